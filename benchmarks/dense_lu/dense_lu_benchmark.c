@@ -0,0 +1,256 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Micro-benchmark for the dense LU factorization. For each matrix
+ * size the following factorizations of the same random, diagonally
+ * weighted matrix are timed:
+ *
+ *   unblocked - the reference column oriented kernel (the previous
+ *               implementation of SUNDlsMat_denseGETRF)
+ *   blocked   - SUNDlsMat_denseGETRF, as used by SUNLinSol_Dense
+ *   lapack    - xGETRF through SUNLinSol_LapackDense (if enabled)
+ *
+ * and the relative difference of the blocked and reference factors
+ * is reported.
+ *
+ * Usage: dense_lu_benchmark <min size> <max size> <number of tests>
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <nvector/nvector_serial.h>
+#include <sundials/sundials_dense.h>
+#include <sundials/sundials_math.h>
+#include <sunmatrix/sunmatrix_dense.h>
+#if defined(BENCHMARK_LAPACK)
+#include <sunlinsol/sunlinsol_lapackdense.h>
+#endif
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* private functions */
+static sunindextype RefGETRF(realtype **a, sunindextype m, sunindextype n,
+                             sunindextype *p);
+static void FillMatrix(SUNMatrix A);
+#if defined(BENCHMARK_LAPACK)
+static double TimeFactor(SUNLinearSolver LS, SUNMatrix A, SUNMatrix B,
+                         int ntests);
+#endif
+static double TimeKernel(SUNMatrix A, SUNMatrix B, sunindextype *p,
+                         int ntests, booleantype blocked);
+static double get_time();
+
+
+/* ----------------------------------------------------------------------
+ * Main dense LU benchmark routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  SUNContext      ctx = NULL;  /* SUNDIALS context             */
+  N_Vector        y;           /* template vector              */
+  SUNMatrix       A, B, C;     /* source and factored matrices */
+#if defined(BENCHMARK_LAPACK)
+  SUNLinearSolver LS;          /* LAPACK linear solver         */
+#endif
+  sunindextype    nmin, nmax;  /* range of matrix sizes        */
+  sunindextype    n, i, j;     /* matrix size and indices      */
+  sunindextype   *p;           /* reference pivots             */
+  realtype        diff, nrm;   /* factor difference and norm   */
+  double          tref, tblk;  /* timings                      */
+  double          tlap = 0.0;
+  int             ntests;      /* number of timed repetitions  */
+
+  if (argc < 4) {
+    printf("ERROR: THREE (3) arguments required: ");
+    printf("<min size> <max size> <number of tests>\n");
+    return(-1);
+  }
+
+  nmin   = (sunindextype) atol(argv[1]);
+  nmax   = (sunindextype) atol(argv[2]);
+  ntests = atoi(argv[3]);
+  if (nmin <= 0 || nmax < nmin || ntests <= 0) {
+    printf("ERROR: sizes and number of tests must be positive integers\n");
+    return(-1);
+  }
+
+  if (SUNContext_Create(NULL, &ctx)) return(-1);
+
+  printf("\nDense LU factorization benchmark (%d tests per size)\n", ntests);
+  printf("%8s %14s %14s %14s %10s %12s\n", "n", "unblocked (s)",
+         "blocked (s)", "lapack (s)", "speedup", "rel. diff");
+
+  for (n = nmin; n <= nmax; n *= 2) {
+
+    A = SUNDenseMatrix(n, n, ctx);
+    B = SUNDenseMatrix(n, n, ctx);
+    C = SUNDenseMatrix(n, n, ctx);
+    y = N_VNew_Serial(n, ctx);
+    p = (sunindextype *) malloc(n * sizeof(sunindextype));
+    FillMatrix(A);
+
+#if defined(BENCHMARK_LAPACK)
+    /* time the LAPACK factorization */
+    LS = SUNLinSol_LapackDense(y, A, ctx);
+    SUNLinSolInitialize(LS);
+    tlap = TimeFactor(LS, A, B, ntests);
+    SUNLinSolFree(LS);
+#endif
+
+    /* time the reference and blocked factorizations */
+    tref = TimeKernel(A, C, p, ntests, SUNFALSE);
+    tblk = TimeKernel(A, B, p, ntests, SUNTRUE);
+
+    /* relative difference of the factors */
+    diff = ZERO;
+    nrm  = ZERO;
+    for (j = 0; j < n; j++) {
+      for (i = 0; i < n; i++) {
+        diff = SUNMAX(diff, SUNRabs(SM_ELEMENT_D(B, i, j) -
+                                    SM_ELEMENT_D(C, i, j)));
+        nrm  = SUNMAX(nrm, SUNRabs(SM_ELEMENT_D(C, i, j)));
+      }
+    }
+
+    printf("%8ld %14.6e %14.6e %14.6e %10.2f %12.4e\n", (long int) n,
+           tref, tblk, tlap, tref / tblk, (double) (diff / nrm));
+
+    SUNMatDestroy(A);
+    SUNMatDestroy(B);
+    SUNMatDestroy(C);
+    N_VDestroy(y);
+    free(p);
+  }
+
+  SUNContext_Free(&ctx);
+
+  return(0);
+}
+
+
+/* ----------------------------------------------------------------------
+ * Private helper functions
+ * --------------------------------------------------------------------*/
+
+/* reference unblocked column oriented LU factorization */
+static sunindextype RefGETRF(realtype **a, sunindextype m, sunindextype n,
+                             sunindextype *p)
+{
+  sunindextype i, j, k, l;
+  realtype *col_j, *col_k;
+  realtype temp, mult, a_kj;
+
+  for (k=0; k < n; k++) {
+    col_k = a[k];
+
+    l = k;
+    for (i=k+1; i < m; i++)
+      if (SUNRabs(col_k[i]) > SUNRabs(col_k[l])) l = i;
+    p[k] = l;
+
+    if (col_k[l] == ZERO) return(k+1);
+
+    if (l != k) {
+      for (i=0; i < n; i++) {
+        temp = a[i][l];
+        a[i][l] = a[i][k];
+        a[i][k] = temp;
+      }
+    }
+
+    mult = ONE/col_k[k];
+    for (i=k+1; i < m; i++) col_k[i] *= mult;
+
+    for (j=k+1; j < n; j++) {
+      col_j = a[j];
+      a_kj = col_j[k];
+      if (a_kj != ZERO) {
+        for (i=k+1; i < m; i++)
+          col_j[i] -= a_kj * col_k[i];
+      }
+    }
+  }
+
+  return(0);
+}
+
+/* fill the matrix with random entries and a weighted diagonal */
+static void FillMatrix(SUNMatrix A)
+{
+  sunindextype i, j, n;
+
+  n = SUNDenseMatrix_Columns(A);
+  srand(1);
+  for (j = 0; j < n; j++)
+    for (i = 0; i < n; i++)
+      SM_ELEMENT_D(A, i, j) = (realtype) rand() / (realtype) RAND_MAX
+        + ((i == j) ? SUN_RCONST(0.1) * n : ZERO);
+}
+
+#if defined(BENCHMARK_LAPACK)
+/* average time to factor a copy of A with the linear solver setup */
+static double TimeFactor(SUNLinearSolver LS, SUNMatrix A, SUNMatrix B,
+                         int ntests)
+{
+  int    t;
+  double start, total = 0.0;
+
+  for (t = 0; t < ntests; t++) {
+    SUNMatCopy(A, B);
+    start = get_time();
+    SUNLinSolSetup(LS, B);
+    total += get_time() - start;
+  }
+
+  return(total / ntests);
+}
+#endif
+
+/* average time to factor a copy of A with the blocked or reference kernel */
+static double TimeKernel(SUNMatrix A, SUNMatrix B, sunindextype *p,
+                         int ntests, booleantype blocked)
+{
+  int          t;
+  double       start, total = 0.0;
+  realtype   **cols;
+  sunindextype n;
+
+  n    = SUNDenseMatrix_Columns(A);
+  cols = SUNDenseMatrix_Cols(B);
+
+  for (t = 0; t < ntests; t++) {
+    SUNMatCopy(A, B);
+    start = get_time();
+    if (blocked) SUNDlsMat_denseGETRF(cols, n, n, p);
+    else         RefGETRF(cols, n, n, p);
+    total += get_time() - start;
+  }
+
+  return(total / ntests);
+}
+
+/* wall clock time in seconds */
+static double get_time()
+{
+  double time;
+#if defined(SUNDIALS_HAVE_POSIX_TIMERS) && defined(_POSIX_TIMERS)
+  struct timespec spec;
+  clock_gettime( CLOCK_MONOTONIC, &spec );
+  time = (double)(spec.tv_sec) + ((double)(spec.tv_nsec) / 1E9);
+#else
+  time = (double) clock() / CLOCKS_PER_SEC;
+#endif
+  return time;
+}
@@ -0,0 +1,284 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Micro-benchmark for the sparse matrix-vector product. For each
+ * matrix size a matrix with the pattern of a 2D five point stencil
+ * plus a random number (0 to 8) of extra entries per row is stored in
+ * CSR and CSC format and the following products are timed:
+ *
+ *   csr ref   - the reference sequential CSR kernel (the previous
+ *               implementation of SUNMatMatvec_Sparse)
+ *   csc ref   - the reference sequential CSC scatter kernel
+ *   csr       - SUNMatMatvec with a CSR matrix
+ *   csc->csr  - SUNMatMatvec with a CSC matrix and the CSR layout
+ *   sell      - SUNMatMatvec with a CSR matrix and the SELL-C-sigma
+ *               layout with the default parameters
+ *
+ * The time to build the layouts is not included. The largest
+ * relative difference from the reference CSR product is reported.
+ * The products use the given number of threads (default 1, see
+ * SUNSparseMatrix_SetNumThreads) when the SUNMATRIX_SPARSE library is
+ * built with OpenMP.
+ *
+ * Usage: sparse_matvec_benchmark <min size> <max size> <number of tests>
+ *                                [number of threads]
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <nvector/nvector_serial.h>
+#include <sundials/sundials_math.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* private functions */
+static SUNMatrix CreateMatrix(sunindextype n, SUNContext ctx);
+static void RefCSR(SUNMatrix A, realtype *x, realtype *y);
+static void RefCSC(SUNMatrix A, realtype *x, realtype *y);
+static double TimeRef(SUNMatrix A, N_Vector x, N_Vector y, int ntests);
+static double TimeMatvec(SUNMatrix A, N_Vector x, N_Vector y, int ntests);
+static realtype RelDiff(N_Vector y, N_Vector yref);
+static double get_time();
+
+
+/* ----------------------------------------------------------------------
+ * Main sparse matrix-vector product benchmark routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  SUNContext   ctx = NULL;         /* SUNDIALS context             */
+  N_Vector     x, y, yref;         /* input and output vectors     */
+  SUNMatrix    Acsr, Acsc, Asell;  /* matrices in each format      */
+  sunindextype nmin, nmax, n, i;   /* range of matrix sizes        */
+  double       t[5];               /* timings                      */
+  realtype     diff;               /* largest relative difference  */
+  int          ntests;             /* number of timed repetitions  */
+  int          nthreads;           /* threads used by the products */
+
+  if (argc < 4) {
+    printf("ERROR: THREE (3) arguments required: ");
+    printf("<min size> <max size> <number of tests>\n");
+    return(-1);
+  }
+
+  nmin   = (sunindextype) atol(argv[1]);
+  nmax   = (sunindextype) atol(argv[2]);
+  ntests = atoi(argv[3]);
+  nthreads = (argc > 4) ? atoi(argv[4]) : 1;
+  if (nmin <= 0 || nmax < nmin || ntests <= 0 || nthreads <= 0) {
+    printf("ERROR: sizes and numbers of tests and threads must be positive integers\n");
+    return(-1);
+  }
+
+  if (SUNContext_Create(NULL, &ctx)) return(-1);
+
+  printf("\nSparse matrix-vector product benchmark (%d tests per size, "
+         "%d threads)\n", ntests, nthreads);
+  printf("%10s %10s %12s %12s %12s %12s %12s %12s\n", "n", "nnz",
+         "csr ref (s)", "csc ref (s)", "csr (s)", "csc->csr (s)", "sell (s)",
+         "rel. diff");
+
+  for (n = nmin; n <= nmax; n *= 2) {
+
+    Acsr = CreateMatrix(n, ctx);
+    if (Acsr == NULL) return(-1);
+    if (SUNSparseMatrix_ToCSC(Acsr, &Acsc)) return(-1);
+    Asell = SUNMatClone(Acsr);
+    SUNMatCopy(Acsr, Asell);
+
+    SUNSparseMatrix_SetMatvecLayout(Acsc, SUNSPARSE_MATVEC_CSR, 0, 0);
+    SUNSparseMatrix_SetMatvecLayout(Asell, SUNSPARSE_MATVEC_SELL, 0, 0);
+
+    SUNSparseMatrix_SetNumThreads(Acsr, nthreads);
+    SUNSparseMatrix_SetNumThreads(Acsc, nthreads);
+    SUNSparseMatrix_SetNumThreads(Asell, nthreads);
+
+    x    = N_VNew_Serial(n, ctx);
+    y    = N_VNew_Serial(n, ctx);
+    yref = N_VNew_Serial(n, ctx);
+    for (i = 0; i < n; i++)
+      NV_Ith_S(x, i) = ONE + (realtype) (i % 7) / SUN_RCONST(7.0);
+
+    /* time the reference kernels */
+    t[0] = TimeRef(Acsr, x, yref, ntests);
+    t[1] = TimeRef(Acsc, x, y, ntests);
+    diff = RelDiff(y, yref);
+
+    /* time the matrix-vector products, building the layouts first */
+    SUNMatMatvec(Acsc, x, y);
+    SUNMatMatvec(Asell, x, y);
+    t[2] = TimeMatvec(Acsr, x, y, ntests);
+    diff = SUNMAX(diff, RelDiff(y, yref));
+    t[3] = TimeMatvec(Acsc, x, y, ntests);
+    diff = SUNMAX(diff, RelDiff(y, yref));
+    t[4] = TimeMatvec(Asell, x, y, ntests);
+    diff = SUNMAX(diff, RelDiff(y, yref));
+
+    printf("%10ld %10ld %12.4e %12.4e %12.4e %12.4e %12.4e %12.4e\n",
+           (long int) n,
+           (long int) (SUNSparseMatrix_IndexPointers(Acsr))[n],
+           t[0], t[1], t[2], t[3], t[4], (double) diff);
+
+    SUNMatDestroy(Acsr);
+    SUNMatDestroy(Acsc);
+    SUNMatDestroy(Asell);
+    N_VDestroy(x);
+    N_VDestroy(y);
+    N_VDestroy(yref);
+  }
+
+  SUNContext_Free(&ctx);
+
+  return(0);
+}
+
+
+/* ----------------------------------------------------------------------
+ * Private helper functions
+ * --------------------------------------------------------------------*/
+
+/* CSR matrix with the pattern of a 2D five point stencil on a grid with
+   about sqrt(n) points per side plus random extra entries in each row */
+static SUNMatrix CreateMatrix(sunindextype n, SUNContext ctx)
+{
+  sunindextype i, j, k, nx, nz, *rp, *ci;
+  realtype    *v;
+  SUNMatrix    A;
+
+  nx = 1;
+  while (nx * nx < n) nx++;
+
+  A = SUNSparseMatrix(n, n, 13 * n, CSR_MAT, ctx);
+  if (A == NULL) return(NULL);
+
+  rp = SUNSparseMatrix_IndexPointers(A);
+  ci = SUNSparseMatrix_IndexValues(A);
+  v  = SUNSparseMatrix_Data(A);
+
+  srand(1);
+  nz = 0;
+  for (i = 0; i < n; i++) {
+    rp[i] = nz;
+    if (i - nx >= 0)   { ci[nz] = i - nx; v[nz++] = -ONE; }
+    if (i % nx > 0)    { ci[nz] = i - 1;  v[nz++] = -ONE; }
+    ci[nz] = i; v[nz++] = SUN_RCONST(4.0);
+    if (i % nx < nx - 1 && i + 1 < n) { ci[nz] = i + 1;  v[nz++] = -ONE; }
+    if (i + nx < n)    { ci[nz] = i + nx; v[nz++] = -ONE; }
+
+    /* extra entries beyond the stencil, in increasing column order */
+    k = rand() % 9;
+    for (j = 0; j < k; j++) {
+      if (i + nx + 1 + j * nx >= n) break;
+      ci[nz]  = i + nx + 1 + j * nx;
+      v[nz++] = SUN_RCONST(0.01) * (realtype) (j + 1);
+    }
+  }
+  rp[n] = nz;
+
+  return(A);
+}
+
+/* reference sequential CSR product */
+static void RefCSR(SUNMatrix A, realtype *x, realtype *y)
+{
+  sunindextype i, j, *Ap, *Aj;
+  realtype *Ax;
+
+  Ap = SUNSparseMatrix_IndexPointers(A);
+  Aj = SUNSparseMatrix_IndexValues(A);
+  Ax = SUNSparseMatrix_Data(A);
+
+  for (i = 0; i < SUNSparseMatrix_Rows(A); i++)
+    y[i] = ZERO;
+  for (i = 0; i < SUNSparseMatrix_Rows(A); i++)
+    for (j = Ap[i]; j < Ap[i+1]; j++)
+      y[i] += Ax[j] * x[Aj[j]];
+}
+
+/* reference sequential CSC product */
+static void RefCSC(SUNMatrix A, realtype *x, realtype *y)
+{
+  sunindextype i, j, *Ap, *Ai;
+  realtype *Ax;
+
+  Ap = SUNSparseMatrix_IndexPointers(A);
+  Ai = SUNSparseMatrix_IndexValues(A);
+  Ax = SUNSparseMatrix_Data(A);
+
+  for (i = 0; i < SUNSparseMatrix_Rows(A); i++)
+    y[i] = ZERO;
+  for (j = 0; j < SUNSparseMatrix_Columns(A); j++)
+    for (i = Ap[j]; i < Ap[j+1]; i++)
+      y[Ai[i]] += Ax[i] * x[j];
+}
+
+/* average time of the reference product */
+static double TimeRef(SUNMatrix A, N_Vector x, N_Vector y, int ntests)
+{
+  int    t;
+  double start;
+
+  start = get_time();
+  for (t = 0; t < ntests; t++) {
+    if (SUNSparseMatrix_SparseType(A) == CSR_MAT)
+      RefCSR(A, N_VGetArrayPointer(x), N_VGetArrayPointer(y));
+    else
+      RefCSC(A, N_VGetArrayPointer(x), N_VGetArrayPointer(y));
+  }
+
+  return((get_time() - start) / ntests);
+}
+
+/* average time of SUNMatMatvec */
+static double TimeMatvec(SUNMatrix A, N_Vector x, N_Vector y, int ntests)
+{
+  int    t;
+  double start;
+
+  start = get_time();
+  for (t = 0; t < ntests; t++)
+    SUNMatMatvec(A, x, y);
+
+  return((get_time() - start) / ntests);
+}
+
+/* largest difference relative to the largest reference entry */
+static realtype RelDiff(N_Vector y, N_Vector yref)
+{
+  sunindextype i;
+  realtype diff = ZERO, nrm = ZERO;
+
+  for (i = 0; i < N_VGetLength(y); i++) {
+    diff = SUNMAX(diff, SUNRabs(NV_Ith_S(y, i) - NV_Ith_S(yref, i)));
+    nrm  = SUNMAX(nrm, SUNRabs(NV_Ith_S(yref, i)));
+  }
+
+  return(diff / nrm);
+}
+
+/* wall clock time in seconds */
+static double get_time()
+{
+  double time;
+#if defined(SUNDIALS_HAVE_POSIX_TIMERS) && defined(_POSIX_TIMERS)
+  struct timespec spec;
+  clock_gettime( CLOCK_MONOTONIC, &spec );
+  time = (double)(spec.tv_sec) + ((double)(spec.tv_nsec) / 1E9);
+#else
+  time = (double) clock() / CLOCKS_PER_SEC;
+#endif
+  return time;
+}
@@ -120,6 +120,10 @@ list(APPEND SUNDIALS_BUILD_LIST "BUILD_NVECTOR_KOKKOS")
 # required modules are in the build list, but cannot be disabled
 set(BUILD_SUNMATRIX_BAND TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNMATRIX_BAND")
+set(BUILD_SUNMATRIX_BLOCKDENSE TRUE)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNMATRIX_BLOCKDENSE")
+set(BUILD_SUNMATRIX_BSR TRUE)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNMATRIX_BSR")
 set(BUILD_SUNMATRIX_DENSE TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNMATRIX_DENSE")
 set(BUILD_SUNMATRIX_SPARSE TRUE)
@@ -166,8 +170,12 @@ list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNMATRIX_SLUNRLOC")
 # required modules are in the build list, but cannot be disabled
 set(BUILD_SUNLINSOL_BAND TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_BAND")
+set(BUILD_SUNLINSOL_BLOCKDENSE TRUE)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_BLOCKDENSE")
 set(BUILD_SUNLINSOL_DENSE TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_DENSE")
+set(BUILD_SUNLINSOL_ILU TRUE)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_ILU")
 set(BUILD_SUNLINSOL_PCG TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_PCG")
 set(BUILD_SUNLINSOL_SPBCGS TRUE)
@@ -176,6 +184,8 @@ set(BUILD_SUNLINSOL_SPFGMR TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_SPFGMR")
 set(BUILD_SUNLINSOL_SPGMR TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_SPGMR")
+set(BUILD_SUNLINSOL_SSGMR TRUE)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_SSGMR")
 set(BUILD_SUNLINSOL_SPTFQMR TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_SPTFQMR")
 
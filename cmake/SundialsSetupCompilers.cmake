@@ -231,6 +231,63 @@ if(SUNDIALS_BUILD_WITH_PROFILING AND
   message(SEND_ERROR "The SUNDIALS native profiler requires POSIX timers or MPI_Wtime, but neither were found.")
 endif()
 
+# ---------------------------------------------------------------
+# Check for thread local storage and atomics (native profiler)
+# ---------------------------------------------------------------
+
+if(SUNDIALS_BUILD_WITH_PROFILING AND (NOT ENABLE_CALIPER))
+  check_c_source_compiles("
+    #if defined(__GNUC__) || defined(__clang__)
+    static __thread int x;
+    static char lock;
+    int main() {
+      while (__atomic_test_and_set(&lock, __ATOMIC_ACQUIRE)) {}
+      __atomic_clear(&lock, __ATOMIC_RELEASE);
+      return x;
+    }
+    #elif defined(_MSC_VER)
+    #include <intrin.h>
+    static __declspec(thread) int x;
+    static volatile char lock;
+    int main() {
+      while (_InterlockedExchange8(&lock, 1)) {}
+      _InterlockedExchange8(&lock, 0);
+      return x;
+    }
+    #else
+    #include <stdatomic.h>
+    static _Thread_local int x;
+    static atomic_flag lock = ATOMIC_FLAG_INIT;
+    int main() {
+      while (atomic_flag_test_and_set(&lock)) {}
+      atomic_flag_clear(&lock);
+      return x;
+    }
+    #endif
+  " SUNDIALS_PROFILER_THREAD_SAFE)
+  if(NOT SUNDIALS_PROFILER_THREAD_SAFE)
+    message(SEND_ERROR "The SUNDIALS native profiler requires thread local storage and atomic operations (GCC/Clang builtins, MSVC intrinsics, or C11 _Thread_local and stdatomic.h), try CMAKE_C_STANDARD=11.")
+  endif()
+endif()
+
+# ---------------------------------------------------------------
+# Check for Linux perf events (hardware counters in the profiler)
+# ---------------------------------------------------------------
+
+if(SUNDIALS_BUILD_WITH_PROFILING AND (NOT ENABLE_CALIPER))
+  check_c_source_compiles("
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    int main() {
+      struct perf_event_attr attr;
+      attr.type   = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      return (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0) < -1;
+    }
+  " SUNDIALS_PERF_EVENTS)
+endif()
+
 # ---------------------------------------------------------------
 # Check for deprecated attribute with message
 # ---------------------------------------------------------------
@@ -71,6 +71,11 @@ foreach(tpl ${SUNDIALS_TPL_LIST})
   set(SUNDIALS_${tpl}_ENABLED TRUE)
 endforeach()
 
+# the Pthreads TPL is listed as PTHREAD but its macro is SUNDIALS_PTHREADS_ENABLED
+if(ENABLE_PTHREAD)
+  set(SUNDIALS_PTHREADS_ENABLED TRUE)
+endif()
+
 # prepare substitution variable SUNDIALS_TRILINOS_HAVE_MPI for sundials_config.h
 if(Trilinos_MPI)
   set(SUNDIALS_TRILINOS_HAVE_MPI TRUE)
@@ -96,6 +101,11 @@ if(SUNDIALS_POSIX_TIMERS) # set in SundialsPOSIXTimers.cmake
   set(SUNDIALS_HAVE_POSIX_TIMERS TRUE)
 endif()
 
+# prepare substitution variable SUNDIALS_HAVE_PERF_EVENTS for sundials_config.h
+if(SUNDIALS_PERF_EVENTS) # set in SundialsSetupCompilers.cmake
+  set(SUNDIALS_HAVE_PERF_EVENTS TRUE)
+endif()
+
 # =============================================================================
 # All required substitution variables should be available at this point.
 # Generate the header file and place it in the binary dir.
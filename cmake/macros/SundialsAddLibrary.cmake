@@ -265,6 +265,12 @@ macro(sundials_add_library target)
         endif()
       endif()
 
+      # Libraries that include the sundials_generic objects need Pthreads for
+      # the file checkpoint store
+      if(ENABLE_PTHREAD AND ("sundials_generic_obj" IN_LIST sundials_add_library_OBJECT_LIBRARIES))
+        target_link_libraries(${_actual_target_name} PRIVATE Threads::Threads)
+      endif()
+
       if(SUNDIALS_BUILD_WITH_PROFILING)
         if(ENABLE_CALIPER)
           target_link_libraries(${_actual_target_name} PUBLIC caliper)
@@ -225,6 +225,10 @@ int main(int argc, char *argv[])
   fails += Test_N_VDotProdMultiLocal(V, local_length, myid);
   fails += Test_N_VDotProdMultiAllReduce(V, local_length, myid);
 
+  /* split-phase reduction operations */
+  if (myid == 0) printf("\nTesting split-phase reduction operations:\n\n");
+  fails += Test_N_VAllReduce(X, local_length, myid);
+
   /* XBraid interface operations */
   if (myid == 0) printf("\nTesting XBraid interface operations:\n\n");
 
@@ -5609,6 +5609,106 @@ int Test_N_VDotProdMultiAllReduce(N_Vector X, sunindextype local_length,
 }
 
 
+/* ----------------------------------------------------------------------
+ * N_VAllReduceStart / N_VAllReduceFinish Test
+ * --------------------------------------------------------------------*/
+int Test_N_VAllReduce(N_Vector X, sunindextype local_length, int myid)
+{
+  int      fails = 0, failure = 0, ierr = 0;
+  double   start_time, stop_time, maxt;
+
+  sunindextype global_length;
+  realtype     buf[3], nprocs;
+
+  /* only test if the operations are implemented, local vectors (non-MPI) do
+     not provide these functions */
+  if (!(X->ops->nvallreducestart) || !(X->ops->nvallreducefinish)) return 0;
+
+  /* get global length */
+  global_length = N_VGetLength(X);
+
+  /*
+   * Case 1: sum reduction overlapped with a local vector operation
+   */
+
+  buf[0] = ONE;
+  buf[1] = (realtype) local_length;
+  buf[2] = NEG_ONE * local_length;
+
+  start_time = get_time();
+  ierr = N_VAllReduceStart(3, X, buf, SUN_REDUCE_SUM);
+  N_VConst(TWO, X);
+  if (ierr == 0) ierr = N_VAllReduceFinish(X);
+  sync_device(X);
+  stop_time = get_time();
+
+  /* buf[1] and buf[2] should equal +/- the global length, buf[0] is the
+     number of participating tasks */
+  nprocs = buf[0];
+  if (ierr == 0) {
+    failure  = (nprocs < ONE);
+    failure += SUNRCompare(buf[1], (realtype) global_length);
+    failure += SUNRCompare(buf[2], NEG_ONE * global_length);
+    failure += check_ans(TWO, X, local_length);
+  } else {
+    failure = 1;
+  }
+
+  if (failure) {
+    printf(">>> FAILED test -- N_VAllReduce Case 1, Proc %d \n", myid);
+    fails++;
+  } else if (myid == 0) {
+    printf("PASSED test -- N_VAllReduce Case 1 \n");
+  }
+
+  /* find max time across all processes */
+  maxt = max_time(X, stop_time - start_time);
+  PRINT_TIME("N_VAllReduce", maxt);
+
+  /*
+   * Case 2: max and min reductions
+   */
+
+  buf[0] = (realtype) myid;
+
+  start_time = get_time();
+  ierr = N_VAllReduceStart(1, X, buf, SUN_REDUCE_MAX);
+  if (ierr == 0) ierr = N_VAllReduceFinish(X);
+  sync_device(X);
+  stop_time = get_time();
+
+  if (ierr == 0)
+    failure = SUNRCompare(buf[0], nprocs - ONE);
+  else
+    failure = 1;
+
+  buf[0] = (realtype) myid;
+  ierr = N_VAllReduceStart(1, X, buf, SUN_REDUCE_MIN);
+  if (ierr == 0) ierr = N_VAllReduceFinish(X);
+
+  if (ierr == 0)
+    failure += SUNRCompare(buf[0], ZERO);
+  else
+    failure += 1;
+
+  /* finishing without a pending reduction is a no-op */
+  if (N_VAllReduceFinish(X) != 0) failure++;
+
+  if (failure) {
+    printf(">>> FAILED test -- N_VAllReduce Case 2, Proc %d \n", myid);
+    fails++;
+  } else if (myid == 0) {
+    printf("PASSED test -- N_VAllReduce Case 2 \n");
+  }
+
+  /* find max time across all processes */
+  maxt = max_time(X, stop_time - start_time);
+  PRINT_TIME("N_VAllReduce", maxt);
+
+  return(fails);
+}
+
+
 /* ----------------------------------------------------------------------
  * N_VBufSize test
  * --------------------------------------------------------------------*/
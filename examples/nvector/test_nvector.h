@@ -143,6 +143,9 @@ int Test_N_VDotProdMultiLocal(N_Vector X, sunindextype local_length, int myid);
 int Test_N_VDotProdMultiAllReduce(N_Vector X, sunindextype local_length,
                                   int myid);
 
+/* Split-phase reduction tests */
+int Test_N_VAllReduce(N_Vector X, sunindextype local_length, int myid);
+
 /* XBraid interface operations */
 int Test_N_VBufSize(N_Vector x, sunindextype local_length, int myid);
 int Test_N_VBufPack(N_Vector x, sunindextype local_length, int myid);
@@ -0,0 +1,273 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the SUNLinSol BlockDense module
+ * implementation.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_types.h>
+#include <sunlinsol/sunlinsol_blockdense.h>
+#include <sunmatrix/sunmatrix_blockdense.h>
+#include <nvector/nvector_serial.h>
+#include <sundials/sundials_math.h>
+#include "test_sunlinsol.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* prototypes for custom tests */
+static int Test_BlockDenseThreads(SUNLinearSolver LS, SUNMatrix A, N_Vector b);
+
+/* ----------------------------------------------------------------------
+ * SUNLinSol_BlockDense Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  int             fails = 0;          /* counter for test failures  */
+  sunindextype    nblocks, N;         /* number of blocks, block size */
+  SUNLinearSolver LS;                 /* solver object              */
+  SUNMatrix       A, B;               /* test matrices              */
+  N_Vector        x, y, b;            /* test vectors               */
+  int             print_timing;
+  int             print_on_fail;
+  sunindextype    i, j, k;
+  realtype        *xdata;
+  SUNContext      sunctx;
+
+  if (SUNContext_Create(NULL, &sunctx)) {
+    printf("ERROR: SUNContext_Create failed\n");
+    return(-1);
+  }
+
+  /* check input and set matrix dimensions */
+  if (argc < 4) {
+    printf("ERROR: THREE (3) Inputs required: number of blocks, block size, print timing \n");
+    return(-1);
+  }
+
+  nblocks = (sunindextype) atol(argv[1]);
+  if (nblocks <= 0) {
+    printf("ERROR: number of blocks must be a positive integer \n");
+    return(-1);
+  }
+
+  N = (sunindextype) atol(argv[2]);
+  if (N <= 0) {
+    printf("ERROR: block size must be a positive integer \n");
+    return(-1);
+  }
+
+  print_timing = atoi(argv[3]);
+  SetTiming(print_timing);
+
+  print_on_fail = 0;
+  if (argc == 5) {
+    print_on_fail = atoi(argv[4]);
+  }
+
+  printf("\nBlock-diagonal dense linear solver test: %ld blocks of size %ld\n\n",
+         (long int) nblocks, (long int) N);
+
+  /* Create matrices and vectors */
+  A = SUNBlockDenseMatrix(nblocks, N, N, sunctx);
+  B = SUNBlockDenseMatrix(nblocks, N, N, sunctx);
+  x = N_VNew_Serial(nblocks*N, sunctx);
+  y = N_VNew_Serial(nblocks*N, sunctx);
+  b = N_VNew_Serial(nblocks*N, sunctx);
+
+  /* Fill each block with uniform random data in [0,1/N] and add the
+     anti-identity to ensure the solver needs to do row-swapping */
+  for (k=0; k<nblocks; k++) {
+    for (j=0; j<N; j++) {
+      for (i=0; i<N; i++) {
+        SM_ELEMENT_BD(A,k,i,j) = (realtype) rand() / (realtype) RAND_MAX / N;
+        if (i + j == N - 1)
+          SM_ELEMENT_BD(A,k,i,j) += ONE;
+      }
+    }
+  }
+
+  /* Fill x vector with uniform random data in [0,1] */
+  xdata = N_VGetArrayPointer(x);
+  for (j=0; j<nblocks*N; j++) {
+    xdata[j] = (realtype) rand() / (realtype) RAND_MAX;
+  }
+
+  /* copy A and x into B and y to print in case of solver failure */
+  SUNMatCopy(A, B);
+  N_VScale(ONE, x, y);
+
+  /* create right-hand side vector for linear solve */
+  fails = SUNMatMatvec(A, x, b);
+  if (fails) {
+    printf("FAIL: SUNLinSol SUNMatMatvec failure\n");
+
+    /* Free matrices and vectors */
+    SUNMatDestroy(A);
+    SUNMatDestroy(B);
+    N_VDestroy(x);
+    N_VDestroy(y);
+    N_VDestroy(b);
+
+    return(1);
+  }
+
+  /* Create block-diagonal dense linear solver */
+  LS = SUNLinSol_BlockDense(x, A, sunctx);
+
+  /* Run Tests */
+  fails += Test_SUNLinSolInitialize(LS, 0);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  fails += Test_SUNLinSolSolve(LS, A, x, b, 100*UNIT_ROUNDOFF, SUNTRUE, 0);
+
+  fails += Test_SUNLinSolGetType(LS, SUNLINEARSOLVER_DIRECT, 0);
+  fails += Test_SUNLinSolGetID(LS, SUNLINEARSOLVER_BLOCKDENSE, 0);
+  fails += Test_SUNLinSolLastFlag(LS, 0);
+  fails += Test_SUNLinSolSpace(LS, 0);
+  fails += Test_BlockDenseThreads(LS, B, b);
+
+  /* Print result */
+  if (fails) {
+    printf("FAIL: SUNLinSol module failed %i tests \n \n", fails);
+    if (print_on_fail) {
+      printf("\nA (original) =\n");
+      SUNBlockDenseMatrix_Print(B,stdout);
+      printf("\nA (factored) =\n");
+      SUNBlockDenseMatrix_Print(A,stdout);
+      printf("\nx (original) =\n");
+      N_VPrint_Serial(y);
+      printf("\nx (computed) =\n");
+      N_VPrint_Serial(x);
+    }
+  } else {
+    printf("SUCCESS: SUNLinSol module passed all tests \n \n");
+  }
+
+  /* Free solver, matrix and vectors */
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  SUNMatDestroy(B);
+  N_VDestroy(x);
+  N_VDestroy(y);
+  N_VDestroy(b);
+  SUNContext_Free(&sunctx);
+
+  return(fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Implementation-specific 'check' routines
+ * --------------------------------------------------------------------*/
+int check_vector(N_Vector X, N_Vector Y, realtype tol)
+{
+  int failure = 0;
+  sunindextype i, local_length;
+  realtype *Xdata, *Ydata, maxerr;
+
+  Xdata = N_VGetArrayPointer(X);
+  Ydata = N_VGetArrayPointer(Y);
+  local_length = N_VGetLength_Serial(X);
+
+  /* check vector data */
+  for(i=0; i < local_length; i++)
+    failure += SUNRCompareTol(Xdata[i], Ydata[i], tol);
+
+  if (failure > ZERO) {
+    maxerr = ZERO;
+    for(i=0; i < local_length; i++)
+      maxerr = SUNMAX(SUNRabs(Xdata[i]-Ydata[i]), maxerr);
+    printf("check err failure: maxerr = %"GSYM" (tol = %"GSYM")\n",
+	   maxerr, tol);
+    return(1);
+  }
+  else
+    return(0);
+}
+
+void sync_device()
+{
+}
+
+/* ----------------------------------------------------------------------
+ * Check that the setup and solve with several threads give the serial
+ * solution and the same zero pivot flag, the groups of blocks are
+ * independent so the results match. The original matrix A is unchanged.
+ * --------------------------------------------------------------------*/
+static int Test_BlockDenseThreads(SUNLinearSolver LS, SUNMatrix A, N_Vector b)
+{
+  int          failure;
+  sunindextype nblocks, N, i, flag_serial, flag_threads;
+  SUNMatrix    C;
+  N_Vector     x, z;
+
+  if (SUNLinSol_BlockDenseSetNumThreads(LS, 0) != SUNLS_ILL_INPUT) {
+    printf(">>> FAILED test -- SUNLinSol_BlockDenseSetNumThreads accepted 0 \n");
+    return(1);
+  }
+
+  nblocks = SUNBlockDenseMatrix_NumBlocks(A);
+  N       = SUNBlockDenseMatrix_BlockRows(A);
+
+  C = SUNMatClone(A);
+  x = N_VClone(b);
+  z = N_VClone(b);
+
+  /* nonsingular blocks */
+  failure  = SUNMatCopy(A, C);
+  failure += SUNLinSolSetup(LS, C);
+  failure += SUNLinSolSolve(LS, C, x, b, ZERO);
+
+  failure += SUNLinSol_BlockDenseSetNumThreads(LS, 3);
+  failure += SUNMatCopy(A, C);
+  failure += SUNLinSolSetup(LS, C);
+  failure += SUNLinSolSolve(LS, C, z, b, ZERO);
+  failure += check_vector(x, z, 10*UNIT_ROUNDOFF);
+
+  /* the last block is singular */
+  failure += SUNMatCopy(A, C);
+  for (i=0; i<N; i++)
+    SM_ELEMENT_BD(C,nblocks-1,i,0) = ZERO;
+  SUNLinSolSetup(LS, C);
+  flag_threads = SUNLinSolLastFlag(LS);
+
+  failure += SUNLinSol_BlockDenseSetNumThreads(LS, 1);
+  failure += SUNMatCopy(A, C);
+  for (i=0; i<N; i++)
+    SM_ELEMENT_BD(C,nblocks-1,i,0) = ZERO;
+  SUNLinSolSetup(LS, C);
+  flag_serial = SUNLinSolLastFlag(LS);
+
+  if ((flag_serial != (nblocks-1)*N + 1) || (flag_threads != flag_serial))
+    failure += 1;
+
+  if (failure) {
+    printf(">>> FAILED test -- SUNLinSol_BlockDenseSetNumThreads \n");
+    failure = 1;
+  } else {
+    printf("    PASSED test -- SUNLinSol_BlockDenseSetNumThreads \n");
+  }
+
+  SUNMatDestroy(C);
+  N_VDestroy(x);
+  N_VDestroy(z);
+  return(failure);
+}
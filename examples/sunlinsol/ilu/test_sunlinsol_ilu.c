@@ -0,0 +1,472 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the SUNLinSol ILU module
+ * implementation.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_types.h>
+#include <sunlinsol/sunlinsol_ilu.h>
+#include <sunmatrix/sunmatrix_dense.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+#include <nvector/nvector_serial.h>
+#include <sundials/sundials_math.h>
+#include "test_sunlinsol.h"
+
+static int Test_ILUTridiag(sunindextype N, int mattype, SUNContext sunctx);
+static int Test_ILUFactors(int mattype, int fill, SUNContext sunctx);
+static int Test_ILUThreads(SUNLinearSolver LS, SUNMatrix A, N_Vector x,
+                           N_Vector b);
+static int Test_ILUResidual(SUNLinearSolver LS, SUNMatrix A, N_Vector x,
+                            N_Vector b);
+
+/* ----------------------------------------------------------------------
+ * SUNLinSol_ILU Linear Solver Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  int             fails = 0;          /* counter for test failures  */
+  sunindextype    N;                  /* matrix columns, rows       */
+  SUNLinearSolver LS;                 /* linear solver object       */
+  SUNMatrix       A, B;               /* test matrices              */
+  N_Vector        x, y, b;            /* test vectors               */
+  realtype        *matdata, *xdata;
+  int             mattype, fill, print_timing;
+  sunindextype    i, j, k, nnz, nlevL, nlevU;
+  SUNContext      sunctx;
+
+  if (SUNContext_Create(NULL, &sunctx)) {
+    printf("ERROR: SUNContext_Create failed\n");
+    return(-1);
+  }
+
+  /* check input and set matrix dimensions */
+  if (argc < 5){
+    printf("ERROR: FOUR (4) Inputs required: matrix size, matrix type (0/1), fill level, print timing \n");
+    return(-1);
+  }
+
+  N = (sunindextype) atol(argv[1]);
+  if (N <= 0) {
+    printf("ERROR: matrix size must be a positive integer \n");
+    return(-1);
+  }
+
+  mattype = atoi(argv[2]);
+  if ((mattype != 0) && (mattype != 1)) {
+    printf("ERROR: matrix type must be 0 or 1 \n");
+    return(-1);
+  }
+  mattype = (mattype == 0) ? CSC_MAT : CSR_MAT;
+
+  fill = atoi(argv[3]);
+  if (fill < 0) {
+    printf("ERROR: fill level must be a nonnegative integer \n");
+    return(-1);
+  }
+
+  print_timing = atoi(argv[4]);
+  SetTiming(print_timing);
+
+  printf("\nILU linear solver test: size %ld, type %i, fill level %i\n\n",
+         (long int) N, mattype, fill);
+
+  /* Create matrices and vectors */
+  B = SUNDenseMatrix(N, N, sunctx);
+  x = N_VNew_Serial(N, sunctx);
+  y = N_VNew_Serial(N, sunctx);
+  b = N_VNew_Serial(N, sunctx);
+
+  /* Fill matrix with uniform random data in [0,1/N] */
+  for (k=0; k<5*N; k++) {
+    i = rand() % N;
+    j = rand() % N;
+    matdata = SUNDenseMatrix_Column(B,j);
+    matdata[i] = (realtype) rand() / (realtype) RAND_MAX / N;
+  }
+
+  /* Add identity to matrix */
+  fails = SUNMatScaleAddI(ONE, B);
+  if (fails) {
+    printf("FAIL: SUNLinSol SUNMatScaleAddI failure\n");
+    return(1);
+  }
+
+  /* Fill x vector with uniform random data in [0,1] */
+  xdata = N_VGetArrayPointer(x);
+  for (i=0; i<N; i++)
+    xdata[i] = (realtype) rand() / (realtype) RAND_MAX;
+
+  /* Create sparse matrix from dense, and destroy B */
+  A = SUNSparseFromDenseMatrix(B, ZERO, mattype);
+  SUNMatDestroy(B);
+
+  /* copy x into y to print in case of solver failure */
+  N_VScale(ONE, x, y);
+
+  /* create right-hand side vector for linear solve */
+  fails = SUNMatMatvec(A, x, b);
+  if (fails) {
+    printf("FAIL: SUNLinSol SUNMatMatvec failure\n");
+    return(1);
+  }
+
+  /* Create ILU linear solver */
+  LS = SUNLinSol_ILU(x, A, fill, sunctx);
+
+  /* Run Tests, with a fill level of at least N-1 the factorization is
+     exact, otherwise check that the preconditioner reduces the residual */
+  fails += Test_SUNLinSolInitialize(LS, 0);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  if (fill >= N - 1)
+    fails += Test_SUNLinSolSolve(LS, A, x, b, 1000*UNIT_ROUNDOFF, SUNTRUE, 0);
+  else
+    fails += Test_ILUResidual(LS, A, x, b);
+
+  fails += Test_SUNLinSolGetType(LS, SUNLINEARSOLVER_DIRECT, 0);
+  fails += Test_SUNLinSolGetID(LS, SUNLINEARSOLVER_ILU, 0);
+  fails += Test_SUNLinSolLastFlag(LS, 0);
+  fails += Test_SUNLinSolSpace(LS, 0);
+
+  /* Test 'Get' routines */
+  SUNLinSol_ILUGetNumNonzeros(LS, &nnz);
+  if ((nnz < SUNSparseMatrix_NNZ(A)) || (nnz > N*N)) {
+    printf("FAIL: SUNLinSol_ILUGetNumNonzeros failure\n");
+    fails += 1;
+  } else {
+    printf("    PASSED test -- SUNLinSol_ILUGetNumNonzeros \n");
+  }
+  SUNLinSol_ILUGetNumLevels(LS, &nlevL, &nlevU);
+  if ((nlevL < 1) || (nlevL > N) || (nlevU < 1) || (nlevU > N)) {
+    printf("FAIL: SUNLinSol_ILUGetNumLevels failure\n");
+    fails += 1;
+  } else {
+    printf("    PASSED test -- SUNLinSol_ILUGetNumLevels \n");
+  }
+
+  /* ILU(0) keeps the pattern of A (and the diagonal) */
+  fails += SUNLinSol_ILUSetFillLevel(LS, 0);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  SUNLinSol_ILUGetNumNonzeros(LS, &nnz);
+  if (nnz != SUNSparseMatrix_NNZ(A)) {
+    printf("FAIL: SUNLinSol_ILUSetFillLevel failure\n");
+    fails += 1;
+  } else {
+    printf("    PASSED test -- SUNLinSol_ILUSetFillLevel \n");
+  }
+
+  /* the threaded setup and solve give the serial result */
+  fails += Test_ILUThreads(LS, A, x, b);
+
+  /* ILU(0) of a tridiagonal matrix is exact */
+  fails += Test_ILUTridiag(N, mattype, sunctx);
+
+  /* known ILU(0) factors and exact ILU(1) factors of a small matrix */
+  fails += Test_ILUFactors(mattype, 0, sunctx);
+  fails += Test_ILUFactors(mattype, 1, sunctx);
+
+  /* Print result */
+  if (fails) {
+    printf("FAIL: SUNLinSol module failed %i tests \n \n", fails);
+    printf("\nA =\n");
+    SUNSparseMatrix_Print(A,stdout);
+    printf("\nx (original) =\n");
+    N_VPrint_Serial(y);
+    printf("\nb =\n");
+    N_VPrint_Serial(b);
+    printf("\nx (computed) =\n");
+    N_VPrint_Serial(x);
+  } else {
+    printf("SUCCESS: SUNLinSol module passed all tests \n \n");
+  }
+
+  /* Free solver, matrix and vectors */
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  N_VDestroy(x);
+  N_VDestroy(y);
+  N_VDestroy(b);
+
+  SUNContext_Free(&sunctx);
+
+  return(fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Check that ILU(0) solves a diagonally dominant tridiagonal system, the
+ * factors have no fill and each triangular solve has N levels
+ * --------------------------------------------------------------------*/
+static int Test_ILUTridiag(sunindextype N, int mattype, SUNContext sunctx)
+{
+  int             fails = 0;
+  SUNLinearSolver LS;
+  SUNMatrix       A, B;
+  N_Vector        x, y, b;
+  realtype        *xdata;
+  sunindextype    i, nnz, nlevL, nlevU;
+
+  B = SUNDenseMatrix(N, N, sunctx);
+  x = N_VNew_Serial(N, sunctx);
+  y = N_VNew_Serial(N, sunctx);
+  b = N_VNew_Serial(N, sunctx);
+
+  xdata = N_VGetArrayPointer(x);
+  for (i=0; i<N; i++) {
+    SM_ELEMENT_D(B,i,i) = RCONST(4.0) + (realtype) i / N;
+    if (i > 0)   SM_ELEMENT_D(B,i,i-1) = -ONE;
+    if (i < N-1) SM_ELEMENT_D(B,i,i+1) = -RCONST(2.0);
+    xdata[i] = (realtype) rand() / (realtype) RAND_MAX;
+  }
+  A = SUNSparseFromDenseMatrix(B, ZERO, mattype);
+  SUNMatDestroy(B);
+
+  N_VScale(ONE, x, y);
+  fails += SUNMatMatvec(A, x, b);
+
+  LS = SUNLinSol_ILU(x, A, 0, sunctx);
+  fails += SUNLinSolInitialize(LS);
+  fails += SUNLinSolSetup(LS, A);
+  fails += SUNLinSolSolve(LS, A, x, b, ZERO);
+  fails += check_vector(y, x, 1000*UNIT_ROUNDOFF);
+
+  SUNLinSol_ILUGetNumNonzeros(LS, &nnz);
+  SUNLinSol_ILUGetNumLevels(LS, &nlevL, &nlevU);
+  if ((nnz != SUNSparseMatrix_NNZ(A)) || (nlevL != N) || (nlevU != N))
+    fails++;
+
+  if (fails) {
+    printf("FAIL: SUNLinSol_ILU tridiagonal ILU(0) failure\n");
+  } else {
+    printf("    PASSED test -- SUNLinSol_ILU tridiagonal ILU(0) \n");
+  }
+
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  N_VDestroy(x);
+  N_VDestroy(y);
+  N_VDestroy(b);
+
+  return(fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Check the factors of the 4x4 periodic matrix
+ *
+ *       [  4 -1  0 -1 ]
+ *   A = [ -1  4 -1  0 ]
+ *       [  0 -1  4 -1 ]
+ *       [ -1  0 -1  4 ]
+ *
+ * ILU(0) drops the fill entries (1,3) and (3,1) of level one, which gives
+ *
+ *   L = [ 1, -1/4 1, -4/15 1, -1/4 0 -15/56 1 ] (by rows, in the pattern of A)
+ *   U = [ 4 -1 0 -1, 15/4 -1 0, 56/15 -1, 195/56 ]
+ *
+ * while ILU(1) keeps them and equals the exact LU factorization, so the
+ * factors are compared with a dense LU factorization without pivoting.
+ * --------------------------------------------------------------------*/
+static int Test_ILUFactors(int mattype, int fill, SUNContext sunctx)
+{
+  int             fails = 0;
+  SUNLinearSolver LS;
+  SUNMatrix       A, B;
+  N_Vector        x, y, b;
+  realtype        F[4][4], *LUx;
+  sunindextype    i, j, k, p, *LUp, *LUj;
+
+  /* expected ILU(0) factors, L below and U on and above the diagonal */
+  realtype F0[4][4] = {
+    { RCONST(4.0),   -ONE,                ZERO,               -ONE },
+    {-RCONST(0.25),   RCONST(3.75),      -ONE,                 ZERO },
+    { ZERO,          -RCONST(4.0/15.0),   RCONST(56.0/15.0),  -ONE },
+    {-RCONST(0.25),   ZERO,              -RCONST(15.0/56.0),   RCONST(195.0/56.0) }
+  };
+
+  B = SUNDenseMatrix(4, 4, sunctx);
+  for (i=0; i<4; i++) {
+    SM_ELEMENT_D(B,i,i)       = RCONST(4.0);
+    SM_ELEMENT_D(B,i,(i+1)%4) = -ONE;
+    SM_ELEMENT_D(B,(i+1)%4,i) = -ONE;
+  }
+
+  /* dense LU factorization without pivoting in F */
+  for (i=0; i<4; i++)
+    for (j=0; j<4; j++)
+      F[i][j] = SM_ELEMENT_D(B,i,j);
+  for (k=0; k<4; k++)
+    for (i=k+1; i<4; i++) {
+      F[i][k] /= F[k][k];
+      for (j=k+1; j<4; j++)
+        F[i][j] -= F[i][k] * F[k][j];
+    }
+  if (fill == 0)
+    for (i=0; i<4; i++)
+      for (j=0; j<4; j++)
+        F[i][j] = F0[i][j];
+
+  A = SUNSparseFromDenseMatrix(B, ZERO, mattype);
+  SUNMatDestroy(B);
+
+  x = N_VNew_Serial(4, sunctx);
+  y = N_VClone(x);
+  b = N_VClone(x);
+  for (i=0; i<4; i++) NV_Ith_S(y,i) = ONE + (realtype) i;
+  fails += SUNMatMatvec(A, y, b);
+
+  LS = SUNLinSol_ILU(x, A, fill, sunctx);
+  fails += SUNLinSolInitialize(LS);
+  fails += SUNLinSolSetup(LS, A);
+
+  /* compare every stored entry, the pattern is the one of A plus the two
+     fill entries for ILU(1) */
+  LUp = ((SUNLinearSolverContent_ILU) LS->content)->LUp;
+  LUj = ((SUNLinearSolverContent_ILU) LS->content)->LUj;
+  LUx = ((SUNLinearSolverContent_ILU) LS->content)->LUx;
+  if (LUp[4] != ((fill == 0) ? 12 : 14)) fails++;
+  for (i=0; i<4; i++)
+    for (p=LUp[i]; p<LUp[i+1]; p++)
+      if ((F[i][LUj[p]] == ZERO) ||
+          (SUNRabs(LUx[p] - F[i][LUj[p]]) > 100*UNIT_ROUNDOFF))
+        fails++;
+
+  /* the ILU(1) factors are exact */
+  if (fill > 0) {
+    fails += SUNLinSolSolve(LS, A, x, b, ZERO);
+    fails += check_vector(y, x, 1000*UNIT_ROUNDOFF);
+  }
+
+  if (fails) {
+    printf("FAIL: SUNLinSol_ILU ILU(%d) factors failure\n", fill);
+  } else {
+    printf("    PASSED test -- SUNLinSol_ILU ILU(%d) factors \n", fill);
+  }
+
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  N_VDestroy(x);
+  N_VDestroy(y);
+  N_VDestroy(b);
+
+  return(fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Check that the setup and solve with several threads give the serial
+ * solution, the rows of a level are independent so the results match
+ * --------------------------------------------------------------------*/
+static int Test_ILUThreads(SUNLinearSolver LS, SUNMatrix A, N_Vector x,
+                           N_Vector b)
+{
+  int      failure;
+  N_Vector z;
+
+  z = N_VClone(x);
+
+  if (SUNLinSol_ILUSetNumThreads(LS, 0) != SUNLS_ILL_INPUT) {
+    printf(">>> FAILED test -- SUNLinSol_ILUSetNumThreads accepted 0 \n");
+    N_VDestroy(z);
+    return(1);
+  }
+
+  failure = SUNLinSolSetup(LS, A);
+  failure += SUNLinSolSolve(LS, A, x, b, ZERO);
+
+  failure += SUNLinSol_ILUSetNumThreads(LS, 3);
+  failure += SUNLinSolSetup(LS, A);
+  failure += SUNLinSolSolve(LS, A, z, b, ZERO);
+  failure += check_vector(x, z, 10*UNIT_ROUNDOFF);
+
+  failure += SUNLinSol_ILUSetNumThreads(LS, 1);
+
+  if (failure) {
+    printf(">>> FAILED test -- SUNLinSol_ILUSetNumThreads \n");
+    failure = 1;
+  } else {
+    printf("    PASSED test -- SUNLinSol_ILUSetNumThreads \n");
+  }
+
+  N_VDestroy(z);
+  return(failure);
+}
+
+/* ----------------------------------------------------------------------
+ * Check that applying the incomplete factors reduces the residual, i.e.
+ * ||b - A M^{-1} b|| < ||b||
+ * --------------------------------------------------------------------*/
+static int Test_ILUResidual(SUNLinearSolver LS, SUNMatrix A, N_Vector x,
+                            N_Vector b)
+{
+  int      failure;
+  N_Vector r;
+  realtype rnorm, bnorm;
+
+  r = N_VClone(b);
+
+  failure = SUNLinSolSolve(LS, A, x, b, ZERO);
+  failure += SUNMatMatvec(A, x, r);
+  N_VLinearSum(ONE, b, -ONE, r, r);
+
+  rnorm = SUNRsqrt(N_VDotProd(r, r));
+  bnorm = SUNRsqrt(N_VDotProd(b, b));
+
+  if (failure || (rnorm >= bnorm)) {
+    printf(">>> FAILED test -- SUNLinSolSolve residual %g vs %g\n",
+           (double) rnorm, (double) bnorm);
+    failure = 1;
+  } else {
+    printf("    PASSED test -- SUNLinSolSolve residual reduction \n");
+  }
+
+  N_VDestroy(r);
+  return(failure);
+}
+
+/* ----------------------------------------------------------------------
+ * Implementation-specific 'check' routines
+ * --------------------------------------------------------------------*/
+int check_vector(N_Vector X, N_Vector Y, realtype tol)
+{
+  int failure = 0;
+  sunindextype i, local_length, maxloc;
+  realtype *Xdata, *Ydata, maxerr;
+
+  Xdata = N_VGetArrayPointer(X);
+  Ydata = N_VGetArrayPointer(Y);
+  local_length = N_VGetLength_Serial(X);
+
+  /* check vector data */
+  for(i=0; i < local_length; i++)
+    failure += SUNRCompareTol(Xdata[i], Ydata[i], tol);
+
+  if (failure > ZERO) {
+    maxerr = ZERO;
+    maxloc = -1;
+    for(i=0; i < local_length; i++) {
+      if (SUNRabs(Xdata[i]-Ydata[i]) >  maxerr) {
+        maxerr = SUNRabs(Xdata[i]-Ydata[i]);
+        maxloc = i;
+      }
+    }
+    printf("check err failure: maxerr = %g at loc %li (tol = %g)\n",
+	   maxerr, (long int) maxloc, tol);
+    return(1);
+  }
+  else
+    return(0);
+}
+
+void sync_device()
+{
+}
@@ -35,8 +35,8 @@ int main(int argc, char *argv[])
 {
   int             fails = 0;          /* counter for test failures  */
   sunindextype    N;                  /* matrix columns, rows       */
-  SUNLinearSolver LS;                 /* linear solver object       */
-  SUNMatrix       A, B;               /* test matrices              */
+  SUNLinearSolver LS, LS2, LS3;       /* linear solver objects      */
+  SUNMatrix       A, B, U, L;         /* test matrices              */
   N_Vector        x, y, b;            /* test vectors               */
   realtype        *matdata, *xdata;
   int             mattype, print_timing;
@@ -152,6 +152,82 @@ int main(int argc, char *argv[])
     printf("    PASSED test -- SUNLinSol_KLUGetCommon \n");
   }
 
+  /* Test reuse of the symbolic factorization after a partial reinit */
+  fails += SUNLinSol_KLUReInit(LS, A, 0, SUNKLU_REINIT_PARTIAL);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  if (SUNLinSol_KLUGetSymbolic(LS) != symbolic) {
+    printf("FAIL: SUNLinSol_KLUReInit symbolic reuse failure\n");
+    fails += 1;
+  } else {
+    printf("    PASSED test -- SUNLinSol_KLUReInit symbolic reuse \n");
+  }
+
+  /* Test sharing the symbolic factorization with a second solver */
+  LS2 = SUNLinSol_KLU(x, A, sunctx);
+  fails += SUNLinSol_KLUShareSymbolic(LS2, LS);
+  fails += Test_SUNLinSolInitialize(LS2, 0);
+  fails += Test_SUNLinSolSetup(LS2, A, 0);
+  fails += Test_SUNLinSolSolve(LS2, A, x, b, 1000*UNIT_ROUNDOFF, SUNTRUE, 0);
+  if (SUNLinSol_KLUGetSymbolic(LS2) != symbolic) {
+    printf("FAIL: SUNLinSol_KLUShareSymbolic failure\n");
+    fails += 1;
+  } else {
+    printf("    PASSED test -- SUNLinSol_KLUShareSymbolic \n");
+  }
+  SUNLinSolFree(LS2);
+
+  /* Test that a different pattern with the same size and number of nonzeros
+     (upper versus lower bidiagonal) is analyzed again, for a shared and for
+     an unshared symbolic factorization */
+  B = SUNDenseMatrix(N, N, sunctx);
+  for (j=0; j<N; j++) {
+    matdata = SUNDenseMatrix_Column(B,j);
+    matdata[j] = RCONST(2.0);
+    if (j > 0) matdata[j-1] = -ONE;
+  }
+  U = SUNSparseFromDenseMatrix(B, ZERO, mattype);
+  for (j=0; j<N; j++) {
+    matdata = SUNDenseMatrix_Column(B,j);
+    if (j > 0) matdata[j-1] = ZERO;
+    if (j < N-1) matdata[j+1] = -ONE;
+  }
+  L = SUNSparseFromDenseMatrix(B, ZERO, mattype);
+  SUNMatDestroy(B);
+
+  LS2 = SUNLinSol_KLU(x, U, sunctx);
+  LS3 = SUNLinSol_KLU(x, U, sunctx);
+  fails += Test_SUNLinSolInitialize(LS2, 0);
+  fails += Test_SUNLinSolSetup(LS2, U, 0);
+  fails += SUNLinSol_KLUShareSymbolic(LS3, LS2);
+  fails += Test_SUNLinSolInitialize(LS3, 0);
+
+  N_VScale(ONE, y, x);
+  fails += SUNMatMatvec(L, x, b);
+  fails += Test_SUNLinSolSetup(LS3, L, 0);
+  fails += Test_SUNLinSolSolve(LS3, L, x, b, 1000*UNIT_ROUNDOFF, SUNTRUE, 0);
+  if (SUNLinSol_KLUGetSymbolic(LS3) == SUNLinSol_KLUGetSymbolic(LS2)) {
+    printf("FAIL: SUNLinSol_KLU shared pattern change failure\n");
+    fails += 1;
+  } else {
+    printf("    PASSED test -- SUNLinSol_KLU shared pattern change \n");
+  }
+
+  N_VScale(ONE, y, x);
+  fails += SUNLinSol_KLUReInit(LS2, L, 0, SUNKLU_REINIT_PARTIAL);
+  fails += Test_SUNLinSolSetup(LS2, L, 0);
+  fails += Test_SUNLinSolSolve(LS2, L, x, b, 1000*UNIT_ROUNDOFF, SUNTRUE, 0);
+
+  N_VScale(ONE, y, x);
+  fails += SUNMatMatvec(U, x, b);
+  fails += SUNLinSol_KLUReInit(LS2, U, 0, SUNKLU_REINIT_PARTIAL);
+  fails += Test_SUNLinSolSetup(LS2, U, 0);
+  fails += Test_SUNLinSolSolve(LS2, U, x, b, 1000*UNIT_ROUNDOFF, SUNTRUE, 0);
+
+  SUNLinSolFree(LS2);
+  SUNLinSolFree(LS3);
+  SUNMatDestroy(U);
+  SUNMatDestroy(L);
+
   /* Print result */
   if (fails) {
     printf("FAIL: SUNLinSol module failed %i tests \n \n", fails);
@@ -0,0 +1,480 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the SUNMatrix BSR module
+ * implementation.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sundials/sundials_types.h>
+#include <sunmatrix/sunmatrix_bsr.h>
+#include <nvector/nvector_serial.h>
+#include <sundials/sundials_math.h>
+#include "test_sunmatrix.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* prototypes for custom tests */
+int Test_SUNBSRMatrixToSparse(SUNMatrix A, N_Vector x, N_Vector y, int sparsetype);
+int Test_SUNBSRMatrixColorColumns(SUNMatrix A);
+int Test_SUNBSRMatrixSetNumThreads(SUNMatrix A, N_Vector x, N_Vector y);
+
+/* ----------------------------------------------------------------------
+ * Main SUNMatrix Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  int          fails = 0;        /* counter for test failures  */
+  sunindextype nblocks;          /* number of block rows/cols  */
+  sunindextype bs;               /* block size                 */
+  N_Vector     x, y;             /* test vectors               */
+  realtype     *xdata, *ydata;   /* pointers to vector data    */
+  SUNMatrix    A, I;             /* test matrices              */
+  int          print_timing;
+  sunindextype *Ap, *Aj, *Ip, *Ij;
+  sunindextype bi, bj, i, j, k;
+  SUNContext   sunctx;
+
+  if (SUNContext_Create(NULL, &sunctx)) {
+    printf("ERROR: SUNContext_Create failed\n");
+    return(-1);
+  }
+
+  /* check input and set matrix dimensions */
+  if (argc < 4){
+    printf("ERROR: THREE (3) Input required: number of block rows, block size, print timing \n");
+    return(-1);
+  }
+
+  nblocks = (sunindextype) atol(argv[1]);
+  if (nblocks <= 0) {
+    printf("ERROR: number of block rows must be a positive integer \n");
+    return(-1);
+  }
+
+  bs = (sunindextype) atol(argv[2]);
+  if (bs <= 0) {
+    printf("ERROR: block size must be a positive integer \n");
+    return(-1);
+  }
+
+  print_timing = atoi(argv[3]);
+  SetTiming(print_timing);
+
+  printf("\nBSR matrix test: %ld by %ld blocks of size %ld\n\n",
+         (long int) nblocks, (long int) nblocks, (long int) bs);
+
+  /* Create vectors and matrices, block row bi has the blocks of a block
+     tridiagonal matrix and one more block in block column (7 bi + 3) % nblocks */
+  x = N_VNew_Serial(nblocks*bs, sunctx);
+  y = N_VNew_Serial(nblocks*bs, sunctx);
+  A = SUNBSRMatrix(nblocks, nblocks, bs, 4*nblocks, sunctx);
+  I = SUNBSRMatrix(nblocks, nblocks, bs, nblocks, sunctx);
+
+  Ap = SUNBSRMatrix_IndexPointers(A);
+  Aj = SUNBSRMatrix_IndexValues(A);
+  k  = 0;
+  for (bi=0; bi < nblocks; bi++) {
+    Ap[bi] = k;
+    for (bj=0; bj < nblocks; bj++) {
+      if ((bj >= bi-1 && bj <= bi+1) || (bj == (7*bi + 3) % nblocks)) {
+        Aj[k] = bj;
+        for (j=0; j < bs; j++)
+          for (i=0; i < bs; i++)
+            SM_BLOCK_ELEMENT_BSR(A,k,i,j) =
+              ONE + (bi*bs + i + 1) * SUN_RCONST(0.01) + ((bj*bs + j) % 5);
+        k++;
+      }
+    }
+  }
+  Ap[nblocks] = k;
+
+  Ip = SUNBSRMatrix_IndexPointers(I);
+  Ij = SUNBSRMatrix_IndexValues(I);
+  for (bi=0; bi < nblocks; bi++) {
+    Ip[bi] = bi;
+    Ij[bi] = bi;
+    for (i=0; i < bs; i++)
+      SM_BLOCK_ELEMENT_BSR(I,bi,i,i) = ONE;
+  }
+  Ip[nblocks] = nblocks;
+
+  xdata = N_VGetArrayPointer(x);
+  for (i=0; i < nblocks*bs; i++)
+    xdata[i] = ONE / (i+1);
+
+  /* reference product y = A x */
+  ydata = N_VGetArrayPointer(y);
+  for (i=0; i < nblocks*bs; i++)
+    ydata[i] = ZERO;
+  for (bi=0; bi < nblocks; bi++)
+    for (k=Ap[bi]; k < Ap[bi+1]; k++)
+      for (j=0; j < bs; j++)
+        for (i=0; i < bs; i++)
+          ydata[bi*bs + i] += SM_BLOCK_ELEMENT_BSR(A,k,i,j) * xdata[Aj[k]*bs + j];
+
+  /* SUNMatrix Tests */
+  fails += Test_SUNMatGetID(A, SUNMATRIX_BSR, 0);
+  fails += Test_SUNMatClone(A, 0);
+  fails += Test_SUNMatCopy(A, 0);
+  fails += Test_SUNMatZero(A, 0);
+  fails += Test_SUNMatScaleAdd(A, I, 0);
+  fails += Test_SUNMatScaleAddI(A, I, 0);
+  fails += Test_SUNMatMatvec(A, x, y, 0);
+  fails += Test_SUNMatSpace(A, 0);
+  fails += Test_SUNBSRMatrixToSparse(A, x, y, CSR_MAT);
+  fails += Test_SUNBSRMatrixToSparse(A, x, y, CSC_MAT);
+  fails += Test_SUNBSRMatrixColorColumns(A);
+  fails += Test_SUNBSRMatrixSetNumThreads(A, x, y);
+
+  /* Print result */
+  if (fails) {
+    printf("FAIL: SUNMatrix module failed %i tests \n \n", fails);
+    printf("\nA =\n");
+    SUNBSRMatrix_Print(A,stdout);
+    printf("\nI =\n");
+    SUNBSRMatrix_Print(I,stdout);
+    printf("\nx =\n");
+    N_VPrint_Serial(x);
+    printf("\ny =\n");
+    N_VPrint_Serial(y);
+  } else {
+    printf("SUCCESS: SUNMatrix module passed all tests \n \n");
+  }
+
+  /* Free vectors and matrices */
+  N_VDestroy(x);
+  N_VDestroy(y);
+  SUNMatDestroy(A);
+  SUNMatDestroy(I);
+  SUNContext_Free(&sunctx);
+
+  return(fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Convert A to a sparse matrix and back, the sparse product must match
+ * y and the round trip must give A again
+ * --------------------------------------------------------------------*/
+int Test_SUNBSRMatrixToSparse(SUNMatrix A, N_Vector x, N_Vector y, int sparsetype)
+{
+  int       failure;
+  SUNMatrix S, B;
+  N_Vector  z;
+  realtype  tol = 100*UNIT_ROUNDOFF;
+
+  S = NULL;
+  failure = SUNBSRMatrix_ToSparse(A, sparsetype, &S);
+  if (failure) {
+    printf(">>> FAILED test -- SUNBSRMatrix_ToSparse returned %d \n", failure);
+    SUNMatDestroy(S);
+    return(1);
+  }
+
+  /* every entry of the blocks is stored */
+  if (SUNSparseMatrix_IndexPointers(S)[SUNSparseMatrix_NP(S)] !=
+      SUNBSRMatrix_IndexPointers(A)[SUNBSRMatrix_BlockRows(A)] *
+      SUNBSRMatrix_BlockSize(A) * SUNBSRMatrix_BlockSize(A)) {
+    printf(">>> FAILED test -- SUNBSRMatrix_ToSparse wrong number of nonzeros \n");
+    SUNMatDestroy(S);
+    return(1);
+  }
+
+  z = N_VClone(y);
+  failure = SUNMatMatvec(S, x, z);
+  if (failure || check_vector(z, y, tol)) {
+    printf(">>> FAILED test -- SUNBSRMatrix_ToSparse product \n");
+    N_VDestroy(z);
+    SUNMatDestroy(S);
+    return(1);
+  }
+  N_VDestroy(z);
+
+  /* copying the same pattern again keeps the pattern of S */
+  failure = SUNBSRMatrix_CopyToSparse(A, S);
+  if (failure || SUNSparseMatrix_PatternChanged(S)) {
+    printf(">>> FAILED test -- SUNBSRMatrix_CopyToSparse pattern \n");
+    SUNMatDestroy(S);
+    return(1);
+  }
+
+  B = SUNBSRFromSparseMatrix(S, SUNBSRMatrix_BlockSize(A));
+  if (B == NULL) {
+    printf(">>> FAILED test -- SUNBSRFromSparseMatrix returned NULL \n");
+    SUNMatDestroy(S);
+    return(1);
+  }
+
+  failure = check_matrix(A, B, tol);
+  SUNMatDestroy(S);
+  SUNMatDestroy(B);
+
+  if (failure) {
+    printf(">>> FAILED test -- SUNBSRMatrix %s round trip \n",
+           (sparsetype == CSR_MAT) ? "CSR" : "CSC");
+    return(1);
+  }
+
+  printf("    PASSED test -- SUNBSRMatrix %s conversion \n",
+         (sparsetype == CSR_MAT) ? "CSR" : "CSC");
+  return(0);
+}
+
+/* ----------------------------------------------------------------------
+ * Check that columns of the same color do not share a row
+ * --------------------------------------------------------------------*/
+int Test_SUNBSRMatrixColorColumns(SUNMatrix A)
+{
+  int          failure;
+  sunindextype N, ncolors, i, p, q;
+  sunindextype *colors, *Sp, *Sj;
+  SUNMatrix    S;
+
+  N      = SUNBSRMatrix_Columns(A);
+  colors = (sunindextype *) malloc(N * sizeof(sunindextype));
+
+  failure = SUNBSRMatrix_ColorColumns(A, colors, &ncolors);
+  if (failure) {
+    printf(">>> FAILED test -- SUNBSRMatrix_ColorColumns returned %d \n", failure);
+    free(colors);
+    return(1);
+  }
+
+  S = NULL;
+  SUNBSRMatrix_ToSparse(A, CSR_MAT, &S);
+  Sp = SUNSparseMatrix_IndexPointers(S);
+  Sj = SUNSparseMatrix_IndexValues(S);
+
+  for (i=0; i < N; i++)
+    if (colors[i] < 0 || colors[i] >= ncolors) failure++;
+  for (i=0; i < N; i++)
+    for (p=Sp[i]; p < Sp[i+1]; p++)
+      for (q=p+1; q < Sp[i+1]; q++)
+        if (colors[Sj[p]] == colors[Sj[q]]) failure++;
+
+  free(colors);
+  SUNMatDestroy(S);
+
+  if (failure) {
+    printf(">>> FAILED test -- SUNBSRMatrix_ColorColumns \n");
+    return(1);
+  }
+
+  printf("    PASSED test -- SUNBSRMatrix_ColorColumns (%ld colors) \n",
+         (long int) ncolors);
+  return(0);
+}
+
+/* ----------------------------------------------------------------------
+ * The product with several threads and with a clone of the threaded
+ * matrix must match y
+ * --------------------------------------------------------------------*/
+int Test_SUNBSRMatrixSetNumThreads(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int       failure;
+  SUNMatrix B;
+  N_Vector  z;
+  realtype  tol = 100*UNIT_ROUNDOFF;
+
+  if (SUNBSRMatrix_SetNumThreads(A, 0) != SUNMAT_ILL_INPUT) {
+    printf(">>> FAILED test -- SUNBSRMatrix_SetNumThreads accepted 0 \n");
+    return(1);
+  }
+
+  failure = SUNBSRMatrix_SetNumThreads(A, 3);
+  if (failure) {
+    printf(">>> FAILED test -- SUNBSRMatrix_SetNumThreads returned %d \n", failure);
+    return(1);
+  }
+
+  z = N_VClone(y);
+  failure = SUNMatMatvec(A, x, z);
+  if (failure || check_vector(z, y, tol)) {
+    printf(">>> FAILED test -- SUNBSRMatrix threaded product \n");
+    SUNBSRMatrix_SetNumThreads(A, 1);
+    N_VDestroy(z);
+    return(1);
+  }
+
+  B = SUNMatClone(A);
+  failure = SUNMatCopy(A, B);
+  if (!failure) failure = SUNMatMatvec(B, x, z);
+  if (failure || SM_NUM_THREADS_BSR(B) != 3 || check_vector(z, y, tol)) {
+    printf(">>> FAILED test -- SUNBSRMatrix threaded clone product \n");
+    failure = 1;
+  }
+
+  SUNBSRMatrix_SetNumThreads(A, 1);
+  SUNMatDestroy(B);
+  N_VDestroy(z);
+
+  if (failure) return(1);
+
+  printf("    PASSED test -- SUNBSRMatrix_SetNumThreads \n");
+  return(0);
+}
+
+/* ----------------------------------------------------------------------
+ * Check matrix
+ * --------------------------------------------------------------------*/
+int check_matrix(SUNMatrix A, SUNMatrix B, realtype tol)
+{
+  int failure = 0;
+  realtype *Adata, *Bdata;
+  sunindextype *Ap, *Bp, *Aj, *Bj;
+  sunindextype i, MB, bs, nnzb;
+
+  /* matrices must have the same block grid, block size and pattern */
+  if ((SUNBSRMatrix_BlockRows(A) != SUNBSRMatrix_BlockRows(B)) ||
+      (SUNBSRMatrix_BlockColumns(A) != SUNBSRMatrix_BlockColumns(B)) ||
+      (SUNBSRMatrix_BlockSize(A) != SUNBSRMatrix_BlockSize(B))) {
+    printf(">>> ERROR: check_matrix: Different dimensions \n");
+    return(1);
+  }
+
+  MB   = SUNBSRMatrix_BlockRows(A);
+  bs   = SUNBSRMatrix_BlockSize(A);
+  Ap   = SUNBSRMatrix_IndexPointers(A);
+  Bp   = SUNBSRMatrix_IndexPointers(B);
+  Aj   = SUNBSRMatrix_IndexValues(A);
+  Bj   = SUNBSRMatrix_IndexValues(B);
+  nnzb = Ap[MB];
+
+  for (i=0; i <= MB; i++)
+    failure += (Ap[i] != Bp[i]);
+  if (failure) {
+    printf(">>> ERROR: check_matrix: Different indexptrs \n");
+    return(1);
+  }
+  for (i=0; i < nnzb; i++)
+    failure += (Aj[i] != Bj[i]);
+  if (failure) {
+    printf(">>> ERROR: check_matrix: Different indexvals \n");
+    return(1);
+  }
+
+  /* compare data */
+  Adata = SUNBSRMatrix_Data(A);
+  Bdata = SUNBSRMatrix_Data(B);
+  for(i=0; i < nnzb*bs*bs; i++)
+    failure += SUNRCompareTol(Adata[i], Bdata[i], tol);
+
+  if (failure > ZERO) {
+    printf(">>> ERROR: check_matrix: Different entries \n");
+    return(1);
+  }
+
+  return(0);
+}
+
+int check_matrix_entry(SUNMatrix A, realtype val, realtype tol)
+{
+  int failure = 0;
+  realtype *Adata;
+  sunindextype Aldata;
+  sunindextype i, bs;
+
+  /* get data pointer */
+  Adata = SUNBSRMatrix_Data(A);
+
+  /* compare the entries of the stored blocks */
+  bs     = SUNBSRMatrix_BlockSize(A);
+  Aldata = SUNBSRMatrix_IndexPointers(A)[SUNBSRMatrix_BlockRows(A)] * bs * bs;
+  for(i=0; i < Aldata; i++){
+    failure += SUNRCompareTol(Adata[i], val, tol);
+  }
+
+  if (failure > ZERO) {
+    printf("Check_matrix_entry failures:\n");
+    for(i=0; i < Aldata; i++)
+      if (SUNRCompareTol(Adata[i], val, tol) != 0)
+        printf("  Adata[%ld] = %"GSYM" != %"GSYM" (err = %"GSYM")\n", (long int) i,
+               Adata[i], val, SUNRabs(Adata[i]-val));
+  }
+
+  if (failure > ZERO)
+    return(1);
+  else
+    return(0);
+}
+
+int check_vector(N_Vector x, N_Vector y, realtype tol)
+{
+  int failure = 0;
+  realtype *xdata, *ydata;
+  sunindextype xldata, yldata;
+  sunindextype i;
+
+  /* get vector data */
+  xdata = N_VGetArrayPointer(x);
+  ydata = N_VGetArrayPointer(y);
+
+  /* check data lengths */
+  xldata = N_VGetLength(x);
+  yldata = N_VGetLength(y);
+
+  if (xldata != yldata) {
+    printf(">>> ERROR: check_vector: Different data array lengths \n");
+    return(1);
+  }
+
+  /* check vector data */
+  for(i=0; i < xldata; i++)
+    failure += SUNRCompareTol(xdata[i], ydata[i], tol);
+
+  if (failure > ZERO) {
+    printf("Check_vector failures:\n");
+    for(i=0; i < xldata; i++)
+      if (SUNRCompareTol(xdata[i], ydata[i], tol) != 0)
+        printf("  xdata[%ld] = %"GSYM" != %"GSYM" (err = %"GSYM")\n", (long int) i,
+               xdata[i], ydata[i], SUNRabs(xdata[i]-ydata[i]));
+  }
+
+  if (failure > ZERO)
+    return(1);
+  else
+    return(0);
+}
+
+booleantype has_data(SUNMatrix A)
+{
+  realtype *Adata = SUNBSRMatrix_Data(A);
+  if (Adata == NULL)
+    return SUNFALSE;
+  else
+    return SUNTRUE;
+}
+
+booleantype is_square(SUNMatrix A)
+{
+  if (SUNBSRMatrix_Rows(A) == SUNBSRMatrix_Columns(A))
+    return SUNTRUE;
+  else
+    return SUNFALSE;
+}
+
+void sync_device(SUNMatrix A)
+{
+  /* not running on GPU, just return */
+  return;
+}
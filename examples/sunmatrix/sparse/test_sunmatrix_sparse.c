@@ -32,8 +32,13 @@
 int Test_SUNMatScaleAdd2(SUNMatrix A, SUNMatrix B, N_Vector x,
                          N_Vector y, N_Vector z);
 int Test_SUNMatScaleAddI2(SUNMatrix A, N_Vector x, N_Vector y);
+int Test_SUNMatScaleAddReuse(SUNMatrix A, SUNMatrix B, N_Vector x,
+                             N_Vector y, N_Vector z, int square);
+int Test_SUNMatMatvecLayout(SUNMatrix A, N_Vector x, N_Vector y);
+int Test_SUNSparseMatrixSetNumThreads(SUNMatrix A, N_Vector x, N_Vector y);
 int Test_SUNSparseMatrixToCSC(SUNMatrix A);
 int Test_SUNSparseMatrixToCSR(SUNMatrix A);
+int Test_SUNSparseMatrixDiagonalBlocks(SUNMatrix A);
 
 /* ----------------------------------------------------------------------
  * Main SUNMatrix Testing Routine
@@ -369,8 +374,12 @@ int main(int argc, char *argv[])
   if (square) {
     fails += Test_SUNMatScaleAddI(A, I, 0);
     fails += Test_SUNMatScaleAddI2(A, x, y);
+    fails += Test_SUNSparseMatrixDiagonalBlocks(A);
   }
+  fails += Test_SUNMatScaleAddReuse(A, B, x, y, z, square);
   fails += Test_SUNMatMatvec(A, x, y, 0);
+  fails += Test_SUNMatMatvecLayout(A, x, y);
+  fails += Test_SUNSparseMatrixSetNumThreads(A, x, y);
   fails += Test_SUNMatSpace(A, 0);
   if (mattype == CSR_MAT) {
     fails += Test_SUNSparseMatrixToCSC(A);
@@ -739,6 +748,170 @@ int Test_SUNMatScaleAddI2(SUNMatrix A, N_Vector x, N_Vector y)
   return(0);
 }
 
+/* ----------------------------------------------------------------------
+ * Repeated ScaleAdd and ScaleAddI tests for sparse matrices: the first
+ *   call with a given pattern changes the pattern of the output, later
+ *   calls with the same input patterns reuse the cached maps
+ *    A and B should have different sparsity patterns
+ *    y should already equal A*x
+ *    z should already equal B*x
+ * --------------------------------------------------------------------*/
+int Test_SUNMatScaleAddReuse(SUNMatrix A, SUNMatrix B, N_Vector x,
+                             N_Vector y, N_Vector z, int square)
+{
+  int         failure, k;
+  booleantype changed;
+  realtype    c;
+  SUNMatrix   C;
+  N_Vector    u, v;
+  realtype    tol=100*UNIT_ROUNDOFF;
+
+  C = SUNMatClone(A);
+  u = N_VClone(y);
+  v = N_VClone(y);
+
+  /* C = c A + B with the pattern of A restored before each call */
+  for (k=0; k<3; k++) {
+    c = (realtype) (k+1);
+    failure = SUNMatCopy(A, C);
+    if (!failure) failure = SUNMatScaleAdd(c, C, B);
+    if (!failure) failure = SUNMatMatvec(C, x, u);
+    if (failure) {
+      printf(">>> FAILED test -- SUNMatScaleAddReuse returned %d \n",
+             failure);
+      SUNMatDestroy(C);  N_VDestroy(u);  N_VDestroy(v);  return(1);
+    }
+    N_VLinearSum(c,y,ONE,z,v);
+    changed = SUNSparseMatrix_PatternChanged(C);
+    if (check_vector(u, v, tol) || changed != (k == 0)) {
+      printf(">>> FAILED test -- SUNMatScaleAddReuse check %d \n", k+1);
+      SUNMatDestroy(C);  N_VDestroy(u);  N_VDestroy(v);  return(1);
+    }
+  }
+  printf("    PASSED test -- SUNMatScaleAddReuse ScaleAdd \n");
+
+  /* C = I - c A with the pattern of A restored before each call */
+  if (square) {
+    SUNSparseMatrix_FreeCache(C);
+    for (k=0; k<3; k++) {
+      c = (realtype) (k+1);
+      failure = SUNMatCopy(A, C);
+      if (!failure) failure = SUNMatScaleAddI(-c, C);
+      if (!failure) failure = SUNMatMatvec(C, x, u);
+      if (failure) {
+        printf(">>> FAILED test -- SUNMatScaleAddReuse returned %d \n",
+               failure);
+        SUNMatDestroy(C);  N_VDestroy(u);  N_VDestroy(v);  return(1);
+      }
+      N_VLinearSum(ONE,x,-c,y,v);
+      changed = SUNSparseMatrix_PatternChanged(C);
+      if (check_vector(u, v, tol) || changed != (k == 0)) {
+        printf(">>> FAILED test -- SUNMatScaleAddReuse check %d \n", k+4);
+        SUNMatDestroy(C);  N_VDestroy(u);  N_VDestroy(v);  return(1);
+      }
+    }
+    printf("    PASSED test -- SUNMatScaleAddReuse ScaleAddI \n");
+  }
+
+  SUNMatDestroy(C);
+  N_VDestroy(u);
+  N_VDestroy(v);
+  return(0);
+}
+
+/* ----------------------------------------------------------------------
+ * Matvec tests with the CSR and SELL-C-sigma layouts:
+ *    y should already equal A*x
+ *    the layout is rebuilt when the matrix changes
+ * --------------------------------------------------------------------*/
+int Test_SUNMatMatvecLayout(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int          failure, k;
+  int          layouts[4] = {SUNSPARSE_MATVEC_CSR, SUNSPARSE_MATVEC_SELL,
+                             SUNSPARSE_MATVEC_SELL, SUNSPARSE_MATVEC_SELL};
+  sunindextype chunks[4]  = {0, 0, 4, 1};
+  sunindextype sigmas[4]  = {0, 0, 16, 1};
+  SUNMatrix    B;
+  N_Vector     z, w;
+  realtype     tol=100*UNIT_ROUNDOFF;
+
+  z = N_VClone(y);
+  w = N_VClone(y);
+  N_VScale(TWO, y, w);
+
+  for (k=0; k<4; k++) {
+    B = SUNMatClone(A);
+    failure = SUNSparseMatrix_SetMatvecLayout(B, layouts[k], chunks[k],
+                                              sigmas[k]);
+    if (!failure) failure = SUNMatCopy(A, B);
+    if (!failure) failure = SUNMatMatvec(B, x, z);      /* z = Bx = Ax */
+    if (!failure) failure = check_vector(z, y, tol);
+    if (!failure) failure = SUNMatScaleAdd(ONE, B, A);  /* B = 2A */
+    if (!failure) failure = SUNMatMatvec(B, x, z);      /* z = 2Ax */
+    if (!failure) failure = check_vector(z, w, tol);
+    SUNMatDestroy(B);
+    if (failure) {
+      printf(">>> FAILED test -- SUNMatMatvecLayout check %d \n", k+1);
+      N_VDestroy(z);  N_VDestroy(w);  return(1);
+    }
+  }
+  printf("    PASSED test -- SUNMatMatvecLayout \n");
+
+  N_VDestroy(z);
+  N_VDestroy(w);
+  return(0);
+}
+
+/* ----------------------------------------------------------------------
+ * Threaded matvec tests with the native, CSR and SELL-C-sigma layouts:
+ *    y should already equal A*x
+ *    clones use the same number of threads
+ * --------------------------------------------------------------------*/
+int Test_SUNSparseMatrixSetNumThreads(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int          failure, k;
+  int          layouts[3] = {SUNSPARSE_MATVEC_NATIVE, SUNSPARSE_MATVEC_CSR,
+                             SUNSPARSE_MATVEC_SELL};
+  SUNMatrix    B, C;
+  N_Vector     z;
+  realtype     tol=100*UNIT_ROUNDOFF;
+
+  if (SUNSparseMatrix_SetNumThreads(A, 0) != SUNMAT_ILL_INPUT) {
+    printf(">>> FAILED test -- SUNSparseMatrix_SetNumThreads accepted 0 \n");
+    return(1);
+  }
+
+  z = N_VClone(y);
+
+  for (k=0; k<3; k++) {
+    B = SUNMatClone(A);
+    C = NULL;
+    failure = SUNSparseMatrix_SetMatvecLayout(B, layouts[k], 0, 0);
+    if (!failure) failure = SUNSparseMatrix_SetNumThreads(B, 3);
+    if (!failure) failure = SUNMatCopy(A, B);
+    if (!failure) failure = SUNMatMatvec(B, x, z);
+    if (!failure) failure = check_vector(z, y, tol);
+    if (!failure) {
+      C = SUNMatClone(B);
+      failure = (C == NULL) || (SM_NUM_THREADS_S(C) != 3);
+    }
+    if (!failure) failure = SUNMatCopy(A, C);
+    if (!failure) failure = SUNMatMatvec(C, x, z);
+    if (!failure) failure = check_vector(z, y, tol);
+    SUNMatDestroy(B);
+    if (C) SUNMatDestroy(C);
+    if (failure) {
+      printf(">>> FAILED test -- SUNSparseMatrix_SetNumThreads check %d \n",
+             k+1);
+      N_VDestroy(z);  return(1);
+    }
+  }
+  printf("    PASSED test -- SUNSparseMatrix_SetNumThreads \n");
+
+  N_VDestroy(z);
+  return(0);
+}
+
 int Test_SUNSparseMatrixToCSR(SUNMatrix A)
 {
   int       failure;
@@ -812,6 +985,68 @@ int Test_SUNSparseMatrixToCSC(SUNMatrix A)
 }
 
 
+int Test_SUNSparseMatrixDiagonalBlocks(SUNMatrix A)
+{
+  int          failure = 0;
+  SUNMatrix    B[3];
+  sunindextype offsets[4], N, nblocks, b, k, p, q, s, e, nin;
+  sunindextype *Ap, *Ai, *Bp, *Bi;
+  realtype     *Ax, *Bx, aval;
+  booleantype  hasdiag;
+
+  /* split A in (up to) three blocks of nearly equal size */
+  N = SUNSparseMatrix_Rows(A);
+  nblocks = SUNMIN(3, N);
+  for (b=0; b<=nblocks; b++) offsets[b] = (b*N)/nblocks;
+
+  if (SUNSparseMatrix_DiagonalBlocks(A, nblocks, offsets, B)) {
+    printf(">>> FAILED test -- SUNSparseMatrix_DiagonalBlocks returned nonzero\n");
+    return(1);
+  }
+
+  Ap = SUNSparseMatrix_IndexPointers(A);
+  Ai = SUNSparseMatrix_IndexValues(A);
+  Ax = SUNSparseMatrix_Data(A);
+
+  /* every block holds the entries of A inside the block and its diagonal */
+  for (b=0; b<nblocks && !failure; b++) {
+    s  = offsets[b];
+    e  = offsets[b+1];
+    Bp = SUNSparseMatrix_IndexPointers(B[b]);
+    Bi = SUNSparseMatrix_IndexValues(B[b]);
+    Bx = SUNSparseMatrix_Data(B[b]);
+    if (SUNSparseMatrix_Rows(B[b]) != e-s ||
+        SUNSparseMatrix_SparseType(B[b]) != SUNSparseMatrix_SparseType(A))
+      failure = 1;
+    for (k=s; k<e && !failure; k++) {
+      nin = 0;
+      for (p=Ap[k]; p<Ap[k+1]; p++)
+        if (Ai[p] >= s && Ai[p] < e) nin++;
+      hasdiag = SUNFALSE;
+      for (q=Bp[k-s]; q<Bp[k-s+1]; q++) {
+        if (Bi[q] == k-s) hasdiag = SUNTRUE;
+        aval = ZERO;
+        for (p=Ap[k]; p<Ap[k+1]; p++)
+          if (Ai[p] == Bi[q]+s) aval = Ax[p];
+        if (Bx[q] != aval) failure = 1;
+      }
+      if (!hasdiag || Bp[k-s+1]-Bp[k-s] < nin ||
+          Bp[k-s+1]-Bp[k-s] > nin+1)
+        failure = 1;
+    }
+  }
+
+  for (b=0; b<nblocks; b++) SUNMatDestroy(B[b]);
+
+  if (failure) {
+    printf(">>> FAILED test -- SUNSparseMatrix_DiagonalBlocks check failed\n");
+    return(1);
+  }
+
+  printf("    PASSED test -- SUNSparseMatrixDiagonalBlocks\n");
+  return(0);
+}
+
 /* ----------------------------------------------------------------------
  * Check matrix
  * --------------------------------------------------------------------*/
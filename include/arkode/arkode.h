@@ -29,6 +29,7 @@
 #define _ARKODE_H
 
 #include <stdio.h>
+#include <sundials/sundials_adaptcontroller.h>
 #include <sundials/sundials_context.h>
 #include <sundials/sundials_nvector.h>
 #include <arkode/arkode_butcher.h>
@@ -137,6 +138,8 @@ extern "C" {
 #define ARK_RELAX_FUNC_FAIL        -45
 #define ARK_RELAX_JAC_FAIL         -46
 
+#define ARK_CONTROLLER_ERR         -47
+
 
 #define ARK_UNRECOGNIZED_ERROR     -99
 
@@ -180,6 +183,9 @@ typedef int (*ARKRelaxFn)(N_Vector y, realtype* r, void* user_data);
 
 typedef int (*ARKRelaxJacFn)(N_Vector y, N_Vector J, void* user_data);
 
+typedef int (*ARKRelaxHessFn)(N_Vector y, N_Vector v, N_Vector Hv,
+                              void* user_data);
+
 /* --------------------------
  * MRIStep Inner Stepper Type
  * -------------------------- */
@@ -192,7 +198,8 @@ typedef _SUNDIALS_STRUCT_ _MRIStepInnerStepper *MRIStepInnerStepper;
 
 typedef enum {
   ARK_RELAX_BRENT,
-  ARK_RELAX_NEWTON
+  ARK_RELAX_NEWTON,
+  ARK_RELAX_QUADRATIC
 } ARKRelaxSolver;
 
 #ifdef __cplusplus
@@ -199,6 +199,8 @@ SUNDIALS_EXPORT int ARKStepSetAdaptivityMethod(void *arkode_mem,
 SUNDIALS_EXPORT int ARKStepSetAdaptivityFn(void *arkode_mem,
                                            ARKAdaptFn hfun,
                                            void *h_data);
+SUNDIALS_EXPORT int ARKStepSetAdaptController(void *arkode_mem,
+                                            SUNAdaptController C);
 SUNDIALS_EXPORT int ARKStepSetMaxFirstGrowth(void *arkode_mem,
                                              realtype etamx1);
 SUNDIALS_EXPORT int ARKStepSetMaxEFailGrowth(void *arkode_mem,
@@ -274,6 +276,8 @@ SUNDIALS_EXPORT int ARKStepSetStagePredictFn(void *arkode_mem,
 /* Linear solver interface optional input functions -- must be called
    AFTER ARKStepSetLinearSolver and/or ARKStepSetMassLinearSolver */
 SUNDIALS_EXPORT int ARKStepSetJacFn(void *arkode_mem, ARKLsJacFn jac);
+SUNDIALS_EXPORT int ARKStepSetJacSparsityPattern(void *arkode_mem,
+                                                 SUNMatrix P);
 SUNDIALS_EXPORT int ARKStepSetMassFn(void *arkode_mem, ARKLsMassFn mass);
 SUNDIALS_EXPORT int ARKStepSetJacEvalFrequency(void *arkode_mem,
                                                long int msbj);
@@ -478,6 +482,8 @@ SUNDIALS_EXPORT int ARKStepCreateMRIStepInnerStepper(void *arkode_mem,
 /* Relaxation functions */
 SUNDIALS_EXPORT int ARKStepSetRelaxFn(void* arkode_mem, ARKRelaxFn rfn,
                                       ARKRelaxJacFn rjac);
+SUNDIALS_EXPORT int ARKStepSetRelaxHessFn(void* arkode_mem,
+                                          ARKRelaxHessFn rhess);
 SUNDIALS_EXPORT int ARKStepSetRelaxEtaFail(void* arkode_mem,
                                            sunrealtype eta_rf);
 SUNDIALS_EXPORT int ARKStepSetRelaxLowerBound(void* arkode_mem,
@@ -496,6 +502,8 @@ SUNDIALS_EXPORT int ARKStepGetNumRelaxFnEvals(void* arkode_mem,
                                               long int* r_evals);
 SUNDIALS_EXPORT int ARKStepGetNumRelaxJacEvals(void* arkode_mem,
                                                long int* J_evals);
+SUNDIALS_EXPORT int ARKStepGetNumRelaxHessEvals(void* arkode_mem,
+                                                long int* H_evals);
 SUNDIALS_EXPORT int ARKStepGetNumRelaxFails(void* arkode_mem,
                                             long int* relax_fails);
 SUNDIALS_EXPORT int ARKStepGetNumRelaxBoundFails(void* arkode_mem,
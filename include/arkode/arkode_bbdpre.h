@@ -13,12 +13,15 @@
  * -----------------------------------------------------------------
  * This is the header file for the ARKBBDPRE module, for a
  * band-block-diagonal preconditioner, i.e. a block-diagonal
- * matrix with banded blocks.
+ * matrix with banded blocks, or with sparse blocks split into
+ * independent sub-blocks.
  * -----------------------------------------------------------------*/
 
 #ifndef _ARKBBDPRE_H
 #define _ARKBBDPRE_H
 
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
 #include <sundials/sundials_nvector.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
@@ -34,6 +37,9 @@ typedef int (*ARKLocalFn)(sunindextype Nlocal, realtype t,
 typedef int (*ARKCommFn)(sunindextype Nlocal, realtype t,
                          N_Vector y, void *user_data);
 
+typedef SUNLinearSolver (*ARKBBDLinSolFn)(N_Vector y, SUNMatrix A,
+                                          SUNContext sunctx);
+
 /* Exported Functions */
 
 SUNDIALS_EXPORT int ARKBBDPrecInit(void *arkode_mem,
@@ -46,6 +52,15 @@ SUNDIALS_EXPORT int ARKBBDPrecInit(void *arkode_mem,
                                    ARKLocalFn gloc,
                                    ARKCommFn cfn);
 
+SUNDIALS_EXPORT int ARKBBDPrecInitSparse(void *arkode_mem,
+                                         sunindextype Nlocal,
+                                         SUNMatrix Jpattern,
+                                         int nsub,
+                                         ARKBBDLinSolFn lsfn,
+                                         realtype dqrely,
+                                         ARKLocalFn gloc,
+                                         ARKCommFn cfn);
+
 SUNDIALS_EXPORT int ARKBBDPrecReInit(void *arkode_mem,
                                      sunindextype mudq,
                                      sunindextype mldq,
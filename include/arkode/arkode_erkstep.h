@@ -130,6 +130,8 @@ SUNDIALS_EXPORT int ERKStepSetAdaptivityMethod(void *arkode_mem,
 SUNDIALS_EXPORT int ERKStepSetAdaptivityFn(void *arkode_mem,
                                            ARKAdaptFn hfun,
                                            void *h_data);
+SUNDIALS_EXPORT int ERKStepSetAdaptController(void *arkode_mem,
+                                            SUNAdaptController C);
 SUNDIALS_EXPORT int ERKStepSetMaxFirstGrowth(void *arkode_mem,
                                              realtype etamx1);
 SUNDIALS_EXPORT int ERKStepSetMaxEFailGrowth(void *arkode_mem,
@@ -265,6 +267,8 @@ SUNDIALS_EXPORT void ERKStepPrintMem(void* arkode_mem, FILE* outfile);
 /* Relaxation functions */
 SUNDIALS_EXPORT int ERKStepSetRelaxFn(void* arkode_mem, ARKRelaxFn rfn,
                                       ARKRelaxJacFn rjac);
+SUNDIALS_EXPORT int ERKStepSetRelaxHessFn(void* arkode_mem,
+                                          ARKRelaxHessFn rhess);
 SUNDIALS_EXPORT int ERKStepSetRelaxEtaFail(void* arkode_mem,
                                            sunrealtype eta_rf);
 SUNDIALS_EXPORT int ERKStepSetRelaxLowerBound(void* arkode_mem,
@@ -283,6 +287,8 @@ SUNDIALS_EXPORT int ERKStepGetNumRelaxFnEvals(void* arkode_mem,
                                               long int* r_evals);
 SUNDIALS_EXPORT int ERKStepGetNumRelaxJacEvals(void* arkode_mem,
                                                long int* J_evals);
+SUNDIALS_EXPORT int ERKStepGetNumRelaxHessEvals(void* arkode_mem,
+                                                long int* H_evals);
 SUNDIALS_EXPORT int ERKStepGetNumRelaxFails(void* arkode_mem,
                                             long int* relax_fails);
 SUNDIALS_EXPORT int ERKStepGetNumRelaxBoundFails(void* arkode_mem,
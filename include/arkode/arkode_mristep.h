@@ -131,6 +131,17 @@ typedef int (*MRIStepInnerFullRhsFn)(MRIStepInnerStepper stepper,
 typedef int (*MRIStepInnerResetFn)(MRIStepInnerStepper stepper,
                                    realtype tR, N_Vector yR);
 
+typedef int (*MRIStepInnerSetFixedStepFn)(MRIStepInnerStepper stepper,
+                                          realtype hfixed);
+
+typedef int (*MRIStepInnerGetAccumulatedErrorFn)(MRIStepInnerStepper stepper,
+                                                 realtype *accum);
+
+typedef int (*MRIStepInnerResetAccumulatedErrorFn)(MRIStepInnerStepper stepper);
+
+typedef int (*MRIStepInnerGetEmbeddingOrderFn)(MRIStepInnerStepper stepper,
+                                               int *p);
+
 /*---------------------------------------------------------------
   MRI coupling data structure and associated utility routines
   ---------------------------------------------------------------*/
@@ -141,8 +152,12 @@ struct MRIStepCouplingMem
   int q;           /* method order of accuracy                          */
   int p;           /* embedding order of accuracy                       */
   realtype *c;     /* stage abscissae                                   */
-  realtype ***W;   /* explicit coupling matrices [nmat][stages][stages] */
-  realtype ***G;   /* implicit coupling matrices [nmat][stages][stages] */
+  realtype ***W;   /* explicit coupling matrices [nmat][stages+1][stages],
+                      row stages holds the embedding coefficients (NULL
+                      if the table has no embedding)                    */
+  realtype ***G;   /* implicit coupling matrices [nmat][stages+1][stages],
+                      row stages holds the embedding coefficients (NULL
+                      if the table has no embedding)                    */
 };
 
 typedef _SUNDIALS_STRUCT_ MRIStepCouplingMem *MRIStepCoupling;
@@ -163,6 +178,13 @@ SUNDIALS_EXPORT MRIStepCoupling MRIStepCoupling_Create(int nmat,
                                                        realtype *W,
                                                        realtype *G,
                                                        realtype *c);
+SUNDIALS_EXPORT MRIStepCoupling MRIStepCoupling_CreateEmbedded(int nmat,
+                                                               int stages,
+                                                               int q,
+                                                               int p,
+                                                               realtype *W,
+                                                               realtype *G,
+                                                               realtype *c);
 SUNDIALS_EXPORT MRIStepCoupling MRIStepCoupling_MIStoMRI(ARKodeButcherTable B,
                                                          int q, int p);
 SUNDIALS_EXPORT MRIStepCoupling MRIStepCoupling_Copy(MRIStepCoupling MRIC);
@@ -258,6 +280,18 @@ SUNDIALS_EXPORT int MRIStepSetInterpolateStopTime(void *arkode_mem,
 SUNDIALS_EXPORT int MRIStepClearStopTime(void *arkode_mem);
 SUNDIALS_EXPORT int MRIStepSetFixedStep(void *arkode_mem,
                                         realtype hsfixed);
+SUNDIALS_EXPORT int MRIStepSetInitStep(void *arkode_mem,
+                                       realtype hin);
+SUNDIALS_EXPORT int MRIStepSetMinStep(void *arkode_mem,
+                                      realtype hmin);
+SUNDIALS_EXPORT int MRIStepSetMaxStep(void *arkode_mem,
+                                      realtype hmax);
+SUNDIALS_EXPORT int MRIStepSetMaxErrTestFails(void *arkode_mem,
+                                              int maxnef);
+SUNDIALS_EXPORT int MRIStepSetAdaptController(void *arkode_mem,
+                                              SUNAdaptController C);
+SUNDIALS_EXPORT int MRIStepSetFastStepBudget(void *arkode_mem,
+                                             int budget, int max_budget);
 SUNDIALS_EXPORT int MRIStepSetRootDirection(void *arkode_mem,
                                             int *rootdir);
 SUNDIALS_EXPORT int MRIStepSetNoInactiveRootWarn(void *arkode_mem);
@@ -286,6 +320,8 @@ SUNDIALS_EXPORT int MRIStepSetDeduceImplicitRhs(void *arkode_mem,
 /* Linear solver interface optional input functions -- must be called
    AFTER MRIStepSetLinearSolver */
 SUNDIALS_EXPORT int MRIStepSetJacFn(void *arkode_mem, ARKLsJacFn jac);
+SUNDIALS_EXPORT int MRIStepSetJacSparsityPattern(void *arkode_mem,
+                                                 SUNMatrix P);
 SUNDIALS_EXPORT int MRIStepSetJacEvalFrequency(void *arkode_mem,
                                                long int msbj);
 SUNDIALS_EXPORT int MRIStepSetLinearSolutionScaling(void *arkode_mem,
@@ -329,6 +365,24 @@ SUNDIALS_EXPORT int MRIStepGetWorkSpace(void *arkode_mem,
                                         long int *leniw);
 SUNDIALS_EXPORT int MRIStepGetNumSteps(void *arkode_mem,
                                        long int *nssteps);
+SUNDIALS_EXPORT int MRIStepGetNumStepAttempts(void *arkode_mem,
+                                              long int *nstep_attempts);
+SUNDIALS_EXPORT int MRIStepGetNumErrTestFails(void *arkode_mem,
+                                              long int *netfails);
+SUNDIALS_EXPORT int MRIStepGetActualInitStep(void *arkode_mem,
+                                             realtype *hinused);
+SUNDIALS_EXPORT int MRIStepGetCurrentStep(void *arkode_mem,
+                                          realtype *hcur);
+SUNDIALS_EXPORT int MRIStepGetStepStats(void *arkode_mem,
+                                        long int *nssteps,
+                                        realtype *hinused,
+                                        realtype *hlast,
+                                        realtype *hcur,
+                                        realtype *tcur);
+SUNDIALS_EXPORT int MRIStepGetFastStepStats(void *arkode_mem,
+                                            int *budget,
+                                            realtype *fast_err,
+                                            long int *nfast_fails);
 SUNDIALS_EXPORT int MRIStepGetLastStep(void *arkode_mem,
                                        realtype *hlast);
 SUNDIALS_EXPORT int MRIStepGetCurrentTime(void *arkode_mem,
@@ -432,6 +486,18 @@ SUNDIALS_EXPORT int MRIStepInnerStepper_SetFullRhsFn(MRIStepInnerStepper stepper
 SUNDIALS_EXPORT int MRIStepInnerStepper_SetResetFn(MRIStepInnerStepper stepper,
                                                    MRIStepInnerResetFn fn);
 
+SUNDIALS_EXPORT int MRIStepInnerStepper_SetFixedStepFn(MRIStepInnerStepper stepper,
+                                                       MRIStepInnerSetFixedStepFn fn);
+
+SUNDIALS_EXPORT int MRIStepInnerStepper_SetAccumulatedErrorGetFn(MRIStepInnerStepper stepper,
+                                                                 MRIStepInnerGetAccumulatedErrorFn fn);
+
+SUNDIALS_EXPORT int MRIStepInnerStepper_SetAccumulatedErrorResetFn(MRIStepInnerStepper stepper,
+                                                                   MRIStepInnerResetAccumulatedErrorFn fn);
+
+SUNDIALS_EXPORT int MRIStepInnerStepper_SetEmbeddingOrderGetFn(MRIStepInnerStepper stepper,
+                                                               MRIStepInnerGetEmbeddingOrderFn fn);
+
 SUNDIALS_EXPORT int MRIStepInnerStepper_AddForcing(MRIStepInnerStepper stepper,
                                                    realtype t, N_Vector f);
 
@@ -202,6 +202,8 @@ SUNDIALS_EXPORT int CVodeGetNumLinSolvSetups(void *cvode_mem,
                                              long int *nlinsetups);
 SUNDIALS_EXPORT int CVodeGetNumErrTestFails(void *cvode_mem,
                                             long int *netfails);
+SUNDIALS_EXPORT int CVodeGetNumReductions(void *cvode_mem,
+                                          long int *nreduce);
 SUNDIALS_EXPORT int CVodeGetLastOrder(void *cvode_mem, int *qlast);
 SUNDIALS_EXPORT int CVodeGetCurrentOrder(void *cvode_mem, int *qcur);
 SUNDIALS_EXPORT int CVodeGetCurrentGamma(void *cvode_mem, realtype *gamma);
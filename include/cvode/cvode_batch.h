@@ -0,0 +1,118 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the batched (ensemble) mode of CVODE.
+ *
+ * A batched CVODE memory integrates nsys independent initial value
+ * problems of size neq with the BDF method. The systems are stored
+ * one after another in a single N_Vector of length nsys*neq (the
+ * block k occupies entries k*neq, ..., k*neq+neq-1). Every system
+ * has its own step size, order, local error test, and Newton
+ * convergence test; the systems advance in lockstep rounds in which
+ * the right-hand side, the Jacobian, and the linear solves are
+ * evaluated for all systems at once.
+ * -----------------------------------------------------------------*/
+
+#ifndef _CVODE_BATCH_H
+#define _CVODE_BATCH_H
+
+#include <stdio.h>
+#include <sundials/sundials_context.h>
+#include <sundials/sundials_nvector.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_linearsolver.h>
+#include <cvode/cvode.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* ------------------------------
+ * User-Supplied Function Types
+ * ------------------------------ */
+
+/* Evaluates the right-hand sides of all systems. t[k] is the time at
+   which block k of y is given. */
+typedef int (*CVBatchRhsFn)(const realtype *t, N_Vector y, N_Vector ydot,
+                            void *user_data);
+
+/* Evaluates the Jacobians of all systems into the blocks of the
+   block-diagonal matrix J. */
+typedef int (*CVBatchJacFn)(const realtype *t, N_Vector y, N_Vector fy,
+                            SUNMatrix J, void *user_data, N_Vector tmp1,
+                            N_Vector tmp2, N_Vector tmp3);
+
+/* -------------------
+ * Exported Functions
+ * ------------------- */
+
+/* Initialization functions */
+SUNDIALS_EXPORT void *CVodeBatchCreate(int nsys, sunindextype neq,
+                                       SUNContext sunctx);
+
+SUNDIALS_EXPORT int CVodeBatchInit(void *cvbatch_mem, CVBatchRhsFn f,
+                                   realtype t0, N_Vector y0);
+SUNDIALS_EXPORT int CVodeBatchReInit(void *cvbatch_mem, realtype t0,
+                                     N_Vector y0);
+
+/* Tolerance input functions */
+SUNDIALS_EXPORT int CVodeBatchSStolerances(void *cvbatch_mem, realtype reltol,
+                                           realtype abstol);
+SUNDIALS_EXPORT int CVodeBatchSVtolerances(void *cvbatch_mem, realtype reltol,
+                                           N_Vector abstol);
+
+/* Linear solver interface functions */
+SUNDIALS_EXPORT int CVodeBatchSetLinearSolver(void *cvbatch_mem,
+                                              SUNLinearSolver LS, SUNMatrix A);
+SUNDIALS_EXPORT int CVodeBatchSetJacFn(void *cvbatch_mem, CVBatchJacFn jac);
+
+/* Optional input functions */
+SUNDIALS_EXPORT int CVodeBatchSetUserData(void *cvbatch_mem, void *user_data);
+SUNDIALS_EXPORT int CVodeBatchSetErrFile(void *cvbatch_mem, FILE *errfp);
+SUNDIALS_EXPORT int CVodeBatchSetMaxOrd(void *cvbatch_mem, int maxord);
+SUNDIALS_EXPORT int CVodeBatchSetMaxNumSteps(void *cvbatch_mem, long int mxsteps);
+SUNDIALS_EXPORT int CVodeBatchSetInitStep(void *cvbatch_mem, realtype hin);
+SUNDIALS_EXPORT int CVodeBatchSetMaxStep(void *cvbatch_mem, realtype hmax);
+
+/* Integrate all systems to tout */
+SUNDIALS_EXPORT int CVodeBatch(void *cvbatch_mem, realtype tout, N_Vector yout,
+                               realtype *tret);
+
+/* Optional output functions for each system (arrays of length nsys) */
+SUNDIALS_EXPORT int CVodeBatchGetStatus(void *cvbatch_mem, int *status);
+SUNDIALS_EXPORT int CVodeBatchGetNumSteps(void *cvbatch_mem, long int *nsteps);
+SUNDIALS_EXPORT int CVodeBatchGetNumErrTestFails(void *cvbatch_mem,
+                                                 long int *netfails);
+SUNDIALS_EXPORT int CVodeBatchGetNumNonlinSolvIters(void *cvbatch_mem,
+                                                    long int *nniters);
+SUNDIALS_EXPORT int CVodeBatchGetNumNonlinSolvConvFails(void *cvbatch_mem,
+                                                        long int *nnfails);
+SUNDIALS_EXPORT int CVodeBatchGetLastOrder(void *cvbatch_mem, int *qlast);
+SUNDIALS_EXPORT int CVodeBatchGetCurrentOrder(void *cvbatch_mem, int *qcur);
+SUNDIALS_EXPORT int CVodeBatchGetLastStep(void *cvbatch_mem, realtype *hlast);
+SUNDIALS_EXPORT int CVodeBatchGetCurrentStep(void *cvbatch_mem, realtype *hcur);
+SUNDIALS_EXPORT int CVodeBatchGetCurrentTime(void *cvbatch_mem, realtype *tcur);
+
+/* Optional output functions for the whole batch */
+SUNDIALS_EXPORT int CVodeBatchGetNumRhsEvals(void *cvbatch_mem, long int *nfevals);
+SUNDIALS_EXPORT int CVodeBatchGetNumJacEvals(void *cvbatch_mem, long int *njevals);
+SUNDIALS_EXPORT int CVodeBatchGetNumLinSolvSetups(void *cvbatch_mem,
+                                                  long int *nlinsetups);
+SUNDIALS_EXPORT int CVodeBatchGetNumRounds(void *cvbatch_mem, long int *nrounds);
+
+/* Free function */
+SUNDIALS_EXPORT void CVodeBatchFree(void **cvbatch_mem);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -15,12 +15,15 @@
  * -----------------------------------------------------------------
  * This is the header file for the CVBBDPRE module, for a
  * band-block-diagonal preconditioner, i.e. a block-diagonal
- * matrix with banded blocks.
+ * matrix with banded blocks, or with sparse blocks split into
+ * independent sub-blocks.
  * -----------------------------------------------------------------*/
 
 #ifndef _CVBBDPRE_H
 #define _CVBBDPRE_H
 
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
 #include <sundials/sundials_nvector.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
@@ -36,6 +39,9 @@ typedef int (*CVLocalFn)(sunindextype Nlocal, realtype t,
 typedef int (*CVCommFn)(sunindextype Nlocal, realtype t,
                         N_Vector y, void *user_data);
 
+typedef SUNLinearSolver (*CVBBDLinSolFn)(N_Vector y, SUNMatrix A,
+                                         SUNContext sunctx);
+
 /* Exported Functions */
 
 SUNDIALS_EXPORT int CVBBDPrecInit(void *cvode_mem, sunindextype Nlocal,
@@ -43,10 +49,17 @@ SUNDIALS_EXPORT int CVBBDPrecInit(void *cvode_mem, sunindextype Nlocal,
                                   sunindextype mukeep, sunindextype mlkeep,
                                   realtype dqrely, CVLocalFn gloc, CVCommFn cfn);
 
+SUNDIALS_EXPORT int CVBBDPrecInitSparse(void *cvode_mem, sunindextype Nlocal,
+                                        SUNMatrix Jpattern, int nsub,
+                                        CVBBDLinSolFn lsfn, realtype dqrely,
+                                        CVLocalFn gloc, CVCommFn cfn);
+
 SUNDIALS_EXPORT int CVBBDPrecReInit(void *cvode_mem,
                                     sunindextype mudq, sunindextype mldq,
                                     realtype dqrely);
 
+SUNDIALS_EXPORT int CVBBDPrecSetNumThreads(void *cvode_mem, int num_threads);
+
 
 /* Optional output functions */
 
@@ -0,0 +1,49 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the CVILUPRE module, which provides
+ * an incomplete LU preconditioner built from a user-supplied
+ * sparse Jacobian.
+ * -----------------------------------------------------------------*/
+
+#ifndef _CVILUPRE_H
+#define _CVILUPRE_H
+
+#include <cvode/cvode_ls.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+
+/* ILUPrec inititialization function */
+
+SUNDIALS_EXPORT int CVILUPrecInit(void *cvode_mem, SUNMatrix J,
+                                  CVLsJacFn jac, int fill_level);
+
+/* Optional output functions */
+
+SUNDIALS_EXPORT int CVILUPrecGetWorkSpace(void *cvode_mem,
+                                          long int *lenrwLS,
+                                          long int *leniwLS);
+SUNDIALS_EXPORT int CVILUPrecGetNumJacEvals(void *cvode_mem,
+                                            long int *njevalsIP);
+SUNDIALS_EXPORT int CVILUPrecGetNumFactorizations(void *cvode_mem,
+                                                  long int *nfactIP);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
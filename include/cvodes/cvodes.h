@@ -18,6 +18,7 @@
 #define _CVODES_H
 
 #include <stdio.h>
+#include <sundials/sundials_checkpointstore.h>
 #include <sundials/sundials_context.h>
 #include <sundials/sundials_nvector.h>
 #include <sundials/sundials_nonlinearsolver.h>
@@ -564,6 +565,9 @@ SUNDIALS_EXPORT int CVodeB(void *cvode_mem, realtype tBout, int itaskB);
 /* Optional Input Functions For Adjoint Problems */
 
 SUNDIALS_EXPORT int CVodeSetAdjNoSensi(void *cvode_mem);
+SUNDIALS_EXPORT int CVodeSetAdjCheckpointStore(void *cvode_mem,
+                                               SUNCheckpointStore store);
+SUNDIALS_EXPORT int CVodeSetAdjCheckpointSlots(void *cvode_mem, int nslots);
 
 SUNDIALS_EXPORT int CVodeSetUserDataB(void *cvode_mem, int which,
                                       void *user_dataB);
@@ -611,6 +615,10 @@ typedef struct {
 
 SUNDIALS_EXPORT int CVodeGetAdjCheckPointsInfo(void *cvode_mem,
                                                CVadjCheckPointRec *ckpnt);
+SUNDIALS_EXPORT int CVodeGetAdjNumRecomputedSteps(void *cvode_mem,
+                                                  long int *nstR);
+SUNDIALS_EXPORT int CVodeGetAdjRecomputationRatio(void *cvode_mem,
+                                                  realtype *ratio);
 
 /* CVLS interface function that depends on CVRhsFn */
 int CVodeSetJacTimesRhsFnB(void *cvode_mem, int which, CVRhsFn jtimesRhsFn);
@@ -96,6 +96,7 @@ SUNDIALS_EXPORT int CVodeSetLinearSolver(void *cvode_mem,
   -----------------------------------------------------------------*/
 
 SUNDIALS_EXPORT int CVodeSetJacFn(void *cvode_mem, CVLsJacFn jac);
+SUNDIALS_EXPORT int CVodeSetJacSparsityPattern(void *cvode_mem, SUNMatrix P);
 SUNDIALS_EXPORT int CVodeSetJacEvalFrequency(void *cvode_mem,
                                              long int msbj);
 SUNDIALS_EXPORT int CVodeSetLinearSolutionScaling(void *cvode_mem,
@@ -237,6 +238,9 @@ SUNDIALS_EXPORT int CVodeSetJacFnB(void *cvode_mem, int which,
 SUNDIALS_EXPORT int CVodeSetJacFnBS(void *cvode_mem, int which,
                                     CVLsJacFnBS jacBS);
 
+SUNDIALS_EXPORT int CVodeSetJacSparsityPatternB(void *cvode_mem, int which,
+                                                SUNMatrix PB);
+
 SUNDIALS_EXPORT int CVodeSetEpsLinB(void *cvode_mem, int which,
                                     realtype eplifacB);
 
@@ -196,6 +196,7 @@ SUNDIALS_EXPORT int IDAGetNumSteps(void *ida_mem, long int *nsteps);
 SUNDIALS_EXPORT int IDAGetNumResEvals(void *ida_mem, long int *nrevals);
 SUNDIALS_EXPORT int IDAGetNumLinSolvSetups(void *ida_mem, long int *nlinsetups);
 SUNDIALS_EXPORT int IDAGetNumErrTestFails(void *ida_mem, long int *netfails);
+SUNDIALS_EXPORT int IDAGetNumReductions(void *ida_mem, long int *nreduce);
 SUNDIALS_EXPORT int IDAGetNumBacktrackOps(void *ida_mem, long int *nbacktr);
 SUNDIALS_EXPORT int IDAGetConsistentIC(void *ida_mem, N_Vector yy0_mod,
                                        N_Vector yp0_mod);
@@ -14,12 +14,15 @@
  * -----------------------------------------------------------------
  * This is the header file for the IDABBDPRE module, for a
  * band-block-diagonal preconditioner, i.e. a block-diagonal
- * matrix with banded blocks.
+ * matrix with banded blocks, or with sparse blocks split into
+ * independent sub-blocks.
  * -----------------------------------------------------------------*/
 
 #ifndef _IDABBDPRE_H
 #define _IDABBDPRE_H
 
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
 #include <sundials/sundials_nvector.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
@@ -36,6 +39,9 @@ typedef int (*IDABBDLocalFn)(sunindextype Nlocal, realtype tt,
 typedef int (*IDABBDCommFn)(sunindextype Nlocal, realtype tt,
                             N_Vector yy, N_Vector yp, void *user_data);
 
+typedef SUNLinearSolver (*IDABBDLinSolFn)(N_Vector y, SUNMatrix A,
+                                          SUNContext sunctx);
+
 /* Exported Functions */
 
 SUNDIALS_EXPORT int IDABBDPrecInit(void *ida_mem, sunindextype Nlocal,
@@ -44,6 +50,13 @@ SUNDIALS_EXPORT int IDABBDPrecInit(void *ida_mem, sunindextype Nlocal,
                                    realtype dq_rel_yy,
                                    IDABBDLocalFn Gres, IDABBDCommFn Gcomm);
 
+SUNDIALS_EXPORT int IDABBDPrecInitSparse(void *ida_mem, sunindextype Nlocal,
+                                         SUNMatrix Jpattern, int nsub,
+                                         IDABBDLinSolFn lsfn,
+                                         realtype dq_rel_yy,
+                                         IDABBDLocalFn Gres,
+                                         IDABBDCommFn Gcomm);
+
 SUNDIALS_EXPORT int IDABBDPrecReInit(void *ida_mem,
                                      sunindextype mudq, sunindextype mldq,
                                      realtype dq_rel_yy);
@@ -0,0 +1,47 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the IDAILUPRE module, which provides
+ * an incomplete LU preconditioner built from a user-supplied
+ * sparse Jacobian.
+ * -----------------------------------------------------------------*/
+
+#ifndef _IDAILUPRE_H
+#define _IDAILUPRE_H
+
+#include <ida/ida_ls.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Exported Functions */
+
+SUNDIALS_EXPORT int IDAILUPrecInit(void *ida_mem, SUNMatrix J,
+                                   IDALsJacFn jac, int fill_level);
+
+/* Optional output functions */
+
+SUNDIALS_EXPORT int IDAILUPrecGetWorkSpace(void *ida_mem,
+                                           long int *lenrwILU,
+                                           long int *leniwILU);
+SUNDIALS_EXPORT int IDAILUPrecGetNumJacEvals(void *ida_mem,
+                                             long int *njevalsILU);
+SUNDIALS_EXPORT int IDAILUPrecGetNumFactorizations(void *ida_mem,
+                                                   long int *nfactILU);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -90,6 +90,7 @@ SUNDIALS_EXPORT int IDASetLinearSolver(void *ida_mem,
   -----------------------------------------------------------------*/
 
 SUNDIALS_EXPORT int IDASetJacFn(void *ida_mem, IDALsJacFn jac);
+SUNDIALS_EXPORT int IDASetJacSparsityPattern(void *ida_mem, SUNMatrix P);
 SUNDIALS_EXPORT int IDASetPreconditioner(void *ida_mem,
                                          IDALsPrecSetupFn pset,
                                          IDALsPrecSolveFn psolve);
@@ -18,6 +18,7 @@
 #define _IDAS_H
 
 #include <stdio.h>
+#include <sundials/sundials_checkpointstore.h>
 #include <sundials/sundials_context.h>
 #include <sundials/sundials_nvector.h>
 #include <sundials/sundials_nonlinearsolver.h>
@@ -549,6 +550,9 @@ SUNDIALS_EXPORT int IDASolveB(void *ida_mem, realtype tBout, int itaskB);
 /* Optional Input Functions For Adjoint Problems */
 
 SUNDIALS_EXPORT int IDAAdjSetNoSensi(void *ida_mem);
+SUNDIALS_EXPORT int IDAAdjSetCheckpointStore(void *ida_mem,
+                                             SUNCheckpointStore store);
+SUNDIALS_EXPORT int IDAAdjSetCheckpointSlots(void *ida_mem, int nslots);
 
 SUNDIALS_EXPORT int IDASetUserDataB(void *ida_mem, int which, void *user_dataB);
 SUNDIALS_EXPORT int IDASetMaxOrdB(void *ida_mem, int which, int maxordB);
@@ -595,6 +599,10 @@ typedef struct {
 
 SUNDIALS_EXPORT int IDAGetAdjCheckPointsInfo(void *ida_mem,
                                              IDAadjCheckPointRec *ckpnt);
+SUNDIALS_EXPORT int IDAGetAdjNumRecomputedSteps(void *ida_mem,
+                                                long int *nstR);
+SUNDIALS_EXPORT int IDAGetAdjRecomputationRatio(void *ida_mem,
+                                                realtype *ratio);
 
 /* IDALS interface function that depends on IDAResFn */
 SUNDIALS_EXPORT int IDASetJacTimesResFnB(void *ida_mem, int which,
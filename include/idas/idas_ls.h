@@ -97,6 +97,7 @@ SUNDIALS_EXPORT int IDASetLinearSolver(void *ida_mem,
   -----------------------------------------------------------------*/
 
 SUNDIALS_EXPORT int IDASetJacFn(void *ida_mem, IDALsJacFn jac);
+SUNDIALS_EXPORT int IDASetJacSparsityPattern(void *ida_mem, SUNMatrix P);
 SUNDIALS_EXPORT int IDASetPreconditioner(void *ida_mem,
                                          IDALsPrecSetupFn pset,
                                          IDALsPrecSolveFn psolve);
@@ -237,6 +238,8 @@ SUNDIALS_EXPORT int IDASetJacFnB(void *ida_mem, int which,
                                  IDALsJacFnB jacB);
 SUNDIALS_EXPORT int IDASetJacFnBS(void *ida_mem, int which,
                                   IDALsJacFnBS jacBS);
+SUNDIALS_EXPORT int IDASetJacSparsityPatternB(void *ida_mem, int which,
+                                              SUNMatrix PB);
 
 SUNDIALS_EXPORT int IDASetEpsLinB(void *ida_mem, int which,
                                   realtype eplifacB);
@@ -15,12 +15,15 @@
  * -----------------------------------------------------------------
  * This is the header file for the KINBBDPRE module, for a
  * band-block-diagonal preconditioner, i.e. a block-diagonal
- * matrix with banded blocks.
+ * matrix with banded blocks, or with sparse blocks split into
+ * independent sub-blocks.
  * -----------------------------------------------------------------*/
 
 #ifndef _KINBBDPRE_H
 #define _KINBBDPRE_H
 
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
 #include <sundials/sundials_nvector.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
@@ -41,6 +44,9 @@ typedef int (*KINBBDCommFn)(sunindextype Nlocal, N_Vector u,
 typedef int (*KINBBDLocalFn)(sunindextype Nlocal, N_Vector uu,
                              N_Vector gval, void *user_data);
 
+typedef SUNLinearSolver (*KINBBDLinSolFn)(N_Vector y, SUNMatrix A,
+                                          SUNContext sunctx);
+
 /* Exported Functions */
 
 SUNDIALS_EXPORT int KINBBDPrecInit(void *kinmem, sunindextype Nlocal,
@@ -49,6 +55,13 @@ SUNDIALS_EXPORT int KINBBDPrecInit(void *kinmem, sunindextype Nlocal,
                                    realtype dq_rel_uu,
                                    KINBBDLocalFn gloc, KINBBDCommFn gcomm);
 
+SUNDIALS_EXPORT int KINBBDPrecInitSparse(void *kinmem, sunindextype Nlocal,
+                                         SUNMatrix Jpattern, int nsub,
+                                         KINBBDLinSolFn lsfn,
+                                         realtype dq_rel_uu,
+                                         KINBBDLocalFn gloc,
+                                         KINBBDCommFn gcomm);
+
 /* Optional output functions */
 
 SUNDIALS_EXPORT int KINBBDPrecGetWorkSpace(void *kinmem,
@@ -0,0 +1,47 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the KINILUPRE module, which provides
+ * an incomplete LU preconditioner built from a user-supplied
+ * sparse Jacobian.
+ * -----------------------------------------------------------------*/
+
+#ifndef _KINILUPRE_H
+#define _KINILUPRE_H
+
+#include <kinsol/kinsol_ls.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Exported Functions */
+
+SUNDIALS_EXPORT int KINILUPrecInit(void *kinmem, SUNMatrix J,
+                                   KINLsJacFn jac, int fill_level);
+
+/* Optional output functions */
+
+SUNDIALS_EXPORT int KINILUPrecGetWorkSpace(void *kinmem,
+                                           long int *lenrwILU,
+                                           long int *leniwILU);
+SUNDIALS_EXPORT int KINILUPrecGetNumJacEvals(void *kinmem,
+                                             long int *njevalsILU);
+SUNDIALS_EXPORT int KINILUPrecGetNumFactorizations(void *kinmem,
+                                                   long int *nfactILU);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
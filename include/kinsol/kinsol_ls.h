@@ -78,6 +78,7 @@ SUNDIALS_EXPORT int KINSetLinearSolver(void *kinmem, SUNLinearSolver LS,
   -----------------------------------------------------------------*/
 
 SUNDIALS_EXPORT int KINSetJacFn(void *kinmem, KINLsJacFn jac);
+SUNDIALS_EXPORT int KINSetJacSparsityPattern(void *kinmem, SUNMatrix P);
 SUNDIALS_EXPORT int KINSetPreconditioner(void *kinmem,
                                          KINLsPrecSetupFn psetup,
                                          KINLsPrecSolveFn psolve);
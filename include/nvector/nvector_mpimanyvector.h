@@ -56,6 +56,7 @@ struct _N_VectorContent_MPIManyVector {
   sunindextype  global_length;   /* overall global manyvector length */
   N_Vector*     subvec_array;    /* pointer to N_Vector array        */
   booleantype   own_data;        /* flag indicating data ownership   */
+  MPI_Request   request;         /* pending split-phase reduction    */
 };
 
 typedef struct _N_VectorContent_MPIManyVector *N_VectorContent_MPIManyVector;
@@ -140,6 +141,11 @@ SUNDIALS_EXPORT int N_VDotProdMultiAllReduce_MPIManyVector(int nvec_total,
                                                            N_Vector x,
                                                            realtype* sum);
 
+/* split-phase buffer reduction operations */
+SUNDIALS_EXPORT int N_VAllReduceStart_MPIManyVector(int nvec, N_Vector x,
+                                                    realtype* buf, int op);
+SUNDIALS_EXPORT int N_VAllReduceFinish_MPIManyVector(N_Vector x);
+
 /* vector array operations */
 SUNDIALS_EXPORT int N_VLinearSumVectorArray_MPIManyVector(int nvec,
                                                           realtype a, N_Vector* X,
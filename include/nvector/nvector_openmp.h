@@ -43,6 +43,7 @@
 #define _NVECTOR_OPENMP_H
 
 #include <stdio.h>
+#include <sundials/sundials_memory.h>
 #include <sundials/sundials_nvector.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
@@ -60,6 +61,8 @@ struct _N_VectorContent_OpenMP {
   booleantype own_data;  /* data ownership flag      */
   realtype *data;        /* data array               */
   int num_threads;       /* number of OpenMP threads */
+  SUNMemoryHelper mem_helper; /* helper that allocated the data (if any) */
+  SUNMemory mem;              /* memory of the data from mem_helper      */
 };
 
 typedef struct _N_VectorContent_OpenMP *N_VectorContent_OpenMP;
@@ -59,6 +59,7 @@ struct _N_VectorContent_Parallel {
   booleantype own_data;        /* ownership of data           */
   realtype *data;              /* local data array            */
   MPI_Comm comm;               /* pointer to MPI communicator */
+  MPI_Request request;         /* pending split-phase reduction */
 };
 
 typedef struct _N_VectorContent_Parallel *N_VectorContent_Parallel;
@@ -198,6 +199,11 @@ SUNDIALS_EXPORT int N_VDotProdMultiLocal_Parallel(int nvec, N_Vector x,
 SUNDIALS_EXPORT int N_VDotProdMultiAllReduce_Parallel(int nvec_total, N_Vector x,
                                                       realtype* dotprods);
 
+/* OPTIONAL split-phase buffer reduction operations */
+SUNDIALS_EXPORT int N_VAllReduceStart_Parallel(int nvec, N_Vector x,
+                                               realtype* buf, int op);
+SUNDIALS_EXPORT int N_VAllReduceFinish_Parallel(N_Vector x);
+
 /* OPTIONAL XBraid interface operations */
 SUNDIALS_EXPORT int N_VBufSize_Parallel(N_Vector x, sunindextype *size);
 SUNDIALS_EXPORT int N_VBufPack_Parallel(N_Vector x, void *buf);
@@ -45,6 +45,7 @@
 
 #include <stdio.h>
 #include <pthread.h>
+#include <sundials/sundials_memory.h>
 #include <sundials/sundials_nvector.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
@@ -57,15 +58,31 @@ extern "C" {
  * -----------------------------------------------------------------
  */
 
+/* Persistent pool of worker threads used to execute the vector
+   operations. The pool is created with a vector, shared by all of its
+   clones, and destroyed with the last vector referencing it. */
+
+typedef struct _N_VThreadPool_Pthreads *N_VThreadPool_Pthreads;
+
 struct _N_VectorContent_Pthreads {
-  sunindextype length;   /* vector length           */
-  booleantype own_data;  /* data ownership flag     */
-  realtype *data;        /* data array              */
-  int num_threads;       /* number of POSIX threads */
+  sunindextype length;          /* vector length           */
+  booleantype own_data;         /* data ownership flag     */
+  realtype *data;               /* data array              */
+  int num_threads;              /* number of POSIX threads */
+  N_VThreadPool_Pthreads pool;  /* worker thread pool      */
+  SUNMemoryHelper mem_helper;   /* helper that allocated data (if any) */
+  SUNMemory mem;                /* memory of data from mem_helper      */
 };
 
 typedef struct _N_VectorContent_Pthreads *N_VectorContent_Pthreads;
 
+/* Body of a loop run on the thread pool by N_VParallelFor_Pthreads. It is
+   called once per thread with the index range [start, end) and the task
+   number of the thread. */
+
+typedef void (*N_VLoopBody_Pthreads)(sunindextype start, sunindextype end,
+                                     int task, void* data);
+
 /* Structure to hold parallelization information for each thread when
    calling "companion" functions to compute vector operations. The
    start and end vector (loop) indices are unique to each thread, the
@@ -95,6 +112,10 @@ struct _Pthreads_Data{
 
   N_Vector** ZZ1;  /* array of vector arrays in fused op */
   N_Vector** ZZ2;  /* array of vector arrays in fused op */
+
+  int task;                        /* task index in a user loop */
+  N_VLoopBody_Pthreads loop_body;  /* user loop body            */
+  void* loop_data;                 /* user loop data            */
 };
 
 typedef struct _Pthreads_Data Pthreads_Data;
@@ -112,6 +133,8 @@ typedef struct _Pthreads_Data Pthreads_Data;
 
 #define NV_NUM_THREADS_PT(v)   ( NV_CONTENT_PT(v)->num_threads )
 
+#define NV_POOL_PT(v)          ( NV_CONTENT_PT(v)->pool )
+
 #define NV_OWN_DATA_PT(v)      ( NV_CONTENT_PT(v)->own_data )
 
 #define NV_DATA_PT(v)          ( NV_CONTENT_PT(v)->data )
@@ -243,6 +266,18 @@ SUNDIALS_EXPORT int N_VEnableScaleAddMultiVectorArray_Pthreads(N_Vector v,
 SUNDIALS_EXPORT int N_VEnableLinearCombinationVectorArray_Pthreads(N_Vector v,
                                                                    booleantype tf);
 
+/*
+ * -----------------------------------------------------------------
+ * Thread pool options
+ * -----------------------------------------------------------------
+ */
+
+SUNDIALS_EXPORT int N_VEnableThreadPinning_Pthreads(N_Vector v, booleantype tf);
+
+SUNDIALS_EXPORT int N_VParallelFor_Pthreads(N_Vector v,
+                                            N_VLoopBody_Pthreads body,
+                                            void* data);
+
 /*
  * -----------------------------------------------------------------
  * Deprecated functions
@@ -39,6 +39,7 @@
 #define _NVECTOR_SERIAL_H
 
 #include <stdio.h>
+#include <sundials/sundials_memory.h>
 #include <sundials/sundials_nvector.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
@@ -55,6 +56,8 @@ struct _N_VectorContent_Serial {
   sunindextype length;   /* vector length       */
   booleantype own_data;  /* data ownership flag */
   realtype *data;        /* data array          */
+  SUNMemoryHelper mem_helper; /* helper that allocated the data (if any) */
+  SUNMemory mem;              /* memory of the data from mem_helper      */
 };
 
 typedef struct _N_VectorContent_Serial *N_VectorContent_Serial;
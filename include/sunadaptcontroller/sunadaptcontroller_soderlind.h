@@ -0,0 +1,132 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * This is the header file for the SUNAdaptController module implementing the
+ * general digital filter step size controllers of G. Söderlind, "Digital
+ * filters in adaptive time-stepping", ACM TOMS 29(1), 2003. Given the current
+ * (biased) error estimate e_n of a method of order p, the new step size is
+ *
+ *   h' = h_n e_n^(-k1/p) e_{n-1}^(-k2/p) e_{n-2}^(-k3/p)
+ *            (h_n/h_{n-1})^k4 (h_{n-1}/h_{n-2})^k5
+ *
+ * where the previous errors and steps are kept in the controller's history
+ * buffer. Special choices of the parameters k1-k5 give the classical I, PI,
+ * PID, and Gustafsson controllers and the H0211, H0321, H211, and H312
+ * filters.
+ *
+ * Part I defines the controller-specific content structure.
+ *
+ * Part II contains prototypes for the controller constructors and operations.
+ * ---------------------------------------------------------------------------*/
+
+#ifndef _SUNADAPTCONTROLLER_SODERLIND_H
+#define _SUNADAPTCONTROLLER_SODERLIND_H
+
+#include <stdio.h>
+#include <sundials/sundials_adaptcontroller.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------------------------------------------------------------------
+ * I. Content structure
+ * ---------------------------------------------------------------------------*/
+
+struct _SUNAdaptControllerContent_Soderlind {
+  realtype k1, k2, k3, k4, k5; /* filter parameters                         */
+  realtype ep, epp;            /* error history (biased error estimates)    */
+  realtype hp, hpp;            /* step size history                         */
+  int      firststeps;         /* number of accepted steps in the history   */
+};
+
+typedef struct _SUNAdaptControllerContent_Soderlind *SUNAdaptControllerContent_Soderlind;
+
+/* -----------------------------------------------------------------------------
+ * II: Exported functions
+ * ---------------------------------------------------------------------------*/
+
+/* General Soderlind controller (defaults to a PID controller) */
+SUNDIALS_EXPORT
+SUNAdaptController SUNAdaptController_Soderlind(SUNContext sunctx);
+SUNDIALS_EXPORT
+int SUNAdaptController_SetParams_Soderlind(SUNAdaptController C,
+                                           realtype k1, realtype k2,
+                                           realtype k3, realtype k4,
+                                           realtype k5);
+
+/* Classical controllers */
+SUNDIALS_EXPORT
+SUNAdaptController SUNAdaptController_PID(SUNContext sunctx);
+SUNDIALS_EXPORT
+int SUNAdaptController_SetParams_PID(SUNAdaptController C, realtype k1,
+                                     realtype k2, realtype k3);
+
+SUNDIALS_EXPORT
+SUNAdaptController SUNAdaptController_PI(SUNContext sunctx);
+SUNDIALS_EXPORT
+int SUNAdaptController_SetParams_PI(SUNAdaptController C, realtype k1,
+                                    realtype k2);
+
+SUNDIALS_EXPORT
+SUNAdaptController SUNAdaptController_I(SUNContext sunctx);
+SUNDIALS_EXPORT
+int SUNAdaptController_SetParams_I(SUNAdaptController C, realtype k1);
+
+SUNDIALS_EXPORT
+SUNAdaptController SUNAdaptController_ExpGus(SUNContext sunctx);
+SUNDIALS_EXPORT
+int SUNAdaptController_SetParams_ExpGus(SUNAdaptController C, realtype k1,
+                                        realtype k2);
+
+SUNDIALS_EXPORT
+SUNAdaptController SUNAdaptController_ImpGus(SUNContext sunctx);
+SUNDIALS_EXPORT
+int SUNAdaptController_SetParams_ImpGus(SUNAdaptController C, realtype k1,
+                                        realtype k2);
+
+/* Digital filter controllers */
+SUNDIALS_EXPORT
+SUNAdaptController SUNAdaptController_H0211(SUNContext sunctx);
+SUNDIALS_EXPORT
+SUNAdaptController SUNAdaptController_H0321(SUNContext sunctx);
+SUNDIALS_EXPORT
+SUNAdaptController SUNAdaptController_H211(SUNContext sunctx);
+SUNDIALS_EXPORT
+SUNAdaptController SUNAdaptController_H312(SUNContext sunctx);
+
+/* core functions */
+SUNDIALS_EXPORT
+SUNAdaptController_Type SUNAdaptController_GetType_Soderlind(SUNAdaptController C);
+SUNDIALS_EXPORT
+int SUNAdaptController_EstimateStep_Soderlind(SUNAdaptController C, realtype h,
+                                              int p, realtype dsm,
+                                              realtype* hnew);
+SUNDIALS_EXPORT
+int SUNAdaptController_UpdateH_Soderlind(SUNAdaptController C, realtype h,
+                                         realtype dsm);
+SUNDIALS_EXPORT
+int SUNAdaptController_Reset_Soderlind(SUNAdaptController C);
+SUNDIALS_EXPORT
+int SUNAdaptController_SetDefaults_Soderlind(SUNAdaptController C);
+SUNDIALS_EXPORT
+int SUNAdaptController_Write_Soderlind(SUNAdaptController C, FILE* fptr);
+SUNDIALS_EXPORT
+int SUNAdaptController_Space_Soderlind(SUNAdaptController C, long int* lenrw,
+                                       long int* leniw);
+SUNDIALS_EXPORT
+int SUNAdaptController_Destroy_Soderlind(SUNAdaptController C);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,146 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * This is the header file for a generic time step adaptivity controller
+ * package. It defines the SUNAdaptController structure
+ * (_generic_SUNAdaptController) which contains the following fields:
+ *   - an implementation-dependent 'content' field which contains any internal
+ *     data required by the controller, e.g., its error and step size history
+ *   - an 'ops' field which contains a structure listing operations acting on
+ *     such controllers
+ * -----------------------------------------------------------------------------
+ * This header file contains:
+ *   - enumeration constants for SUNDIALS-defined controller types,
+ *   - type declarations for the _generic_SUNAdaptController and
+ *     _generic_SUNAdaptController_Ops structures, as well as references to
+ *     pointers to such structures (SUNAdaptController),
+ *   - prototypes for the controller functions which operate on
+ *     SUNAdaptController objects, and
+ *   - return codes for SUNAdaptController objects.
+ * -----------------------------------------------------------------------------
+ * At a minimum, a particular implementation of a SUNAdaptController must do
+ * the following:
+ *   - specify the 'content' field of a SUNAdaptController,
+ *   - implement the operations on those SUNAdaptController objects,
+ *   - provide a constructor routine for new SUNAdaptController objects
+ *
+ * Additionally, a SUNAdaptController implementation may provide "Set"
+ * routines to control implementation-specific parameters.
+ * ---------------------------------------------------------------------------*/
+
+#ifndef _SUNADAPTCONTROLLER_H
+#define _SUNADAPTCONTROLLER_H
+
+#include <stdio.h>
+#include <sundials/sundials_context.h>
+#include <sundials/sundials_types.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------------------------------------------------------------------
+ * SUNAdaptController types
+ * ---------------------------------------------------------------------------*/
+
+typedef enum
+{
+  SUN_ADAPTCONTROLLER_NONE, /* controller does not adapt anything  */
+  SUN_ADAPTCONTROLLER_H     /* controller adapts a single step size */
+} SUNAdaptController_Type;
+
+/* -----------------------------------------------------------------------------
+ * Generic definition of SUNAdaptController
+ * ---------------------------------------------------------------------------*/
+
+/* Forward reference for pointer to SUNAdaptController_Ops object */
+typedef _SUNDIALS_STRUCT_ _generic_SUNAdaptController_Ops* SUNAdaptController_Ops;
+
+/* Forward reference for pointer to SUNAdaptController object */
+typedef _SUNDIALS_STRUCT_ _generic_SUNAdaptController* SUNAdaptController;
+
+/* Structure containing function pointers to controller operations */
+struct _generic_SUNAdaptController_Ops
+{
+  SUNAdaptController_Type (*gettype)(SUNAdaptController C);
+  int (*estimatestep)(SUNAdaptController C, realtype h, int p, realtype dsm,
+                      realtype* hnew);
+  int (*updateh)(SUNAdaptController C, realtype h, realtype dsm);
+  int (*reset)(SUNAdaptController C);
+  int (*setdefaults)(SUNAdaptController C);
+  int (*write)(SUNAdaptController C, FILE* fptr);
+  int (*space)(SUNAdaptController C, long int* lenrw, long int* leniw);
+  int (*destroy)(SUNAdaptController C);
+#ifdef __cplusplus
+  _generic_SUNAdaptController_Ops() = default;
+#endif
+};
+
+/* A controller is a structure with an implementation-dependent 'content'
+   field, and a pointer to a structure of controller operations corresponding
+   to that implementation. */
+struct _generic_SUNAdaptController
+{
+  void* content;
+  SUNAdaptController_Ops ops;
+  SUNContext sunctx;
+#ifdef __cplusplus
+  _generic_SUNAdaptController() = default;
+#endif
+};
+
+/* -----------------------------------------------------------------------------
+ * Functions exported by SUNAdaptController module
+ * ---------------------------------------------------------------------------*/
+
+/* empty constructor/destructor */
+SUNDIALS_EXPORT SUNAdaptController SUNAdaptController_NewEmpty(SUNContext sunctx);
+SUNDIALS_EXPORT void SUNAdaptController_DestroyEmpty(SUNAdaptController C);
+
+/* core functions */
+SUNDIALS_EXPORT SUNAdaptController_Type
+SUNAdaptController_GetType(SUNAdaptController C);
+
+SUNDIALS_EXPORT int SUNAdaptController_EstimateStep(SUNAdaptController C,
+                                                    realtype h, int p,
+                                                    realtype dsm,
+                                                    realtype* hnew);
+
+SUNDIALS_EXPORT int SUNAdaptController_UpdateH(SUNAdaptController C,
+                                               realtype h, realtype dsm);
+
+SUNDIALS_EXPORT int SUNAdaptController_Reset(SUNAdaptController C);
+
+SUNDIALS_EXPORT int SUNAdaptController_SetDefaults(SUNAdaptController C);
+
+SUNDIALS_EXPORT int SUNAdaptController_Write(SUNAdaptController C,
+                                             FILE* fptr);
+
+SUNDIALS_EXPORT int SUNAdaptController_Space(SUNAdaptController C,
+                                             long int* lenrw,
+                                             long int* leniw);
+
+SUNDIALS_EXPORT int SUNAdaptController_Destroy(SUNAdaptController C);
+
+/* -----------------------------------------------------------------------------
+ * SUNAdaptController return values
+ * ---------------------------------------------------------------------------*/
+
+#define SUNADAPTCONTROLLER_SUCCESS             0 /* function successful         */
+#define SUNADAPTCONTROLLER_ILL_INPUT       -1001 /* illegal function input      */
+#define SUNADAPTCONTROLLER_MEM_FAIL        -1002 /* failed memory allocation    */
+#define SUNADAPTCONTROLLER_OPERATION_FAIL  -1003 /* failed controller operation */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
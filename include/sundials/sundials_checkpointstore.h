@@ -0,0 +1,120 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * SUNDIALS checkpoint stores. A checkpoint store keeps blocks of
+ * bytes identified by an integer key, e.g., the check point data
+ * of the CVODES and IDAS adjoint modules.
+ * ----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_CHECKPOINTSTORE_H
+#define _SUNDIALS_CHECKPOINTSTORE_H
+
+#include <stdlib.h>
+
+#include <sundials/sundials_context.h>
+#include <sundials/sundials_types.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+typedef struct _SUNCheckpointStore_Ops *SUNCheckpointStore_Ops;
+typedef struct _SUNCheckpointStore *SUNCheckpointStore;
+
+struct _SUNCheckpointStore
+{
+  void*                  content;
+  SUNCheckpointStore_Ops ops;
+  SUNContext             sunctx;
+};
+
+struct _SUNCheckpointStore_Ops
+{
+  /* operations that implementations are required to provide */
+  int (*write)(SUNCheckpointStore, long int key, void* buf, size_t bytes);
+  int (*read)(SUNCheckpointStore, long int key, void* buf, size_t bytes);
+  int (*remove)(SUNCheckpointStore, long int key);
+  int (*destroy)(SUNCheckpointStore);
+
+  /* optional operations */
+  int (*prefetch)(SUNCheckpointStore, long int key);
+  int (*getmemoryusage)(SUNCheckpointStore, size_t* bytes);
+};
+
+/*
+ * Required SUNCheckpointStore operations.
+ */
+
+/* Stores a copy of bytes bytes from buf under key (replacing any
+ * data already stored under key). The buffer may be reused once the
+ * function returns. */
+SUNDIALS_EXPORT
+int SUNCheckpointStore_Write(SUNCheckpointStore store, long int key, void* buf,
+                             size_t bytes);
+
+/* Copies the bytes bytes stored under key into buf */
+SUNDIALS_EXPORT
+int SUNCheckpointStore_Read(SUNCheckpointStore store, long int key, void* buf,
+                            size_t bytes);
+
+/* Releases the data stored under key */
+SUNDIALS_EXPORT
+int SUNCheckpointStore_Remove(SUNCheckpointStore store, long int key);
+
+/* Frees the SUNCheckpointStore and all data it holds */
+SUNDIALS_EXPORT
+int SUNCheckpointStore_Destroy(SUNCheckpointStore store);
+
+/*
+ * Optional SUNCheckpointStore operations.
+ */
+
+/* Hints that the data stored under key will be read soon */
+SUNDIALS_EXPORT
+int SUNCheckpointStore_Prefetch(SUNCheckpointStore store, long int key);
+
+/* Returns the number of bytes of stored data currently held in memory */
+SUNDIALS_EXPORT
+int SUNCheckpointStore_GetMemoryUsage(SUNCheckpointStore store, size_t* bytes);
+
+/*
+ * Utility SUNCheckpointStore functions.
+ */
+
+/* Creates an empty SUNCheckpointStore object */
+SUNDIALS_EXPORT SUNCheckpointStore SUNCheckpointStore_NewEmpty(SUNContext sunctx);
+
+/* Frees an empty SUNCheckpointStore object (the content is not freed) */
+SUNDIALS_EXPORT void SUNCheckpointStore_FreeEmpty(SUNCheckpointStore store);
+
+/*
+ * Checkpoint store implementations.
+ */
+
+/* Keeps an uncompressed copy of the data in memory */
+SUNDIALS_EXPORT SUNCheckpointStore SUNCheckpointStore_Memory(SUNContext sunctx);
+
+/* Keeps a losslessly compressed copy of the data in memory */
+SUNDIALS_EXPORT
+SUNCheckpointStore SUNCheckpointStore_CompressedMemory(SUNContext sunctx);
+
+/* Streams the data to a scratch file (a temporary file if filename is
+ * NULL). When SUNDIALS is built with Pthreads, writes and prefetches
+ * are carried out by a background thread. */
+SUNDIALS_EXPORT
+SUNCheckpointStore SUNCheckpointStore_File(const char* filename,
+                                           SUNContext sunctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -93,6 +93,9 @@ typedef enum
   SUNLINEARSOLVER_ONEMKLDENSE,
   SUNLINEARSOLVER_GINKGO,
   SUNLINEARSOLVER_KOKKOSDENSE,
+  SUNLINEARSOLVER_BLOCKDENSE,
+  SUNLINEARSOLVER_SSGMR,
+  SUNLINEARSOLVER_ILU,
   SUNLINEARSOLVER_CUSTOM
 } SUNLinearSolver_ID;
 
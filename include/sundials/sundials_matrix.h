@@ -67,6 +67,8 @@ typedef enum
   SUNMATRIX_CUSPARSE,
   SUNMATRIX_GINKGO,
   SUNMATRIX_KOKKOSDENSE,
+  SUNMATRIX_BLOCKDENSE,
+  SUNMATRIX_BSR,
   SUNMATRIX_CUSTOM
 } SUNMatrix_ID;
 
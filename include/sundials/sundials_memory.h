@@ -154,6 +154,16 @@ SUNDIALS_EXPORT int SUNMemoryHelper_CopyOps(SUNMemoryHelper src,
 SUNDIALS_EXPORT
 booleantype SUNMemoryHelper_ImplementsRequiredOps(SUNMemoryHelper);
 
+/* Attaches a memory helper to a context, host vectors created with the
+   context allocate their data through it. The context does not take
+   ownership of the helper. */
+SUNDIALS_EXPORT
+int SUNContext_SetMemoryHelper(SUNContext sunctx, SUNMemoryHelper helper);
+
+/* Gets the memory helper attached to a context (NULL if none) */
+SUNDIALS_EXPORT
+int SUNContext_GetMemoryHelper(SUNContext sunctx, SUNMemoryHelper* helper);
+
 
 #ifdef __cplusplus
 }
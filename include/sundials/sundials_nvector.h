@@ -79,6 +79,17 @@ typedef enum
   SUNDIALS_NVEC_CUSTOM
 } N_Vector_ID;
 
+/* -----------------------------------------------------------------
+ * Reduction operations for split-phase global reductions
+ * ----------------------------------------------------------------- */
+
+typedef enum
+{
+  SUN_REDUCE_SUM,
+  SUN_REDUCE_MAX,
+  SUN_REDUCE_MIN
+} N_VReduceOp;
+
 /* -----------------------------------------------------------------
  * Generic definition of N_Vector
  * ----------------------------------------------------------------- */
@@ -174,6 +185,10 @@ struct _generic_N_Vector_Ops
   int (*nvdotprodmultilocal)(int, N_Vector, N_Vector*, realtype*);
   int (*nvdotprodmultiallreduce)(int, N_Vector, realtype*);
 
+  /* Split-phase (non-blocking) buffer reduction operations */
+  int (*nvallreducestart)(int, N_Vector, realtype*, int);
+  int (*nvallreducefinish)(N_Vector);
+
   /* XBraid interface operations */
   int (*nvbufsize)(N_Vector, sunindextype*);
   int (*nvbufpack)(N_Vector, void*);
@@ -292,6 +307,10 @@ SUNDIALS_EXPORT realtype N_VMinQuotientLocal(N_Vector num, N_Vector denom);
 SUNDIALS_EXPORT int N_VDotProdMultiLocal(int nvec, N_Vector x, N_Vector* Y, realtype* dotprods);
 SUNDIALS_EXPORT int N_VDotProdMultiAllReduce(int nvec_total, N_Vector x, realtype* sum);
 
+/* split-phase buffer reduction operations */
+SUNDIALS_EXPORT int N_VAllReduceStart(int nvec, N_Vector x, realtype* buf, int op);
+SUNDIALS_EXPORT int N_VAllReduceFinish(N_Vector x);
+
 /* XBraid interface operations */
 SUNDIALS_EXPORT int N_VBufSize(N_Vector x, sunindextype* size);
 SUNDIALS_EXPORT int N_VBufPack(N_Vector x, void* buf);
@@ -306,6 +325,18 @@ SUNDIALS_EXPORT N_Vector* N_VCloneEmptyVectorArray(int count, N_Vector w);
 SUNDIALS_EXPORT N_Vector* N_VCloneVectorArray(int count, N_Vector w);
 SUNDIALS_EXPORT void N_VDestroyVectorArray(N_Vector* vs, int count);
 
+/* Scratch vectors shared through a vector pool in the SUNContext */
+SUNDIALS_EXPORT N_Vector* N_VCheckoutVectorArray(int count, N_Vector w);
+SUNDIALS_EXPORT void N_VReturnVectorArray(N_Vector* vs, int count);
+SUNDIALS_EXPORT int SUNContext_EnableVectorPool(SUNContext sunctx,
+                                                booleantype onoff);
+SUNDIALS_EXPORT int SUNContext_ReleaseVectorPool(SUNContext sunctx);
+SUNDIALS_EXPORT int SUNContext_GetVectorPoolStats(SUNContext sunctx,
+                                                  long int* num_clones,
+                                                  long int* num_checkouts,
+                                                  long int* num_in_use,
+                                                  long int* max_in_use);
+
 /* These function are really only for users of the Fortran interface */
 SUNDIALS_EXPORT N_Vector N_VGetVecAtIndexVectorArray(N_Vector* vs, int index);
 SUNDIALS_EXPORT void N_VSetVecAtIndexVectorArray(N_Vector* vs, int index, N_Vector w);
@@ -35,6 +35,13 @@ SUNDIALS_EXPORT int SUNProfiler_Begin(SUNProfiler p, const char* name);
 SUNDIALS_EXPORT int SUNProfiler_End(SUNProfiler p, const char* name);
 SUNDIALS_EXPORT int SUNProfiler_Print(SUNProfiler p, FILE* fp);
 SUNDIALS_EXPORT int SUNProfiler_Reset(SUNProfiler p);
+SUNDIALS_EXPORT int SUNProfiler_GetTimerId(SUNProfiler p, const char* name, int* id);
+SUNDIALS_EXPORT int SUNProfiler_BeginId(SUNProfiler p, int id);
+SUNDIALS_EXPORT int SUNProfiler_EndId(SUNProfiler p, int id);
+SUNDIALS_EXPORT int SUNProfiler_EnableTrace(SUNProfiler p, long int max_events);
+SUNDIALS_EXPORT int SUNProfiler_EnableCounters(SUNProfiler p, int onoff);
+SUNDIALS_EXPORT int SUNProfiler_ExportTrace(SUNProfiler p, FILE* fp);
+SUNDIALS_EXPORT int SUNProfiler_ExportCSV(SUNProfiler p, FILE* fp);
 
 #if defined(SUNDIALS_BUILD_WITH_PROFILING) && defined(SUNDIALS_CALIPER_ENABLED)
 
@@ -101,16 +108,17 @@ class ProfilerMarkScope
 public:
   ProfilerMarkScope(SUNProfiler prof, const char* name) {
     prof_ = prof;
-    name_ = name;
-    SUNProfiler_Begin(prof_, name_);
+    id_   = -1;
+    if (!SUNProfiler_GetTimerId(prof_, name, &id_))
+      SUNProfiler_BeginId(prof_, id_);
   }
 
   ~ProfilerMarkScope() {
-    SUNProfiler_End(prof_, name_);
+    if (id_ >= 0) SUNProfiler_EndId(prof_, id_);
   }
 private:
   SUNProfiler prof_;
-  const char* name_;
+  int id_;
 };
 }
 
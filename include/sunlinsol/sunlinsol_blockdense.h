@@ -0,0 +1,86 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the batched block-diagonal dense
+ * implementation of the SUNLINSOL module, SUNLINSOL_BLOCKDENSE.
+ *
+ * The solver computes the LU factorization with partial pivoting
+ * of every block of a SUNMATRIX_BLOCKDENSE matrix. All blocks of an
+ * interleaved group are factored and solved together so that the
+ * inner loops run across blocks. The groups may be factored and
+ * solved in parallel with OpenMP, see
+ * SUNLinSol_BlockDenseSetNumThreads.
+ *
+ * Notes:
+ *   - The definition of the generic SUNLinearSolver structure can
+ *     be found in the header file sundials_linearsolver.h.
+ *   - The definition of the type 'realtype' can be found in the
+ *     header file sundials_types.h, and it may be changed (at the
+ *     configuration stage) according to the user's needs.
+ *     The sundials_types.h file also contains the definition
+ *     for the type 'booleantype' and 'indextype'.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNLINSOL_BLOCKDENSE_H
+#define _SUNLINSOL_BLOCKDENSE_H
+
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+#include <sunmatrix/sunmatrix_blockdense.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* ------------------------------------------------------
+ * Block-diagonal dense implementation of SUNLinearSolver
+ * ------------------------------------------------------ */
+
+struct _SUNLinearSolverContent_BlockDense {
+  sunindextype M;        /* size of each block           */
+  sunindextype nblocks;  /* number of blocks             */
+  sunindextype npacks;   /* number of interleaved groups */
+  sunindextype *pivots;  /* interleaved pivots           */
+  realtype *work;        /* interleaved right-hand sides */
+  sunindextype last_flag;
+  int num_threads;       /* threads used by setup/solve  */
+};
+
+typedef struct _SUNLinearSolverContent_BlockDense *SUNLinearSolverContent_BlockDense;
+
+/* ---------------------------------------------
+ * Exported Functions for SUNLINSOL_BLOCKDENSE
+ * --------------------------------------------- */
+
+SUNDIALS_EXPORT SUNLinearSolver SUNLinSol_BlockDense(N_Vector y, SUNMatrix A,
+                                                     SUNContext sunctx);
+SUNDIALS_EXPORT int SUNLinSol_BlockDenseSetNumThreads(SUNLinearSolver S,
+                                                      int num_threads);
+SUNDIALS_EXPORT SUNLinearSolver_Type SUNLinSolGetType_BlockDense(SUNLinearSolver S);
+SUNDIALS_EXPORT SUNLinearSolver_ID SUNLinSolGetID_BlockDense(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolInitialize_BlockDense(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolSetup_BlockDense(SUNLinearSolver S, SUNMatrix A);
+SUNDIALS_EXPORT int SUNLinSolSolve_BlockDense(SUNLinearSolver S, SUNMatrix A,
+                                              N_Vector x, N_Vector b, realtype tol);
+SUNDIALS_EXPORT sunindextype SUNLinSolLastFlag_BlockDense(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolSpace_BlockDense(SUNLinearSolver S,
+                                              long int *lenrwLS,
+                                              long int *leniwLS);
+SUNDIALS_EXPORT int SUNLinSolFree_BlockDense(SUNLinearSolver S);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
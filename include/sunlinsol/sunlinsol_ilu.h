@@ -0,0 +1,109 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the incomplete LU implementation of
+ * the SUNLINSOL module, SUNLINSOL_ILU.
+ *
+ * The solver computes an ILU(k) factorization of a SUNMATRIX_SPARSE
+ * matrix, keeping the fill entries of level at most k. It is meant
+ * to be used as a preconditioner for the Krylov solvers. The rows of
+ * the factors are grouped in levels that can be factored and solved
+ * independently, and the rows of a level are processed in parallel
+ * with OpenMP after a call to SUNLinSol_ILUSetNumThreads.
+ *
+ * Notes:
+ *   - The definition of the generic SUNLinearSolver structure can
+ *     be found in the header file sundials_linearsolver.h.
+ *   - The definition of the type 'realtype' can be found in the
+ *     header file sundials_types.h, and it may be changed (at the
+ *     configuration stage) according to the user's needs.
+ *     The sundials_types.h file also contains the definition
+ *     for the type 'booleantype' and 'indextype'.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNLINSOL_ILU_H
+#define _SUNLINSOL_ILU_H
+
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------------------------------------
+ * Incomplete LU implementation of SUNLinearSolver
+ * ----------------------------------------------- */
+
+struct _SUNLinearSolverContent_ILU {
+  sunindextype N;           /* number of rows                        */
+  int fill_level;           /* maximum level of the fill entries     */
+  int first_factorize;      /* symbolic factorization needed         */
+  sunindextype nnzA;        /* stored entries of the factored matrix */
+  sunindextype *Ap;         /* copy of the pattern of the factored   */
+  sunindextype *Ai;         /*   matrix to detect pattern changes    */
+  sunindextype *amap;       /* position in LUx of each entry of A    */
+  sunindextype *LUp;        /* row pointers of the L and U factors   */
+  sunindextype *LUj;        /* sorted column indices of the factors  */
+  realtype *LUx;            /* L (unit diagonal omitted) and U       */
+  sunindextype *diag;       /* position of the diagonal in each row  */
+  realtype *dinv;           /* inverse of the diagonal of U          */
+  sunindextype nlevL;       /* number of levels of the L solve       */
+  sunindextype *levL;       /* first row of each level in ordL       */
+  sunindextype *ordL;       /* rows sorted by L level                */
+  sunindextype nlevU;       /* number of levels of the U solve       */
+  sunindextype *levU;       /* first row of each level in ordU       */
+  sunindextype *ordU;       /* rows sorted by U level                */
+  sunindextype *work;       /* row markers, one set per thread       */
+  int num_threads;          /* threads used by setup and solve       */
+  sunindextype last_flag;
+};
+
+typedef struct _SUNLinearSolverContent_ILU *SUNLinearSolverContent_ILU;
+
+/* ---------------------------------------
+ * Exported Functions for SUNLINSOL_ILU
+ * --------------------------------------- */
+
+SUNDIALS_EXPORT SUNLinearSolver SUNLinSol_ILU(N_Vector y, SUNMatrix A,
+                                              int fill_level,
+                                              SUNContext sunctx);
+SUNDIALS_EXPORT int SUNLinSol_ILUSetFillLevel(SUNLinearSolver S,
+                                              int fill_level);
+SUNDIALS_EXPORT int SUNLinSol_ILUSetNumThreads(SUNLinearSolver S,
+                                               int num_threads);
+SUNDIALS_EXPORT int SUNLinSol_ILUGetNumNonzeros(SUNLinearSolver S,
+                                                sunindextype *nnz);
+SUNDIALS_EXPORT int SUNLinSol_ILUGetNumLevels(SUNLinearSolver S,
+                                              sunindextype *nlevL,
+                                              sunindextype *nlevU);
+
+SUNDIALS_EXPORT SUNLinearSolver_Type SUNLinSolGetType_ILU(SUNLinearSolver S);
+SUNDIALS_EXPORT SUNLinearSolver_ID SUNLinSolGetID_ILU(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolInitialize_ILU(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolSetup_ILU(SUNLinearSolver S, SUNMatrix A);
+SUNDIALS_EXPORT int SUNLinSolSolve_ILU(SUNLinearSolver S, SUNMatrix A,
+                                       N_Vector x, N_Vector b, realtype tol);
+SUNDIALS_EXPORT sunindextype SUNLinSolLastFlag_ILU(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolSpace_ILU(SUNLinearSolver S,
+                                       long int *lenrwLS,
+                                       long int *leniwLS);
+SUNDIALS_EXPORT int SUNLinSolFree_ILU(SUNLinearSolver S);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -53,6 +53,7 @@ extern "C" {
 #define sun_klu_refactor      klu_l_refactor
 #define sun_klu_rcond         klu_l_rcond
 #define sun_klu_condest       klu_l_condest
+#define sun_klu_rgrowth       klu_l_rgrowth
 #define sun_klu_defaults      klu_l_defaults
 #define sun_klu_free_symbolic klu_l_free_symbolic
 #define sun_klu_free_numeric  klu_l_free_numeric
@@ -65,6 +66,7 @@ extern "C" {
 #define sun_klu_refactor      klu_refactor
 #define sun_klu_rcond         klu_rcond
 #define sun_klu_condest       klu_condest
+#define sun_klu_rgrowth       klu_rgrowth
 #define sun_klu_defaults      klu_defaults
 #define sun_klu_free_symbolic klu_free_symbolic
 #define sun_klu_free_numeric  klu_free_numeric
@@ -88,13 +90,33 @@ typedef sunindextype (*KLUSolveFn)(sun_klu_symbolic*, sun_klu_numeric*,
                                    sunindextype, sunindextype,
                                    double*, sun_klu_common*);
 
-struct _SUNLinearSolverContent_KLU {
-  int              last_flag;
-  int              first_factorize;
+/* Reference counted symbolic factorization that may be shared by several KLU
+ * linear solvers with the same sparsity pattern. An existing analysis is only
+ * reused for the same ordering and an identical copy of the analyzed pattern,
+ * the pattern hash is a quick check before the full comparison. */
+
+struct _SUNKLUSharedSymbolic {
   sun_klu_symbolic *symbolic;
-  sun_klu_numeric  *numeric;
-  sun_klu_common   common;
-  KLUSolveFn       klu_solver;
+  unsigned long    hash;
+  sunindextype     n;
+  sunindextype     nnz;
+  sunindextype     *indexptrs;  /* analyzed pattern */
+  sunindextype     *indexvals;
+  int              ordering;
+  int              refcount;
+};
+
+typedef struct _SUNKLUSharedSymbolic *SUNKLUSharedSymbolic;
+
+struct _SUNLinearSolverContent_KLU {
+  int                  last_flag;
+  int                  first_factorize;
+  sun_klu_symbolic     *symbolic;
+  sun_klu_numeric      *numeric;
+  sun_klu_common       common;
+  KLUSolveFn           klu_solver;
+  SUNKLUSharedSymbolic shared;
+  SUNMatrix            bsr_copy;  /* CSC copy of a SUNMATRIX_BSR matrix */
 };
 
 typedef struct _SUNLinearSolverContent_KLU *SUNLinearSolverContent_KLU;
@@ -109,6 +131,8 @@ SUNDIALS_EXPORT int SUNLinSol_KLUReInit(SUNLinearSolver S, SUNMatrix A,
                                         sunindextype nnz, int reinit_type);
 SUNDIALS_EXPORT int SUNLinSol_KLUSetOrdering(SUNLinearSolver S,
                                              int ordering_choice);
+SUNDIALS_EXPORT int SUNLinSol_KLUShareSymbolic(SUNLinearSolver S,
+                                               SUNLinearSolver S_src);
 
 /* --------------------
  *  Accessor functions
@@ -0,0 +1,129 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the SSGMR implementation of the
+ * SUNLINSOL module, SUNLINSOL_SSGMR. The SSGMR algorithm is an
+ * s-step variant of the Scaled Preconditioned GMRES method: the
+ * Krylov vectors are generated s at a time and orthonormalized
+ * together with a block classical Gram-Schmidt and Cholesky QR
+ * scheme, so that each block of s iterations needs two global
+ * reductions instead of one or more per iteration.
+ *
+ * Note:
+ *   - The definition of the generic SUNLinearSolver structure can
+ *     be found in the header file sundials_linearsolver.h.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNLINSOL_SSGMR_H
+#define _SUNLINSOL_SSGMR_H
+
+#include <stdio.h>
+
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Default SSGMR solver parameters */
+#define SUNSSGMR_MAXL_DEFAULT    5
+#define SUNSSGMR_MAXRS_DEFAULT   0
+#define SUNSSGMR_BLOCK_DEFAULT   4
+
+/* ----------------------------------------
+ * SSGMR Implementation of SUNLinearSolver
+ * ---------------------------------------- */
+
+struct _SUNLinearSolverContent_SSGMR {
+  int maxl;
+  int pretype;
+  int block;
+  int max_restarts;
+  booleantype zeroguess;
+  int numiters;
+  realtype resnorm;
+  int last_flag;
+  realtype sigma;
+
+  SUNATimesFn ATimes;
+  void* ATData;
+  SUNPSetupFn Psetup;
+  SUNPSolveFn Psolve;
+  void* PData;
+
+  N_Vector s1;
+  N_Vector s2;
+  N_Vector *V;
+  realtype **Hes;
+  realtype **Hraw;
+  realtype *givens;
+  N_Vector xcor;
+  realtype *yg;
+  N_Vector vtemp;
+
+  realtype *cv;
+  N_Vector *Xv;
+  realtype *work;
+};
+
+typedef struct _SUNLinearSolverContent_SSGMR *SUNLinearSolverContent_SSGMR;
+
+
+/* ---------------------------------------
+ * Exported Functions for SUNLINSOL_SSGMR
+ * --------------------------------------- */
+
+SUNDIALS_EXPORT SUNLinearSolver SUNLinSol_SSGMR(N_Vector y,
+                                                int pretype,
+                                                int maxl,
+                                                SUNContext sunctx);
+SUNDIALS_EXPORT int SUNLinSol_SSGMRSetPrecType(SUNLinearSolver S,
+                                               int pretype);
+SUNDIALS_EXPORT int SUNLinSol_SSGMRSetBlockSize(SUNLinearSolver S,
+                                                int block);
+SUNDIALS_EXPORT int SUNLinSol_SSGMRSetMaxRestarts(SUNLinearSolver S,
+                                                  int maxrs);
+SUNDIALS_EXPORT SUNLinearSolver_Type SUNLinSolGetType_SSGMR(SUNLinearSolver S);
+SUNDIALS_EXPORT SUNLinearSolver_ID SUNLinSolGetID_SSGMR(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolInitialize_SSGMR(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolSetATimes_SSGMR(SUNLinearSolver S, void* A_data,
+                                             SUNATimesFn ATimes);
+SUNDIALS_EXPORT int SUNLinSolSetPreconditioner_SSGMR(SUNLinearSolver S,
+                                                     void* P_data,
+                                                     SUNPSetupFn Pset,
+                                                     SUNPSolveFn Psol);
+SUNDIALS_EXPORT int SUNLinSolSetScalingVectors_SSGMR(SUNLinearSolver S,
+                                                     N_Vector s1,
+                                                     N_Vector s2);
+SUNDIALS_EXPORT int SUNLinSolSetZeroGuess_SSGMR(SUNLinearSolver S,
+                                                booleantype onff);
+SUNDIALS_EXPORT int SUNLinSolSetup_SSGMR(SUNLinearSolver S, SUNMatrix A);
+SUNDIALS_EXPORT int SUNLinSolSolve_SSGMR(SUNLinearSolver S, SUNMatrix A,
+                                         N_Vector x, N_Vector b, realtype tol);
+SUNDIALS_EXPORT int SUNLinSolNumIters_SSGMR(SUNLinearSolver S);
+SUNDIALS_EXPORT realtype SUNLinSolResNorm_SSGMR(SUNLinearSolver S);
+SUNDIALS_EXPORT N_Vector SUNLinSolResid_SSGMR(SUNLinearSolver S);
+SUNDIALS_EXPORT sunindextype SUNLinSolLastFlag_SSGMR(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolSpace_SSGMR(SUNLinearSolver S,
+                                         long int *lenrwLS,
+                                         long int *leniwLS);
+SUNDIALS_EXPORT int SUNLinSolFree_SSGMR(SUNLinearSolver S);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the block-diagonal dense
+ * implementation of the SUNMATRIX module, SUNMATRIX_BLOCKDENSE.
+ *
+ * The matrix has nblocks dense M by N blocks on its diagonal.
+ * Groups of SUNBLOCKDENSE_PACK consecutive blocks are stored
+ * together in an interleaved (structure-of-arrays) layout: within
+ * a group, entry (i,j) of all blocks is contiguous, so that
+ * operations applied to every block vectorize across blocks. The
+ * groups are stored one after another and may be processed in
+ * parallel with OpenMP, see SUNBlockDenseMatrix_SetNumThreads.
+ *
+ * Notes:
+ *   - The definition of the generic SUNMatrix structure can be found
+ *     in the header file sundials_matrix.h.
+ *   - The definition of the type 'realtype' can be found in the
+ *     header file sundials_types.h, and it may be changed (at the
+ *     configuration stage) according to the user's needs.
+ *     The sundials_types.h file also contains the definition
+ *     for the type 'booleantype' and 'indextype'.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNMATRIX_BLOCKDENSE_H
+#define _SUNMATRIX_BLOCKDENSE_H
+
+#include <stdio.h>
+#include <sundials/sundials_matrix.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* number of blocks interleaved in one group */
+#define SUNBLOCKDENSE_PACK 8
+
+/* ---------------------------------------------------
+ * Block-diagonal dense implementation of SUNMatrix
+ * --------------------------------------------------- */
+
+struct _SUNMatrixContent_BlockDense {
+  sunindextype M;        /* rows in each block          */
+  sunindextype N;        /* columns in each block       */
+  sunindextype nblocks;  /* number of blocks            */
+  sunindextype npacks;   /* number of interleaved groups */
+  realtype *data;
+  sunindextype ldata;
+  int num_threads;       /* threads used by the operations */
+};
+
+typedef struct _SUNMatrixContent_BlockDense *SUNMatrixContent_BlockDense;
+
+/* -----------------------------------------
+ * Macros for access to SUNMATRIX_BLOCKDENSE
+ * ----------------------------------------- */
+
+#define SM_CONTENT_BD(A)       ( (SUNMatrixContent_BlockDense)(A->content) )
+
+#define SM_BLOCKROWS_BD(A)     ( SM_CONTENT_BD(A)->M )
+
+#define SM_BLOCKCOLUMNS_BD(A)  ( SM_CONTENT_BD(A)->N )
+
+#define SM_NBLOCKS_BD(A)       ( SM_CONTENT_BD(A)->nblocks )
+
+#define SM_NPACKS_BD(A)        ( SM_CONTENT_BD(A)->npacks )
+
+#define SM_LDATA_BD(A)         ( SM_CONTENT_BD(A)->ldata )
+
+#define SM_DATA_BD(A)          ( SM_CONTENT_BD(A)->data )
+
+#define SM_NUM_THREADS_BD(A)   ( SM_CONTENT_BD(A)->num_threads )
+
+/* entry (i,j) of block k */
+#define SM_ELEMENT_BD(A,k,i,j)                                              \
+  ( SM_DATA_BD(A)[ ( ((k) / SUNBLOCKDENSE_PACK * SM_BLOCKCOLUMNS_BD(A)      \
+                      + (j)) * SM_BLOCKROWS_BD(A) + (i) ) * SUNBLOCKDENSE_PACK \
+                   + (k) % SUNBLOCKDENSE_PACK ] )
+
+/* --------------------------------------------
+ * Exported Functions for SUNMATRIX_BLOCKDENSE
+ * -------------------------------------------- */
+
+SUNDIALS_EXPORT SUNMatrix SUNBlockDenseMatrix(sunindextype nblocks,
+                                              sunindextype M, sunindextype N,
+                                              SUNContext sunctx);
+
+SUNDIALS_EXPORT void SUNBlockDenseMatrix_Print(SUNMatrix A, FILE* outfile);
+
+SUNDIALS_EXPORT sunindextype SUNBlockDenseMatrix_Rows(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNBlockDenseMatrix_Columns(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNBlockDenseMatrix_BlockRows(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNBlockDenseMatrix_BlockColumns(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNBlockDenseMatrix_NumBlocks(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNBlockDenseMatrix_LData(SUNMatrix A);
+SUNDIALS_EXPORT realtype* SUNBlockDenseMatrix_Data(SUNMatrix A);
+
+SUNDIALS_EXPORT int SUNBlockDenseMatrix_SetNumThreads(SUNMatrix A,
+                                                      int num_threads);
+
+SUNDIALS_EXPORT SUNMatrix_ID SUNMatGetID_BlockDense(SUNMatrix A);
+SUNDIALS_EXPORT SUNMatrix SUNMatClone_BlockDense(SUNMatrix A);
+SUNDIALS_EXPORT void SUNMatDestroy_BlockDense(SUNMatrix A);
+SUNDIALS_EXPORT int SUNMatZero_BlockDense(SUNMatrix A);
+SUNDIALS_EXPORT int SUNMatCopy_BlockDense(SUNMatrix A, SUNMatrix B);
+SUNDIALS_EXPORT int SUNMatScaleAdd_BlockDense(realtype c, SUNMatrix A, SUNMatrix B);
+SUNDIALS_EXPORT int SUNMatScaleAddI_BlockDense(realtype c, SUNMatrix A);
+SUNDIALS_EXPORT int SUNMatMatvec_BlockDense(SUNMatrix A, N_Vector x, N_Vector y);
+SUNDIALS_EXPORT int SUNMatSpace_BlockDense(SUNMatrix A, long int *lenrw, long int *leniw);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the block compressed sparse row
+ * implementation of the SUNMATRIX module, SUNMATRIX_BSR.
+ *
+ * The matrix is made of MB by NB blocks of size bs by bs. Only the
+ * nonzero blocks are stored: indexptrs[I] is the position of the
+ * first block of block row I, indexvals[k] is the block column of
+ * block k, and the bs*bs entries of block k are stored in column
+ * major order starting at data[k*bs*bs]. The block pattern is kept
+ * by SUNMatZero, so a Jacobian can be loaded into the same pattern
+ * at every setup.
+ *
+ * Notes:
+ *   - The definition of the generic SUNMatrix structure can be found
+ *     in the header file sundials_matrix.h.
+ *   - The definition of the type 'realtype' can be found in the
+ *     header file sundials_types.h, and it may be changed (at the
+ *     configuration stage) according to the user's needs.
+ *     The sundials_types.h file also contains the definition
+ *     for the type 'booleantype' and 'indextype'.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNMATRIX_BSR_H
+#define _SUNMATRIX_BSR_H
+
+#include <stdio.h>
+#include <sundials/sundials_matrix.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* ----------------------------------------
+ * BSR Implementation of SUNMATRIX_BSR
+ * ---------------------------------------- */
+
+struct _SUNMatrixContent_BSR {
+  sunindextype MB;         /* number of block rows              */
+  sunindextype NB;         /* number of block columns           */
+  sunindextype bs;         /* rows and columns of each block    */
+  sunindextype NNZB;       /* number of allocated blocks        */
+  realtype *data;          /* block entries, column major       */
+  sunindextype *indexvals; /* block column of each block        */
+  sunindextype *indexptrs; /* first block of each block row     */
+  int num_threads;         /* threads used by SUNMatMatvec      */
+};
+
+typedef struct _SUNMatrixContent_BSR *SUNMatrixContent_BSR;
+
+
+/* ---------------------------------------
+ * Macros for access to SUNMATRIX_BSR
+ * --------------------------------------- */
+
+#define SM_CONTENT_BSR(A)     ( (SUNMatrixContent_BSR)(A->content) )
+
+#define SM_BLOCKROWS_BSR(A)   ( SM_CONTENT_BSR(A)->MB )
+
+#define SM_BLOCKCOLS_BSR(A)   ( SM_CONTENT_BSR(A)->NB )
+
+#define SM_BLOCKSIZE_BSR(A)   ( SM_CONTENT_BSR(A)->bs )
+
+#define SM_NNZB_BSR(A)        ( SM_CONTENT_BSR(A)->NNZB )
+
+#define SM_DATA_BSR(A)        ( SM_CONTENT_BSR(A)->data )
+
+#define SM_INDEXVALS_BSR(A)   ( SM_CONTENT_BSR(A)->indexvals )
+
+#define SM_INDEXPTRS_BSR(A)   ( SM_CONTENT_BSR(A)->indexptrs )
+
+#define SM_NUM_THREADS_BSR(A) ( SM_CONTENT_BSR(A)->num_threads )
+
+/* first entry of block k */
+#define SM_BLOCK_BSR(A,k)                                           \
+  ( SM_DATA_BSR(A) + (k) * SM_BLOCKSIZE_BSR(A) * SM_BLOCKSIZE_BSR(A) )
+
+/* entry (i,j) of block k */
+#define SM_BLOCK_ELEMENT_BSR(A,k,i,j)                               \
+  ( SM_BLOCK_BSR(A,k)[(j) * SM_BLOCKSIZE_BSR(A) + (i)] )
+
+
+/* ----------------------------------------
+ * Exported Functions for SUNMATRIX_BSR
+ * ---------------------------------------- */
+
+SUNDIALS_EXPORT SUNMatrix SUNBSRMatrix(sunindextype MB, sunindextype NB,
+                                       sunindextype bs, sunindextype NNZB,
+                                       SUNContext sunctx);
+
+SUNDIALS_EXPORT SUNMatrix SUNBSRFromSparseMatrix(SUNMatrix A,
+                                                 sunindextype bs);
+
+SUNDIALS_EXPORT int SUNBSRMatrix_ToSparse(SUNMatrix A, int sparsetype,
+                                          SUNMatrix *Bout);
+
+SUNDIALS_EXPORT int SUNBSRMatrix_CopyToSparse(SUNMatrix A, SUNMatrix B);
+
+SUNDIALS_EXPORT int SUNBSRMatrix_Reallocate(SUNMatrix A, sunindextype NNZB);
+
+SUNDIALS_EXPORT void SUNBSRMatrix_Print(SUNMatrix A, FILE* outfile);
+
+SUNDIALS_EXPORT sunindextype SUNBSRMatrix_Rows(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNBSRMatrix_Columns(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNBSRMatrix_BlockRows(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNBSRMatrix_BlockColumns(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNBSRMatrix_BlockSize(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNBSRMatrix_NNZB(SUNMatrix A);
+SUNDIALS_EXPORT realtype* SUNBSRMatrix_Data(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype* SUNBSRMatrix_IndexValues(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype* SUNBSRMatrix_IndexPointers(SUNMatrix A);
+
+SUNDIALS_EXPORT int SUNBSRMatrix_SetNumThreads(SUNMatrix A, int num_threads);
+
+SUNDIALS_EXPORT int SUNBSRMatrix_ColorColumns(SUNMatrix A,
+                                              sunindextype *colors,
+                                              sunindextype *ncolors);
+
+SUNDIALS_EXPORT SUNMatrix_ID SUNMatGetID_BSR(SUNMatrix A);
+SUNDIALS_EXPORT SUNMatrix SUNMatClone_BSR(SUNMatrix A);
+SUNDIALS_EXPORT void SUNMatDestroy_BSR(SUNMatrix A);
+SUNDIALS_EXPORT int SUNMatZero_BSR(SUNMatrix A);
+SUNDIALS_EXPORT int SUNMatCopy_BSR(SUNMatrix A, SUNMatrix B);
+SUNDIALS_EXPORT int SUNMatScaleAdd_BSR(realtype c, SUNMatrix A, SUNMatrix B);
+SUNDIALS_EXPORT int SUNMatScaleAddI_BSR(realtype c, SUNMatrix A);
+SUNDIALS_EXPORT int SUNMatMatvec_BSR(SUNMatrix A, N_Vector x, N_Vector y);
+SUNDIALS_EXPORT int SUNMatSpace_BSR(SUNMatrix A, long int *lenrw, long int *leniw);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -48,6 +48,14 @@ extern "C" {
 #define CSC_MAT 0
 #define CSR_MAT 1
 
+/* -----------------------------------------------
+ * Storage layouts for the matrix-vector product
+ * ----------------------------------------------- */
+
+#define SUNSPARSE_MATVEC_NATIVE 0
+#define SUNSPARSE_MATVEC_CSR    1
+#define SUNSPARSE_MATVEC_SELL   2
+
 
 /* ------------------------------------------
  * Sparse Implementation of SUNMATRIX_SPARSE
@@ -68,6 +76,13 @@ struct _SUNMatrixContent_Sparse {
   /* CSR indices */
   sunindextype **colvals;
   sunindextype **rowptrs;
+  /* maps cached by SUNMatScaleAdd and SUNMatScaleAddI */
+  struct _SUNSparseMergeCache *cache;
+  booleantype pattern_changed;
+  /* storage used by SUNMatMatvec */
+  struct _SUNSparseMatvecLayout *layout;
+  /* number of threads used by SUNMatMatvec */
+  int num_threads;
 };
 
 typedef struct _SUNMatrixContent_Sparse *SUNMatrixContent_Sparse;
@@ -95,6 +110,8 @@ typedef struct _SUNMatrixContent_Sparse *SUNMatrixContent_Sparse;
 
 #define SM_INDEXPTRS_S(A)   ( SM_CONTENT_S(A)->indexptrs )
 
+#define SM_NUM_THREADS_S(A) ( SM_CONTENT_S(A)->num_threads )
+
 /* ----------------------------------------
  * Exported Functions for SUNMATRIX_SPARSE
  * ---------------------------------------- */
@@ -129,6 +146,24 @@ SUNDIALS_EXPORT realtype* SUNSparseMatrix_Data(SUNMatrix A);
 SUNDIALS_EXPORT sunindextype* SUNSparseMatrix_IndexValues(SUNMatrix A);
 SUNDIALS_EXPORT sunindextype* SUNSparseMatrix_IndexPointers(SUNMatrix A);
 
+SUNDIALS_EXPORT booleantype SUNSparseMatrix_PatternChanged(SUNMatrix A);
+SUNDIALS_EXPORT void SUNSparseMatrix_FreeCache(SUNMatrix A);
+
+SUNDIALS_EXPORT int SUNSparseMatrix_SetMatvecLayout(SUNMatrix A, int layout,
+                                                    sunindextype chunk,
+                                                    sunindextype sigma);
+SUNDIALS_EXPORT int SUNSparseMatrix_SetNumThreads(SUNMatrix A,
+                                                  int num_threads);
+
+SUNDIALS_EXPORT int SUNSparseMatrix_ColorColumns(SUNMatrix A,
+                                                 sunindextype *colors,
+                                                 sunindextype *ncolors);
+
+SUNDIALS_EXPORT int SUNSparseMatrix_DiagonalBlocks(SUNMatrix A,
+                                                   sunindextype nblocks,
+                                                   const sunindextype *offsets,
+                                                   SUNMatrix *B);
+
 SUNDIALS_EXPORT SUNMatrix_ID SUNMatGetID_Sparse(SUNMatrix A);
 SUNDIALS_EXPORT SUNMatrix SUNMatClone_Sparse(SUNMatrix A);
 SUNDIALS_EXPORT void SUNMatDestroy_Sparse(SUNMatrix A);
@@ -0,0 +1,77 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * SUNDIALS pooled host memory helper header file.
+ * ----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_POOLMEMORY_H
+#define _SUNDIALS_POOLMEMORY_H
+
+#include <sundials/sundials_memory.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Alignment (in bytes) of the blocks returned by the pool */
+#define SUNMEMORY_POOL_ALIGNMENT 64
+
+/* Implementation specific functions */
+
+SUNDIALS_EXPORT
+SUNMemoryHelper SUNMemoryHelper_Pool(SUNContext sunctx);
+
+SUNDIALS_EXPORT
+int SUNMemoryHelper_SetMaxCached_Pool(SUNMemoryHelper helper,
+                                      size_t max_bytes_cached);
+
+SUNDIALS_EXPORT
+int SUNMemoryHelper_ReleaseCached_Pool(SUNMemoryHelper helper);
+
+SUNDIALS_EXPORT
+int SUNMemoryHelper_GetPoolStats_Pool(SUNMemoryHelper helper,
+                                      unsigned long* num_reuses,
+                                      size_t* bytes_cached);
+
+/* SUNMemoryHelper functions */
+
+SUNDIALS_EXPORT
+int SUNMemoryHelper_Alloc_Pool(SUNMemoryHelper helper, SUNMemory* memptr,
+                               size_t mem_size, SUNMemoryType mem_type,
+                               void* queue);
+
+SUNDIALS_EXPORT
+int SUNMemoryHelper_Dealloc_Pool(SUNMemoryHelper helper, SUNMemory mem,
+                                 void* queue);
+
+SUNDIALS_EXPORT
+int SUNMemoryHelper_Copy_Pool(SUNMemoryHelper helper, SUNMemory dst,
+                              SUNMemory src, size_t memory_size, void* queue);
+
+SUNDIALS_EXPORT
+int SUNMemoryHelper_GetAllocStats_Pool(SUNMemoryHelper helper,
+                                       SUNMemoryType mem_type,
+                                       unsigned long* num_allocations,
+                                       unsigned long* num_deallocations,
+                                       size_t* bytes_allocated,
+                                       size_t* bytes_high_watermark);
+
+SUNDIALS_EXPORT
+SUNMemoryHelper SUNMemoryHelper_Clone_Pool(SUNMemoryHelper helper);
+
+SUNDIALS_EXPORT
+int SUNMemoryHelper_Destroy_Pool(SUNMemoryHelper helper);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1348,6 +1348,8 @@ int arkInit(ARKodeMem ark_mem, realtype t0, N_Vector y0,
     ark_mem->hadapt_mem->ehist[1] = ONE;
     ark_mem->hadapt_mem->hhist[0] = ZERO;
     ark_mem->hadapt_mem->hhist[1] = ZERO;
+    if (ark_mem->hadapt_mem->hcontroller != NULL)
+      SUNAdaptController_Reset(ark_mem->hadapt_mem->hcontroller);
 
     /* Indicate that evaluation of the full RHS is not required after each step,
        this flag is updated to SUNTRUE by the interpolation module initialization
@@ -2440,6 +2442,12 @@ int arkCompleteStep(ARKodeMem ark_mem, realtype dsm)
   ark_mem->hadapt_mem->ehist[0] = dsm*ark_mem->hadapt_mem->bias;
   ark_mem->hadapt_mem->hhist[1] = ark_mem->hadapt_mem->hhist[0];
   ark_mem->hadapt_mem->hhist[0] = ark_mem->h;
+  if (ark_mem->hadapt_mem->hcontroller != NULL) {
+    retval = SUNAdaptController_UpdateH(ark_mem->hadapt_mem->hcontroller,
+                                        ark_mem->h,
+                                        dsm*ark_mem->hadapt_mem->bias);
+    if (retval != SUNADAPTCONTROLLER_SUCCESS) return(ARK_CONTROLLER_ERR);
+  }
 
   /* update scalar quantities */
   ark_mem->nst++;
@@ -2569,6 +2577,11 @@ int arkHandleFailure(ARKodeMem ark_mem, int flag)
     arkProcessError(ark_mem, ARK_RELAX_JAC_FAIL, "ARKODE", "ARKODE",
                     "The relaxation Jacobian failed unrecoverably");
     break;
+  case ARK_CONTROLLER_ERR:
+    arkProcessError(ark_mem, ARK_CONTROLLER_ERR, "ARKODE", "ARKODE",
+                    "At t = %Lg the time step controller failed",
+                    (long double) ark_mem->tcur);
+    break;
   default:
     /* This return should never happen */
     arkProcessError(ark_mem, ARK_UNRECOGNIZED_ERROR, "ARKODE", "ARKODE",
@@ -2599,11 +2612,7 @@ int arkEwtSetSS(N_Vector ycur, N_Vector weight, void* arkode_mem)
   N_VAbs(ycur, ark_mem->tempv1);
   N_VScale(ark_mem->reltol, ark_mem->tempv1, ark_mem->tempv1);
   N_VAddConst(ark_mem->tempv1, ark_mem->Sabstol, ark_mem->tempv1);
-  if (ark_mem->atolmin0) {
-    if (N_VMin(ark_mem->tempv1) <= ZERO) return(-1);
-  }
-  N_VInv(ark_mem->tempv1, weight);
-  return(0);
+  return(arkInvPositive(ark_mem->tempv1, weight, ark_mem->atolmin0));
 }
 
 
@@ -2626,11 +2635,7 @@ int arkEwtSetSV(N_Vector ycur, N_Vector weight, void* arkode_mem)
   N_VAbs(ycur, ark_mem->tempv1);
   N_VLinearSum(ark_mem->reltol, ark_mem->tempv1, ONE,
                ark_mem->Vabstol, ark_mem->tempv1);
-  if (ark_mem->atolmin0) {
-    if (N_VMin(ark_mem->tempv1) <= ZERO) return(-1);
-  }
-  N_VInv(ark_mem->tempv1, weight);
-  return(0);
+  return(arkInvPositive(ark_mem->tempv1, weight, ark_mem->atolmin0));
 }
 
 
@@ -2667,11 +2672,7 @@ int arkRwtSetSS(ARKodeMem ark_mem, N_Vector My, N_Vector weight)
   N_VAbs(My, ark_mem->tempv1);
   N_VScale(ark_mem->reltol, ark_mem->tempv1, ark_mem->tempv1);
   N_VAddConst(ark_mem->tempv1, ark_mem->SRabstol, ark_mem->tempv1);
-  if (ark_mem->Ratolmin0) {
-    if (N_VMin(ark_mem->tempv1) <= ZERO) return(-1);
-  }
-  N_VInv(ark_mem->tempv1, weight);
-  return(0);
+  return(arkInvPositive(ark_mem->tempv1, weight, ark_mem->Ratolmin0));
 }
 
 
@@ -2689,14 +2690,79 @@ int arkRwtSetSV(ARKodeMem ark_mem, N_Vector My, N_Vector weight)
   N_VAbs(My, ark_mem->tempv1);
   N_VLinearSum(ark_mem->reltol, ark_mem->tempv1, ONE,
                ark_mem->VRabstol, ark_mem->tempv1);
-  if (ark_mem->Ratolmin0) {
-    if (N_VMin(ark_mem->tempv1) <= ZERO) return(-1);
+  return(arkInvPositive(ark_mem->tempv1, weight, ark_mem->Ratolmin0));
+}
+
+
+/*---------------------------------------------------------------
+  arkInvPositive
+
+  This routine sets weight = 1/tempv. When test is SUNTRUE, it
+  also checks that all components of tempv are positive. If the
+  vector supports split-phase reductions, the global minimum is
+  computed while the inversion is performed. arkInvPositive
+  returns 0 on success and -1 if the test fails, in which case
+  weight is left unchanged.
+  ---------------------------------------------------------------*/
+int arkInvPositive(N_Vector tempv, N_Vector weight, booleantype test)
+{
+  realtype tmin;
+
+  if (!test) {
+    N_VInv(tempv, weight);
+    return(0);
+  }
+
+  if ((tempv->ops->nvminlocal != NULL) &&
+      (tempv->ops->nvallreducestart != NULL)) {
+    tmin = N_VMinLocal(tempv);
+    if (N_VAllReduceStart(1, tempv, &tmin, SUN_REDUCE_MIN) == 0) {
+      /* invert in place so that weight is only set once tmin is known */
+      N_VInv(tempv, tempv);
+      if (N_VAllReduceFinish(tempv) != 0) return(-1);
+      if (tmin <= ZERO) return(-1);
+      N_VScale(ONE, tempv, weight);
+      return(0);
+    }
   }
-  N_VInv(ark_mem->tempv1, weight);
+
+  if (N_VMin(tempv) <= ZERO) return(-1);
+  N_VInv(tempv, weight);
   return(0);
 }
 
 
+/*---------------------------------------------------------------
+  arkWrmsNormStart and arkWrmsNormFinish
+
+  These routines split the computation of the WRMS norm of x with
+  weights w so that other work can be done while the global
+  reduction is in flight. arkWrmsNormStart returns SUNTRUE if a
+  reduction was started, in which case arkWrmsNormFinish must be
+  called before x is used again. Otherwise the norm is computed
+  immediately and stored in sum. In both cases arkWrmsNormFinish
+  returns the norm.
+  ---------------------------------------------------------------*/
+booleantype arkWrmsNormStart(N_Vector x, N_Vector w, realtype *sum)
+{
+  if ((x->ops->nvwsqrsumlocal != NULL) &&
+      (x->ops->nvallreducestart != NULL) &&
+      (x->ops->nvgetlength != NULL)) {
+    *sum = N_VWSqrSumLocal(x, w);
+    if (N_VAllReduceStart(1, x, sum, SUN_REDUCE_SUM) == 0) return(SUNTRUE);
+  }
+  *sum = N_VWrmsNorm(x, w);
+  return(SUNFALSE);
+}
+
+realtype arkWrmsNormFinish(N_Vector x, realtype *sum, booleantype started)
+{
+  if (!started) return(*sum);
+  if (N_VAllReduceFinish(x) != 0) return(SUN_BIG_REAL);
+  return(SUNRsqrt(*sum / N_VGetLength(x)));
+}
+
+
 /*---------------------------------------------------------------
   arkExpStab is the default explicit stability estimation function
   ---------------------------------------------------------------*/
@@ -68,6 +68,10 @@ void arkPrintAdaptMem(ARKodeHAdaptMem hadapt_mem, FILE *outfile)
     fprintf(outfile, "ark_hadapt: small_nef = %i\n", hadapt_mem->small_nef);
     fprintf(outfile, "ark_hadapt: etacf = %"RSYM"\n", hadapt_mem->etacf);
     fprintf(outfile, "ark_hadapt: imethod = %i\n", hadapt_mem->imethod);
+    if (hadapt_mem->hcontroller != NULL) {
+      fprintf(outfile, "ark_hadapt: controller object:\n");
+      SUNAdaptController_Write(hadapt_mem->hcontroller, outfile);
+    }
     fprintf(outfile, "ark_hadapt: ehist =  %"RSYM"  %"RSYM"\n",
             hadapt_mem->ehist[0],
             hadapt_mem->ehist[1]);
@@ -126,38 +130,44 @@ int arkAdapt(void* arkode_mem, ARKodeHAdaptMem hadapt_mem,
   /* Set k as either p or q, based on pq flag */
   k = (hadapt_mem->pq) ? hadapt_mem->q : hadapt_mem->p;
 
-  /* Call algorithm-specific error adaptivity method */
-  switch (hadapt_mem->imethod) {
-  case(ARK_ADAPT_PID):         /* PID controller */
-    ier = arkAdaptPID(hadapt_mem, k, hcur, ecur, &h_acc);
-    break;
-  case(ARK_ADAPT_PI):          /* PI controller */
-    ier = arkAdaptPI(hadapt_mem, k, hcur, ecur, &h_acc);
-    break;
-  case(ARK_ADAPT_I):           /* I controller */
-    ier = arkAdaptI(hadapt_mem, k, hcur, ecur, &h_acc);
-    break;
-  case(ARK_ADAPT_EXP_GUS):     /* explicit Gustafsson controller */
-    ier = arkAdaptExpGus(hadapt_mem, k, nst, hcur, ecur, &h_acc);
-    break;
-  case(ARK_ADAPT_IMP_GUS):     /* implicit Gustafsson controller */
-    ier = arkAdaptImpGus(hadapt_mem, k, nst, hcur, ecur, &h_acc);
-    break;
-  case(ARK_ADAPT_IMEX_GUS):    /* imex Gustafsson controller */
-    ier = arkAdaptImExGus(hadapt_mem, k, nst, hcur, ecur, &h_acc);
-    break;
-  case(ARK_ADAPT_CUSTOM):      /* user-supplied controller */
-    ier = hadapt_mem->HAdapt(ycur, tcur, hcur, hadapt_mem->hhist[0],
-                             hadapt_mem->hhist[1], ecur,
-                             hadapt_mem->ehist[0],
-                             hadapt_mem->ehist[1],
-                             hadapt_mem->q, hadapt_mem->p,
-                             &h_acc, hadapt_mem->HAdapt_data);
-    break;
-  default:
-    arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKODE", "arkAdapt",
-                    "Illegal imethod.");
-    return (ARK_ILL_INPUT);
+  /* Call the controller object if one is attached, otherwise call the
+     algorithm-specific error adaptivity method */
+  if (hadapt_mem->hcontroller != NULL) {
+    ier = SUNAdaptController_EstimateStep(hadapt_mem->hcontroller, hcur, k,
+                                          ecur, &h_acc);
+  } else {
+    switch (hadapt_mem->imethod) {
+    case(ARK_ADAPT_PID):         /* PID controller */
+      ier = arkAdaptPID(hadapt_mem, k, hcur, ecur, &h_acc);
+      break;
+    case(ARK_ADAPT_PI):          /* PI controller */
+      ier = arkAdaptPI(hadapt_mem, k, hcur, ecur, &h_acc);
+      break;
+    case(ARK_ADAPT_I):           /* I controller */
+      ier = arkAdaptI(hadapt_mem, k, hcur, ecur, &h_acc);
+      break;
+    case(ARK_ADAPT_EXP_GUS):     /* explicit Gustafsson controller */
+      ier = arkAdaptExpGus(hadapt_mem, k, nst, hcur, ecur, &h_acc);
+      break;
+    case(ARK_ADAPT_IMP_GUS):     /* implicit Gustafsson controller */
+      ier = arkAdaptImpGus(hadapt_mem, k, nst, hcur, ecur, &h_acc);
+      break;
+    case(ARK_ADAPT_IMEX_GUS):    /* imex Gustafsson controller */
+      ier = arkAdaptImExGus(hadapt_mem, k, nst, hcur, ecur, &h_acc);
+      break;
+    case(ARK_ADAPT_CUSTOM):      /* user-supplied controller */
+      ier = hadapt_mem->HAdapt(ycur, tcur, hcur, hadapt_mem->hhist[0],
+                               hadapt_mem->hhist[1], ecur,
+                               hadapt_mem->ehist[0],
+                               hadapt_mem->ehist[1],
+                               hadapt_mem->q, hadapt_mem->p,
+                               &h_acc, hadapt_mem->HAdapt_data);
+      break;
+    default:
+      arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKODE", "arkAdapt",
+                      "Illegal imethod.");
+      return (ARK_ILL_INPUT);
+    }
   }
   if (ier != ARK_SUCCESS) {
     arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKODE", "arkAdapt",
@@ -20,6 +20,7 @@
 
 #include <stdarg.h>
 #include <arkode/arkode.h>
+#include <sundials/sundials_adaptcontroller.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
 extern "C" {
@@ -87,6 +88,7 @@ typedef struct ARKodeHAdaptMemRec {
   realtype     etacf;       /* h reduction factor on nonlinear conv fail  */
   ARKAdaptFn   HAdapt;      /* function to set the new time step size     */
   void        *HAdapt_data; /* user pointer passed to hadapt              */
+  SUNAdaptController hcontroller; /* controller object, overrides imethod */
   realtype     ehist[2];    /* error history for time adaptivity          */
   realtype     hhist[2];    /* step history for time adaptivity           */
   int          imethod;     /* step adaptivity method to use:
@@ -192,6 +192,10 @@ void* ARKStepCreate(ARKRhsFn fe, ARKRhsFn fi, realtype t0, N_Vector y0,
   step_mem->forcing    = NULL;
   step_mem->nforcing   = 0;
 
+  /* Initialize error accumulation data */
+  step_mem->accum_error = SUNFALSE;
+  step_mem->dsm_accum   = ZERO;
+
   /* Initialize main ARKODE infrastructure */
   retval = arkInit(ark_mem, t0, y0, FIRST_INIT);
   if (retval != ARK_SUCCESS) {
@@ -379,6 +383,11 @@ int ARKStepReInit(void* arkode_mem, ARKRhsFn fe,
   /* Initialize initial error norm  */
   step_mem->eRNrm = ONE;
 
+  /* Disable the error accumulation of fixed steps, an MRIStep inner stepper
+     enables it again before its next inner steps */
+  step_mem->accum_error = SUNFALSE;
+  step_mem->dsm_accum   = ZERO;
+
   /* Initialize main ARKODE infrastructure */
   retval = arkInit(ark_mem, t0, y0, FIRST_INIT);
   if (retval != ARK_SUCCESS) {
@@ -1105,6 +1114,7 @@ int arkStep_Init(void* arkode_mem, int init_type)
     reset_efun = SUNTRUE;
     if ( step_mem->implicit )   reset_efun = SUNFALSE;
     if ( !ark_mem->fixedstep )  reset_efun = SUNFALSE;
+    if ( step_mem->accum_error ) reset_efun = SUNFALSE;
     if ( ark_mem->user_efun )   reset_efun = SUNFALSE;
     if ( ark_mem->rwt_is_ewt && (step_mem->msolve_type == SUNLINEARSOLVER_ITERATIVE) )
       reset_efun = SUNFALSE;
@@ -1855,6 +1865,10 @@ int arkStep_TakeStep_Z(void* arkode_mem, realtype *dsmPtr, int *nflagPtr)
     return(TRY_AGAIN);
   }
 
+  /* accumulate the error estimate of fixed steps for MRIStep */
+  if (ark_mem->fixedstep && step_mem->accum_error)
+    step_mem->dsm_accum = SUNMAX(step_mem->dsm_accum, *dsmPtr);
+
 #ifdef SUNDIALS_LOGGING_EXTRA_DEBUG
   SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
                      "ARKODE::arkStep_TakeStep_Z", "updated solution",
@@ -2143,7 +2157,7 @@ int arkStep_CheckButcherTables(ARKodeMem ark_mem)
   }
 
   /* check that embedding exists */
-  if ((step_mem->p > 0) && (!ark_mem->fixedstep)) {
+  if ((step_mem->p > 0) && (!ark_mem->fixedstep || step_mem->accum_error)) {
     if (step_mem->implicit) {
       if (step_mem->Bi->d == NULL) {
         arkProcessError(ark_mem, ARK_INVALID_TABLE, "ARKODE::ARKStep",
@@ -2598,6 +2612,8 @@ int arkStep_ComputeSolutions(ARKodeMem ark_mem, realtype *dsmPtr)
 {
   /* local data */
   int retval, j, nvec;
+  booleantype started = SUNFALSE;
+  realtype dsm = ZERO;
   N_Vector y, yerr;
   realtype* cvals;
   N_Vector* Xvecs;
@@ -2622,6 +2638,33 @@ int arkStep_ComputeSolutions(ARKodeMem ark_mem, realtype *dsmPtr)
   /* initialize output */
   *dsmPtr = ZERO;
 
+  /* Compute yerr (if step adaptivity or error accumulation is enabled) first,
+     so that the reduction for its norm overlaps the time step solution update */
+  if (!ark_mem->fixedstep || (step_mem->accum_error && step_mem->p > 0)) {
+
+    /* set arrays for fused vector operation */
+    nvec = 0;
+    for (j=0; j<step_mem->stages; j++) {
+      if (step_mem->explicit) {        /* Explicit pieces */
+        cvals[nvec] = ark_mem->h * (step_mem->Be->b[j] - step_mem->Be->d[j]);
+        Xvecs[nvec] = step_mem->Fe[j];
+        nvec += 1;
+      }
+      if (step_mem->implicit) {        /* Implicit pieces */
+        cvals[nvec] = ark_mem->h * (step_mem->Bi->b[j] - step_mem->Bi->d[j]);
+        Xvecs[nvec] = step_mem->Fi[j];
+        nvec += 1;
+      }
+    }
+
+    /* call fused vector operation to do the work */
+    retval = N_VLinearCombination(nvec, cvals, Xvecs, yerr);
+    if (retval != 0) return(ARK_VECTOROP_ERR);
+
+    /* start error norm */
+    started = arkWrmsNormStart(yerr, ark_mem->ewt, &dsm);
+  }
+
   /* Compute time step solution */
   /*   set arrays for fused vector operation */
   cvals[0] = ONE;
@@ -2642,33 +2685,12 @@ int arkStep_ComputeSolutions(ARKodeMem ark_mem, realtype *dsmPtr)
 
   /*   call fused vector operation to do the work */
   retval = N_VLinearCombination(nvec, cvals, Xvecs, y);
-  if (retval != 0) return(ARK_VECTOROP_ERR);
 
-  /* Compute yerr (if step adaptivity enabled) */
-  if (!ark_mem->fixedstep) {
+  /* fill error norm */
+  if (!ark_mem->fixedstep || (step_mem->accum_error && step_mem->p > 0))
+    *dsmPtr = arkWrmsNormFinish(yerr, &dsm, started);
 
-    /* set arrays for fused vector operation */
-    nvec = 0;
-    for (j=0; j<step_mem->stages; j++) {
-      if (step_mem->explicit) {        /* Explicit pieces */
-        cvals[nvec] = ark_mem->h * (step_mem->Be->b[j] - step_mem->Be->d[j]);
-        Xvecs[nvec] = step_mem->Fe[j];
-        nvec += 1;
-      }
-      if (step_mem->implicit) {        /* Implicit pieces */
-        cvals[nvec] = ark_mem->h * (step_mem->Bi->b[j] - step_mem->Bi->d[j]);
-        Xvecs[nvec] = step_mem->Fi[j];
-        nvec += 1;
-      }
-    }
-
-    /* call fused vector operation to do the work */
-    retval = N_VLinearCombination(nvec, cvals, Xvecs, yerr);
-    if (retval != 0) return(ARK_VECTOROP_ERR);
-
-    /* fill error norm */
-    *dsmPtr = N_VWrmsNorm(yerr, ark_mem->ewt);
-  }
+  if (retval != 0) return(ARK_VECTOROP_ERR);
 
   return(ARK_SUCCESS);
 }
@@ -2747,8 +2769,8 @@ int arkStep_ComputeSolutions_MassFixed(ARKodeMem ark_mem, realtype *dsmPtr)
   N_VLinearSum(ONE, ark_mem->yn, ONE, y, y);
 
 
-  /* compute yerr (if step adaptivity enabled) */
-  if (!ark_mem->fixedstep) {
+  /* compute yerr (if step adaptivity or error accumulation is enabled) */
+  if (!ark_mem->fixedstep || (step_mem->accum_error && step_mem->p > 0)) {
 
     /* compute yerr RHS vector */
     /*   set arrays for fused vector operation */
@@ -2831,6 +2853,22 @@ int ARKStepCreateMRIStepInnerStepper(void *inner_arkode_mem,
                                           arkStep_MRIStepInnerReset);
   if (retval != ARK_SUCCESS) return(retval);
 
+  retval = MRIStepInnerStepper_SetFixedStepFn(*stepper,
+                                              arkStep_MRIStepInnerSetFixedStep);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  retval = MRIStepInnerStepper_SetAccumulatedErrorGetFn(*stepper,
+                                                        arkStep_MRIStepInnerGetAccumulatedError);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  retval = MRIStepInnerStepper_SetAccumulatedErrorResetFn(*stepper,
+                                                          arkStep_MRIStepInnerResetAccumulatedError);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  retval = MRIStepInnerStepper_SetEmbeddingOrderGetFn(*stepper,
+                                                      arkStep_MRIStepInnerGetEmbeddingOrder);
+  if (retval != ARK_SUCCESS) return(retval);
+
   return(ARK_SUCCESS);
 }
 
@@ -2925,6 +2963,129 @@ int arkStep_MRIStepInnerReset(MRIStepInnerStepper stepper, realtype tR,
 }
 
 
+/*------------------------------------------------------------------------------
+  arkStep_MRIStepInnerSetFixedStep
+
+  Implementation of MRIStepInnerSetFixedStepFn to set the step size used by
+  the inner (fast) stepper.
+  ----------------------------------------------------------------------------*/
+
+int arkStep_MRIStepInnerSetFixedStep(MRIStepInnerStepper stepper,
+                                     realtype hfixed)
+{
+  void* arkode_mem;
+  int   retval;
+
+  /* extract the ARKODE memory struct */
+  retval = MRIStepInnerStepper_GetContent(stepper, &arkode_mem);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  return(ARKStepSetFixedStep(arkode_mem, hfixed));
+}
+
+
+/*------------------------------------------------------------------------------
+  arkStep_MRIStepInnerGetAccumulatedError
+
+  Implementation of MRIStepInnerGetAccumulatedErrorFn to return the largest
+  local error estimate of the inner (fast) steps since the last reset. Only
+  tables with an embedding provide an estimate.
+  ----------------------------------------------------------------------------*/
+
+int arkStep_MRIStepInnerGetAccumulatedError(MRIStepInnerStepper stepper,
+                                            realtype *accum)
+{
+  void*            arkode_mem;
+  ARKodeMem        ark_mem;
+  ARKodeARKStepMem step_mem;
+  int              retval;
+
+  /* extract the ARKODE memory struct */
+  retval = MRIStepInnerStepper_GetContent(stepper, &arkode_mem);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  retval = arkStep_AccessStepMem(arkode_mem,
+                                 "arkStep_MRIStepInnerGetAccumulatedError",
+                                 &ark_mem, &step_mem);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  if (step_mem->p < 1) {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKODE::ARKStep",
+                    "arkStep_MRIStepInnerGetAccumulatedError",
+                    "The Butcher table(s) do not have an embedding");
+    return(ARK_ILL_INPUT);
+  }
+
+  *accum = step_mem->dsm_accum;
+  return(ARK_SUCCESS);
+}
+
+
+/*------------------------------------------------------------------------------
+  arkStep_MRIStepInnerResetAccumulatedError
+
+  Implementation of MRIStepInnerResetAccumulatedErrorFn to reset the local
+  error accumulation of the inner (fast) stepper. This also enables the error
+  estimation with fixed step sizes.
+  ----------------------------------------------------------------------------*/
+
+int arkStep_MRIStepInnerResetAccumulatedError(MRIStepInnerStepper stepper)
+{
+  void*            arkode_mem;
+  ARKodeMem        ark_mem;
+  ARKodeARKStepMem step_mem;
+  int              retval;
+
+  /* extract the ARKODE memory struct */
+  retval = MRIStepInnerStepper_GetContent(stepper, &arkode_mem);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  retval = arkStep_AccessStepMem(arkode_mem,
+                                 "arkStep_MRIStepInnerResetAccumulatedError",
+                                 &ark_mem, &step_mem);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  step_mem->accum_error = SUNTRUE;
+  step_mem->dsm_accum   = ZERO;
+  return(ARK_SUCCESS);
+}
+
+
+/*------------------------------------------------------------------------------
+  arkStep_MRIStepInnerGetEmbeddingOrder
+
+  Implementation of MRIStepInnerGetEmbeddingOrderFn to return the order of the
+  embedding of the inner (fast) stepper, i.e., of its local error estimate.
+  ----------------------------------------------------------------------------*/
+
+int arkStep_MRIStepInnerGetEmbeddingOrder(MRIStepInnerStepper stepper, int *p)
+{
+  void*            arkode_mem;
+  ARKodeMem        ark_mem;
+  ARKodeARKStepMem step_mem;
+  int              retval;
+
+  /* extract the ARKODE memory struct */
+  retval = MRIStepInnerStepper_GetContent(stepper, &arkode_mem);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  retval = arkStep_AccessStepMem(arkode_mem,
+                                 "arkStep_MRIStepInnerGetEmbeddingOrder",
+                                 &ark_mem, &step_mem);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  if (step_mem->p < 1) {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKODE::ARKStep",
+                    "arkStep_MRIStepInnerGetEmbeddingOrder",
+                    "The Butcher table(s) do not have an embedding");
+    return(ARK_ILL_INPUT);
+  }
+
+  *p = step_mem->p;
+  return(ARK_SUCCESS);
+}
+
+
 /*------------------------------------------------------------------------------
   arkStep_ApplyForcing
 
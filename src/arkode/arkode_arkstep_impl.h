@@ -157,6 +157,11 @@ typedef struct ARKodeARKStepMemRec {
   N_Vector*   forcing;     /* array of forcing vectors    */
   int         nforcing;    /* number of forcing vectors   */
 
+  /* Data for accumulating the local error estimates of fixed steps when
+     ARKStep is used as an MRIStep inner stepper */
+  booleantype accum_error; /* estimate error with fixed steps */
+  realtype    dsm_accum;   /* max error estimate since reset  */
+
 } *ARKodeARKStepMem;
 
 
@@ -229,6 +234,12 @@ int arkStep_MRIStepInnerFullRhs(MRIStepInnerStepper stepper, realtype t,
                                 N_Vector y, N_Vector f, int mode);
 int arkStep_MRIStepInnerReset(MRIStepInnerStepper stepper, realtype tR,
                               N_Vector yR);
+int arkStep_MRIStepInnerSetFixedStep(MRIStepInnerStepper stepper,
+                                     realtype hfixed);
+int arkStep_MRIStepInnerGetAccumulatedError(MRIStepInnerStepper stepper,
+                                            realtype *accum);
+int arkStep_MRIStepInnerResetAccumulatedError(MRIStepInnerStepper stepper);
+int arkStep_MRIStepInnerGetEmbeddingOrder(MRIStepInnerStepper stepper, int *p);
 
 /* private functions for relaxation */
 int arkStep_RelaxDeltaY(ARKodeMem ark_mem, N_Vector delta_y);
@@ -94,6 +94,8 @@ int ARKStepSetAdaptivityMethod(void *arkode_mem, int imethod, int idefault,
   return(arkSetAdaptivityMethod(arkode_mem, imethod, idefault, pq, adapt_params)); }
 int ARKStepSetAdaptivityFn(void *arkode_mem, ARKAdaptFn hfun, void *h_data) {
   return(arkSetAdaptivityFn(arkode_mem, hfun, h_data)); }
+int ARKStepSetAdaptController(void *arkode_mem, SUNAdaptController C) {
+  return(arkSetAdaptController(arkode_mem, C)); }
 int ARKStepSetMaxFirstGrowth(void *arkode_mem, realtype etamx1) {
   return(arkSetMaxFirstGrowth(arkode_mem, etamx1)); }
 int ARKStepSetMaxEFailGrowth(void *arkode_mem, realtype etamxf) {
@@ -124,6 +126,8 @@ int ARKStepSetMassLinearSolver(void *arkode_mem, SUNLinearSolver LS,
   return(arkLSSetMassLinearSolver(arkode_mem, LS, M, time_dep)); }
 int ARKStepSetJacFn(void *arkode_mem, ARKLsJacFn jac) {
   return(arkLSSetJacFn(arkode_mem, jac)); }
+int ARKStepSetJacSparsityPattern(void *arkode_mem, SUNMatrix P) {
+  return(arkLSSetJacSparsityPattern(arkode_mem, P)); }
 int ARKStepSetMassFn(void *arkode_mem, ARKLsMassFn mass) {
   return(arkLSSetMassFn(arkode_mem, mass)); }
 int ARKStepSetJacEvalFrequency(void *arkode_mem, long int msbj) {
@@ -272,6 +276,11 @@ int ARKStepSetRelaxFn(void* arkode_mem, ARKRelaxFn rfn, ARKRelaxJacFn rjac)
                         arkStep_RelaxDeltaE, arkStep_GetOrder);
 }
 
+int ARKStepSetRelaxHessFn(void* arkode_mem, ARKRelaxHessFn rhess)
+{
+  return arkRelaxSetHessFn(arkode_mem, rhess);
+}
+
 int ARKStepSetRelaxEtaFail(void* arkode_mem, sunrealtype eta_rf)
 {
   return arkRelaxSetEtaFail(arkode_mem, eta_rf);
@@ -323,6 +332,11 @@ int ARKStepGetNumRelaxJacEvals(void* arkode_mem, long int* J_evals)
   return arkRelaxGetNumRelaxJacEvals(arkode_mem, J_evals);
 }
 
+int ARKStepGetNumRelaxHessEvals(void* arkode_mem, long int* H_evals)
+{
+  return arkRelaxGetNumRelaxHessEvals(arkode_mem, H_evals);
+}
+
 int ARKStepGetNumRelaxFails(void* arkode_mem, long int* relax_fails)
 {
   return arkRelaxGetNumRelaxFails(arkode_mem, relax_fails);
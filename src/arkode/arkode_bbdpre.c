@@ -15,7 +15,9 @@
  * band-block-diagonal preconditioner, i.e. a block-diagonal
  * matrix with banded blocks, for use with ARKODE, the ARKLS
  * linear solver interface, and the MPI-parallel implementation
- * of NVECTOR.
+ * of NVECTOR. The sparse variant keeps sparse local blocks
+ * computed by colored difference quotients, split in sub-blocks
+ * that are factored and solved independently.
  *--------------------------------------------------------------*/
 
 #include <stdio.h>
@@ -27,7 +29,6 @@
 #include <sundials/sundials_math.h>
 #include <nvector/nvector_serial.h>
 
-
 #define MIN_INC_MULT RCONST(1000.0)
 #define ZERO         RCONST(0.0)
 #define ONE          RCONST(1.0)
@@ -42,13 +43,26 @@ static int ARKBBDPrecSolve(realtype t, N_Vector y, N_Vector fy,
                            realtype gamma, realtype delta,
                            int lr, void *bbd_data);
 
-/* Prototype for ARKBBDPrecFree */
+/* Prototypes of functions ARKBBDSparsePrecSetup and ARKBBDSparsePrecSolve */
+static int ARKBBDSparsePrecSetup(realtype t, N_Vector y, N_Vector fy,
+                                 booleantype jok, booleantype *jcurPtr,
+                                 realtype gamma, void *bbd_data);
+static int ARKBBDSparsePrecSolve(realtype t, N_Vector y, N_Vector fy,
+                                 N_Vector r, N_Vector z,
+                                 realtype gamma, realtype delta,
+                                 int lr, void *bbd_data);
+
+/* Prototypes for ARKBBDPrecFree and ARKBBDPrecFreeData */
 static int ARKBBDPrecFree(ARKodeMem ark_mem);
+static void ARKBBDPrecFreeData(ARKodeMem ark_mem, ARKBBDPrecData pdata);
 
 /* Prototype for difference quotient Jacobian calculation routine */
 static int ARKBBDDQJac(ARKBBDPrecData pdata, realtype t,
                        N_Vector y, N_Vector gy,
                        N_Vector ytemp, N_Vector gtemp);
+static int ARKBBDSparseDQJac(ARKBBDPrecData pdata, realtype t,
+                             N_Vector y, N_Vector gy,
+                             N_Vector ytemp, N_Vector gtemp);
 
 
 /*---------------------------------------------------------------
@@ -99,6 +113,18 @@ int ARKBBDPrecInit(void *arkode_mem, sunindextype Nlocal,
   pdata->mukeep = muk;
   pdata->mlkeep = mlk;
 
+  /* The local block is banded */
+  pdata->sparse = SUNFALSE;
+  pdata->nsub   = 0;
+  pdata->suboff = NULL;
+  pdata->colors = NULL;
+  pdata->dqinc  = NULL;
+  pdata->subJ   = NULL;
+  pdata->subP   = NULL;
+  pdata->subLS  = NULL;
+  pdata->zsub   = NULL;
+  pdata->rsub   = NULL;
+
   /* Allocate memory for saved Jacobian */
   pdata->savedJ = SUNBandMatrixStorage(Nlocal, muk, mlk, muk, ark_mem->sunctx);
   if (pdata->savedJ == NULL) {
@@ -274,6 +300,212 @@ int ARKBBDPrecInit(void *arkode_mem, sunindextype Nlocal,
 }
 
 
+/*-------------------------------------------------------------*/
+int ARKBBDPrecInitSparse(void *arkode_mem, sunindextype Nlocal,
+                         SUNMatrix Jpattern, int nsub,
+                         ARKBBDLinSolFn lsfn, realtype dqrely,
+                         ARKLocalFn gloc, ARKCommFn cfn)
+{
+  ARKodeMem      ark_mem;
+  ARKLsMem       arkls_mem;
+  ARKBBDPrecData pdata;
+  sunindextype   lrw1, liw1, ncolors;
+  long int       lrw, liw;
+  int            b, retval;
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(arkode_mem, "ARKBBDPrecInitSparse",
+                            &ark_mem, &arkls_mem);
+  if (retval != ARK_SUCCESS)  return(retval);
+
+  /* Test compatibility of NVECTOR package with the BBD preconditioner */
+  if(ark_mem->tempv1->ops->nvgetarraypointer == NULL) {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKBBDPRE",
+                    "ARKBBDPrecInitSparse", MSG_BBD_BAD_NVECTOR);
+    return(ARKLS_ILL_INPUT);
+  }
+
+  /* Test the pattern of the local block */
+  if ( (Nlocal < 1) || (Jpattern == NULL) ||
+       (SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(Jpattern) != Nlocal) ||
+       (SUNSparseMatrix_Columns(Jpattern) != Nlocal) ) {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKBBDPRE",
+                    "ARKBBDPrecInitSparse", MSG_BBD_BAD_MATRIX);
+    return(ARKLS_ILL_INPUT);
+  }
+
+  /* By default the local block is not split */
+  if (nsub < 1) nsub = 1;
+  if (nsub > Nlocal) nsub = (int) Nlocal;
+
+  /* Allocate data memory */
+  pdata = NULL;
+  pdata = (ARKBBDPrecData) malloc(sizeof *pdata);
+  if (pdata == NULL) {
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKBBDPRE",
+                    "ARKBBDPrecInitSparse", MSG_BBD_MEM_FAIL);
+    return(ARKLS_MEM_FAIL);
+  }
+
+  /* Set pointers to gloc and cfn, the banded data is not used */
+  pdata->arkode_mem = arkode_mem;
+  pdata->gloc = gloc;
+  pdata->cfn = cfn;
+  pdata->mudq = pdata->mldq = pdata->mukeep = pdata->mlkeep = 0;
+  pdata->savedJ = NULL;
+  pdata->savedP = NULL;
+  pdata->LS = NULL;
+  pdata->zlocal = NULL;
+  pdata->rlocal = NULL;
+  pdata->tmp1 = NULL;
+  pdata->tmp2 = NULL;
+  pdata->tmp3 = NULL;
+  pdata->n_local = Nlocal;
+
+  /* Allocate the sub-block arrays */
+  pdata->sparse = SUNTRUE;
+  pdata->nsub   = nsub;
+  pdata->suboff = (sunindextype *) malloc((nsub+1)*sizeof(sunindextype));
+  pdata->colors = (sunindextype *) malloc(Nlocal*sizeof(sunindextype));
+  pdata->dqinc  = (realtype *) malloc(Nlocal*sizeof(realtype));
+  pdata->subJ   = (SUNMatrix *) calloc(nsub, sizeof(SUNMatrix));
+  pdata->subP   = (SUNMatrix *) calloc(nsub, sizeof(SUNMatrix));
+  pdata->subLS  = (SUNLinearSolver *) calloc(nsub, sizeof(SUNLinearSolver));
+  pdata->zsub   = (N_Vector *) calloc(nsub, sizeof(N_Vector));
+  pdata->rsub   = (N_Vector *) calloc(nsub, sizeof(N_Vector));
+  if ( (pdata->suboff == NULL) || (pdata->colors == NULL) ||
+       (pdata->dqinc == NULL) || (pdata->subJ == NULL) ||
+       (pdata->subP == NULL) || (pdata->subLS == NULL) ||
+       (pdata->zsub == NULL) || (pdata->rsub == NULL) ||
+       !arkAllocVec(ark_mem, ark_mem->tempv1, &(pdata->tmp1)) ||
+       !arkAllocVec(ark_mem, ark_mem->tempv1, &(pdata->tmp2)) ||
+       !arkAllocVec(ark_mem, ark_mem->tempv1, &(pdata->tmp3)) ) {
+    ARKBBDPrecFreeData(ark_mem, pdata);
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKBBDPRE",
+                    "ARKBBDPrecInitSparse", MSG_BBD_MEM_FAIL);
+    return(ARKLS_MEM_FAIL);
+  }
+
+  /* Split the local block in sub-blocks of contiguous rows, the entries
+     coupling different sub-blocks are dropped */
+  for (b=0; b<=nsub; b++)
+    pdata->suboff[b] = (b*Nlocal)/nsub;
+
+  retval = SUNSparseMatrix_DiagonalBlocks(Jpattern, nsub, pdata->suboff,
+                                          pdata->subJ);
+  if (retval != SUNMAT_SUCCESS) {
+    ARKBBDPrecFreeData(ark_mem, pdata);
+    arkProcessError(ark_mem, ARKLS_SUNMAT_FAIL, "ARKBBDPRE",
+                    "ARKBBDPrecInitSparse", MSG_BBD_SPMAT_FAIL);
+    return(ARKLS_SUNMAT_FAIL);
+  }
+
+  /* Color the columns of each sub-block, the rows of different sub-blocks
+     are disjoint so they may share colors */
+  pdata->ncolors = 0;
+  for (b=0; b<nsub; b++) {
+    retval = SUNSparseMatrix_ColorColumns(pdata->subJ[b],
+                                          pdata->colors + pdata->suboff[b],
+                                          &ncolors);
+    if (retval != SUNMAT_SUCCESS) {
+      ARKBBDPrecFreeData(ark_mem, pdata);
+      arkProcessError(ark_mem, ARKLS_SUNMAT_FAIL, "ARKBBDPRE",
+                      "ARKBBDPrecInitSparse", MSG_BBD_SPMAT_FAIL);
+      return(ARKLS_SUNMAT_FAIL);
+    }
+    pdata->ncolors = SUNMAX(pdata->ncolors, ncolors);
+  }
+
+  /* Create the preconditioner matrix, local vectors and linear solver of
+     each sub-block */
+  for (b=0; b<nsub; b++) {
+    pdata->subP[b] = SUNMatClone(pdata->subJ[b]);
+    pdata->zsub[b] = N_VNewEmpty_Serial(pdata->suboff[b+1] - pdata->suboff[b],
+                                        ark_mem->sunctx);
+    pdata->rsub[b] = N_VNewEmpty_Serial(pdata->suboff[b+1] - pdata->suboff[b],
+                                        ark_mem->sunctx);
+    if ( (pdata->subP[b] == NULL) || (pdata->zsub[b] == NULL) ||
+         (pdata->rsub[b] == NULL) ) {
+      ARKBBDPrecFreeData(ark_mem, pdata);
+      arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKBBDPRE",
+                      "ARKBBDPrecInitSparse", MSG_BBD_MEM_FAIL);
+      return(ARKLS_MEM_FAIL);
+    }
+    retval = SUNMatCopy(pdata->subJ[b], pdata->subP[b]);
+    if (retval != SUNMAT_SUCCESS) {
+      ARKBBDPrecFreeData(ark_mem, pdata);
+      arkProcessError(ark_mem, ARKLS_SUNMAT_FAIL, "ARKBBDPRE",
+                      "ARKBBDPrecInitSparse", MSG_BBD_SPMAT_FAIL);
+      return(ARKLS_SUNMAT_FAIL);
+    }
+
+    if (lsfn != NULL)
+      pdata->subLS[b] = lsfn(pdata->rsub[b], pdata->subP[b],
+                             ark_mem->sunctx);
+    else
+      pdata->subLS[b] = SUNLinSol_ILU(pdata->rsub[b], pdata->subP[b], 0,
+                                      ark_mem->sunctx);
+    if (pdata->subLS[b] == NULL) {
+      ARKBBDPrecFreeData(ark_mem, pdata);
+      arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKBBDPRE",
+                      "ARKBBDPrecInitSparse", MSG_BBD_MEM_FAIL);
+      return(ARKLS_MEM_FAIL);
+    }
+    retval = SUNLinSolInitialize(pdata->subLS[b]);
+    if (retval != SUNLS_SUCCESS) {
+      ARKBBDPrecFreeData(ark_mem, pdata);
+      arkProcessError(ark_mem, ARKLS_SUNLS_FAIL, "ARKBBDPRE",
+                      "ARKBBDPrecInitSparse", MSG_BBD_SPLS_FAIL);
+      return(ARKLS_SUNLS_FAIL);
+    }
+  }
+
+  /* Set dqrely based on input dqrely (0 implies default). */
+  pdata->dqrely = (dqrely > ZERO) ?
+    dqrely : SUNRsqrt(ark_mem->uround);
+
+  /* Set work space sizes and initialize nge */
+  pdata->rpwsize = Nlocal;
+  pdata->ipwsize = Nlocal + nsub + 1;
+  if (ark_mem->tempv1->ops->nvspace) {
+    N_VSpace(ark_mem->tempv1, &lrw1, &liw1);
+    pdata->rpwsize += 3*lrw1;
+    pdata->ipwsize += 3*liw1;
+  }
+  for (b=0; b<nsub; b++) {
+    if (pdata->subJ[b]->ops->space) {
+      retval = SUNMatSpace(pdata->subJ[b], &lrw, &liw);
+      pdata->rpwsize += 2*lrw;
+      pdata->ipwsize += 2*liw;
+    }
+    if (pdata->subLS[b]->ops->space) {
+      retval = SUNLinSolSpace(pdata->subLS[b], &lrw, &liw);
+      pdata->rpwsize += lrw;
+      pdata->ipwsize += liw;
+    }
+  }
+  pdata->nge = 0;
+
+  /* make sure P_data is free from any previous allocations */
+  if (arkls_mem->pfree)
+    arkls_mem->pfree(ark_mem);
+
+  /* Point to the new P_data field in the LS memory */
+  arkls_mem->P_data = pdata;
+
+  /* Attach the pfree function */
+  arkls_mem->pfree = ARKBBDPrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  retval = arkLSSetPreconditioner(arkode_mem,
+                                  ARKBBDSparsePrecSetup,
+                                  ARKBBDSparsePrecSolve);
+
+  return(retval);
+}
+
+
 /*-------------------------------------------------------------*/
 int ARKBBDPrecReInit(void *arkode_mem, sunindextype mudq,
                      sunindextype mldq, realtype dqrely)
@@ -297,7 +529,7 @@ int ARKBBDPrecReInit(void *arkode_mem, sunindextype mudq,
   }
   pdata = (ARKBBDPrecData) arkls_mem->P_data;
 
-  /* Load half-bandwidths */
+  /* Load half-bandwidths (not used with a sparse local block) */
   Nlocal = pdata->n_local;
   pdata->mudq = SUNMIN(Nlocal-1, SUNMAX(0,mudq));
   pdata->mldq = SUNMIN(Nlocal-1, SUNMAX(0,mldq));
@@ -555,6 +787,40 @@ static int ARKBBDPrecFree(ARKodeMem ark_mem)
   if (arkls_mem->P_data == NULL) return(0);
   pdata = (ARKBBDPrecData) arkls_mem->P_data;
 
+  ARKBBDPrecFreeData(ark_mem, pdata);
+  pdata = NULL;
+
+  return(0);
+}
+
+
+/*---------------------------------------------------------------
+ ARKBBDPrecFreeData:
+
+ Frees the preconditioner data of either kind of local block.
+---------------------------------------------------------------*/
+static void ARKBBDPrecFreeData(ARKodeMem ark_mem, ARKBBDPrecData pdata)
+{
+  int b;
+
+  if (pdata->sparse) {
+    for (b=0; b<pdata->nsub; b++) {
+      if (pdata->subLS) SUNLinSolFree(pdata->subLS[b]);
+      if (pdata->subP)  SUNMatDestroy(pdata->subP[b]);
+      if (pdata->subJ)  SUNMatDestroy(pdata->subJ[b]);
+      if (pdata->zsub)  N_VDestroy(pdata->zsub[b]);
+      if (pdata->rsub)  N_VDestroy(pdata->rsub[b]);
+    }
+    free(pdata->suboff);
+    free(pdata->colors);
+    free(pdata->dqinc);
+    free(pdata->subLS);
+    free(pdata->subP);
+    free(pdata->subJ);
+    free(pdata->zsub);
+    free(pdata->rsub);
+  }
+
   SUNLinSolFree(pdata->LS);
   arkFreeVec(ark_mem, &(pdata->tmp1));
   arkFreeVec(ark_mem, &(pdata->tmp2));
@@ -565,9 +831,119 @@ static int ARKBBDPrecFree(ARKodeMem ark_mem)
   SUNMatDestroy(pdata->savedJ);
 
   free(pdata);
-  pdata = NULL;
+}
 
-  return(0);
+
+/*---------------------------------------------------------------
+ ARKBBDSparsePrecSetup:
+
+ ARKBBDSparsePrecSetup is the setup routine of the preconditioner
+ created by ARKBBDPrecInitSparse. It calculates a new sparse J by
+ colored difference quotients if jok == SUNFALSE, then forms
+ P = I - gamma*J on each sub-block of the local block and
+ factors it with the sub-block linear solver.
+
+ The parameters and return values are the same as for
+ ARKBBDPrecSetup.
+---------------------------------------------------------------*/
+static int ARKBBDSparsePrecSetup(realtype t, N_Vector y, N_Vector fy,
+                                 booleantype jok, booleantype *jcurPtr,
+                                 realtype gamma, void *bbd_data)
+{
+  ARKBBDPrecData pdata;
+  ARKodeMem ark_mem;
+  int b, retval, matfail, lsneg, lspos;
+
+  pdata = (ARKBBDPrecData) bbd_data;
+
+  ark_mem = (ARKodeMem) pdata->arkode_mem;
+
+  /* If jok = SUNTRUE, use saved copy of J, otherwise compute a new one */
+  if (jok) {
+    *jcurPtr = SUNFALSE;
+  } else {
+    *jcurPtr = SUNTRUE;
+    retval = ARKBBDSparseDQJac(pdata, t, y, pdata->tmp1,
+                               pdata->tmp2, pdata->tmp3);
+    if (retval < 0) {
+      arkProcessError(ark_mem, -1, "ARKBBDPRE", "ARKBBDSparsePrecSetup",
+                      MSG_BBD_FUNC_FAILED);
+      return(-1);
+    }
+    if (retval > 0) {
+      return(1);
+    }
+  }
+
+  /* Form P = I - gamma*J and factor each sub-block */
+  matfail = 0;
+  lsneg = 0;
+  lspos = 0;
+  for (b=0; b<pdata->nsub; b++) {
+    retval = SUNMatCopy(pdata->subJ[b], pdata->subP[b]);
+    if (retval == SUNMAT_SUCCESS)
+      retval = SUNMatScaleAddI(-gamma, pdata->subP[b]);
+    if (retval != SUNMAT_SUCCESS) {
+      matfail = 1;
+      continue;
+    }
+    retval = SUNLinSolSetup(pdata->subLS[b], pdata->subP[b]);
+    if (retval < 0) lsneg = SUNMIN(lsneg, retval);
+    if (retval > 0) lspos = SUNMAX(lspos, retval);
+  }
+
+  if (matfail) {
+    arkProcessError(ark_mem, -1, "ARKBBDPRE",
+                    "ARKBBDSparsePrecSetup", MSG_BBD_SPMAT_FAIL);
+    return(-1);
+  }
+
+  /* Return an unrecoverable failure first, then a recoverable one */
+  return((lsneg < 0) ? lsneg : lspos);
+}
+
+
+/*---------------------------------------------------------------
+ ARKBBDSparsePrecSolve:
+
+ ARKBBDSparsePrecSolve solves a linear system P z = r, with the
+ block-diagonal preconditioner matrix generated and factored by
+ ARKBBDSparsePrecSetup. The local parts of r and z are attached
+ to the sub-block vectors and the sub-block systems are solved
+ one after the other.
+---------------------------------------------------------------*/
+static int ARKBBDSparsePrecSolve(realtype t, N_Vector y, N_Vector fy,
+                                 N_Vector r, N_Vector z,
+                                 realtype gamma, realtype delta,
+                                 int lr, void *bbd_data)
+{
+  ARKBBDPrecData pdata;
+  realtype *rdata, *zdata;
+  int b, retval, lsneg, lspos;
+
+  pdata = (ARKBBDPrecData) bbd_data;
+
+  rdata = N_VGetArrayPointer(r);
+  zdata = N_VGetArrayPointer(z);
+
+  lsneg = 0;
+  lspos = 0;
+  for (b=0; b<pdata->nsub; b++) {
+    /* Attach the sub-block data of r and z to rsub and zsub */
+    N_VSetArrayPointer(rdata + pdata->suboff[b], pdata->rsub[b]);
+    N_VSetArrayPointer(zdata + pdata->suboff[b], pdata->zsub[b]);
+
+    retval = SUNLinSolSolve(pdata->subLS[b], pdata->subP[b],
+                            pdata->zsub[b], pdata->rsub[b], ZERO);
+    if (retval < 0) lsneg = SUNMIN(lsneg, retval);
+    if (retval > 0) lspos = SUNMAX(lspos, retval);
+
+    /* Detach the sub-block data */
+    N_VSetArrayPointer(NULL, pdata->rsub[b]);
+    N_VSetArrayPointer(NULL, pdata->zsub[b]);
+  }
+
+  return((lsneg < 0) ? lsneg : lspos);
 }
 
 
@@ -681,6 +1057,122 @@ static int ARKBBDDQJac(ARKBBDPrecData pdata, realtype t,
 }
 
 
+/*---------------------------------------------------------------
+ ARKBBDSparseDQJac:
+
+ This routine generates a sparse difference quotient approximation
+ to the sub-blocks of the local block of the Jacobian of g(t,y).
+ The columns of the sub-blocks are colored so that columns of one
+ color do not share any rows, and all y_j of a color are perturbed
+ together. The number of calls to gloc is therefore the number of
+ colors plus one, independently of the bandwidth of the block.
+---------------------------------------------------------------*/
+static int ARKBBDSparseDQJac(ARKBBDPrecData pdata, realtype t,
+                             N_Vector y, N_Vector gy,
+                             N_Vector ytemp, N_Vector gtemp)
+{
+  ARKodeMem ark_mem;
+  realtype gnorm, minInc, inc, conj;
+  sunindextype color, b, i, j, p, s, nb;
+  sunindextype *colors, *Jp, *Ji;
+  realtype *y_data, *ewt_data, *gy_data, *gtemp_data;
+  realtype *ytemp_data, *cns_data, *inc_data, *J_data;
+  int retval;
+
+  ark_mem = (ARKodeMem) pdata->arkode_mem;
+
+  /* Load ytemp with y = predicted solution vector */
+  N_VScale(ONE, y, ytemp);
+
+  /* Call cfn and gloc to get base value of g(t,y) */
+  if (pdata->cfn != NULL) {
+    retval = pdata->cfn(pdata->n_local, t, y, ark_mem->user_data);
+    if (retval != 0) return(retval);
+  }
+
+  retval = pdata->gloc(pdata->n_local, t, ytemp, gy,
+                       ark_mem->user_data);
+  pdata->nge++;
+  if (retval != 0) return(retval);
+
+  /* Obtain pointers to the data for various vectors */
+  y_data     =  N_VGetArrayPointer(y);
+  gy_data    =  N_VGetArrayPointer(gy);
+  ewt_data   =  N_VGetArrayPointer(ark_mem->ewt);
+  ytemp_data =  N_VGetArrayPointer(ytemp);
+  gtemp_data =  N_VGetArrayPointer(gtemp);
+  cns_data = (ark_mem->constraintsSet) ?
+    N_VGetArrayPointer(ark_mem->constraints) : NULL;
+  colors   = pdata->colors;
+  inc_data = pdata->dqinc;
+
+  /* Set minimum increment based on uround and norm of g */
+  gnorm = N_VWrmsNorm(gy, ark_mem->rwt);
+  minInc = (gnorm != ZERO) ?
+    (MIN_INC_MULT * SUNRabs(ark_mem->h) *
+     ark_mem->uround * pdata->n_local * gnorm) : ONE;
+
+  /* Compute the increment for each column */
+  for (j=0; j < pdata->n_local; j++) {
+    inc = SUNMAX(pdata->dqrely*SUNRabs(y_data[j]), minInc/ewt_data[j]);
+
+    /* Adjust sign(inc) if yj has an inequality constraint. */
+    if (ark_mem->constraintsSet) {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)      {if ((y_data[j]+inc)*conj < ZERO)  inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if ((y_data[j]+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    inc_data[j] = inc;
+  }
+
+  /* Loop over column colors */
+  for (color=0; color < pdata->ncolors; color++) {
+
+    /* Increment all y_j of this color */
+    for (j=0; j < pdata->n_local; j++)
+      if (colors[j] == color) ytemp_data[j] += inc_data[j];
+
+    /* Evaluate g with incremented y */
+    retval = pdata->gloc(pdata->n_local, t, ytemp, gtemp,
+                         ark_mem->user_data);
+    pdata->nge++;
+    if (retval != 0) return(retval);
+
+    /* Restore ytemp, then form and load difference quotients */
+    for (j=0; j < pdata->n_local; j++)
+      if (colors[j] == color) ytemp_data[j] = y_data[j];
+
+    for (b=0; b < pdata->nsub; b++) {
+      s      = pdata->suboff[b];
+      nb     = pdata->suboff[b+1] - s;
+      Jp     = SUNSparseMatrix_IndexPointers(pdata->subJ[b]);
+      Ji     = SUNSparseMatrix_IndexValues(pdata->subJ[b]);
+      J_data = SUNSparseMatrix_Data(pdata->subJ[b]);
+      if (SUNSparseMatrix_SparseType(pdata->subJ[b]) == CSC_MAT) {
+        for (j=0; j < nb; j++) {
+          if (colors[s+j] != color) continue;
+          for (p=Jp[j]; p < Jp[j+1]; p++) {
+            i = s + Ji[p];
+            J_data[p] = (gtemp_data[i] - gy_data[i]) / inc_data[s+j];
+          }
+        }
+      } else {
+        for (i=0; i < nb; i++) {
+          for (p=Jp[i]; p < Jp[i+1]; p++) {
+            j = s + Ji[p];
+            if (colors[j] == color)
+              J_data[p] = (gtemp_data[s+i] - gy_data[s+i]) / inc_data[j];
+          }
+        }
+      }
+    }
+  }
+
+  return(0);
+}
+
+
 
 /*---------------------------------------------------------------
     EOF
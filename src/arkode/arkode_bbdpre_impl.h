@@ -20,6 +20,8 @@
 #include <arkode/arkode_bbdpre.h>
 #include <sunmatrix/sunmatrix_band.h>
 #include <sunlinsol/sunlinsol_band.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+#include <sunlinsol/sunlinsol_ilu.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
 extern "C" {
@@ -50,6 +52,20 @@ typedef struct ARKBBDPrecDataRec {
   /* set by ARKBBDPrecAlloc and used by ARKBBDPrecSetup */
   sunindextype n_local;
 
+  /* set by ARKBBDPrecInitSparse for a sparse local block split in nsub
+     diagonal sub-blocks starting at the rows suboff */
+  booleantype sparse;
+  int nsub;
+  sunindextype *suboff;
+  sunindextype *colors;
+  sunindextype ncolors;
+  realtype *dqinc;
+  SUNMatrix *subJ;
+  SUNMatrix *subP;
+  SUNLinearSolver *subLS;
+  N_Vector *zsub;
+  N_Vector *rsub;
+
   /* available for optional output */
   long int rpwsize;
   long int ipwsize;
@@ -72,6 +88,9 @@ typedef struct ARKBBDPrecDataRec {
 #define MSG_BBD_SUNMAT_FAIL "An error arose from a SUNBandMatrix routine."
 #define MSG_BBD_SUNLS_FAIL  "An error arose from a SUNBandLinearSolver routine."
 #define MSG_BBD_PMEM_NULL   "BBD peconditioner memory is NULL. ARKBBDPrecInit must be called."
+#define MSG_BBD_SPMAT_FAIL  "An error arose from a SUNSparseMatrix routine."
+#define MSG_BBD_SPLS_FAIL   "An error arose from a local block linear solver."
+#define MSG_BBD_BAD_MATRIX  "The local Jacobian pattern must be a square SUNMATRIX_SPARSE matrix of size Nlocal."
 #define MSG_BBD_FUNC_FAILED "The gloc or cfn routine failed in an unrecoverable manner."
 
 #ifdef __cplusplus
@@ -1106,6 +1106,8 @@ int erkStep_ComputeSolutions(ARKodeMem ark_mem, realtype *dsmPtr)
 {
   /* local data */
   int retval, j, nvec;
+  booleantype started = SUNFALSE;
+  realtype dsm = ZERO;
   N_Vector y, yerr;
   realtype* cvals;
   N_Vector* Xvecs;
@@ -1131,6 +1133,26 @@ int erkStep_ComputeSolutions(ARKodeMem ark_mem, realtype *dsmPtr)
   *dsmPtr = ZERO;
 
 
+  /* Compute yerr (if step adaptivity enabled) first, so that the
+     reduction for its norm overlaps the time step solution update */
+  if (!ark_mem->fixedstep) {
+
+    /* set arrays for fused vector operation */
+    nvec = 0;
+    for (j=0; j<step_mem->stages; j++) {
+      cvals[nvec] = ark_mem->h * (step_mem->B->b[j] - step_mem->B->d[j]);
+      Xvecs[nvec] = step_mem->F[j];
+      nvec += 1;
+    }
+
+    /* call fused vector operation to do the work */
+    retval = N_VLinearCombination(nvec, cvals, Xvecs, yerr);
+    if (retval != 0) return(ARK_VECTOROP_ERR);
+
+    /* start error norm */
+    started = arkWrmsNormStart(yerr, ark_mem->ewt, &dsm);
+  }
+
   /* Compute time step solution */
   /*   set arrays for fused vector operation */
   nvec = 0;
@@ -1145,26 +1167,12 @@ int erkStep_ComputeSolutions(ARKodeMem ark_mem, realtype *dsmPtr)
 
   /*   call fused vector operation to do the work */
   retval = N_VLinearCombination(nvec, cvals, Xvecs, y);
-  if (retval != 0) return(ARK_VECTOROP_ERR);
-
-  /* Compute yerr (if step adaptivity enabled) */
-  if (!ark_mem->fixedstep) {
-
-    /* set arrays for fused vector operation */
-    nvec = 0;
-    for (j=0; j<step_mem->stages; j++) {
-      cvals[nvec] = ark_mem->h * (step_mem->B->b[j] - step_mem->B->d[j]);
-      Xvecs[nvec] = step_mem->F[j];
-      nvec += 1;
-    }
 
-    /* call fused vector operation to do the work */
-    retval = N_VLinearCombination(nvec, cvals, Xvecs, yerr);
-    if (retval != 0) return(ARK_VECTOROP_ERR);
+  /* fill error norm */
+  if (!ark_mem->fixedstep)
+    *dsmPtr = arkWrmsNormFinish(yerr, &dsm, started);
 
-    /* fill error norm */
-    *dsmPtr = N_VWrmsNorm(yerr, ark_mem->ewt);
-  }
+  if (retval != 0) return(ARK_VECTOROP_ERR);
 
   return(ARK_SUCCESS);
 }
@@ -95,6 +95,8 @@ int ERKStepSetAdaptivityMethod(void *arkode_mem, int imethod, int idefault,
   return(arkSetAdaptivityMethod(arkode_mem, imethod, idefault, pq, adapt_params)); }
 int ERKStepSetAdaptivityFn(void *arkode_mem, ARKAdaptFn hfun, void *h_data) {
   return(arkSetAdaptivityFn(arkode_mem, hfun, h_data)); }
+int ERKStepSetAdaptController(void *arkode_mem, SUNAdaptController C) {
+  return(arkSetAdaptController(arkode_mem, C)); }
 int ERKStepSetMaxFirstGrowth(void *arkode_mem, realtype etamx1) {
   return(arkSetMaxFirstGrowth(arkode_mem, etamx1)); }
 int ERKStepSetMaxEFailGrowth(void *arkode_mem, realtype etamxf) {
@@ -163,6 +165,11 @@ int ERKStepSetRelaxFn(void* arkode_mem, ARKRelaxFn rfn, ARKRelaxJacFn rjac)
                         erkStep_RelaxDeltaE, erkStep_GetOrder);
 }
 
+int ERKStepSetRelaxHessFn(void* arkode_mem, ARKRelaxHessFn rhess)
+{
+  return arkRelaxSetHessFn(arkode_mem, rhess);
+}
+
 int ERKStepSetRelaxEtaFail(void* arkode_mem, sunrealtype eta_rf)
 {
   return arkRelaxSetEtaFail(arkode_mem, eta_rf);
@@ -214,6 +221,11 @@ int ERKStepGetNumRelaxJacEvals(void* arkode_mem, long int* J_evals)
   return arkRelaxGetNumRelaxJacEvals(arkode_mem, J_evals);
 }
 
+int ERKStepGetNumRelaxHessEvals(void* arkode_mem, long int* H_evals)
+{
+  return arkRelaxGetNumRelaxHessEvals(arkode_mem, H_evals);
+}
+
 int ERKStepGetNumRelaxFails(void* arkode_mem, long int* relax_fails)
 {
   return arkRelaxGetNumRelaxFails(arkode_mem, relax_fails);
@@ -0,0 +1,494 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file contains implementations of the incomplete LU
+ * preconditioner and solver routines for use with the ARKLS linear
+ * solver interface.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode_impl.h"
+#include "arkode_ilupre_impl.h"
+#include "arkode_ls_impl.h"
+#include <sundials/sundials_math.h>
+
+#define ZERO         RCONST(0.0)
+#define ONE          RCONST(1.0)
+
+/* Prototypes of ARKILUPrecSetup and ARKILUPrecSolve */
+static int ARKILUPrecSetup(realtype t, N_Vector y, N_Vector fy,
+                           booleantype jok, booleantype *jcurPtr,
+                           realtype gamma, void *ip_data);
+static int ARKILUPrecSolve(realtype t, N_Vector y, N_Vector fy,
+                           N_Vector r, N_Vector z,
+                           realtype gamma, realtype delta,
+                           int lr, void *ip_data);
+
+/* Prototype for ARKILUPrecFree */
+static int ARKILUPrecFree(ARKodeMem ark_mem);
+
+/* Prototype for the shared access routine */
+static int ARKILUPrecAccess(void *arkode_mem, const char *fname,
+                            ARKodeMem *ark_mem, ARKILUPrecData *pdata);
+
+
+/*---------------------------------------------------------------
+ Initialization, Free, and Get Functions
+ NOTE: The ILU linear solver assumes a serial/OpenMP/Pthreads
+       implementation of the NVECTOR package. Therefore,
+       ARKILUPrecInit will first test for a compatible N_Vector
+       internal representation by checking that the function
+       N_VGetArrayPointer exists.
+---------------------------------------------------------------*/
+int ARKILUPrecInit(void *arkode_mem, SUNMatrix J, ARKLsJacFn jac,
+                   int fill_level)
+{
+  ARKodeMem ark_mem;
+  ARKLsMem arkls_mem;
+  ARKILUPrecData pdata;
+  int flag;
+
+  /* access ARKLsMem structure */
+  flag = arkLs_AccessLMem(arkode_mem, "ARKILUPrecInit",
+                          &ark_mem, &arkls_mem);
+  if (flag != ARK_SUCCESS)  return(flag);
+
+  /* Test compatibility of NVECTOR package with the ILU preconditioner */
+  if(ark_mem->tempv1->ops->nvgetarraypointer == NULL) {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_BAD_NVECTOR);
+    return(ARKLS_ILL_INPUT);
+  }
+
+  /* Test the Jacobian template, function and fill level */
+  if ( (J == NULL) || (SUNMatGetID(J) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(J) != SUNSparseMatrix_Columns(J)) ||
+       (SUNSparseMatrix_Rows(J) != N_VGetLength(ark_mem->tempv1)) ) {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_BAD_MATRIX);
+    return(ARKLS_ILL_INPUT);
+  }
+  if (jac == NULL) {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_JAC_NULL);
+    return(ARKLS_ILL_INPUT);
+  }
+  if (fill_level < 0) {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_BAD_FILL);
+    return(ARKLS_ILL_INPUT);
+  }
+
+  /* Allocate data memory */
+  pdata = NULL;
+  pdata = (ARKILUPrecData) malloc(sizeof *pdata);
+  if (pdata == NULL) {
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_MEM_FAIL);
+    return(ARKLS_MEM_FAIL);
+  }
+
+  /* Load pointers into pdata block. */
+  pdata->arkode_mem = arkode_mem;
+  pdata->jac       = jac;
+  pdata->gammaP    = ZERO;
+  pdata->factored  = SUNFALSE;
+
+  /* Initialize counters */
+  pdata->njeIP   = 0;
+  pdata->nfactIP = 0;
+
+  /* Allocate memory for the saved Jacobian and the preconditioner matrix
+     with the pattern of the template */
+  pdata->savedJ = NULL;
+  pdata->savedJ = SUNMatClone(J);
+  if (pdata->savedJ == NULL) {
+    free(pdata); pdata = NULL;
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_MEM_FAIL);
+    return(ARKLS_MEM_FAIL);
+  }
+  flag = SUNMatCopy(J, pdata->savedJ);
+  if (flag != SUNMAT_SUCCESS) {
+    SUNMatDestroy(pdata->savedJ);
+    free(pdata); pdata = NULL;
+    arkProcessError(ark_mem, ARKLS_SUNMAT_FAIL, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_SUNMAT_FAIL);
+    return(ARKLS_SUNMAT_FAIL);
+  }
+
+  pdata->savedP = NULL;
+  pdata->savedP = SUNMatClone(J);
+  if (pdata->savedP == NULL) {
+    SUNMatDestroy(pdata->savedJ);
+    free(pdata); pdata = NULL;
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_MEM_FAIL);
+    return(ARKLS_MEM_FAIL);
+  }
+
+  /* Allocate memory for the ILU linear solver */
+  pdata->LS = NULL;
+  pdata->LS = SUNLinSol_ILU(ark_mem->tempv1, pdata->savedP, fill_level,
+                            ark_mem->sunctx);
+  if (pdata->LS == NULL) {
+    SUNMatDestroy(pdata->savedP);
+    SUNMatDestroy(pdata->savedJ);
+    free(pdata); pdata = NULL;
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_MEM_FAIL);
+    return(ARKLS_MEM_FAIL);
+  }
+
+  /* allocate memory for temporary N_Vectors */
+  pdata->tmp1 = NULL;
+  pdata->tmp2 = NULL;
+  pdata->tmp3 = NULL;
+  if (!arkAllocVec(ark_mem, ark_mem->tempv1, &(pdata->tmp1)) ||
+      !arkAllocVec(ark_mem, ark_mem->tempv1, &(pdata->tmp2)) ||
+      !arkAllocVec(ark_mem, ark_mem->tempv1, &(pdata->tmp3))) {
+    SUNLinSolFree(pdata->LS);
+    SUNMatDestroy(pdata->savedP);
+    SUNMatDestroy(pdata->savedJ);
+    arkFreeVec(ark_mem, &(pdata->tmp1));
+    arkFreeVec(ark_mem, &(pdata->tmp2));
+    arkFreeVec(ark_mem, &(pdata->tmp3));
+    free(pdata); pdata = NULL;
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_MEM_FAIL);
+    return(ARKLS_MEM_FAIL);
+  }
+
+  /* initialize ILU linear solver object */
+  flag = SUNLinSolInitialize(pdata->LS);
+  if (flag != SUNLS_SUCCESS) {
+    SUNLinSolFree(pdata->LS);
+    SUNMatDestroy(pdata->savedP);
+    SUNMatDestroy(pdata->savedJ);
+    arkFreeVec(ark_mem, &(pdata->tmp1));
+    arkFreeVec(ark_mem, &(pdata->tmp2));
+    arkFreeVec(ark_mem, &(pdata->tmp3));
+    free(pdata); pdata = NULL;
+    arkProcessError(ark_mem, ARKLS_SUNLS_FAIL, "ARKILUPRE",
+                    "ARKILUPrecInit", MSG_IP_SUNLS_FAIL);
+    return(ARKLS_SUNLS_FAIL);
+  }
+
+  /* make sure P_data is free from any previous allocations */
+  if (arkls_mem->pfree)
+    arkls_mem->pfree(ark_mem);
+
+  /* Point to the new P_data field in the LS memory */
+  arkls_mem->P_data = pdata;
+
+  /* Attach the pfree function */
+  arkls_mem->pfree = ARKILUPrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = arkLSSetPreconditioner(arkode_mem,
+                                ARKILUPrecSetup,
+                                ARKILUPrecSolve);
+  return(flag);
+}
+
+
+int ARKILUPrecGetWorkSpace(void *arkode_mem, long int *lenrwIP,
+                           long int *leniwIP)
+{
+  ARKodeMem ark_mem;
+  ARKILUPrecData pdata;
+  sunindextype lrw1, liw1;
+  long int lrw, liw;
+  int flag;
+
+  flag = ARKILUPrecAccess(arkode_mem, "ARKILUPrecGetWorkSpace",
+                          &ark_mem, &pdata);
+  if (flag != ARKLS_SUCCESS) return(flag);
+
+  /* sum space requirements for all objects in pdata */
+  *leniwIP = 6;
+  *lenrwIP = 1;
+  if (ark_mem->tempv1->ops->nvspace) {
+    N_VSpace(ark_mem->tempv1, &lrw1, &liw1);
+    *leniwIP += 3*liw1;
+    *lenrwIP += 3*lrw1;
+  }
+  if (pdata->savedJ->ops->space) {
+    flag = SUNMatSpace(pdata->savedJ, &lrw, &liw);
+    if (flag != 0) return(-1);
+    *leniwIP += liw;
+    *lenrwIP += lrw;
+  }
+  if (pdata->savedP->ops->space) {
+    flag = SUNMatSpace(pdata->savedP, &lrw, &liw);
+    if (flag != 0) return(-1);
+    *leniwIP += liw;
+    *lenrwIP += lrw;
+  }
+  if (pdata->LS->ops->space) {
+    flag = SUNLinSolSpace(pdata->LS, &lrw, &liw);
+    if (flag != 0) return(-1);
+    *leniwIP += liw;
+    *lenrwIP += lrw;
+  }
+
+  return(ARKLS_SUCCESS);
+}
+
+
+int ARKILUPrecGetNumJacEvals(void *arkode_mem, long int *njevalsIP)
+{
+  ARKodeMem ark_mem;
+  ARKILUPrecData pdata;
+  int flag;
+
+  flag = ARKILUPrecAccess(arkode_mem, "ARKILUPrecGetNumJacEvals",
+                          &ark_mem, &pdata);
+  if (flag != ARKLS_SUCCESS) return(flag);
+
+  *njevalsIP = pdata->njeIP;
+
+  return(ARKLS_SUCCESS);
+}
+
+
+int ARKILUPrecGetNumFactorizations(void *arkode_mem, long int *nfactIP)
+{
+  ARKodeMem ark_mem;
+  ARKILUPrecData pdata;
+  int flag;
+
+  flag = ARKILUPrecAccess(arkode_mem, "ARKILUPrecGetNumFactorizations",
+                          &ark_mem, &pdata);
+  if (flag != ARKLS_SUCCESS) return(flag);
+
+  *nfactIP = pdata->nfactIP;
+
+  return(ARKLS_SUCCESS);
+}
+
+
+/*---------------------------------------------------------------
+ ARKILUPrecSetup:
+
+ Together ARKILUPrecSetup and ARKILUPrecSolve use an incomplete LU
+ factorization of P = I - gamma*J as the preconditioner, where J
+ is computed by the user-supplied sparse Jacobian function.
+
+ The parameters of ARKILUPrecSetup are as follows:
+
+ t       is the current value of the independent variable.
+
+ y       is the current value of the dependent variable vector,
+         namely the predicted value of y(t).
+
+ fy      is the vector f(t,y).
+
+ jok     is an input flag indicating whether Jacobian-related
+         data needs to be recomputed, as follows:
+           jok == SUNFALSE means recompute Jacobian-related data
+                  from scratch.
+           jok == SUNTRUE means that Jacobian data from the
+                  previous PrecSetup call will be reused
+                  (with the current value of gamma).
+         A ARKILUPrecSetup call with jok == SUNTRUE should only
+         occur after a call with jok == SUNFALSE.
+
+ *jcurPtr is a pointer to an output integer flag which is
+          set by ARKILUPrecSetup as follows:
+            *jcurPtr = SUNTRUE if Jacobian data was recomputed.
+            *jcurPtr = SUNFALSE if Jacobian data was not recomputed,
+                       but saved data was reused.
+
+ gamma   is the scalar appearing in the Newton matrix.
+
+ ip_data is a pointer to preconditoner data (set by ARKILUPrecInit)
+
+ With jok == SUNTRUE the factors are only recomputed when gamma
+ differs from the one of the current factorization, otherwise the
+ call returns immediately.
+
+ The value to be returned by the ARKILUPrecSetup function is
+   0  if successful, or
+   1  if the ILU factorization failed (zero pivot).
+---------------------------------------------------------------*/
+static int ARKILUPrecSetup(realtype t, N_Vector y, N_Vector fy,
+                           booleantype jok, booleantype *jcurPtr,
+                           realtype gamma, void *ip_data)
+{
+  ARKILUPrecData pdata;
+  ARKodeMem ark_mem;
+  int retval;
+
+  pdata = (ARKILUPrecData) ip_data;
+  ark_mem = (ARKodeMem) pdata->arkode_mem;
+
+  if (jok) {
+
+    /* If jok = SUNTRUE, use saved copy of J. */
+    *jcurPtr = SUNFALSE;
+
+    /* the current factors are still valid */
+    if (pdata->factored && (gamma == pdata->gammaP))
+      return(0);
+
+  } else {
+
+    /* If jok = SUNFALSE, call the Jacobian function for a new J. */
+    *jcurPtr = SUNTRUE;
+    retval = SUNMatZero(pdata->savedJ);
+    if (retval < 0) {
+      arkProcessError(ark_mem, -1, "ARKILUPRE",
+                      "ARKILUPrecSetup", MSG_IP_SUNMAT_FAIL);
+      return(-1);
+    }
+    if (retval > 0) {
+      return(1);
+    }
+
+    retval = pdata->jac(t, y, fy, pdata->savedJ, ark_mem->user_data,
+                        pdata->tmp1, pdata->tmp2, pdata->tmp3);
+    pdata->njeIP++;
+    if (retval < 0) {
+      arkProcessError(ark_mem, -1, "ARKILUPRE",
+                      "ARKILUPrecSetup", MSG_IP_JACFUNC_FAILED);
+      return(-1);
+    }
+    if (retval > 0) {
+      return(1);
+    }
+
+  }
+
+  pdata->factored = SUNFALSE;
+
+  retval = SUNMatCopy(pdata->savedJ, pdata->savedP);
+  if (retval < 0) {
+    arkProcessError(ark_mem, -1, "ARKILUPRE",
+                    "ARKILUPrecSetup", MSG_IP_SUNMAT_FAIL);
+    return(-1);
+  }
+  if (retval > 0) {
+    return(1);
+  }
+
+  /* Scale and add identity to get savedP = I - gamma*J. */
+  retval = SUNMatScaleAddI(-gamma, pdata->savedP);
+  if (retval) {
+    arkProcessError(ark_mem, -1, "ARKILUPRE",
+                    "ARKILUPrecSetup", MSG_IP_SUNMAT_FAIL);
+    return(-1);
+  }
+
+  /* Do the ILU factorization of the matrix and return error flag, the
+     symbolic factorization is only recomputed if the pattern changed */
+  retval = SUNLinSolSetup(pdata->LS, pdata->savedP);
+  pdata->nfactIP++;
+  if (retval != SUNLS_SUCCESS)
+    return((retval == SUNLS_LUFACT_FAIL) ? 1 : -1);
+
+  pdata->gammaP   = gamma;
+  pdata->factored = SUNTRUE;
+
+  return(0);
+}
+
+
+/*---------------------------------------------------------------
+ ARKILUPrecSolve:
+
+ ARKILUPrecSolve solves a linear system P z = r, where P is the
+ matrix computed by ARKILUPrecSetup.
+
+ The parameters of ARKILUPrecSolve used here are as follows:
+
+ r is the right-hand side vector of the linear system.
+
+ ip_data is a pointer to preconditoner data (set by ARKILUPrecInit)
+
+ z is the output vector computed by ARKILUPrecSolve.
+
+ The value returned by the ARKILUPrecSolve function is always 0,
+ indicating success.
+---------------------------------------------------------------*/
+static int ARKILUPrecSolve(realtype t, N_Vector y, N_Vector fy,
+                           N_Vector r, N_Vector z, realtype gamma,
+                           realtype delta, int lr, void *ip_data)
+{
+  ARKILUPrecData pdata;
+  int retval;
+
+  pdata = (ARKILUPrecData) ip_data;
+
+  /* Call ILU solver object to do the work */
+  retval = SUNLinSolSolve(pdata->LS, pdata->savedP, z, r, ZERO);
+  return(retval);
+}
+
+
+static int ARKILUPrecFree(ARKodeMem ark_mem)
+{
+  ARKLsMem arkls_mem;
+  void* ark_step_lmem;
+  ARKILUPrecData pdata;
+
+  /* Return immediately if ARKodeMem, ARKLsMem or ARKILUPrecData are NULL */
+  if (ark_mem == NULL) return(0);
+  ark_step_lmem = ark_mem->step_getlinmem((void*) ark_mem);
+  if (ark_step_lmem == NULL) return(0);
+  arkls_mem = (ARKLsMem) ark_step_lmem;
+  if (arkls_mem->P_data == NULL) return(0);
+  pdata = (ARKILUPrecData) arkls_mem->P_data;
+
+  SUNLinSolFree(pdata->LS);
+  SUNMatDestroy(pdata->savedP);
+  SUNMatDestroy(pdata->savedJ);
+  arkFreeVec(ark_mem, &(pdata->tmp1));
+  arkFreeVec(ark_mem, &(pdata->tmp2));
+  arkFreeVec(ark_mem, &(pdata->tmp3));
+
+  free(pdata);
+  pdata = NULL;
+
+  return(0);
+}
+
+
+/*---------------------------------------------------------------
+ ARKILUPrecAccess:
+
+ This routine checks the integrator, linear solver and
+ preconditioner memory and returns pointers to them.
+---------------------------------------------------------------*/
+static int ARKILUPrecAccess(void *arkode_mem, const char *fname,
+                            ARKodeMem *ark_mem, ARKILUPrecData *pdata)
+{
+  ARKLsMem arkls_mem;
+  int retval;
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(arkode_mem, fname, ark_mem, &arkls_mem);
+  if (retval != ARK_SUCCESS)  return(retval);
+
+  /* Return immediately if ARKILUPrecData is NULL */
+  if (arkls_mem->P_data == NULL) {
+    arkProcessError(*ark_mem, ARKLS_PMEM_NULL, "ARKILUPRE",
+                    fname, MSG_IP_PMEM_NULL);
+    return(ARKLS_PMEM_NULL);
+  }
+  *pdata = (ARKILUPrecData) arkls_mem->P_data;
+
+  return(ARKLS_SUCCESS);
+}
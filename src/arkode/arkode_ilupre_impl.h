@@ -0,0 +1,79 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Implementation header file for the ARKILUPRE module.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _ARKILUPRE_IMPL_H
+#define _ARKILUPRE_IMPL_H
+
+#include <arkode/arkode_ilupre.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+#include <sunlinsol/sunlinsol_ilu.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------------
+  Type: ARKILUPrecData
+  -----------------------------------------------------------------*/
+
+typedef struct ARKILUPrecDataRec {
+
+  /* Data set by user in ARKILUPrecInit */
+  ARKLsJacFn jac;
+
+  /* Data set by ARKILUPrecSetup */
+  SUNMatrix savedJ;
+  SUNMatrix savedP;
+  SUNLinearSolver LS;
+  N_Vector tmp1;
+  N_Vector tmp2;
+  N_Vector tmp3;
+
+  /* gamma of the current factorization */
+  realtype gammaP;
+  booleantype factored;
+
+  /* Jacobian calls and factorizations */
+  long int njeIP;
+  long int nfactIP;
+
+  /* Pointer to arkode_mem */
+  void *arkode_mem;
+
+} *ARKILUPrecData;
+
+/*-----------------------------------------------------------------
+  ARKILUPRE error messages
+  -----------------------------------------------------------------*/
+
+#define MSG_IP_MEM_NULL       "Integrator memory is NULL."
+#define MSG_IP_LMEM_NULL      "Linear solver memory is NULL. The SPILS interface must be attached."
+#define MSG_IP_MEM_FAIL       "A memory request failed."
+#define MSG_IP_BAD_NVECTOR    "A required vector operation is not implemented."
+#define MSG_IP_BAD_MATRIX     "The Jacobian template must be a square SUNMATRIX_SPARSE matrix matching the vector length."
+#define MSG_IP_BAD_FILL       "The fill level must be nonnegative."
+#define MSG_IP_JAC_NULL       "The Jacobian function is NULL."
+#define MSG_IP_SUNMAT_FAIL    "An error arose from a SUNSparseMatrix routine."
+#define MSG_IP_SUNLS_FAIL     "An error arose from the SUNLinSol_ILU linear solver."
+#define MSG_IP_PMEM_NULL      "ILU preconditioner memory is NULL. ARKILUPrecInit must be called."
+#define MSG_IP_JACFUNC_FAILED "The Jacobian routine failed in an unrecoverable manner."
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -947,6 +947,9 @@ int arkRwtSetSS(ARKodeMem ark_mem, N_Vector My,
                 N_Vector weight);
 int arkRwtSetSV(ARKodeMem ark_mem, N_Vector My,
                 N_Vector weight);
+int arkInvPositive(N_Vector tempv, N_Vector weight, booleantype test);
+booleantype arkWrmsNormStart(N_Vector x, N_Vector w, realtype *sum);
+realtype arkWrmsNormFinish(N_Vector x, realtype *sum, booleantype started);
 
 ARKodeMem arkCreate(SUNContext sunctx);
 int arkResize(ARKodeMem ark_mem, N_Vector ynew, realtype hscale,
@@ -1016,6 +1019,7 @@ int arkSetFixedStepBounds(void *arkode_mem, realtype lb, realtype ub);
 int arkSetAdaptivityMethod(void *arkode_mem, int imethod, int idefault,
                            int pq, realtype adapt_params[3]);
 int arkSetAdaptivityFn(void *arkode_mem, ARKAdaptFn hfun, void *h_data);
+int arkSetAdaptController(void *arkode_mem, SUNAdaptController C);
 int arkSetMaxFirstGrowth(void *arkode_mem, realtype etamx1);
 int arkSetMaxEFailGrowth(void *arkode_mem, realtype etamxf);
 int arkSetSmallNumEFails(void *arkode_mem, int small_nef);
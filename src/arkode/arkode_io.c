@@ -93,6 +93,7 @@ int arkSetDefaults(void *arkode_mem)
   ark_mem->hadapt_mem->HAdapt      = NULL;           /* step adaptivity fn */
   ark_mem->hadapt_mem->HAdapt_data = NULL;           /* step adaptivity data */
   ark_mem->hadapt_mem->imethod     = ARK_ADAPT_PID;  /* PID controller */
+  arkSetAdaptController(ark_mem, NULL);              /* no controller object */
   ark_mem->hadapt_mem->cfl         = CFLFAC;         /* explicit stability factor */
   ark_mem->hadapt_mem->safety      = SAFETY;         /* step adaptivity safety factor  */
   ark_mem->hadapt_mem->bias        = BIAS;           /* step adaptivity error bias */
@@ -1024,8 +1025,9 @@ int arkSetAdaptivityMethod(void *arkode_mem, int imethod, int idefault,
     return(ARK_ILL_INPUT);
   }
 
-  /* set adaptivity method */
+  /* set adaptivity method, detaching any controller object */
   hadapt_mem->imethod = imethod;
+  arkSetAdaptController(arkode_mem, NULL);
 
   /* set flag whether to use p (embedding, 0) or q (method, 1) order */
   hadapt_mem->pq = (pq != 0);
@@ -1077,6 +1079,9 @@ int arkSetAdaptivityFn(void *arkode_mem, ARKAdaptFn hfun, void *h_data)
                               &ark_mem, &hadapt_mem);
   if (retval != ARK_SUCCESS)  return(retval);
 
+  /* detach any controller object */
+  arkSetAdaptController(arkode_mem, NULL);
+
   /* NULL hfun sets default, otherwise set inputs */
   if (hfun == NULL) {
     hadapt_mem->HAdapt      = NULL;
@@ -1092,6 +1097,59 @@ int arkSetAdaptivityFn(void *arkode_mem, ARKAdaptFn hfun, void *h_data)
 }
 
 
+/*---------------------------------------------------------------
+  arkSetAdaptController:
+
+  Specifies a time step controller object to use in place of the
+  built-in adaptivity methods, a NULL input detaches the current
+  controller. The controller is owned by the user and its history
+  is reset here.
+  ---------------------------------------------------------------*/
+int arkSetAdaptController(void *arkode_mem, SUNAdaptController C)
+{
+  int retval;
+  long int lenrw, leniw;
+  ARKodeHAdaptMem hadapt_mem;
+  ARKodeMem ark_mem;
+  retval = arkAccessHAdaptMem(arkode_mem, "arkSetAdaptController",
+                              &ark_mem, &hadapt_mem);
+  if (retval != ARK_SUCCESS)  return(retval);
+
+  /* remove the space of the current controller from the totals */
+  if (hadapt_mem->hcontroller != NULL) {
+    SUNAdaptController_Space(hadapt_mem->hcontroller, &lenrw, &leniw);
+    ark_mem->lrw -= lenrw;
+    ark_mem->liw -= leniw;
+    hadapt_mem->hcontroller = NULL;
+  }
+
+  if (C == NULL)  return(ARK_SUCCESS);
+
+  /* only controllers that adapt a single step size are supported */
+  if (SUNAdaptController_GetType(C) != SUN_ADAPTCONTROLLER_H) {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKODE",
+                    "arkSetAdaptController",
+                    "The controller must be of type SUN_ADAPTCONTROLLER_H");
+    return(ARK_ILL_INPUT);
+  }
+
+  retval = SUNAdaptController_Reset(C);
+  if (retval != SUNADAPTCONTROLLER_SUCCESS) {
+    arkProcessError(ark_mem, ARK_CONTROLLER_ERR, "ARKODE",
+                    "arkSetAdaptController",
+                    "The controller reset failed");
+    return(ARK_CONTROLLER_ERR);
+  }
+
+  SUNAdaptController_Space(C, &lenrw, &leniw);
+  ark_mem->lrw += lenrw;
+  ark_mem->liw += leniw;
+  hadapt_mem->hcontroller = C;
+
+  return(ARK_SUCCESS);
+}
+
+
 /*---------------------------------------------------------------
   arkSetMaxFirstGrowth:
 
@@ -1929,6 +1987,9 @@ char *arkGetReturnFlagName(long int flag)
   case ARK_INNERSTEP_FAIL:
     sprintf(name,"ARK_INNERSTEP_FAIL");
     break;
+  case ARK_CONTROLLER_ERR:
+    sprintf(name,"ARK_CONTROLLER_ERR");
+    break;
   default:
     sprintf(name,"NONE");
   }
@@ -1997,7 +2058,13 @@ int arkWriteParameters(ARKodeMem ark_mem, FILE *fp)
           ark_mem->hadapt_mem->etacf);
   fprintf(fp, "  Explicit safety factor = %"RSYM"\n",
           ark_mem->hadapt_mem->cfl);
-  if (ark_mem->hadapt_mem->HAdapt == NULL) {
+  if (ark_mem->hadapt_mem->hcontroller != NULL) {
+    fprintf(fp, "  Time step adaptivity controller object:\n");
+    SUNAdaptController_Write(ark_mem->hadapt_mem->hcontroller, fp);
+    fprintf(fp, "     Safety factor = %"RSYM"\n", ark_mem->hadapt_mem->safety);
+    fprintf(fp, "     Bias factor = %"RSYM"\n", ark_mem->hadapt_mem->bias);
+    fprintf(fp, "     Growth factor = %"RSYM"\n", ark_mem->hadapt_mem->growth);
+  } else if (ark_mem->hadapt_mem->HAdapt == NULL) {
     fprintf(fp, "  Time step adaptivity method %i\n", ark_mem->hadapt_mem->imethod);
     fprintf(fp, "     Safety factor = %"RSYM"\n", ark_mem->hadapt_mem->safety);
     fprintf(fp, "     Bias factor = %"RSYM"\n", ark_mem->hadapt_mem->bias);
@@ -21,6 +21,7 @@
 #include "arkode_ls_impl.h"
 #include <sundials/sundials_math.h>
 #include <sunmatrix/sunmatrix_band.h>
+#include <sunmatrix/sunmatrix_bsr.h>
 #include <sunmatrix/sunmatrix_dense.h>
 #include <sunmatrix/sunmatrix_sparse.h>
 
@@ -533,6 +534,111 @@ int arkLSSetJacFn(void *arkode_mem, ARKLsJacFn jac)
 }
 
 
+/*---------------------------------------------------------------
+  arkLSSetJacSparsityPattern specifies the sparsity pattern used
+  by the internal difference quotient Jacobian approximation with
+  a sparse matrix. A copy of the pattern is stored and a column
+  coloring is computed so that the Jacobian can be approximated
+  with one implicit RHS evaluation per color.
+  ---------------------------------------------------------------*/
+int arkLSSetJacSparsityPattern(void *arkode_mem, SUNMatrix P)
+{
+  ARKodeMem    ark_mem;
+  ARKLsMem     arkls_mem;
+  sunindextype N;
+  int          retval;
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(arkode_mem, "arkLSSetJacSparsityPattern",
+                            &ark_mem, &arkls_mem);
+  if (retval != ARKLS_SUCCESS)  return(retval);
+
+  /* free any existing pattern */
+  if (arkls_mem->jac_pattern) {
+    SUNMatDestroy(arkls_mem->jac_pattern);
+    arkls_mem->jac_pattern = NULL;
+  }
+  if (arkls_mem->jac_colors) {
+    free(arkls_mem->jac_colors);
+    arkls_mem->jac_colors = NULL;
+  }
+  arkls_mem->jac_ncolors = 0;
+
+  /* a NULL input disables the sparse DQ Jacobian */
+  if (P == NULL) return(ARKLS_SUCCESS);
+
+  /* the pattern must match the sparse or BSR system matrix */
+  if ((arkls_mem->A == NULL) ||
+      (SUNMatGetID(arkls_mem->A) != SUNMatGetID(P)) ||
+      ((SUNMatGetID(P) == SUNMATRIX_SPARSE) &&
+       ((SUNSparseMatrix_Rows(P) != SUNSparseMatrix_Rows(arkls_mem->A)) ||
+        (SUNSparseMatrix_Columns(P) != SUNSparseMatrix_Columns(arkls_mem->A)) ||
+        (SUNSparseMatrix_SparseType(P) != SUNSparseMatrix_SparseType(arkls_mem->A)))) ||
+      ((SUNMatGetID(P) == SUNMATRIX_BSR) &&
+       ((SUNBSRMatrix_BlockRows(P) != SUNBSRMatrix_BlockRows(arkls_mem->A)) ||
+        (SUNBSRMatrix_BlockColumns(P) != SUNBSRMatrix_BlockColumns(arkls_mem->A)) ||
+        (SUNBSRMatrix_BlockSize(P) != SUNBSRMatrix_BlockSize(arkls_mem->A)))) ||
+      ((SUNMatGetID(P) != SUNMATRIX_SPARSE) &&
+       (SUNMatGetID(P) != SUNMATRIX_BSR))) {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKLS",
+                    "arkLSSetJacSparsityPattern",
+                    "Sparsity pattern is incompatible with the SUNMatrix");
+    return(ARKLS_ILL_INPUT);
+  }
+
+  /* store a copy of the pattern */
+  arkls_mem->jac_pattern = SUNMatClone(P);
+  if (arkls_mem->jac_pattern == NULL) {
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKLS",
+                    "arkLSSetJacSparsityPattern", MSG_LS_MEM_FAIL);
+    return(ARKLS_MEM_FAIL);
+  }
+
+  retval = SUNMatCopy(P, arkls_mem->jac_pattern);
+  if (retval != SUNMAT_SUCCESS) {
+    arkProcessError(ark_mem, ARKLS_SUNMAT_FAIL, "ARKLS",
+                    "arkLSSetJacSparsityPattern", MSG_LS_SUNMAT_FAILED);
+    SUNMatDestroy(arkls_mem->jac_pattern);
+    arkls_mem->jac_pattern = NULL;
+    return(ARKLS_SUNMAT_FAIL);
+  }
+
+  /* color the columns of the pattern */
+  if (SUNMatGetID(P) == SUNMATRIX_BSR)
+    N = SUNBSRMatrix_Columns(P);
+  else
+    N = SUNSparseMatrix_Columns(P);
+  arkls_mem->jac_colors = (sunindextype *) malloc(N*sizeof(sunindextype));
+  if (arkls_mem->jac_colors == NULL) {
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKLS",
+                    "arkLSSetJacSparsityPattern", MSG_LS_MEM_FAIL);
+    SUNMatDestroy(arkls_mem->jac_pattern);
+    arkls_mem->jac_pattern = NULL;
+    return(ARKLS_MEM_FAIL);
+  }
+
+  if (SUNMatGetID(P) == SUNMATRIX_BSR)
+    retval = SUNBSRMatrix_ColorColumns(arkls_mem->jac_pattern,
+                                       arkls_mem->jac_colors,
+                                       &(arkls_mem->jac_ncolors));
+  else
+    retval = SUNSparseMatrix_ColorColumns(arkls_mem->jac_pattern,
+                                          arkls_mem->jac_colors,
+                                          &(arkls_mem->jac_ncolors));
+  if (retval != SUNMAT_SUCCESS) {
+    arkProcessError(ark_mem, ARKLS_SUNMAT_FAIL, "ARKLS",
+                    "arkLSSetJacSparsityPattern", MSG_LS_SUNMAT_FAILED);
+    SUNMatDestroy(arkls_mem->jac_pattern);
+    arkls_mem->jac_pattern = NULL;
+    free(arkls_mem->jac_colors);
+    arkls_mem->jac_colors = NULL;
+    return(ARKLS_SUNMAT_FAIL);
+  }
+
+  return(ARKLS_SUCCESS);
+}
+
+
 /*---------------------------------------------------------------
   arkLSSetMassFn specifies the mass matrix function.
   ---------------------------------------------------------------*/
@@ -1900,7 +2006,7 @@ int arkLsMPSolve(void *arkode_mem, N_Vector r, N_Vector z,
 /*---------------------------------------------------------------
   arkLsDQJac:
 
-  This routine is a wrapper for the Dense and Band
+  This routine is a wrapper for the Dense, Band and Sparse
   implementations of the difference quotient Jacobian
   approximation routines.
   ---------------------------------------------------------------*/
@@ -1954,6 +2060,11 @@ int arkLsDQJac(realtype t, N_Vector y, N_Vector fy,
   } else if (SUNMatGetID(Jac) == SUNMATRIX_BAND) {
     retval = arkLsBandDQJac(t, y, fy, Jac, ark_mem, arkls_mem,
                             fi, tmp1, tmp2);
+  } else if (((SUNMatGetID(Jac) == SUNMATRIX_SPARSE) ||
+               (SUNMatGetID(Jac) == SUNMATRIX_BSR)) &&
+             (arkls_mem->jac_pattern != NULL)) {
+    retval = arkLsSparseDQJac(t, y, fy, Jac, ark_mem, arkls_mem,
+                              fi, tmp1, tmp2, tmp3);
   } else {
     arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKLS", "arkLsDQJac",
                     "arkLsDQJac not implemented for this SUNMatrix type!");
@@ -2145,6 +2256,145 @@ int arkLsBandDQJac(realtype t, N_Vector y, N_Vector fy,
 }
 
 
+/*---------------------------------------------------------------
+  arkLsSparseDQJac:
+
+  This routine generates a sparse difference quotient approximation
+  to the Jacobian of f(t,y) using the user-supplied sparsity
+  pattern. The columns of the pattern are grouped by the coloring
+  computed in arkLSSetJacSparsityPattern so that columns of one
+  color do not share any rows. All y_j of a color are perturbed
+  together, requiring a single f evaluation per color, and the
+  difference quotients are scattered into the pattern entries
+  (CSC, CSR or BSR) of the matching columns.
+  ---------------------------------------------------------------*/
+int arkLsSparseDQJac(realtype t, N_Vector y, N_Vector fy,
+                     SUNMatrix Jac, ARKodeMem ark_mem,
+                     ARKLsMem arkls_mem, ARKRhsFn fi,
+                     N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  N_Vector ftemp, ytemp, incvec;
+  realtype fnorm, minInc, inc, srur, conj;
+  realtype *ewt_data, *fy_data, *ftemp_data, *y_data, *ytemp_data;
+  realtype *inc_data, *cns_data, *J_data;
+  sunindextype *colors, *Jp, *Ji;
+  sunindextype color, i, j, p, N, NP, I, r, c, bs;
+  int retval = 0;
+
+  /* load the pattern into the Jacobian matrix */
+  retval = SUNMatCopy(arkls_mem->jac_pattern, Jac);
+  if (retval != SUNMAT_SUCCESS) return(-1);
+
+  /* access matrix dimensions and data, for a BSR matrix NP is the number
+     of block rows and Jp, Ji index the blocks */
+  bs = 1;
+  if (SUNMatGetID(Jac) == SUNMATRIX_BSR) {
+    N      = SUNBSRMatrix_Columns(Jac);
+    NP     = SUNBSRMatrix_BlockRows(Jac);
+    bs     = SUNBSRMatrix_BlockSize(Jac);
+    Jp     = SUNBSRMatrix_IndexPointers(Jac);
+    Ji     = SUNBSRMatrix_IndexValues(Jac);
+    J_data = SUNBSRMatrix_Data(Jac);
+  } else {
+    N      = SUNSparseMatrix_Columns(Jac);
+    NP     = SUNSparseMatrix_NP(Jac);
+    Jp     = SUNSparseMatrix_IndexPointers(Jac);
+    Ji     = SUNSparseMatrix_IndexValues(Jac);
+    J_data = SUNSparseMatrix_Data(Jac);
+  }
+  colors = arkls_mem->jac_colors;
+
+  /* Rename work vectors for use as temporary values of y and f and to
+     hold the increment for each column */
+  ftemp  = tmp1;
+  ytemp  = tmp2;
+  incvec = tmp3;
+
+  /* Obtain pointers to the data for ewt, fy, ftemp, y, ytemp, incvec */
+  ewt_data   = N_VGetArrayPointer(ark_mem->ewt);
+  fy_data    = N_VGetArrayPointer(fy);
+  ftemp_data = N_VGetArrayPointer(ftemp);
+  y_data     = N_VGetArrayPointer(y);
+  ytemp_data = N_VGetArrayPointer(ytemp);
+  inc_data   = N_VGetArrayPointer(incvec);
+  cns_data = (ark_mem->constraintsSet) ?
+    N_VGetArrayPointer(ark_mem->constraints) : NULL;
+
+  /* Load ytemp with y = predicted y vector */
+  N_VScale(ONE, y, ytemp);
+
+  /* Set minimum increment based on uround and norm of f */
+  srur = SUNRsqrt(ark_mem->uround);
+  fnorm = N_VWrmsNorm(fy, ark_mem->rwt);
+  minInc = (fnorm != ZERO) ?
+    (MIN_INC_MULT * SUNRabs(ark_mem->h) * ark_mem->uround * N * fnorm) : ONE;
+
+  /* Compute the increment for each column */
+  for (j=0; j < N; j++) {
+    inc = SUNMAX(srur*SUNRabs(y_data[j]), minInc/ewt_data[j]);
+
+    /* Adjust sign(inc) if yj has an inequality constraint. */
+    if (ark_mem->constraintsSet) {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)      {if ((y_data[j]+inc)*conj < ZERO)  inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if ((y_data[j]+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    inc_data[j] = inc;
+  }
+
+  /* Loop over column colors */
+  for (color=0; color < arkls_mem->jac_ncolors; color++) {
+
+    /* Increment all y_j of this color */
+    for (j=0; j < N; j++)
+      if (colors[j] == color) ytemp_data[j] += inc_data[j];
+
+    /* Evaluate f with incremented y */
+    retval = fi(ark_mem->tcur, ytemp, ftemp, ark_mem->user_data);
+    arkls_mem->nfeDQ++;
+    if (retval != 0) break;
+
+    /* Restore ytemp, then form and load difference quotients */
+    for (j=0; j < N; j++)
+      if (colors[j] == color) ytemp_data[j] = y_data[j];
+
+    if (SUNMatGetID(Jac) == SUNMATRIX_BSR) {
+      for (I=0; I < NP; I++) {
+        for (p=Jp[I]; p < Jp[I+1]; p++) {
+          for (c=0; c < bs; c++) {
+            j = Ji[p]*bs + c;
+            if (colors[j] != color) continue;
+            for (r=0; r < bs; r++) {
+              i = I*bs + r;
+              J_data[(p*bs + c)*bs + r] = (ftemp_data[i] - fy_data[i]) / inc_data[j];
+            }
+          }
+        }
+      }
+    } else if (SUNSparseMatrix_SparseType(Jac) == CSC_MAT) {
+      for (j=0; j < NP; j++) {
+        if (colors[j] != color) continue;
+        for (p=Jp[j]; p < Jp[j+1]; p++) {
+          i = Ji[p];
+          J_data[p] = (ftemp_data[i] - fy_data[i]) / inc_data[j];
+        }
+      }
+    } else {
+      for (i=0; i < NP; i++) {
+        for (p=Jp[i]; p < Jp[i+1]; p++) {
+          j = Ji[p];
+          if (colors[j] == color)
+            J_data[p] = (ftemp_data[i] - fy_data[i]) / inc_data[j];
+        }
+      }
+    }
+  }
+
+  return(retval);
+}
+
+
 /*---------------------------------------------------------------
   arkLsDQJtimes:
 
@@ -2329,13 +2579,17 @@ int arkLsInitialize(void* arkode_mem)
       /* Check if an internal or user-supplied Jacobian function is used */
       if (arkls_mem->jacDQ) {
 
-        /* Internal difference quotient Jacobian. Check that A is dense or band,
-           otherwise return an error */
+        /* Internal difference quotient Jacobian. Check that A is dense, band,
+           or sparse or BSR with a sparsity pattern, otherwise return an
+           error */
         retval = 0;
         if (arkls_mem->A->ops->getid) {
 
           if ( (SUNMatGetID(arkls_mem->A) == SUNMATRIX_DENSE) ||
-               (SUNMatGetID(arkls_mem->A) == SUNMATRIX_BAND) ) {
+               (SUNMatGetID(arkls_mem->A) == SUNMATRIX_BAND) ||
+               (((SUNMatGetID(arkls_mem->A) == SUNMATRIX_SPARSE) ||
+                 (SUNMatGetID(arkls_mem->A) == SUNMATRIX_BSR)) &&
+                (arkls_mem->jac_pattern != NULL)) ) {
             arkls_mem->jac    = arkLsDQJac;
             arkls_mem->J_data = ark_mem;
           } else {
@@ -2826,6 +3080,16 @@ int arkLsFree(void* arkode_mem)
     arkls_mem->savedJ = NULL;
   }
 
+  /* Free sparse DQ Jacobian pattern and coloring */
+  if (arkls_mem->jac_pattern) {
+    SUNMatDestroy(arkls_mem->jac_pattern);
+    arkls_mem->jac_pattern = NULL;
+  }
+  if (arkls_mem->jac_colors) {
+    free(arkls_mem->jac_colors);
+    arkls_mem->jac_colors = NULL;
+  }
+
   /* Nullify other N_Vector pointers */
   arkls_mem->ycur = NULL;
   arkls_mem->fcur = NULL;
@@ -55,6 +55,11 @@ typedef struct ARKLsMemRec {
   void *J_data;       /* user data is passed to jac                    */
   booleantype jbad;   /* heuristic suggestion for pset                 */
 
+  /* Sparse difference quotient Jacobian */
+  SUNMatrix jac_pattern;    /* copy of the Jacobian sparsity pattern   */
+  sunindextype *jac_colors; /* column colors of the sparsity pattern   */
+  sunindextype jac_ncolors; /* number of column colors                 */
+
   /* Matrix-based solver, scale solution to account for change in gamma */
   booleantype scalesol;
 
@@ -221,6 +226,10 @@ int arkLsBandDQJac(realtype t, N_Vector y, N_Vector fy,
                    SUNMatrix Jac, ARKodeMem ark_mem,
                    ARKLsMem arkls_mem, ARKRhsFn fi,
                    N_Vector tmp1, N_Vector tmp2);
+int arkLsSparseDQJac(realtype t, N_Vector y, N_Vector fy,
+                     SUNMatrix Jac, ARKodeMem ark_mem,
+                     ARKLsMem arkls_mem, ARKRhsFn fi,
+                     N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 
 /* Generic linit/lsetup/lsolve/lfree interface routines for ARKODE to call */
 int arkLsInitialize(void* arkode_mem);
@@ -264,6 +273,7 @@ int arkLSSetMassLinearSolver(void* arkode_mem, SUNLinearSolver LS,
                              SUNMatrix M, booleantype time_dep);
 
 int arkLSSetJacFn(void* arkode_mem, ARKLsJacFn jac);
+int arkLSSetJacSparsityPattern(void* arkode_mem, SUNMatrix P);
 int arkLSSetMassFn(void* arkode_mem, ARKLsMassFn mass);
 int arkLSSetEpsLin(void* arkode_mem, realtype eplifac);
 int arkLSSetMassEpsLin(void* arkode_mem, realtype eplifac);
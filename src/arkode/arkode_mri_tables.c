@@ -109,16 +109,16 @@ MRIStepCoupling MRIStepCoupling_Alloc(int nmat, int stages,
     MRIC->W = (realtype ***) calloc( nmat, sizeof(realtype**) );
     if (!(MRIC->W)) { MRIStepCoupling_Free(MRIC); return(NULL); }
 
-    /* allocate rows of each matrix in W */
+    /* allocate rows of each matrix in W (the last row is the embedding) */
     for (i=0; i<nmat; i++) {
       MRIC->W[i] = NULL;
-      MRIC->W[i] = (realtype **) calloc( stages, sizeof(realtype*) );
+      MRIC->W[i] = (realtype **) calloc( stages+1, sizeof(realtype*) );
       if (!(MRIC->W[i])) { MRIStepCoupling_Free(MRIC); return(NULL); }
     }
 
     /* allocate columns of each matrix in W */
     for (i=0; i<nmat; i++)
-      for (j=0; j<stages; j++) {
+      for (j=0; j<=stages; j++) {
         MRIC->W[i][j] = NULL;
         MRIC->W[i][j] = (realtype *) calloc( stages, sizeof(realtype) );
         if (!(MRIC->W[i][j])) { MRIStepCoupling_Free(MRIC); return(NULL); }
@@ -131,16 +131,16 @@ MRIStepCoupling MRIStepCoupling_Alloc(int nmat, int stages,
     MRIC->G = (realtype ***) calloc( nmat, sizeof(realtype**) );
     if (!(MRIC->G)) { MRIStepCoupling_Free(MRIC); return(NULL); }
 
-    /* allocate rows of each matrix in G */
+    /* allocate rows of each matrix in G (the last row is the embedding) */
     for (i=0; i<nmat; i++) {
       MRIC->G[i] = NULL;
-      MRIC->G[i] = (realtype **) calloc( stages, sizeof(realtype*) );
+      MRIC->G[i] = (realtype **) calloc( stages+1, sizeof(realtype*) );
       if (!(MRIC->G[i])) { MRIStepCoupling_Free(MRIC); return(NULL); }
     }
 
     /* allocate columns of each matrix in G */
     for (i=0; i<nmat; i++)
-      for (j=0; j<stages; j++) {
+      for (j=0; j<=stages; j++) {
         MRIC->G[i][j] = NULL;
         MRIC->G[i][j] = (realtype *) calloc( stages, sizeof(realtype) );
         if (!(MRIC->G[i][j])) { MRIStepCoupling_Free(MRIC); return(NULL); }
@@ -157,55 +157,28 @@ MRIStepCoupling MRIStepCoupling_Alloc(int nmat, int stages,
 MRIStepCoupling MRIStepCoupling_Create(int nmat, int stages, int q, int p,
                                        realtype *W, realtype *G, realtype *c)
 {
-  int i, j, k;
-  MRISTEP_METHOD_TYPE type;
-  MRIStepCoupling MRIC = NULL;
-
-  /* Check for legal inputs */
-  if (nmat < 1 || stages < 1 || !c) return(NULL);
-
-  /* Check for method coefficients and set method type */
-  if (W && G)
-    type = MRISTEP_IMEX;
-  else if (W && !G)
-    type = MRISTEP_EXPLICIT;
-  else if (!W && G)
-    type = MRISTEP_IMPLICIT;
-  else
-    return(NULL);
+  MRIStepCoupling MRIC;
 
-  /* Allocate MRIStepCoupling structure */
-  MRIC = MRIStepCoupling_Alloc(nmat, stages, type);
+  MRIC = mriStepCoupling_Fill(nmat, stages, q, p, W, G, c, stages);
   if (!MRIC) return(NULL);
 
-  /* -------------------------
-   * Copy the inputs into MRIC
-   * ------------------------- */
-
-  /* Method and embedding order */
-  MRIC->q = q;
-  MRIC->p = p;
+  /* The embedding coefficients are not given, a table with an embedding
+     order has no embedding row and can only be used with fixed steps */
+  if (p > 0) mriStepCoupling_DropEmbedding(MRIC);
 
-  /* Abscissae */
-  for (i=0; i<stages; i++)
-    MRIC->c[i] = c[i];
+  return(MRIC);
+}
 
-  /* Coupling coefficients stored as 1D arrays of length nmat * stages * stages,
-     with each stages * stages matrix stored in C (row-major) order */
-  if (type == MRISTEP_EXPLICIT || type == MRISTEP_IMEX) {
-    for (k = 0; k < nmat; k++)
-      for (i = 0; i < stages; i++)
-        for (j = 0; j < stages; j++)
-          MRIC->W[k][i][j] = W[stages * (stages * k + i) + j];
-  }
-  if (type == MRISTEP_IMPLICIT || type == MRISTEP_IMEX) {
-    for (k = 0; k < nmat; k++)
-      for (i = 0; i < stages; i++)
-        for (j = 0; j < stages; j++)
-          MRIC->G[k][i][j] = G[stages * (stages * k + i) + j];
-  }
 
-  return(MRIC);
+/*---------------------------------------------------------------
+  Routine to allocate and fill a MRIStepCoupling structure with
+  an embedding
+  ---------------------------------------------------------------*/
+MRIStepCoupling MRIStepCoupling_CreateEmbedded(int nmat, int stages, int q,
+                                               int p, realtype *W,
+                                               realtype *G, realtype *c)
+{
+  return(mriStepCoupling_Fill(nmat, stages, q, p, W, G, c, stages + 1));
 }
 
 
@@ -306,9 +279,8 @@ MRIStepCoupling MRIStepCoupling_MIStoMRI(ARKodeButcherTable B,
     C = MRIC->G;
 
   /* First row is identically zero */
-  for (i=0; i<stages; i++)
-    for (j=0; j<stages; j++)
-      C[0][i][j] = ZERO;
+  for (j=0; j<stages; j++)
+    C[0][0][j] = ZERO;
 
   /* Remaining rows = A(2:end,:) - A(1:end-1,:) */
   for (i=1; i<B->stages; i++)
@@ -320,6 +292,15 @@ MRIStepCoupling MRIStepCoupling_MIStoMRI(ARKodeButcherTable B,
     for (j=0; j<B->stages; j++)
       C[0][stages-1][j] = B->b[j] - B->A[B->stages-1][j];
 
+  /* Embedding row = d(:) - A(end-1,:), replacing the final stage. Without
+     embedding weights a table with an embedding order has no embedding
+     row and can only be used with fixed steps. */
+  if (p > 0 && B->d)
+    for (j=0; j<B->stages; j++)
+      C[0][stages][j] = B->d[j] - B->A[stages-2][j];
+  else if (p > 0)
+    mriStepCoupling_DropEmbedding(MRIC);
+
   return(MRIC);
 }
 
@@ -365,20 +346,31 @@ MRIStepCoupling MRIStepCoupling_Copy(MRIStepCoupling MRIC)
   for (i=0; i<stages; i++)
     MRICcopy->c[i] = MRIC->c[i];
 
-  /* Copy explicit coupling matrices W */
+  /* Copy explicit coupling matrices W, including the embedding row */
   if (MRIC->W)
     for (k = 0; k < nmat; k++)
       for (i = 0; i < stages; i++)
         for (j = 0; j < stages; j++)
           MRICcopy->W[k][i][j] = MRIC->W[k][i][j];
 
-  /* Copy implicit coupling matrices G */
+  /* Copy implicit coupling matrices G, including the embedding row */
   if (MRIC->G)
     for (k = 0; k < nmat; k++)
       for (i = 0; i < stages; i++)
         for (j = 0; j < stages; j++)
           MRICcopy->G[k][i][j] = MRIC->G[k][i][j];
 
+  /* Copy the embedding row if present */
+  if (mriStepCoupling_HasEmbedding(MRIC)) {
+    for (k = 0; k < nmat; k++)
+      for (j = 0; j < stages; j++) {
+        if (MRIC->W) MRICcopy->W[k][stages][j] = MRIC->W[k][stages][j];
+        if (MRIC->G) MRICcopy->G[k][stages][j] = MRIC->G[k][stages][j];
+      }
+  } else {
+    mriStepCoupling_DropEmbedding(MRICcopy);
+  }
+
   return(MRICcopy);
 }
 
@@ -389,6 +381,8 @@ MRIStepCoupling MRIStepCoupling_Copy(MRIStepCoupling MRIC)
 void MRIStepCoupling_Space(MRIStepCoupling MRIC, sunindextype *liw,
                            sunindextype *lrw)
 {
+  int rows;
+
   /* initialize outputs and return if MRIC is not allocated */
   *liw = 0;
   *lrw = 0;
@@ -398,10 +392,11 @@ void MRIStepCoupling_Space(MRIStepCoupling MRIC, sunindextype *liw,
   *liw = 4;
   if (MRIC->c)
     *lrw += MRIC->stages;
+  rows = MRIC->stages + (mriStepCoupling_HasEmbedding(MRIC) ? 1 : 0);
   if (MRIC->W)
-    *lrw += MRIC->nmat * MRIC->stages * MRIC->stages;
+    *lrw += MRIC->nmat * rows * MRIC->stages;
   if (MRIC->G)
-    *lrw += MRIC->nmat * MRIC->stages * MRIC->stages;
+    *lrw += MRIC->nmat * rows * MRIC->stages;
 }
 
 
@@ -422,7 +417,7 @@ void MRIStepCoupling_Free(MRIStepCoupling MRIC)
     if (MRIC->W) {
       for (k=0; k<MRIC->nmat; k++)
         if (MRIC->W[k]) {
-          for (i=0; i<MRIC->stages; i++)
+          for (i=0; i<=MRIC->stages; i++)
             if (MRIC->W[k][i]) {
               free(MRIC->W[k][i]);
               MRIC->W[k][i] = NULL;
@@ -436,7 +431,7 @@ void MRIStepCoupling_Free(MRIStepCoupling MRIC)
     if (MRIC->G) {
       for (k=0; k<MRIC->nmat; k++)
         if (MRIC->G[k]) {
-          for (i=0; i<MRIC->stages; i++)
+          for (i=0; i<=MRIC->stages; i++)
             if (MRIC->G[k][i]) {
               free(MRIC->G[k][i]);
               MRIC->G[k][i] = NULL;
@@ -457,7 +452,7 @@ void MRIStepCoupling_Free(MRIStepCoupling MRIC)
   ---------------------------------------------------------------*/
 void MRIStepCoupling_Write(MRIStepCoupling MRIC, FILE *outfile)
 {
-  int i, j, k;
+  int i, j, k, rows;
 
   /* check for vaild coupling structure */
   if (!MRIC) return;
@@ -481,6 +476,9 @@ void MRIStepCoupling_Write(MRIStepCoupling MRIC, FILE *outfile)
 
   if (!(MRIC->c)) return;
 
+  /* print the embedding row if present */
+  rows = MRIC->stages + (mriStepCoupling_HasEmbedding(MRIC) ? 1 : 0);
+
   fprintf(outfile, "  nmat = %i\n", MRIC->nmat);
   fprintf(outfile, "  stages = %i\n", MRIC->stages);
   fprintf(outfile, "  method order (q) = %i\n", MRIC->q);
@@ -494,7 +492,7 @@ void MRIStepCoupling_Write(MRIStepCoupling MRIC, FILE *outfile)
   if (MRIC->W) {
     for (k = 0; k < MRIC->nmat; k++) {
       fprintf(outfile, "  W[%i] = \n", k);
-      for (i = 0; i < MRIC->stages; i++){
+      for (i = 0; i < rows; i++){
         fprintf(outfile, "      ");
         for (j = 0; j < MRIC->stages; j++)
           fprintf(outfile, "%"RSYMW"  ", MRIC->W[k][i][j]);
@@ -507,7 +505,7 @@ void MRIStepCoupling_Write(MRIStepCoupling MRIC, FILE *outfile)
   if (MRIC->G) {
     for (k = 0; k < MRIC->nmat; k++) {
       fprintf(outfile, "  G[%i] = \n", k);
-      for (i = 0; i < MRIC->stages; i++) {
+      for (i = 0; i < rows; i++) {
         fprintf(outfile, "      ");
         for (j = 0; j < MRIC->stages; j++)
           fprintf(outfile, "%"RSYMW"  ", MRIC->G[k][i][j]);
@@ -524,6 +522,94 @@ void MRIStepCoupling_Write(MRIStepCoupling MRIC, FILE *outfile)
  * ===========================================================================*/
 
 
+/* ---------------------------------------------------------------------------
+ * Allocate a coupling table and fill it from 1D arrays holding nmat matrices
+ * of size rows * stages in C (row-major) order, where rows = stages + 1 if the
+ * arrays include the embedding row and rows = stages otherwise.
+ * ---------------------------------------------------------------------------*/
+
+MRIStepCoupling mriStepCoupling_Fill(int nmat, int stages, int q, int p,
+                                     realtype *W, realtype *G, realtype *c,
+                                     int rows)
+{
+  int i, j, k;
+  MRISTEP_METHOD_TYPE type;
+  MRIStepCoupling MRIC = NULL;
+
+  /* Check for legal inputs */
+  if (nmat < 1 || stages < 1 || !c) return(NULL);
+
+  /* Check for method coefficients and set method type */
+  if (W && G)
+    type = MRISTEP_IMEX;
+  else if (W && !G)
+    type = MRISTEP_EXPLICIT;
+  else if (!W && G)
+    type = MRISTEP_IMPLICIT;
+  else
+    return(NULL);
+
+  /* Allocate MRIStepCoupling structure */
+  MRIC = MRIStepCoupling_Alloc(nmat, stages, type);
+  if (!MRIC) return(NULL);
+
+  /* Method and embedding order */
+  MRIC->q = q;
+  MRIC->p = p;
+
+  /* Abscissae */
+  for (i=0; i<stages; i++)
+    MRIC->c[i] = c[i];
+
+  /* Coupling coefficients */
+  if (type == MRISTEP_EXPLICIT || type == MRISTEP_IMEX) {
+    for (k = 0; k < nmat; k++)
+      for (i = 0; i < rows; i++)
+        for (j = 0; j < stages; j++)
+          MRIC->W[k][i][j] = W[stages * (rows * k + i) + j];
+  }
+  if (type == MRISTEP_IMPLICIT || type == MRISTEP_IMEX) {
+    for (k = 0; k < nmat; k++)
+      for (i = 0; i < rows; i++)
+        for (j = 0; j < stages; j++)
+          MRIC->G[k][i][j] = G[stages * (rows * k + i) + j];
+  }
+
+  return(MRIC);
+}
+
+
+/* ---------------------------------------------------------------------------
+ * The embedding row (row 'stages' of the coupling matrices) is allocated by
+ * MRIStepCoupling_Alloc. Tables created without embedding coefficients free
+ * it, so that an embedding order without coefficients is detected.
+ * ---------------------------------------------------------------------------*/
+
+booleantype mriStepCoupling_HasEmbedding(MRIStepCoupling MRIC)
+{
+  if (MRIC->p < 1) return(SUNFALSE);
+  if (MRIC->W && !(MRIC->W[0][MRIC->stages])) return(SUNFALSE);
+  if (MRIC->G && !(MRIC->G[0][MRIC->stages])) return(SUNFALSE);
+  return(SUNTRUE);
+}
+
+void mriStepCoupling_DropEmbedding(MRIStepCoupling MRIC)
+{
+  int k;
+
+  for (k = 0; k < MRIC->nmat; k++) {
+    if (MRIC->W && MRIC->W[k][MRIC->stages]) {
+      free(MRIC->W[k][MRIC->stages]);
+      MRIC->W[k][MRIC->stages] = NULL;
+    }
+    if (MRIC->G && MRIC->G[k][MRIC->stages]) {
+      free(MRIC->G[k][MRIC->stages]);
+      MRIC->G[k][MRIC->stages] = NULL;
+    }
+  }
+}
+
+
 /* ---------------------------------------------------------------------------
  * Stage type identifier: returns one of the constants
  *
@@ -584,7 +670,7 @@ int mriStepCoupling_GetStageMap(MRIStepCoupling MRIC,
                                 int* stage_map,
                                 int* nstages_active)
 {
-  int i, j, k, idx;
+  int i, j, k, idx, rows;
   realtype Wsum, Gsum;
   const realtype tol = RCONST(100.0) * UNIT_ROUNDOFF;
 
@@ -606,8 +692,11 @@ int mriStepCoupling_GetStageMap(MRIStepCoupling MRIC,
   /* Initial storage index */
   idx = 0;
 
+  /* Rows to check, including the embedding row if present */
+  rows = MRIC->stages + (mriStepCoupling_HasEmbedding(MRIC) ? 1 : 0);
+
   /* Check if a stage corresponds to a column of zeros for all coupling
-   * matrices by computing the column sums */
+   * matrices, including the embedding row, by computing the column sums */
   for (j = 0; j < MRIC->stages; j++) {
 
     Wsum = ZERO;
@@ -615,12 +704,12 @@ int mriStepCoupling_GetStageMap(MRIStepCoupling MRIC,
 
     if (MRIC->W)
       for (k = 0; k < MRIC->nmat; k++)
-        for (i = 0; i < MRIC->stages; i++)
+        for (i = 0; i < rows; i++)
           Wsum += SUNRabs(MRIC->W[k][i][j]);
 
     if (MRIC->G)
       for (k = 0; k < MRIC->nmat; k++)
-        for (i = 0; i < MRIC->stages; i++)
+        for (i = 0; i < rows; i++)
           Gsum += SUNRabs(MRIC->G[k][i][j]);
 
     if (Wsum > tol || Gsum > tol) {
@@ -31,6 +31,15 @@ int mriStepCoupling_GetStageType(MRIStepCoupling MRIC, int is);
 int mriStepCoupling_GetStageMap(MRIStepCoupling MRIC, int* stage_map,
                                 int* nstored_stages);
 
+/* Allocates and fills a coupling table with or without the embedding row */
+MRIStepCoupling mriStepCoupling_Fill(int nmat, int stages, int q, int p,
+                                     realtype *W, realtype *G, realtype *c,
+                                     int rows);
+
+/* Checks for and removes the embedding row of a coupling table */
+booleantype mriStepCoupling_HasEmbedding(MRIStepCoupling MRIC);
+void mriStepCoupling_DropEmbedding(MRIStepCoupling MRIC);
+
 
 #ifdef __cplusplus
 }
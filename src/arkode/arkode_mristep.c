@@ -170,6 +170,11 @@ void* MRIStepCreate(ARKRhsFn fse, ARKRhsFn fsi, realtype t0, N_Vector y0,
   step_mem->nls_iters = 0;
   step_mem->nls_fails = 0;
 
+  /* Initialize the fast step budget controller data */
+  step_mem->hfast       = ZERO;
+  step_mem->fast_err    = ZERO;
+  step_mem->nfast_fails = 0;
+
   /* Initialize fused op work space */
   step_mem->cvals        = NULL;
   step_mem->Xvecs        = NULL;
@@ -419,6 +424,11 @@ int MRIStepReInit(void* arkode_mem, ARKRhsFn fse, ARKRhsFn fsi, realtype t0,
   step_mem->nstlp     = 0;
   step_mem->nls_iters = 0;
 
+  /* Reset the fast step budget controller data */
+  step_mem->hfast       = ZERO;
+  step_mem->fast_err    = ZERO;
+  step_mem->nfast_fails = 0;
+
   return(ARK_SUCCESS);
 }
 
@@ -991,6 +1001,7 @@ int mriStep_Init(void* arkode_mem, int init_type)
        an explicit method and an internal error weight function */
     reset_efun = SUNTRUE;
     if ( step_mem->implicit_rhs )  reset_efun = SUNFALSE;
+    if ( !ark_mem->fixedstep )  reset_efun = SUNFALSE;
     if ( ark_mem->user_efun )  reset_efun = SUNFALSE;
     if (reset_efun) {
       ark_mem->user_efun = SUNFALSE;
@@ -998,10 +1009,11 @@ int mriStep_Init(void* arkode_mem, int init_type)
       ark_mem->e_data    = ark_mem;
     }
 
-    /* assume fixed outer step size */
-    if (!ark_mem->fixedstep) {
+    /* the fast step budget requires an inner stepper with fixed steps */
+    if ((step_mem->fast_budget > 0) &&
+        (step_mem->stepper->ops->setfixedstep == NULL)) {
       arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKODE::MRIStep", "mriStep_Init",
-                      "Adaptive outer time stepping is not currently supported");
+                      "The inner stepper does not support a fast step budget");
       return(ARK_ILL_INPUT);
     }
 
@@ -1023,8 +1035,8 @@ int mriStep_Init(void* arkode_mem, int init_type)
 
     /* Retrieve/store method and embedding orders now that tables are finalized */
     step_mem->stages = step_mem->MRIC->stages;
-    step_mem->q = step_mem->MRIC->q;
-    step_mem->p = step_mem->MRIC->p;
+    step_mem->q = ark_mem->hadapt_mem->q = step_mem->MRIC->q;
+    step_mem->p = ark_mem->hadapt_mem->p = step_mem->MRIC->p;
 
     /* allocate/fill derived quantities from MRIC structure */
 
@@ -1444,9 +1456,15 @@ int mriStep_TakeStep(void* arkode_mem, realtype *dsmPtr, int *nflagPtr)
 {
   ARKodeMem ark_mem;           /* outer ARKODE memory        */
   ARKodeMRIStepMem step_mem;   /* outer stepper memory       */
-  int is;                      /* current stage index        */
+  booleantype retry;           /* repeated step attempt      */
+  booleantype adapt_budget;    /* adapt the fast step budget */
+  int fast_p;                  /* inner error estimate order */
+  realtype eta;                /* fast step size ratio       */
   int retval;                  /* reusable return flag       */
 
+  /* check for a repeated step attempt */
+  retry = (*nflagPtr != FIRST_CALL);
+
   /* initialize algebraic solver convergence flag to success;
      error estimate to zero */
   *nflagPtr = ARK_SUCCESS;
@@ -1457,6 +1475,15 @@ int mriStep_TakeStep(void* arkode_mem, realtype *dsmPtr, int *nflagPtr)
                                  &ark_mem, &step_mem);
   if (retval != ARK_SUCCESS) return(retval);
 
+  /* a repeated attempt restarts the slow and fast solutions from the
+     beginning of the step */
+  if (retry) {
+    N_VScale(ONE, ark_mem->yn, ark_mem->ycur);
+    retval = mriStepInnerStepper_Reset(step_mem->stepper, ark_mem->tn,
+                                       ark_mem->yn);
+    if (retval != ARK_SUCCESS) return(ARK_INNERSTEP_FAIL);
+  }
+
 #ifdef SUNDIALS_DEBUG
   printf("    MRIStep step %li,  stage 0,  h = %"RSYM",  t_n = %"RSYM"\n",
          ark_mem->nst, ark_mem->h, ark_mem->tcur);
@@ -1493,12 +1520,120 @@ int mriStep_TakeStep(void* arkode_mem, realtype *dsmPtr, int *nflagPtr)
       if (retval > 0) return(ARK_NLS_SETUP_RECVR);
     }
 
+  /* the fast step budget is adapted if the inner stepper estimates its error
+     and provides the order of the estimate */
+  adapt_budget = (step_mem->fast_budget > 0) &&
+    (step_mem->stepper->ops->getaccumulatederror != NULL) &&
+    (step_mem->stepper->ops->resetaccumulatederror != NULL) &&
+    (step_mem->stepper->ops->getembeddingorder != NULL);
+
+  for (;;) {
+
+    /* set the inner step size from the fast step budget */
+    if (step_mem->fast_budget > 0) {
+      retval = mriStep_SetFastStep(ark_mem, step_mem);
+      if (retval != ARK_SUCCESS) return(retval);
+    }
+
+    /* compute the stages, time-evolved solution, and error estimate */
+    retval = mriStep_ComputeStages(ark_mem, step_mem, nflagPtr, dsmPtr);
+    if (retval != ARK_SUCCESS) return(retval);
+
+    if (!adapt_budget) break;
+
+    /* update the fast step size from the accumulated inner error estimate
+       of order p, h_f = h_f * safety * err^(-1/p) */
+    retval = mriStepInnerStepper_GetAccumulatedError(step_mem->stepper,
+                                                     &(step_mem->fast_err));
+    if (retval != ARK_SUCCESS) return(ARK_INNERSTEP_FAIL);
+
+    retval = mriStepInnerStepper_GetEmbeddingOrder(step_mem->stepper,
+                                                   &fast_p);
+    if ((retval != ARK_SUCCESS) || (fast_p < 1)) return(ARK_INNERSTEP_FAIL);
+
+    if (step_mem->fast_err > ZERO)
+      eta = FAST_SAFETY * SUNRpowerR(step_mem->fast_err, -ONE / fast_p);
+    else
+      eta = FAST_GROWTH;
+    eta = SUNMAX(SUNMIN(eta, FAST_GROWTH), FAST_ETAMIN);
+    step_mem->hfast *= eta;
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_INFO
+    SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_INFO,
+                       "ARKODE::mriStep_TakeStep", "fast-error-test",
+                       "step = %li, budget = %i, fast_err = %"RSYM,
+                       ark_mem->nst, step_mem->fast_budget,
+                       step_mem->fast_err);
+#endif
+
+    /* accept the inner solution if it passes the error test, if the budget
+       cannot grow, or if the slow error test will reject the step anyway */
+    if ((step_mem->fast_err <= ONE) ||
+        (step_mem->fast_budget >= step_mem->max_budget) ||
+        (*dsmPtr > ONE))
+      break;
+
+    /* otherwise repeat the step with a larger fast step budget */
+    step_mem->nfast_fails++;
+    N_VScale(ONE, ark_mem->yn, ark_mem->ycur);
+    retval = mriStepInnerStepper_Reset(step_mem->stepper, ark_mem->tn,
+                                       ark_mem->yn);
+    if (retval != ARK_SUCCESS) return(ARK_INNERSTEP_FAIL);
+  }
+
+#ifdef SUNDIALS_LOGGING_EXTRA_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::mriStep_TakeStep", "updated solution",
+                     "ycur =", "");
+  N_VPrintFile(ark_mem->ycur, ARK_LOGGER->debug_fp);
+#endif
+
+  /* Solver diagnostics reporting */
+  if (ark_mem->report)
+    fprintf(ark_mem->diagfp, "MRIStep  etest  %li  %"RSYM"  %"RSYM"\n",
+            ark_mem->nst, ark_mem->h, *dsmPtr);
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_INFO
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_INFO,
+                     "ARKODE::mriStep_TakeStep", "error-test",
+                     "step = %li, h = %"RSYM", dsm = %"RSYM,
+                     ark_mem->nst, ark_mem->h, *dsmPtr);
+#endif
+
+  return(ARK_SUCCESS);
+}
+
+
+
+
+/*---------------------------------------------------------------
+  mriStep_ComputeStages:
+
+  This routine computes the stages of a single MRI step. On
+  return ark_mem->ycur holds the time-evolved solution and, when
+  the step size is adaptive, dsmPtr holds the weighted norm of
+  the difference between the solution and its embedding. The
+  inputs and return values are the same as for mriStep_TakeStep.
+  ---------------------------------------------------------------*/
+int mriStep_ComputeStages(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
+                          int *nflagPtr, realtype *dsmPtr)
+{
+  int is;                      /* current stage index        */
+  int retval;                  /* reusable return flag       */
+
   /* The first stage is the previous time-step solution, so its RHS
      is the [already-computed] slow RHS from the start of the step */
 
   /* Loop over remaining stages */
   for (is = 1; is < step_mem->stages; is++) {
 
+    /* The embedding replaces the last stage, compute it from the current
+       stage solution before the last stage overwrites it */
+    if ((is == step_mem->stages - 1) && !(ark_mem->fixedstep)) {
+      retval = mriStep_ComputeEmbedding(ark_mem, step_mem);
+      if (retval != ARK_SUCCESS) return(retval);
+    }
+
     /* Set current stage time  */
     ark_mem->tcur = ark_mem->tn + step_mem->MRIC->c[is]*ark_mem->h;
 
@@ -1605,24 +1740,146 @@ int mriStep_TakeStep(void* arkode_mem, realtype *dsmPtr, int *nflagPtr)
     } /* compute slow RHS */
   } /* loop over stages */
 
+  /* compute the error estimate (if step adaptivity enabled) */
+  if (!(ark_mem->fixedstep)) {
+    N_VLinearSum(ONE, ark_mem->ycur, -ONE, ark_mem->tempv4, ark_mem->tempv4);
+    *dsmPtr = N_VWrmsNorm(ark_mem->tempv4, ark_mem->ewt);
+  }
+
+  return(ARK_SUCCESS);
+}
+
+
+/*---------------------------------------------------------------
+  mriStep_ComputeEmbedding:
+
+  This routine computes the embedded solution of an MRI step in
+  ark_mem->tempv4. The embedding is given by the additional row
+  of the coupling matrices and replaces the last stage, i.e., it
+  starts from the stage solution z_{s-2} in ark_mem->ycur and
+  uses the slow RHS of the stages 0 to s-2. If the embedding
+  requires a fast evolution the inner stepper is afterwards
+  reset to z_{s-2} for the last stage.
+  ---------------------------------------------------------------*/
+int mriStep_ComputeEmbedding(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem)
+{
+  int retval, j, nvec, is;
+  realtype t0, tf, cdiff;
+  N_Vector yemb;
+  const realtype tol = RCONST(100.0)*UNIT_ROUNDOFF;
+
+  /* the embedding is stored as row 'stages' of the coupling matrices */
+  is   = step_mem->stages;
+  yemb = ark_mem->tempv4;
+
+  t0    = ark_mem->tn + step_mem->MRIC->c[is-2]*ark_mem->h;
+  tf    = ark_mem->tn + ark_mem->h;
+  cdiff = step_mem->MRIC->c[is-1] - step_mem->MRIC->c[is-2];
+
+  N_VScale(ONE, ark_mem->ycur, yemb);
+
+  if (cdiff > tol) {
+
+    /* compute the inner forcing and time normalization constants */
+    retval = mriStep_ComputeInnerForcing(ark_mem, step_mem, is, cdiff);
+    if (retval != ARK_SUCCESS) return(retval);
+
+    step_mem->stepper->tshift = t0;
+    step_mem->stepper->tscale = cdiff * ark_mem->h;
+
+    /* pre inner evolve function (if supplied) */
+    if (step_mem->pre_inner_evolve) {
+      retval = step_mem->pre_inner_evolve(t0, step_mem->stepper->forcing,
+                                          step_mem->stepper->nforcing,
+                                          ark_mem->user_data);
+      if (retval != 0) return(ARK_OUTERTOINNER_FAIL);
+    }
+
+    /* advance inner method in time */
+    retval = mriStepInnerStepper_Evolve(step_mem->stepper, t0, tf, yemb);
+    if (retval < 0) return(ARK_INNERSTEP_FAIL);
+
+    /* post inner evolve function (if supplied) */
+    if (step_mem->post_inner_evolve) {
+      retval = step_mem->post_inner_evolve(tf, yemb, ark_mem->user_data);
+      if (retval != 0) return(ARK_INNERTOOUTER_FAIL);
+    }
+
+    /* restore the inner stepper state for the last stage */
+    retval = mriStepInnerStepper_Reset(step_mem->stepper, t0, ark_mem->ycur);
+    if (retval != ARK_SUCCESS) return(ARK_INNERSTEP_FAIL);
+
+  } else {
+
+    /* determine effective RK coefficients of the embedding */
+    retval = mriStep_RKCoeffs(step_mem->MRIC, is, step_mem->stage_map,
+                              step_mem->Ae_row, step_mem->Ai_row);
+    if (retval != ARK_SUCCESS) return(retval);
+
+    step_mem->cvals[0] = ONE;
+    step_mem->Xvecs[0] = yemb;
+    nvec = 1;
+    for (j = 0; j < is - 1; j++) {
+      if (step_mem->explicit_rhs && step_mem->stage_map[j] > -1) {
+        step_mem->cvals[nvec] = ark_mem->h *
+          step_mem->Ae_row[step_mem->stage_map[j]];
+        step_mem->Xvecs[nvec] = step_mem->Fse[step_mem->stage_map[j]];
+        nvec += 1;
+      }
+      if (step_mem->implicit_rhs && step_mem->stage_map[j] > -1) {
+        step_mem->cvals[nvec] = ark_mem->h *
+          step_mem->Ai_row[step_mem->stage_map[j]];
+        step_mem->Xvecs[nvec] = step_mem->Fsi[step_mem->stage_map[j]];
+        nvec += 1;
+      }
+    }
+
+    retval = N_VLinearCombination(nvec, step_mem->cvals,
+                                  step_mem->Xvecs, yemb);
+    if (retval != 0) return(ARK_VECTOROP_ERR);
+  }
+
 #ifdef SUNDIALS_LOGGING_EXTRA_DEBUG
   SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
-                     "ARKODE::mriStep_TakeStep", "updated solution",
-                     "ycur =", "");
-  N_VPrintFile(ark_mem->ycur, ARK_LOGGER->debug_fp);
+                     "ARKODE::mriStep_ComputeEmbedding", "embedded solution",
+                     "yemb =", "");
+  N_VPrintFile(yemb, ARK_LOGGER->debug_fp);
 #endif
 
-  /* Solver diagnostics reporting */
-  if (ark_mem->report)
-    fprintf(ark_mem->diagfp, "MRIStep  etest  %li  %"RSYM"  %"RSYM"\n",
-            ark_mem->nst, ark_mem->h, *dsmPtr);
+  return(ARK_SUCCESS);
+}
 
-#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_INFO
-  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_INFO,
-                     "ARKODE::mriStep_TakeStep", "error-test",
-                     "step = %li, h = %"RSYM", dsm = %"RSYM,
-                     ark_mem->nst, ark_mem->h, *dsmPtr);
-#endif
+
+/*---------------------------------------------------------------
+  mriStep_SetFastStep:
+
+  This routine sets the number of inner steps taken per slow
+  step, either from the initial fast step budget or from the
+  fast step size selected by the controller, and passes the
+  resulting fixed step size to the inner stepper.
+  ---------------------------------------------------------------*/
+int mriStep_SetFastStep(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem)
+{
+  int retval;
+  realtype nsteps;
+
+  /* number of inner steps to cover the slow step */
+  if (step_mem->hfast != ZERO) {
+    nsteps = SUNRceil(SUNRabs(ark_mem->h / step_mem->hfast) - ark_mem->uround);
+    nsteps = SUNMIN(nsteps, (realtype) step_mem->max_budget);
+    step_mem->fast_budget = SUNMAX((int) nsteps, 1);
+  }
+  step_mem->hfast = ark_mem->h / step_mem->fast_budget;
+
+  retval = mriStepInnerStepper_SetFixedStep(step_mem->stepper,
+                                            step_mem->hfast);
+  if (retval != ARK_SUCCESS) return(ARK_INNERSTEP_FAIL);
+
+  /* restart the accumulation of the inner error estimate */
+  if (step_mem->stepper->ops->resetaccumulatederror) {
+    retval = mriStepInnerStepper_ResetAccumulatedError(step_mem->stepper);
+    if (retval != ARK_SUCCESS) return(ARK_INNERSTEP_FAIL);
+  }
 
   return(ARK_SUCCESS);
 }
@@ -1834,6 +2091,14 @@ int mriStep_CheckCoupling(ARKodeMem ark_mem)
     return(ARK_INVALID_TABLE);
   }
 
+  /* check that the embedding coefficients are given (if adaptive) */
+  if (!mriStepCoupling_HasEmbedding(step_mem->MRIC) && (!ark_mem->fixedstep)) {
+    arkProcessError(ark_mem, ARK_INVALID_TABLE, "ARKODE::MRIStep",
+                    "mriStep_CheckCoupling",
+                    "coupling table has no embedding coefficients");
+    return(ARK_INVALID_TABLE);
+  }
+
   /* Check that the matrices are defined appropriately */
   if (step_mem->implicit_rhs && step_mem->explicit_rhs) {
     /* ImEx */
@@ -1932,6 +2197,30 @@ int mriStep_CheckCoupling(ARKodeMem ark_mem)
     return(ARK_INVALID_TABLE);
   }
 
+  /* check that the embedding is explicit in the last stage */
+  if (mriStepCoupling_HasEmbedding(step_mem->MRIC)) {
+    if (step_mem->MRIC->stages < 2) {
+      arkProcessError(ark_mem, ARK_INVALID_TABLE, "ARKODE::MRIStep",
+                      "mriStep_CheckCoupling",
+                      "An embedding requires at least two stages.");
+      return(ARK_INVALID_TABLE);
+    }
+    Gabs = ZERO;
+    i = step_mem->MRIC->stages;
+    for (k=0; k<step_mem->MRIC->nmat; k++) {
+      if (step_mem->MRIC->W)
+        Gabs += SUNRabs(step_mem->MRIC->W[k][i][i-1]);
+      if (step_mem->MRIC->G)
+        Gabs += SUNRabs(step_mem->MRIC->G[k][i][i-1]);
+    }
+    if (Gabs > tol) {
+      arkProcessError(ark_mem, ARK_INVALID_TABLE, "ARKODE::MRIStep",
+                      "mriStep_CheckCoupling",
+                      "Embedding may not depend on the last stage.");
+      return(ARK_INVALID_TABLE);
+    }
+  }
+
   /* check that the last stage is at the final time */
   if (SUNRabs(ONE - step_mem->MRIC->c[step_mem->MRIC->stages-1]) > tol) {
     arkProcessError(ark_mem, ARK_INVALID_TABLE, "ARKODE::MRIStep",
@@ -2191,7 +2480,7 @@ int mriStep_ComputeInnerForcing(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
                                 int stage, realtype cdiff)
 {
   realtype  rcdiff;
-  int       j, k, nmat, nstore, retval;
+  int       j, jmax, k, nmat, nstore, retval;
   realtype* cvals;
   N_Vector* Xvecs;
 
@@ -2199,9 +2488,12 @@ int mriStep_ComputeInnerForcing(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
   cvals = step_mem->cvals;
   Xvecs = step_mem->Xvecs;
 
+  /* the embedding (stage == stages) only couples to the stages 0 to s-2 */
+  jmax = SUNMIN(stage, step_mem->MRIC->stages - 1);
+
   /* compute inner forcing vectors (assumes cdiff != 0) */
   nstore = 0;
-  for (j = 0; j < stage; j++) {
+  for (j = 0; j < jmax; j++) {
     if (step_mem->explicit_rhs && step_mem->stage_map[j] > -1) {
       Xvecs[nstore] = step_mem->Fse[step_mem->stage_map[j]];
       nstore += 1;
@@ -2217,7 +2509,7 @@ int mriStep_ComputeInnerForcing(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
 
   for (k = 0; k < nmat; k++) {
     nstore = 0;
-    for (j = 0; j < stage; j++) {
+    for (j = 0; j < jmax; j++) {
       if (step_mem->stage_map[j] > -1) {
         if (step_mem->explicit_rhs && step_mem->implicit_rhs) {
           /* ImEx */
@@ -2258,19 +2550,22 @@ int mriStep_ComputeInnerForcing(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
 
 /*---------------------------------------------------------------
   Compute/return the 'effective' RK coefficients for a 'nofast'
-  stage.  It is assumed that the array 'A' has already been
+  stage or, with is == MRIC->stages, for the embedding.  It is assumed that the array 'A' has already been
   allocated to have length MRIC->stages.
   ---------------------------------------------------------------*/
 
 int mriStep_RKCoeffs(MRIStepCoupling MRIC, int is, int *stage_map,
                      realtype *Ae_row, realtype *Ai_row)
 {
-  int j, k;
+  int j, k, jmax;
   realtype kconst;
 
-  if (is < 1 || is >= MRIC->stages || !stage_map || !Ae_row || !Ai_row)
+  if (is < 1 || is > MRIC->stages || !stage_map || !Ae_row || !Ai_row)
     return ARK_INVALID_TABLE;
 
+  /* the embedding row (is == stages) is explicit in the stages 0 to s-2 */
+  jmax = (is < MRIC->stages) ? is : MRIC->stages - 2;
+
   /* initialize RK coefficient array */
   for (j = 0; j < MRIC->stages; j++) {
     Ae_row[j] = ZERO;
@@ -2281,12 +2576,12 @@ int mriStep_RKCoeffs(MRIStepCoupling MRIC, int is, int *stage_map,
   for (k = 0; k < MRIC->nmat; k++) {
     kconst = ONE/(k+ONE);
     if (MRIC->W) {
-      for (j = 0; j < is; j++)
+      for (j = 0; j <= SUNMIN(jmax, is - 1); j++)
         if (stage_map[j] > -1)
           Ae_row[stage_map[j]] += (MRIC->W[k][is][j] * kconst);
     }
     if (MRIC->G) {
-      for (j = 0; j <= is; j++)
+      for (j = 0; j <= jmax; j++)
         if (stage_map[j] > -1)
           Ai_row[stage_map[j]] += (MRIC->G[k][is][j] * kconst);
     }
@@ -2660,6 +2955,106 @@ int MRIStepInnerStepper_SetResetFn(MRIStepInnerStepper stepper,
 }
 
 
+int MRIStepInnerStepper_SetFixedStepFn(MRIStepInnerStepper stepper,
+                                       MRIStepInnerSetFixedStepFn fn)
+{
+  if (stepper == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, "ARKODE::MRIStep",
+                    "MRIStepInnerStepper_SetFixedStepFn",
+                    "Inner stepper memory is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  if (stepper->ops == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, "ARKODE::MRIStep",
+                    "MRIStepInnerStepper_SetFixedStepFn",
+                    "Inner stepper operations structure is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  stepper->ops->setfixedstep = fn;
+
+  return ARK_SUCCESS;
+}
+
+
+int MRIStepInnerStepper_SetAccumulatedErrorGetFn(MRIStepInnerStepper stepper,
+                                                 MRIStepInnerGetAccumulatedErrorFn fn)
+{
+  if (stepper == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, "ARKODE::MRIStep",
+                    "MRIStepInnerStepper_SetAccumulatedErrorGetFn",
+                    "Inner stepper memory is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  if (stepper->ops == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, "ARKODE::MRIStep",
+                    "MRIStepInnerStepper_SetAccumulatedErrorGetFn",
+                    "Inner stepper operations structure is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  stepper->ops->getaccumulatederror = fn;
+
+  return ARK_SUCCESS;
+}
+
+
+int MRIStepInnerStepper_SetAccumulatedErrorResetFn(MRIStepInnerStepper stepper,
+                                                   MRIStepInnerResetAccumulatedErrorFn fn)
+{
+  if (stepper == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, "ARKODE::MRIStep",
+                    "MRIStepInnerStepper_SetAccumulatedErrorResetFn",
+                    "Inner stepper memory is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  if (stepper->ops == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, "ARKODE::MRIStep",
+                    "MRIStepInnerStepper_SetAccumulatedErrorResetFn",
+                    "Inner stepper operations structure is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  stepper->ops->resetaccumulatederror = fn;
+
+  return ARK_SUCCESS;
+}
+
+
+int MRIStepInnerStepper_SetEmbeddingOrderGetFn(MRIStepInnerStepper stepper,
+                                               MRIStepInnerGetEmbeddingOrderFn fn)
+{
+  if (stepper == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, "ARKODE::MRIStep",
+                    "MRIStepInnerStepper_SetEmbeddingOrderGetFn",
+                    "Inner stepper memory is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  if (stepper->ops == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, "ARKODE::MRIStep",
+                    "MRIStepInnerStepper_SetEmbeddingOrderGetFn",
+                    "Inner stepper operations structure is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  stepper->ops->getembeddingorder = fn;
+
+  return ARK_SUCCESS;
+}
+
+
 int MRIStepInnerStepper_AddForcing(MRIStepInnerStepper stepper,
                                    realtype t, N_Vector f)
 {
@@ -2801,6 +3196,56 @@ int mriStepInnerStepper_Reset(MRIStepInnerStepper stepper,
 }
 
 
+/* Set the inner (fast) stepper fixed step size */
+int mriStepInnerStepper_SetFixedStep(MRIStepInnerStepper stepper,
+                                     realtype hfixed)
+{
+  if (stepper == NULL) return ARK_ILL_INPUT;
+  if (stepper->ops == NULL) return ARK_ILL_INPUT;
+  if (stepper->ops->setfixedstep == NULL) return ARK_ILL_INPUT;
+
+  stepper->last_flag = stepper->ops->setfixedstep(stepper, hfixed);
+  return stepper->last_flag;
+}
+
+
+/* Get the inner (fast) stepper accumulated error estimate */
+int mriStepInnerStepper_GetAccumulatedError(MRIStepInnerStepper stepper,
+                                            realtype *accum)
+{
+  if (stepper == NULL) return ARK_ILL_INPUT;
+  if (stepper->ops == NULL) return ARK_ILL_INPUT;
+  if (stepper->ops->getaccumulatederror == NULL) return ARK_ILL_INPUT;
+
+  stepper->last_flag = stepper->ops->getaccumulatederror(stepper, accum);
+  return stepper->last_flag;
+}
+
+
+/* Reset the inner (fast) stepper accumulated error estimate */
+int mriStepInnerStepper_ResetAccumulatedError(MRIStepInnerStepper stepper)
+{
+  if (stepper == NULL) return ARK_ILL_INPUT;
+  if (stepper->ops == NULL) return ARK_ILL_INPUT;
+  if (stepper->ops->resetaccumulatederror == NULL) return ARK_ILL_INPUT;
+
+  stepper->last_flag = stepper->ops->resetaccumulatederror(stepper);
+  return stepper->last_flag;
+}
+
+
+/* Get the order of the inner (fast) stepper error estimate */
+int mriStepInnerStepper_GetEmbeddingOrder(MRIStepInnerStepper stepper, int *p)
+{
+  if (stepper == NULL) return ARK_ILL_INPUT;
+  if (stepper->ops == NULL) return ARK_ILL_INPUT;
+  if (stepper->ops->getembeddingorder == NULL) return ARK_ILL_INPUT;
+
+  stepper->last_flag = stepper->ops->getembeddingorder(stepper, p);
+  return stepper->last_flag;
+}
+
+
 /* Allocate MRI forcing and fused op workspace vectors if necessary */
 int mriStepInnerStepper_AllocVecs(MRIStepInnerStepper stepper, int count,
                                   N_Vector tmpl)
@@ -37,6 +37,12 @@ extern "C" {
 #define MRISTAGE_DIRK_NOFAST 2
 #define MRISTAGE_DIRK_FAST   3
 
+/* Fast step budget controller constants */
+#define FAST_MAX_BUDGET  1000            /* default max inner steps per step */
+#define FAST_SAFETY      RCONST(0.9)     /* fast step size safety factor     */
+#define FAST_GROWTH      RCONST(10.0)    /* max fast step size growth        */
+#define FAST_ETAMIN      RCONST(0.1)     /* min fast step size reduction     */
+
 /* Implicit solver constants (duplicate from arkode_arkstep_impl.h) */
 #define MAXCOR    3              /* max number of nonlinear iterations */
 #define CRDOWN    RCONST(0.3)    /* constant to estimate the convergence
@@ -126,6 +132,13 @@ typedef struct ARKodeMRIStepMemRec {
   MRIStepPreInnerFn  pre_inner_evolve;
   MRIStepPostInnerFn post_inner_evolve;
 
+  /* Fast step budget controller */
+  int      fast_budget;   /* inner steps per slow step (0 = disabled)   */
+  int      max_budget;    /* max inner steps per slow step              */
+  realtype hfast;         /* inner step size from the controller        */
+  realtype fast_err;      /* accumulated inner error of the last step   */
+  long int nfast_fails;   /* slow steps repeated due to the inner error */
+
   /* Counters */
   long int nfse;          /* num fse calls                    */
   long int nfsi;          /* num fsi calls                    */
@@ -149,9 +162,13 @@ typedef struct _MRIStepInnerStepper_Ops *MRIStepInnerStepper_Ops;
 
 struct _MRIStepInnerStepper_Ops
 {
-  MRIStepInnerEvolveFn  evolve;
-  MRIStepInnerFullRhsFn fullrhs;
-  MRIStepInnerResetFn   reset;
+  MRIStepInnerEvolveFn                evolve;
+  MRIStepInnerFullRhsFn               fullrhs;
+  MRIStepInnerResetFn                 reset;
+  MRIStepInnerSetFixedStepFn          setfixedstep;
+  MRIStepInnerGetAccumulatedErrorFn   getaccumulatederror;
+  MRIStepInnerResetAccumulatedErrorFn resetaccumulatederror;
+  MRIStepInnerGetEmbeddingOrderFn     getembeddingorder;
 };
 
 struct _MRIStepInnerStepper
@@ -219,6 +236,10 @@ int mriStep_StageDIRKFast(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
                           int is, int *nflagPtr);
 int mriStep_StageDIRKNoFast(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
                             int is, int *nflagPtr);
+int mriStep_ComputeStages(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
+                          int *nflagPtr, realtype *dsmPtr);
+int mriStep_ComputeEmbedding(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem);
+int mriStep_SetFastStep(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem);
 int mriStep_Predict(ARKodeMem ark_mem, int istage, N_Vector yguess);
 int mriStep_StageSetup(ARKodeMem ark_mem);
 int mriStep_NlsInit(ARKodeMem ark_mem);
@@ -242,6 +263,12 @@ int mriStepInnerStepper_FullRhs(MRIStepInnerStepper stepper,
                                 int mode);
 int mriStepInnerStepper_Reset(MRIStepInnerStepper stepper,
                               realtype tR, N_Vector yR);
+int mriStepInnerStepper_SetFixedStep(MRIStepInnerStepper stepper,
+                                     realtype hfixed);
+int mriStepInnerStepper_GetAccumulatedError(MRIStepInnerStepper stepper,
+                                            realtype *accum);
+int mriStepInnerStepper_ResetAccumulatedError(MRIStepInnerStepper stepper);
+int mriStepInnerStepper_GetEmbeddingOrder(MRIStepInnerStepper stepper, int *p);
 int mriStepInnerStepper_AllocVecs(MRIStepInnerStepper stepper, int count,
                                   N_Vector tmpl);
 int mriStepInnerStepper_Resize(MRIStepInnerStepper stepper,
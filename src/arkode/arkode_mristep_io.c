@@ -63,6 +63,16 @@ int MRIStepSetPostprocessStepFn(void *arkode_mem,
 int MRIStepSetPostprocessStageFn(void *arkode_mem,
                                  ARKPostProcessFn ProcessStage) {
   return(arkSetPostprocessStageFn(arkode_mem, ProcessStage)); }
+int MRIStepSetInitStep(void *arkode_mem, realtype hin) {
+  return(arkSetInitStep(arkode_mem, hin)); }
+int MRIStepSetMinStep(void *arkode_mem, realtype hmin) {
+  return(arkSetMinStep(arkode_mem, hmin)); }
+int MRIStepSetMaxStep(void *arkode_mem, realtype hmax) {
+  return(arkSetMaxStep(arkode_mem, hmax)); }
+int MRIStepSetMaxErrTestFails(void *arkode_mem, int maxnef) {
+  return(arkSetMaxErrTestFails(arkode_mem, maxnef)); }
+int MRIStepSetAdaptController(void *arkode_mem, SUNAdaptController C) {
+  return(arkSetAdaptController(arkode_mem, C)); }
 
 
 /*---------------------------------------------------------------
@@ -74,6 +84,8 @@ int MRIStepSetLinearSolver(void *arkode_mem, SUNLinearSolver LS,
   return(arkLSSetLinearSolver(arkode_mem, LS, A)); }
 int MRIStepSetJacFn(void *arkode_mem, ARKLsJacFn jac) {
   return(arkLSSetJacFn(arkode_mem, jac)); }
+int MRIStepSetJacSparsityPattern(void *arkode_mem, SUNMatrix P) {
+  return(arkLSSetJacSparsityPattern(arkode_mem, P)); }
 int MRIStepSetJacEvalFrequency(void *arkode_mem, long int msbj) {
   return(arkLSSetJacEvalFrequency(arkode_mem, msbj)); }
 int MRIStepSetLinearSolutionScaling(void *arkode_mem, booleantype onoff) {
@@ -118,6 +130,18 @@ int MRIStepGetNumStepSolveFails(void *arkode_mem, long int *nncfails) {
   return(arkGetNumStepSolveFails(arkode_mem, nncfails)); }
 int MRIStepGetUserData(void *arkode_mem, void** user_data) {
   return(arkGetUserData(arkode_mem, user_data)); }
+int MRIStepGetNumStepAttempts(void *arkode_mem, long int *nstep_attempts) {
+  return(arkGetNumStepAttempts(arkode_mem, nstep_attempts)); }
+int MRIStepGetNumErrTestFails(void *arkode_mem, long int *netfails) {
+  return(arkGetNumErrTestFails(arkode_mem, netfails)); }
+int MRIStepGetActualInitStep(void *arkode_mem, realtype *hinused) {
+  return(arkGetActualInitStep(arkode_mem, hinused)); }
+int MRIStepGetCurrentStep(void *arkode_mem, realtype *hcur) {
+  return(arkGetCurrentStep(arkode_mem, hcur)); }
+int MRIStepGetStepStats(void *arkode_mem, long int *nssteps,
+                        realtype *hinused, realtype *hlast,
+                        realtype *hcur, realtype *tcur) {
+  return(arkGetStepStats(arkode_mem, nssteps, hinused, hlast, hcur, tcur)); }
 char *MRIStepGetReturnFlagName(long int flag) {
   return(arkGetReturnFlagName(flag)); }
 
@@ -229,6 +253,8 @@ int MRIStepSetDefaults(void* arkode_mem)
   step_mem->jcur           = SUNFALSE;
   step_mem->convfail       = ARK_NO_FAILURES;
   step_mem->stage_predict  = NULL;           /* no user-supplied stage predictor */
+  step_mem->fast_budget    = 0;              /* no fast step budget control */
+  step_mem->max_budget     = FAST_MAX_BUDGET; /* max inner steps per step */
 
   return(ARK_SUCCESS);
 }
@@ -440,8 +466,9 @@ int MRIStepSetPostInnerFn(void *arkode_mem, MRIStepPostInnerFn postfn)
 /*---------------------------------------------------------------
   MRIStepSetFixedStep:
 
-  Wrapper for generic arkSetFixedStep routine.  Additionally
-  enforces current MRIStep constraint for fixed time-stepping.
+  Wrapper for generic arkSetFixedStep routine.  A zero input
+  enables adaptive slow time steps, which require a coupling
+  table with an embedding.
   ---------------------------------------------------------------*/
 int MRIStepSetFixedStep(void *arkode_mem, realtype hsfixed)
 {
@@ -453,15 +480,42 @@ int MRIStepSetFixedStep(void *arkode_mem, realtype hsfixed)
   }
   ark_mem = (ARKodeMem) arkode_mem;
 
-  if (hsfixed == ZERO) {
+  /* call generic routine for remaining work */
+  return(arkSetFixedStep(ark_mem, hsfixed));
+}
+
+
+/*---------------------------------------------------------------
+  MRIStepSetFastStepBudget:
+
+  Specifies the initial number of fixed inner steps taken per
+  slow step and the maximum number the controller may select.
+  A zero budget leaves the inner step size to the inner stepper;
+  a non-positive maximum implies a reset to the default.
+  ---------------------------------------------------------------*/
+int MRIStepSetFastStepBudget(void *arkode_mem, int budget, int max_budget)
+{
+  ARKodeMem ark_mem;
+  ARKodeMRIStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMRIStepMem structure */
+  retval = mriStep_AccessStepMem(arkode_mem, "MRIStepSetFastStepBudget",
+                                 &ark_mem, &step_mem);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  if (budget < 0) {
     arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKODE::MRIStep",
-                    "MRIStepSetFixedStep",
-                    "MRIStep does not support adaptive steps at this time.");
+                    "MRIStepSetFastStepBudget",
+                    "The fast step budget must be non-negative");
     return(ARK_ILL_INPUT);
   }
 
-  /* call generic routine for remaining work */
-  return(arkSetFixedStep(ark_mem, hsfixed));
+  step_mem->max_budget  = (max_budget > 0) ? max_budget : FAST_MAX_BUDGET;
+  step_mem->fast_budget = SUNMIN(budget, step_mem->max_budget);
+  step_mem->hfast       = ZERO;
+
+  return(ARK_SUCCESS);
 }
 
 
@@ -927,6 +981,33 @@ int MRIStepGetNonlinSolvStats(void *arkode_mem, long int *nniters,
 }
 
 
+/*---------------------------------------------------------------
+  MRIStepGetFastStepStats:
+
+  Returns the current fast step budget, the last accumulated
+  inner error estimate, and the number of slow step attempts
+  repeated because the inner error test failed.
+  ---------------------------------------------------------------*/
+int MRIStepGetFastStepStats(void *arkode_mem, int *budget,
+                            realtype *fast_err, long int *nfast_fails)
+{
+  ARKodeMem ark_mem;
+  ARKodeMRIStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMRIStepMem structure */
+  retval = mriStep_AccessStepMem(arkode_mem, "MRIStepGetFastStepStats",
+                                 &ark_mem, &step_mem);
+  if (retval != ARK_SUCCESS) return(retval);
+
+  *budget      = step_mem->fast_budget;
+  *fast_err    = step_mem->fast_err;
+  *nfast_fails = step_mem->nfast_fails;
+
+  return(ARK_SUCCESS);
+}
+
+
 /*---------------------------------------------------------------
   MRIStepGetCurrentCoupling:
 
@@ -978,6 +1059,13 @@ int MRIStepPrintAllStats(void *arkode_mem, FILE *outfile, SUNOutputFormat fmt)
     fprintf(outfile, "Explicit slow RHS fn evals   = %ld\n", step_mem->nfse);
     fprintf(outfile, "Implicit slow RHS fn evals   = %ld\n", step_mem->nfsi);
 
+    /* fast step budget stats */
+    if (step_mem->fast_budget > 0)
+    {
+      fprintf(outfile, "Fast step budget             = %i\n", step_mem->fast_budget);
+      fprintf(outfile, "Fast error test fails        = %ld\n", step_mem->nfast_fails);
+    }
+
 
     /* nonlinear solver stats */
     fprintf(outfile, "NLS iters                    = %ld\n", step_mem->nls_iters);
@@ -1018,6 +1106,13 @@ int MRIStepPrintAllStats(void *arkode_mem, FILE *outfile, SUNOutputFormat fmt)
     fprintf(outfile, ",Explicit slow RHS fn evals,%ld", step_mem->nfse);
     fprintf(outfile, ",Implicit slow RHS fn evals,%ld", step_mem->nfsi);
 
+    /* fast step budget stats */
+    if (step_mem->fast_budget > 0)
+    {
+      fprintf(outfile, ",Fast step budget,%i", step_mem->fast_budget);
+      fprintf(outfile, ",Fast error test fails,%ld", step_mem->nfast_fails);
+    }
+
     /* nonlinear solver stats */
     fprintf(outfile, ",NLS iters,%ld", step_mem->nls_iters);
     fprintf(outfile, ",NLS fails,%ld", step_mem->nls_fails);
@@ -18,6 +18,8 @@
  *   tempv2 - holds delta_y, the update direction vector
  *   tempv3 - holds y_relax, the relaxed solution vector
  *   tempv4 - holds J_relax, the Jacobian of the relaxation function
+ *
+ * The quadratic solver uses tempv3 to hold the Hessian action H delta_y.
  * ---------------------------------------------------------------------------*/
 
 #include <stdarg.h>
@@ -331,6 +333,68 @@ static int arkRelaxBrentSolve(ARKodeMem ark_mem)
   return ARK_RELAX_SOLVE_RECV;
 }
 
+/* Solve the relaxation residual equation for a quadratic relaxation function.
+   Along the step direction the relaxation function is
+
+     e(y_n + r delta_y) = e(y_n) + r J(y_n) . delta_y
+                          + r^2 / 2 delta_y . H delta_y
+
+   so the nonzero root of the residual is given in closed form and requires a
+   single reduction (or two without the local reduction operations). */
+static int arkRelaxQuadraticSolve(ARKodeMem ark_mem)
+{
+  int retval;
+  sunrealtype dots[2];
+  N_Vector delta_y = ark_mem->tempv2;
+  N_Vector H_relax = ark_mem->tempv3;
+  N_Vector J_relax = ark_mem->tempv4;
+  void* user_data  = ark_mem->user_data;
+
+  ARKodeRelaxMem relax_mem = ark_mem->relax_mem;
+
+  if (!(relax_mem->relax_hess_fn))
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKODE", "arkRelaxQuadraticSolve",
+                    "The relaxation Hessian function is NULL.");
+    return ARK_ILL_INPUT;
+  }
+
+  /* Evaluate Jacobian of entropy function at y_n */
+  retval = relax_mem->relax_jac_fn(ark_mem->yn, J_relax, user_data);
+  relax_mem->num_relax_jac_evals++;
+  if (retval < 0) { return ARK_RELAX_JAC_FAIL; }
+  if (retval > 0) { return ARK_RELAX_JAC_RECV; }
+
+  /* Evaluate Hessian of entropy function at y_n applied to delta_y */
+  retval = relax_mem->relax_hess_fn(ark_mem->yn, delta_y, H_relax, user_data);
+  relax_mem->num_relax_hess_evals++;
+  if (retval < 0) { return ARK_RELAX_JAC_FAIL; }
+  if (retval > 0) { return ARK_RELAX_JAC_RECV; }
+
+  /* Compute J(y_n) . delta_y and delta_y . H delta_y */
+  if (delta_y->ops->nvdotprodlocal && delta_y->ops->nvdotprodmultiallreduce)
+  {
+    dots[0] = N_VDotProdLocal(J_relax, delta_y);
+    dots[1] = N_VDotProdLocal(H_relax, delta_y);
+    retval  = N_VDotProdMultiAllReduce(2, delta_y, dots);
+    if (retval) { return ARK_VECTOROP_ERR; }
+  }
+  else
+  {
+    dots[0] = N_VDotProd(J_relax, delta_y);
+    dots[1] = N_VDotProd(H_relax, delta_y);
+  }
+
+  /* The relaxation function does not change along the step direction */
+  if (dots[1] == ZERO) { return ARK_RELAX_SOLVE_RECV; }
+
+  relax_mem->relax_param = TWO * (relax_mem->delta_e - dots[0]) / dots[1];
+  relax_mem->res         = ZERO;
+  relax_mem->nls_iters++;
+
+  return ARK_SUCCESS;
+}
+
 /* Compute and apply relaxation parameter */
 int arkRelaxSolve(ARKodeMem ark_mem, ARKodeRelaxMem relax_mem,
                   sunrealtype* relax_val_out)
@@ -348,12 +412,16 @@ int arkRelaxSolve(ARKodeMem ark_mem, ARKodeRelaxMem relax_mem,
   retval = relax_mem->delta_y_fn(ark_mem, ark_mem->tempv2);
   if (retval) return retval;
 
-  /* Store the current relaxation function value */
-  retval = relax_mem->relax_fn(ark_mem->yn, &(relax_mem->e_old),
-                               ark_mem->user_data);
-  relax_mem->num_relax_fn_evals++;
-  if (retval < 0) { return ARK_RELAX_FUNC_FAIL; }
-  if (retval > 0) { return ARK_RELAX_FUNC_RECV; }
+  /* Store the current relaxation function value (not needed by the
+     quadratic solver) */
+  if (relax_mem->solver != ARK_RELAX_QUADRATIC)
+  {
+    retval = relax_mem->relax_fn(ark_mem->yn, &(relax_mem->e_old),
+                                 ark_mem->user_data);
+    relax_mem->num_relax_fn_evals++;
+    if (retval < 0) { return ARK_RELAX_FUNC_FAIL; }
+    if (retval > 0) { return ARK_RELAX_FUNC_RECV; }
+  }
 
   /* Initial guess for relaxation parameter */
   relax_mem->relax_param = relax_mem->relax_param_prev;
@@ -366,6 +434,9 @@ int arkRelaxSolve(ARKodeMem ark_mem, ARKodeRelaxMem relax_mem,
   case(ARK_RELAX_NEWTON):
     retval = arkRelaxNewtonSolve(ark_mem);
     break;
+  case(ARK_RELAX_QUADRATIC):
+    retval = arkRelaxQuadraticSolve(ark_mem);
+    break;
   default:
     return ARK_ILL_INPUT;
     break;
@@ -403,6 +474,21 @@ int arkRelaxSolve(ARKodeMem ark_mem, ARKodeRelaxMem relax_mem,
  * Set functions
  * ---------------------------------------------------------------------------*/
 
+int arkRelaxSetHessFn(void* arkode_mem, ARKRelaxHessFn relax_hess_fn)
+{
+  int retval;
+  ARKodeMem ark_mem;
+  ARKodeRelaxMem relax_mem;
+
+  retval = arkRelaxAccessMem(arkode_mem, "arkRelaxSetHessFn", &ark_mem,
+                             &relax_mem);
+  if (retval) return retval;
+
+  relax_mem->relax_hess_fn = relax_hess_fn;
+
+  return ARK_SUCCESS;
+}
+
 int arkRelaxSetEtaFail(void* arkode_mem, sunrealtype eta_fail)
 {
   int retval;
@@ -477,7 +563,8 @@ int arkRelaxSetSolver(void* arkode_mem, ARKRelaxSolver solver)
                              &relax_mem);
   if (retval) return retval;
 
-  if (solver != ARK_RELAX_BRENT && solver != ARK_RELAX_NEWTON)
+  if (solver != ARK_RELAX_BRENT && solver != ARK_RELAX_NEWTON &&
+      solver != ARK_RELAX_QUADRATIC)
   {
     arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKODE", "arkRelaxSetSolver",
                     "An invalid relaxation solver option was provided.");
@@ -574,6 +661,21 @@ int arkRelaxGetNumRelaxJacEvals(void* arkode_mem, long int* J_evals)
   return ARK_SUCCESS;
 }
 
+int arkRelaxGetNumRelaxHessEvals(void* arkode_mem, long int* H_evals)
+{
+  int retval;
+  ARKodeMem ark_mem;
+  ARKodeRelaxMem relax_mem;
+
+  retval = arkRelaxAccessMem(arkode_mem, "arkRelaxGetNumRelaxHessEvals",
+                             &ark_mem, &relax_mem);
+  if (retval) return retval;
+
+  *H_evals = relax_mem->num_relax_hess_evals;
+
+  return ARK_SUCCESS;
+}
+
 int arkRelaxGetNumRelaxFails(void* arkode_mem, long int* relax_fails)
 {
   int retval;
@@ -651,6 +753,11 @@ int arkRelaxPrintAllStats(void* arkode_mem, FILE* outfile, SUNOutputFormat fmt)
             relax_mem->num_relax_fn_evals);
     fprintf(outfile, "Relax Jac evals              = %ld\n",
             relax_mem->num_relax_jac_evals);
+    if (relax_mem->relax_hess_fn)
+    {
+      fprintf(outfile, "Relax Hess evals             = %ld\n",
+              relax_mem->num_relax_hess_evals);
+    }
     fprintf(outfile, "Relax fails                  = %ld\n",
             relax_mem->num_fails);
     fprintf(outfile, "Relax bound fails            = %ld\n",
@@ -663,6 +770,10 @@ int arkRelaxPrintAllStats(void* arkode_mem, FILE* outfile, SUNOutputFormat fmt)
   case SUN_OUTPUTFORMAT_CSV:
     fprintf(outfile, ",Relax fn evals,%ld", relax_mem->num_relax_fn_evals);
     fprintf(outfile, ",Relax Jac evals,%ld", relax_mem->num_relax_jac_evals);
+    if (relax_mem->relax_hess_fn)
+    {
+      fprintf(outfile, ",Relax Hess evals,%ld", relax_mem->num_relax_hess_evals);
+    }
     fprintf(outfile, ",Relax fails,%ld", relax_mem->num_fails);
     fprintf(outfile, ",Relax bound fails,%ld", relax_mem->bound_fails);
     fprintf(outfile, ",Relax NLS iters,%ld", relax_mem->nls_iters);
@@ -750,7 +861,7 @@ int arkRelaxCreate(void* arkode_mem, ARKRelaxFn relax_fn,
 
     /* Update workspace sizes */
     ark_mem->lrw += 12;
-    ark_mem->liw += 14;
+    ark_mem->liw += 16;
   }
 
   /* Set function pointers */
@@ -69,6 +69,7 @@ struct ARKodeRelaxMemRec
   /* user-supplied and stepper supplied functions */
   ARKRelaxFn relax_fn;             /* user relaxation function ("entropy") */
   ARKRelaxJacFn relax_jac_fn;      /* user relaxation Jacobian             */
+  ARKRelaxHessFn relax_hess_fn;    /* user relaxation Hessian action       */
   ARKRelaxDeltaYFn delta_y_fn;     /* get delta y from stepper             */
   ARKRelaxDeltaEFn delta_e_fn;     /* get delta entropy from stepper       */
   ARKRelaxGetOrderFn get_order_fn; /* get the method order                 */
@@ -77,6 +78,7 @@ struct ARKodeRelaxMemRec
   int max_fails;                /* max allowed relax fails in a step   */
   long int num_relax_fn_evals;  /* counter for total function evals    */
   long int num_relax_jac_evals; /* counter for total jacobian evals    */
+  long int num_relax_hess_evals; /* counter for total Hessian evals   */
   long int num_fails;           /* counter for total relaxation fails  */
   sunrealtype e_old;            /* entropy at start of step y(t_{n-1}) */
   sunrealtype delta_e;          /* change in entropy                   */
@@ -113,6 +115,7 @@ int arkRelax(ARKodeMem ark_mem, int* relax_fails, sunrealtype* dsm_inout,
              int* nflag_out);
 
 /* User Functions */
+int arkRelaxSetHessFn(void* arkode_mem, ARKRelaxHessFn relax_hess_fn);
 int arkRelaxSetEtaFail(void* arkode_mem, sunrealtype eta_fail);
 int arkRelaxSetLowerBound(void* arkode_mem, sunrealtype lower);
 int arkRelaxSetMaxFails(void* arkode_mem, int max_fails);
@@ -124,6 +127,7 @@ int arkRelaxSetUpperBound(void* arkode_mem, sunrealtype upper);
 
 int arkRelaxGetNumRelaxFnEvals(void* arkode_mem, long int* r_evals);
 int arkRelaxGetNumRelaxJacEvals(void* arkode_mem, long int* j_evals);
+int arkRelaxGetNumRelaxHessEvals(void* arkode_mem, long int* h_evals);
 int arkRelaxGetNumRelaxFails(void* arkode_mem, long int* relax_fails);
 int arkRelaxGetNumRelaxBoundFails(void* arkode_mem, long int* fails);
 int arkRelaxGetNumRelaxSolveFails(void* arkode_mem, long int* fails);
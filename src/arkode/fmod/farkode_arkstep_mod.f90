@@ -99,6 +99,7 @@ module farkode_arkstep_mod
  public :: FARKStepSetFixedStepBounds
  public :: FARKStepSetAdaptivityMethod
  public :: FARKStepSetAdaptivityFn
+ public :: FARKStepSetAdaptController
  public :: FARKStepSetMaxFirstGrowth
  public :: FARKStepSetMaxEFailGrowth
  public :: FARKStepSetSmallNumEFails
@@ -134,6 +135,7 @@ module farkode_arkstep_mod
  public :: FARKStepSetPostprocessStageFn
  public :: FARKStepSetStagePredictFn
  public :: FARKStepSetJacFn
+ public :: FARKStepSetJacSparsityPattern
  public :: FARKStepSetMassFn
  public :: FARKStepSetJacEvalFrequency
  public :: FARKStepSetLinearSolutionScaling
@@ -214,6 +216,7 @@ module farkode_arkstep_mod
  public :: FARKStepPrintMem
  public :: FARKStepCreateMRIStepInnerStepper
  public :: FARKStepSetRelaxFn
+ public :: FARKStepSetRelaxHessFn
  public :: FARKStepSetRelaxEtaFail
  public :: FARKStepSetRelaxLowerBound
  public :: FARKStepSetRelaxMaxFails
@@ -224,6 +227,7 @@ module farkode_arkstep_mod
  public :: FARKStepSetRelaxUpperBound
  public :: FARKStepGetNumRelaxFnEvals
  public :: FARKStepGetNumRelaxJacEvals
+ public :: FARKStepGetNumRelaxHessEvals
  public :: FARKStepGetNumRelaxFails
  public :: FARKStepGetNumRelaxBoundFails
  public :: FARKStepGetNumRelaxSolveFails
@@ -595,6 +599,15 @@ type(C_PTR), value :: farg3
 integer(C_INT) :: fresult
 end function
 
+function swigc_FARKStepSetAdaptController(farg1, farg2) &
+bind(C, name="_wrap_FARKStepSetAdaptController") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FARKStepSetMaxFirstGrowth(farg1, farg2) &
 bind(C, name="_wrap_FARKStepSetMaxFirstGrowth") &
 result(fresult)
@@ -910,6 +923,15 @@ type(C_FUNPTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FARKStepSetJacSparsityPattern(farg1, farg2) &
+bind(C, name="_wrap_FARKStepSetJacSparsityPattern") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FARKStepSetMassFn(farg1, farg2) &
 bind(C, name="_wrap_FARKStepSetMassFn") &
 result(fresult)
@@ -1665,6 +1687,15 @@ type(C_FUNPTR), value :: farg3
 integer(C_INT) :: fresult
 end function
 
+function swigc_FARKStepSetRelaxHessFn(farg1, farg2) &
+bind(C, name="_wrap_FARKStepSetRelaxHessFn") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_FUNPTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FARKStepSetRelaxEtaFail(farg1, farg2) &
 bind(C, name="_wrap_FARKStepSetRelaxEtaFail") &
 result(fresult)
@@ -1756,6 +1787,15 @@ type(C_PTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FARKStepGetNumRelaxHessEvals(farg1, farg2) &
+bind(C, name="_wrap_FARKStepGetNumRelaxHessEvals") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FARKStepGetNumRelaxFails(farg1, farg2) &
 bind(C, name="_wrap_FARKStepGetNumRelaxFails") &
 result(fresult)
@@ -2488,6 +2528,22 @@ fresult = swigc_FARKStepSetAdaptivityFn(farg1, farg2, farg3)
 swig_result = fresult
 end function
 
+function FARKStepSetAdaptController(arkode_mem, c) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+type(C_PTR) :: c
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c
+fresult = swigc_FARKStepSetAdaptController(farg1, farg2)
+swig_result = fresult
+end function
+
 function FARKStepSetMaxFirstGrowth(arkode_mem, etamx1) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -3048,6 +3104,22 @@ fresult = swigc_FARKStepSetJacFn(farg1, farg2)
 swig_result = fresult
 end function
 
+function FARKStepSetJacSparsityPattern(arkode_mem, p) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+type(SUNMatrix), target, intent(inout) :: p
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c_loc(p)
+fresult = swigc_FARKStepSetJacSparsityPattern(farg1, farg2)
+swig_result = fresult
+end function
+
 function FARKStepSetMassFn(arkode_mem, mass) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -4433,6 +4505,22 @@ fresult = swigc_FARKStepSetRelaxFn(farg1, farg2, farg3)
 swig_result = fresult
 end function
 
+function FARKStepSetRelaxHessFn(arkode_mem, rhess) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+type(C_FUNPTR), intent(in), value :: rhess
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_FUNPTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = rhess
+fresult = swigc_FARKStepSetRelaxHessFn(farg1, farg2)
+swig_result = fresult
+end function
+
 function FARKStepSetRelaxEtaFail(arkode_mem, eta_rf) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -4596,6 +4684,22 @@ fresult = swigc_FARKStepGetNumRelaxJacEvals(farg1, farg2)
 swig_result = fresult
 end function
 
+function FARKStepGetNumRelaxHessEvals(arkode_mem, H_evals) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+integer(C_LONG), dimension(*), target, intent(inout) :: H_evals
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c_loc(H_evals(1))
+fresult = swigc_FARKStepGetNumRelaxHessEvals(farg1, farg2)
+swig_result = fresult
+end function
+
 function FARKStepGetNumRelaxFails(arkode_mem, relax_fails) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
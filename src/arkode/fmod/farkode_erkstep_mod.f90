@@ -73,6 +73,7 @@ module farkode_erkstep_mod
  public :: FERKStepSetFixedStepBounds
  public :: FERKStepSetAdaptivityMethod
  public :: FERKStepSetAdaptivityFn
+ public :: FERKStepSetAdaptController
  public :: FERKStepSetMaxFirstGrowth
  public :: FERKStepSetMaxEFailGrowth
  public :: FERKStepSetSmallNumEFails
@@ -127,6 +128,7 @@ module farkode_erkstep_mod
  public :: FERKStepFree
  public :: FERKStepPrintMem
  public :: FERKStepSetRelaxFn
+ public :: FERKStepSetRelaxHessFn
  public :: FERKStepSetRelaxEtaFail
  public :: FERKStepSetRelaxLowerBound
  public :: FERKStepSetRelaxMaxFails
@@ -137,6 +139,7 @@ module farkode_erkstep_mod
  public :: FERKStepSetRelaxUpperBound
  public :: FERKStepGetNumRelaxFnEvals
  public :: FERKStepGetNumRelaxJacEvals
+ public :: FERKStepGetNumRelaxHessEvals
  public :: FERKStepGetNumRelaxFails
  public :: FERKStepGetNumRelaxBoundFails
  public :: FERKStepGetNumRelaxSolveFails
@@ -377,6 +380,15 @@ type(C_PTR), value :: farg3
 integer(C_INT) :: fresult
 end function
 
+function swigc_FERKStepSetAdaptController(farg1, farg2) &
+bind(C, name="_wrap_FERKStepSetAdaptController") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FERKStepSetMaxFirstGrowth(farg1, farg2) &
 bind(C, name="_wrap_FERKStepSetMaxFirstGrowth") &
 result(fresult)
@@ -879,6 +891,15 @@ type(C_FUNPTR), value :: farg3
 integer(C_INT) :: fresult
 end function
 
+function swigc_FERKStepSetRelaxHessFn(farg1, farg2) &
+bind(C, name="_wrap_FERKStepSetRelaxHessFn") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_FUNPTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FERKStepSetRelaxEtaFail(farg1, farg2) &
 bind(C, name="_wrap_FERKStepSetRelaxEtaFail") &
 result(fresult)
@@ -970,6 +991,15 @@ type(C_PTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FERKStepGetNumRelaxHessEvals(farg1, farg2) &
+bind(C, name="_wrap_FERKStepGetNumRelaxHessEvals") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FERKStepGetNumRelaxFails(farg1, farg2) &
 bind(C, name="_wrap_FERKStepGetNumRelaxFails") &
 result(fresult)
@@ -1462,6 +1492,22 @@ fresult = swigc_FERKStepSetAdaptivityFn(farg1, farg2, farg3)
 swig_result = fresult
 end function
 
+function FERKStepSetAdaptController(arkode_mem, c) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+type(C_PTR) :: c
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c
+fresult = swigc_FERKStepSetAdaptController(farg1, farg2)
+swig_result = fresult
+end function
+
 function FERKStepSetMaxFirstGrowth(arkode_mem, etamx1) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -2375,6 +2421,22 @@ fresult = swigc_FERKStepSetRelaxFn(farg1, farg2, farg3)
 swig_result = fresult
 end function
 
+function FERKStepSetRelaxHessFn(arkode_mem, rhess) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+type(C_FUNPTR), intent(in), value :: rhess
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_FUNPTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = rhess
+fresult = swigc_FERKStepSetRelaxHessFn(farg1, farg2)
+swig_result = fresult
+end function
+
 function FERKStepSetRelaxEtaFail(arkode_mem, eta_rf) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -2538,6 +2600,22 @@ fresult = swigc_FERKStepGetNumRelaxJacEvals(farg1, farg2)
 swig_result = fresult
 end function
 
+function FERKStepGetNumRelaxHessEvals(arkode_mem, H_evals) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+integer(C_LONG), dimension(*), target, intent(inout) :: H_evals
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c_loc(H_evals(1))
+fresult = swigc_FERKStepGetNumRelaxHessEvals(farg1, farg2)
+swig_result = fresult
+end function
+
 function FERKStepGetNumRelaxFails(arkode_mem, relax_fails) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -104,14 +104,16 @@ module farkode_mod
  integer(C_INT), parameter, public :: ARK_RELAX_MEM_NULL = -44_C_INT
  integer(C_INT), parameter, public :: ARK_RELAX_FUNC_FAIL = -45_C_INT
  integer(C_INT), parameter, public :: ARK_RELAX_JAC_FAIL = -46_C_INT
+ integer(C_INT), parameter, public :: ARK_CONTROLLER_ERR = -47_C_INT
  integer(C_INT), parameter, public :: ARK_UNRECOGNIZED_ERROR = -99_C_INT
  ! typedef enum ARKRelaxSolver
  enum, bind(c)
   enumerator :: ARK_RELAX_BRENT
   enumerator :: ARK_RELAX_NEWTON
+  enumerator :: ARK_RELAX_QUADRATIC
  end enum
  integer, parameter, public :: ARKRelaxSolver = kind(ARK_RELAX_BRENT)
- public :: ARK_RELAX_BRENT, ARK_RELAX_NEWTON
+ public :: ARK_RELAX_BRENT, ARK_RELAX_NEWTON, ARK_RELAX_QUADRATIC
  public :: FARKBandPrecInit
  public :: FARKBandPrecGetWorkSpace
  public :: FARKBandPrecGetNumRhsEvals
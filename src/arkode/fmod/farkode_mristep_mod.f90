@@ -126,6 +126,7 @@ module farkode_mristep_mod
  public :: FMRIStepCoupling_LoadTableByName
  public :: FMRIStepCoupling_Alloc
  public :: FMRIStepCoupling_Create
+ public :: FMRIStepCoupling_CreateEmbedded
  public :: FMRIStepCoupling_MIStoMRI
  public :: FMRIStepCoupling_Copy
  public :: FMRIStepCoupling_Space
@@ -163,6 +164,12 @@ module farkode_mristep_mod
  public :: FMRIStepSetInterpolateStopTime
  public :: FMRIStepClearStopTime
  public :: FMRIStepSetFixedStep
+ public :: FMRIStepSetInitStep
+ public :: FMRIStepSetMinStep
+ public :: FMRIStepSetMaxStep
+ public :: FMRIStepSetMaxErrTestFails
+ public :: FMRIStepSetAdaptController
+ public :: FMRIStepSetFastStepBudget
  public :: FMRIStepSetRootDirection
  public :: FMRIStepSetNoInactiveRootWarn
  public :: FMRIStepSetErrHandlerFn
@@ -176,6 +183,7 @@ module farkode_mristep_mod
  public :: FMRIStepSetStagePredictFn
  public :: FMRIStepSetDeduceImplicitRhs
  public :: FMRIStepSetJacFn
+ public :: FMRIStepSetJacSparsityPattern
  public :: FMRIStepSetJacEvalFrequency
  public :: FMRIStepSetLinearSolutionScaling
  public :: FMRIStepSetEpsLin
@@ -192,6 +200,12 @@ module farkode_mristep_mod
  public :: FMRIStepGetCurrentCoupling
  public :: FMRIStepGetWorkSpace
  public :: FMRIStepGetNumSteps
+ public :: FMRIStepGetNumStepAttempts
+ public :: FMRIStepGetNumErrTestFails
+ public :: FMRIStepGetActualInitStep
+ public :: FMRIStepGetCurrentStep
+ public :: FMRIStepGetStepStats
+ public :: FMRIStepGetFastStepStats
  public :: FMRIStepGetLastStep
  public :: FMRIStepGetCurrentTime
  public :: FMRIStepGetCurrentState
@@ -234,6 +248,10 @@ module farkode_mristep_mod
  public :: FMRIStepInnerStepper_SetEvolveFn
  public :: FMRIStepInnerStepper_SetFullRhsFn
  public :: FMRIStepInnerStepper_SetResetFn
+ public :: FMRIStepInnerStepper_SetFixedStepFn
+ public :: FMRIStepInnerStepper_SetAccumulatedErrorGetFn
+ public :: FMRIStepInnerStepper_SetAccumulatedErrorResetFn
+ public :: FMRIStepInnerStepper_SetEmbeddingOrderGetFn
  public :: FMRIStepInnerStepper_AddForcing
  public :: FMRIStepInnerStepper_GetForcingData
 
@@ -422,6 +440,20 @@ type(C_PTR), value :: farg7
 type(C_PTR) :: fresult
 end function
 
+function swigc_FMRIStepCoupling_CreateEmbedded(farg1, farg2, farg3, farg4, farg5, farg6, farg7) &
+bind(C, name="_wrap_FMRIStepCoupling_CreateEmbedded") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT), intent(in) :: farg1
+integer(C_INT), intent(in) :: farg2
+integer(C_INT), intent(in) :: farg3
+integer(C_INT), intent(in) :: farg4
+type(C_PTR), value :: farg5
+type(C_PTR), value :: farg6
+type(C_PTR), value :: farg7
+type(C_PTR) :: fresult
+end function
+
 function swigc_FMRIStepCoupling_MIStoMRI(farg1, farg2, farg3) &
 bind(C, name="_wrap_FMRIStepCoupling_MIStoMRI") &
 result(fresult)
@@ -761,6 +793,61 @@ real(C_DOUBLE), intent(in) :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FMRIStepSetInitStep(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepSetInitStep") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+real(C_DOUBLE), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepSetMinStep(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepSetMinStep") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+real(C_DOUBLE), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepSetMaxStep(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepSetMaxStep") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+real(C_DOUBLE), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepSetMaxErrTestFails(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepSetMaxErrTestFails") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepSetAdaptController(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepSetAdaptController") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepSetFastStepBudget(farg1, farg2, farg3) &
+bind(C, name="_wrap_FMRIStepSetFastStepBudget") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+integer(C_INT), intent(in) :: farg3
+integer(C_INT) :: fresult
+end function
+
 function swigc_FMRIStepSetRootDirection(farg1, farg2) &
 bind(C, name="_wrap_FMRIStepSetRootDirection") &
 result(fresult)
@@ -878,6 +965,15 @@ type(C_FUNPTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FMRIStepSetJacSparsityPattern(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepSetJacSparsityPattern") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FMRIStepSetJacEvalFrequency(farg1, farg2) &
 bind(C, name="_wrap_FMRIStepSetJacEvalFrequency") &
 result(fresult)
@@ -1032,6 +1128,66 @@ type(C_PTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FMRIStepGetNumStepAttempts(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepGetNumStepAttempts") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepGetNumErrTestFails(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepGetNumErrTestFails") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepGetActualInitStep(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepGetActualInitStep") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepGetCurrentStep(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepGetCurrentStep") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepGetStepStats(farg1, farg2, farg3, farg4, farg5, farg6) &
+bind(C, name="_wrap_FMRIStepGetStepStats") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+type(C_PTR), value :: farg3
+type(C_PTR), value :: farg4
+type(C_PTR), value :: farg5
+type(C_PTR), value :: farg6
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepGetFastStepStats(farg1, farg2, farg3, farg4) &
+bind(C, name="_wrap_FMRIStepGetFastStepStats") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+type(C_PTR), value :: farg3
+type(C_PTR), value :: farg4
+integer(C_INT) :: fresult
+end function
+
 function swigc_FMRIStepGetLastStep(farg1, farg2) &
 bind(C, name="_wrap_FMRIStepGetLastStep") &
 result(fresult)
@@ -1418,6 +1574,42 @@ type(C_FUNPTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FMRIStepInnerStepper_SetFixedStepFn(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepInnerStepper_SetFixedStepFn") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_FUNPTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepInnerStepper_SetAccumulatedErrorGetFn(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepInnerStepper_SetAccumulatedErrorGetFn") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_FUNPTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepInnerStepper_SetAccumulatedErrorResetFn(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepInnerStepper_SetAccumulatedErrorResetFn") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_FUNPTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FMRIStepInnerStepper_SetEmbeddingOrderGetFn(farg1, farg2) &
+bind(C, name="_wrap_FMRIStepInnerStepper_SetEmbeddingOrderGetFn") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_FUNPTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FMRIStepInnerStepper_AddForcing(farg1, farg2, farg3) &
 bind(C, name="_wrap_FMRIStepInnerStepper_AddForcing") &
 result(fresult)
@@ -1752,6 +1944,37 @@ fresult = swigc_FMRIStepCoupling_Create(farg1, farg2, farg3, farg4, farg5, farg6
 swig_result = fresult
 end function
 
+function FMRIStepCoupling_CreateEmbedded(nmat, stages, q, p, w, g, c) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR) :: swig_result
+integer(C_INT), intent(in) :: nmat
+integer(C_INT), intent(in) :: stages
+integer(C_INT), intent(in) :: q
+integer(C_INT), intent(in) :: p
+real(C_DOUBLE), dimension(*), target, intent(inout) :: w
+real(C_DOUBLE), dimension(*), target, intent(inout) :: g
+real(C_DOUBLE), dimension(*), target, intent(inout) :: c
+type(C_PTR) :: fresult 
+integer(C_INT) :: farg1 
+integer(C_INT) :: farg2 
+integer(C_INT) :: farg3 
+integer(C_INT) :: farg4 
+type(C_PTR) :: farg5 
+type(C_PTR) :: farg6 
+type(C_PTR) :: farg7 
+
+farg1 = nmat
+farg2 = stages
+farg3 = q
+farg4 = p
+farg5 = c_loc(w(1))
+farg6 = c_loc(g(1))
+farg7 = c_loc(c(1))
+fresult = swigc_FMRIStepCoupling_CreateEmbedded(farg1, farg2, farg3, farg4, farg5, farg6, farg7)
+swig_result = fresult
+end function
+
 function FMRIStepCoupling_MIStoMRI(b, q, p) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -2368,6 +2591,105 @@ fresult = swigc_FMRIStepSetFixedStep(farg1, farg2)
 swig_result = fresult
 end function
 
+function FMRIStepSetInitStep(arkode_mem, hin) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+real(C_DOUBLE), intent(in) :: hin
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+real(C_DOUBLE) :: farg2 
+
+farg1 = arkode_mem
+farg2 = hin
+fresult = swigc_FMRIStepSetInitStep(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepSetMinStep(arkode_mem, hmin) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+real(C_DOUBLE), intent(in) :: hmin
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+real(C_DOUBLE) :: farg2 
+
+farg1 = arkode_mem
+farg2 = hmin
+fresult = swigc_FMRIStepSetMinStep(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepSetMaxStep(arkode_mem, hmax) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+real(C_DOUBLE), intent(in) :: hmax
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+real(C_DOUBLE) :: farg2 
+
+farg1 = arkode_mem
+farg2 = hmax
+fresult = swigc_FMRIStepSetMaxStep(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepSetMaxErrTestFails(arkode_mem, maxnef) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+integer(C_INT), intent(in) :: maxnef
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+
+farg1 = arkode_mem
+farg2 = maxnef
+fresult = swigc_FMRIStepSetMaxErrTestFails(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepSetAdaptController(arkode_mem, c) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+type(C_PTR) :: c
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c
+fresult = swigc_FMRIStepSetAdaptController(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepSetFastStepBudget(arkode_mem, budget, max_budget) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+integer(C_INT), intent(in) :: budget
+integer(C_INT), intent(in) :: max_budget
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+integer(C_INT) :: farg3 
+
+farg1 = arkode_mem
+farg2 = budget
+farg3 = max_budget
+fresult = swigc_FMRIStepSetFastStepBudget(farg1, farg2, farg3)
+swig_result = fresult
+end function
+
 function FMRIStepSetRootDirection(arkode_mem, rootdir) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -2576,6 +2898,22 @@ fresult = swigc_FMRIStepSetJacFn(farg1, farg2)
 swig_result = fresult
 end function
 
+function FMRIStepSetJacSparsityPattern(arkode_mem, p) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+type(SUNMatrix), target, intent(inout) :: p
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c_loc(p)
+fresult = swigc_FMRIStepSetJacSparsityPattern(farg1, farg2)
+swig_result = fresult
+end function
+
 function FMRIStepSetJacEvalFrequency(arkode_mem, msbj) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -2862,6 +3200,120 @@ fresult = swigc_FMRIStepGetNumSteps(farg1, farg2)
 swig_result = fresult
 end function
 
+function FMRIStepGetNumStepAttempts(arkode_mem, nstep_attempts) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+integer(C_LONG), dimension(*), target, intent(inout) :: nstep_attempts
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c_loc(nstep_attempts(1))
+fresult = swigc_FMRIStepGetNumStepAttempts(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepGetNumErrTestFails(arkode_mem, netfails) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+integer(C_LONG), dimension(*), target, intent(inout) :: netfails
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c_loc(netfails(1))
+fresult = swigc_FMRIStepGetNumErrTestFails(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepGetActualInitStep(arkode_mem, hinused) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+real(C_DOUBLE), dimension(*), target, intent(inout) :: hinused
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c_loc(hinused(1))
+fresult = swigc_FMRIStepGetActualInitStep(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepGetCurrentStep(arkode_mem, hcur) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+real(C_DOUBLE), dimension(*), target, intent(inout) :: hcur
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = arkode_mem
+farg2 = c_loc(hcur(1))
+fresult = swigc_FMRIStepGetCurrentStep(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepGetStepStats(arkode_mem, nssteps, hinused, hlast, hcur, tcur) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+integer(C_LONG), dimension(*), target, intent(inout) :: nssteps
+real(C_DOUBLE), dimension(*), target, intent(inout) :: hinused
+real(C_DOUBLE), dimension(*), target, intent(inout) :: hlast
+real(C_DOUBLE), dimension(*), target, intent(inout) :: hcur
+real(C_DOUBLE), dimension(*), target, intent(inout) :: tcur
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+type(C_PTR) :: farg3 
+type(C_PTR) :: farg4 
+type(C_PTR) :: farg5 
+type(C_PTR) :: farg6 
+
+farg1 = arkode_mem
+farg2 = c_loc(nssteps(1))
+farg3 = c_loc(hinused(1))
+farg4 = c_loc(hlast(1))
+farg5 = c_loc(hcur(1))
+farg6 = c_loc(tcur(1))
+fresult = swigc_FMRIStepGetStepStats(farg1, farg2, farg3, farg4, farg5, farg6)
+swig_result = fresult
+end function
+
+function FMRIStepGetFastStepStats(arkode_mem, budget, fast_err, nfast_fails) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: arkode_mem
+integer(C_INT), dimension(*), target, intent(inout) :: budget
+real(C_DOUBLE), dimension(*), target, intent(inout) :: fast_err
+integer(C_LONG), dimension(*), target, intent(inout) :: nfast_fails
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+type(C_PTR) :: farg3 
+type(C_PTR) :: farg4 
+
+farg1 = arkode_mem
+farg2 = c_loc(budget(1))
+farg3 = c_loc(fast_err(1))
+farg4 = c_loc(nfast_fails(1))
+fresult = swigc_FMRIStepGetFastStepStats(farg1, farg2, farg3, farg4)
+swig_result = fresult
+end function
+
 function FMRIStepGetLastStep(arkode_mem, hlast) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -3557,6 +4009,70 @@ fresult = swigc_FMRIStepInnerStepper_SetResetFn(farg1, farg2)
 swig_result = fresult
 end function
 
+function FMRIStepInnerStepper_SetFixedStepFn(stepper, fn) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: stepper
+type(C_FUNPTR), intent(in), value :: fn
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_FUNPTR) :: farg2 
+
+farg1 = stepper
+farg2 = fn
+fresult = swigc_FMRIStepInnerStepper_SetFixedStepFn(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepInnerStepper_SetAccumulatedErrorGetFn(stepper, fn) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: stepper
+type(C_FUNPTR), intent(in), value :: fn
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_FUNPTR) :: farg2 
+
+farg1 = stepper
+farg2 = fn
+fresult = swigc_FMRIStepInnerStepper_SetAccumulatedErrorGetFn(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepInnerStepper_SetAccumulatedErrorResetFn(stepper, fn) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: stepper
+type(C_FUNPTR), intent(in), value :: fn
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_FUNPTR) :: farg2 
+
+farg1 = stepper
+farg2 = fn
+fresult = swigc_FMRIStepInnerStepper_SetAccumulatedErrorResetFn(farg1, farg2)
+swig_result = fresult
+end function
+
+function FMRIStepInnerStepper_SetEmbeddingOrderGetFn(stepper, fn) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: stepper
+type(C_FUNPTR), intent(in), value :: fn
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_FUNPTR) :: farg2 
+
+farg1 = stepper
+farg2 = fn
+fresult = swigc_FMRIStepInnerStepper_SetEmbeddingOrderGetFn(farg1, farg2)
+swig_result = fresult
+end function
+
 function FMRIStepInnerStepper_AddForcing(stepper, t, f) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -134,6 +134,7 @@ static void cvFreeVectors(CVodeMem cv_mem);
 
 static int cvEwtSetSS(CVodeMem cv_mem, N_Vector ycur, N_Vector weight);
 static int cvEwtSetSV(CVodeMem cv_mem, N_Vector ycur, N_Vector weight);
+static int cvInvPositive(N_Vector tempv, N_Vector weight, booleantype test);
 
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
 extern
@@ -184,6 +185,8 @@ static void cvSetTqBDF(CVodeMem cv_mem, realtype hsum, realtype alpha0,
 /* Nonlinear solver functions */
 
 static int cvNls(CVodeMem cv_mem, int nflag);
+static booleantype cvUseFusedNorms(CVodeMem cv_mem);
+static void cvFusedNorms(CVodeMem cv_mem, realtype acsum);
 
 static int cvCheckConstraints(CVodeMem cv_mem);
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
@@ -369,8 +372,10 @@ void *CVodeCreate(int lmm, SUNContext sunctx)
   cv_mem->NLS    = NULL;
   cv_mem->ownNLS = SUNFALSE;
 
-  /* Initialize fused operations variable */
-  cv_mem->cv_usefused = SUNFALSE;
+  /* Initialize fused operations variables */
+  cv_mem->cv_usefused     = SUNFALSE;
+  cv_mem->cv_usefusedhost = SUNFALSE;
+  cv_mem->cv_znblock      = NULL;
 
   /* Return pointer to CVODE memory block */
 
@@ -514,6 +519,7 @@ int CVodeInit(void *cvode_mem, CVRhsFn f, realtype t0, N_Vector y0)
   cv_mem->cv_nfe     = 0;
   cv_mem->cv_ncfn    = 0;
   cv_mem->cv_netf    = 0;
+  cv_mem->cv_nreduce = 0;
   cv_mem->cv_nni     = 0;
   cv_mem->cv_nnf     = 0;
   cv_mem->cv_nsetups = 0;
@@ -620,6 +626,7 @@ int CVodeReInit(void *cvode_mem, realtype t0, N_Vector y0)
   cv_mem->cv_nfe     = 0;
   cv_mem->cv_ncfn    = 0;
   cv_mem->cv_netf    = 0;
+  cv_mem->cv_nreduce = 0;
   cv_mem->cv_nni     = 0;
   cv_mem->cv_nnf     = 0;
   cv_mem->cv_nsetups = 0;
@@ -1796,6 +1803,11 @@ static void cvFreeVectors(CVodeMem cv_mem)
   N_VDestroy(cv_mem->cv_vtemp3);
   for (j=0; j <= maxord; j++) N_VDestroy(cv_mem->cv_zn[j]);
 
+  if (cv_mem->cv_znblock != NULL) {
+    free(cv_mem->cv_znblock);
+    cv_mem->cv_znblock = NULL;
+  }
+
   cv_mem->cv_lrw -= (maxord + 8)*cv_mem->cv_lrw1;
   cv_mem->cv_liw -= (maxord + 8)*cv_mem->cv_liw1;
 
@@ -2354,10 +2366,15 @@ static void cvAdjustAdams(CVodeMem cv_mem, int deltaq)
   for (j=2; j < cv_mem->cv_q; j++)
     cv_mem->cv_cvals[j-2] = -cv_mem->cv_l[j];
 
-  if (cv_mem->cv_q > 2)
-    (void) N_VScaleAddMulti(cv_mem->cv_q-2, cv_mem->cv_cvals,
-                            cv_mem->cv_zn[cv_mem->cv_q],
-                            cv_mem->cv_zn+2, cv_mem->cv_zn+2);
+  if (cv_mem->cv_q > 2) {
+    if (cv_mem->cv_usefusedhost)
+      cvAdjustOrder_host(cv_mem->cv_q-2, cv_mem->cv_cvals, ONE,
+                         cv_mem->cv_zn[cv_mem->cv_q], NULL, cv_mem->cv_zn+2);
+    else
+      (void) N_VScaleAddMulti(cv_mem->cv_q-2, cv_mem->cv_cvals,
+                              cv_mem->cv_zn[cv_mem->cv_q],
+                              cv_mem->cv_zn+2, cv_mem->cv_zn+2);
+  }
 }
 
 /*
@@ -2415,6 +2432,15 @@ static void cvIncreaseBDF(CVodeMem cv_mem)
     }
   }
   A1 = (-alpha0 - alpha1) / prod;
+
+  /* set zn[L] and adjust zn[2],...,zn[q] in one sweep */
+  if (cv_mem->cv_usefusedhost) {
+    cvAdjustOrder_host(cv_mem->cv_q-1, cv_mem->cv_l+2, A1,
+                       cv_mem->cv_zn[cv_mem->cv_indx_acor],
+                       cv_mem->cv_zn[cv_mem->cv_L], cv_mem->cv_zn+2);
+    return;
+  }
+
   N_VScale(A1, cv_mem->cv_zn[cv_mem->cv_indx_acor],
            cv_mem->cv_zn[cv_mem->cv_L]);
 
@@ -2505,10 +2531,17 @@ static void cvPredict(CVodeMem cv_mem)
       cv_mem->cv_tn = cv_mem->cv_tstop;
   }
 
-  for (k = 1; k <= cv_mem->cv_q; k++)
-    for (j = cv_mem->cv_q; j >= k; j--)
-      N_VLinearSum(ONE, cv_mem->cv_zn[j-1], ONE,
-                   cv_mem->cv_zn[j], cv_mem->cv_zn[j-1]);
+  if (cv_mem->cv_usefusedhost)
+  {
+    cvPredict_host(cv_mem->cv_q, ONE, cv_mem->cv_zn);
+  }
+  else
+  {
+    for (k = 1; k <= cv_mem->cv_q; k++)
+      for (j = cv_mem->cv_q; j >= k; j--)
+        N_VLinearSum(ONE, cv_mem->cv_zn[j-1], ONE,
+                     cv_mem->cv_zn[j], cv_mem->cv_zn[j-1]);
+  }
 
 #ifdef SUNDIALS_LOGGING_EXTRA_DEBUG
   SUNLogger_QueueMsg(CV_LOGGER, SUN_LOGLEVEL_DEBUG,
@@ -2794,7 +2827,8 @@ static void cvSetTqBDF(CVodeMem cv_mem, realtype hsum, realtype alpha0,
 static int cvNls(CVodeMem cv_mem, int nflag)
 {
   int flag = CV_SUCCESS;
-  booleantype callSetup;
+  booleantype callSetup, fuse;
+  realtype acsum = ZERO;
   long int nni_inc = 0;
   long int nnf_inc = 0;
 
@@ -2842,9 +2876,19 @@ static int cvNls(CVodeMem cv_mem, int nflag)
   /* update the state based on the final correction from the nonlinear solver */
   N_VLinearSum(ONE, cv_mem->cv_zn[0], ONE, cv_mem->cv_acor, cv_mem->cv_y);
 
-  /* compute acnrm if is was not already done by the nonlinear solver */
-  if (!cv_mem->cv_acnrmcur)
-    cv_mem->cv_acnrm = N_VWrmsNorm(cv_mem->cv_acor, cv_mem->cv_ewt);
+  /* compute acnrm if is was not already done by the nonlinear solver. When
+     the order selection norms are needed after this step, only the local
+     part is computed here and the reduction is combined with theirs. */
+  cv_mem->cv_ordnrmcur = SUNFALSE;
+  fuse = cvUseFusedNorms(cv_mem);
+  if (!cv_mem->cv_acnrmcur) {
+    if (fuse) {
+      acsum = N_VWSqrSumLocal(cv_mem->cv_acor, cv_mem->cv_ewt);
+    } else {
+      cv_mem->cv_acnrm = N_VWrmsNorm(cv_mem->cv_acor, cv_mem->cv_ewt);
+      cv_mem->cv_nreduce++;
+    }
+  }
 
   /* update Jacobian status */
   cv_mem->cv_jcur = SUNFALSE;
@@ -2853,9 +2897,99 @@ static int cvNls(CVodeMem cv_mem, int nflag)
   if (cv_mem->cv_constraintsSet)
     flag = cvCheckConstraints(cv_mem);
 
+  /* compute acnrm and the order selection norms with one reduction */
+  if (fuse && flag == CV_SUCCESS) cvFusedNorms(cv_mem, acsum);
+
   return(flag);
 }
 
+/*
+ * cvUseFusedNorms
+ *
+ * This routine determines if the norms needed by cvComputeEtaqm1 and
+ * cvComputeEtaqp1 after a successful step should be computed in cvNls
+ * together with the norm of acor. This is the case when an order change
+ * will be considered (qwait = 1 before cvCompleteStep), the step is not
+ * projected, and the vector supports single buffer reductions.
+ */
+
+static booleantype cvUseFusedNorms(CVodeMem cv_mem)
+{
+  N_Vector acor = cv_mem->cv_acor;
+
+  if (cv_mem->cv_qwait != 1 || cv_mem->cv_etamax == ONE) return(SUNFALSE);
+  if (cv_mem->proj_enabled) return(SUNFALSE);
+  if ((cv_mem->cv_q == 1) && (cv_mem->cv_q == cv_mem->cv_qmax)) return(SUNFALSE);
+
+  return((acor->ops->nvwsqrsumlocal != NULL) &&
+         (acor->ops->nvdotprodmultiallreduce != NULL) &&
+         (acor->ops->nvgetlength != NULL));
+}
+
+/*
+ * cvFusedNorms
+ *
+ * This routine computes the norm of acor (unless the nonlinear solver
+ * already did so, acsum holds its local part otherwise) along with the
+ * norms used by cvComputeEtaqm1 and cvComputeEtaqp1 using a single global
+ * reduction. The vectors for the order selection norms are formed as they
+ * will be after cvCompleteStep updates zn and tau.
+ */
+
+static void cvFusedNorms(CVodeMem cv_mem, realtype acsum)
+{
+  int nvec, iac, iqm1, iqp1;
+  realtype sums[3], tau2, cquot, len;
+  N_Vector acor  = cv_mem->cv_acor;
+  N_Vector tempv = cv_mem->cv_tempv;
+
+  nvec = 0;
+  iac = iqm1 = iqp1 = -1;
+
+  if (!cv_mem->cv_acnrmcur) {
+    iac = nvec;
+    sums[nvec++] = acsum;
+  }
+
+  /* zn[q] after the correction in cvCompleteStep */
+  if (cv_mem->cv_q > 1) {
+    N_VLinearSum(cv_mem->cv_l[cv_mem->cv_q], acor, ONE,
+                 cv_mem->cv_zn[cv_mem->cv_q], tempv);
+    iqm1 = nvec;
+    sums[nvec++] = N_VWSqrSumLocal(tempv, cv_mem->cv_ewt);
+  }
+
+  /* acor - cquot zn[qmax] with tau[2] as shifted by cvCompleteStep */
+  if ((cv_mem->cv_q != cv_mem->cv_qmax) && (cv_mem->cv_saved_tq5 != ZERO)) {
+    tau2 = ((cv_mem->cv_q > 1) || (cv_mem->cv_nst > 0)) ?
+      cv_mem->cv_tau[1] : cv_mem->cv_tau[2];
+    cquot = (cv_mem->cv_tq[5] / cv_mem->cv_saved_tq5) *
+      SUNRpowerI(cv_mem->cv_h/tau2, cv_mem->cv_L);
+    N_VLinearSum(-cquot, cv_mem->cv_zn[cv_mem->cv_qmax], ONE, acor, tempv);
+    iqp1 = nvec;
+    sums[nvec++] = N_VWSqrSumLocal(tempv, cv_mem->cv_ewt);
+  }
+
+  if (nvec == 0) return;
+
+  if (N_VDotProdMultiAllReduce(nvec, acor, sums) != 0) {
+    /* fall back to the norm of acor and let the order selection recompute
+       its norms */
+    if (iac >= 0) {
+      cv_mem->cv_acnrm = N_VWrmsNorm(acor, cv_mem->cv_ewt);
+      cv_mem->cv_nreduce++;
+    }
+    return;
+  }
+  cv_mem->cv_nreduce++;
+
+  len = (realtype) N_VGetLength(acor);
+  if (iac >= 0) cv_mem->cv_acnrm = SUNRsqrt(sums[iac] / len);
+  cv_mem->cv_ddnqm1 = (iqm1 >= 0) ? SUNRsqrt(sums[iqm1] / len) : ZERO;
+  cv_mem->cv_dupqp1 = (iqp1 >= 0) ? SUNRsqrt(sums[iqp1] / len) : ZERO;
+  cv_mem->cv_ordnrmcur = SUNTRUE;
+}
+
 /*
  * cvCheckConstraints
  *
@@ -2885,8 +3019,16 @@ static int cvCheckConstraints(CVodeMem cv_mem)
   /* Constraints not met */
 
   /* Compute correction to satisfy constraints */
+  if (cv_mem->cv_usefusedhost)
+  {
+    cvCheckConstraints_host(cv_mem->cv_constraints,
+                            cv_mem->cv_ewt,
+                            cv_mem->cv_y,
+                            mm,
+                            tmp);
+  }
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
-  if (cv_mem->cv_usefused)
+  else if (cv_mem->cv_usefused)
   {
     cvCheckConstraints_fused(cv_mem->cv_constraints,
                              cv_mem->cv_ewt,
@@ -2894,8 +3036,8 @@ static int cvCheckConstraints(CVodeMem cv_mem)
                              mm,
                              tmp);
   }
-  else
 #endif
+  else
   {
     N_VCompare(ONEPT5, cv_mem->cv_constraints, tmp); /* a[i]=1 when |c[i]|=2  */
     N_VProd(tmp, cv_mem->cv_constraints, tmp);       /* a * c                 */
@@ -3023,6 +3165,12 @@ void cvRestore(CVodeMem cv_mem, realtype saved_t)
   int j, k;
 
   cv_mem->cv_tn = saved_t;
+  if (cv_mem->cv_usefusedhost)
+  {
+    cvPredict_host(cv_mem->cv_q, -ONE, cv_mem->cv_zn);
+    return;
+  }
+
   for (k = 1; k <= cv_mem->cv_q; k++)
     for (j = cv_mem->cv_q; j >= k; j--)
       N_VLinearSum(ONE, cv_mem->cv_zn[j-1], -ONE,
@@ -3175,6 +3323,7 @@ static int cvDoErrorTest(CVodeMem cv_mem, int *nflagPtr, realtype saved_t,
 static void cvCompleteStep(CVodeMem cv_mem)
 {
   int i;
+  booleantype saveacor;
 
   cv_mem->cv_nst++;
   cv_mem->cv_nscon++;
@@ -3186,20 +3335,34 @@ static void cvCompleteStep(CVodeMem cv_mem)
     cv_mem->cv_tau[2] = cv_mem->cv_tau[1];
   cv_mem->cv_tau[1] = cv_mem->cv_h;
 
-  /* Apply correction to column j of zn: l_j * Delta_n */
-  (void) N_VScaleAddMulti(cv_mem->cv_q+1, cv_mem->cv_l, cv_mem->cv_acor,
-                          cv_mem->cv_zn, cv_mem->cv_zn);
+  cv_mem->cv_qwait--;
+  saveacor = (cv_mem->cv_qwait == 1) && (cv_mem->cv_q != cv_mem->cv_qmax);
+
+  if (cv_mem->cv_usefusedhost) {
+
+    /* Apply the corrections and save acor in one sweep over zn */
+    cvCorrect_host(cv_mem->cv_q, cv_mem->cv_l, cv_mem->cv_acor,
+                   cv_mem->proj_applied ? cv_mem->proj_p : NULL,
+                   cv_mem->cv_tempv, cv_mem->cv_zn,
+                   saveacor ? cv_mem->cv_zn[cv_mem->cv_qmax] : NULL);
+
+  } else {
 
-  /* Apply the projection correction to column j of zn: p_j * Delta_n */
-  if (cv_mem->proj_applied) {
-    (void) N_VScaleAddMulti(cv_mem->cv_q+1,
-                            cv_mem->proj_p, cv_mem->cv_tempv, /* tempv = acorP */
+    /* Apply correction to column j of zn: l_j * Delta_n */
+    (void) N_VScaleAddMulti(cv_mem->cv_q+1, cv_mem->cv_l, cv_mem->cv_acor,
                             cv_mem->cv_zn, cv_mem->cv_zn);
+
+    /* Apply the projection correction to column j of zn: p_j * Delta_n */
+    if (cv_mem->proj_applied) {
+      (void) N_VScaleAddMulti(cv_mem->cv_q+1,
+                              cv_mem->proj_p, cv_mem->cv_tempv, /* tempv = acorP */
+                              cv_mem->cv_zn, cv_mem->cv_zn);
+    }
+
+    if (saveacor) N_VScale(ONE, cv_mem->cv_acor, cv_mem->cv_zn[cv_mem->cv_qmax]);
   }
 
-  cv_mem->cv_qwait--;
-  if ((cv_mem->cv_qwait == 1) && (cv_mem->cv_q != cv_mem->cv_qmax)) {
-    N_VScale(ONE, cv_mem->cv_acor, cv_mem->cv_zn[cv_mem->cv_qmax]);
+  if (saveacor) {
     cv_mem->cv_saved_tq5 = cv_mem->cv_tq[5];
     cv_mem->cv_indx_acor = cv_mem->cv_qmax;
   }
@@ -3315,7 +3478,12 @@ static realtype cvComputeEtaqm1(CVodeMem cv_mem)
 
   cv_mem->cv_etaqm1 = ZERO;
   if (cv_mem->cv_q > 1) {
-    ddn = N_VWrmsNorm(cv_mem->cv_zn[cv_mem->cv_q], cv_mem->cv_ewt) * cv_mem->cv_tq[1];
+    if (cv_mem->cv_ordnrmcur) {
+      ddn = cv_mem->cv_ddnqm1 * cv_mem->cv_tq[1];
+    } else {
+      ddn = N_VWrmsNorm(cv_mem->cv_zn[cv_mem->cv_q], cv_mem->cv_ewt) * cv_mem->cv_tq[1];
+      cv_mem->cv_nreduce++;
+    }
     cv_mem->cv_etaqm1 = ONE/(SUNRpowerR(BIAS1*ddn, ONE/cv_mem->cv_q) + ADDON);
   }
   return(cv_mem->cv_etaqm1);
@@ -3337,9 +3505,18 @@ static realtype cvComputeEtaqp1(CVodeMem cv_mem)
     if (cv_mem->cv_saved_tq5 == ZERO) return(cv_mem->cv_etaqp1);
     cquot = (cv_mem->cv_tq[5] / cv_mem->cv_saved_tq5) *
       SUNRpowerI(cv_mem->cv_h/cv_mem->cv_tau[2], cv_mem->cv_L);
-    N_VLinearSum(-cquot, cv_mem->cv_zn[cv_mem->cv_qmax], ONE,
-                 cv_mem->cv_acor, cv_mem->cv_tempv);
-    dup = N_VWrmsNorm(cv_mem->cv_tempv, cv_mem->cv_ewt) * cv_mem->cv_tq[3];
+    if (cv_mem->cv_ordnrmcur) {
+      dup = cv_mem->cv_dupqp1 * cv_mem->cv_tq[3];
+    } else if (cv_mem->cv_usefusedhost) {
+      cv_mem->cv_nreduce++;
+      dup = cvEtaqp1Norm_host(cquot, cv_mem->cv_zn[cv_mem->cv_qmax],
+                              cv_mem->cv_acor, cv_mem->cv_ewt) * cv_mem->cv_tq[3];
+    } else {
+      N_VLinearSum(-cquot, cv_mem->cv_zn[cv_mem->cv_qmax], ONE,
+                   cv_mem->cv_acor, cv_mem->cv_tempv);
+      dup = N_VWrmsNorm(cv_mem->cv_tempv, cv_mem->cv_ewt) * cv_mem->cv_tq[3];
+      cv_mem->cv_nreduce++;
+    }
     cv_mem->cv_etaqp1 = ONE / (SUNRpowerR(BIAS3*dup, ONE/(cv_mem->cv_L+1)) + ADDON);
   }
   return(cv_mem->cv_etaqp1);
@@ -3541,6 +3718,7 @@ static void cvBDFStab(CVodeMem cv_mem)
       N_VWrmsNorm(cv_mem->cv_zn[cv_mem->cv_q], cv_mem->cv_ewt);
     sqm2 = factorial *
       N_VWrmsNorm(cv_mem->cv_zn[cv_mem->cv_q-1], cv_mem->cv_ewt);
+    cv_mem->cv_nreduce += 2;
     cv_mem->cv_ssdat[1][1] = sqm2*sqm2;
     cv_mem->cv_ssdat[1][2] = sqm1*sqm1;
     cv_mem->cv_ssdat[1][3] = sq*sq;
@@ -4388,8 +4566,13 @@ int cvEwtSet(N_Vector ycur, N_Vector weight, void *data)
 
 static int cvEwtSetSS(CVodeMem cv_mem, N_Vector ycur, N_Vector weight)
 {
+  if (cv_mem->cv_usefusedhost)
+  {
+    return(cvEwtSetSS_host(cv_mem->cv_atolmin0, cv_mem->cv_reltol,
+                           cv_mem->cv_Sabstol, ycur, weight));
+  }
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
-  if (cv_mem->cv_usefused)
+  else if (cv_mem->cv_usefused)
   {
     /* We compute weight (inverse of tempv) regardless of the component test
        since it will be thrown away in this case anyways. */
@@ -4400,16 +4583,13 @@ static int cvEwtSetSS(CVodeMem cv_mem, N_Vector ycur, N_Vector weight)
       if (N_VMin(cv_mem->cv_tempv) <= ZERO) return(-1);
     }
   }
-  else
 #endif
+  else
   {
     N_VAbs(ycur, cv_mem->cv_tempv);
     N_VScale(cv_mem->cv_reltol, cv_mem->cv_tempv, cv_mem->cv_tempv);
     N_VAddConst(cv_mem->cv_tempv, cv_mem->cv_Sabstol, cv_mem->cv_tempv);
-    if (cv_mem->cv_atolmin0) {
-      if (N_VMin(cv_mem->cv_tempv) <= ZERO) return(-1);
-    }
-    N_VInv(cv_mem->cv_tempv, weight);
+    return(cvInvPositive(cv_mem->cv_tempv, weight, cv_mem->cv_atolmin0));
   }
 
   return(0);
@@ -4427,8 +4607,13 @@ static int cvEwtSetSS(CVodeMem cv_mem, N_Vector ycur, N_Vector weight)
 
 static int cvEwtSetSV(CVodeMem cv_mem, N_Vector ycur, N_Vector weight)
 {
+  if (cv_mem->cv_usefusedhost)
+  {
+    return(cvEwtSetSV_host(cv_mem->cv_atolmin0, cv_mem->cv_reltol,
+                           cv_mem->cv_Vabstol, ycur, weight));
+  }
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
-  if (cv_mem->cv_usefused)
+  else if (cv_mem->cv_usefused)
   {
     /* We compute weight (inverse of tempv) regardless of the component test
        since it will be thrown away in this case anyways. */
@@ -4439,18 +4624,52 @@ static int cvEwtSetSV(CVodeMem cv_mem, N_Vector ycur, N_Vector weight)
       if (N_VMin(cv_mem->cv_tempv) <= ZERO) return(-1);
     }
   }
-  else
 #endif
+  else
   {
     N_VAbs(ycur, cv_mem->cv_tempv);
     N_VLinearSum(cv_mem->cv_reltol, cv_mem->cv_tempv, ONE,
                  cv_mem->cv_Vabstol, cv_mem->cv_tempv);
-    if (cv_mem->cv_atolmin0) {
-      if (N_VMin(cv_mem->cv_tempv) <= ZERO) return(-1);
+    return(cvInvPositive(cv_mem->cv_tempv, weight, cv_mem->cv_atolmin0));
+  }
+
+  return(0);
+}
+
+/*
+ * cvInvPositive
+ *
+ * This routine sets weight = 1/tempv. If test is SUNTRUE, it also checks
+ * that all components of tempv are positive. When the vector supports
+ * split-phase reductions, the global minimum is computed while the inversion
+ * is performed. cvInvPositive returns 0 on success and -1 if the test fails,
+ * in which case weight is left unchanged.
+ */
+
+static int cvInvPositive(N_Vector tempv, N_Vector weight, booleantype test)
+{
+  realtype tmin;
+
+  if (!test) {
+    N_VInv(tempv, weight);
+    return(0);
+  }
+
+  if ((tempv->ops->nvminlocal != NULL) &&
+      (tempv->ops->nvallreducestart != NULL)) {
+    tmin = N_VMinLocal(tempv);
+    if (N_VAllReduceStart(1, tempv, &tmin, SUN_REDUCE_MIN) == 0) {
+      /* invert in place so that weight is only set once tmin is known */
+      N_VInv(tempv, tempv);
+      if (N_VAllReduceFinish(tempv) != 0) return(-1);
+      if (tmin <= ZERO) return(-1);
+      N_VScale(ONE, tempv, weight);
+      return(0);
     }
-    N_VInv(cv_mem->cv_tempv, weight);
   }
 
+  if (N_VMin(tempv) <= ZERO) return(-1);
+  N_VInv(tempv, weight);
   return(0);
 }
 
@@ -0,0 +1,2006 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the batched mode of CVODE.
+ *
+ * Each system follows the variable step, variable order BDF
+ * algorithm of CVODE (cvStep and the routines it calls), with its
+ * own step size, order, Nordsieck array, error test, and Newton
+ * convergence test. The systems advance in lockstep rounds: in one
+ * round every running system makes one attempt at its next step,
+ * and the right-hand side, the Jacobian, and the linear solves of
+ * the Newton iterations are evaluated for all systems at once.
+ * The per-system work is threaded over systems with OpenMP when
+ * the vectors are OpenMP or Pthreads vectors.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "cvode_batch_impl.h"
+#include "cvode_ls_impl.h"
+#include <sundials/sundials_math.h>
+#include <sunmatrix/sunmatrix_blockdense.h>
+
+#define ZERO   RCONST(0.0)
+#define HALF   RCONST(0.5)
+#define ONE    RCONST(1.0)
+#define TWO    RCONST(2.0)
+
+/* Initial step size estimation constants (see cvHin) */
+#define HLB_FACTOR RCONST(100.0)
+#define HUB_FACTOR RCONST(0.1)
+#define H_BIAS     HALF
+#define MAX_ITERS  4
+
+/* Newton iteration constants (see cvode_nls.c) */
+#define CORTES     RCONST(0.1)
+#define NLS_MAXCOR 3
+#define CRDOWN     RCONST(0.3)
+#define RDIV       RCONST(2.0)
+
+/* Difference quotient Jacobian constant (see cvode_ls.c) */
+#define MIN_INC_MULT RCONST(1000.0)
+
+/* Access to the block of system s */
+#define CVB_SLICE(v,s) (N_VGetArrayPointer(v) + (s) * cvb_mem->cvb_neq)
+
+/* Thread count used for the loops over systems */
+#if defined(_OPENMP)
+#define CVB_NUM_THREADS(cvb_mem) cvFusedNumThreads((cvb_mem)->cvb_ewt)
+#endif
+
+/*
+ * =================================================================
+ *   P R I V A T E   F U N C T I O N   P R O T O T Y P E S
+ * =================================================================
+ */
+
+static booleantype cvbAllocVectors(CVodeBatchMem cvb_mem, N_Vector tmpl);
+static void cvbFreeVectors(CVodeBatchMem cvb_mem);
+static booleantype cvbAllocArrays(CVodeBatchMem cvb_mem);
+static void cvbFreeArrays(CVodeBatchMem cvb_mem);
+static void cvbResetState(CVodeBatchMem cvb_mem, realtype t0);
+
+static realtype cvbWrmsNorm(const realtype *x, const realtype *w,
+                            sunindextype n);
+static int cvbEwtSet(CVodeBatchMem cvb_mem, int s);
+static int cvbRhs(CVodeBatchMem cvb_mem, N_Vector y, N_Vector ydot);
+
+static int cvbInitialSetup(CVodeBatchMem cvb_mem, realtype tout);
+static int cvbHin(CVodeBatchMem cvb_mem, realtype tout);
+
+static void cvbStartAttempt(CVodeBatchMem cvb_mem, int s);
+static void cvbAdjustParams(CVodeBatchMem cvb_mem, int s);
+static void cvbAdjustOrder(CVodeBatchMem cvb_mem, int s, int deltaq);
+static void cvbIncreaseBDF(CVodeBatchMem cvb_mem, int s);
+static void cvbDecreaseBDF(CVodeBatchMem cvb_mem, int s);
+static void cvbRescale(CVodeBatchMem cvb_mem, int s);
+static void cvbPredict(CVodeBatchMem cvb_mem, int s);
+static void cvbRestore(CVodeBatchMem cvb_mem, int s);
+static void cvbSet(CVodeBatchMem cvb_mem, int s);
+
+static int cvbNls(CVodeBatchMem cvb_mem);
+static int cvbLinSetup(CVodeBatchMem cvb_mem);
+static int cvbDQJac(CVodeBatchMem cvb_mem);
+static void cvbConvTest(CVodeBatchMem cvb_mem, int s);
+
+static void cvbEndAttempt(CVodeBatchMem cvb_mem, int s, realtype tout,
+                          N_Vector yout, realtype *tret);
+static void cvbCompleteStep(CVodeBatchMem cvb_mem, int s);
+static void cvbPrepareNextStep(CVodeBatchMem cvb_mem, int s, realtype dsm);
+static void cvbSetEta(CVodeBatchMem cvb_mem, int s);
+static void cvbInterpolate(CVodeBatchMem cvb_mem, int s, realtype t,
+                           N_Vector yout);
+
+/*
+ * =================================================================
+ *   E X P O R T E D   F U N C T I O N S
+ * =================================================================
+ */
+
+/*
+ * CVodeBatchCreate
+ *
+ * CVodeBatchCreate allocates the batched CVODE memory for nsys
+ * systems of neq equations each and sets the default optional
+ * inputs. The vectors are allocated in CVodeBatchInit.
+ */
+
+void *CVodeBatchCreate(int nsys, sunindextype neq, SUNContext sunctx)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (!sunctx) {
+    cvBatchProcessError(NULL, 0, "CVodeBatchCreate", MSGCV_NULL_SUNCTX);
+    return(NULL);
+  }
+
+  if ((nsys <= 0) || (neq <= 0)) {
+    cvBatchProcessError(NULL, 0, "CVodeBatchCreate", MSGCVB_BAD_NSYS);
+    return(NULL);
+  }
+
+  cvb_mem = NULL;
+  cvb_mem = (CVodeBatchMem) malloc(sizeof(struct CVodeBatchMemRec));
+  if (cvb_mem == NULL) {
+    cvBatchProcessError(NULL, 0, "CVodeBatchCreate", MSGCV_CVMEM_FAIL);
+    return(NULL);
+  }
+
+  /* Zero out cvb_mem */
+  memset(cvb_mem, 0, sizeof(struct CVodeBatchMemRec));
+
+  cvb_mem->cvb_sunctx = sunctx;
+  cvb_mem->cvb_uround = UNIT_ROUNDOFF;
+  cvb_mem->cvb_nsys   = nsys;
+  cvb_mem->cvb_neq    = neq;
+
+  /* Set default values for integrator optional inputs */
+  cvb_mem->cvb_itol     = CVB_NN;
+  cvb_mem->cvb_qmax     = BDF_Q_MAX;
+  cvb_mem->cvb_mxstep   = MXSTEP_DEFAULT;
+  cvb_mem->cvb_hin      = ZERO;
+  cvb_mem->cvb_hmax_inv = HMAX_INV_DEFAULT;
+  cvb_mem->cvb_errfp    = stderr;
+
+  /* Allocate the per-system arrays */
+  if (!cvbAllocArrays(cvb_mem)) {
+    cvBatchProcessError(NULL, 0, "CVodeBatchCreate", MSGCV_CVMEM_FAIL);
+    cvbFreeArrays(cvb_mem);
+    free(cvb_mem);
+    return(NULL);
+  }
+
+  cvb_mem->cvb_MallocDone = SUNFALSE;
+
+  return((void *)cvb_mem);
+}
+
+/*
+ * CVodeBatchInit
+ *
+ * CVodeBatchInit allocates the vectors of the batched integrator
+ * (cloned from y0) and initializes every system at t0.
+ */
+
+int CVodeBatchInit(void *cvbatch_mem, CVBatchRhsFn f, realtype t0, N_Vector y0)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchInit", MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  if (y0 == NULL) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchInit", MSGCV_NULL_Y0);
+    return(CV_ILL_INPUT);
+  }
+
+  if (f == NULL) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchInit", MSGCV_NULL_F);
+    return(CV_ILL_INPUT);
+  }
+
+  if ((N_VGetLength(y0) != cvb_mem->cvb_nsys * cvb_mem->cvb_neq) ||
+      (N_VGetArrayPointer(y0) == NULL)) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchInit", MSGCVB_BAD_Y0);
+    return(CV_ILL_INPUT);
+  }
+
+  /* Free any existing vectors and allocate new ones */
+  cvbFreeVectors(cvb_mem);
+  if (!cvbAllocVectors(cvb_mem, y0)) {
+    cvbFreeVectors(cvb_mem);
+    cvBatchProcessError(cvb_mem, CV_MEM_FAIL, "CVodeBatchInit", MSGCV_MEM_FAIL);
+    return(CV_MEM_FAIL);
+  }
+
+  cvb_mem->cvb_f = f;
+
+  N_VScale(ONE, y0, cvb_mem->cvb_zn[0]);
+  cvbResetState(cvb_mem, t0);
+
+  cvb_mem->cvb_MallocDone = SUNTRUE;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVodeBatchReInit
+ *
+ * CVodeBatchReInit restarts every system at t0 with the initial
+ * condition y0, keeping the optional inputs and the linear solver.
+ */
+
+int CVodeBatchReInit(void *cvbatch_mem, realtype t0, N_Vector y0)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchReInit", MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  if (!cvb_mem->cvb_MallocDone) {
+    cvBatchProcessError(cvb_mem, CV_NO_MALLOC, "CVodeBatchReInit",
+                        MSGCV_NO_MALLOC);
+    return(CV_NO_MALLOC);
+  }
+
+  if (y0 == NULL) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchReInit",
+                        MSGCV_NULL_Y0);
+    return(CV_ILL_INPUT);
+  }
+
+  N_VScale(ONE, y0, cvb_mem->cvb_zn[0]);
+  cvbResetState(cvb_mem, t0);
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVodeBatchSStolerances / CVodeBatchSVtolerances
+ *
+ * These functions set the tolerances shared by all systems. For
+ * CVodeBatchSVtolerances, abstol has length nsys*neq so that every
+ * system may use different absolute tolerances.
+ */
+
+int CVodeBatchSStolerances(void *cvbatch_mem, realtype reltol, realtype abstol)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchSStolerances",
+                        MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  if (cvb_mem->cvb_MallocDone == SUNFALSE) {
+    cvBatchProcessError(cvb_mem, CV_NO_MALLOC, "CVodeBatchSStolerances",
+                        MSGCV_NO_MALLOC);
+    return(CV_NO_MALLOC);
+  }
+
+  if (reltol < ZERO) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchSStolerances",
+                        MSGCV_BAD_RELTOL);
+    return(CV_ILL_INPUT);
+  }
+
+  if (abstol < ZERO) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchSStolerances",
+                        MSGCV_BAD_ABSTOL);
+    return(CV_ILL_INPUT);
+  }
+
+  cvb_mem->cvb_reltol  = reltol;
+  cvb_mem->cvb_Sabstol = abstol;
+  cvb_mem->cvb_itol    = CVB_SS;
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchSVtolerances(void *cvbatch_mem, realtype reltol, N_Vector abstol)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchSVtolerances",
+                        MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  if (cvb_mem->cvb_MallocDone == SUNFALSE) {
+    cvBatchProcessError(cvb_mem, CV_NO_MALLOC, "CVodeBatchSVtolerances",
+                        MSGCV_NO_MALLOC);
+    return(CV_NO_MALLOC);
+  }
+
+  if (reltol < ZERO) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchSVtolerances",
+                        MSGCV_BAD_RELTOL);
+    return(CV_ILL_INPUT);
+  }
+
+  if (abstol == NULL) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchSVtolerances",
+                        MSGCV_NULL_ABSTOL);
+    return(CV_ILL_INPUT);
+  }
+
+  if (N_VMin(abstol) < ZERO) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchSVtolerances",
+                        MSGCV_BAD_ABSTOL);
+    return(CV_ILL_INPUT);
+  }
+
+  if (!cvb_mem->cvb_VabstolMallocDone) {
+    cvb_mem->cvb_Vabstol = N_VClone(cvb_mem->cvb_ewt);
+    if (cvb_mem->cvb_Vabstol == NULL) {
+      cvBatchProcessError(cvb_mem, CV_MEM_FAIL, "CVodeBatchSVtolerances",
+                          MSGCV_MEM_FAIL);
+      return(CV_MEM_FAIL);
+    }
+    cvb_mem->cvb_VabstolMallocDone = SUNTRUE;
+  }
+
+  cvb_mem->cvb_reltol = reltol;
+  N_VScale(ONE, abstol, cvb_mem->cvb_Vabstol);
+  cvb_mem->cvb_itol = CVB_SV;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVodeBatch
+ *
+ * This routine advances every system to tout (CV_NORMAL mode). A
+ * system that passes tout is interpolated to tout with its own
+ * Nordsieck array, yout receives the solutions of all systems, and
+ * tret[k] the time reached by system k. A failure of a system does
+ * not stop the others: its flag is available from
+ * CVodeBatchGetStatus, the solution at its last successful step is
+ * returned in yout, and CVodeBatch returns the flag of the first
+ * failed system. Failures affecting the whole batch (f, the
+ * Jacobian, or the linear solver failing unrecoverably) stop the
+ * integration immediately.
+ */
+
+int CVodeBatch(void *cvbatch_mem, realtype tout, N_Vector yout, realtype *tret)
+{
+  CVodeBatchMem cvb_mem;
+  int retval, s, nsys, nrunning, nreload;
+  realtype *zd, *fd, *yd;
+  sunindextype i, neq;
+#if defined(_OPENMP)
+  int nt;
+#endif
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatch", MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  if (cvb_mem->cvb_MallocDone == SUNFALSE) {
+    cvBatchProcessError(cvb_mem, CV_NO_MALLOC, "CVodeBatch", MSGCV_NO_MALLOC);
+    return(CV_NO_MALLOC);
+  }
+
+  if (yout == NULL) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatch", MSGCV_YOUT_NULL);
+    return(CV_ILL_INPUT);
+  }
+
+  if (tret == NULL) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatch", MSGCV_TRET_NULL);
+    return(CV_ILL_INPUT);
+  }
+
+  if (cvb_mem->cvb_itol == CVB_NN) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatch", MSGCV_NO_TOL);
+    return(CV_ILL_INPUT);
+  }
+
+  if (cvb_mem->cvb_LS == NULL) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatch", MSGCVB_NO_LS);
+    return(CV_ILL_INPUT);
+  }
+
+  nsys = cvb_mem->cvb_nsys;
+  neq  = cvb_mem->cvb_neq;
+
+  /* On the first call, load zn[1] and choose the initial step sizes */
+  if (cvb_mem->cvb_firststep) {
+    retval = cvbInitialSetup(cvb_mem, tout);
+    if (retval != CV_SUCCESS) return(retval);
+    cvb_mem->cvb_firststep = SUNFALSE;
+  }
+
+  /* Systems that are already past tout are interpolated right away */
+  nrunning = 0;
+  for (s = 0; s < nsys; s++) {
+    cvb_mem->cvb_nstloc[s] = 0;
+    cvb_mem->cvb_status[s] = CV_SUCCESS;
+    cvb_mem->cvb_newstep[s] = SUNTRUE;
+    if ((cvb_mem->cvb_nst[s] > 0) &&
+        ((cvb_mem->cvb_tn[s] - tout) * cvb_mem->cvb_h[s] >= ZERO)) {
+      cvbInterpolate(cvb_mem, s, tout, yout);
+      tret[s] = tout;
+      cvb_mem->cvb_state[s] = CVB_REACHED;
+    } else {
+      cvb_mem->cvb_state[s] = CVB_RUNNING;
+      nrunning++;
+    }
+  }
+
+#if defined(_OPENMP)
+  nt = CVB_NUM_THREADS(cvb_mem);
+#endif
+
+  /* Looping point for the lockstep rounds */
+  while (nrunning > 0) {
+
+    cvb_mem->cvb_nrounds++;
+
+    /* Every running system starts an attempt at its next step */
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(nt) if(nt > 1) schedule(static)
+#endif
+    for (s = 0; s < nsys; s++)
+      cvbStartAttempt(cvb_mem, s);
+
+    /* Solve the nonlinear systems of the running systems together */
+    retval = cvbNls(cvb_mem);
+    if (retval != CV_SUCCESS) return(retval);
+
+    /* Error test, step completion, and step size selection */
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(nt) if(nt > 1) schedule(static)
+#endif
+    for (s = 0; s < nsys; s++)
+      cvbEndAttempt(cvb_mem, s, tout, yout, tret);
+
+    /* Reload zn[1] for systems restarted at order 1 by the error test */
+    nreload = 0;
+    for (s = 0; s < nsys; s++)
+      if (cvb_mem->cvb_reload[s]) nreload++;
+
+    if (nreload > 0) {
+      for (s = 0; s < nsys; s++)
+        cvb_mem->cvb_tfeval[s] = cvb_mem->cvb_tn[s];
+      retval = cvbRhs(cvb_mem, cvb_mem->cvb_zn[0], cvb_mem->cvb_tempv);
+      if (retval < 0) return(CV_RHSFUNC_FAIL);
+
+      for (s = 0; s < nsys; s++) {
+        if (!cvb_mem->cvb_reload[s]) continue;
+        cvb_mem->cvb_reload[s] = SUNFALSE;
+        if (retval > 0) {
+          cvb_mem->cvb_state[s]   = CVB_FAILED;
+          cvb_mem->cvb_status[s]  = CV_UNREC_RHSFUNC_ERR;
+          cvb_mem->cvb_newstep[s] = SUNTRUE;
+          continue;
+        }
+        zd = CVB_SLICE(cvb_mem->cvb_zn[1], s);
+        fd = CVB_SLICE(cvb_mem->cvb_tempv, s);
+        for (i = 0; i < neq; i++) zd[i] = cvb_mem->cvb_h[s] * fd[i];
+      }
+    }
+
+    nrunning = 0;
+    for (s = 0; s < nsys; s++)
+      if (cvb_mem->cvb_state[s] == CVB_RUNNING) nrunning++;
+  }
+
+  /* Return the last solutions of failed systems */
+  retval = CV_SUCCESS;
+  for (s = 0; s < nsys; s++) {
+    if (cvb_mem->cvb_state[s] != CVB_FAILED) continue;
+    zd = CVB_SLICE(cvb_mem->cvb_zn[0], s);
+    yd = CVB_SLICE(yout, s);
+    for (i = 0; i < neq; i++) yd[i] = zd[i];
+    tret[s] = cvb_mem->cvb_tn[s];
+    if (retval == CV_SUCCESS) retval = cvb_mem->cvb_status[s];
+  }
+
+  if (retval != CV_SUCCESS)
+    cvBatchProcessError(cvb_mem, retval, "CVodeBatch", MSGCVB_SYS_FAILED);
+
+  return(retval);
+}
+
+/*
+ * CVodeBatchFree
+ *
+ * This routine frees the batched CVODE memory. The linear solver
+ * and matrix attached by the user are not freed.
+ */
+
+void CVodeBatchFree(void **cvbatch_mem)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (*cvbatch_mem == NULL) return;
+
+  cvb_mem = (CVodeBatchMem) (*cvbatch_mem);
+
+  cvbFreeVectors(cvb_mem);
+  cvbFreeArrays(cvb_mem);
+
+  if (cvb_mem->cvb_savedJ != NULL) {
+    SUNMatDestroy(cvb_mem->cvb_savedJ);
+    cvb_mem->cvb_savedJ = NULL;
+  }
+
+  free(*cvbatch_mem);
+  *cvbatch_mem = NULL;
+}
+
+/*
+ * =================================================================
+ *   M E M O R Y   M A N A G E M E N T
+ * =================================================================
+ */
+
+static booleantype cvbAllocVectors(CVodeBatchMem cvb_mem, N_Vector tmpl)
+{
+  int j;
+
+  for (j = 0; j <= cvb_mem->cvb_qmax; j++) {
+    cvb_mem->cvb_zn[j] = N_VClone(tmpl);
+    if (cvb_mem->cvb_zn[j] == NULL) return(SUNFALSE);
+  }
+
+  cvb_mem->cvb_ewt    = N_VClone(tmpl);
+  cvb_mem->cvb_acor   = N_VClone(tmpl);
+  cvb_mem->cvb_y      = N_VClone(tmpl);
+  cvb_mem->cvb_ftemp  = N_VClone(tmpl);
+  cvb_mem->cvb_delta  = N_VClone(tmpl);
+  cvb_mem->cvb_tempv  = N_VClone(tmpl);
+  cvb_mem->cvb_tempv2 = N_VClone(tmpl);
+
+  if ((cvb_mem->cvb_ewt == NULL) || (cvb_mem->cvb_acor == NULL) ||
+      (cvb_mem->cvb_y == NULL) || (cvb_mem->cvb_ftemp == NULL) ||
+      (cvb_mem->cvb_delta == NULL) || (cvb_mem->cvb_tempv == NULL) ||
+      (cvb_mem->cvb_tempv2 == NULL))
+    return(SUNFALSE);
+
+  return(SUNTRUE);
+}
+
+static void cvbFreeVectors(CVodeBatchMem cvb_mem)
+{
+  int j;
+
+  for (j = 0; j < CVB_L_MAX; j++) {
+    if (cvb_mem->cvb_zn[j] != NULL) N_VDestroy(cvb_mem->cvb_zn[j]);
+    cvb_mem->cvb_zn[j] = NULL;
+  }
+
+  if (cvb_mem->cvb_ewt != NULL)    N_VDestroy(cvb_mem->cvb_ewt);
+  if (cvb_mem->cvb_acor != NULL)   N_VDestroy(cvb_mem->cvb_acor);
+  if (cvb_mem->cvb_y != NULL)      N_VDestroy(cvb_mem->cvb_y);
+  if (cvb_mem->cvb_ftemp != NULL)  N_VDestroy(cvb_mem->cvb_ftemp);
+  if (cvb_mem->cvb_delta != NULL)  N_VDestroy(cvb_mem->cvb_delta);
+  if (cvb_mem->cvb_tempv != NULL)  N_VDestroy(cvb_mem->cvb_tempv);
+  if (cvb_mem->cvb_tempv2 != NULL) N_VDestroy(cvb_mem->cvb_tempv2);
+
+  cvb_mem->cvb_ewt    = NULL;
+  cvb_mem->cvb_acor   = NULL;
+  cvb_mem->cvb_y      = NULL;
+  cvb_mem->cvb_ftemp  = NULL;
+  cvb_mem->cvb_delta  = NULL;
+  cvb_mem->cvb_tempv  = NULL;
+  cvb_mem->cvb_tempv2 = NULL;
+
+  if (cvb_mem->cvb_VabstolMallocDone) {
+    N_VDestroy(cvb_mem->cvb_Vabstol);
+    cvb_mem->cvb_Vabstol = NULL;
+    cvb_mem->cvb_VabstolMallocDone = SUNFALSE;
+    if (cvb_mem->cvb_itol == CVB_SV) cvb_mem->cvb_itol = CVB_NN;
+  }
+}
+
+static booleantype cvbAllocArrays(CVodeBatchMem cvb_mem)
+{
+  size_t n = (size_t) cvb_mem->cvb_nsys;
+  size_t np = (size_t) ((cvb_mem->cvb_nsys + SUNBLOCKDENSE_PACK - 1) /
+                        SUNBLOCKDENSE_PACK) * SUNBLOCKDENSE_PACK;
+
+  cvb_mem->cvb_tn        = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_saved_t   = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_tfeval    = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_h         = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_hprime    = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_hscale    = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_eta       = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_etamax    = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_hu        = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_saved_tq5 = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_tau       = (realtype *) calloc(n * (CVB_L_MAX+1), sizeof(realtype));
+  cvb_mem->cvb_l         = (realtype *) calloc(n * CVB_L_MAX, sizeof(realtype));
+  cvb_mem->cvb_tq        = (realtype *) calloc(n * (NUM_TESTS+1), sizeof(realtype));
+  cvb_mem->cvb_rl1       = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_gamma     = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_gammap    = (realtype *) calloc(np, sizeof(realtype));
+  cvb_mem->cvb_gamrat    = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_crate     = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_delp      = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_acnrm     = (realtype *) calloc(n, sizeof(realtype));
+  cvb_mem->cvb_gsetup    = (realtype *) calloc(np, sizeof(realtype));
+
+  cvb_mem->cvb_q        = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_qprime   = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_qwait    = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_L        = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_qu       = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_nflag    = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_ncf      = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_nef      = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_state    = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_status   = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_nls      = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_m        = (int *) calloc(n, sizeof(int));
+  cvb_mem->cvb_convfail = (int *) calloc(n, sizeof(int));
+
+  cvb_mem->cvb_newstep   = (booleantype *) calloc(n, sizeof(booleantype));
+  cvb_mem->cvb_callSetup = (booleantype *) calloc(n, sizeof(booleantype));
+  cvb_mem->cvb_jbad      = (booleantype *) calloc(np, sizeof(booleantype));
+  cvb_mem->cvb_jcur      = (booleantype *) calloc(n, sizeof(booleantype));
+  cvb_mem->cvb_hasJ      = (booleantype *) calloc(n, sizeof(booleantype));
+  cvb_mem->cvb_reload    = (booleantype *) calloc(n, sizeof(booleantype));
+
+  cvb_mem->cvb_nst    = (long int *) calloc(n, sizeof(long int));
+  cvb_mem->cvb_nstloc = (long int *) calloc(n, sizeof(long int));
+  cvb_mem->cvb_nstlp  = (long int *) calloc(n, sizeof(long int));
+  cvb_mem->cvb_nstlj  = (long int *) calloc(n, sizeof(long int));
+  cvb_mem->cvb_netf   = (long int *) calloc(n, sizeof(long int));
+  cvb_mem->cvb_ncfn   = (long int *) calloc(n, sizeof(long int));
+  cvb_mem->cvb_nni    = (long int *) calloc(n, sizeof(long int));
+  cvb_mem->cvb_nnf    = (long int *) calloc(n, sizeof(long int));
+
+  if (!cvb_mem->cvb_tn || !cvb_mem->cvb_saved_t || !cvb_mem->cvb_tfeval ||
+      !cvb_mem->cvb_h || !cvb_mem->cvb_hprime || !cvb_mem->cvb_hscale ||
+      !cvb_mem->cvb_eta || !cvb_mem->cvb_etamax || !cvb_mem->cvb_hu ||
+      !cvb_mem->cvb_saved_tq5 || !cvb_mem->cvb_tau || !cvb_mem->cvb_l ||
+      !cvb_mem->cvb_tq || !cvb_mem->cvb_rl1 || !cvb_mem->cvb_gamma ||
+      !cvb_mem->cvb_gammap || !cvb_mem->cvb_gamrat || !cvb_mem->cvb_crate ||
+      !cvb_mem->cvb_delp || !cvb_mem->cvb_acnrm || !cvb_mem->cvb_gsetup ||
+      !cvb_mem->cvb_q || !cvb_mem->cvb_qprime || !cvb_mem->cvb_qwait ||
+      !cvb_mem->cvb_L || !cvb_mem->cvb_qu || !cvb_mem->cvb_nflag ||
+      !cvb_mem->cvb_ncf || !cvb_mem->cvb_nef || !cvb_mem->cvb_state ||
+      !cvb_mem->cvb_status || !cvb_mem->cvb_nls || !cvb_mem->cvb_m ||
+      !cvb_mem->cvb_convfail || !cvb_mem->cvb_newstep ||
+      !cvb_mem->cvb_callSetup || !cvb_mem->cvb_jbad || !cvb_mem->cvb_jcur ||
+      !cvb_mem->cvb_hasJ || !cvb_mem->cvb_reload || !cvb_mem->cvb_nst ||
+      !cvb_mem->cvb_nstloc || !cvb_mem->cvb_nstlp || !cvb_mem->cvb_nstlj ||
+      !cvb_mem->cvb_netf || !cvb_mem->cvb_ncfn || !cvb_mem->cvb_nni ||
+      !cvb_mem->cvb_nnf)
+    return(SUNFALSE);
+
+  return(SUNTRUE);
+}
+
+static void cvbFreeArrays(CVodeBatchMem cvb_mem)
+{
+  free(cvb_mem->cvb_tn);
+  free(cvb_mem->cvb_saved_t);
+  free(cvb_mem->cvb_tfeval);
+  free(cvb_mem->cvb_h);
+  free(cvb_mem->cvb_hprime);
+  free(cvb_mem->cvb_hscale);
+  free(cvb_mem->cvb_eta);
+  free(cvb_mem->cvb_etamax);
+  free(cvb_mem->cvb_hu);
+  free(cvb_mem->cvb_saved_tq5);
+  free(cvb_mem->cvb_tau);
+  free(cvb_mem->cvb_l);
+  free(cvb_mem->cvb_tq);
+  free(cvb_mem->cvb_rl1);
+  free(cvb_mem->cvb_gamma);
+  free(cvb_mem->cvb_gammap);
+  free(cvb_mem->cvb_gamrat);
+  free(cvb_mem->cvb_crate);
+  free(cvb_mem->cvb_delp);
+  free(cvb_mem->cvb_acnrm);
+  free(cvb_mem->cvb_gsetup);
+
+  free(cvb_mem->cvb_q);
+  free(cvb_mem->cvb_qprime);
+  free(cvb_mem->cvb_qwait);
+  free(cvb_mem->cvb_L);
+  free(cvb_mem->cvb_qu);
+  free(cvb_mem->cvb_nflag);
+  free(cvb_mem->cvb_ncf);
+  free(cvb_mem->cvb_nef);
+  free(cvb_mem->cvb_state);
+  free(cvb_mem->cvb_status);
+  free(cvb_mem->cvb_nls);
+  free(cvb_mem->cvb_m);
+  free(cvb_mem->cvb_convfail);
+
+  free(cvb_mem->cvb_newstep);
+  free(cvb_mem->cvb_callSetup);
+  free(cvb_mem->cvb_jbad);
+  free(cvb_mem->cvb_jcur);
+  free(cvb_mem->cvb_hasJ);
+  free(cvb_mem->cvb_reload);
+
+  free(cvb_mem->cvb_nst);
+  free(cvb_mem->cvb_nstloc);
+  free(cvb_mem->cvb_nstlp);
+  free(cvb_mem->cvb_nstlj);
+  free(cvb_mem->cvb_netf);
+  free(cvb_mem->cvb_ncfn);
+  free(cvb_mem->cvb_nni);
+  free(cvb_mem->cvb_nnf);
+}
+
+/*
+ * cvbResetState
+ *
+ * This routine puts every system in the state CVodeInit leaves a
+ * CVODE memory in, with zn[0] already loaded.
+ */
+
+static void cvbResetState(CVodeBatchMem cvb_mem, realtype t0)
+{
+  int s, i;
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) {
+    cvb_mem->cvb_tn[s]        = t0;
+    cvb_mem->cvb_saved_t[s]   = t0;
+    cvb_mem->cvb_h[s]         = ZERO;
+    cvb_mem->cvb_hprime[s]    = ZERO;
+    cvb_mem->cvb_hscale[s]    = ZERO;
+    cvb_mem->cvb_eta[s]       = ONE;
+    cvb_mem->cvb_etamax[s]    = ETA_MAX_FS_DEFAULT;
+    cvb_mem->cvb_hu[s]        = ZERO;
+    cvb_mem->cvb_saved_tq5[s] = ZERO;
+    cvb_mem->cvb_gammap[s]    = ZERO;
+    cvb_mem->cvb_crate[s]     = ONE;
+    for (i = 0; i <= CVB_L_MAX; i++)
+      cvb_mem->cvb_tau[s*(CVB_L_MAX+1) + i] = ZERO;
+
+    cvb_mem->cvb_q[s]      = 1;
+    cvb_mem->cvb_qprime[s] = 1;
+    cvb_mem->cvb_L[s]      = 2;
+    cvb_mem->cvb_qwait[s]  = 2;
+    cvb_mem->cvb_qu[s]     = 0;
+    cvb_mem->cvb_state[s]  = CVB_RUNNING;
+    cvb_mem->cvb_status[s] = CV_SUCCESS;
+    cvb_mem->cvb_nls[s]    = CVB_NLS_IDLE;
+    cvb_mem->cvb_hasJ[s]   = SUNFALSE;
+    cvb_mem->cvb_jcur[s]   = SUNFALSE;
+    cvb_mem->cvb_reload[s] = SUNFALSE;
+
+    cvb_mem->cvb_nst[s]   = 0;
+    cvb_mem->cvb_nstlp[s] = 0;
+    cvb_mem->cvb_nstlj[s] = 0;
+    cvb_mem->cvb_netf[s]  = 0;
+    cvb_mem->cvb_ncfn[s]  = 0;
+    cvb_mem->cvb_nni[s]   = 0;
+    cvb_mem->cvb_nnf[s]   = 0;
+  }
+
+  cvb_mem->cvb_nfe     = 0;
+  cvb_mem->cvb_nje     = 0;
+  cvb_mem->cvb_nsetups = 0;
+  cvb_mem->cvb_nrounds = 0;
+
+  cvb_mem->cvb_Abad      = SUNTRUE;
+  cvb_mem->cvb_firststep = SUNTRUE;
+}
+
+/*
+ * =================================================================
+ *   U T I L I T Y   F U N C T I O N S
+ * =================================================================
+ */
+
+/* WRMS norm of one block */
+static realtype cvbWrmsNorm(const realtype *x, const realtype *w,
+                            sunindextype n)
+{
+  sunindextype i;
+  realtype sum = ZERO;
+
+  for (i = 0; i < n; i++) sum += (x[i] * w[i]) * (x[i] * w[i]);
+
+  return(SUNRsqrt(sum / n));
+}
+
+/*
+ * cvbEwtSet
+ *
+ * This routine sets the error weights of system s from the current
+ * zn[0]. It returns -1 if a weight would not be positive.
+ */
+
+static int cvbEwtSet(CVodeBatchMem cvb_mem, int s)
+{
+  sunindextype i, neq = cvb_mem->cvb_neq;
+  realtype *yd = CVB_SLICE(cvb_mem->cvb_zn[0], s);
+  realtype *wd = CVB_SLICE(cvb_mem->cvb_ewt, s);
+  realtype *ad, t;
+
+  ad = (cvb_mem->cvb_itol == CVB_SV) ? CVB_SLICE(cvb_mem->cvb_Vabstol, s) : NULL;
+
+  for (i = 0; i < neq; i++) {
+    t = cvb_mem->cvb_reltol * SUNRabs(yd[i]) +
+      ((ad != NULL) ? ad[i] : cvb_mem->cvb_Sabstol);
+    if (t <= ZERO) return(-1);
+    wd[i] = ONE / t;
+  }
+
+  return(0);
+}
+
+/* Evaluates f for all systems at the times in tfeval */
+static int cvbRhs(CVodeBatchMem cvb_mem, N_Vector y, N_Vector ydot)
+{
+  cvb_mem->cvb_nfe++;
+  return(cvb_mem->cvb_f(cvb_mem->cvb_tfeval, y, ydot, cvb_mem->cvb_user_data));
+}
+
+/*
+ * cvBatchProcessError
+ *
+ * Error handling function for the batched integrator. The message is
+ * written to errfp in the same format as the CVODE default error
+ * handler.
+ */
+
+void cvBatchProcessError(CVodeBatchMem cvb_mem, int error_code,
+                         const char *fname, const char *msgfmt, ...)
+{
+  va_list ap;
+  char msg[256];
+  FILE *errfp;
+
+  va_start(ap, msgfmt);
+  vsprintf(msg, msgfmt, ap);
+
+  errfp = (cvb_mem == NULL) ? stderr : cvb_mem->cvb_errfp;
+
+#ifndef NO_FPRINTF_OUTPUT
+  if (errfp != NULL) {
+    fprintf(errfp, "\n[CVODE %s]  %s\n",
+            (error_code == CV_WARNING) ? "WARNING" : "ERROR", fname);
+    fprintf(errfp, "  %s\n\n", msg);
+  }
+#endif
+
+  va_end(ap);
+}
+
+/*
+ * =================================================================
+ *   I N I T I A L   S T E P
+ * =================================================================
+ */
+
+/*
+ * cvbInitialSetup
+ *
+ * This routine is called on the first call to CVodeBatch. It sets
+ * the error weights, loads zn[1] = f(t0,y0), chooses the initial
+ * step sizes, and scales zn[1] by them.
+ */
+
+static int cvbInitialSetup(CVodeBatchMem cvb_mem, realtype tout)
+{
+  int retval, s;
+  sunindextype i;
+  realtype *zd, rh;
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) {
+    if (cvbEwtSet(cvb_mem, s) != 0) {
+      cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatch", MSGCV_BAD_EWT);
+      return(CV_ILL_INPUT);
+    }
+    cvb_mem->cvb_tfeval[s] = cvb_mem->cvb_tn[s];
+  }
+
+  retval = cvbRhs(cvb_mem, cvb_mem->cvb_zn[0], cvb_mem->cvb_zn[1]);
+  if (retval < 0) {
+    cvBatchProcessError(cvb_mem, CV_RHSFUNC_FAIL, "CVodeBatch",
+                        MSGCVB_RHSFUNC_FAILED, cvb_mem->cvb_tn[0]);
+    return(CV_RHSFUNC_FAIL);
+  }
+  if (retval > 0) {
+    cvBatchProcessError(cvb_mem, CV_FIRST_RHSFUNC_ERR, "CVodeBatch",
+                        MSGCV_RHSFUNC_FIRST);
+    return(CV_FIRST_RHSFUNC_ERR);
+  }
+
+  /* Set the initial step sizes */
+  if (cvb_mem->cvb_hin != ZERO) {
+    if ((tout - cvb_mem->cvb_tn[0]) * cvb_mem->cvb_hin < ZERO) {
+      cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatch", MSGCV_BAD_H0);
+      return(CV_ILL_INPUT);
+    }
+    for (s = 0; s < cvb_mem->cvb_nsys; s++)
+      cvb_mem->cvb_h[s] = cvb_mem->cvb_hin;
+  } else {
+    retval = cvbHin(cvb_mem, tout);
+    if (retval != CV_SUCCESS) {
+      if (retval == CV_TOO_CLOSE)
+        cvBatchProcessError(cvb_mem, retval, "CVodeBatch", MSGCV_TOO_CLOSE);
+      else if (retval == CV_RHSFUNC_FAIL)
+        cvBatchProcessError(cvb_mem, retval, "CVodeBatch",
+                            MSGCVB_RHSFUNC_FAILED, cvb_mem->cvb_tn[0]);
+      else
+        cvBatchProcessError(cvb_mem, retval, "CVodeBatch",
+                            MSGCV_RHSFUNC_FIRST);
+      return(retval);
+    }
+  }
+
+  /* Enforce hmax and scale zn[1] by the initial step sizes */
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) {
+    rh = SUNRabs(cvb_mem->cvb_h[s]) * cvb_mem->cvb_hmax_inv;
+    if (rh > ONE) cvb_mem->cvb_h[s] /= rh;
+
+    cvb_mem->cvb_hscale[s] = cvb_mem->cvb_h[s];
+    cvb_mem->cvb_hprime[s] = cvb_mem->cvb_h[s];
+
+    zd = CVB_SLICE(cvb_mem->cvb_zn[1], s);
+    for (i = 0; i < cvb_mem->cvb_neq; i++) zd[i] *= cvb_mem->cvb_h[s];
+  }
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * cvbHin
+ *
+ * This routine computes a tentative initial step size h0 for every
+ * system with the algorithm of cvHin. The iterations of all systems
+ * share the right-hand side evaluations. A recoverable failure of f
+ * during the estimation is not retried and CV_REPTD_RHSFUNC_ERR is
+ * returned.
+ */
+
+static int cvbHin(CVodeBatchMem cvb_mem, realtype tout)
+{
+  int retval, s, count1, nsys, ndone;
+  sunindextype i, neq;
+  realtype tdiff, tdist, tround, hub_inv, t, sign, hrat, yddnrm, h0;
+  realtype *hlb, *hub, *hg, *hnew, *z0, *z1, *wd, *yd, *fd;
+  booleantype *done;
+
+  nsys = cvb_mem->cvb_nsys;
+  neq  = cvb_mem->cvb_neq;
+
+  tdiff = tout - cvb_mem->cvb_tn[0];
+  if (tdiff == ZERO) return(CV_TOO_CLOSE);
+
+  sign   = (tdiff > ZERO) ? ONE : -ONE;
+  tdist  = SUNRabs(tdiff);
+  tround = cvb_mem->cvb_uround * SUNMAX(SUNRabs(cvb_mem->cvb_tn[0]),
+                                         SUNRabs(tout));
+  if (tdist < TWO*tround) return(CV_TOO_CLOSE);
+
+  hlb  = (realtype *) malloc(4 * nsys * sizeof(realtype));
+  done = (booleantype *) malloc(nsys * sizeof(booleantype));
+  if ((hlb == NULL) || (done == NULL)) {
+    free(hlb);
+    free(done);
+    return(CV_MEM_FAIL);
+  }
+  hub  = hlb + nsys;
+  hg   = hub + nsys;
+  hnew = hg + nsys;
+
+  /* Set lower and upper bounds on h0 and take their geometric mean as
+     the first trial value (see cvUpperBoundH0) */
+  ndone = 0;
+  for (s = 0; s < nsys; s++) {
+    z0 = CVB_SLICE(cvb_mem->cvb_zn[0], s);
+    z1 = CVB_SLICE(cvb_mem->cvb_zn[1], s);
+    wd = CVB_SLICE(cvb_mem->cvb_ewt, s);
+
+    hub_inv = ZERO;
+    for (i = 0; i < neq; i++) {
+      t = SUNRabs(z1[i]) / (HUB_FACTOR * SUNRabs(z0[i]) + ONE / wd[i]);
+      hub_inv = SUNMAX(hub_inv, t);
+    }
+
+    hlb[s] = HLB_FACTOR * tround;
+    hub[s] = HUB_FACTOR * tdist;
+    if (hub[s] * hub_inv > ONE) hub[s] = ONE / hub_inv;
+
+    hg[s]   = SUNRsqrt(hlb[s] * hub[s]);
+    hnew[s] = hg[s];
+    done[s] = (hub[s] < hlb[s]);
+    if (done[s]) ndone++;
+  }
+
+  /* Iterate on the estimates of ||y''|| */
+  retval = CV_SUCCESS;
+  for (count1 = 1; (count1 <= MAX_ITERS) && (ndone < nsys); count1++) {
+
+    for (s = 0; s < nsys; s++) {
+      z0 = CVB_SLICE(cvb_mem->cvb_zn[0], s);
+      z1 = CVB_SLICE(cvb_mem->cvb_zn[1], s);
+      yd = CVB_SLICE(cvb_mem->cvb_y, s);
+      for (i = 0; i < neq; i++) yd[i] = z0[i] + sign * hg[s] * z1[i];
+      cvb_mem->cvb_tfeval[s] = cvb_mem->cvb_tn[s] + sign * hg[s];
+    }
+
+    retval = cvbRhs(cvb_mem, cvb_mem->cvb_y, cvb_mem->cvb_tempv);
+    if (retval < 0) { retval = CV_RHSFUNC_FAIL; break; }
+    if (retval > 0) { retval = CV_REPTD_RHSFUNC_ERR; break; }
+
+    for (s = 0; s < nsys; s++) {
+      if (done[s]) continue;
+
+      z1 = CVB_SLICE(cvb_mem->cvb_zn[1], s);
+      wd = CVB_SLICE(cvb_mem->cvb_ewt, s);
+      fd = CVB_SLICE(cvb_mem->cvb_tempv, s);
+      for (i = 0; i < neq; i++) fd[i] = (fd[i] - z1[i]) / (sign * hg[s]);
+      yddnrm = cvbWrmsNorm(fd, wd, neq);
+
+      /* Propose new step size */
+      hnew[s] = (yddnrm * hub[s] * hub[s] > TWO) ?
+        SUNRsqrt(TWO / yddnrm) : SUNRsqrt(hg[s] * hub[s]);
+
+      hrat = hnew[s] / hg[s];
+
+      if ((count1 == MAX_ITERS) || ((hrat > HALF) && (hrat < TWO))) {
+        done[s] = SUNTRUE;
+      } else if ((count1 > 1) && (hrat > TWO)) {
+        /* ydd seems to be bad, use the fall-back value */
+        hnew[s] = hg[s];
+        done[s] = SUNTRUE;
+      } else {
+        hg[s] = hnew[s];
+      }
+      if (done[s]) ndone++;
+    }
+  }
+
+  /* Apply bounds, bias factor, and attach sign */
+  if (retval == CV_SUCCESS) {
+    for (s = 0; s < nsys; s++) {
+      if (hub[s] < hlb[s]) {
+        cvb_mem->cvb_h[s] = sign * hg[s];
+        continue;
+      }
+      h0 = H_BIAS * hnew[s];
+      if (h0 < hlb[s]) h0 = hlb[s];
+      if (h0 > hub[s]) h0 = hub[s];
+      cvb_mem->cvb_h[s] = sign * h0;
+    }
+  }
+
+  free(hlb);
+  free(done);
+
+  return(retval);
+}
+
+/*
+ * =================================================================
+ *   S T E P   A T T E M P T
+ * =================================================================
+ */
+
+/*
+ * cvbStartAttempt
+ *
+ * This routine starts an attempt at the next step of system s: on a
+ * new step it updates the error weights, checks mxstep, and applies
+ * the step size and order chosen after the previous step; then it
+ * predicts zn, sets the method coefficients, and decides whether the
+ * Newton matrix must be updated (see cvStep and cvNls).
+ */
+
+static void cvbStartAttempt(CVodeBatchMem cvb_mem, int s)
+{
+  sunindextype i;
+  realtype *ad;
+  int nflag;
+
+  cvb_mem->cvb_nls[s] = CVB_NLS_IDLE;
+  if (cvb_mem->cvb_state[s] != CVB_RUNNING) return;
+
+  if (cvb_mem->cvb_newstep[s]) {
+
+    if (cvb_mem->cvb_nstloc[s] > 0) {
+      if (cvbEwtSet(cvb_mem, s) != 0) {
+        cvb_mem->cvb_state[s]  = CVB_FAILED;
+        cvb_mem->cvb_status[s] = CV_ILL_INPUT;
+        return;
+      }
+    }
+
+    if ((cvb_mem->cvb_mxstep > 0) &&
+        (cvb_mem->cvb_nstloc[s] >= cvb_mem->cvb_mxstep)) {
+      cvb_mem->cvb_state[s]  = CVB_FAILED;
+      cvb_mem->cvb_status[s] = CV_TOO_MUCH_WORK;
+      return;
+    }
+
+    cvb_mem->cvb_saved_t[s] = cvb_mem->cvb_tn[s];
+    cvb_mem->cvb_ncf[s]     = 0;
+    cvb_mem->cvb_nef[s]     = 0;
+    cvb_mem->cvb_nflag[s]   = FIRST_CALL;
+    cvb_mem->cvb_newstep[s] = SUNFALSE;
+
+    if ((cvb_mem->cvb_nst[s] > 0) &&
+        (cvb_mem->cvb_hprime[s] != cvb_mem->cvb_h[s]))
+      cvbAdjustParams(cvb_mem, s);
+  }
+
+  cvbPredict(cvb_mem, s);
+  cvbSet(cvb_mem, s);
+
+  /* initial guess for the correction to the predictor */
+  ad = CVB_SLICE(cvb_mem->cvb_acor, s);
+  for (i = 0; i < cvb_mem->cvb_neq; i++) ad[i] = ZERO;
+
+  nflag = cvb_mem->cvb_nflag[s];
+  cvb_mem->cvb_convfail[s] = ((nflag == FIRST_CALL) || (nflag == PREV_ERR_FAIL)) ?
+    CV_NO_FAILURES : CV_FAIL_OTHER;
+
+  cvb_mem->cvb_callSetup[s] = (nflag == PREV_CONV_FAIL) ||
+    (nflag == PREV_ERR_FAIL) || (cvb_mem->cvb_nst[s] == 0) ||
+    (cvb_mem->cvb_nst[s] >= cvb_mem->cvb_nstlp[s] + MSBP_DEFAULT) ||
+    (SUNRabs(cvb_mem->cvb_gamrat[s] - ONE) > DGMAX_LSETUP_DEFAULT);
+
+  cvb_mem->cvb_jcur[s] = SUNFALSE;
+  cvb_mem->cvb_m[s]    = 0;
+  cvb_mem->cvb_nls[s]  = CVB_NLS_ITER;
+}
+
+/* See cvAdjustParams */
+static void cvbAdjustParams(CVodeBatchMem cvb_mem, int s)
+{
+  if (cvb_mem->cvb_qprime[s] != cvb_mem->cvb_q[s]) {
+    cvbAdjustOrder(cvb_mem, s, cvb_mem->cvb_qprime[s] - cvb_mem->cvb_q[s]);
+    cvb_mem->cvb_q[s]     = cvb_mem->cvb_qprime[s];
+    cvb_mem->cvb_L[s]     = cvb_mem->cvb_q[s] + 1;
+    cvb_mem->cvb_qwait[s] = cvb_mem->cvb_L[s];
+  }
+  cvbRescale(cvb_mem, s);
+}
+
+/* See cvAdjustOrder and cvAdjustBDF */
+static void cvbAdjustOrder(CVodeBatchMem cvb_mem, int s, int deltaq)
+{
+  if ((cvb_mem->cvb_q[s] == 2) && (deltaq != 1)) return;
+
+  if (deltaq == 1)       cvbIncreaseBDF(cvb_mem, s);
+  else if (deltaq == -1) cvbDecreaseBDF(cvb_mem, s);
+}
+
+/* See cvIncreaseBDF */
+static void cvbIncreaseBDF(CVodeBatchMem cvb_mem, int s)
+{
+  realtype alpha0, alpha1, prod, xi, xiold, hsum, A1;
+  realtype *l   = cvb_mem->cvb_l + s * CVB_L_MAX;
+  realtype *tau = cvb_mem->cvb_tau + s * (CVB_L_MAX+1);
+  realtype *zL, *zacor, *zj;
+  sunindextype k;
+  int i, j, q = cvb_mem->cvb_q[s];
+
+  for (i = 0; i <= cvb_mem->cvb_qmax; i++) l[i] = ZERO;
+  l[2] = alpha1 = prod = xiold = ONE;
+  alpha0 = -ONE;
+  hsum = cvb_mem->cvb_hscale[s];
+  if (q > 1) {
+    for (j = 1; j < q; j++) {
+      hsum += tau[j+1];
+      xi = hsum / cvb_mem->cvb_hscale[s];
+      prod *= xi;
+      alpha0 -= ONE / (j+1);
+      alpha1 += ONE / xi;
+      for (i = j+2; i >= 2; i--) l[i] = l[i]*xiold + l[i-1];
+      xiold = xi;
+    }
+  }
+  A1 = (-alpha0 - alpha1) / prod;
+
+  zL    = CVB_SLICE(cvb_mem->cvb_zn[cvb_mem->cvb_L[s]], s);
+  zacor = CVB_SLICE(cvb_mem->cvb_zn[cvb_mem->cvb_qmax], s);
+  for (k = 0; k < cvb_mem->cvb_neq; k++) zL[k] = A1 * zacor[k];
+
+  for (j = 2; j <= q; j++) {
+    zj = CVB_SLICE(cvb_mem->cvb_zn[j], s);
+    for (k = 0; k < cvb_mem->cvb_neq; k++) zj[k] += l[j] * zL[k];
+  }
+}
+
+/* See cvDecreaseBDF */
+static void cvbDecreaseBDF(CVodeBatchMem cvb_mem, int s)
+{
+  realtype hsum, xi;
+  realtype *l   = cvb_mem->cvb_l + s * CVB_L_MAX;
+  realtype *tau = cvb_mem->cvb_tau + s * (CVB_L_MAX+1);
+  realtype *zq, *zj;
+  sunindextype k;
+  int i, j, q = cvb_mem->cvb_q[s];
+
+  for (i = 0; i <= cvb_mem->cvb_qmax; i++) l[i] = ZERO;
+  l[2] = ONE;
+  hsum = ZERO;
+  for (j = 1; j <= q-2; j++) {
+    hsum += tau[j];
+    xi = hsum / cvb_mem->cvb_hscale[s];
+    for (i = j+2; i >= 2; i--) l[i] = l[i]*xi + l[i-1];
+  }
+
+  zq = CVB_SLICE(cvb_mem->cvb_zn[q], s);
+  for (j = 2; j < q; j++) {
+    zj = CVB_SLICE(cvb_mem->cvb_zn[j], s);
+    for (k = 0; k < cvb_mem->cvb_neq; k++) zj[k] -= l[j] * zq[k];
+  }
+}
+
+/* See cvRescale */
+static void cvbRescale(CVodeBatchMem cvb_mem, int s)
+{
+  realtype factor, *zj;
+  sunindextype k;
+  int j;
+
+  factor = cvb_mem->cvb_eta[s];
+  for (j = 1; j <= cvb_mem->cvb_q[s]; j++) {
+    zj = CVB_SLICE(cvb_mem->cvb_zn[j], s);
+    for (k = 0; k < cvb_mem->cvb_neq; k++) zj[k] *= factor;
+    factor *= cvb_mem->cvb_eta[s];
+  }
+
+  cvb_mem->cvb_h[s]      = cvb_mem->cvb_hscale[s] * cvb_mem->cvb_eta[s];
+  cvb_mem->cvb_hscale[s] = cvb_mem->cvb_h[s];
+}
+
+/* See cvPredict */
+static void cvbPredict(CVodeBatchMem cvb_mem, int s)
+{
+  realtype *zj, *zjm1;
+  sunindextype i;
+  int j, k;
+
+  cvb_mem->cvb_tn[s] += cvb_mem->cvb_h[s];
+
+  for (k = 1; k <= cvb_mem->cvb_q[s]; k++) {
+    for (j = cvb_mem->cvb_q[s]; j >= k; j--) {
+      zjm1 = CVB_SLICE(cvb_mem->cvb_zn[j-1], s);
+      zj   = CVB_SLICE(cvb_mem->cvb_zn[j], s);
+      for (i = 0; i < cvb_mem->cvb_neq; i++) zjm1[i] += zj[i];
+    }
+  }
+}
+
+/* See cvRestore */
+static void cvbRestore(CVodeBatchMem cvb_mem, int s)
+{
+  realtype *zj, *zjm1;
+  sunindextype i;
+  int j, k;
+
+  cvb_mem->cvb_tn[s] = cvb_mem->cvb_saved_t[s];
+
+  for (k = 1; k <= cvb_mem->cvb_q[s]; k++) {
+    for (j = cvb_mem->cvb_q[s]; j >= k; j--) {
+      zjm1 = CVB_SLICE(cvb_mem->cvb_zn[j-1], s);
+      zj   = CVB_SLICE(cvb_mem->cvb_zn[j], s);
+      for (i = 0; i < cvb_mem->cvb_neq; i++) zjm1[i] -= zj[i];
+    }
+  }
+}
+
+/* See cvSet, cvSetBDF, and cvSetTqBDF */
+static void cvbSet(CVodeBatchMem cvb_mem, int s)
+{
+  realtype alpha0, alpha0_hat, xi_inv, xistar_inv, hsum, h;
+  realtype A1, A2, A3, A4, A5, A6, C, Cpinv, Cppinv;
+  realtype *l   = cvb_mem->cvb_l + s * CVB_L_MAX;
+  realtype *tq  = cvb_mem->cvb_tq + s * (NUM_TESTS+1);
+  realtype *tau = cvb_mem->cvb_tau + s * (CVB_L_MAX+1);
+  int i, j, q = cvb_mem->cvb_q[s];
+
+  h = cvb_mem->cvb_h[s];
+
+  l[0] = l[1] = xi_inv = xistar_inv = ONE;
+  for (i = 2; i <= q; i++) l[i] = ZERO;
+  alpha0 = alpha0_hat = -ONE;
+  hsum = h;
+
+  if (q > 1) {
+    for (j = 2; j < q; j++) {
+      hsum += tau[j-1];
+      xi_inv = h / hsum;
+      alpha0 -= ONE / j;
+      for (i = j; i >= 1; i--) l[i] += l[i-1]*xi_inv;
+    }
+
+    /* j = q */
+    alpha0 -= ONE / q;
+    xistar_inv = -l[1] - alpha0;
+    hsum += tau[q-1];
+    xi_inv = h / hsum;
+    alpha0_hat = -l[1] - xi_inv;
+    for (i = q; i >= 1; i--) l[i] += l[i-1]*xistar_inv;
+  }
+
+  A1 = ONE - alpha0_hat + alpha0;
+  A2 = ONE + q * A1;
+  tq[2] = SUNRabs(A1 / (alpha0 * A2));
+  tq[5] = SUNRabs(A2 * xistar_inv / (l[q] * xi_inv));
+  if (cvb_mem->cvb_qwait[s] == 1) {
+    if (q > 1) {
+      C = xistar_inv / l[q];
+      A3 = alpha0 + ONE / q;
+      A4 = alpha0_hat + xi_inv;
+      Cpinv = (ONE - A4 + A3) / A3;
+      tq[1] = SUNRabs(C * Cpinv);
+    }
+    else tq[1] = ONE;
+    hsum += tau[q];
+    xi_inv = h / hsum;
+    A5 = alpha0 - (ONE / (q+1));
+    A6 = alpha0_hat - xi_inv;
+    Cppinv = (ONE - A6 + A5) / A2;
+    tq[3] = SUNRabs(Cppinv / (xi_inv * (q+2) * A5));
+  }
+  tq[4] = CORTES / tq[2];
+
+  cvb_mem->cvb_rl1[s]   = ONE / l[1];
+  cvb_mem->cvb_gamma[s] = h * cvb_mem->cvb_rl1[s];
+  if (cvb_mem->cvb_nst[s] == 0) cvb_mem->cvb_gammap[s] = cvb_mem->cvb_gamma[s];
+  cvb_mem->cvb_gamrat[s] = (cvb_mem->cvb_nst[s] > 0) ?
+    cvb_mem->cvb_gamma[s] / cvb_mem->cvb_gammap[s] : ONE;
+}
+
+/*
+ * =================================================================
+ *   N E W T O N   I T E R A T I O N
+ * =================================================================
+ */
+
+/*
+ * cvbNls
+ *
+ * This routine runs the Newton iterations of all systems in the
+ * CVB_NLS_ITER state together. Every pass evaluates f for the whole
+ * batch, updates the Newton matrices if a system needs it, and makes
+ * one batched linear solve; the convergence of each system is then
+ * tested separately. A system whose iteration fails with an old
+ * Jacobian is retried with a new one (see SUNNonlinSol_Newton).
+ * Unrecoverable failures are returned; recoverable failures are
+ * recorded in the Newton status of the affected systems.
+ */
+
+static int cvbNls(CVodeBatchMem cvb_mem)
+{
+  int retval, s, nsys, niter;
+  booleantype doSetup;
+  sunindextype i, neq;
+  realtype *z1d, *ad, *fd, *bd, scale;
+#if defined(_OPENMP)
+  int nt = CVB_NUM_THREADS(cvb_mem);
+#endif
+
+  nsys = cvb_mem->cvb_nsys;
+  neq  = cvb_mem->cvb_neq;
+
+  for (;;) {
+
+    niter = 0;
+    for (s = 0; s < nsys; s++)
+      if (cvb_mem->cvb_nls[s] == CVB_NLS_ITER) niter++;
+    if (niter == 0) return(CV_SUCCESS);
+
+    /* evaluate f at the current iterates y = zn[0] + acor */
+    N_VLinearSum(ONE, cvb_mem->cvb_zn[0], ONE, cvb_mem->cvb_acor,
+                 cvb_mem->cvb_y);
+    for (s = 0; s < nsys; s++) cvb_mem->cvb_tfeval[s] = cvb_mem->cvb_tn[s];
+
+    retval = cvbRhs(cvb_mem, cvb_mem->cvb_y, cvb_mem->cvb_ftemp);
+    if (retval < 0) {
+      cvBatchProcessError(cvb_mem, CV_RHSFUNC_FAIL, "CVodeBatch",
+                          MSGCVB_RHSFUNC_FAILED, cvb_mem->cvb_tn[0]);
+      return(CV_RHSFUNC_FAIL);
+    }
+    if (retval > 0) {
+      for (s = 0; s < nsys; s++)
+        if (cvb_mem->cvb_nls[s] == CVB_NLS_ITER)
+          cvb_mem->cvb_nls[s] = CVB_NLS_RHSFAIL;
+      return(CV_SUCCESS);
+    }
+
+    /* update the Newton matrices if needed */
+    doSetup = cvb_mem->cvb_Abad;
+    for (s = 0; s < nsys; s++)
+      if ((cvb_mem->cvb_nls[s] == CVB_NLS_ITER) && cvb_mem->cvb_callSetup[s])
+        doSetup = SUNTRUE;
+
+    if (doSetup) {
+      retval = cvbLinSetup(cvb_mem);
+      if (retval != CV_SUCCESS) return(retval);
+    }
+
+    /* b = -(rl1*zn[1] + acor - gamma*f), zero for the other systems */
+#if defined(_OPENMP)
+#pragma omp parallel for private(i, z1d, ad, fd, bd, scale) \
+  num_threads(nt) if(nt > 1) schedule(static)
+#endif
+    for (s = 0; s < nsys; s++) {
+      bd = CVB_SLICE(cvb_mem->cvb_tempv, s);
+      if (cvb_mem->cvb_nls[s] != CVB_NLS_ITER) {
+        for (i = 0; i < neq; i++) bd[i] = ZERO;
+        continue;
+      }
+      z1d = CVB_SLICE(cvb_mem->cvb_zn[1], s);
+      ad  = CVB_SLICE(cvb_mem->cvb_acor, s);
+      fd  = CVB_SLICE(cvb_mem->cvb_ftemp, s);
+
+      /* scale the solution for the change in gamma (see cvLsSolve) */
+      scale = (cvb_mem->cvb_gamrat[s] != ONE) ?
+        TWO / (ONE + cvb_mem->cvb_gamrat[s]) : ONE;
+      for (i = 0; i < neq; i++)
+        bd[i] = -scale * (cvb_mem->cvb_rl1[s] * z1d[i] + ad[i] -
+                          cvb_mem->cvb_gamma[s] * fd[i]);
+    }
+
+    retval = SUNLinSolSolve(cvb_mem->cvb_LS, cvb_mem->cvb_A, cvb_mem->cvb_delta,
+                            cvb_mem->cvb_tempv, ZERO);
+    if (retval < 0) {
+      cvBatchProcessError(cvb_mem, CV_LSOLVE_FAIL, "CVodeBatch",
+                          MSGCVB_SOLVE_FAILED, cvb_mem->cvb_tn[0]);
+      return(CV_LSOLVE_FAIL);
+    }
+    if (retval > 0) {
+      for (s = 0; s < nsys; s++)
+        if (cvb_mem->cvb_nls[s] == CVB_NLS_ITER)
+          cvb_mem->cvb_nls[s] = CVB_NLS_LSFAIL;
+      return(CV_SUCCESS);
+    }
+
+    /* apply the updates and test the convergence of each system */
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(nt) if(nt > 1) schedule(static)
+#endif
+    for (s = 0; s < nsys; s++)
+      if (cvb_mem->cvb_nls[s] == CVB_NLS_ITER) cvbConvTest(cvb_mem, s);
+
+    /* restart the iterations that failed with an old Jacobian */
+    for (s = 0; s < nsys; s++) {
+      if (cvb_mem->cvb_nls[s] != CVB_NLS_RETRY) continue;
+      ad = CVB_SLICE(cvb_mem->cvb_acor, s);
+      for (i = 0; i < neq; i++) ad[i] = ZERO;
+      cvb_mem->cvb_m[s]         = 0;
+      cvb_mem->cvb_convfail[s]  = CV_FAIL_BAD_J;
+      cvb_mem->cvb_callSetup[s] = SUNTRUE;
+      cvb_mem->cvb_nls[s]       = CVB_NLS_ITER;
+    }
+  }
+}
+
+/*
+ * cvbConvTest
+ *
+ * This routine applies the Newton update of system s and tests the
+ * convergence of its iteration (see cvNlsConvTest).
+ */
+
+static void cvbConvTest(CVodeBatchMem cvb_mem, int s)
+{
+  sunindextype i, neq = cvb_mem->cvb_neq;
+  realtype *ad = CVB_SLICE(cvb_mem->cvb_acor, s);
+  realtype *dd = CVB_SLICE(cvb_mem->cvb_delta, s);
+  realtype *wd = CVB_SLICE(cvb_mem->cvb_ewt, s);
+  realtype del, dcon;
+  int m = cvb_mem->cvb_m[s];
+
+  for (i = 0; i < neq; i++) ad[i] += dd[i];
+  cvb_mem->cvb_nni[s]++;
+
+  del = cvbWrmsNorm(dd, wd, neq);
+
+  if (m > 0)
+    cvb_mem->cvb_crate[s] = SUNMAX(CRDOWN * cvb_mem->cvb_crate[s],
+                                   del / cvb_mem->cvb_delp[s]);
+  dcon = del * SUNMIN(ONE, cvb_mem->cvb_crate[s]) /
+    cvb_mem->cvb_tq[s * (NUM_TESTS+1) + 4];
+
+  if (dcon <= ONE) {
+    cvb_mem->cvb_acnrm[s] = (m == 0) ? del : cvbWrmsNorm(ad, wd, neq);
+    cvb_mem->cvb_jcur[s]  = SUNFALSE;
+    cvb_mem->cvb_nls[s]   = CVB_NLS_DONE;
+    return;
+  }
+
+  if (!((m >= 1) && (del > RDIV * cvb_mem->cvb_delp[s]))) {
+    cvb_mem->cvb_delp[s] = del;
+    cvb_mem->cvb_m[s] = ++m;
+    if (m < NLS_MAXCOR) return;
+  }
+
+  /* the iteration failed, retry if the Jacobian may be out of date */
+  if (!cvb_mem->cvb_jcur[s]) {
+    cvb_mem->cvb_nls[s] = CVB_NLS_RETRY;
+  } else {
+    cvb_mem->cvb_nnf[s]++;
+    cvb_mem->cvb_nls[s] = CVB_NLS_CONVFAIL;
+  }
+}
+
+/*
+ * cvbLinSetup
+ *
+ * This routine updates the Newton matrices M_k = I - gamma_k J_k of
+ * the systems that requested a setup. A new Jacobian is computed for
+ * all systems when one of them needs it (see cvLsSetup), but it is
+ * only kept for those systems. The matrices of the other systems are
+ * rebuilt from their saved Jacobian and gamma of their last setup, so
+ * that they are unchanged by the batched factorization.
+ */
+
+static int cvbLinSetup(CVodeBatchMem cvb_mem)
+{
+  int retval, s, nsys, lane;
+  booleantype anyJbad, setup;
+  realtype dgamma, *Ad, *Jd, gs;
+  sunindextype p, e, MN, npacks, idx;
+  const sunindextype NP = SUNBLOCKDENSE_PACK;
+
+  nsys = cvb_mem->cvb_nsys;
+
+  /* decide which systems need a new Jacobian */
+  anyJbad = SUNFALSE;
+  for (s = 0; s < nsys; s++) {
+    cvb_mem->cvb_jbad[s] = SUNFALSE;
+    if ((cvb_mem->cvb_nls[s] != CVB_NLS_ITER) || !cvb_mem->cvb_callSetup[s])
+      continue;
+    dgamma = SUNRabs(cvb_mem->cvb_gamrat[s] - ONE);
+    cvb_mem->cvb_jbad[s] = !cvb_mem->cvb_hasJ[s] || (cvb_mem->cvb_nst[s] == 0) ||
+      (cvb_mem->cvb_nst[s] >= cvb_mem->cvb_nstlj[s] + CVLS_MSBJ) ||
+      ((cvb_mem->cvb_convfail[s] == CV_FAIL_BAD_J) && (dgamma < CVLS_DGMAX)) ||
+      (cvb_mem->cvb_convfail[s] == CV_FAIL_OTHER);
+    if (cvb_mem->cvb_jbad[s]) anyJbad = SUNTRUE;
+  }
+
+  Ad = SUNBlockDenseMatrix_Data(cvb_mem->cvb_A);
+  Jd = SUNBlockDenseMatrix_Data(cvb_mem->cvb_savedJ);
+  MN = SUNBlockDenseMatrix_BlockRows(cvb_mem->cvb_A) *
+    SUNBlockDenseMatrix_BlockColumns(cvb_mem->cvb_A);
+  npacks = (nsys + NP - 1) / NP;
+
+  /* evaluate the Jacobians into A and keep those that were needed */
+  if (anyJbad) {
+    cvb_mem->cvb_nje++;
+    if (cvb_mem->cvb_jac == NULL) {
+      retval = cvbDQJac(cvb_mem);
+    } else {
+      retval = SUNMatZero(cvb_mem->cvb_A);
+      if (retval == 0)
+        retval = cvb_mem->cvb_jac(cvb_mem->cvb_tfeval, cvb_mem->cvb_y,
+                                  cvb_mem->cvb_ftemp, cvb_mem->cvb_A,
+                                  cvb_mem->cvb_user_data, cvb_mem->cvb_tempv,
+                                  cvb_mem->cvb_tempv2, cvb_mem->cvb_delta);
+    }
+    if (retval < 0) {
+      cvBatchProcessError(cvb_mem, CV_LSETUP_FAIL, "CVodeBatch",
+                          MSGCVB_JACFUNC_FAILED, cvb_mem->cvb_tn[0]);
+      return(CV_LSETUP_FAIL);
+    }
+
+    if (retval > 0) {
+      /* recoverable failure, the systems concerned retry the step */
+      for (s = 0; s < nsys; s++) {
+        if (!cvb_mem->cvb_jbad[s]) continue;
+        cvb_mem->cvb_jbad[s] = SUNFALSE;
+        cvb_mem->cvb_nls[s]  = CVB_NLS_LSFAIL;
+      }
+    } else {
+      for (p = 0; p < npacks; p++)
+        for (e = 0; e < MN; e++)
+          for (lane = 0; lane < NP; lane++)
+            if ((p*NP + lane < nsys) && cvb_mem->cvb_jbad[p*NP + lane]) {
+              idx = (p*MN + e)*NP + lane;
+              Jd[idx] = Ad[idx];
+            }
+      for (s = 0; s < nsys; s++) {
+        if (!cvb_mem->cvb_jbad[s]) continue;
+        cvb_mem->cvb_hasJ[s]  = SUNTRUE;
+        cvb_mem->cvb_nstlj[s] = cvb_mem->cvb_nst[s];
+      }
+    }
+  }
+
+  /* choose gamma for each block */
+  for (s = 0; s < nsys; s++) {
+    setup = (cvb_mem->cvb_nls[s] == CVB_NLS_ITER) && cvb_mem->cvb_callSetup[s];
+    if (setup) {
+      cvb_mem->cvb_jcur[s]      = cvb_mem->cvb_jbad[s];
+      cvb_mem->cvb_gamrat[s]    = ONE;
+      cvb_mem->cvb_gammap[s]    = cvb_mem->cvb_gamma[s];
+      cvb_mem->cvb_crate[s]     = ONE;
+      cvb_mem->cvb_nstlp[s]     = cvb_mem->cvb_nst[s];
+      cvb_mem->cvb_callSetup[s] = SUNFALSE;
+    }
+    cvb_mem->cvb_gsetup[s] = cvb_mem->cvb_hasJ[s] ? cvb_mem->cvb_gammap[s] : ZERO;
+  }
+  for (s = nsys; s < npacks*NP; s++) cvb_mem->cvb_gsetup[s] = ZERO;
+
+  /* A = I - gamma J, vectorized over the blocks of each group */
+  {
+    const sunindextype M = SUNBlockDenseMatrix_BlockRows(cvb_mem->cvb_A);
+    sunindextype i, j;
+#if defined(_OPENMP)
+    int nt = CVB_NUM_THREADS(cvb_mem);
+#pragma omp parallel for private(i, j, idx, lane, gs) num_threads(nt) \
+  if(nt > 1) schedule(static)
+#endif
+    for (p = 0; p < npacks; p++) {
+      for (j = 0; j < M; j++) {
+        for (i = 0; i < M; i++) {
+          idx = (p*MN + j*M + i)*NP;
+          for (lane = 0; lane < NP; lane++) {
+            gs = cvb_mem->cvb_gsetup[p*NP + lane];
+            Ad[idx + lane] = ((i == j) ? ONE : ZERO) - gs * Jd[idx + lane];
+          }
+        }
+      }
+    }
+  }
+
+  cvb_mem->cvb_nsetups++;
+
+  retval = SUNLinSolSetup(cvb_mem->cvb_LS, cvb_mem->cvb_A);
+  if (retval < 0) {
+    cvBatchProcessError(cvb_mem, CV_LSETUP_FAIL, "CVodeBatch",
+                        MSGCV_SETUP_FAILED, cvb_mem->cvb_tn[0]);
+    return(CV_LSETUP_FAIL);
+  }
+
+  if (retval > 0) {
+    /* a singular matrix: the factorization of A is incomplete, so every
+       iterating system retries its step and A is rebuilt next time */
+    for (s = 0; s < nsys; s++)
+      if (cvb_mem->cvb_nls[s] == CVB_NLS_ITER)
+        cvb_mem->cvb_nls[s] = CVB_NLS_LSFAIL;
+    cvb_mem->cvb_Abad = SUNTRUE;
+    return(CV_SUCCESS);
+  }
+
+  cvb_mem->cvb_Abad = SUNFALSE;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * cvbDQJac
+ *
+ * This routine generates difference quotient approximations to the
+ * Jacobians of all systems (see cvLsDenseDQJac). Column j of every
+ * block is computed from one batched evaluation of f, in which
+ * component j of every system is perturbed with its own increment.
+ */
+
+static int cvbDQJac(CVodeBatchMem cvb_mem)
+{
+  int retval, s, nsys;
+  sunindextype i, j, neq;
+  realtype srur, *fnorm, *inc, *yd, *fyd, *wd, *fjd, minInc;
+  SUNMatrix A = cvb_mem->cvb_A;
+
+  nsys = cvb_mem->cvb_nsys;
+  neq  = cvb_mem->cvb_neq;
+  srur = SUNRsqrt(cvb_mem->cvb_uround);
+
+  fnorm = (realtype *) malloc(2 * nsys * sizeof(realtype));
+  if (fnorm == NULL) return(-1);
+  inc = fnorm + nsys;
+
+  for (s = 0; s < nsys; s++)
+    fnorm[s] = cvbWrmsNorm(CVB_SLICE(cvb_mem->cvb_ftemp, s),
+                           CVB_SLICE(cvb_mem->cvb_ewt, s), neq);
+
+  /* the perturbed iterates are built in tempv */
+  N_VScale(ONE, cvb_mem->cvb_y, cvb_mem->cvb_tempv);
+
+  retval = 0;
+  for (j = 0; j < neq; j++) {
+
+    for (s = 0; s < nsys; s++) {
+      yd = CVB_SLICE(cvb_mem->cvb_tempv, s);
+      wd = CVB_SLICE(cvb_mem->cvb_ewt, s);
+      minInc = (fnorm[s] != ZERO) ?
+        (MIN_INC_MULT * SUNRabs(cvb_mem->cvb_h[s]) * cvb_mem->cvb_uround *
+         neq * fnorm[s]) : ONE;
+      inc[s] = SUNMAX(srur * SUNRabs(yd[j]), minInc / wd[j]);
+      yd[j] += inc[s];
+    }
+
+    retval = cvbRhs(cvb_mem, cvb_mem->cvb_tempv, cvb_mem->cvb_tempv2);
+    if (retval != 0) break;
+
+    for (s = 0; s < nsys; s++) {
+      yd  = CVB_SLICE(cvb_mem->cvb_tempv, s);
+      fyd = CVB_SLICE(cvb_mem->cvb_ftemp, s);
+      fjd = CVB_SLICE(cvb_mem->cvb_tempv2, s);
+      for (i = 0; i < neq; i++)
+        SM_ELEMENT_BD(A, s, i, j) = (fjd[i] - fyd[i]) / inc[s];
+      yd[j] = CVB_SLICE(cvb_mem->cvb_y, s)[j];
+    }
+  }
+
+  free(fnorm);
+
+  return(retval);
+}
+
+/*
+ * =================================================================
+ *   E N D   O F   A   S T E P   A T T E M P T
+ * =================================================================
+ */
+
+/*
+ * cvbEndAttempt
+ *
+ * This routine finishes the step attempt of system s: it handles
+ * Newton failures (see cvHandleNFlag), performs the local error test
+ * (see cvDoErrorTest), and on success completes the step, selects
+ * the next step size and order, and interpolates to tout when the
+ * system has passed it.
+ */
+
+static void cvbEndAttempt(CVodeBatchMem cvb_mem, int s, realtype tout,
+                          N_Vector yout, realtype *tret)
+{
+  realtype dsm;
+  int nls = cvb_mem->cvb_nls[s];
+
+  if (nls == CVB_NLS_IDLE) return;
+  cvb_mem->cvb_nls[s] = CVB_NLS_IDLE;
+
+  if (nls != CVB_NLS_DONE) {
+
+    /* The nonlinear solve failed; restore zn and retry with a smaller h */
+    cvb_mem->cvb_ncfn[s]++;
+    cvbRestore(cvb_mem, s);
+
+    cvb_mem->cvb_ncf[s]++;
+    cvb_mem->cvb_etamax[s] = ONE;
+
+    if (cvb_mem->cvb_ncf[s] == MXNCF) {
+      cvb_mem->cvb_state[s]   = CVB_FAILED;
+      cvb_mem->cvb_status[s]  = (nls == CVB_NLS_RHSFAIL) ?
+        CV_REPTD_RHSFUNC_ERR : CV_CONV_FAILURE;
+      cvb_mem->cvb_newstep[s] = SUNTRUE;
+      return;
+    }
+
+    cvb_mem->cvb_eta[s]   = ETA_CF_DEFAULT;
+    cvb_mem->cvb_nflag[s] = PREV_CONV_FAIL;
+    cvbRescale(cvb_mem, s);
+    return;
+  }
+
+  /* Local error test */
+  dsm = cvb_mem->cvb_acnrm[s] * cvb_mem->cvb_tq[s * (NUM_TESTS+1) + 2];
+
+  if (dsm > ONE) {
+    cvb_mem->cvb_nef[s]++;
+    cvb_mem->cvb_netf[s]++;
+    cvb_mem->cvb_nflag[s] = PREV_ERR_FAIL;
+    cvbRestore(cvb_mem, s);
+
+    if (cvb_mem->cvb_nef[s] == MXNEF) {
+      cvb_mem->cvb_state[s]   = CVB_FAILED;
+      cvb_mem->cvb_status[s]  = CV_ERR_FAILURE;
+      cvb_mem->cvb_newstep[s] = SUNTRUE;
+      return;
+    }
+
+    cvb_mem->cvb_etamax[s] = ONE;
+
+    if (cvb_mem->cvb_nef[s] <= MXNEF1) {
+      cvb_mem->cvb_eta[s] = ONE / (SUNRpowerR(BIAS2*dsm, ONE/cvb_mem->cvb_L[s])
+                                   + ADDON);
+      cvb_mem->cvb_eta[s] = SUNMAX(ETA_MIN_EF_DEFAULT, cvb_mem->cvb_eta[s]);
+      if (cvb_mem->cvb_nef[s] >= SMALL_NEF_DEFAULT)
+        cvb_mem->cvb_eta[s] = SUNMIN(cvb_mem->cvb_eta[s], ETA_MAX_EF_DEFAULT);
+      cvbRescale(cvb_mem, s);
+      return;
+    }
+
+    /* After MXNEF1 failures, force an order reduction */
+    if (cvb_mem->cvb_q[s] > 1) {
+      cvb_mem->cvb_eta[s] = ETA_MIN_EF_DEFAULT;
+      cvbAdjustOrder(cvb_mem, s, -1);
+      cvb_mem->cvb_L[s] = cvb_mem->cvb_q[s];
+      cvb_mem->cvb_q[s]--;
+      cvb_mem->cvb_qwait[s] = cvb_mem->cvb_L[s];
+      cvbRescale(cvb_mem, s);
+      return;
+    }
+
+    /* If already at order 1, restart: zn[1] is reloaded after the round */
+    cvb_mem->cvb_eta[s]    = ETA_MIN_EF_DEFAULT;
+    cvb_mem->cvb_h[s]     *= cvb_mem->cvb_eta[s];
+    cvb_mem->cvb_hscale[s] = cvb_mem->cvb_h[s];
+    cvb_mem->cvb_qwait[s]  = LONG_WAIT;
+    cvb_mem->cvb_reload[s] = SUNTRUE;
+    return;
+  }
+
+  /* The step was successful */
+  cvbCompleteStep(cvb_mem, s);
+  cvbPrepareNextStep(cvb_mem, s, dsm);
+
+  cvb_mem->cvb_etamax[s] = (cvb_mem->cvb_nst[s] <= SMALL_NST_DEFAULT) ?
+    ETA_MAX_ES_DEFAULT : ETA_MAX_GS_DEFAULT;
+
+  cvb_mem->cvb_nstloc[s]++;
+  cvb_mem->cvb_newstep[s] = SUNTRUE;
+
+  if ((cvb_mem->cvb_tn[s] - tout) * cvb_mem->cvb_h[s] >= ZERO) {
+    cvbInterpolate(cvb_mem, s, tout, yout);
+    tret[s] = tout;
+    cvb_mem->cvb_state[s] = CVB_REACHED;
+  }
+}
+
+/* See cvCompleteStep */
+static void cvbCompleteStep(CVodeBatchMem cvb_mem, int s)
+{
+  realtype *l   = cvb_mem->cvb_l + s * CVB_L_MAX;
+  realtype *tau = cvb_mem->cvb_tau + s * (CVB_L_MAX+1);
+  realtype *ad, *zj;
+  sunindextype k;
+  int i, j, q = cvb_mem->cvb_q[s];
+
+  cvb_mem->cvb_nst[s]++;
+  cvb_mem->cvb_hu[s] = cvb_mem->cvb_h[s];
+  cvb_mem->cvb_qu[s] = q;
+
+  for (i = q; i >= 2; i--) tau[i] = tau[i-1];
+  if ((q == 1) && (cvb_mem->cvb_nst[s] > 1)) tau[2] = tau[1];
+  tau[1] = cvb_mem->cvb_h[s];
+
+  /* Apply the correction to column j of zn: l_j * Delta_n */
+  ad = CVB_SLICE(cvb_mem->cvb_acor, s);
+  for (j = 0; j <= q; j++) {
+    zj = CVB_SLICE(cvb_mem->cvb_zn[j], s);
+    for (k = 0; k < cvb_mem->cvb_neq; k++) zj[k] += l[j] * ad[k];
+  }
+
+  cvb_mem->cvb_qwait[s]--;
+  if ((cvb_mem->cvb_qwait[s] == 1) && (q != cvb_mem->cvb_qmax)) {
+    zj = CVB_SLICE(cvb_mem->cvb_zn[cvb_mem->cvb_qmax], s);
+    for (k = 0; k < cvb_mem->cvb_neq; k++) zj[k] = ad[k];
+    cvb_mem->cvb_saved_tq5[s] = cvb_mem->cvb_tq[s * (NUM_TESTS+1) + 5];
+  }
+}
+
+/* See cvPrepareNextStep, cvComputeEtaqm1, cvComputeEtaqp1, and
+   cvChooseEta */
+static void cvbPrepareNextStep(CVodeBatchMem cvb_mem, int s, realtype dsm)
+{
+  realtype etaq, etaqm1, etaqp1, etam, ddn, dup, cquot, t;
+  realtype *tq  = cvb_mem->cvb_tq + s * (NUM_TESTS+1);
+  realtype *tau = cvb_mem->cvb_tau + s * (CVB_L_MAX+1);
+  realtype *wd, *zq, *zmax, *ad;
+  sunindextype k, neq = cvb_mem->cvb_neq;
+  int q = cvb_mem->cvb_q[s], L = cvb_mem->cvb_L[s], qmax = cvb_mem->cvb_qmax;
+
+  /* If etamax = 1, defer step size or order changes */
+  if (cvb_mem->cvb_etamax[s] == ONE) {
+    cvb_mem->cvb_qwait[s]  = SUNMAX(cvb_mem->cvb_qwait[s], 2);
+    cvb_mem->cvb_qprime[s] = q;
+    cvb_mem->cvb_hprime[s] = cvb_mem->cvb_h[s];
+    cvb_mem->cvb_eta[s]    = ONE;
+    return;
+  }
+
+  etaq = ONE / (SUNRpowerR(BIAS2*dsm, ONE/L) + ADDON);
+
+  if (cvb_mem->cvb_qwait[s] != 0) {
+    cvb_mem->cvb_eta[s]    = etaq;
+    cvb_mem->cvb_qprime[s] = q;
+    cvbSetEta(cvb_mem, s);
+    return;
+  }
+
+  cvb_mem->cvb_qwait[s] = 2;
+  wd = CVB_SLICE(cvb_mem->cvb_ewt, s);
+
+  etaqm1 = ZERO;
+  if (q > 1) {
+    zq  = CVB_SLICE(cvb_mem->cvb_zn[q], s);
+    ddn = cvbWrmsNorm(zq, wd, neq) * tq[1];
+    etaqm1 = ONE / (SUNRpowerR(BIAS1*ddn, ONE/q) + ADDON);
+  }
+
+  etaqp1 = ZERO;
+  if ((q != qmax) && (cvb_mem->cvb_saved_tq5[s] != ZERO)) {
+    cquot = (tq[5] / cvb_mem->cvb_saved_tq5[s]) *
+      SUNRpowerI(cvb_mem->cvb_h[s] / tau[2], L);
+    zmax = CVB_SLICE(cvb_mem->cvb_zn[qmax], s);
+    ad   = CVB_SLICE(cvb_mem->cvb_acor, s);
+    dup  = ZERO;
+    for (k = 0; k < neq; k++) {
+      t = (ad[k] - cquot * zmax[k]) * wd[k];
+      dup += t * t;
+    }
+    dup = SUNRsqrt(dup / neq) * tq[3];
+    etaqp1 = ONE / (SUNRpowerR(BIAS3*dup, ONE/(L+1)) + ADDON);
+  }
+
+  etam = SUNMAX(etaqm1, SUNMAX(etaq, etaqp1));
+
+  if ((etam > ETA_MIN_FX_DEFAULT) && (etam < ETA_MAX_FX_DEFAULT)) {
+    cvb_mem->cvb_eta[s]    = ONE;
+    cvb_mem->cvb_qprime[s] = q;
+  } else if (etam == etaq) {
+    cvb_mem->cvb_eta[s]    = etaq;
+    cvb_mem->cvb_qprime[s] = q;
+  } else if (etam == etaqm1) {
+    cvb_mem->cvb_eta[s]    = etaqm1;
+    cvb_mem->cvb_qprime[s] = q - 1;
+  } else {
+    cvb_mem->cvb_eta[s]    = etaqp1;
+    cvb_mem->cvb_qprime[s] = q + 1;
+    /* Store Delta_n in zn[qmax] to be used in the order increase */
+    zmax = CVB_SLICE(cvb_mem->cvb_zn[qmax], s);
+    ad   = CVB_SLICE(cvb_mem->cvb_acor, s);
+    for (k = 0; k < neq; k++) zmax[k] = ad[k];
+  }
+
+  cvbSetEta(cvb_mem, s);
+}
+
+/* See cvSetEta */
+static void cvbSetEta(CVodeBatchMem cvb_mem, int s)
+{
+  realtype eta = cvb_mem->cvb_eta[s];
+
+  if ((eta > ETA_MIN_FX_DEFAULT) && (eta < ETA_MAX_FX_DEFAULT)) {
+    cvb_mem->cvb_eta[s]    = ONE;
+    cvb_mem->cvb_hprime[s] = cvb_mem->cvb_h[s];
+    return;
+  }
+
+  if (eta >= ETA_MAX_FX_DEFAULT) {
+    eta = SUNMIN(eta, cvb_mem->cvb_etamax[s]);
+    eta /= SUNMAX(ONE, SUNRabs(cvb_mem->cvb_h[s]) * cvb_mem->cvb_hmax_inv * eta);
+  } else {
+    eta = SUNMAX(eta, ETA_MIN_DEFAULT);
+  }
+
+  cvb_mem->cvb_eta[s]    = eta;
+  cvb_mem->cvb_hprime[s] = cvb_mem->cvb_h[s] * eta;
+}
+
+/*
+ * cvbInterpolate
+ *
+ * This routine evaluates the interpolating polynomial of system s at
+ * t and stores the result in the block s of yout (see CVodeGetDky).
+ */
+
+static void cvbInterpolate(CVodeBatchMem cvb_mem, int s, realtype t,
+                           N_Vector yout)
+{
+  realtype sfac, c, *yd, *zj;
+  sunindextype k;
+  int j;
+
+  sfac = (t - cvb_mem->cvb_tn[s]) / cvb_mem->cvb_h[s];
+  yd   = CVB_SLICE(yout, s);
+  zj   = CVB_SLICE(cvb_mem->cvb_zn[0], s);
+  for (k = 0; k < cvb_mem->cvb_neq; k++) yd[k] = zj[k];
+
+  c = ONE;
+  for (j = 1; j <= cvb_mem->cvb_q[s]; j++) {
+    c *= sfac;
+    zj = CVB_SLICE(cvb_mem->cvb_zn[j], s);
+    for (k = 0; k < cvb_mem->cvb_neq; k++) yd[k] += c * zj[k];
+  }
+}
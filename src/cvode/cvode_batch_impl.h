@@ -0,0 +1,210 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Implementation header file for the batched mode of CVODE.
+ * -----------------------------------------------------------------*/
+
+#ifndef _CVODE_BATCH_IMPL_H
+#define _CVODE_BATCH_IMPL_H
+
+#include <cvode/cvode_batch.h>
+#include "cvode_impl.h"
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*
+ * =================================================================
+ *   B A T C H   C O N S T A N T S
+ * =================================================================
+ */
+
+/* The batched integrator only implements the BDF method */
+#define CVB_L_MAX (BDF_Q_MAX+1)
+
+/* Control constants for tolerances */
+#define CVB_NN  0
+#define CVB_SS  1
+#define CVB_SV  2
+
+/* Status of a system within a call to CVodeBatch */
+#define CVB_RUNNING  0   /* still advancing towards tout        */
+#define CVB_REACHED  1   /* reached tout, yout has been filled  */
+#define CVB_FAILED   2   /* failed, the flag is in status array */
+
+/* Status of a system within one Newton solve */
+#define CVB_NLS_IDLE     0   /* not part of this round's solve  */
+#define CVB_NLS_ITER     1   /* iterating                       */
+#define CVB_NLS_DONE     2   /* converged                       */
+#define CVB_NLS_RETRY    3   /* failed, retry with a new J      */
+#define CVB_NLS_CONVFAIL 4   /* failed, convergence failure     */
+#define CVB_NLS_RHSFAIL  5   /* failed, recoverable RHS failure */
+#define CVB_NLS_LSFAIL   6   /* failed, singular Newton matrix  */
+
+/*
+ * =================================================================
+ *   B A T C H   M E M O R Y   S T R U C T U R E
+ * =================================================================
+ */
+
+typedef struct CVodeBatchMemRec {
+
+  SUNContext cvb_sunctx;
+
+  realtype cvb_uround;         /* machine unit roundoff                */
+
+  /*--------------------------
+    Problem Specification Data
+    --------------------------*/
+
+  int cvb_nsys;                /* number of systems                    */
+  sunindextype cvb_neq;        /* number of equations per system       */
+  CVBatchRhsFn cvb_f;          /* y' = f(t,y(t)) for all systems       */
+  void *cvb_user_data;         /* user pointer passed to f and jac     */
+  int cvb_itol;                /* CVB_SS or CVB_SV                     */
+  realtype cvb_reltol;         /* relative tolerance                   */
+  realtype cvb_Sabstol;        /* scalar absolute tolerance            */
+  N_Vector cvb_Vabstol;        /* vector absolute tolerance            */
+  booleantype cvb_VabstolMallocDone;
+
+  /*------------------
+    Optional Inputs
+    ------------------*/
+
+  int cvb_qmax;                /* q <= qmax                            */
+  long int cvb_mxstep;         /* max steps per system and call        */
+  realtype cvb_hin;            /* initial step size (0 = estimate)     */
+  realtype cvb_hmax_inv;       /* |h| <= 1/hmax_inv                    */
+  FILE *cvb_errfp;             /* error messages are sent to errfp     */
+
+  /*------------------------------------------------------
+    Vectors of length nsys*neq (block k holds system k)
+    ------------------------------------------------------*/
+
+  N_Vector cvb_zn[CVB_L_MAX];  /* Nordsieck arrays of all systems      */
+  N_Vector cvb_ewt;            /* error weights                        */
+  N_Vector cvb_acor;           /* corrections                          */
+  N_Vector cvb_y;              /* current iterates                     */
+  N_Vector cvb_ftemp;          /* f evaluated at y                     */
+  N_Vector cvb_delta;          /* Newton updates                       */
+  N_Vector cvb_tempv;          /* temporary storage                    */
+  N_Vector cvb_tempv2;         /* temporary storage                    */
+
+  /*----------------------
+    Linear Solver Data
+    ----------------------*/
+
+  SUNLinearSolver cvb_LS;      /* block-diagonal linear solver         */
+  SUNMatrix cvb_A;             /* Newton matrices I - gamma_k J_k      */
+  SUNMatrix cvb_savedJ;        /* saved Jacobians J_k                  */
+  CVBatchJacFn cvb_jac;        /* Jacobian function (NULL = DQ)        */
+  booleantype cvb_Abad;        /* A must be rebuilt and factored       */
+
+  /*-------------------------------------------
+    Per-System Integrator State (length nsys)
+    -------------------------------------------*/
+
+  realtype *cvb_tn;            /* current internal times               */
+  realtype *cvb_saved_t;       /* times at the start of the step       */
+  realtype *cvb_tfeval;        /* times passed to f and jac            */
+  realtype *cvb_h;             /* current step sizes                   */
+  realtype *cvb_hprime;        /* step sizes for the next steps        */
+  realtype *cvb_hscale;        /* step sizes at the last rescaling     */
+  realtype *cvb_eta;           /* hprime / h                           */
+  realtype *cvb_etamax;        /* eta <= etamax                        */
+  realtype *cvb_hu;            /* last successful step sizes           */
+  realtype *cvb_saved_tq5;     /* saved tq[5]                          */
+  realtype *cvb_tau;           /* step history, CVB_L_MAX+1 per system */
+  realtype *cvb_l;             /* BDF coefficients, CVB_L_MAX each     */
+  realtype *cvb_tq;            /* test quantities, NUM_TESTS+1 each    */
+  realtype *cvb_rl1;           /* 1 / l[1]                             */
+  realtype *cvb_gamma;         /* gamma = h * rl1                      */
+  realtype *cvb_gammap;        /* gamma at the last setup              */
+  realtype *cvb_gamrat;        /* gamma / gammap                       */
+  realtype *cvb_crate;         /* estimated convergence rates          */
+  realtype *cvb_delp;          /* norms of the previous Newton updates */
+  realtype *cvb_acnrm;         /* WRMS norms of acor                   */
+  realtype *cvb_gsetup;        /* gamma used in each block of A        */
+
+  int *cvb_q;                  /* current orders                       */
+  int *cvb_qprime;             /* orders for the next steps            */
+  int *cvb_qwait;              /* steps to wait before an order change */
+  int *cvb_L;                  /* q + 1                                */
+  int *cvb_qu;                 /* last successful orders               */
+  int *cvb_nflag;              /* FIRST_CALL, PREV_CONV_FAIL, ...      */
+  int *cvb_ncf;                /* conv. failures in this step attempt  */
+  int *cvb_nef;                /* error test failures in this attempt  */
+  int *cvb_state;              /* CVB_RUNNING, CVB_REACHED, CVB_FAILED */
+  int *cvb_status;             /* flag returned for each system        */
+  int *cvb_nls;                /* Newton status (CVB_NLS_*)            */
+  int *cvb_m;                  /* current Newton iteration             */
+  int *cvb_convfail;           /* CV_NO_FAILURES, CV_FAIL_BAD_J, ...   */
+  booleantype *cvb_newstep;    /* starting a new step                  */
+  booleantype *cvb_callSetup;  /* needs a linear solver setup          */
+  booleantype *cvb_jbad;       /* needs a new Jacobian                 */
+  booleantype *cvb_jcur;       /* Jacobian is current                  */
+  booleantype *cvb_hasJ;       /* savedJ holds a Jacobian              */
+  booleantype *cvb_reload;     /* zn[1] must be reloaded from f        */
+
+  long int *cvb_nst;           /* steps taken                          */
+  long int *cvb_nstloc;        /* steps taken in this call             */
+  long int *cvb_nstlp;         /* step of the last setup               */
+  long int *cvb_nstlj;         /* step of the last Jacobian            */
+  long int *cvb_netf;          /* error test failures                  */
+  long int *cvb_ncfn;          /* step failures due to the corrector   */
+  long int *cvb_nni;           /* Newton iterations                    */
+  long int *cvb_nnf;           /* Newton convergence failures          */
+
+  /*------------------
+    Batch Counters
+    ------------------*/
+
+  long int cvb_nfe;            /* right-hand side evaluations          */
+  long int cvb_nje;            /* Jacobian evaluations                 */
+  long int cvb_nsetups;        /* linear solver setups                 */
+  long int cvb_nrounds;        /* lockstep rounds                      */
+
+  booleantype cvb_MallocDone;  /* CVodeBatchInit has been called       */
+  booleantype cvb_firststep;   /* no step has been attempted yet       */
+
+} *CVodeBatchMem;
+
+/*
+ * =================================================================
+ *   B A T C H   I N T E R N A L   F U N C T I O N S
+ * =================================================================
+ */
+
+void cvBatchProcessError(CVodeBatchMem cvb_mem, int error_code,
+                         const char *fname, const char *msgfmt, ...);
+
+/*
+ * =================================================================
+ *   B A T C H   E R R O R   M E S S A G E S
+ * =================================================================
+ */
+
+#define MSGCVB_NO_MEM "cvbatch_mem = NULL illegal."
+#define MSGCVB_BAD_NSYS "nsys <= 0 or neq <= 0 illegal."
+#define MSGCVB_BAD_Y0 "y0 must have length nsys*neq and provide an array pointer."
+#define MSGCVB_NO_LS "No linear solver has been attached."
+#define MSGCVB_BAD_LS "The linear solver must be a SUNLINSOL_BLOCKDENSE solver for a SUNMATRIX_BLOCKDENSE matrix with nsys blocks of size neq."
+#define MSGCVB_SYS_FAILED "At least one system failed, see CVodeBatchGetStatus."
+#define MSGCVB_RHSFUNC_FAILED "At " MSG_TIME ", the right-hand side routine failed in an unrecoverable manner."
+#define MSGCVB_JACFUNC_FAILED "At " MSG_TIME ", the Jacobian routine failed in an unrecoverable manner."
+#define MSGCVB_SOLVE_FAILED "At " MSG_TIME ", the linear solver failed in an unrecoverable manner."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
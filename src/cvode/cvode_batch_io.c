@@ -0,0 +1,411 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the optional input and output
+ * functions of the batched mode of CVODE.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cvode_batch_impl.h"
+#include <sundials/sundials_math.h>
+#include <sunmatrix/sunmatrix_blockdense.h>
+
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+
+/*
+ * =================================================================
+ * CVODE BATCH optional input functions
+ * =================================================================
+ */
+
+/*
+ * CVodeBatchSetLinearSolver
+ *
+ * Attaches a SUNLINSOL_BLOCKDENSE linear solver and a
+ * SUNMATRIX_BLOCKDENSE matrix with one block per system. The matrix
+ * is used to store the Newton matrices of all systems.
+ */
+
+int CVodeBatchSetLinearSolver(void *cvbatch_mem, SUNLinearSolver LS,
+                              SUNMatrix A)
+{
+  CVodeBatchMem cvb_mem;
+  int retval, s;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchSetLinearSolver",
+                        MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  if ((LS == NULL) || (A == NULL) ||
+      (SUNLinSolGetID(LS) != SUNLINEARSOLVER_BLOCKDENSE) ||
+      (SUNMatGetID(A) != SUNMATRIX_BLOCKDENSE) ||
+      (SUNBlockDenseMatrix_NumBlocks(A) != cvb_mem->cvb_nsys) ||
+      (SUNBlockDenseMatrix_BlockRows(A) != cvb_mem->cvb_neq) ||
+      (SUNBlockDenseMatrix_BlockColumns(A) != cvb_mem->cvb_neq)) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchSetLinearSolver",
+                        MSGCVB_BAD_LS);
+    return(CV_ILL_INPUT);
+  }
+
+  retval = SUNLinSolInitialize(LS);
+  if (retval != SUNLS_SUCCESS) {
+    cvBatchProcessError(cvb_mem, CV_LINIT_FAIL, "CVodeBatchSetLinearSolver",
+                        MSGCV_LINIT_FAIL);
+    return(CV_LINIT_FAIL);
+  }
+
+  /* Storage for the saved Jacobians (the padding blocks stay zero) */
+  if (cvb_mem->cvb_savedJ != NULL) SUNMatDestroy(cvb_mem->cvb_savedJ);
+  cvb_mem->cvb_savedJ = SUNMatClone(A);
+  if (cvb_mem->cvb_savedJ == NULL) {
+    cvBatchProcessError(cvb_mem, CV_MEM_FAIL, "CVodeBatchSetLinearSolver",
+                        MSGCV_MEM_FAIL);
+    return(CV_MEM_FAIL);
+  }
+  SUNMatZero(cvb_mem->cvb_savedJ);
+
+  cvb_mem->cvb_LS   = LS;
+  cvb_mem->cvb_A    = A;
+  cvb_mem->cvb_Abad = SUNTRUE;
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) cvb_mem->cvb_hasJ[s] = SUNFALSE;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVodeBatchSetJacFn
+ *
+ * Specifies the Jacobian function. A NULL jac selects the internal
+ * difference quotient approximation.
+ */
+
+int CVodeBatchSetJacFn(void *cvbatch_mem, CVBatchJacFn jac)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchSetJacFn",
+                        MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  cvb_mem->cvb_jac = jac;
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchSetUserData(void *cvbatch_mem, void *user_data)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchSetUserData",
+                        MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  cvb_mem->cvb_user_data = user_data;
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchSetErrFile(void *cvbatch_mem, FILE *errfp)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchSetErrFile",
+                        MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  cvb_mem->cvb_errfp = errfp;
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchSetMaxOrd(void *cvbatch_mem, int maxord)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchSetMaxOrd",
+                        MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  if (maxord <= 0) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchSetMaxOrd",
+                        MSGCV_NEG_MAXORD);
+    return(CV_ILL_INPUT);
+  }
+
+  /* Cannot increase maximum order beyond the value that was used when
+     allocating memory */
+  if (cvb_mem->cvb_MallocDone && (maxord > cvb_mem->cvb_qmax)) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchSetMaxOrd",
+                        MSGCV_BAD_MAXORD);
+    return(CV_ILL_INPUT);
+  }
+
+  cvb_mem->cvb_qmax = SUNMIN(maxord, BDF_Q_MAX);
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchSetMaxNumSteps(void *cvbatch_mem, long int mxsteps)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchSetMaxNumSteps",
+                        MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  /* Passing mxsteps=0 sets the default. Passing mxsteps<0 disables the test. */
+  if (mxsteps == 0)
+    cvb_mem->cvb_mxstep = MXSTEP_DEFAULT;
+  else
+    cvb_mem->cvb_mxstep = mxsteps;
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchSetInitStep(void *cvbatch_mem, realtype hin)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchSetInitStep",
+                        MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  cvb_mem->cvb_hin = hin;
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchSetMaxStep(void *cvbatch_mem, realtype hmax)
+{
+  CVodeBatchMem cvb_mem;
+
+  if (cvbatch_mem == NULL) {
+    cvBatchProcessError(NULL, CV_MEM_NULL, "CVodeBatchSetMaxStep",
+                        MSGCVB_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+  if (hmax < ZERO) {
+    cvBatchProcessError(cvb_mem, CV_ILL_INPUT, "CVodeBatchSetMaxStep",
+                        MSGCV_NEG_HMAX);
+    return(CV_ILL_INPUT);
+  }
+
+  /* Passing 0 sets hmax = infinity */
+  cvb_mem->cvb_hmax_inv = (hmax == ZERO) ? HMAX_INV_DEFAULT : ONE / hmax;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * =================================================================
+ * CVODE BATCH optional output functions
+ * =================================================================
+ */
+
+/* Checks the memory pointer for the getters below */
+#define CVB_GET_MEM(fname)                                        \
+  if (cvbatch_mem == NULL) {                                      \
+    cvBatchProcessError(NULL, CV_MEM_NULL, fname, MSGCVB_NO_MEM); \
+    return(CV_MEM_NULL);                                          \
+  }                                                               \
+  cvb_mem = (CVodeBatchMem) cvbatch_mem;
+
+int CVodeBatchGetStatus(void *cvbatch_mem, int *status)
+{
+  CVodeBatchMem cvb_mem;
+  int s;
+
+  CVB_GET_MEM("CVodeBatchGetStatus");
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) status[s] = cvb_mem->cvb_status[s];
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetNumSteps(void *cvbatch_mem, long int *nsteps)
+{
+  CVodeBatchMem cvb_mem;
+  int s;
+
+  CVB_GET_MEM("CVodeBatchGetNumSteps");
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) nsteps[s] = cvb_mem->cvb_nst[s];
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetNumErrTestFails(void *cvbatch_mem, long int *netfails)
+{
+  CVodeBatchMem cvb_mem;
+  int s;
+
+  CVB_GET_MEM("CVodeBatchGetNumErrTestFails");
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) netfails[s] = cvb_mem->cvb_netf[s];
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetNumNonlinSolvIters(void *cvbatch_mem, long int *nniters)
+{
+  CVodeBatchMem cvb_mem;
+  int s;
+
+  CVB_GET_MEM("CVodeBatchGetNumNonlinSolvIters");
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) nniters[s] = cvb_mem->cvb_nni[s];
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetNumNonlinSolvConvFails(void *cvbatch_mem, long int *nnfails)
+{
+  CVodeBatchMem cvb_mem;
+  int s;
+
+  CVB_GET_MEM("CVodeBatchGetNumNonlinSolvConvFails");
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) nnfails[s] = cvb_mem->cvb_nnf[s];
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetLastOrder(void *cvbatch_mem, int *qlast)
+{
+  CVodeBatchMem cvb_mem;
+  int s;
+
+  CVB_GET_MEM("CVodeBatchGetLastOrder");
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) qlast[s] = cvb_mem->cvb_qu[s];
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetCurrentOrder(void *cvbatch_mem, int *qcur)
+{
+  CVodeBatchMem cvb_mem;
+  int s;
+
+  CVB_GET_MEM("CVodeBatchGetCurrentOrder");
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) qcur[s] = cvb_mem->cvb_qprime[s];
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetLastStep(void *cvbatch_mem, realtype *hlast)
+{
+  CVodeBatchMem cvb_mem;
+  int s;
+
+  CVB_GET_MEM("CVodeBatchGetLastStep");
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) hlast[s] = cvb_mem->cvb_hu[s];
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetCurrentStep(void *cvbatch_mem, realtype *hcur)
+{
+  CVodeBatchMem cvb_mem;
+  int s;
+
+  CVB_GET_MEM("CVodeBatchGetCurrentStep");
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++)
+    hcur[s] = (cvb_mem->cvb_nst[s] > 0) ? cvb_mem->cvb_hprime[s] :
+      cvb_mem->cvb_h[s];
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetCurrentTime(void *cvbatch_mem, realtype *tcur)
+{
+  CVodeBatchMem cvb_mem;
+  int s;
+
+  CVB_GET_MEM("CVodeBatchGetCurrentTime");
+
+  for (s = 0; s < cvb_mem->cvb_nsys; s++) tcur[s] = cvb_mem->cvb_tn[s];
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetNumRhsEvals(void *cvbatch_mem, long int *nfevals)
+{
+  CVodeBatchMem cvb_mem;
+
+  CVB_GET_MEM("CVodeBatchGetNumRhsEvals");
+
+  *nfevals = cvb_mem->cvb_nfe;
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetNumJacEvals(void *cvbatch_mem, long int *njevals)
+{
+  CVodeBatchMem cvb_mem;
+
+  CVB_GET_MEM("CVodeBatchGetNumJacEvals");
+
+  *njevals = cvb_mem->cvb_nje;
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetNumLinSolvSetups(void *cvbatch_mem, long int *nlinsetups)
+{
+  CVodeBatchMem cvb_mem;
+
+  CVB_GET_MEM("CVodeBatchGetNumLinSolvSetups");
+
+  *nlinsetups = cvb_mem->cvb_nsetups;
+
+  return(CV_SUCCESS);
+}
+
+int CVodeBatchGetNumRounds(void *cvbatch_mem, long int *nrounds)
+{
+  CVodeBatchMem cvb_mem;
+
+  CVB_GET_MEM("CVodeBatchGetNumRounds");
+
+  *nrounds = cvb_mem->cvb_nrounds;
+
+  return(CV_SUCCESS);
+}
@@ -18,6 +18,9 @@
  * band-block-diagonal preconditioner, i.e. a block-diagonal
  * matrix with banded blocks, for use with CVODE, the CVLS linear
  * solver interface, and the MPI-parallel implementation of NVECTOR.
+ * The sparse variant keeps sparse local blocks computed by colored
+ * difference quotients, split in sub-blocks that are factored and
+ * solved independently (see cvode_bbdpre_threads.c).
  * -----------------------------------------------------------------
  */
 
@@ -44,13 +47,26 @@ static int CVBBDPrecSolve(realtype t, N_Vector y, N_Vector fy,
                           realtype gamma, realtype delta,
                           int lr, void *bbd_data);
 
-/* Prototype for CVBBDPrecFree */
+/* Prototypes of functions CVBBDSparsePrecSetup and CVBBDSparsePrecSolve */
+static int CVBBDSparsePrecSetup(realtype t, N_Vector y, N_Vector fy,
+                                booleantype jok, booleantype *jcurPtr,
+                                realtype gamma, void *bbd_data);
+static int CVBBDSparsePrecSolve(realtype t, N_Vector y, N_Vector fy,
+                                N_Vector r, N_Vector z,
+                                realtype gamma, realtype delta,
+                                int lr, void *bbd_data);
+
+/* Prototypes for CVBBDPrecFree and CVBBDPrecFreeData */
 static int CVBBDPrecFree(CVodeMem cv_mem);
+static void CVBBDPrecFreeData(CVBBDPrecData pdata);
 
 /* Prototype for difference quotient Jacobian calculation routine */
 static int CVBBDDQJac(CVBBDPrecData pdata, realtype t,
                       N_Vector y, N_Vector gy,
                       N_Vector ytemp, N_Vector gtemp);
+static int CVBBDSparseDQJac(CVBBDPrecData pdata, realtype t,
+                            N_Vector y, N_Vector gy,
+                            N_Vector ytemp, N_Vector gtemp);
 
 /*-----------------------------------------------------------------
   User-Callable Functions: initialization, reinit and free
@@ -109,6 +125,19 @@ int CVBBDPrecInit(void *cvode_mem, sunindextype Nlocal,
   pdata->mukeep = muk;
   pdata->mlkeep = mlk;
 
+  /* The local block is banded */
+  pdata->sparse = SUNFALSE;
+  pdata->nsub   = 0;
+  pdata->nthreads = 1;
+  pdata->suboff = NULL;
+  pdata->colors = NULL;
+  pdata->dqinc  = NULL;
+  pdata->subJ   = NULL;
+  pdata->subP   = NULL;
+  pdata->subLS  = NULL;
+  pdata->zsub   = NULL;
+  pdata->rsub   = NULL;
+
   /* Allocate memory for saved Jacobian */
   pdata->savedJ = SUNBandMatrixStorage(Nlocal, muk, mlk, muk, cv_mem->cv_sunctx);
   if (pdata->savedJ == NULL) {
@@ -280,6 +309,220 @@ int CVBBDPrecInit(void *cvode_mem, sunindextype Nlocal,
   return(flag);
 }
 
+int CVBBDPrecInitSparse(void *cvode_mem, sunindextype Nlocal,
+                        SUNMatrix Jpattern, int nsub,
+                        CVBBDLinSolFn lsfn, realtype dqrely,
+                        CVLocalFn gloc, CVCommFn cfn)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  CVBBDPrecData pdata;
+  sunindextype lrw1, liw1, ncolors;
+  long int lrw, liw;
+  int b, flag;
+
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CVLS_MEM_NULL, "CVBBDPRE",
+                   "CVBBDPrecInitSparse", MSGBBD_MEM_NULL);
+    return(CVLS_MEM_NULL);
+  }
+  cv_mem = (CVodeMem) cvode_mem;
+
+  /* Test if the CVLS linear solver interface has been created */
+  if (cv_mem->cv_lmem == NULL) {
+    cvProcessError(cv_mem, CVLS_LMEM_NULL, "CVBBDPRE",
+                   "CVBBDPrecInitSparse", MSGBBD_LMEM_NULL);
+    return(CVLS_LMEM_NULL);
+  }
+  cvls_mem = (CVLsMem) cv_mem->cv_lmem;
+
+  /* Test compatibility of NVECTOR package with the BBD preconditioner */
+  if(cv_mem->cv_tempv->ops->nvgetarraypointer == NULL) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVBBDPRE",
+                   "CVBBDPrecInitSparse", MSGBBD_BAD_NVECTOR);
+    return(CVLS_ILL_INPUT);
+  }
+
+  /* Test the pattern of the local block */
+  if ( (Nlocal < 1) || (Jpattern == NULL) ||
+       (SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(Jpattern) != Nlocal) ||
+       (SUNSparseMatrix_Columns(Jpattern) != Nlocal) ) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVBBDPRE",
+                   "CVBBDPrecInitSparse", MSGBBD_BAD_MATRIX);
+    return(CVLS_ILL_INPUT);
+  }
+
+  /* By default the local block is not split */
+  if (nsub < 1) nsub = 1;
+  if (nsub > Nlocal) nsub = (int) Nlocal;
+
+  /* Allocate data memory */
+  pdata = NULL;
+  pdata = (CVBBDPrecData) malloc(sizeof *pdata);
+  if (pdata == NULL) {
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVBBDPRE",
+                   "CVBBDPrecInitSparse", MSGBBD_MEM_FAIL);
+    return(CVLS_MEM_FAIL);
+  }
+
+  /* Set pointers to gloc and cfn, the banded data is not used */
+  pdata->cvode_mem = cvode_mem;
+  pdata->gloc = gloc;
+  pdata->cfn = cfn;
+  pdata->mudq = pdata->mldq = pdata->mukeep = pdata->mlkeep = 0;
+  pdata->savedJ = NULL;
+  pdata->savedP = NULL;
+  pdata->LS = NULL;
+  pdata->zlocal = NULL;
+  pdata->rlocal = NULL;
+  pdata->n_local = Nlocal;
+
+  /* Allocate the sub-block arrays */
+  pdata->sparse = SUNTRUE;
+  pdata->nsub   = nsub;
+  pdata->nthreads = 1;
+  pdata->suboff = (sunindextype *) malloc((nsub+1)*sizeof(sunindextype));
+  pdata->colors = (sunindextype *) malloc(Nlocal*sizeof(sunindextype));
+  pdata->dqinc  = (realtype *) malloc(Nlocal*sizeof(realtype));
+  pdata->subJ   = (SUNMatrix *) calloc(nsub, sizeof(SUNMatrix));
+  pdata->subP   = (SUNMatrix *) calloc(nsub, sizeof(SUNMatrix));
+  pdata->subLS  = (SUNLinearSolver *) calloc(nsub, sizeof(SUNLinearSolver));
+  pdata->zsub   = (N_Vector *) calloc(nsub, sizeof(N_Vector));
+  pdata->rsub   = (N_Vector *) calloc(nsub, sizeof(N_Vector));
+  pdata->tmp1   = N_VClone(cv_mem->cv_tempv);
+  pdata->tmp2   = N_VClone(cv_mem->cv_tempv);
+  pdata->tmp3   = N_VClone(cv_mem->cv_tempv);
+  if ( (pdata->suboff == NULL) || (pdata->colors == NULL) ||
+       (pdata->dqinc == NULL) || (pdata->subJ == NULL) ||
+       (pdata->subP == NULL) || (pdata->subLS == NULL) ||
+       (pdata->zsub == NULL) || (pdata->rsub == NULL) ||
+       (pdata->tmp1 == NULL) || (pdata->tmp2 == NULL) ||
+       (pdata->tmp3 == NULL) ) {
+    CVBBDPrecFreeData(pdata);
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVBBDPRE",
+                   "CVBBDPrecInitSparse", MSGBBD_MEM_FAIL);
+    return(CVLS_MEM_FAIL);
+  }
+
+  /* Split the local block in sub-blocks of contiguous rows, the entries
+     coupling different sub-blocks are dropped */
+  for (b=0; b<=nsub; b++)
+    pdata->suboff[b] = (b*Nlocal)/nsub;
+
+  flag = SUNSparseMatrix_DiagonalBlocks(Jpattern, nsub, pdata->suboff,
+                                        pdata->subJ);
+  if (flag != SUNMAT_SUCCESS) {
+    CVBBDPrecFreeData(pdata);
+    cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, "CVBBDPRE",
+                   "CVBBDPrecInitSparse", MSGBBD_SPMAT_FAIL);
+    return(CVLS_SUNMAT_FAIL);
+  }
+
+  /* Color the columns of each sub-block, the rows of different sub-blocks
+     are disjoint so they may share colors */
+  pdata->ncolors = 0;
+  for (b=0; b<nsub; b++) {
+    flag = SUNSparseMatrix_ColorColumns(pdata->subJ[b],
+                                        pdata->colors + pdata->suboff[b],
+                                        &ncolors);
+    if (flag != SUNMAT_SUCCESS) {
+      CVBBDPrecFreeData(pdata);
+      cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, "CVBBDPRE",
+                     "CVBBDPrecInitSparse", MSGBBD_SPMAT_FAIL);
+      return(CVLS_SUNMAT_FAIL);
+    }
+    pdata->ncolors = SUNMAX(pdata->ncolors, ncolors);
+  }
+
+  /* Create the preconditioner matrix, local vectors and linear solver of
+     each sub-block */
+  for (b=0; b<nsub; b++) {
+    pdata->subP[b] = SUNMatClone(pdata->subJ[b]);
+    pdata->zsub[b] = N_VNewEmpty_Serial(pdata->suboff[b+1] - pdata->suboff[b],
+                                        cv_mem->cv_sunctx);
+    pdata->rsub[b] = N_VNewEmpty_Serial(pdata->suboff[b+1] - pdata->suboff[b],
+                                        cv_mem->cv_sunctx);
+    if ( (pdata->subP[b] == NULL) || (pdata->zsub[b] == NULL) ||
+         (pdata->rsub[b] == NULL) ) {
+      CVBBDPrecFreeData(pdata);
+      cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVBBDPRE",
+                     "CVBBDPrecInitSparse", MSGBBD_MEM_FAIL);
+      return(CVLS_MEM_FAIL);
+    }
+    flag = SUNMatCopy(pdata->subJ[b], pdata->subP[b]);
+    if (flag != SUNMAT_SUCCESS) {
+      CVBBDPrecFreeData(pdata);
+      cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, "CVBBDPRE",
+                     "CVBBDPrecInitSparse", MSGBBD_SPMAT_FAIL);
+      return(CVLS_SUNMAT_FAIL);
+    }
+
+    if (lsfn != NULL)
+      pdata->subLS[b] = lsfn(pdata->rsub[b], pdata->subP[b],
+                             cv_mem->cv_sunctx);
+    else
+      pdata->subLS[b] = SUNLinSol_ILU(pdata->rsub[b], pdata->subP[b], 0,
+                                      cv_mem->cv_sunctx);
+    if (pdata->subLS[b] == NULL) {
+      CVBBDPrecFreeData(pdata);
+      cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVBBDPRE",
+                     "CVBBDPrecInitSparse", MSGBBD_MEM_FAIL);
+      return(CVLS_MEM_FAIL);
+    }
+    flag = SUNLinSolInitialize(pdata->subLS[b]);
+    if (flag != SUNLS_SUCCESS) {
+      CVBBDPrecFreeData(pdata);
+      cvProcessError(cv_mem, CVLS_SUNLS_FAIL, "CVBBDPRE",
+                     "CVBBDPrecInitSparse", MSGBBD_SPLS_FAIL);
+      return(CVLS_SUNLS_FAIL);
+    }
+  }
+
+  /* Set pdata->dqrely based on input dqrely (0 implies default). */
+  pdata->dqrely = (dqrely > ZERO) ?
+    dqrely : SUNRsqrt(cv_mem->cv_uround);
+
+  /* Set work space sizes and initialize nge */
+  pdata->rpwsize = Nlocal;
+  pdata->ipwsize = Nlocal + nsub + 1;
+  if (cv_mem->cv_tempv->ops->nvspace) {
+    N_VSpace(cv_mem->cv_tempv, &lrw1, &liw1);
+    pdata->rpwsize += 3*lrw1;
+    pdata->ipwsize += 3*liw1;
+  }
+  for (b=0; b<nsub; b++) {
+    if (pdata->subJ[b]->ops->space) {
+      flag = SUNMatSpace(pdata->subJ[b], &lrw, &liw);
+      pdata->rpwsize += 2*lrw;
+      pdata->ipwsize += 2*liw;
+    }
+    if (pdata->subLS[b]->ops->space) {
+      flag = SUNLinSolSpace(pdata->subLS[b], &lrw, &liw);
+      pdata->rpwsize += lrw;
+      pdata->ipwsize += liw;
+    }
+  }
+  pdata->nge = 0;
+
+  /* make sure P_data is free from any previous allocations */
+  if (cvls_mem->pfree)
+    cvls_mem->pfree(cv_mem);
+
+  /* Point to the new P_data field in the LS memory */
+  cvls_mem->P_data = pdata;
+
+  /* Attach the pfree function */
+  cvls_mem->pfree = CVBBDPrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = CVodeSetPreconditioner(cvode_mem,
+                                CVBBDSparsePrecSetup,
+                                CVBBDSparsePrecSolve);
+  return(flag);
+}
+
+
 
 int CVBBDPrecReInit(void *cvode_mem, sunindextype mudq,
                     sunindextype mldq, realtype dqrely)
@@ -312,7 +555,7 @@ int CVBBDPrecReInit(void *cvode_mem, sunindextype mudq,
   }
   pdata = (CVBBDPrecData) cvls_mem->P_data;
 
-  /* Load half-bandwidths */
+  /* Load half-bandwidths (not used with a sparse local block) */
   Nlocal = pdata->n_local;
   pdata->mudq = SUNMIN(Nlocal-1, SUNMAX(0,mudq));
   pdata->mldq = SUNMIN(Nlocal-1, SUNMAX(0,mldq));
@@ -575,6 +818,36 @@ static int CVBBDPrecFree(CVodeMem cv_mem)
   if (cvls_mem->P_data == NULL) return(0);
   pdata = (CVBBDPrecData) cvls_mem->P_data;
 
+  CVBBDPrecFreeData(pdata);
+  pdata = NULL;
+
+  return(0);
+}
+
+
+/* Free the preconditioner data of either kind of local block */
+static void CVBBDPrecFreeData(CVBBDPrecData pdata)
+{
+  int b;
+
+  if (pdata->sparse) {
+    for (b=0; b<pdata->nsub; b++) {
+      if (pdata->subLS) SUNLinSolFree(pdata->subLS[b]);
+      if (pdata->subP)  SUNMatDestroy(pdata->subP[b]);
+      if (pdata->subJ)  SUNMatDestroy(pdata->subJ[b]);
+      if (pdata->zsub)  N_VDestroy(pdata->zsub[b]);
+      if (pdata->rsub)  N_VDestroy(pdata->rsub[b]);
+    }
+    free(pdata->suboff);
+    free(pdata->colors);
+    free(pdata->dqinc);
+    free(pdata->subLS);
+    free(pdata->subP);
+    free(pdata->subJ);
+    free(pdata->zsub);
+    free(pdata->rsub);
+  }
+
   SUNLinSolFree(pdata->LS);
   N_VDestroy(pdata->tmp1);
   N_VDestroy(pdata->tmp2);
@@ -585,9 +858,82 @@ static int CVBBDPrecFree(CVodeMem cv_mem)
   SUNMatDestroy(pdata->savedJ);
 
   free(pdata);
-  pdata = NULL;
+}
 
-  return(0);
+
+/*-----------------------------------------------------------------
+  Function : CVBBDSparsePrecSetup
+  -----------------------------------------------------------------
+  CVBBDSparsePrecSetup is the setup routine of the preconditioner
+  created by CVBBDPrecInitSparse. It calculates a new sparse J by
+  colored difference quotients if jok == SUNFALSE, then forms
+  P = I - gamma*J on each sub-block of the local block and
+  factors it with the sub-block linear solver.
+
+  The parameters and return values are the same as for
+  CVBBDPrecSetup.
+  -----------------------------------------------------------------*/
+static int CVBBDSparsePrecSetup(realtype t, N_Vector y, N_Vector fy,
+                                booleantype jok, booleantype *jcurPtr,
+                                realtype gamma, void *bbd_data)
+{
+  CVBBDPrecData pdata;
+  CVodeMem cv_mem;
+  int retval, matfail;
+
+  pdata = (CVBBDPrecData) bbd_data;
+  cv_mem = (CVodeMem) pdata->cvode_mem;
+
+  /* If jok = SUNTRUE, use saved copy of J, otherwise compute a new one */
+  if (jok) {
+    *jcurPtr = SUNFALSE;
+  } else {
+    *jcurPtr = SUNTRUE;
+    retval = CVBBDSparseDQJac(pdata, t, y, pdata->tmp1,
+                              pdata->tmp2, pdata->tmp3);
+    if (retval < 0) {
+      cvProcessError(cv_mem, -1, "CVBBDPRE", "CVBBDSparsePrecSetup",
+                     MSGBBD_FUNC_FAILED);
+      return(-1);
+    }
+    if (retval > 0) {
+      return(1);
+    }
+  }
+
+  /* Form P = I - gamma*J and factor each sub-block */
+  retval = cvBBDSparseFactorBlocks(pdata, gamma, &matfail);
+
+  if (matfail) {
+    cvProcessError(cv_mem, -1, "CVBBDPRE",
+                   "CVBBDSparsePrecSetup", MSGBBD_SPMAT_FAIL);
+    return(-1);
+  }
+
+  return(retval);
+}
+
+
+/*-----------------------------------------------------------------
+  Function : CVBBDSparsePrecSolve
+  -----------------------------------------------------------------
+  CVBBDSparsePrecSolve solves a linear system P z = r, with the
+  block-diagonal preconditioner matrix generated and factored by
+  CVBBDSparsePrecSetup. The local parts of r and z are attached
+  to the sub-block vectors and the sub-block systems are solved
+  independently.
+  -----------------------------------------------------------------*/
+static int CVBBDSparsePrecSolve(realtype t, N_Vector y, N_Vector fy,
+                                N_Vector r, N_Vector z,
+                                realtype gamma, realtype delta,
+                                int lr, void *bbd_data)
+{
+  CVBBDPrecData pdata;
+
+  pdata = (CVBBDPrecData) bbd_data;
+
+  return(cvBBDSparseSolveBlocks(pdata, N_VGetArrayPointer(r),
+                                N_VGetArrayPointer(z)));
 }
 
 
@@ -702,3 +1048,121 @@ static int CVBBDDQJac(CVBBDPrecData pdata, realtype t, N_Vector y,
 
   return(0);
 }
+
+
+/*-----------------------------------------------------------------
+  Function : CVBBDSparseDQJac
+  -----------------------------------------------------------------
+  This routine generates a sparse difference quotient approximation
+  to the sub-blocks of the local block of the Jacobian of g(t,y).
+  The columns of the sub-blocks are colored so that columns of one
+  color do not share any rows, and all y_j of a color are perturbed
+  together. The number of calls to gloc is therefore the number of
+  colors plus one, independently of the bandwidth of the block.
+  -----------------------------------------------------------------*/
+static int CVBBDSparseDQJac(CVBBDPrecData pdata, realtype t, N_Vector y,
+                            N_Vector gy, N_Vector ytemp, N_Vector gtemp)
+{
+  CVodeMem cv_mem;
+  realtype gnorm, minInc, inc, conj;
+  sunindextype color, b, i, j, p, s, nb;
+  sunindextype *colors, *Jp, *Ji;
+  realtype *y_data, *ewt_data, *gy_data, *gtemp_data;
+  realtype *ytemp_data, *cns_data, *inc_data, *J_data;
+  int retval;
+
+  /* initialize cns_data to avoid compiler warning */
+  cns_data = NULL;
+
+  cv_mem = (CVodeMem) pdata->cvode_mem;
+
+  /* Load ytemp with y = predicted solution vector */
+  N_VScale(ONE, y, ytemp);
+
+  /* Call cfn and gloc to get base value of g(t,y) */
+  if (pdata->cfn != NULL) {
+    retval = pdata->cfn(pdata->n_local, t, y, cv_mem->cv_user_data);
+    if (retval != 0) return(retval);
+  }
+
+  retval = pdata->gloc(pdata->n_local, t, ytemp, gy,
+                       cv_mem->cv_user_data);
+  pdata->nge++;
+  if (retval != 0) return(retval);
+
+  /* Obtain pointers to the data for various vectors */
+  y_data     =  N_VGetArrayPointer(y);
+  gy_data    =  N_VGetArrayPointer(gy);
+  ewt_data   =  N_VGetArrayPointer(cv_mem->cv_ewt);
+  ytemp_data =  N_VGetArrayPointer(ytemp);
+  gtemp_data =  N_VGetArrayPointer(gtemp);
+  if (cv_mem->cv_constraintsSet)
+    cns_data =  N_VGetArrayPointer(cv_mem->cv_constraints);
+  colors   = pdata->colors;
+  inc_data = pdata->dqinc;
+
+  /* Set minimum increment based on uround and norm of g */
+  gnorm = N_VWrmsNorm(gy, cv_mem->cv_ewt);
+  minInc = (gnorm != ZERO) ?
+    (MIN_INC_MULT * SUNRabs(cv_mem->cv_h) *
+     cv_mem->cv_uround * pdata->n_local * gnorm) : ONE;
+
+  /* Compute the increment for each column */
+  for (j=0; j < pdata->n_local; j++) {
+    inc = SUNMAX(pdata->dqrely * SUNRabs(y_data[j]), minInc/ewt_data[j]);
+
+    /* Adjust sign(inc) if yj has an inequality constraint. */
+    if (cv_mem->cv_constraintsSet) {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)      {if ((y_data[j]+inc)*conj < ZERO)  inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if ((y_data[j]+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    inc_data[j] = inc;
+  }
+
+  /* Loop over column colors */
+  for (color=0; color < pdata->ncolors; color++) {
+
+    /* Increment all y_j of this color */
+    for (j=0; j < pdata->n_local; j++)
+      if (colors[j] == color) ytemp_data[j] += inc_data[j];
+
+    /* Evaluate g with incremented y */
+    retval = pdata->gloc(pdata->n_local, t, ytemp, gtemp,
+                         cv_mem->cv_user_data);
+    pdata->nge++;
+    if (retval != 0) return(retval);
+
+    /* Restore ytemp, then form and load difference quotients */
+    for (j=0; j < pdata->n_local; j++)
+      if (colors[j] == color) ytemp_data[j] = y_data[j];
+
+    for (b=0; b < pdata->nsub; b++) {
+      s      = pdata->suboff[b];
+      nb     = pdata->suboff[b+1] - s;
+      Jp     = SUNSparseMatrix_IndexPointers(pdata->subJ[b]);
+      Ji     = SUNSparseMatrix_IndexValues(pdata->subJ[b]);
+      J_data = SUNSparseMatrix_Data(pdata->subJ[b]);
+      if (SUNSparseMatrix_SparseType(pdata->subJ[b]) == CSC_MAT) {
+        for (j=0; j < nb; j++) {
+          if (colors[s+j] != color) continue;
+          for (p=Jp[j]; p < Jp[j+1]; p++) {
+            i = s + Ji[p];
+            J_data[p] = (gtemp_data[i] - gy_data[i]) / inc_data[s+j];
+          }
+        }
+      } else {
+        for (i=0; i < nb; i++) {
+          for (p=Jp[i]; p < Jp[i+1]; p++) {
+            j = s + Ji[p];
+            if (colors[j] == color)
+              J_data[p] = (gtemp_data[s+i] - gy_data[s+i]) / inc_data[j];
+          }
+        }
+      }
+    }
+  }
+
+  return(0);
+}
@@ -23,6 +23,8 @@
 #include <cvode/cvode_bbdpre.h>
 #include <sunmatrix/sunmatrix_band.h>
 #include <sunlinsol/sunlinsol_band.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+#include <sunlinsol/sunlinsol_ilu.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
 extern "C" {
@@ -53,6 +55,21 @@ typedef struct CVBBDPrecDataRec {
   /* set by CVBBDPrecInit and used by CVBBDPrecSetup */
   sunindextype n_local;
 
+  /* set by CVBBDPrecInitSparse for a sparse local block split in nsub
+     diagonal sub-blocks starting at the rows suboff */
+  booleantype sparse;
+  int nsub;
+  int nthreads;
+  sunindextype *suboff;
+  sunindextype *colors;
+  sunindextype ncolors;
+  realtype *dqinc;
+  SUNMatrix *subJ;
+  SUNMatrix *subP;
+  SUNLinearSolver *subLS;
+  N_Vector *zsub;
+  N_Vector *rsub;
+
   /* available for optional output */
   long int rpwsize;
   long int ipwsize;
@@ -63,6 +80,21 @@ typedef struct CVBBDPrecDataRec {
 
 } *CVBBDPrecData;
 
+/*-----------------------------------------------------------------
+  Sub-block loops of the sparse variant (cvode_bbdpre_threads.c),
+  both return an unrecoverable sub-block solver failure first,
+  then a recoverable one
+  -----------------------------------------------------------------*/
+
+/* Forms P = I - gamma*J and factors every sub-block, matfail is set
+   if a matrix operation failed */
+int cvBBDSparseFactorBlocks(CVBBDPrecData pdata, realtype gamma,
+                            int *matfail);
+
+/* Solves P z = r on every sub-block */
+int cvBBDSparseSolveBlocks(CVBBDPrecData pdata, realtype *rdata,
+                           realtype *zdata);
+
 /*-----------------------------------------------------------------
   CVBBDPRE error messages
   -----------------------------------------------------------------*/
@@ -74,6 +106,10 @@ typedef struct CVBBDPrecDataRec {
 #define MSGBBD_SUNMAT_FAIL "An error arose from a SUNBandMatrix routine."
 #define MSGBBD_SUNLS_FAIL  "An error arose from a SUNBandLinearSolver routine."
 #define MSGBBD_PMEM_NULL   "BBD peconditioner memory is NULL. CVBBDPrecInit must be called."
+#define MSGBBD_SPMAT_FAIL  "An error arose from a SUNSparseMatrix routine."
+#define MSGBBD_SPLS_FAIL   "An error arose from a local block linear solver."
+#define MSGBBD_BAD_MATRIX  "The local Jacobian pattern must be a square SUNMATRIX_SPARSE matrix of size Nlocal."
+#define MSGBBD_BAD_THREADS "The number of threads must be positive."
 #define MSGBBD_FUNC_FAILED "The gloc or cfn routine failed in an unrecoverable manner."
 
 #ifdef __cplusplus
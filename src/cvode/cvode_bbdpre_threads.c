@@ -0,0 +1,154 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file contains the sub-block loops of the sparse variant of
+ * the CVBBDPRE preconditioner. The sub-blocks are independent and
+ * are divided among OpenMP threads when a number of threads is set
+ * with CVBBDPrecSetNumThreads and CVODE is built with OpenMP,
+ * otherwise they are processed one after the other.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cvode_impl.h"
+#include "cvode_bbdpre_impl.h"
+#include "cvode_ls_impl.h"
+#include <sundials/sundials_math.h>
+
+#define ZERO RCONST(0.0)
+
+/*-----------------------------------------------------------------
+  Function : CVBBDPrecSetNumThreads
+  -----------------------------------------------------------------
+  CVBBDPrecSetNumThreads sets the number of OpenMP threads among
+  which the sub-blocks of the sparse variant are divided. Without
+  OpenMP the number is stored and the sub-blocks are processed by
+  the calling thread.
+  -----------------------------------------------------------------*/
+int CVBBDPrecSetNumThreads(void *cvode_mem, int num_threads)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  CVBBDPrecData pdata;
+
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CVLS_MEM_NULL, "CVBBDPRE",
+                   "CVBBDPrecSetNumThreads", MSGBBD_MEM_NULL);
+    return(CVLS_MEM_NULL);
+  }
+  cv_mem = (CVodeMem) cvode_mem;
+
+  /* Test if the LS linear solver interface has been created */
+  if (cv_mem->cv_lmem == NULL) {
+    cvProcessError(cv_mem, CVLS_LMEM_NULL, "CVBBDPRE",
+                   "CVBBDPrecSetNumThreads", MSGBBD_LMEM_NULL);
+    return(CVLS_LMEM_NULL);
+  }
+  cvls_mem = (CVLsMem) cv_mem->cv_lmem;
+
+  /* Test if the preconditioner data is non-NULL */
+  if (cvls_mem->P_data == NULL) {
+    cvProcessError(cv_mem, CVLS_PMEM_NULL, "CVBBDPRE",
+                   "CVBBDPrecSetNumThreads", MSGBBD_PMEM_NULL);
+    return(CVLS_PMEM_NULL);
+  }
+  pdata = (CVBBDPrecData) cvls_mem->P_data;
+
+  if (num_threads < 1) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVBBDPRE",
+                   "CVBBDPrecSetNumThreads", MSGBBD_BAD_THREADS);
+    return(CVLS_ILL_INPUT);
+  }
+
+  pdata->nthreads = num_threads;
+
+  return(CVLS_SUCCESS);
+}
+
+/*-----------------------------------------------------------------
+  Function : cvBBDSparseFactorBlocks
+  -----------------------------------------------------------------
+  cvBBDSparseFactorBlocks forms P = I - gamma*J on every sub-block
+  and factors it with the sub-block linear solver. The sub-block
+  solvers own their work memory, so the sub-blocks can be set up
+  concurrently.
+  -----------------------------------------------------------------*/
+int cvBBDSparseFactorBlocks(CVBBDPrecData pdata, realtype gamma,
+                            int *matfail)
+{
+  int b, retval, mfail, lsneg, lspos;
+  int nt = SUNMIN(pdata->nthreads, pdata->nsub);
+
+  mfail = 0;
+  lsneg = 0;
+  lspos = 0;
+#if defined(_OPENMP)
+#pragma omp parallel for private(retval) reduction(max:mfail,lspos) \
+  reduction(min:lsneg) num_threads(nt) if(nt > 1) schedule(dynamic, 1)
+#endif
+  for (b=0; b<pdata->nsub; b++) {
+    retval = SUNMatCopy(pdata->subJ[b], pdata->subP[b]);
+    if (retval == SUNMAT_SUCCESS)
+      retval = SUNMatScaleAddI(-gamma, pdata->subP[b]);
+    if (retval != SUNMAT_SUCCESS) {
+      mfail = 1;
+      continue;
+    }
+    retval = SUNLinSolSetup(pdata->subLS[b], pdata->subP[b]);
+    if (retval < 0) lsneg = SUNMIN(lsneg, retval);
+    if (retval > 0) lspos = SUNMAX(lspos, retval);
+  }
+
+  *matfail = mfail;
+
+  /* Return an unrecoverable failure first, then a recoverable one */
+  return((lsneg < 0) ? lsneg : lspos);
+}
+
+/*-----------------------------------------------------------------
+  Function : cvBBDSparseSolveBlocks
+  -----------------------------------------------------------------
+  cvBBDSparseSolveBlocks attaches the local parts of r and z to the
+  sub-block vectors of each sub-block and solves the sub-block
+  systems.
+  -----------------------------------------------------------------*/
+int cvBBDSparseSolveBlocks(CVBBDPrecData pdata, realtype *rdata,
+                           realtype *zdata)
+{
+  int b, retval, lsneg, lspos;
+  int nt = SUNMIN(pdata->nthreads, pdata->nsub);
+
+  lsneg = 0;
+  lspos = 0;
+#if defined(_OPENMP)
+#pragma omp parallel for private(retval) reduction(max:lspos) \
+  reduction(min:lsneg) num_threads(nt) if(nt > 1) schedule(dynamic, 1)
+#endif
+  for (b=0; b<pdata->nsub; b++) {
+    /* Attach the sub-block data of r and z to rsub and zsub */
+    N_VSetArrayPointer(rdata + pdata->suboff[b], pdata->rsub[b]);
+    N_VSetArrayPointer(zdata + pdata->suboff[b], pdata->zsub[b]);
+
+    retval = SUNLinSolSolve(pdata->subLS[b], pdata->subP[b],
+                            pdata->zsub[b], pdata->rsub[b], ZERO);
+    if (retval < 0) lsneg = SUNMIN(lsneg, retval);
+    if (retval > 0) lspos = SUNMAX(lspos, retval);
+
+    /* Detach the sub-block data */
+    N_VSetArrayPointer(NULL, pdata->rsub[b]);
+    N_VSetArrayPointer(NULL, pdata->zsub[b]);
+  }
+
+  return((lsneg < 0) ? lsneg : lspos);
+}
@@ -356,13 +356,17 @@ static int CVDiagSetup(CVodeMem cv_mem, int convfail, N_Vector ypred,
 
   /* Form y with perturbation = FRACT*(func. iter. correction) */
   r = FRACT * rl1;
+  if (cv_mem->cv_usefusedhost)
+  {
+    cvDiagSetup_formY_host(h, r, fpred, zn[1], ypred, ftemp, y);
+  }
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
-  if (cv_mem->cv_usefused)
+  else if (cv_mem->cv_usefused)
   {
     cvDiagSetup_formY(h, r, fpred, zn[1], ypred, ftemp, y);
   }
-  else
 #endif
+  else
   {
     N_VLinearSum(h, fpred, -ONE, zn[1], ftemp);
     N_VLinearSum(r, ftemp, ONE, ypred, y);
@@ -382,13 +386,17 @@ static int CVDiagSetup(CVodeMem cv_mem, int convfail, N_Vector ypred,
   }
 
   /* Construct M = I - gamma*J with J = diag(deltaf_i/deltay_i) */
+  if (cv_mem->cv_usefusedhost)
+  {
+    cvDiagSetup_buildM_host(FRACT, uround, h, ftemp, fpred, ewt, M);
+  }
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
-  if (cv_mem->cv_usefused)
+  else if (cv_mem->cv_usefused)
   {
     cvDiagSetup_buildM(FRACT, uround, h, ftemp, fpred, ewt, bit, bitcomp, y, M);
   }
-  else
 #endif
+  else
   {
     N_VLinearSum(ONE, M, -ONE, fpred, M);
     N_VLinearSum(FRACT, ftemp, -h, M, M);
@@ -439,13 +447,17 @@ static int CVDiagSolve(CVodeMem cv_mem, N_Vector b, N_Vector weight,
 
   if (gammasv != gamma) {
     r = gamma / gammasv;
+    if (cv_mem->cv_usefusedhost)
+    {
+      cvDiagSolve_updateM_host(r, M);
+    }
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
-    if (cv_mem->cv_usefused)
+    else if (cv_mem->cv_usefused)
     {
       cvDiagSolve_updateM(r, M);
     }
-    else
 #endif
+    else
     {
       N_VInv(M, M);
       N_VAddConst(M, -ONE, M);
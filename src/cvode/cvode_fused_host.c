@@ -0,0 +1,753 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file implements fused kernels for CVODE operating on host
+ * (serial, OpenMP, and Pthreads) vectors. Each kernel replaces a
+ * sequence of vector operations by a single sweep over the vector
+ * data. Temporary vectors that are only used within the sequence
+ * are not written. The sweeps of Pthreads vectors are split across
+ * the thread pool of the vector and, when CVODE is built with
+ * OpenMP, the sweeps of OpenMP vectors are split across as many
+ * OpenMP threads as the vector uses. The Nordsieck array may also be
+ * moved into a single contiguous block of memory.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include <nvector/nvector_openmp.h>
+#if defined(SUNDIALS_PTHREADS_ENABLED)
+#include <nvector/nvector_pthreads.h>
+#endif
+
+#include "cvode_impl.h"
+
+#define ZERO   RCONST(0.0)
+#define PT1    RCONST(0.1)
+#define FRACT  RCONST(0.1)
+#define ONEPT5 RCONST(1.50)
+#define ONE    RCONST(1.0)
+
+/* Number of tasks whose partial reduction results are kept on the
+   stack, more tasks allocate their partial results */
+#define CV_FUSED_NPART 64
+
+/* Body of a fused kernel for the index range [start, end) of task */
+typedef void (*cvFusedBody)(sunindextype start, sunindextype end, int task,
+                            void* data);
+
+/*
+ * -----------------------------------------------------------------
+ * Check if the fused host kernels support a vector
+ * -----------------------------------------------------------------
+ */
+
+booleantype cvFusedHostSupported(N_Vector v)
+{
+  N_Vector_ID id = N_VGetVectorID(v);
+
+  return((id == SUNDIALS_NVEC_SERIAL) ||
+         (id == SUNDIALS_NVEC_OPENMP) ||
+         (id == SUNDIALS_NVEC_PTHREADS));
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Number of threads used for the vector (1 for serial vectors)
+ * -----------------------------------------------------------------
+ */
+
+int cvFusedNumThreads(N_Vector v)
+{
+  switch (N_VGetVectorID(v)) {
+  case SUNDIALS_NVEC_OPENMP:
+    return(NV_NUM_THREADS_OMP(v));
+#if defined(SUNDIALS_PTHREADS_ENABLED)
+  case SUNDIALS_NVEC_PTHREADS:
+    return(NV_NUM_THREADS_PT(v));
+#endif
+  default:
+    return(1);
+  }
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Run body over the entries of v split into nt contiguous ranges,
+ * one per task. OpenMP vectors use an OpenMP team (if CVODE is
+ * built with OpenMP), Pthreads vectors use the thread pool of the
+ * vector, and otherwise the whole range is a single task. The
+ * ranges are the same as those of the NVECTOR_PTHREADS operations
+ * and of a static OpenMP schedule.
+ * -----------------------------------------------------------------
+ */
+
+static void cvFusedSplit(int task, int nt, sunindextype N,
+                         sunindextype* start, sunindextype* end)
+{
+  sunindextype q = N / nt;
+  sunindextype r = N % nt;
+
+  if (task < r) {
+    *start = task * q + task;
+    *end   = *start + q + 1;
+  } else {
+    *start = task * q + r;
+    *end   = *start + q;
+  }
+}
+
+static void cvFusedFor(N_Vector v, int nt, cvFusedBody body, void* data)
+{
+  sunindextype N = N_VGetLength(v);
+
+  if (nt > 1) {
+    switch (N_VGetVectorID(v)) {
+#if defined(_OPENMP)
+    case SUNDIALS_NVEC_OPENMP:
+#pragma omp parallel num_threads(nt)
+      {
+        sunindextype start, end;
+        int task  = omp_get_thread_num();
+        int ntask = omp_get_num_threads();
+        cvFusedSplit(task, ntask, N, &start, &end);
+        body(start, end, task, data);
+      }
+      return;
+#endif
+#if defined(CVODE_FUSED_PTHREADS)
+    case SUNDIALS_NVEC_PTHREADS:
+      if (N_VParallelFor_Pthreads(v, body, data) == 0) return;
+      break;
+#endif
+    default:
+      break;
+    }
+  }
+
+  body(0, N, 0, data);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Partial results of reductions, one per task. If the array can not
+ * be allocated nt is reset to 1 so the kernel runs as a single task.
+ * -----------------------------------------------------------------
+ */
+
+static void* cvFusedPartials(int* nt, size_t size, void* stack)
+{
+  void* part;
+
+  if (*nt <= CV_FUSED_NPART) return(stack);
+
+  part = malloc((*nt) * size);
+  if (part == NULL) {
+    *nt = 1;
+    return(stack);
+  }
+
+  return(part);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Compute the ewt vector when the tol type is CV_SS or CV_SV. If
+ * atolmin0 is true, first check that all components of
+ * reltol*|y| + abstol are positive and return -1 without modifying
+ * weight if not.
+ * -----------------------------------------------------------------
+ */
+
+typedef struct {
+  realtype reltol, Sabstol;
+  realtype *yd, *ad, *wd;
+  int *fail;
+} cvEwtData;
+
+static void cvEwtCheck_body(sunindextype start, sunindextype end, int task,
+                            void* data)
+{
+  cvEwtData* d = (cvEwtData*) data;
+  sunindextype i;
+  realtype t;
+
+  d->fail[task] = 0;
+  for (i = start; i < end; i++) {
+    t = (d->ad != NULL) ? d->ad[i] : d->Sabstol;
+    t += d->reltol * SUNRabs(d->yd[i]);
+    if (t <= ZERO) {
+      d->fail[task] = 1;
+      return;
+    }
+  }
+}
+
+static void cvEwtSet_body(sunindextype start, sunindextype end, int task,
+                          void* data)
+{
+  cvEwtData* d = (cvEwtData*) data;
+  sunindextype i;
+
+  if (d->ad != NULL) {
+    for (i = start; i < end; i++)
+      d->wd[i] = ONE / (d->reltol * SUNRabs(d->yd[i]) + d->ad[i]);
+  } else {
+    for (i = start; i < end; i++)
+      d->wd[i] = ONE / (d->reltol * SUNRabs(d->yd[i]) + d->Sabstol);
+  }
+}
+
+static int cvEwtSet_host(const booleantype atolmin0, cvEwtData* d,
+                         N_Vector weight)
+{
+  int fail[CV_FUSED_NPART], j, nfail;
+  int nt = cvFusedNumThreads(weight);
+
+  if (atolmin0) {
+    d->fail = (int*) cvFusedPartials(&nt, sizeof(int), fail);
+    for (j = 0; j < nt; j++) d->fail[j] = 0;
+    cvFusedFor(weight, nt, cvEwtCheck_body, d);
+    nfail = 0;
+    for (j = 0; j < nt; j++) nfail += d->fail[j];
+    if (d->fail != fail) free(d->fail);
+    if (nfail > 0) return(-1);
+  }
+
+  cvFusedFor(weight, nt, cvEwtSet_body, d);
+
+  return(0);
+}
+
+int cvEwtSetSS_host(const booleantype atolmin0,
+                    const realtype reltol,
+                    const realtype Sabstol,
+                    const N_Vector ycur,
+                    N_Vector weight)
+{
+  cvEwtData d;
+
+  d.reltol  = reltol;
+  d.Sabstol = Sabstol;
+  d.yd      = N_VGetArrayPointer(ycur);
+  d.ad      = NULL;
+  d.wd      = N_VGetArrayPointer(weight);
+
+  return(cvEwtSet_host(atolmin0, &d, weight));
+}
+
+int cvEwtSetSV_host(const booleantype atolmin0,
+                    const realtype reltol,
+                    const N_Vector Vabstol,
+                    const N_Vector ycur,
+                    N_Vector weight)
+{
+  cvEwtData d;
+
+  d.reltol  = reltol;
+  d.Sabstol = ZERO;
+  d.yd      = N_VGetArrayPointer(ycur);
+  d.ad      = N_VGetArrayPointer(Vabstol);
+  d.wd      = N_VGetArrayPointer(weight);
+
+  return(cvEwtSet_host(atolmin0, &d, weight));
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Compute the constraint correction tmp = mm*(y - 0.1*a*c/ewt)
+ * where a_i = 1 when |c_i| = 2 and 0 otherwise.
+ * -----------------------------------------------------------------
+ */
+
+typedef struct {
+  realtype *cd, *wd, *yd, *md, *td;
+} cvCheckConstraintsData;
+
+static void cvCheckConstraints_body(sunindextype start, sunindextype end,
+                                    int task, void* data)
+{
+  cvCheckConstraintsData* d = (cvCheckConstraintsData*) data;
+  sunindextype i;
+  realtype t;
+
+  for (i = start; i < end; i++) {
+    t = (SUNRabs(d->cd[i]) >= ONEPT5) ? d->cd[i] / d->wd[i] : ZERO;
+    d->td[i] = (d->yd[i] - PT1 * t) * d->md[i];
+  }
+}
+
+int cvCheckConstraints_host(const N_Vector c,
+                            const N_Vector ewt,
+                            const N_Vector y,
+                            const N_Vector mm,
+                            N_Vector tmp)
+{
+  cvCheckConstraintsData d;
+
+  d.cd = N_VGetArrayPointer(c);
+  d.wd = N_VGetArrayPointer(ewt);
+  d.yd = N_VGetArrayPointer(y);
+  d.md = N_VGetArrayPointer(mm);
+  d.td = N_VGetArrayPointer(tmp);
+
+  cvFusedFor(tmp, cvFusedNumThreads(tmp), cvCheckConstraints_body, &d);
+
+  return(0);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Compute the nonlinear residual res = rl1*zn1 + ycor + ngamma*ftemp
+ * -----------------------------------------------------------------
+ */
+
+typedef struct {
+  realtype rl1, ngamma;
+  realtype *zd, *yd, *fd, *rd;
+} cvNlsResidData;
+
+static void cvNlsResid_body(sunindextype start, sunindextype end, int task,
+                            void* data)
+{
+  cvNlsResidData* d = (cvNlsResidData*) data;
+  sunindextype i;
+
+  for (i = start; i < end; i++)
+    d->rd[i] = d->ngamma * d->fd[i] + (d->rl1 * d->zd[i] + d->yd[i]);
+}
+
+int cvNlsResid_host(const realtype rl1,
+                    const realtype ngamma,
+                    const N_Vector zn1,
+                    const N_Vector ycor,
+                    const N_Vector ftemp,
+                    N_Vector res)
+{
+  cvNlsResidData d;
+
+  d.rl1    = rl1;
+  d.ngamma = ngamma;
+  d.zd     = N_VGetArrayPointer(zn1);
+  d.yd     = N_VGetArrayPointer(ycor);
+  d.fd     = N_VGetArrayPointer(ftemp);
+  d.rd     = N_VGetArrayPointer(res);
+
+  cvFusedFor(res, cvFusedNumThreads(res), cvNlsResid_body, &d);
+
+  return(0);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Form y with perturbation = FRACT*(func. iter. correction)
+ * -----------------------------------------------------------------
+ */
+
+typedef struct {
+  realtype h, r;
+  realtype *fpd, *zd, *ypd, *ftd, *yd;
+} cvDiagFormYData;
+
+static void cvDiagSetup_formY_body(sunindextype start, sunindextype end,
+                                   int task, void* data)
+{
+  cvDiagFormYData* d = (cvDiagFormYData*) data;
+  sunindextype i;
+
+  for (i = start; i < end; i++) {
+    d->ftd[i] = d->h * d->fpd[i] - d->zd[i];
+    d->yd[i]  = d->r * d->ftd[i] + d->ypd[i];
+  }
+}
+
+int cvDiagSetup_formY_host(const realtype h,
+                           const realtype r,
+                           const N_Vector fpred,
+                           const N_Vector zn1,
+                           const N_Vector ypred,
+                           N_Vector ftemp,
+                           N_Vector y)
+{
+  cvDiagFormYData d;
+
+  d.h   = h;
+  d.r   = r;
+  d.fpd = N_VGetArrayPointer(fpred);
+  d.zd  = N_VGetArrayPointer(zn1);
+  d.ypd = N_VGetArrayPointer(ypred);
+  d.ftd = N_VGetArrayPointer(ftemp);
+  d.yd  = N_VGetArrayPointer(y);
+
+  cvFusedFor(y, cvFusedNumThreads(y), cvDiagSetup_formY_body, &d);
+
+  return(0);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Construct M = I - gamma*J with J = diag(deltaf_i/deltay_i)
+ * protecting against deltay_i being at roundoff level.
+ * -----------------------------------------------------------------
+ */
+
+typedef struct {
+  realtype fract, uround, h;
+  realtype *ftd, *fpd, *wd, *Md;
+} cvDiagBuildMData;
+
+static void cvDiagSetup_buildM_body(sunindextype start, sunindextype end,
+                                    int task, void* data)
+{
+  cvDiagBuildMData* d = (cvDiagBuildMData*) data;
+  sunindextype i;
+  realtype m, dy, b;
+
+  for (i = start; i < end; i++) {
+    m = d->fract * d->ftd[i] - d->h * (d->Md[i] - d->fpd[i]);
+    b = (SUNRabs(d->ftd[i] * d->wd[i]) >= d->uround) ? ONE : ZERO;
+    /* bitcomp = b - 1, so dy = fract*ftemp where b = 1 and 1 elsewhere */
+    dy = d->fract * (d->ftd[i] * b) - (b - ONE);
+    d->Md[i] = (m / dy) * b - (b - ONE);
+  }
+}
+
+int cvDiagSetup_buildM_host(const realtype fract,
+                            const realtype uround,
+                            const realtype h,
+                            const N_Vector ftemp,
+                            const N_Vector fpred,
+                            const N_Vector ewt,
+                            N_Vector M)
+{
+  cvDiagBuildMData d;
+
+  d.fract  = fract;
+  d.uround = uround;
+  d.h      = h;
+  d.ftd    = N_VGetArrayPointer(ftemp);
+  d.fpd    = N_VGetArrayPointer(fpred);
+  d.wd     = N_VGetArrayPointer(ewt);
+  d.Md     = N_VGetArrayPointer(M);
+
+  cvFusedFor(M, cvFusedNumThreads(M), cvDiagSetup_buildM_body, &d);
+
+  return(0);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Update M with changed gamma so that M = I - gamma*J.
+ * -----------------------------------------------------------------
+ */
+
+typedef struct {
+  realtype r;
+  realtype *Md;
+} cvDiagUpdateMData;
+
+static void cvDiagSolve_updateM_body(sunindextype start, sunindextype end,
+                                     int task, void* data)
+{
+  cvDiagUpdateMData* d = (cvDiagUpdateMData*) data;
+  sunindextype i;
+
+  for (i = start; i < end; i++)
+    d->Md[i] = d->r * (ONE / d->Md[i] - ONE) + ONE;
+}
+
+int cvDiagSolve_updateM_host(const realtype r, N_Vector M)
+{
+  cvDiagUpdateMData d;
+
+  d.r  = r;
+  d.Md = N_VGetArrayPointer(M);
+
+  cvFusedFor(M, cvFusedNumThreads(M), cvDiagSolve_updateM_body, &d);
+
+  return(0);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Apply the Nordsieck predictor (sign = 1) or undo it (sign = -1)
+ * in a single sweep, i.e. for k = 1,...,q and j = q,...,k update
+ * zn[j-1] += sign*zn[j]. The entries of zn[0],...,zn[q] are
+ * updated in the same order as the unfused loop.
+ * -----------------------------------------------------------------
+ */
+
+typedef struct {
+  int q;
+  realtype sign;
+  realtype *zd[L_MAX];
+} cvPredictData;
+
+static void cvPredict_body(sunindextype start, sunindextype end, int task,
+                           void* data)
+{
+  cvPredictData* d = (cvPredictData*) data;
+  sunindextype i;
+  int j, k, q = d->q;
+  realtype z[L_MAX];
+
+  for (i = start; i < end; i++) {
+    for (j = 0; j <= q; j++)
+      z[j] = d->zd[j][i];
+    if (d->sign > ZERO) {
+      for (k = 1; k <= q; k++)
+        for (j = q; j >= k; j--)
+          z[j-1] = z[j-1] + z[j];
+    } else {
+      for (k = 1; k <= q; k++)
+        for (j = q; j >= k; j--)
+          z[j-1] = z[j-1] - z[j];
+    }
+    for (j = 0; j < q; j++)
+      d->zd[j][i] = z[j];
+  }
+}
+
+int cvPredict_host(const int q, const realtype sign, N_Vector* zn)
+{
+  cvPredictData d;
+  int j;
+
+  d.q    = q;
+  d.sign = sign;
+  for (j = 0; j <= q; j++)
+    d.zd[j] = N_VGetArrayPointer(zn[j]);
+
+  cvFusedFor(zn[0], cvFusedNumThreads(zn[0]), cvPredict_body, &d);
+
+  return(0);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Compute the weighted RMS norm of acor - cquot*zqmax used in the
+ * order increase test without storing the difference. The partial
+ * sums of the tasks are added in task order, so the result does not
+ * depend on the thread timing.
+ * -----------------------------------------------------------------
+ */
+
+typedef struct {
+  realtype cquot;
+  realtype *zd, *ad, *wd;
+  realtype *sum;
+} cvEtaqp1NormData;
+
+static void cvEtaqp1Norm_body(sunindextype start, sunindextype end, int task,
+                              void* data)
+{
+  cvEtaqp1NormData* d = (cvEtaqp1NormData*) data;
+  sunindextype i;
+  realtype t, sum = ZERO;
+
+  for (i = start; i < end; i++) {
+    t = (-d->cquot * d->zd[i] + d->ad[i]) * d->wd[i];
+    sum += SUNSQR(t);
+  }
+
+  d->sum[task] = sum;
+}
+
+realtype cvEtaqp1Norm_host(const realtype cquot,
+                           const N_Vector zqmax,
+                           const N_Vector acor,
+                           const N_Vector ewt)
+{
+  cvEtaqp1NormData d;
+  realtype part[CV_FUSED_NPART], sum;
+  int j, nt = cvFusedNumThreads(acor);
+
+  d.cquot = cquot;
+  d.zd    = N_VGetArrayPointer(zqmax);
+  d.ad    = N_VGetArrayPointer(acor);
+  d.wd    = N_VGetArrayPointer(ewt);
+  d.sum   = (realtype*) cvFusedPartials(&nt, sizeof(realtype), part);
+  for (j = 0; j < nt; j++) d.sum[j] = ZERO;
+
+  cvFusedFor(acor, nt, cvEtaqp1Norm_body, &d);
+
+  sum = ZERO;
+  for (j = 0; j < nt; j++) sum += d.sum[j];
+  if (d.sum != part) free(d.sum);
+
+  return(SUNRsqrt(sum / N_VGetLength(acor)));
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Apply the corrections zn[j] += l[j]*acor + p[j]*acorP for
+ * j = 0,...,q in one sweep, where the projection terms are skipped
+ * if p is NULL. If zsave is not NULL, acor is also copied into it.
+ * The entries of zn are updated in the same order as the unfused
+ * calls to N_VScaleAddMulti.
+ * -----------------------------------------------------------------
+ */
+
+typedef struct {
+  int q;
+  const realtype *l, *p;
+  realtype *zd[L_MAX], *ad, *pd, *sd;
+} cvCorrectData;
+
+static void cvCorrect_body(sunindextype start, sunindextype end, int task,
+                           void* data)
+{
+  cvCorrectData* d = (cvCorrectData*) data;
+  sunindextype i;
+  int j, q = d->q;
+  realtype a, ap;
+
+  for (i = start; i < end; i++) {
+    a = d->ad[i];
+    if (d->pd != NULL) {
+      ap = d->pd[i];
+      for (j = 0; j <= q; j++) {
+        d->zd[j][i] += d->l[j] * a;
+        d->zd[j][i] += d->p[j] * ap;
+      }
+    } else {
+      for (j = 0; j <= q; j++)
+        d->zd[j][i] += d->l[j] * a;
+    }
+    if (d->sd != NULL) d->sd[i] = a;
+  }
+}
+
+int cvCorrect_host(const int q, const realtype* l, const N_Vector acor,
+                   const realtype* p, const N_Vector acorP, N_Vector* zn,
+                   N_Vector zsave)
+{
+  cvCorrectData d;
+  int j;
+
+  d.q  = q;
+  d.l  = l;
+  d.p  = p;
+  d.ad = N_VGetArrayPointer(acor);
+  d.pd = (p != NULL) ? N_VGetArrayPointer(acorP) : NULL;
+  d.sd = (zsave != NULL) ? N_VGetArrayPointer(zsave) : NULL;
+  for (j = 0; j <= q; j++)
+    d.zd[j] = N_VGetArrayPointer(zn[j]);
+
+  cvFusedFor(acor, cvFusedNumThreads(acor), cvCorrect_body, &d);
+
+  return(0);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Adjust the history array on a BDF order change in one sweep,
+ * zn[j] += c[j]*(s*x) for j = 0,...,nvec-1. If xs is not NULL, s*x
+ * is also stored in xs (which may be x itself).
+ * -----------------------------------------------------------------
+ */
+
+typedef struct {
+  int nvec;
+  const realtype* c;
+  realtype s;
+  realtype *zd[L_MAX], *xd, *sd;
+} cvAdjustOrderData;
+
+static void cvAdjustOrder_body(sunindextype start, sunindextype end, int task,
+                               void* data)
+{
+  cvAdjustOrderData* d = (cvAdjustOrderData*) data;
+  sunindextype i;
+  int j;
+  realtype t;
+
+  for (i = start; i < end; i++) {
+    t = d->s * d->xd[i];
+    if (d->sd != NULL) d->sd[i] = t;
+    for (j = 0; j < d->nvec; j++)
+      d->zd[j][i] += d->c[j] * t;
+  }
+}
+
+int cvAdjustOrder_host(const int nvec, const realtype* c, const realtype s,
+                       const N_Vector x, N_Vector xs, N_Vector* zn)
+{
+  cvAdjustOrderData d;
+  int j;
+
+  d.nvec = nvec;
+  d.c    = c;
+  d.s    = s;
+  d.xd   = N_VGetArrayPointer(x);
+  d.sd   = (xs != NULL) ? N_VGetArrayPointer(xs) : NULL;
+  for (j = 0; j < nvec; j++)
+    d.zd[j] = N_VGetArrayPointer(zn[j]);
+
+  cvFusedFor(x, cvFusedNumThreads(x), cvAdjustOrder_body, &d);
+
+  return(0);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Move the Nordsieck array zn[0],...,zn[qmax_alloc] into a single
+ * contiguous block. Each zn[j] is replaced by a vector without its
+ * own data that points to the j-th slice of the block, so the rest
+ * of CVODE continues to work with ordinary vectors. The block is
+ * released in cvFreeVectors.
+ * -----------------------------------------------------------------
+ */
+
+int cvNordsieckBlockInit(CVodeMem cv_mem)
+{
+  sunindextype i, N;
+  int j, maxord;
+  realtype *block, *zd;
+  N_Vector v;
+
+  if (cv_mem->cv_znblock != NULL) return(CV_SUCCESS);
+
+  maxord = cv_mem->cv_qmax_alloc;
+  N      = N_VGetLength(cv_mem->cv_zn[0]);
+
+  block = (realtype*) malloc((maxord + 1) * N * sizeof(realtype));
+  if (block == NULL) return(CV_MEM_FAIL);
+
+  /* Create all vectors first so a failure leaves zn unchanged */
+  for (j = 0; j <= maxord; j++) {
+    cv_mem->cv_Xvecs[j] = N_VCloneEmpty(cv_mem->cv_zn[j]);
+    if (cv_mem->cv_Xvecs[j] == NULL) {
+      while (j > 0) N_VDestroy(cv_mem->cv_Xvecs[--j]);
+      free(block);
+      return(CV_MEM_FAIL);
+    }
+  }
+
+  for (j = 0; j <= maxord; j++) {
+    v  = cv_mem->cv_Xvecs[j];
+    zd = N_VGetArrayPointer(cv_mem->cv_zn[j]);
+    for (i = 0; i < N; i++)
+      block[j * N + i] = zd[i];
+    N_VSetArrayPointer(block + j * N, v);
+    N_VDestroy(cv_mem->cv_zn[j]);
+    cv_mem->cv_zn[j] = v;
+  }
+
+  cv_mem->cv_znblock = block;
+
+  return(CV_SUCCESS);
+}
@@ -0,0 +1,511 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file contains implementations of the incomplete LU
+ * preconditioner and solver routines for use with the CVLS linear
+ * solver interface.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cvode_impl.h"
+#include "cvode_ilupre_impl.h"
+#include "cvode_ls_impl.h"
+#include <sundials/sundials_math.h>
+
+#define ZERO         RCONST(0.0)
+#define ONE          RCONST(1.0)
+
+/* Prototypes of CVILUPrecSetup and CVILUPrecSolve */
+static int CVILUPrecSetup(realtype t, N_Vector y, N_Vector fy,
+                          booleantype jok, booleantype *jcurPtr,
+                          realtype gamma, void *ip_data);
+static int CVILUPrecSolve(realtype t, N_Vector y, N_Vector fy,
+                          N_Vector r, N_Vector z,
+                          realtype gamma, realtype delta,
+                          int lr, void *ip_data);
+
+/* Prototype for CVILUPrecFree */
+static int CVILUPrecFree(CVodeMem cv_mem);
+
+/* Prototype for the shared access routine */
+static int CVILUPrecAccess(void *cvode_mem, const char *fname,
+                           CVodeMem *cv_mem, CVILUPrecData *pdata);
+
+
+/*-----------------------------------------------------------------
+  Initialization, Free, and Get Functions
+  NOTE: The ILU linear solver assumes a serial/OpenMP/Pthreads
+        implementation of the NVECTOR package. Therefore,
+        CVILUPrecInit will first test for a compatible N_Vector
+        internal representation by checking that the function
+        N_VGetArrayPointer exists.
+  -----------------------------------------------------------------*/
+int CVILUPrecInit(void *cvode_mem, SUNMatrix J, CVLsJacFn jac,
+                  int fill_level)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  CVILUPrecData pdata;
+  int flag;
+
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CVLS_MEM_NULL, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_MEM_NULL);
+    return(CVLS_MEM_NULL);
+  }
+  cv_mem = (CVodeMem) cvode_mem;
+
+  /* Test if the CVLS linear solver interface has been attached */
+  if (cv_mem->cv_lmem == NULL) {
+    cvProcessError(cv_mem, CVLS_LMEM_NULL, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_LMEM_NULL);
+    return(CVLS_LMEM_NULL);
+  }
+  cvls_mem = (CVLsMem) cv_mem->cv_lmem;
+
+  /* Test compatibility of NVECTOR package with the ILU preconditioner */
+  if(cv_mem->cv_tempv->ops->nvgetarraypointer == NULL) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_BAD_NVECTOR);
+    return(CVLS_ILL_INPUT);
+  }
+
+  /* Test the Jacobian template, function and fill level */
+  if ( (J == NULL) || (SUNMatGetID(J) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(J) != SUNSparseMatrix_Columns(J)) ||
+       (SUNSparseMatrix_Rows(J) != N_VGetLength(cv_mem->cv_tempv)) ) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_BAD_MATRIX);
+    return(CVLS_ILL_INPUT);
+  }
+  if (jac == NULL) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_JAC_NULL);
+    return(CVLS_ILL_INPUT);
+  }
+  if (fill_level < 0) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_BAD_FILL);
+    return(CVLS_ILL_INPUT);
+  }
+
+  /* Allocate data memory */
+  pdata = NULL;
+  pdata = (CVILUPrecData) malloc(sizeof *pdata);
+  if (pdata == NULL) {
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_MEM_FAIL);
+    return(CVLS_MEM_FAIL);
+  }
+
+  /* Load pointers into pdata block. */
+  pdata->cvode_mem = cvode_mem;
+  pdata->jac       = jac;
+  pdata->gammaP    = ZERO;
+  pdata->factored  = SUNFALSE;
+
+  /* Initialize counters */
+  pdata->njeIP   = 0;
+  pdata->nfactIP = 0;
+
+  /* Allocate memory for the saved Jacobian and the preconditioner matrix
+     with the pattern of the template */
+  pdata->savedJ = NULL;
+  pdata->savedJ = SUNMatClone(J);
+  if (pdata->savedJ == NULL) {
+    free(pdata); pdata = NULL;
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_MEM_FAIL);
+    return(CVLS_MEM_FAIL);
+  }
+  flag = SUNMatCopy(J, pdata->savedJ);
+  if (flag != SUNMAT_SUCCESS) {
+    SUNMatDestroy(pdata->savedJ);
+    free(pdata); pdata = NULL;
+    cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_SUNMAT_FAIL);
+    return(CVLS_SUNMAT_FAIL);
+  }
+
+  pdata->savedP = NULL;
+  pdata->savedP = SUNMatClone(J);
+  if (pdata->savedP == NULL) {
+    SUNMatDestroy(pdata->savedJ);
+    free(pdata); pdata = NULL;
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_MEM_FAIL);
+    return(CVLS_MEM_FAIL);
+  }
+
+  /* Allocate memory for the ILU linear solver */
+  pdata->LS = NULL;
+  pdata->LS = SUNLinSol_ILU(cv_mem->cv_tempv, pdata->savedP, fill_level,
+                            cv_mem->cv_sunctx);
+  if (pdata->LS == NULL) {
+    SUNMatDestroy(pdata->savedP);
+    SUNMatDestroy(pdata->savedJ);
+    free(pdata); pdata = NULL;
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_MEM_FAIL);
+    return(CVLS_MEM_FAIL);
+  }
+
+  /* allocate memory for temporary N_Vectors */
+  pdata->tmp1 = NULL;
+  pdata->tmp1 = N_VClone(cv_mem->cv_tempv);
+  pdata->tmp2 = NULL;
+  pdata->tmp2 = N_VClone(cv_mem->cv_tempv);
+  pdata->tmp3 = NULL;
+  pdata->tmp3 = N_VClone(cv_mem->cv_tempv);
+  if ((pdata->tmp1 == NULL) || (pdata->tmp2 == NULL) ||
+      (pdata->tmp3 == NULL)) {
+    SUNLinSolFree(pdata->LS);
+    SUNMatDestroy(pdata->savedP);
+    SUNMatDestroy(pdata->savedJ);
+    if (pdata->tmp1) N_VDestroy(pdata->tmp1);
+    if (pdata->tmp2) N_VDestroy(pdata->tmp2);
+    if (pdata->tmp3) N_VDestroy(pdata->tmp3);
+    free(pdata); pdata = NULL;
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_MEM_FAIL);
+    return(CVLS_MEM_FAIL);
+  }
+
+  /* initialize ILU linear solver object */
+  flag = SUNLinSolInitialize(pdata->LS);
+  if (flag != SUNLS_SUCCESS) {
+    SUNLinSolFree(pdata->LS);
+    SUNMatDestroy(pdata->savedP);
+    SUNMatDestroy(pdata->savedJ);
+    N_VDestroy(pdata->tmp1);
+    N_VDestroy(pdata->tmp2);
+    N_VDestroy(pdata->tmp3);
+    free(pdata); pdata = NULL;
+    cvProcessError(cv_mem, CVLS_SUNLS_FAIL, "CVILUPRE",
+                   "CVILUPrecInit", MSGIP_SUNLS_FAIL);
+    return(CVLS_SUNLS_FAIL);
+  }
+
+  /* make sure P_data is free from any previous allocations */
+  if (cvls_mem->pfree)
+    cvls_mem->pfree(cv_mem);
+
+  /* Point to the new P_data field in the LS memory */
+  cvls_mem->P_data = pdata;
+
+  /* Attach the pfree function */
+  cvls_mem->pfree = CVILUPrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = CVodeSetPreconditioner(cvode_mem,
+                                CVILUPrecSetup,
+                                CVILUPrecSolve);
+  return(flag);
+}
+
+
+int CVILUPrecGetWorkSpace(void *cvode_mem, long int *lenrwIP,
+                          long int *leniwIP)
+{
+  CVodeMem cv_mem;
+  CVILUPrecData pdata;
+  sunindextype lrw1, liw1;
+  long int lrw, liw;
+  int flag;
+
+  flag = CVILUPrecAccess(cvode_mem, "CVILUPrecGetWorkSpace",
+                         &cv_mem, &pdata);
+  if (flag != CVLS_SUCCESS) return(flag);
+
+  /* sum space requirements for all objects in pdata */
+  *leniwIP = 6;
+  *lenrwIP = 1;
+  if (cv_mem->cv_tempv->ops->nvspace) {
+    N_VSpace(cv_mem->cv_tempv, &lrw1, &liw1);
+    *leniwIP += 3*liw1;
+    *lenrwIP += 3*lrw1;
+  }
+  if (pdata->savedJ->ops->space) {
+    flag = SUNMatSpace(pdata->savedJ, &lrw, &liw);
+    if (flag != 0) return(-1);
+    *leniwIP += liw;
+    *lenrwIP += lrw;
+  }
+  if (pdata->savedP->ops->space) {
+    flag = SUNMatSpace(pdata->savedP, &lrw, &liw);
+    if (flag != 0) return(-1);
+    *leniwIP += liw;
+    *lenrwIP += lrw;
+  }
+  if (pdata->LS->ops->space) {
+    flag = SUNLinSolSpace(pdata->LS, &lrw, &liw);
+    if (flag != 0) return(-1);
+    *leniwIP += liw;
+    *lenrwIP += lrw;
+  }
+
+  return(CVLS_SUCCESS);
+}
+
+
+int CVILUPrecGetNumJacEvals(void *cvode_mem, long int *njevalsIP)
+{
+  CVodeMem cv_mem;
+  CVILUPrecData pdata;
+  int flag;
+
+  flag = CVILUPrecAccess(cvode_mem, "CVILUPrecGetNumJacEvals",
+                         &cv_mem, &pdata);
+  if (flag != CVLS_SUCCESS) return(flag);
+
+  *njevalsIP = pdata->njeIP;
+
+  return(CVLS_SUCCESS);
+}
+
+
+int CVILUPrecGetNumFactorizations(void *cvode_mem, long int *nfactIP)
+{
+  CVodeMem cv_mem;
+  CVILUPrecData pdata;
+  int flag;
+
+  flag = CVILUPrecAccess(cvode_mem, "CVILUPrecGetNumFactorizations",
+                         &cv_mem, &pdata);
+  if (flag != CVLS_SUCCESS) return(flag);
+
+  *nfactIP = pdata->nfactIP;
+
+  return(CVLS_SUCCESS);
+}
+
+
+/*-----------------------------------------------------------------
+  CVILUPrecSetup
+  -----------------------------------------------------------------
+  Together CVILUPrecSetup and CVILUPrecSolve use an incomplete LU
+  factorization of P = I - gamma*J as the preconditioner, where J
+  is computed by the user-supplied sparse Jacobian function.
+
+  The parameters of CVILUPrecSetup are as follows:
+
+  t       is the current value of the independent variable.
+
+  y       is the current value of the dependent variable vector,
+          namely the predicted value of y(t).
+
+  fy      is the vector f(t,y).
+
+  jok     is an input flag indicating whether Jacobian-related
+          data needs to be recomputed, as follows:
+            jok == SUNFALSE means recompute Jacobian-related data
+                   from scratch.
+            jok == SUNTRUE means that Jacobian data from the
+                   previous PrecSetup call will be reused
+                   (with the current value of gamma).
+          A CVILUPrecSetup call with jok == SUNTRUE should only
+          occur after a call with jok == SUNFALSE.
+
+  *jcurPtr is a pointer to an output integer flag which is
+           set by CVILUPrecSetup as follows:
+             *jcurPtr = SUNTRUE if Jacobian data was recomputed.
+             *jcurPtr = SUNFALSE if Jacobian data was not recomputed,
+                        but saved data was reused.
+
+  gamma   is the scalar appearing in the Newton matrix.
+
+  ip_data is a pointer to preconditoner data (set by CVILUPrecInit)
+
+  With jok == SUNTRUE the factors are only recomputed when gamma
+  differs from the one of the current factorization, otherwise the
+  call returns immediately.
+
+  The value to be returned by the CVILUPrecSetup function is
+    0  if successful, or
+    1  if the ILU factorization failed (zero pivot).
+  -----------------------------------------------------------------*/
+static int CVILUPrecSetup(realtype t, N_Vector y, N_Vector fy,
+                          booleantype jok, booleantype *jcurPtr,
+                          realtype gamma, void *ip_data)
+{
+  CVILUPrecData pdata;
+  CVodeMem cv_mem;
+  int retval;
+
+  pdata = (CVILUPrecData) ip_data;
+  cv_mem = (CVodeMem) pdata->cvode_mem;
+
+  if (jok) {
+
+    /* If jok = SUNTRUE, use saved copy of J. */
+    *jcurPtr = SUNFALSE;
+
+    /* the current factors are still valid */
+    if (pdata->factored && (gamma == pdata->gammaP))
+      return(0);
+
+  } else {
+
+    /* If jok = SUNFALSE, call the Jacobian function for a new J. */
+    *jcurPtr = SUNTRUE;
+    retval = SUNMatZero(pdata->savedJ);
+    if (retval < 0) {
+      cvProcessError(cv_mem, -1, "CVILUPRE",
+                     "CVILUPrecSetup", MSGIP_SUNMAT_FAIL);
+      return(-1);
+    }
+    if (retval > 0) {
+      return(1);
+    }
+
+    retval = pdata->jac(t, y, fy, pdata->savedJ, cv_mem->cv_user_data,
+                        pdata->tmp1, pdata->tmp2, pdata->tmp3);
+    pdata->njeIP++;
+    if (retval < 0) {
+      cvProcessError(cv_mem, -1, "CVILUPRE",
+                     "CVILUPrecSetup", MSGIP_JACFUNC_FAILED);
+      return(-1);
+    }
+    if (retval > 0) {
+      return(1);
+    }
+
+  }
+
+  pdata->factored = SUNFALSE;
+
+  retval = SUNMatCopy(pdata->savedJ, pdata->savedP);
+  if (retval < 0) {
+    cvProcessError(cv_mem, -1, "CVILUPRE",
+                   "CVILUPrecSetup", MSGIP_SUNMAT_FAIL);
+    return(-1);
+  }
+  if (retval > 0) {
+    return(1);
+  }
+
+  /* Scale and add identity to get savedP = I - gamma*J. */
+  retval = SUNMatScaleAddI(-gamma, pdata->savedP);
+  if (retval) {
+    cvProcessError(cv_mem, -1, "CVILUPRE",
+                   "CVILUPrecSetup", MSGIP_SUNMAT_FAIL);
+    return(-1);
+  }
+
+  /* Do the ILU factorization of the matrix and return error flag, the
+     symbolic factorization is only recomputed if the pattern changed */
+  retval = SUNLinSolSetup(pdata->LS, pdata->savedP);
+  pdata->nfactIP++;
+  if (retval != SUNLS_SUCCESS)
+    return((retval == SUNLS_LUFACT_FAIL) ? 1 : -1);
+
+  pdata->gammaP   = gamma;
+  pdata->factored = SUNTRUE;
+
+  return(0);
+}
+
+
+/*-----------------------------------------------------------------
+  CVILUPrecSolve
+  -----------------------------------------------------------------
+  CVILUPrecSolve solves a linear system P z = r, where P is the
+  matrix computed by CVILUPrecSetup.
+
+  The parameters of CVILUPrecSolve used here are as follows:
+
+  r is the right-hand side vector of the linear system.
+
+  ip_data is a pointer to preconditoner data (set by CVILUPrecInit)
+
+  z is the output vector computed by CVILUPrecSolve.
+
+  The value returned by the CVILUPrecSolve function is always 0,
+  indicating success.
+  -----------------------------------------------------------------*/
+static int CVILUPrecSolve(realtype t, N_Vector y, N_Vector fy,
+                          N_Vector r, N_Vector z, realtype gamma,
+                          realtype delta, int lr, void *ip_data)
+{
+  CVILUPrecData pdata;
+  int retval;
+
+  pdata = (CVILUPrecData) ip_data;
+
+  /* Call ILU solver object to do the work */
+  retval = SUNLinSolSolve(pdata->LS, pdata->savedP, z, r, ZERO);
+  return(retval);
+}
+
+
+static int CVILUPrecFree(CVodeMem cv_mem)
+{
+  CVLsMem cvls_mem;
+  CVILUPrecData pdata;
+
+  if (cv_mem->cv_lmem == NULL) return(0);
+  cvls_mem = (CVLsMem) cv_mem->cv_lmem;
+
+  if (cvls_mem->P_data == NULL) return(0);
+  pdata = (CVILUPrecData) cvls_mem->P_data;
+
+  SUNLinSolFree(pdata->LS);
+  SUNMatDestroy(pdata->savedP);
+  SUNMatDestroy(pdata->savedJ);
+  N_VDestroy(pdata->tmp1);
+  N_VDestroy(pdata->tmp2);
+  N_VDestroy(pdata->tmp3);
+
+  free(pdata);
+  pdata = NULL;
+
+  return(0);
+}
+
+
+/*-----------------------------------------------------------------
+  CVILUPrecAccess
+  -----------------------------------------------------------------
+  This routine checks the integrator, linear solver and
+  preconditioner memory and returns pointers to them.
+  -----------------------------------------------------------------*/
+static int CVILUPrecAccess(void *cvode_mem, const char *fname,
+                           CVodeMem *cv_mem, CVILUPrecData *pdata)
+{
+  CVLsMem cvls_mem;
+
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CVLS_MEM_NULL, "CVILUPRE",
+                   fname, MSGIP_MEM_NULL);
+    return(CVLS_MEM_NULL);
+  }
+  *cv_mem = (CVodeMem) cvode_mem;
+
+  if ((*cv_mem)->cv_lmem == NULL) {
+    cvProcessError(*cv_mem, CVLS_LMEM_NULL, "CVILUPRE",
+                   fname, MSGIP_LMEM_NULL);
+    return(CVLS_LMEM_NULL);
+  }
+  cvls_mem = (CVLsMem) (*cv_mem)->cv_lmem;
+
+  if (cvls_mem->P_data == NULL) {
+    cvProcessError(*cv_mem, CVLS_PMEM_NULL, "CVILUPRE",
+                   fname, MSGIP_PMEM_NULL);
+    return(CVLS_PMEM_NULL);
+  }
+  *pdata = (CVILUPrecData) cvls_mem->P_data;
+
+  return(CVLS_SUCCESS);
+}
@@ -295,6 +295,9 @@ typedef struct CVodeMemRec {
   realtype cv_delp;            /* norm of previous nonlinear solver update    */
   realtype cv_acnrm;           /* | acor |                                    */
   booleantype cv_acnrmcur;     /* is | acor | current?                        */
+  realtype cv_ddnqm1;          /* | zn[q] | after the step, for order q-1      */
+  realtype cv_dupqp1;          /* | acor - cquot zn[qmax] |, for order q+1    */
+  booleantype cv_ordnrmcur;    /* are ddnqm1 and dupqp1 current?              */
   realtype cv_nlscoef;         /* coeficient in nonlinear convergence test    */
 
   /*------
@@ -334,6 +337,8 @@ typedef struct CVodeMemRec {
   long int cv_nni;         /* number of nonlinear iterations performed        */
   long int cv_nnf;         /* number of nonlinear convergence failures        */
   long int cv_netf;        /* number of error test failures                   */
+  long int cv_nreduce;     /* number of error test and order selection norm
+                              reductions                                      */
   long int cv_nsetups;     /* number of setup calls                           */
   int cv_nhnil;            /* number of messages issued to the user that
                               t + h == t for the next iternal step            */
@@ -472,7 +477,9 @@ typedef struct CVodeMemRec {
   realtype cv_cvals[L_MAX]; /* array of scalars */
   N_Vector cv_Xvecs[L_MAX]; /* array of vectors */
 
-  booleantype cv_usefused;  /* flag indicating if CVODE specific fused kernels should be used */
+  booleantype cv_usefused;      /* flag indicating if CVODE specific fused kernels should be used */
+  booleantype cv_usefusedhost;  /* flag indicating if the fused host kernels should be used       */
+  realtype *cv_znblock;         /* contiguous storage of zn[0..qmax_alloc] (NULL if not used)   */
 
 } *CVodeMem;
 
@@ -647,6 +654,40 @@ void cvRestore(CVodeMem cv_mem, realtype saved_t);
 
 void cvRescale(CVodeMem cv_mem);
 
+/* Fused kernels for host (serial, OpenMP, and Pthreads) vectors */
+
+booleantype cvFusedHostSupported(N_Vector v);
+int cvEwtSetSS_host(const booleantype atolmin0, const realtype reltol,
+                    const realtype Sabstol, const N_Vector ycur,
+                    N_Vector weight);
+int cvEwtSetSV_host(const booleantype atolmin0, const realtype reltol,
+                    const N_Vector Vabstol, const N_Vector ycur,
+                    N_Vector weight);
+int cvCheckConstraints_host(const N_Vector c, const N_Vector ewt,
+                            const N_Vector y, const N_Vector mm,
+                            N_Vector tmp);
+int cvNlsResid_host(const realtype rl1, const realtype ngamma,
+                    const N_Vector zn1, const N_Vector ycor,
+                    const N_Vector ftemp, N_Vector res);
+int cvDiagSetup_formY_host(const realtype h, const realtype r,
+                           const N_Vector fpred, const N_Vector zn1,
+                           const N_Vector ypred, N_Vector ftemp, N_Vector y);
+int cvDiagSetup_buildM_host(const realtype fract, const realtype uround,
+                            const realtype h, const N_Vector ftemp,
+                            const N_Vector fpred, const N_Vector ewt,
+                            N_Vector M);
+int cvDiagSolve_updateM_host(const realtype r, N_Vector M);
+int cvPredict_host(const int q, const realtype sign, N_Vector* zn);
+realtype cvEtaqp1Norm_host(const realtype cquot, const N_Vector zqmax,
+                           const N_Vector acor, const N_Vector ewt);
+int cvCorrect_host(const int q, const realtype* l, const N_Vector acor,
+                   const realtype* p, const N_Vector acorP, N_Vector* zn,
+                   N_Vector zsave);
+int cvAdjustOrder_host(const int nvec, const realtype* c, const realtype s,
+                       const N_Vector x, N_Vector xs, N_Vector* zn);
+int cvNordsieckBlockInit(CVodeMem cv_mem);
+int cvFusedNumThreads(N_Vector v);
+
 /*
  * =================================================================
  *    E R R O R    M E S S A G E S
@@ -1002,7 +1002,9 @@ int CVodeSetConstraints(void *cvode_mem, N_Vector constraints)
 /*
  * CVodeSetUseIntegratorFusedKernels
  *
- * Enable or disable integrator specific fused kernels
+ * Enable or disable integrator specific fused kernels. Kernels for
+ * host vectors are always available, GPU kernels require a build
+ * with SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS.
  */
 
 int CVodeSetUseIntegratorFusedKernels(void *cvode_mem, booleantype onoff)
@@ -1020,6 +1022,18 @@ int CVodeSetUseIntegratorFusedKernels(void *cvode_mem, booleantype onoff)
 
   cv_mem = (CVodeMem) cvode_mem;
 
+  /* Use the fused host kernels with serial, OpenMP, and Pthreads vectors and
+     store the Nordsieck array in one contiguous block */
+  if (cv_mem->cv_MallocDone && cvFusedHostSupported(cv_mem->cv_ewt)) {
+    if (onoff && cvNordsieckBlockInit(cv_mem) != CV_SUCCESS) {
+      cvProcessError(cv_mem, CV_MEM_FAIL, "CVODE",
+                     "CVodeSetUseIntegratorFusedKernels", MSGCV_MEM_FAIL);
+      return(CV_MEM_FAIL);
+    }
+    cv_mem->cv_usefusedhost = onoff;
+    return(CV_SUCCESS);
+  }
+
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
   id = N_VGetVectorID(cv_mem->cv_ewt);
   if (!cv_mem->cv_MallocDone ||
@@ -1133,6 +1147,29 @@ int CVodeGetNumErrTestFails(void *cvode_mem, long int *netfails)
   return(CV_SUCCESS);
 }
 
+/*
+ * CVodeGetNumReductions
+ *
+ * Returns the current number of global reductions performed for the
+ * local error test and the step size and order selection
+ */
+
+int CVodeGetNumReductions(void *cvode_mem, long int *nreduce)
+{
+  CVodeMem cv_mem;
+
+  if (cvode_mem==NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODE", "CVodeGetNumReductions", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+
+  cv_mem = (CVodeMem) cvode_mem;
+
+  *nreduce = cv_mem->cv_nreduce;
+
+  return(CV_SUCCESS);
+}
+
 /*
  * CVodeGetLastOrder
  *
@@ -370,14 +370,19 @@ static int cvNlsResidual(N_Vector ycor, N_Vector res, void* cvode_mem)
   if (retval < 0) return(CV_RHSFUNC_FAIL);
   if (retval > 0) return(RHSFUNC_RECVR);
 
+  if (cv_mem->cv_usefusedhost)
+  {
+    cvNlsResid_host(cv_mem->cv_rl1, -cv_mem->cv_gamma, cv_mem->cv_zn[1],
+                    ycor, cv_mem->cv_ftemp, res);
+  }
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
-  if (cv_mem->cv_usefused)
+  else if (cv_mem->cv_usefused)
   {
     cvNlsResid_fused(cv_mem->cv_rl1, -cv_mem->cv_gamma, cv_mem->cv_zn[1],
                      ycor, cv_mem->cv_ftemp, res);
   }
-  else
 #endif
+  else
   {
     N_VLinearSum(cv_mem->cv_rl1, cv_mem->cv_zn[1], ONE, ycor, res);
     N_VLinearSum(-cv_mem->cv_gamma, cv_mem->cv_ftemp, ONE, res, res);
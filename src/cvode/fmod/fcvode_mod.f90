@@ -128,6 +128,7 @@ module fcvode_mod
  public :: FCVodeGetNumRhsEvals
  public :: FCVodeGetNumLinSolvSetups
  public :: FCVodeGetNumErrTestFails
+ public :: FCVodeGetNumReductions
  public :: FCVodeGetLastOrder
  public :: FCVodeGetCurrentOrder
  public :: FCVodeGetCurrentGamma
@@ -189,6 +190,7 @@ module fcvode_mod
  integer(C_INT), parameter, public :: CVLS_SUNLS_FAIL = -9_C_INT
  public :: FCVodeSetLinearSolver
  public :: FCVodeSetJacFn
+ public :: FCVodeSetJacSparsityPattern
  public :: FCVodeSetJacEvalFrequency
  public :: FCVodeSetLinearSolutionScaling
  public :: FCVodeSetDeltaGammaMaxBadJac
@@ -704,6 +706,15 @@ type(C_PTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FCVodeGetNumReductions(farg1, farg2) &
+bind(C, name="_wrap_FCVodeGetNumReductions") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FCVodeGetLastOrder(farg1, farg2) &
 bind(C, name="_wrap_FCVodeGetLastOrder") &
 result(fresult)
@@ -1089,6 +1100,15 @@ type(C_FUNPTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FCVodeSetJacSparsityPattern(farg1, farg2) &
+bind(C, name="_wrap_FCVodeSetJacSparsityPattern") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FCVodeSetJacEvalFrequency(farg1, farg2) &
 bind(C, name="_wrap_FCVodeSetJacEvalFrequency") &
 result(fresult)
@@ -2254,6 +2274,22 @@ fresult = swigc_FCVodeGetNumErrTestFails(farg1, farg2)
 swig_result = fresult
 end function
 
+function FCVodeGetNumReductions(cvode_mem, nreduce) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: cvode_mem
+integer(C_LONG), dimension(*), target, intent(inout) :: nreduce
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = cvode_mem
+farg2 = c_loc(nreduce(1))
+fresult = swigc_FCVodeGetNumReductions(farg1, farg2)
+swig_result = fresult
+end function
+
 function FCVodeGetLastOrder(cvode_mem, qlast) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -2977,6 +3013,22 @@ fresult = swigc_FCVodeSetJacFn(farg1, farg2)
 swig_result = fresult
 end function
 
+function FCVodeSetJacSparsityPattern(cvode_mem, p) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: cvode_mem
+type(SUNMatrix), target, intent(inout) :: p
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = cvode_mem
+farg2 = c_loc(p)
+fresult = swigc_FCVodeSetJacSparsityPattern(farg1, farg2)
+swig_result = fresult
+end function
+
 function FCVodeSetJacEvalFrequency(cvode_mem, msbj) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
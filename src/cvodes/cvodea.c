@@ -57,10 +57,21 @@
 static CVckpntMem CVAckpntInit(CVodeMem cv_mem);
 static CVckpntMem CVAckpntNew(CVodeMem cv_mem);
 static void CVAckpntDelete(CVckpntMem *ck_memPtr);
+static void CVAckpntRemove(CVodeMem cv_mem, CVckpntMem *ck_memPtr);
+static int  CVAckpntThin(CVodeMem cv_mem);
+static void CVAckpntSaveStepData(CVodeMem cv_mem, CVckpntMem ck_mem);
+static int  CVAckpntXfer(CVodeMem cv_mem, CVckpntMem ck_mem, int mode,
+                         size_t *bytes);
+static int  CVAckpntStore(CVodeMem cv_mem, CVckpntMem ck_mem);
+static int  CVAckpntLoad(CVodeMem cv_mem, CVckpntMem ck_mem);
 
 static void CVAbckpbDelete(CVodeBMem *cvB_memPtr);
 
 static int  CVAdataStore(CVodeMem cv_mem, CVckpntMem ck_mem);
+static int  CVAdataRecord(CVodeMem cv_mem, realtype t0, realtype t1);
+static int  CVAadvance(CVodeMem cv_mem, long int nst);
+static int  CVArevolve(CVodeMem cv_mem, CVckpntMem *ck_memPtr);
+static long int CVArevolveSplit(long int m, long int s);
 static int  CVAckpntGet(CVodeMem cv_mem, CVckpntMem ck_mem);
 
 static int CVAfindIndex(CVodeMem cv_mem, realtype t,
@@ -156,6 +167,22 @@ int CVodeAdjInit(void *cvode_mem, long int steps, int interp)
   /* No interpolation data is available */
   ca_mem->ca_ckpntData = NULL;
 
+  /* Check point history arrays are kept in N_Vectors by default */
+  ca_mem->ca_ckstore = NULL;
+  ca_mem->ca_ckbuf = NULL;
+  ca_mem->ca_ckbufsize = 0;
+  ca_mem->ca_ckkey = 0;
+
+  /* All check points are kept by default */
+  ca_mem->ca_nslots = 0;
+  ca_mem->ca_ckspace = 1;
+  ca_mem->ca_tblk = NULL;
+  ca_mem->ca_tblkalloc = 0;
+  ca_mem->ca_ckpntBlk = 0;
+
+  ca_mem->ca_nstF = 0;
+  ca_mem->ca_nstR = 0;
+
   /* ------------------------------------
    * Initialization of interpolation data
    * ------------------------------------ */
@@ -309,6 +336,11 @@ int CVodeAdjReInit(void *cvode_mem)
   ca_mem->ck_mem = NULL;
   ca_mem->ca_nckpnts = 0;
   ca_mem->ca_ckpntData = NULL;
+  ca_mem->ca_ckspace = 1;
+  ca_mem->ca_ckpntBlk = 0;
+
+  ca_mem->ca_nstF = 0;
+  ca_mem->ca_nstR = 0;
 
   /* CVodeF and CVodeB not called yet */
 
@@ -342,6 +374,10 @@ void CVodeAdjFree(void *cvode_mem)
     /* Delete check points one by one */
     while (ca_mem->ck_mem != NULL) CVAckpntDelete(&(ca_mem->ck_mem));
 
+    /* Free the check point packing buffer and block start times */
+    if (ca_mem->ca_ckbuf != NULL) free(ca_mem->ca_ckbuf);
+    if (ca_mem->ca_tblk != NULL) free(ca_mem->ca_tblk);
+
     /* Free vectors at all data points */
     if (ca_mem->ca_IMmallocDone) {
       ca_mem->ca_IMfree(cv_mem);
@@ -454,6 +490,14 @@ int CVodeF(void *cvode_mem, realtype tout, N_Vector yout,
       return(CV_MEM_FAIL);
     }
 
+    if (ca_mem->ca_nslots > 0) {
+      if (CVAckpntThin(cv_mem) != CV_SUCCESS) {
+        cvProcessError(cv_mem, CV_MEM_FAIL, "CVODEA", "CVodeF", MSGCV_MEM_FAIL);
+        SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+        return(CV_MEM_FAIL);
+      }
+    }
+
     if ( !ca_mem->ca_IMmallocDone ) {
 
       /* Do we need to store sensitivities? */
@@ -514,6 +558,7 @@ int CVodeF(void *cvode_mem, realtype tout, N_Vector yout,
       *ncheckPtr = ca_mem->ca_nckpnts;
       ca_mem->ca_IMnewData = SUNTRUE;
       ca_mem->ca_ckpntData = ca_mem->ck_mem;
+      ca_mem->ca_ckpntBlk = ca_mem->ck_mem->ck_nst / ca_mem->ca_nsteps;
       ca_mem->ca_np = cv_mem->cv_nst % ca_mem->ca_nsteps + 1;
       SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
       return(flag);
@@ -540,6 +585,7 @@ int CVodeF(void *cvode_mem, realtype tout, N_Vector yout,
     if (flag < 0) break;
 
     nstloc++;
+    ca_mem->ca_nstF++;
 
     /* Test if a new check point is needed */
 
@@ -559,6 +605,15 @@ int CVodeF(void *cvode_mem, realtype tout, N_Vector yout,
       ca_mem->ca_nckpnts++;
       cv_mem->cv_forceSetup = SUNTRUE;
 
+      /* With a limited number of slots, drop check points not needed */
+      if (ca_mem->ca_nslots > 0) {
+        if (CVAckpntThin(cv_mem) != CV_SUCCESS) {
+          cvProcessError(cv_mem, CV_MEM_FAIL, "CVODEA", "CVodeF", MSGCV_MEM_FAIL);
+          flag = CV_MEM_FAIL;
+          break;
+        }
+      }
+
       /* Reset i=0 and load dt_mem[0] */
       dt_mem[0]->t = ca_mem->ck_mem->ck_t0;
       ca_mem->ca_IMstore(cv_mem, dt_mem[0]);
@@ -615,6 +670,7 @@ int CVodeF(void *cvode_mem, realtype tout, N_Vector yout,
   /* Data is available for the last interval */
   ca_mem->ca_IMnewData = SUNTRUE;
   ca_mem->ca_ckpntData = ca_mem->ck_mem;
+  ca_mem->ca_ckpntBlk = ca_mem->ck_mem->ck_nst / ca_mem->ca_nsteps;
   ca_mem->ca_np = cv_mem->cv_nst % ca_mem->ca_nsteps + 1;
 
   SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
@@ -1283,7 +1339,7 @@ int CVodeB(void *cvode_mem, realtype tBout, int itaskB)
   CVodeBMem cvB_mem, tmp_cvB_mem;
   CVckpntMem ck_mem;
   int sign, flag=0;
-  realtype tfuzz, tBret, tBn;
+  realtype tfuzz, tBret, tBn, tck;
   booleantype gotCheckpoint, isActive, reachedTBout;
 
   /* Check if cvode_mem exists */
@@ -1430,11 +1486,28 @@ int CVodeB(void *cvode_mem, realtype tBout, int itaskB)
     /* Store interpolation data if not available.
        This is the 2nd forward integration pass */
 
-    if (ck_mem != ca_mem->ca_ckpntData) {
+    if (ca_mem->ca_nslots > 0) {
+      flag = CVArevolve(cv_mem, &ck_mem);
+      if (flag != CV_SUCCESS) break;
+    } else if (ck_mem != ca_mem->ca_ckpntData) {
       flag = CVAdataStore(cv_mem, ck_mem);
       if (flag != CV_SUCCESS) break;
     }
 
+    /* Time at which the interpolation data starts */
+
+    if (ca_mem->ca_nslots > 0)
+      tck = ca_mem->ca_tblk[ca_mem->ca_ckpntBlk];
+    else
+      tck = ck_mem->ck_t0;
+
+    /* Start loading the check point needed next from the checkpoint
+       store while the backward problems are integrated */
+
+    if (ck_mem->ck_next != NULL && ck_mem->ck_next->ck_store != NULL)
+      (void) SUNCheckpointStore_Prefetch(ck_mem->ck_next->ck_store,
+                                         ck_mem->ck_next->ck_key);
+
     /* Loop through all backward problems and, if needed,
      * propagate their solution towards tBout */
 
@@ -1447,10 +1520,10 @@ int CVodeB(void *cvode_mem, realtype tBout, int itaskB)
 
       tBn = tmp_cvB_mem->cv_mem->cv_tn;
 
-      if ( (tBn == ck_mem->ck_t0) && (sign*(tBout-ck_mem->ck_t0) < ZERO ) ) isActive = SUNFALSE;
-      if ( (tBn == ck_mem->ck_t0) && (itaskB==CV_ONE_STEP) ) isActive = SUNFALSE;
+      if ( (tBn == tck) && (sign*(tBout-tck) < ZERO ) ) isActive = SUNFALSE;
+      if ( (tBn == tck) && (itaskB==CV_ONE_STEP) ) isActive = SUNFALSE;
 
-      if ( sign * (tBn - ck_mem->ck_t0) < ZERO ) isActive = SUNFALSE;
+      if ( sign * (tBn - tck) < ZERO ) isActive = SUNFALSE;
 
       if ( isActive ) {
 
@@ -1459,7 +1532,7 @@ int CVodeB(void *cvode_mem, realtype tBout, int itaskB)
         ca_mem->ca_bckpbCrt = tmp_cvB_mem;
 
         /* Integrate current backward problem */
-        CVodeSetStopTime(tmp_cvB_mem->cv_mem, ck_mem->ck_t0);
+        CVodeSetStopTime(tmp_cvB_mem->cv_mem, tck);
         flag = CVode(tmp_cvB_mem->cv_mem, tBout, tmp_cvB_mem->cv_y, &tBret, itaskB);
 
         /* Set the time at which we will report solution and/or quadratures */
@@ -1506,9 +1579,13 @@ int CVodeB(void *cvode_mem, realtype tBout, int itaskB)
 
     if ( reachedTBout ) break;
 
-    /* Move check point in linked list to next one */
+    /* Move check point in linked list to next one (with binomial
+       checkpointing, unless earlier blocks of the current check point
+       remain) */
 
-    ck_mem = ck_mem->ck_next;
+    if ( (ca_mem->ca_nslots == 0) ||
+         (ca_mem->ca_ckpntBlk == ck_mem->ck_nst / ca_mem->ca_nsteps) )
+      ck_mem = ck_mem->ck_next;
 
   }
 
@@ -1640,6 +1717,9 @@ static CVckpntMem CVAckpntInit(CVodeMem cv_mem)
   ck_mem = (CVckpntMem) malloc(sizeof(struct CVckpntMemRec));
   if (ck_mem == NULL) return(NULL);
 
+  /* The data at the initial time is always kept in N_Vectors */
+  ck_mem->ck_store = NULL;
+
   ck_mem->ck_zn[0] = N_VClone(cv_mem->cv_tempv);
   if (ck_mem->ck_zn[0] == NULL) {
     free(ck_mem); ck_mem = NULL;
@@ -1724,6 +1804,9 @@ static CVckpntMem CVAckpntInit(CVodeMem cv_mem)
                                cv_mem->cv_znQS[0], ck_mem->ck_znQS[0]);
   }
 
+  /* Created by CVodeF */
+  ck_mem->ck_temp  = SUNFALSE;
+
   /* Next in list */
   ck_mem->ck_next  = NULL;
 
@@ -1749,6 +1832,7 @@ static CVckpntMem CVAckpntNew(CVodeMem cv_mem)
 
   /* Set cv_next to NULL */
   ck_mem->ck_next = NULL;
+  ck_mem->ck_temp = SUNFALSE;
 
   /* Test if we need to allocate space for the last zn.
    * NOTE: zn(qmax) may be needed for a hot restart, if an order
@@ -1756,6 +1840,18 @@ static CVckpntMem CVAckpntNew(CVodeMem cv_mem)
   qmax = cv_mem->cv_qmax;
   ck_mem->ck_zqm = (cv_mem->cv_q < qmax) ? qmax : 0;
 
+  /* Save the history arrays in the checkpoint store if one is set */
+  ck_mem->ck_store = NULL;
+
+  if (cv_mem->cv_adj_mem->ca_ckstore != NULL) {
+    if (CVAckpntStore(cv_mem, ck_mem) != CV_SUCCESS) {
+      free(ck_mem); ck_mem = NULL;
+      return(NULL);
+    }
+    CVAckpntSaveStepData(cv_mem, ck_mem);
+    return(ck_mem);
+  }
+
   for (j=0; j<=cv_mem->cv_q; j++) {
     ck_mem->ck_zn[j] = N_VClone(cv_mem->cv_tempv);
     if (ck_mem->ck_zn[j] == NULL) {
@@ -1948,6 +2044,22 @@ static CVckpntMem CVAckpntNew(CVodeMem cv_mem)
     }
   }
 
+  CVAckpntSaveStepData(cv_mem, ck_mem);
+
+  return(ck_mem);
+}
+
+/*
+ * CVAckpntSaveStepData
+ *
+ * This routine copies the step data (everything but the history
+ * arrays) from cv_mem to a new check point.
+ */
+
+static void CVAckpntSaveStepData(CVodeMem cv_mem, CVckpntMem ck_mem)
+{
+  int j;
+
   for (j=0; j<=L_MAX; j++)        ck_mem->ck_tau[j] = cv_mem->cv_tau[j];
   for (j=0; j<=NUM_TESTS; j++)    ck_mem->ck_tq[j] = cv_mem->cv_tq[j];
   for (j=0; j<=cv_mem->cv_q; j++) ck_mem->ck_l[j] = cv_mem->cv_l[j];
@@ -1965,8 +2077,132 @@ static CVckpntMem CVAckpntNew(CVodeMem cv_mem)
   ck_mem->ck_etamax    = cv_mem->cv_etamax;
   ck_mem->ck_t0        = cv_mem->cv_tn;
   ck_mem->ck_saved_tq5 = cv_mem->cv_saved_tq5;
+}
 
-  return(ck_mem);
+/*
+ * CVAckpntXfer
+ *
+ * This routine walks over the history arrays saved at a check point:
+ * zn[0],...,zn[q] and zn[qmax] (if q < qmax) and, if carried, the
+ * corresponding quadrature, sensitivity, and quadrature sensitivity
+ * arrays. With mode = 0 it only adds up their packed size, with
+ * mode = 1 it packs them from cv_mem into ca_ckbuf, and with mode = 2
+ * it unpacks them from ca_ckbuf into cv_mem. On return bytes holds
+ * the total packed size.
+ */
+
+static int CVAckpntXfer(CVodeMem cv_mem, CVckpntMem ck_mem, int mode,
+                        size_t *bytes)
+{
+  N_Vector v[4];
+  char *buf;
+  sunindextype vbytes;
+  int j, jj, k, is, nv, retval;
+
+  buf = (char*) cv_mem->cv_adj_mem->ca_ckbuf;
+  *bytes = 0;
+
+  for (jj=0; jj<=ck_mem->ck_q+1; jj++) {
+
+    /* the last pass is for zn[qmax] */
+    if (jj <= ck_mem->ck_q) j = jj;
+    else if (ck_mem->ck_zqm != 0) j = ck_mem->ck_zqm;
+    else break;
+
+    for (is=-1; is<ck_mem->ck_Ns; is++) {
+
+      nv = 0;
+      if (is < 0) {
+        v[nv++] = cv_mem->cv_zn[j];
+        if (ck_mem->ck_quadr) v[nv++] = cv_mem->cv_znQ[j];
+      } else {
+        if (ck_mem->ck_sensi) v[nv++] = cv_mem->cv_znS[j][is];
+        if (ck_mem->ck_quadr_sensi) v[nv++] = cv_mem->cv_znQS[j][is];
+      }
+
+      for (k=0; k<nv; k++) {
+        retval = N_VBufSize(v[k], &vbytes);
+        if (retval != 0) return(CV_VECTOROP_ERR);
+        if (mode == 1) retval = N_VBufPack(v[k], buf + *bytes);
+        if (mode == 2) retval = N_VBufUnpack(v[k], buf + *bytes);
+        if (retval != 0) return(CV_VECTOROP_ERR);
+        *bytes += (size_t) vbytes;
+      }
+    }
+  }
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVAckpntStore
+ *
+ * This routine packs the history arrays of a new check point and
+ * writes them to the checkpoint store.
+ */
+
+static int CVAckpntStore(CVodeMem cv_mem, CVckpntMem ck_mem)
+{
+  CVadjMem ca_mem;
+  void *buf;
+  size_t bytes;
+  int retval;
+
+  ca_mem = cv_mem->cv_adj_mem;
+
+  ck_mem->ck_q = cv_mem->cv_q;
+  ck_mem->ck_quadr = cv_mem->cv_quadr && cv_mem->cv_errconQ;
+  ck_mem->ck_sensi = cv_mem->cv_sensi;
+  ck_mem->ck_quadr_sensi = cv_mem->cv_quadr_sensi && cv_mem->cv_errconQS;
+  ck_mem->ck_Ns = (ck_mem->ck_sensi || ck_mem->ck_quadr_sensi) ? cv_mem->cv_Ns : 0;
+
+  /* Make sure the packing buffer is large enough */
+  retval = CVAckpntXfer(cv_mem, ck_mem, 0, &bytes);
+  if (retval != CV_SUCCESS) return(retval);
+
+  if (bytes > ca_mem->ca_ckbufsize) {
+    buf = realloc(ca_mem->ca_ckbuf, bytes);
+    if (buf == NULL) return(CV_MEM_FAIL);
+    ca_mem->ca_ckbuf = buf;
+    ca_mem->ca_ckbufsize = bytes;
+  }
+
+  retval = CVAckpntXfer(cv_mem, ck_mem, 1, &bytes);
+  if (retval != CV_SUCCESS) return(retval);
+
+  ck_mem->ck_key   = ++(ca_mem->ca_ckkey);
+  ck_mem->ck_bytes = bytes;
+
+  if (SUNCheckpointStore_Write(ca_mem->ca_ckstore, ck_mem->ck_key,
+                               ca_mem->ca_ckbuf, bytes) != 0)
+    return(CV_MEM_FAIL);
+
+  ck_mem->ck_store = ca_mem->ca_ckstore;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVAckpntLoad
+ *
+ * This routine reads the history arrays of a check point from the
+ * checkpoint store into cv_mem. The order cv_q must already be set.
+ */
+
+static int CVAckpntLoad(CVodeMem cv_mem, CVckpntMem ck_mem)
+{
+  CVadjMem ca_mem;
+  size_t bytes;
+
+  ca_mem = cv_mem->cv_adj_mem;
+
+  if (SUNCheckpointStore_Read(ck_mem->ck_store, ck_mem->ck_key,
+                              ca_mem->ca_ckbuf, ck_mem->ck_bytes) != 0) {
+    cvProcessError(cv_mem, CV_MEM_FAIL, "CVODEA", "CVAckpntLoad", MSGCV_CKSTORE_FAIL);
+    return(CV_MEM_FAIL);
+  }
+
+  return(CVAckpntXfer(cv_mem, ck_mem, 2, &bytes));
 }
 
 /*
@@ -1989,6 +2225,13 @@ static void CVAckpntDelete(CVckpntMem *ck_memPtr)
   /* move head of list */
   *ck_memPtr = (*ck_memPtr)->ck_next;
 
+  /* release the data in the checkpoint store */
+  if (tmp->ck_store != NULL) {
+    (void) SUNCheckpointStore_Remove(tmp->ck_store, tmp->ck_key);
+    free(tmp); tmp = NULL;
+    return;
+  }
+
   /* free N_Vectors in tmp */
   for (j=0;j<=tmp->ck_q;j++) N_VDestroy(tmp->ck_zn[j]);
   if (tmp->ck_zqm != 0) N_VDestroy(tmp->ck_zn[tmp->ck_zqm]);
@@ -2039,6 +2282,86 @@ static void CVAckpntDelete(CVckpntMem *ck_memPtr)
 
 }
 
+/*
+ * CVAckpntRemove
+ *
+ * This routine deletes the check point *ck_memPtr from anywhere in
+ * the list, extending the interval of the previous check point.
+ */
+
+static void CVAckpntRemove(CVodeMem cv_mem, CVckpntMem *ck_memPtr)
+{
+  CVadjMem ca_mem;
+  CVckpntMem ck_mem;
+
+  ca_mem = cv_mem->cv_adj_mem;
+  ck_mem = *ck_memPtr;
+
+  if (ck_mem->ck_next != NULL) ck_mem->ck_next->ck_t1 = ck_mem->ck_t1;
+  if (ca_mem->ca_ckpntData == ck_mem) ca_mem->ca_ckpntData = NULL;
+
+  CVAckpntDelete(ck_memPtr);
+  ca_mem->ca_nckpnts--;
+}
+
+/*
+ * CVAckpntThin
+ *
+ * With binomial checkpointing, this routine is called by CVodeF each
+ * time a check point is added at the start of a block of nsteps
+ * steps. It records the start time of the block and keeps the
+ * previous check point only if it lies on the grid of blocks spaced
+ * ca_ckspace apart. Whenever more than half of the slots are in use
+ * the grid spacing is doubled and the check points no longer on the
+ * grid are deleted, leaving the other slots for CVodeB.
+ */
+
+static int CVAckpntThin(CVodeMem cv_mem)
+{
+  CVadjMem ca_mem;
+  CVckpntMem ck_mem, *ck_link;
+  realtype *tblk;
+  long int blk, nalloc, nfwd;
+
+  ca_mem = cv_mem->cv_adj_mem;
+  ck_mem = ca_mem->ck_mem;
+
+  /* Record the start time of the new block */
+  blk = ck_mem->ck_nst / ca_mem->ca_nsteps;
+
+  if (blk >= ca_mem->ca_tblkalloc) {
+    nalloc = SUNMAX(64, 2*blk);
+    tblk = (realtype *) realloc(ca_mem->ca_tblk, nalloc*sizeof(realtype));
+    if (tblk == NULL) return(CV_MEM_FAIL);
+    ca_mem->ca_tblk = tblk;
+    ca_mem->ca_tblkalloc = nalloc;
+  }
+  ca_mem->ca_tblk[blk] = ck_mem->ck_t0;
+
+  if (ck_mem->ck_next == NULL) return(CV_SUCCESS);
+
+  /* Keep the previous check point if it is the first one or on the grid */
+  if ( (ck_mem->ck_next->ck_next != NULL) &&
+       ((ck_mem->ck_next->ck_nst / ca_mem->ca_nsteps) % ca_mem->ca_ckspace != 0) )
+    CVAckpntRemove(cv_mem, &(ck_mem->ck_next));
+
+  /* Coarsen the grid while more than half of the slots are used */
+  nfwd = SUNMAX(2, (ca_mem->ca_nslots + 1) / 2);
+
+  while (ca_mem->ca_nckpnts + 1 > nfwd) {
+    ca_mem->ca_ckspace *= 2;
+    ck_link = &(ck_mem->ck_next);
+    while ((*ck_link)->ck_next != NULL) {
+      if (((*ck_link)->ck_nst / ca_mem->ca_nsteps) % ca_mem->ca_ckspace != 0)
+        CVAckpntRemove(cv_mem, ck_link);
+      else
+        ck_link = &((*ck_link)->ck_next);
+    }
+  }
+
+  return(CV_SUCCESS);
+}
+
 /*
  * =================================================================
  * PRIVATE FUNCTIONS FOR BACKWARD PROBLEMS
@@ -2098,52 +2421,272 @@ static void CVAbckpbDelete(CVodeBMem *cvB_memPtr)
 static int CVAdataStore(CVodeMem cv_mem, CVckpntMem ck_mem)
 {
   CVadjMem ca_mem;
-  CVdtpntMem *dt_mem;
-  realtype t;
-  long int i;
-  int flag, sign;
+  int flag;
 
   ca_mem = cv_mem->cv_adj_mem;
-  dt_mem = ca_mem->dt_mem;
 
   /* Initialize cv_mem with data from ck_mem */
   flag = CVAckpntGet(cv_mem, ck_mem);
   if (flag != CV_SUCCESS)
     return(CV_REIFWD_FAIL);
 
-  /* Set first structure in dt_mem[0] */
-  dt_mem[0]->t = ck_mem->ck_t0;
-  ca_mem->ca_IMstore(cv_mem, dt_mem[0]);
-
   /* Decide whether TSTOP must be activated */
   if (ca_mem->ca_tstopCVodeFcall) {
     CVodeSetStopTime(cv_mem, ca_mem->ca_tstopCVodeF);
   }
 
+  /* Run CVode to set the structures in dt_mem */
+  flag = CVAdataRecord(cv_mem, ck_mem->ck_t0, ck_mem->ck_t1);
+  if (flag != CV_SUCCESS) return(flag);
+
+  ca_mem->ca_ckpntData = ck_mem;   /* data is available starting at this check point */
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVAdataRecord
+ *
+ * This routine integrates the forward problem from its current state
+ * at t0 to t1, storing the interpolation data at each step in dt_mem.
+ */
+
+static int CVAdataRecord(CVodeMem cv_mem, realtype t0, realtype t1)
+{
+  CVadjMem ca_mem;
+  CVdtpntMem *dt_mem;
+  realtype t;
+  long int i;
+  int flag, sign;
+
+  ca_mem = cv_mem->cv_adj_mem;
+  dt_mem = ca_mem->dt_mem;
+
   sign = (ca_mem->ca_tfinal - ca_mem->ca_tinitial > ZERO) ? 1 : -1;
 
+  /* Set first structure in dt_mem[0] */
+  dt_mem[0]->t = t0;
+  ca_mem->ca_IMstore(cv_mem, dt_mem[0]);
 
   /* Run CVode to set following structures in dt_mem[i] */
   i = 1;
   do {
 
-    flag = CVode(cv_mem, ck_mem->ck_t1, ca_mem->ca_ytmp, &t, CV_ONE_STEP);
+    if (i > ca_mem->ca_nsteps) return(CV_FWD_FAIL);
+
+    flag = CVode(cv_mem, t1, ca_mem->ca_ytmp, &t, CV_ONE_STEP);
     if (flag < 0) return(CV_FWD_FAIL);
+    ca_mem->ca_nstR++;
 
     dt_mem[i]->t = t;
     ca_mem->ca_IMstore(cv_mem, dt_mem[i]);
     i++;
 
-  } while ( sign*(ck_mem->ck_t1 - t) > ZERO );
+  } while ( sign*(t1 - t) > ZERO );
+
+
+  ca_mem->ca_IMnewData = SUNTRUE;     /* New data is now available */
+  ca_mem->ca_np = i;                  /* and we have this many points */
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVAadvance
+ *
+ * This routine integrates the forward problem from its current state
+ * until nst steps have been taken, without storing any data. As in
+ * CVodeF, a linear solver setup is forced at the start of each block
+ * of nsteps steps.
+ */
+
+static int CVAadvance(CVodeMem cv_mem, long int nst)
+{
+  CVadjMem ca_mem;
+  realtype t;
+  int flag;
+
+  ca_mem = cv_mem->cv_adj_mem;
+
+  while (cv_mem->cv_nst < nst) {
+
+    flag = CVode(cv_mem, ca_mem->ca_tfinal, ca_mem->ca_ytmp, &t, CV_ONE_STEP);
+    if (flag < 0) return(CV_FWD_FAIL);
+    ca_mem->ca_nstR++;
+
+    if (cv_mem->cv_nst % ca_mem->ca_nsteps == 0) cv_mem->cv_forceSetup = SUNTRUE;
+  }
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVArevolve
+ *
+ * With binomial checkpointing, this routine makes interpolation data
+ * available for the block of nsteps steps containing the latest time
+ * reached by the backward problems, which lies in the interval of the
+ * check point *ck_memPtr. The interval is reversed as in the revolve
+ * algorithm of Griewank and Walther: while free slots remain and the
+ * block is not the first one in the interval, the forward problem is
+ * advanced by the optimal number of blocks and a new check point is
+ * taken, which becomes *ck_memPtr. Check points taken this way are
+ * deleted once the backward problems have passed them.
+ */
+
+static int CVArevolve(CVodeMem cv_mem, CVckpntMem *ck_memPtr)
+{
+  CVadjMem ca_mem;
+  CVodeBMem tmp_cvB_mem;
+  CVckpntMem ck_mem, ck_newer, tmp, *ck_link;
+  realtype tB, t1;
+  long int blk, blkB, blkE, lo, hi, mid, nfree, k;
+  int flag, sign;
+
+  ca_mem = cv_mem->cv_adj_mem;
+  ck_mem = *ck_memPtr;
+
+  sign = (ca_mem->ca_tfinal - ca_mem->ca_tinitial > ZERO) ? 1 : -1;
+
+  /* Delete the check points taken for intervals that have been
+     completed and find the check point after ck_mem */
+
+  ck_newer = NULL;
+  ck_link  = &(ca_mem->ck_mem);
+  while (*ck_link != ck_mem) {
+    if ((*ck_link)->ck_temp) {
+      CVAckpntRemove(cv_mem, ck_link);
+    } else {
+      ck_newer = *ck_link;
+      ck_link  = &(ck_newer->ck_next);
+    }
+  }
+
+  /* Latest time reached by the backward problems */
+
+  tB = ck_mem->ck_t0;
+  for (tmp_cvB_mem = ca_mem->cvB_mem; tmp_cvB_mem != NULL;
+       tmp_cvB_mem = tmp_cvB_mem->cv_next) {
+    if (sign*(tmp_cvB_mem->cv_mem->cv_tn - tB) > ZERO)
+      tB = tmp_cvB_mem->cv_mem->cv_tn;
+  }
+
+  for(;;) {
+
+    /* The interval of ck_mem spans the blocks blk,...,blkE-1. Find the
+       block blkB containing tB. */
 
+    blk  = ck_mem->ck_nst / ca_mem->ca_nsteps;
+    blkE = (ck_newer == NULL) ? blk+1 : ck_newer->ck_nst / ca_mem->ca_nsteps;
 
-  ca_mem->ca_IMnewData = SUNTRUE;     /* New data is now available    */
-  ca_mem->ca_ckpntData = ck_mem;   /* starting at this check point */
-  ca_mem->ca_np = i;               /* and we have this many points */
+    blkB = blk;
+    lo = blk + 1;
+    hi = blkE - 1;
+    while (lo <= hi) {
+      mid = (lo + hi) / 2;
+      if (sign*(tB - ca_mem->ca_tblk[mid]) > ZERO) {
+        blkB = mid;
+        lo = mid + 1;
+      } else {
+        hi = mid - 1;
+      }
+    }
+
+    /* Is the data already available? */
+
+    if ( (ck_mem == ca_mem->ca_ckpntData) && (blkB == ca_mem->ca_ckpntBlk) )
+      break;
+
+    /* Restart the forward problem from ck_mem */
+
+    flag = CVAckpntGet(cv_mem, ck_mem);
+    if (flag != CV_SUCCESS) return(CV_REIFWD_FAIL);
+
+    if (ca_mem->ca_tstopCVodeFcall)
+      CVodeSetStopTime(cv_mem, ca_mem->ca_tstopCVodeF);
+
+    nfree = ca_mem->ca_nslots - (ca_mem->ca_nckpnts + 1);
+
+    if ( (blkB == blk) || (nfree <= 0) ) {
+
+      /* Advance to block blkB and store its interpolation data */
+
+      flag = CVAadvance(cv_mem, blkB*ca_mem->ca_nsteps);
+      if (flag != CV_SUCCESS) return(flag);
+
+      t1 = (blkB+1 < blkE) ? ca_mem->ca_tblk[blkB+1] : ck_mem->ck_t1;
+
+      flag = CVAdataRecord(cv_mem, ca_mem->ca_tblk[blkB], t1);
+      if (flag != CV_SUCCESS) return(flag);
+
+      ca_mem->ca_ckpntData = ck_mem;
+      ca_mem->ca_ckpntBlk  = blkB;
+
+      break;
+    }
+
+    /* Advance by the optimal number of blocks, take a check point, and
+       insert it in the list after ck_mem */
+
+    k = CVArevolveSplit(blkB - blk + 1, nfree + 1);
+
+    flag = CVAadvance(cv_mem, (blk + k)*ca_mem->ca_nsteps);
+    if (flag != CV_SUCCESS) return(flag);
+
+    tmp = CVAckpntNew(cv_mem);
+    if (tmp == NULL) return(CV_MEM_FAIL);
+
+    tmp->ck_temp  = SUNTRUE;
+    tmp->ck_t1    = ck_mem->ck_t1;
+    ck_mem->ck_t1 = tmp->ck_t0;
+    tmp->ck_next  = ck_mem;
+    *ck_link      = tmp;
+    ca_mem->ca_nckpnts++;
+
+    ck_mem = tmp;
+  }
+
+  *ck_memPtr = ck_mem;
 
   return(CV_SUCCESS);
 }
 
+/*
+ * CVArevolveSplit
+ *
+ * This routine returns the number of blocks to advance before taking
+ * a check point when reversing m > 1 blocks with s > 1 check points
+ * (including the one at the start), minimizing the total number of
+ * blocks recomputed (Griewank and Walther, ACM TOMS 26(1), 2000).
+ */
+
+static long int CVArevolveSplit(long int m, long int s)
+{
+  long int reps, range, bino1, bino2, bino3, bino4, bino5, k;
+
+  /* Find the number of repetitions needed, range = (s+reps)!/(s! reps!) */
+  reps  = 0;
+  range = 1;
+  while (range < m) {
+    reps++;
+    range = range*(reps + s)/reps;
+  }
+
+  bino1 = range*reps/(s + reps);
+  bino2 = (s > 1) ? bino1*s/(s + reps - 1) : 1;
+  if (s == 1) bino3 = 0;
+  else        bino3 = (s > 2) ? bino2*(s - 1)/(s + reps - 2) : 1;
+  bino4 = bino2*(reps - 1)/s;
+  if (s < 3)  bino5 = 0;
+  else        bino5 = (s > 3) ? bino3*(s - 2)/reps : 1;
+
+  if (m <= bino1 + bino3)       k = bino4;
+  else if (m >= range - bino5)  k = bino1;
+  else                          k = m - bino2 - bino3;
+
+  return(SUNMAX(k, 1));
+}
+
 /*
  * CVAckpntGet
  *
@@ -2202,76 +2745,86 @@ static int CVAckpntGet(CVodeMem cv_mem, CVckpntMem ck_mem)
     cv_mem->cv_tn        = ck_mem->ck_t0;
     cv_mem->cv_saved_tq5 = ck_mem->ck_saved_tq5;
 
-    /* Copy the arrays from check point data structure */
+    /* Copy the arrays from the checkpoint store or the check point
+       data structure */
 
-    for (j=0; j<=cv_mem->cv_q; j++)
-      cv_mem->cv_cvals[j] = ONE;
+    if (ck_mem->ck_store != NULL) {
 
-    retval = N_VScaleVectorArray(cv_mem->cv_q+1, cv_mem->cv_cvals,
-                                 ck_mem->ck_zn, cv_mem->cv_zn);
-    if (retval != CV_SUCCESS) return (CV_VECTOROP_ERR);
+      retval = CVAckpntLoad(cv_mem, ck_mem);
+      if (retval != CV_SUCCESS) return(retval);
 
-    if ( cv_mem->cv_q < qmax )
-      N_VScale(ONE, ck_mem->ck_zn[qmax], cv_mem->cv_zn[qmax]);
+    } else {
 
-    if (ck_mem->ck_quadr) {
       for (j=0; j<=cv_mem->cv_q; j++)
         cv_mem->cv_cvals[j] = ONE;
 
       retval = N_VScaleVectorArray(cv_mem->cv_q+1, cv_mem->cv_cvals,
-                                   ck_mem->ck_znQ, cv_mem->cv_znQ);
+                                   ck_mem->ck_zn, cv_mem->cv_zn);
       if (retval != CV_SUCCESS) return (CV_VECTOROP_ERR);
 
       if ( cv_mem->cv_q < qmax )
-        N_VScale(ONE, ck_mem->ck_znQ[qmax], cv_mem->cv_znQ[qmax]);
-    }
+        N_VScale(ONE, ck_mem->ck_zn[qmax], cv_mem->cv_zn[qmax]);
 
-    if (ck_mem->ck_sensi) {
-      for (j=0; j<=cv_mem->cv_q; j++) {
-        for (is=0; is<cv_mem->cv_Ns; is++) {
-          cv_mem->cv_cvals[j*cv_mem->cv_Ns+is] = ONE;
-          cv_mem->cv_Xvecs[j*cv_mem->cv_Ns+is] = ck_mem->ck_znS[j][is];
-          cv_mem->cv_Zvecs[j*cv_mem->cv_Ns+is] = cv_mem->cv_znS[j][is];
-        }
-      }
+      if (ck_mem->ck_quadr) {
+        for (j=0; j<=cv_mem->cv_q; j++)
+          cv_mem->cv_cvals[j] = ONE;
 
-      retval = N_VScaleVectorArray(cv_mem->cv_Ns*(cv_mem->cv_q+1),
-                                   cv_mem->cv_cvals,
-                                   cv_mem->cv_Xvecs, cv_mem->cv_Zvecs);
-      if (retval != CV_SUCCESS) return (CV_VECTOROP_ERR);
+        retval = N_VScaleVectorArray(cv_mem->cv_q+1, cv_mem->cv_cvals,
+                                     ck_mem->ck_znQ, cv_mem->cv_znQ);
+        if (retval != CV_SUCCESS) return (CV_VECTOROP_ERR);
 
-      if ( cv_mem->cv_q < qmax ) {
-        for (is=0; is<cv_mem->cv_Ns; is++)
-          cv_mem->cv_cvals[is] = ONE;
+        if ( cv_mem->cv_q < qmax )
+          N_VScale(ONE, ck_mem->ck_znQ[qmax], cv_mem->cv_znQ[qmax]);
+      }
+
+      if (ck_mem->ck_sensi) {
+        for (j=0; j<=cv_mem->cv_q; j++) {
+          for (is=0; is<cv_mem->cv_Ns; is++) {
+            cv_mem->cv_cvals[j*cv_mem->cv_Ns+is] = ONE;
+            cv_mem->cv_Xvecs[j*cv_mem->cv_Ns+is] = ck_mem->ck_znS[j][is];
+            cv_mem->cv_Zvecs[j*cv_mem->cv_Ns+is] = cv_mem->cv_znS[j][is];
+          }
+        }
 
-        retval = N_VScaleVectorArray(cv_mem->cv_Ns, cv_mem->cv_cvals,
-                                     ck_mem->ck_znS[qmax], cv_mem->cv_znS[qmax]);
+        retval = N_VScaleVectorArray(cv_mem->cv_Ns*(cv_mem->cv_q+1),
+                                     cv_mem->cv_cvals,
+                                     cv_mem->cv_Xvecs, cv_mem->cv_Zvecs);
         if (retval != CV_SUCCESS) return (CV_VECTOROP_ERR);
-      }
-    }
 
-    if (ck_mem->ck_quadr_sensi) {
-      for (j=0; j<=cv_mem->cv_q; j++) {
-        for (is=0; is<cv_mem->cv_Ns; is++) {
-          cv_mem->cv_cvals[j*cv_mem->cv_Ns+is] = ONE;
-          cv_mem->cv_Xvecs[j*cv_mem->cv_Ns+is] = ck_mem->ck_znQS[j][is];
-          cv_mem->cv_Zvecs[j*cv_mem->cv_Ns+is] = cv_mem->cv_znQS[j][is];
+        if ( cv_mem->cv_q < qmax ) {
+          for (is=0; is<cv_mem->cv_Ns; is++)
+            cv_mem->cv_cvals[is] = ONE;
+
+          retval = N_VScaleVectorArray(cv_mem->cv_Ns, cv_mem->cv_cvals,
+                                       ck_mem->ck_znS[qmax], cv_mem->cv_znS[qmax]);
+          if (retval != CV_SUCCESS) return (CV_VECTOROP_ERR);
         }
       }
 
-      retval = N_VScaleVectorArray(cv_mem->cv_Ns*(cv_mem->cv_q+1),
-                                   cv_mem->cv_cvals,
-                                   cv_mem->cv_Xvecs, cv_mem->cv_Zvecs);
-      if (retval != CV_SUCCESS) return (CV_VECTOROP_ERR);
-
-      if ( cv_mem->cv_q < qmax ) {
-        for (is=0; is<cv_mem->cv_Ns; is++)
-          cv_mem->cv_cvals[is] = ONE;
+      if (ck_mem->ck_quadr_sensi) {
+        for (j=0; j<=cv_mem->cv_q; j++) {
+          for (is=0; is<cv_mem->cv_Ns; is++) {
+            cv_mem->cv_cvals[j*cv_mem->cv_Ns+is] = ONE;
+            cv_mem->cv_Xvecs[j*cv_mem->cv_Ns+is] = ck_mem->ck_znQS[j][is];
+            cv_mem->cv_Zvecs[j*cv_mem->cv_Ns+is] = cv_mem->cv_znQS[j][is];
+          }
+        }
 
-        retval = N_VScaleVectorArray(cv_mem->cv_Ns, cv_mem->cv_cvals,
-                                     ck_mem->ck_znQS[qmax], cv_mem->cv_znQS[qmax]);
+        retval = N_VScaleVectorArray(cv_mem->cv_Ns*(cv_mem->cv_q+1),
+                                     cv_mem->cv_cvals,
+                                     cv_mem->cv_Xvecs, cv_mem->cv_Zvecs);
         if (retval != CV_SUCCESS) return (CV_VECTOROP_ERR);
+
+        if ( cv_mem->cv_q < qmax ) {
+          for (is=0; is<cv_mem->cv_Ns; is++)
+            cv_mem->cv_cvals[is] = ONE;
+
+          retval = N_VScaleVectorArray(cv_mem->cv_Ns, cv_mem->cv_cvals,
+                                       ck_mem->ck_znQS[qmax], cv_mem->cv_znQS[qmax]);
+          if (retval != CV_SUCCESS) return (CV_VECTOROP_ERR);
+        }
       }
+
     }
 
     for (j=0; j<=L_MAX; j++)        cv_mem->cv_tau[j] = ck_mem->ck_tau[j];
@@ -38,6 +38,7 @@
  * =================================================================
  */
 
+#define ZERO        RCONST(0.0)
 #define ONE         RCONST(1.0) 
 
 /* 
@@ -76,6 +77,97 @@ int CVodeSetAdjNoSensi(void *cvode_mem)
   return(CV_SUCCESS);
 }
 
+/*
+ * CVodeSetAdjCheckpointStore
+ *
+ * Keeps the history arrays of the check points in a checkpoint store
+ * instead of N_Vectors. A NULL store restores the default.
+ */
+
+int CVodeSetAdjCheckpointStore(void *cvode_mem, SUNCheckpointStore store)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+  N_Vector v;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODEA", "CVodeSetAdjCheckpointStore", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem) cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE) {
+    cvProcessError(cv_mem, CV_NO_ADJ, "CVODEA", "CVodeSetAdjCheckpointStore", MSGCV_NO_ADJ);
+    return(CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  /* Check points may not change storage once CVodeF was called */
+  if (!ca_mem->ca_firstCVodeFcall) {
+    cvProcessError(cv_mem, CV_ILL_INPUT, "CVODEA", "CVodeSetAdjCheckpointStore", MSGCV_CKSTORE_LATE);
+    return(CV_ILL_INPUT);
+  }
+
+  /* The check point data is packed with the N_Vector buffer operations */
+  v = cv_mem->cv_tempv;
+  if (store != NULL &&
+      (v->ops->nvbufsize == NULL || v->ops->nvbufpack == NULL ||
+       v->ops->nvbufunpack == NULL)) {
+    cvProcessError(cv_mem, CV_ILL_INPUT, "CVODEA", "CVodeSetAdjCheckpointStore", MSGCV_CKSTORE_VEC);
+    return(CV_ILL_INPUT);
+  }
+
+  ca_mem->ca_ckstore = store;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVodeSetAdjCheckpointSlots
+ *
+ * Limits the number of check points kept at any time to nslots and
+ * enables binomial checkpointing. nslots = 0 restores the default,
+ * where a check point is kept every nsteps steps.
+ */
+
+int CVodeSetAdjCheckpointSlots(void *cvode_mem, int nslots)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODEA", "CVodeSetAdjCheckpointSlots", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem) cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE) {
+    cvProcessError(cv_mem, CV_NO_ADJ, "CVODEA", "CVodeSetAdjCheckpointSlots", MSGCV_NO_ADJ);
+    return(CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  /* The check point schedule may not change once CVodeF was called */
+  if (!ca_mem->ca_firstCVodeFcall) {
+    cvProcessError(cv_mem, CV_ILL_INPUT, "CVODEA", "CVodeSetAdjCheckpointSlots", MSGCV_NSLOTS_LATE);
+    return(CV_ILL_INPUT);
+  }
+
+  /* The first check point and the latest one are always kept */
+  if ( (nslots < 0) || (nslots == 1) ) {
+    cvProcessError(cv_mem, CV_ILL_INPUT, "CVODEA", "CVodeSetAdjCheckpointSlots", MSGCV_BAD_NSLOTS);
+    return(CV_ILL_INPUT);
+  }
+
+  ca_mem->ca_nslots = nslots;
+
+  return(CV_SUCCESS);
+}
+
 /* 
  * -----------------------------------------------------------------
  * Optional input functions for backward integration
@@ -611,6 +703,70 @@ int CVodeGetAdjCheckPointsInfo(void *cvode_mem, CVadjCheckPointRec *ckpnt)
 }
 
 
+/*
+ * CVodeGetAdjNumRecomputedSteps
+ *
+ * Returns the number of forward steps recomputed by CVodeB.
+ */
+
+int CVodeGetAdjNumRecomputedSteps(void *cvode_mem, long int *nstR)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODEA", "CVodeGetAdjNumRecomputedSteps", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem) cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE) {
+    cvProcessError(cv_mem, CV_NO_ADJ, "CVODEA", "CVodeGetAdjNumRecomputedSteps", MSGCV_NO_ADJ);
+    return(CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  *nstR = ca_mem->ca_nstR;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVodeGetAdjRecomputationRatio
+ *
+ * Returns the ratio of the number of forward steps recomputed by
+ * CVodeB to the number of steps taken by CVodeF.
+ */
+
+int CVodeGetAdjRecomputationRatio(void *cvode_mem, realtype *ratio)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODEA", "CVodeGetAdjRecomputationRatio", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem) cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE) {
+    cvProcessError(cv_mem, CV_NO_ADJ, "CVODEA", "CVodeGetAdjRecomputationRatio", MSGCV_NO_ADJ);
+    return(CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  if (ca_mem->ca_nstF > 0)
+    *ratio = (realtype) ca_mem->ca_nstR / (realtype) ca_mem->ca_nstF;
+  else
+    *ratio = ZERO;
+
+  return(CV_SUCCESS);
+}
+
 /* 
  * -----------------------------------------------------------------
  * Undocumented Development User-Callable Functions
@@ -767,6 +767,15 @@ struct CVckpntMemRec {
   /* Saved values */
   realtype ck_saved_tq5;
 
+  /* Checkpoint store holding the history arrays (NULL if they are kept
+     in the N_Vectors above), key and size of the stored data */
+  SUNCheckpointStore ck_store;
+  long int ck_key;
+  size_t   ck_bytes;
+
+  /* Was this check point created by CVodeB (binomial checkpointing)? */
+  booleantype ck_temp;
+
   /* Pointer to next structure in list */
   struct CVckpntMemRec *ck_next;
 
@@ -943,6 +952,27 @@ struct CVadjMemRec {
   /* address of the check point structure for which data is available */
   struct CVckpntMemRec *ca_ckpntData;
 
+  /* Optional store for the check point history arrays and a buffer
+     used to pack them */
+  SUNCheckpointStore ca_ckstore;
+  void *ca_ckbuf;
+  size_t ca_ckbufsize;
+  long int ca_ckkey;
+
+  /* Binomial checkpointing: number of check point slots (0 if all check
+     points are kept), spacing of the check points kept by CVodeF (in
+     blocks of nsteps steps), start times of the blocks, and block of
+     the data available in dt_mem */
+  int ca_nslots;
+  long int ca_ckspace;
+  realtype *ca_tblk;
+  long int ca_tblkalloc;
+  long int ca_ckpntBlk;
+
+  /* Number of steps taken by CVodeF and recomputed by CVodeB */
+  long int ca_nstF;
+  long int ca_nstR;
+
   /* ------------------
    * Interpolation data
    * ------------------ */
@@ -1380,6 +1410,11 @@ int cvSensRhs1InternalDQ(int Ns, realtype t,
 #define MSGCV_BACK_ERROR  "Error occured while integrating backward problem # %d"
 #define MSGCV_BAD_TINTERP "Bad t = %g for interpolation."
 #define MSGCV_WRONG_INTERP "This function cannot be called for the specified interp type."
+#define MSGCV_CKSTORE_LATE "The checkpoint store must be set before the first call to CVodeF."
+#define MSGCV_CKSTORE_VEC "The N_Vector does not provide the buffer operations needed by a checkpoint store."
+#define MSGCV_CKSTORE_FAIL "Storing or loading check point data failed."
+#define MSGCV_BAD_NSLOTS "The number of check point slots must be 0 or at least 2."
+#define MSGCV_NSLOTS_LATE "The number of check point slots must be set before the first call to CVodeF."
 
 #ifdef __cplusplus
 }
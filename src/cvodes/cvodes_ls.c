@@ -28,6 +28,7 @@
 #include "cvodes_ls_impl.h"
 #include <sundials/sundials_math.h>
 #include <sunmatrix/sunmatrix_band.h>
+#include <sunmatrix/sunmatrix_bsr.h>
 #include <sunmatrix/sunmatrix_dense.h>
 #include <sunmatrix/sunmatrix_sparse.h>
 
@@ -387,6 +388,108 @@ int CVodeSetJacFn(void *cvode_mem, CVLsJacFn jac)
 }
 
 
+/* CVodeSetJacSparsityPattern specifies the sparsity pattern used by the
+ * internal difference quotient Jacobian approximation with a sparse matrix.
+ * A copy of the pattern is stored and a column coloring is computed so that
+ * the Jacobian can be approximated with one RHS evaluation per color. */
+int CVodeSetJacSparsityPattern(void *cvode_mem, SUNMatrix P)
+{
+  CVodeMem     cv_mem;
+  CVLsMem      cvls_mem;
+  sunindextype N;
+  int          retval;
+
+  /* access CVLsMem structure */
+  retval = cvLs_AccessLMem(cvode_mem, "CVodeSetJacSparsityPattern",
+                           &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS)  return(retval);
+
+  /* free any existing pattern */
+  if (cvls_mem->jac_pattern) {
+    SUNMatDestroy(cvls_mem->jac_pattern);
+    cvls_mem->jac_pattern = NULL;
+  }
+  if (cvls_mem->jac_colors) {
+    free(cvls_mem->jac_colors);
+    cvls_mem->jac_colors = NULL;
+  }
+  cvls_mem->jac_ncolors = 0;
+
+  /* a NULL input disables the sparse DQ Jacobian */
+  if (P == NULL) return(CVLS_SUCCESS);
+
+  /* the pattern must match the sparse or BSR system matrix */
+  if ((cvls_mem->A == NULL) ||
+      (SUNMatGetID(cvls_mem->A) != SUNMatGetID(P)) ||
+      ((SUNMatGetID(P) == SUNMATRIX_SPARSE) &&
+       ((SUNSparseMatrix_Rows(P) != SUNSparseMatrix_Rows(cvls_mem->A)) ||
+        (SUNSparseMatrix_Columns(P) != SUNSparseMatrix_Columns(cvls_mem->A)) ||
+        (SUNSparseMatrix_SparseType(P) != SUNSparseMatrix_SparseType(cvls_mem->A)))) ||
+      ((SUNMatGetID(P) == SUNMATRIX_BSR) &&
+       ((SUNBSRMatrix_BlockRows(P) != SUNBSRMatrix_BlockRows(cvls_mem->A)) ||
+        (SUNBSRMatrix_BlockColumns(P) != SUNBSRMatrix_BlockColumns(cvls_mem->A)) ||
+        (SUNBSRMatrix_BlockSize(P) != SUNBSRMatrix_BlockSize(cvls_mem->A)))) ||
+      ((SUNMatGetID(P) != SUNMATRIX_SPARSE) &&
+       (SUNMatGetID(P) != SUNMATRIX_BSR))) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVLS",
+                   "CVodeSetJacSparsityPattern",
+                   "Sparsity pattern is incompatible with the SUNMatrix");
+    return(CVLS_ILL_INPUT);
+  }
+
+  /* store a copy of the pattern */
+  cvls_mem->jac_pattern = SUNMatClone(P);
+  if (cvls_mem->jac_pattern == NULL) {
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVLS",
+                   "CVodeSetJacSparsityPattern", MSG_LS_MEM_FAIL);
+    return(CVLS_MEM_FAIL);
+  }
+
+  retval = SUNMatCopy(P, cvls_mem->jac_pattern);
+  if (retval != SUNMAT_SUCCESS) {
+    cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, "CVLS",
+                   "CVodeSetJacSparsityPattern", MSG_LS_SUNMAT_FAILED);
+    SUNMatDestroy(cvls_mem->jac_pattern);
+    cvls_mem->jac_pattern = NULL;
+    return(CVLS_SUNMAT_FAIL);
+  }
+
+  /* color the columns of the pattern */
+  if (SUNMatGetID(P) == SUNMATRIX_BSR)
+    N = SUNBSRMatrix_Columns(P);
+  else
+    N = SUNSparseMatrix_Columns(P);
+  cvls_mem->jac_colors = (sunindextype *) malloc(N*sizeof(sunindextype));
+  if (cvls_mem->jac_colors == NULL) {
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVLS",
+                   "CVodeSetJacSparsityPattern", MSG_LS_MEM_FAIL);
+    SUNMatDestroy(cvls_mem->jac_pattern);
+    cvls_mem->jac_pattern = NULL;
+    return(CVLS_MEM_FAIL);
+  }
+
+  if (SUNMatGetID(P) == SUNMATRIX_BSR)
+    retval = SUNBSRMatrix_ColorColumns(cvls_mem->jac_pattern,
+                                       cvls_mem->jac_colors,
+                                       &(cvls_mem->jac_ncolors));
+  else
+    retval = SUNSparseMatrix_ColorColumns(cvls_mem->jac_pattern,
+                                          cvls_mem->jac_colors,
+                                          &(cvls_mem->jac_ncolors));
+  if (retval != SUNMAT_SUCCESS) {
+    cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, "CVLS",
+                   "CVodeSetJacSparsityPattern", MSG_LS_SUNMAT_FAILED);
+    SUNMatDestroy(cvls_mem->jac_pattern);
+    cvls_mem->jac_pattern = NULL;
+    free(cvls_mem->jac_colors);
+    cvls_mem->jac_colors = NULL;
+    return(CVLS_SUNMAT_FAIL);
+  }
+
+  return(CVLS_SUCCESS);
+}
+
+
 /* CVodeSetDeltaGammaMaxBadJac specifies the maximum gamma ratio change
  * after a NLS convergence failure with a potentially bad Jacobian. If
  * |gamma/gammap-1| < dgmax_jbad then the Jacobian is marked as bad */
@@ -1140,6 +1243,10 @@ int cvLsDQJac(realtype t, N_Vector y, N_Vector fy,
     retval = cvLsDenseDQJac(t, y, fy, Jac, cv_mem, tmp1);
   } else if (SUNMatGetID(Jac) == SUNMATRIX_BAND) {
     retval = cvLsBandDQJac(t, y, fy, Jac, cv_mem, tmp1, tmp2);
+  } else if (((SUNMatGetID(Jac) == SUNMATRIX_SPARSE) ||
+               (SUNMatGetID(Jac) == SUNMATRIX_BSR)) &&
+             (((CVLsMem) cv_mem->cv_lmem)->jac_pattern != NULL)) {
+    retval = cvLsSparseDQJac(t, y, fy, Jac, cv_mem, tmp1, tmp2, tmp3);
   } else {
     cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVSLS", "cvLsDQJac",
                    "unrecognized matrix type for cvLsDQJac");
@@ -1341,6 +1448,151 @@ int cvLsBandDQJac(realtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
 }
 
 
+/*-----------------------------------------------------------------
+  cvLsSparseDQJac
+
+  This routine generates a sparse difference quotient approximation
+  to the Jacobian of f(t,y) using the user-supplied sparsity
+  pattern. The columns of the pattern are grouped by the coloring
+  computed in CVodeSetJacSparsityPattern so that columns of one
+  color do not share any rows. All y_j of a color are perturbed
+  together, requiring a single f evaluation per color, and the
+  difference quotients are scattered into the pattern entries
+  (CSC, CSR or BSR) of the matching columns.
+  -----------------------------------------------------------------*/
+int cvLsSparseDQJac(realtype t, N_Vector y, N_Vector fy,
+                    SUNMatrix Jac, CVodeMem cv_mem, N_Vector tmp1,
+                    N_Vector tmp2, N_Vector tmp3)
+{
+  N_Vector ftemp, ytemp, incvec;
+  realtype fnorm, minInc, inc, srur, conj;
+  realtype *ewt_data, *fy_data, *ftemp_data, *y_data, *ytemp_data;
+  realtype *inc_data, *cns_data, *J_data;
+  sunindextype *colors, *Jp, *Ji;
+  sunindextype color, i, j, p, N, NP, I, r, c, bs;
+  CVLsMem cvls_mem;
+  int retval = 0;
+
+  /* initialize cns_data to avoid compiler warning */
+  cns_data = NULL;
+
+  /* access LsMem interface structure */
+  cvls_mem = (CVLsMem) cv_mem->cv_lmem;
+
+  /* load the pattern into the Jacobian matrix */
+  retval = SUNMatCopy(cvls_mem->jac_pattern, Jac);
+  if (retval != SUNMAT_SUCCESS) return(-1);
+
+  /* access matrix dimensions and data, for a BSR matrix NP is the number
+     of block rows and Jp, Ji index the blocks */
+  bs = 1;
+  if (SUNMatGetID(Jac) == SUNMATRIX_BSR) {
+    N      = SUNBSRMatrix_Columns(Jac);
+    NP     = SUNBSRMatrix_BlockRows(Jac);
+    bs     = SUNBSRMatrix_BlockSize(Jac);
+    Jp     = SUNBSRMatrix_IndexPointers(Jac);
+    Ji     = SUNBSRMatrix_IndexValues(Jac);
+    J_data = SUNBSRMatrix_Data(Jac);
+  } else {
+    N      = SUNSparseMatrix_Columns(Jac);
+    NP     = SUNSparseMatrix_NP(Jac);
+    Jp     = SUNSparseMatrix_IndexPointers(Jac);
+    Ji     = SUNSparseMatrix_IndexValues(Jac);
+    J_data = SUNSparseMatrix_Data(Jac);
+  }
+  colors = cvls_mem->jac_colors;
+
+  /* Rename work vectors for use as temporary values of y and f and to
+     hold the increment for each column */
+  ftemp  = tmp1;
+  ytemp  = tmp2;
+  incvec = tmp3;
+
+  /* Obtain pointers to the data for ewt, fy, ftemp, y, ytemp, incvec */
+  ewt_data   = N_VGetArrayPointer(cv_mem->cv_ewt);
+  fy_data    = N_VGetArrayPointer(fy);
+  ftemp_data = N_VGetArrayPointer(ftemp);
+  y_data     = N_VGetArrayPointer(y);
+  ytemp_data = N_VGetArrayPointer(ytemp);
+  inc_data   = N_VGetArrayPointer(incvec);
+  if (cv_mem->cv_constraintsSet)
+    cns_data = N_VGetArrayPointer(cv_mem->cv_constraints);
+
+  /* Load ytemp with y = predicted y vector */
+  N_VScale(ONE, y, ytemp);
+
+  /* Set minimum increment based on uround and norm of f */
+  srur = SUNRsqrt(cv_mem->cv_uround);
+  fnorm = N_VWrmsNorm(fy, cv_mem->cv_ewt);
+  minInc = (fnorm != ZERO) ?
+    (MIN_INC_MULT * SUNRabs(cv_mem->cv_h) * cv_mem->cv_uround * N * fnorm) : ONE;
+
+  /* Compute the increment for each column */
+  for (j=0; j < N; j++) {
+    inc = SUNMAX(srur*SUNRabs(y_data[j]), minInc/ewt_data[j]);
+
+    /* Adjust sign(inc) if yj has an inequality constraint. */
+    if (cv_mem->cv_constraintsSet) {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)      {if ((y_data[j]+inc)*conj < ZERO)  inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if ((y_data[j]+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    inc_data[j] = inc;
+  }
+
+  /* Loop over column colors */
+  for (color=0; color < cvls_mem->jac_ncolors; color++) {
+
+    /* Increment all y_j of this color */
+    for (j=0; j < N; j++)
+      if (colors[j] == color) ytemp_data[j] += inc_data[j];
+
+    /* Evaluate f with incremented y */
+    retval = cv_mem->cv_f(t, ytemp, ftemp, cv_mem->cv_user_data);
+    cvls_mem->nfeDQ++;
+    if (retval != 0) break;
+
+    /* Restore ytemp, then form and load difference quotients */
+    for (j=0; j < N; j++)
+      if (colors[j] == color) ytemp_data[j] = y_data[j];
+
+    if (SUNMatGetID(Jac) == SUNMATRIX_BSR) {
+      for (I=0; I < NP; I++) {
+        for (p=Jp[I]; p < Jp[I+1]; p++) {
+          for (c=0; c < bs; c++) {
+            j = Ji[p]*bs + c;
+            if (colors[j] != color) continue;
+            for (r=0; r < bs; r++) {
+              i = I*bs + r;
+              J_data[(p*bs + c)*bs + r] = (ftemp_data[i] - fy_data[i]) / inc_data[j];
+            }
+          }
+        }
+      }
+    } else if (SUNSparseMatrix_SparseType(Jac) == CSC_MAT) {
+      for (j=0; j < NP; j++) {
+        if (colors[j] != color) continue;
+        for (p=Jp[j]; p < Jp[j+1]; p++) {
+          i = Ji[p];
+          J_data[p] = (ftemp_data[i] - fy_data[i]) / inc_data[j];
+        }
+      }
+    } else {
+      for (i=0; i < NP; i++) {
+        for (p=Jp[i]; p < Jp[i+1]; p++) {
+          j = Ji[p];
+          if (colors[j] == color)
+            J_data[p] = (ftemp_data[i] - fy_data[i]) / inc_data[j];
+        }
+      }
+    }
+  }
+
+  return(retval);
+}
+
+
 /*-----------------------------------------------------------------
   cvLsDQJtimes
 
@@ -1518,13 +1770,17 @@ int cvLsInitialize(CVodeMem cv_mem)
       /* Check if an internal or user-supplied Jacobian function is used */
       if (cvls_mem->jacDQ) {
 
-        /* Internal difference quotient Jacobian. Check that A is dense or band,
-           otherwise return an error */
+        /* Internal difference quotient Jacobian. Check that A is dense, band,
+           or sparse or BSR with a sparsity pattern, otherwise return an
+           error */
         retval = 0;
         if (cvls_mem->A->ops->getid) {
 
           if ( (SUNMatGetID(cvls_mem->A) == SUNMATRIX_DENSE) ||
-               (SUNMatGetID(cvls_mem->A) == SUNMATRIX_BAND) ) {
+               (SUNMatGetID(cvls_mem->A) == SUNMATRIX_BAND) ||
+               (((SUNMatGetID(cvls_mem->A) == SUNMATRIX_SPARSE) ||
+                 (SUNMatGetID(cvls_mem->A) == SUNMATRIX_BSR)) &&
+                (cvls_mem->jac_pattern != NULL)) ) {
             cvls_mem->jac    = cvLsDQJac;
             cvls_mem->J_data = cv_mem;
           } else {
@@ -1952,6 +2208,16 @@ int cvLsFree(CVodeMem cv_mem)
     cvls_mem->savedJ = NULL;
   }
 
+  /* Free sparse DQ Jacobian pattern and coloring */
+  if (cvls_mem->jac_pattern) {
+    SUNMatDestroy(cvls_mem->jac_pattern);
+    cvls_mem->jac_pattern = NULL;
+  }
+  if (cvls_mem->jac_colors) {
+    free(cvls_mem->jac_colors);
+    cvls_mem->jac_colors = NULL;
+  }
+
   /* Nullify other N_Vector pointers */
   cvls_mem->ycur = NULL;
   cvls_mem->fcur = NULL;
@@ -2168,6 +2434,26 @@ int CVodeSetJacFnBS(void *cvode_mem, int which, CVLsJacFnBS jacBS)
 }
 
 
+int CVodeSetJacSparsityPatternB(void *cvode_mem, int which, SUNMatrix PB)
+{
+  CVodeMem  cv_mem;
+  CVadjMem  ca_mem;
+  CVodeBMem cvB_mem;
+  CVLsMemB  cvlsB_mem;
+  void     *cvodeB_mem;
+  int       retval;
+
+  /* access relevant memory structures */
+  retval = cvLs_AccessLMemB(cvode_mem, which, "CVodeSetJacSparsityPatternB",
+                            &cv_mem, &ca_mem, &cvB_mem, &cvlsB_mem);
+  if (retval != CVLS_SUCCESS)  return(retval);
+
+  /* call corresponding routine for cvodeB_mem structure */
+  cvodeB_mem = (void *) (cvB_mem->cv_mem);
+  return(CVodeSetJacSparsityPattern(cvodeB_mem, PB));
+}
+
+
 int CVodeSetEpsLinB(void *cvode_mem, int which, realtype eplifacB)
 {
   CVodeMem  cv_mem;
@@ -65,6 +65,11 @@ typedef struct CVLsMemRec {
   realtype dgmax_jbad; /* if convfail = FAIL_BAD_J and the gamma ratio *
                         * |gamma/gammap-1| < dgmax_jbad then J is bad  */
 
+  /* Sparse difference quotient Jacobian */
+  SUNMatrix jac_pattern;    /* copy of the Jacobian sparsity pattern     */
+  sunindextype *jac_colors; /* column colors of the sparsity pattern     */
+  sunindextype jac_ncolors; /* number of column colors                   */
+
   /* Matrix-based solver, scale solution to account for change in gamma */
   booleantype scalesol;
 
@@ -158,6 +163,9 @@ int cvLsDenseDQJac(realtype t, N_Vector y, N_Vector fy,
 int cvLsBandDQJac(realtype t, N_Vector y, N_Vector fy,
                   SUNMatrix Jac, CVodeMem cv_mem, N_Vector tmp1,
                   N_Vector tmp2);
+int cvLsSparseDQJac(realtype t, N_Vector y, N_Vector fy,
+                    SUNMatrix Jac, CVodeMem cv_mem, N_Vector tmp1,
+                    N_Vector tmp2, N_Vector tmp3);
 
 /* Generic linit/lsetup/lsolve/lfree interface routines for CVode to call */
 int cvLsInitialize(CVodeMem cv_mem);
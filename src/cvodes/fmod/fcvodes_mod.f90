@@ -359,6 +359,7 @@ module fcvodes_mod
  integer(C_INT), parameter, public :: CVLS_LMEMB_NULL = -102_C_INT
  public :: FCVodeSetLinearSolver
  public :: FCVodeSetJacFn
+ public :: FCVodeSetJacSparsityPattern
  public :: FCVodeSetJacEvalFrequency
  public :: FCVodeSetLinearSolutionScaling
  public :: FCVodeSetDeltaGammaMaxBadJac
@@ -385,6 +386,7 @@ module fcvodes_mod
  public :: FCVodeSetLinearSolverB
  public :: FCVodeSetJacFnB
  public :: FCVodeSetJacFnBS
+ public :: FCVodeSetJacSparsityPatternB
  public :: FCVodeSetEpsLinB
  public :: FCVodeSetLSNormFactorB
  public :: FCVodeSetLinearSolutionScalingB
@@ -2442,6 +2444,15 @@ type(C_FUNPTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FCVodeSetJacSparsityPattern(farg1, farg2) &
+bind(C, name="_wrap_FCVodeSetJacSparsityPattern") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FCVodeSetJacEvalFrequency(farg1, farg2) &
 bind(C, name="_wrap_FCVodeSetJacEvalFrequency") &
 result(fresult)
@@ -2690,6 +2701,16 @@ type(C_FUNPTR), value :: farg3
 integer(C_INT) :: fresult
 end function
 
+function swigc_FCVodeSetJacSparsityPatternB(farg1, farg2, farg3) &
+bind(C, name="_wrap_FCVodeSetJacSparsityPatternB") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+type(C_PTR), value :: farg3
+integer(C_INT) :: fresult
+end function
+
 function swigc_FCVodeSetEpsLinB(farg1, farg2, farg3) &
 bind(C, name="_wrap_FCVodeSetEpsLinB") &
 result(fresult)
@@ -6567,6 +6588,22 @@ fresult = swigc_FCVodeSetJacFn(farg1, farg2)
 swig_result = fresult
 end function
 
+function FCVodeSetJacSparsityPattern(cvode_mem, p) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: cvode_mem
+type(SUNMatrix), target, intent(inout) :: p
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = cvode_mem
+farg2 = c_loc(p)
+fresult = swigc_FCVodeSetJacSparsityPattern(farg1, farg2)
+swig_result = fresult
+end function
+
 function FCVodeSetJacEvalFrequency(cvode_mem, msbj) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -7023,6 +7060,25 @@ fresult = swigc_FCVodeSetJacFnBS(farg1, farg2, farg3)
 swig_result = fresult
 end function
 
+function FCVodeSetJacSparsityPatternB(cvode_mem, which, pb) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: cvode_mem
+integer(C_INT), intent(in) :: which
+type(SUNMatrix), target, intent(inout) :: pb
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+type(C_PTR) :: farg3 
+
+farg1 = cvode_mem
+farg2 = which
+farg3 = c_loc(pb)
+fresult = swigc_FCVodeSetJacSparsityPatternB(farg1, farg2, farg3)
+swig_result = fresult
+end function
+
 function FCVodeSetEpsLinB(cvode_mem, which, eplifacb) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
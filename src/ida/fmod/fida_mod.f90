@@ -126,6 +126,7 @@ module fida_mod
  public :: FIDAGetNumResEvals
  public :: FIDAGetNumLinSolvSetups
  public :: FIDAGetNumErrTestFails
+ public :: FIDAGetNumReductions
  public :: FIDAGetNumBacktrackOps
  public :: FIDAGetConsistentIC
  public :: FIDAGetLastOrder
@@ -173,6 +174,7 @@ module fida_mod
  integer(C_INT), parameter, public :: IDALS_SUNLS_FAIL = -9_C_INT
  public :: FIDASetLinearSolver
  public :: FIDASetJacFn
+ public :: FIDASetJacSparsityPattern
  public :: FIDASetPreconditioner
  public :: FIDASetJacTimes
  public :: FIDASetEpsLin
@@ -682,6 +684,15 @@ type(C_PTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FIDAGetNumReductions(farg1, farg2) &
+bind(C, name="_wrap_FIDAGetNumReductions") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FIDAGetNumBacktrackOps(farg1, farg2) &
 bind(C, name="_wrap_FIDAGetNumBacktrackOps") &
 result(fresult)
@@ -1011,6 +1022,15 @@ type(C_FUNPTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FIDASetJacSparsityPattern(farg1, farg2) &
+bind(C, name="_wrap_FIDASetJacSparsityPattern") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FIDASetPreconditioner(farg1, farg2, farg3) &
 bind(C, name="_wrap_FIDASetPreconditioner") &
 result(fresult)
@@ -2091,6 +2111,22 @@ fresult = swigc_FIDAGetNumErrTestFails(farg1, farg2)
 swig_result = fresult
 end function
 
+function FIDAGetNumReductions(ida_mem, nreduce) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: ida_mem
+integer(C_LONG), dimension(*), target, intent(inout) :: nreduce
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = ida_mem
+farg2 = c_loc(nreduce(1))
+fresult = swigc_FIDAGetNumReductions(farg1, farg2)
+swig_result = fresult
+end function
+
 function FIDAGetNumBacktrackOps(ida_mem, nbacktr) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -2714,6 +2750,22 @@ fresult = swigc_FIDASetJacFn(farg1, farg2)
 swig_result = fresult
 end function
 
+function FIDASetJacSparsityPattern(ida_mem, p) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: ida_mem
+type(SUNMatrix), target, intent(inout) :: p
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = ida_mem
+farg2 = c_loc(p)
+fresult = swigc_FIDASetJacSparsityPattern(farg1, farg2)
+swig_result = fresult
+end function
+
 function FIDASetPreconditioner(ida_mem, pset, psolve) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
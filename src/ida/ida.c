@@ -52,6 +52,8 @@
  *       IDAPredict
  *   Error test
  *       IDATestError
+ *       IDAErrorNorms
+ *       IDAFusedErrorNorms
  *       IDARestore
  *   Handler for convergence and/or error test failures
  *       IDAHandleNFlag
@@ -62,6 +64,7 @@
  *       IDAGetSolution
  *   Norm functions
  *       IDAWrmsNorm
+ *       IDAWSqrSumLocal
  *   Functions for rootfinding
  *       IDARcheck1
  *       IDARcheck2
@@ -214,6 +217,9 @@ static int IDANls(IDAMem IDA_mem);
 
 static int IDATestError(IDAMem IDA_mem, realtype ck,
                         realtype *err_k, realtype *err_km1);
+static void IDAErrorNorms(IDAMem IDA_mem, realtype *enorm);
+static booleantype IDAFusedErrorNorms(IDAMem IDA_mem, realtype *enorm);
+static realtype IDAWSqrSumLocal(IDAMem IDA_mem, N_Vector x);
 
 /* Handling of convergence and/or error test failures */
 
@@ -492,6 +498,7 @@ int IDAInit(void *ida_mem, IDAResFn res,
   IDA_mem->ida_nre     = 0;
   IDA_mem->ida_ncfn    = 0;
   IDA_mem->ida_netf    = 0;
+  IDA_mem->ida_nreduce = 0;
   IDA_mem->ida_nni     = 0;
   IDA_mem->ida_nnf     = 0;
   IDA_mem->ida_nsetups = 0;
@@ -599,6 +606,7 @@ int IDAReInit(void *ida_mem,
   IDA_mem->ida_nre     = 0;
   IDA_mem->ida_ncfn    = 0;
   IDA_mem->ida_netf    = 0;
+  IDA_mem->ida_nreduce = 0;
   IDA_mem->ida_nni     = 0;
   IDA_mem->ida_nnf     = 0;
   IDA_mem->ida_nsetups = 0;
@@ -2599,10 +2607,16 @@ static int IDATestError(IDAMem IDA_mem, realtype ck,
 {
   realtype err_km2;                         /* estimated error at k-2 */
   realtype enorm_k, enorm_km1, enorm_km2;   /* error norms */
+  realtype enorm[3];
   realtype terr_k, terr_km1, terr_km2;      /* local truncation error norms */
 
+  /* Compute the error norms for orders k, k-1, and k-2 */
+  IDAErrorNorms(IDA_mem, enorm);
+  enorm_k   = enorm[0];
+  enorm_km1 = enorm[1];
+  enorm_km2 = enorm[2];
+
   /* Compute error for order k. */
-  enorm_k = IDAWrmsNorm(IDA_mem, IDA_mem->ida_ee, IDA_mem->ida_ewt, IDA_mem->ida_suppressalg);
   *err_k = IDA_mem->ida_sigma[IDA_mem->ida_kk] * enorm_k;
   terr_k = (IDA_mem->ida_kk + 1) * (*err_k);
 
@@ -2618,9 +2632,6 @@ static int IDATestError(IDAMem IDA_mem, realtype ck,
   if ( IDA_mem->ida_kk > 1 ) {
 
     /* Compute error at order k-1 */
-    N_VLinearSum(ONE, IDA_mem->ida_phi[IDA_mem->ida_kk], ONE, IDA_mem->ida_ee, IDA_mem->ida_delta);
-    enorm_km1 = IDAWrmsNorm(IDA_mem, IDA_mem->ida_delta,
-                            IDA_mem->ida_ewt, IDA_mem->ida_suppressalg);
     *err_km1 = IDA_mem->ida_sigma[IDA_mem->ida_kk - 1] * enorm_km1;
     terr_km1 = IDA_mem->ida_kk * (*err_km1);
 
@@ -2634,10 +2645,6 @@ static int IDATestError(IDAMem IDA_mem, realtype ck,
     if ( IDA_mem->ida_kk > 2 ) {
 
       /* Compute error at order k-2 */
-      N_VLinearSum(ONE, IDA_mem->ida_phi[IDA_mem->ida_kk - 1], ONE,
-                   IDA_mem->ida_delta, IDA_mem->ida_delta);
-      enorm_km2 = IDAWrmsNorm(IDA_mem, IDA_mem->ida_delta,
-                              IDA_mem->ida_ewt, IDA_mem->ida_suppressalg);
       err_km2 = IDA_mem->ida_sigma[IDA_mem->ida_kk - 2] * enorm_km2;
       terr_km2 = (IDA_mem->ida_kk - 1) * err_km2;
 
@@ -2677,6 +2684,115 @@ static int IDATestError(IDAMem IDA_mem, realtype ck,
   else                    return(IDA_SUCCESS);
 }
 
+/*
+ * IDAErrorNorms
+ *
+ * This routine computes the WRMS norms of the local error estimates for
+ * orders k, k-1 (if k > 1) and k-2 (if k > 2) and stores them in enorm.
+ * When the vector supports single buffer reductions, the norms are
+ * computed with one global reduction (see IDAFusedErrorNorms).
+ */
+
+static void IDAErrorNorms(IDAMem IDA_mem, realtype *enorm)
+{
+  IDA_mem->ida_kp1nrmcur = SUNFALSE;
+
+  enorm[1] = enorm[2] = ZERO;
+
+  if (IDAFusedErrorNorms(IDA_mem, enorm)) return;
+
+  enorm[0] = IDAWrmsNorm(IDA_mem, IDA_mem->ida_ee, IDA_mem->ida_ewt,
+                         IDA_mem->ida_suppressalg);
+  IDA_mem->ida_nreduce++;
+
+  if (IDA_mem->ida_kk > 1) {
+    N_VLinearSum(ONE, IDA_mem->ida_phi[IDA_mem->ida_kk], ONE, IDA_mem->ida_ee,
+                 IDA_mem->ida_delta);
+    enorm[1] = IDAWrmsNorm(IDA_mem, IDA_mem->ida_delta, IDA_mem->ida_ewt,
+                           IDA_mem->ida_suppressalg);
+    IDA_mem->ida_nreduce++;
+
+    if (IDA_mem->ida_kk > 2) {
+      N_VLinearSum(ONE, IDA_mem->ida_phi[IDA_mem->ida_kk - 1], ONE,
+                   IDA_mem->ida_delta, IDA_mem->ida_delta);
+      enorm[2] = IDAWrmsNorm(IDA_mem, IDA_mem->ida_delta, IDA_mem->ida_ewt,
+                             IDA_mem->ida_suppressalg);
+      IDA_mem->ida_nreduce++;
+    }
+  }
+}
+
+/*
+ * IDAFusedErrorNorms
+ *
+ * This routine computes the task-local parts of the error norms needed by
+ * IDATestError and combines them with a single call to
+ * N_VDotProdMultiAllReduce. If IDACompleteStep will need the error norm for
+ * order k+1 should the step succeed, its local part is included in the same
+ * reduction and the norm is saved in enorm_kp1. The routine returns SUNFALSE
+ * if the vector does not support the required operations or the reduction
+ * fails, in which case nothing has been computed.
+ */
+
+static booleantype IDAFusedErrorNorms(IDAMem IDA_mem, realtype *enorm)
+{
+  int i, nvec;
+  booleantype kp1;
+  realtype sums[4], len;
+  N_Vector ee = IDA_mem->ida_ee;
+
+  if ((ee->ops->nvdotprodmultiallreduce == NULL) ||
+      (ee->ops->nvgetlength == NULL))
+    return(SUNFALSE);
+  if (IDA_mem->ida_suppressalg) {
+    if (ee->ops->nvwsqrsummasklocal == NULL) return(SUNFALSE);
+  } else {
+    if (ee->ops->nvwsqrsumlocal == NULL) return(SUNFALSE);
+  }
+
+  /* the k+1 estimate is used in IDACompleteStep unless the order is lowered */
+  kp1 = (IDA_mem->ida_phase == 1) &&
+    (IDA_mem->ida_kk < IDA_mem->ida_maxord) &&
+    (IDA_mem->ida_kk + 1 < IDA_mem->ida_ns) &&
+    (IDA_mem->ida_kk - IDA_mem->ida_kused != 1);
+
+  nvec = 0;
+  sums[nvec++] = IDAWSqrSumLocal(IDA_mem, ee);
+
+  if (IDA_mem->ida_kk > 1) {
+    N_VLinearSum(ONE, IDA_mem->ida_phi[IDA_mem->ida_kk], ONE, ee,
+                 IDA_mem->ida_delta);
+    sums[nvec++] = IDAWSqrSumLocal(IDA_mem, IDA_mem->ida_delta);
+
+    if (IDA_mem->ida_kk > 2) {
+      N_VLinearSum(ONE, IDA_mem->ida_phi[IDA_mem->ida_kk - 1], ONE,
+                   IDA_mem->ida_delta, IDA_mem->ida_delta);
+      sums[nvec++] = IDAWSqrSumLocal(IDA_mem, IDA_mem->ida_delta);
+    }
+  }
+
+  if (kp1) {
+    N_VLinearSum(ONE, ee, -ONE, IDA_mem->ida_phi[IDA_mem->ida_kk + 1],
+                 IDA_mem->ida_tempv1);
+    sums[nvec++] = IDAWSqrSumLocal(IDA_mem, IDA_mem->ida_tempv1);
+  }
+
+  if (N_VDotProdMultiAllReduce(nvec, ee, sums) != 0) return(SUNFALSE);
+  IDA_mem->ida_nreduce++;
+
+  len = (realtype) N_VGetLength(ee);
+  for (i = 0; i < nvec; i++) sums[i] = SUNRsqrt(sums[i] / len);
+
+  for (i = 0; i < SUNMIN(IDA_mem->ida_kk, 3); i++) enorm[i] = sums[i];
+
+  if (kp1) {
+    IDA_mem->ida_enorm_kp1 = sums[nvec - 1];
+    IDA_mem->ida_kp1nrmcur = SUNTRUE;
+  }
+
+  return(SUNTRUE);
+}
+
 /*
  * IDARestore
  *
@@ -2961,10 +3077,15 @@ static void IDACompleteStep(IDAMem IDA_mem, realtype err_k, realtype err_km1)
     {
       /* Estimate the error at order k+1 */
 
-      N_VLinearSum(ONE, IDA_mem->ida_ee, -ONE,
-                   IDA_mem->ida_phi[IDA_mem->ida_kk + 1], IDA_mem->ida_tempv1);
-      enorm = IDAWrmsNorm(IDA_mem, IDA_mem->ida_tempv1, IDA_mem->ida_ewt,
-                          IDA_mem->ida_suppressalg);
+      if (IDA_mem->ida_kp1nrmcur) {
+        enorm = IDA_mem->ida_enorm_kp1;
+      } else {
+        N_VLinearSum(ONE, IDA_mem->ida_ee, -ONE,
+                     IDA_mem->ida_phi[IDA_mem->ida_kk + 1], IDA_mem->ida_tempv1);
+        enorm = IDAWrmsNorm(IDA_mem, IDA_mem->ida_tempv1, IDA_mem->ida_ewt,
+                            IDA_mem->ida_suppressalg);
+        IDA_mem->ida_nreduce++;
+      }
       err_kp1 = enorm / (IDA_mem->ida_kk + 2);
 
       /* Choose among orders k-1, k, k+1 using local truncation error norms. */
@@ -3192,6 +3313,21 @@ realtype IDAWrmsNorm(IDAMem IDA_mem, N_Vector x, N_Vector w,
   return(nrm);
 }
 
+/*
+ * IDAWSqrSumLocal
+ *
+ *  Returns the task-local weighted squared sum of x with the error weights,
+ *  masked by id if suppressalg = SUNTRUE, i.e., the local part of the norm
+ *  IDAWrmsNorm(IDA_mem, x, ewt, suppressalg).
+ */
+
+static realtype IDAWSqrSumLocal(IDAMem IDA_mem, N_Vector x)
+{
+  if (IDA_mem->ida_suppressalg)
+    return(N_VWSqrSumMaskLocal(x, IDA_mem->ida_ewt, IDA_mem->ida_id));
+  return(N_VWSqrSumLocal(x, IDA_mem->ida_ewt));
+}
+
 /*
  * -----------------------------------------------------------------
  * Functions for rootfinding
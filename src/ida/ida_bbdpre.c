@@ -16,7 +16,9 @@
  * This file contains implementations of routines for a
  * band-block-diagonal preconditioner, i.e. a block-diagonal
  * matrix with banded blocks, for use with IDA, the IDASPILS
- * linear solver interface.
+ * linear solver interface. The sparse variant keeps sparse local
+ * blocks computed by colored difference quotients, split in
+ * sub-blocks that are factored and solved independently.
  *
  * NOTE: With only one processor in use, a banded matrix results
  * rather than a block-diagonal matrix with banded blocks.
@@ -33,7 +35,6 @@
 #include <sundials/sundials_math.h>
 #include <nvector/nvector_serial.h>
 
-
 #define ZERO RCONST(0.0)
 #define ONE  RCONST(1.0)
 #define TWO  RCONST(2.0)
@@ -45,13 +46,24 @@ static int IDABBDPrecSolve(realtype tt, N_Vector yy, N_Vector yp,
                            N_Vector rr, N_Vector rvec, N_Vector zvec,
                            realtype c_j, realtype delta, void *prec_data);
 
-/* Prototype for IDABBDPrecFree */
+/* Prototypes of functions IDABBDSparsePrecSetup and IDABBDSparsePrecSolve */
+static int IDABBDSparsePrecSetup(realtype tt, N_Vector yy, N_Vector yp,
+                                 N_Vector rr, realtype c_j, void *prec_data);
+static int IDABBDSparsePrecSolve(realtype tt, N_Vector yy, N_Vector yp,
+                                 N_Vector rr, N_Vector rvec, N_Vector zvec,
+                                 realtype c_j, realtype delta, void *prec_data);
+
+/* Prototypes for IDABBDPrecFree and IDABBDPrecFreeData */
 static int IDABBDPrecFree(IDAMem ida_mem);
+static void IDABBDPrecFreeData(IBBDPrecData pdata);
 
 /* Prototype for difference quotient Jacobian calculation routine */
 static int IBBDDQJac(IBBDPrecData pdata, realtype tt, realtype cj,
                      N_Vector yy, N_Vector yp, N_Vector gref,
                      N_Vector ytemp, N_Vector yptemp, N_Vector gtemp);
+static int IBBDSparseDQJac(IBBDPrecData pdata, realtype tt, realtype cj,
+                           N_Vector yy, N_Vector yp, N_Vector gref,
+                           N_Vector ytemp, N_Vector yptemp, N_Vector gtemp);
 
 /*---------------------------------------------------------------
   User-Callable Functions: initialization, reinit and free
@@ -111,6 +123,17 @@ int IDABBDPrecInit(void *ida_mem, sunindextype Nlocal,
   pdata->mukeep = muk;
   pdata->mlkeep = mlk;
 
+  /* The local block is banded */
+  pdata->sparse = SUNFALSE;
+  pdata->nsub   = 0;
+  pdata->suboff = NULL;
+  pdata->colors = NULL;
+  pdata->dqinc  = NULL;
+  pdata->subP   = NULL;
+  pdata->subLS  = NULL;
+  pdata->zsub   = NULL;
+  pdata->rsub   = NULL;
+
   /* Set extended upper half-bandwidth for PP (required for pivoting). */
   storage_mu = SUNMIN(Nlocal-1, muk+mlk);
 
@@ -280,6 +303,210 @@ int IDABBDPrecInit(void *ida_mem, sunindextype Nlocal,
 }
 
 
+/*-------------------------------------------------------------*/
+int IDABBDPrecInitSparse(void *ida_mem, sunindextype Nlocal,
+                         SUNMatrix Jpattern, int nsub,
+                         IDABBDLinSolFn lsfn, realtype dq_rel_yy,
+                         IDABBDLocalFn Gres, IDABBDCommFn Gcomm)
+{
+  IDAMem IDA_mem;
+  IDALsMem idals_mem;
+  IBBDPrecData pdata;
+  sunindextype lrw1, liw1, ncolors;
+  long int lrw, liw;
+  int b, flag;
+
+  if (ida_mem == NULL) {
+    IDAProcessError(NULL, IDALS_MEM_NULL, "IDABBDPRE",
+                    "IDABBDPrecInitSparse", MSGBBD_MEM_NULL);
+    return(IDALS_MEM_NULL);
+  }
+  IDA_mem = (IDAMem) ida_mem;
+
+  /* Test if the LS linear solver interface has been created */
+  if (IDA_mem->ida_lmem == NULL) {
+    IDAProcessError(IDA_mem, IDALS_LMEM_NULL, "IDABBDPRE",
+                    "IDABBDPrecInitSparse", MSGBBD_LMEM_NULL);
+    return(IDALS_LMEM_NULL);
+  }
+  idals_mem = (IDALsMem) IDA_mem->ida_lmem;
+
+  /* Test compatibility of NVECTOR package with the BBD preconditioner */
+  if(IDA_mem->ida_tempv1->ops->nvgetarraypointer == NULL) {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, "IDABBDPRE",
+                    "IDABBDPrecInitSparse", MSGBBD_BAD_NVECTOR);
+    return(IDALS_ILL_INPUT);
+  }
+
+  /* Test the pattern of the local block */
+  if ( (Nlocal < 1) || (Jpattern == NULL) ||
+       (SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(Jpattern) != Nlocal) ||
+       (SUNSparseMatrix_Columns(Jpattern) != Nlocal) ) {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, "IDABBDPRE",
+                    "IDABBDPrecInitSparse", MSGBBD_BAD_MATRIX);
+    return(IDALS_ILL_INPUT);
+  }
+
+  /* By default the local block is not split */
+  if (nsub < 1) nsub = 1;
+  if (nsub > Nlocal) nsub = (int) Nlocal;
+
+  /* Allocate data memory. */
+  pdata = NULL;
+  pdata = (IBBDPrecData) malloc(sizeof *pdata);
+  if (pdata == NULL) {
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDABBDPRE",
+                    "IDABBDPrecInitSparse", MSGBBD_MEM_FAIL);
+    return(IDALS_MEM_FAIL);
+  }
+
+  /* Set pointers to glocal and gcomm, the banded data is not used. */
+  pdata->ida_mem = IDA_mem;
+  pdata->glocal = Gres;
+  pdata->gcomm = Gcomm;
+  pdata->mudq = pdata->mldq = pdata->mukeep = pdata->mlkeep = 0;
+  pdata->PP = NULL;
+  pdata->LS = NULL;
+  pdata->zlocal = NULL;
+  pdata->rlocal = NULL;
+  pdata->n_local = Nlocal;
+
+  /* Allocate the sub-block arrays */
+  pdata->sparse = SUNTRUE;
+  pdata->nsub   = nsub;
+  pdata->suboff = (sunindextype *) malloc((nsub+1)*sizeof(sunindextype));
+  pdata->colors = (sunindextype *) malloc(Nlocal*sizeof(sunindextype));
+  pdata->dqinc  = (realtype *) malloc(Nlocal*sizeof(realtype));
+  pdata->subP   = (SUNMatrix *) calloc(nsub, sizeof(SUNMatrix));
+  pdata->subLS  = (SUNLinearSolver *) calloc(nsub, sizeof(SUNLinearSolver));
+  pdata->zsub   = (N_Vector *) calloc(nsub, sizeof(N_Vector));
+  pdata->rsub   = (N_Vector *) calloc(nsub, sizeof(N_Vector));
+  pdata->tempv1 = N_VClone(IDA_mem->ida_tempv1);
+  pdata->tempv2 = N_VClone(IDA_mem->ida_tempv1);
+  pdata->tempv3 = N_VClone(IDA_mem->ida_tempv1);
+  pdata->tempv4 = N_VClone(IDA_mem->ida_tempv1);
+  if ( (pdata->suboff == NULL) || (pdata->colors == NULL) ||
+       (pdata->dqinc == NULL) || (pdata->subP == NULL) ||
+       (pdata->subLS == NULL) || (pdata->zsub == NULL) ||
+       (pdata->rsub == NULL) || (pdata->tempv1 == NULL) ||
+       (pdata->tempv2 == NULL) || (pdata->tempv3 == NULL) ||
+       (pdata->tempv4 == NULL) ) {
+    IDABBDPrecFreeData(pdata);
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDABBDPRE",
+                    "IDABBDPrecInitSparse", MSGBBD_MEM_FAIL);
+    return(IDALS_MEM_FAIL);
+  }
+
+  /* Split the local block in sub-blocks of contiguous rows, the entries
+     coupling different sub-blocks are dropped */
+  for (b=0; b<=nsub; b++)
+    pdata->suboff[b] = (b*Nlocal)/nsub;
+
+  flag = SUNSparseMatrix_DiagonalBlocks(Jpattern, nsub, pdata->suboff,
+                                        pdata->subP);
+  if (flag != SUNMAT_SUCCESS) {
+    IDABBDPrecFreeData(pdata);
+    IDAProcessError(IDA_mem, IDALS_SUNMAT_FAIL, "IDABBDPRE",
+                    "IDABBDPrecInitSparse", MSGBBD_SPMAT_FAIL);
+    return(IDALS_SUNMAT_FAIL);
+  }
+
+  /* Color the columns of each sub-block, the rows of different sub-blocks
+     are disjoint so they may share colors */
+  pdata->ncolors = 0;
+  for (b=0; b<nsub; b++) {
+    flag = SUNSparseMatrix_ColorColumns(pdata->subP[b],
+                                        pdata->colors + pdata->suboff[b],
+                                        &ncolors);
+    if (flag != SUNMAT_SUCCESS) {
+      IDABBDPrecFreeData(pdata);
+      IDAProcessError(IDA_mem, IDALS_SUNMAT_FAIL, "IDABBDPRE",
+                      "IDABBDPrecInitSparse", MSGBBD_SPMAT_FAIL);
+      return(IDALS_SUNMAT_FAIL);
+    }
+    pdata->ncolors = SUNMAX(pdata->ncolors, ncolors);
+  }
+
+  /* Create the local vectors and linear solver of each sub-block */
+  for (b=0; b<nsub; b++) {
+    pdata->zsub[b] = N_VNewEmpty_Serial(pdata->suboff[b+1] - pdata->suboff[b],
+                                        IDA_mem->ida_sunctx);
+    pdata->rsub[b] = N_VNewEmpty_Serial(pdata->suboff[b+1] - pdata->suboff[b],
+                                        IDA_mem->ida_sunctx);
+    if ( (pdata->zsub[b] == NULL) || (pdata->rsub[b] == NULL) ) {
+      IDABBDPrecFreeData(pdata);
+      IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDABBDPRE",
+                      "IDABBDPrecInitSparse", MSGBBD_MEM_FAIL);
+      return(IDALS_MEM_FAIL);
+    }
+
+    if (lsfn != NULL)
+      pdata->subLS[b] = lsfn(pdata->rsub[b], pdata->subP[b],
+                             IDA_mem->ida_sunctx);
+    else
+      pdata->subLS[b] = SUNLinSol_ILU(pdata->rsub[b], pdata->subP[b], 0,
+                                      IDA_mem->ida_sunctx);
+    if (pdata->subLS[b] == NULL) {
+      IDABBDPrecFreeData(pdata);
+      IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDABBDPRE",
+                      "IDABBDPrecInitSparse", MSGBBD_MEM_FAIL);
+      return(IDALS_MEM_FAIL);
+    }
+    flag = SUNLinSolInitialize(pdata->subLS[b]);
+    if (flag != SUNLS_SUCCESS) {
+      IDABBDPrecFreeData(pdata);
+      IDAProcessError(IDA_mem, IDALS_SUNLS_FAIL, "IDABBDPRE",
+                      "IDABBDPrecInitSparse", MSGBBD_SPLS_FAIL);
+      return(IDALS_SUNLS_FAIL);
+    }
+  }
+
+  /* Set rel_yy based on input value dq_rel_yy (0 implies default). */
+  pdata->rel_yy = (dq_rel_yy > ZERO) ?
+    dq_rel_yy : SUNRsqrt(IDA_mem->ida_uround);
+
+  /* Set work space sizes and initialize nge. */
+  pdata->rpwsize = Nlocal;
+  pdata->ipwsize = Nlocal + nsub + 1;
+  if (IDA_mem->ida_tempv1->ops->nvspace) {
+    N_VSpace(IDA_mem->ida_tempv1, &lrw1, &liw1);
+    pdata->rpwsize += 4*lrw1;
+    pdata->ipwsize += 4*liw1;
+  }
+  for (b=0; b<nsub; b++) {
+    if (pdata->subP[b]->ops->space) {
+      flag = SUNMatSpace(pdata->subP[b], &lrw, &liw);
+      pdata->rpwsize += lrw;
+      pdata->ipwsize += liw;
+    }
+    if (pdata->subLS[b]->ops->space) {
+      flag = SUNLinSolSpace(pdata->subLS[b], &lrw, &liw);
+      pdata->rpwsize += lrw;
+      pdata->ipwsize += liw;
+    }
+  }
+  pdata->nge = 0;
+
+  /* make sure pdata is free from any previous allocations */
+  if (idals_mem->pfree)
+    idals_mem->pfree(IDA_mem);
+
+  /* Point to the new pdata field in the LS memory */
+  idals_mem->pdata = pdata;
+
+  /* Attach the pfree function */
+  idals_mem->pfree = IDABBDPrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = IDASetPreconditioner(ida_mem,
+                              IDABBDSparsePrecSetup,
+                              IDABBDSparsePrecSolve);
+
+  return(flag);
+}
+
+
 /*-------------------------------------------------------------*/
 int IDABBDPrecReInit(void *ida_mem, sunindextype mudq,
                      sunindextype mldq, realtype dq_rel_yy)
@@ -312,7 +539,7 @@ int IDABBDPrecReInit(void *ida_mem, sunindextype mudq,
   }
   pdata = (IBBDPrecData) idals_mem->pdata;
 
-  /* Load half-bandwidths. */
+  /* Load half-bandwidths (not used with a sparse local block). */
   Nlocal = pdata->n_local;
   pdata->mudq = SUNMIN(Nlocal-1, SUNMAX(0, mudq));
   pdata->mldq = SUNMIN(Nlocal-1, SUNMAX(0, mldq));
@@ -520,6 +747,38 @@ static int IDABBDPrecFree(IDAMem IDA_mem)
   if (idals_mem->pdata == NULL) return(0);
   pdata = (IBBDPrecData) idals_mem->pdata;
 
+  IDABBDPrecFreeData(pdata);
+  pdata = NULL;
+
+  return(0);
+}
+
+
+/*---------------------------------------------------------------
+  IDABBDPrecFreeData
+
+  Frees the preconditioner data of either kind of local block.
+  ---------------------------------------------------------------*/
+static void IDABBDPrecFreeData(IBBDPrecData pdata)
+{
+  int b;
+
+  if (pdata->sparse) {
+    for (b=0; b<pdata->nsub; b++) {
+      if (pdata->subLS) SUNLinSolFree(pdata->subLS[b]);
+      if (pdata->subP)  SUNMatDestroy(pdata->subP[b]);
+      if (pdata->zsub)  N_VDestroy(pdata->zsub[b]);
+      if (pdata->rsub)  N_VDestroy(pdata->rsub[b]);
+    }
+    free(pdata->suboff);
+    free(pdata->colors);
+    free(pdata->dqinc);
+    free(pdata->subLS);
+    free(pdata->subP);
+    free(pdata->zsub);
+    free(pdata->rsub);
+  }
+
   SUNLinSolFree(pdata->LS);
   N_VDestroy(pdata->rlocal);
   N_VDestroy(pdata->zlocal);
@@ -530,9 +789,97 @@ static int IDABBDPrecFree(IDAMem IDA_mem)
   SUNMatDestroy(pdata->PP);
 
   free(pdata);
-  pdata = NULL;
+}
 
-  return(0);
+
+/*---------------------------------------------------------------
+  IDABBDSparsePrecSetup:
+
+  IDABBDSparsePrecSetup is the setup routine of the preconditioner
+  created by IDABBDPrecInitSparse. It computes the sub-blocks of
+  the local block of dG/dy + c_j dG/dy' by colored difference
+  quotients and factors each of them with its linear solver.
+
+  The parameters and return values are the same as for
+  IDABBDPrecSetup.
+ ----------------------------------------------------------------*/
+static int IDABBDSparsePrecSetup(realtype tt, N_Vector yy, N_Vector yp,
+                                 N_Vector rr, realtype c_j, void *bbd_data)
+{
+  IBBDPrecData pdata;
+  IDAMem IDA_mem;
+  int b, retval, lsneg, lspos;
+
+  pdata =(IBBDPrecData) bbd_data;
+
+  IDA_mem = (IDAMem) pdata->ida_mem;
+
+  /* Call IBBDSparseDQJac for a new Jacobian calculation in subP. */
+  retval = IBBDSparseDQJac(pdata, tt, c_j, yy, yp, pdata->tempv1,
+                           pdata->tempv2, pdata->tempv3, pdata->tempv4);
+  if (retval < 0) {
+    IDAProcessError(IDA_mem, -1, "IDABBDPRE", "IDABBDSparsePrecSetup",
+                    MSGBBD_FUNC_FAILED);
+    return(-1);
+  }
+  if (retval > 0) {
+    return(1);
+  }
+
+  /* Factor each sub-block */
+  lsneg = 0;
+  lspos = 0;
+  for (b=0; b<pdata->nsub; b++) {
+    retval = SUNLinSolSetup(pdata->subLS[b], pdata->subP[b]);
+    if (retval < 0) lsneg = SUNMIN(lsneg, retval);
+    if (retval > 0) lspos = SUNMAX(lspos, retval);
+  }
+
+  /* Return an unrecoverable failure first, then a recoverable one */
+  return((lsneg < 0) ? lsneg : lspos);
+}
+
+
+/*---------------------------------------------------------------
+  IDABBDSparsePrecSolve
+
+  The function IDABBDSparsePrecSolve computes a solution to the
+  linear system P z = r, where P is the block-diagonal
+  preconditioner generated by IDABBDSparsePrecSetup. The local
+  parts of rvec and zvec are attached to the sub-block vectors and
+  the sub-block systems are solved one after the other.
+  ---------------------------------------------------------------*/
+static int IDABBDSparsePrecSolve(realtype tt, N_Vector yy, N_Vector yp,
+                                 N_Vector rr, N_Vector rvec, N_Vector zvec,
+                                 realtype c_j, realtype delta, void *bbd_data)
+{
+  IBBDPrecData pdata;
+  realtype *rdata, *zdata;
+  int b, retval, lsneg, lspos;
+
+  pdata = (IBBDPrecData) bbd_data;
+
+  rdata = N_VGetArrayPointer(rvec);
+  zdata = N_VGetArrayPointer(zvec);
+
+  lsneg = 0;
+  lspos = 0;
+  for (b=0; b<pdata->nsub; b++) {
+    /* Attach the sub-block data of rvec and zvec to rsub and zsub */
+    N_VSetArrayPointer(rdata + pdata->suboff[b], pdata->rsub[b]);
+    N_VSetArrayPointer(zdata + pdata->suboff[b], pdata->zsub[b]);
+
+    retval = SUNLinSolSolve(pdata->subLS[b], pdata->subP[b],
+                            pdata->zsub[b], pdata->rsub[b], ZERO);
+    if (retval < 0) lsneg = SUNMIN(lsneg, retval);
+    if (retval > 0) lspos = SUNMAX(lspos, retval);
+
+    /* Detach the sub-block data */
+    N_VSetArrayPointer(NULL, pdata->rsub[b]);
+    N_VSetArrayPointer(NULL, pdata->zsub[b]);
+  }
+
+  return((lsneg < 0) ? lsneg : lspos);
 }
 
 
@@ -663,3 +1010,137 @@ static int IBBDDQJac(IBBDPrecData pdata, realtype tt, realtype cj,
 
   return(0);
 }
+
+
+/*---------------------------------------------------------------
+  IBBDSparseDQJac
+
+  This routine generates a sparse difference quotient approximation
+  to the sub-blocks of the local block of dG/dy + cj*dG/dy'. The
+  columns of the sub-blocks are colored so that columns of one color
+  do not share any rows, and all y_j and y'_j of a color are
+  perturbed together. The number of calls to glocal is therefore the
+  number of colors plus one, independently of the bandwidth of the
+  block.
+
+  Return values are: 0 (success), > 0 (recoverable error),
+  or < 0 (nonrecoverable error).
+  ----------------------------------------------------------------*/
+static int IBBDSparseDQJac(IBBDPrecData pdata, realtype tt, realtype cj,
+                           N_Vector yy, N_Vector yp, N_Vector gref,
+                           N_Vector ytemp, N_Vector yptemp, N_Vector gtemp)
+{
+  IDAMem IDA_mem;
+  realtype inc;
+  int retval;
+  sunindextype color, b, i, j, p, s, nb;
+  sunindextype *colors, *Pp, *Pi;
+  realtype *ydata, *ypdata, *ytempdata, *yptempdata, *grefdata, *gtempdata;
+  realtype *cnsdata = NULL, *ewtdata, *incdata, *Pdata;
+  realtype conj, yj, ypj, ewtj;
+
+  IDA_mem = (IDAMem) pdata->ida_mem;
+
+  /* Initialize ytemp and yptemp. */
+  N_VScale(ONE, yy, ytemp);
+  N_VScale(ONE, yp, yptemp);
+
+  /* Obtain pointers as required to the data array of vectors. */
+  ydata     = N_VGetArrayPointer(yy);
+  ypdata    = N_VGetArrayPointer(yp);
+  gtempdata = N_VGetArrayPointer(gtemp);
+  ewtdata   = N_VGetArrayPointer(IDA_mem->ida_ewt);
+  if (IDA_mem->ida_constraintsSet)
+    cnsdata = N_VGetArrayPointer(IDA_mem->ida_constraints);
+  ytempdata = N_VGetArrayPointer(ytemp);
+  yptempdata= N_VGetArrayPointer(yptemp);
+  grefdata = N_VGetArrayPointer(gref);
+  colors  = pdata->colors;
+  incdata = pdata->dqinc;
+
+  /* Call gcomm and glocal to get base value of G(t,y,y'). */
+  if (pdata->gcomm != NULL) {
+    retval = pdata->gcomm(pdata->n_local, tt, yy, yp, IDA_mem->ida_user_data);
+    if (retval != 0) return(retval);
+  }
+
+  retval = pdata->glocal(pdata->n_local, tt, yy, yp, gref, IDA_mem->ida_user_data);
+  pdata->nge++;
+  if (retval != 0) return(retval);
+
+  /* Compute the increment of each component. */
+  for(j = 0; j < pdata->n_local; j++) {
+    yj = ydata[j];
+    ypj = ypdata[j];
+    ewtj = ewtdata[j];
+
+    /* Set increment inc to yj based on rel_yy*abs(yj), with
+       adjustments using ypj and ewtj if this is small, and a further
+       adjustment to give it the same sign as hh*ypj. */
+    inc = pdata->rel_yy *
+      SUNMAX(SUNRabs(yj), SUNMAX( SUNRabs(IDA_mem->ida_hh*ypj), ONE/ewtj));
+    if (IDA_mem->ida_hh*ypj < ZERO)  inc = -inc;
+    inc = (yj + inc) - yj;
+
+    /* Adjust sign(inc) again if yj has an inequality constraint. */
+    if (IDA_mem->ida_constraintsSet) {
+      conj = cnsdata[j];
+      if (SUNRabs(conj) == ONE)      {if ((yj+inc)*conj <  ZERO) inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if ((yj+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    incdata[j] = inc;
+  }
+
+  /* Loop over column colors. */
+  for(color = 0; color < pdata->ncolors; color++) {
+
+    /* Increment yj and ypj of the components of this color. */
+    for(j = 0; j < pdata->n_local; j++) {
+      if (colors[j] != color) continue;
+      ytempdata[j] += incdata[j];
+      yptempdata[j] += cj*incdata[j];
+    }
+
+    /* Evaluate G with incremented y and yp arguments. */
+    retval = pdata->glocal(pdata->n_local, tt, ytemp, yptemp,
+                           gtemp, IDA_mem->ida_user_data);
+    pdata->nge++;
+    if (retval != 0) return(retval);
+
+    /* Restore ytemp and yptemp. */
+    for(j = 0; j < pdata->n_local; j++) {
+      if (colors[j] != color) continue;
+      ytempdata[j] = ydata[j];
+      yptempdata[j] = ypdata[j];
+    }
+
+    /* Form difference quotients and load into the sub-blocks. */
+    for(b = 0; b < pdata->nsub; b++) {
+      s     = pdata->suboff[b];
+      nb    = pdata->suboff[b+1] - s;
+      Pp    = SUNSparseMatrix_IndexPointers(pdata->subP[b]);
+      Pi    = SUNSparseMatrix_IndexValues(pdata->subP[b]);
+      Pdata = SUNSparseMatrix_Data(pdata->subP[b]);
+      if (SUNSparseMatrix_SparseType(pdata->subP[b]) == CSC_MAT) {
+        for(j = 0; j < nb; j++) {
+          if (colors[s+j] != color) continue;
+          for(p = Pp[j]; p < Pp[j+1]; p++) {
+            i = s + Pi[p];
+            Pdata[p] = (gtempdata[i] - grefdata[i]) / incdata[s+j];
+          }
+        }
+      } else {
+        for(i = 0; i < nb; i++) {
+          for(p = Pp[i]; p < Pp[i+1]; p++) {
+            j = s + Pi[p];
+            if (colors[j] == color)
+              Pdata[p] = (gtempdata[s+i] - grefdata[s+i]) / incdata[j];
+          }
+        }
+      }
+    }
+  }
+
+  return(0);
+}
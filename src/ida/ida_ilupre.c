@@ -0,0 +1,429 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file contains implementations of the incomplete LU
+ * preconditioner and solver routines for use with the IDALS linear
+ * solver interface. The preconditioner is an ILU(k) factorization
+ * of the iteration matrix dF/dy + c_j dF/dy' computed by a
+ * user-supplied sparse Jacobian function.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ida_impl.h"
+#include "ida_ls_impl.h"
+#include "ida_ilupre_impl.h"
+#include <sundials/sundials_math.h>
+
+
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+
+/* Prototypes of functions IDAILUPrecSetup and IDAILUPrecSolve */
+static int IDAILUPrecSetup(realtype tt, N_Vector yy, N_Vector yp,
+                           N_Vector rr, realtype c_j, void *prec_data);
+static int IDAILUPrecSolve(realtype tt, N_Vector yy, N_Vector yp,
+                           N_Vector rr, N_Vector rvec, N_Vector zvec,
+                           realtype c_j, realtype delta, void *prec_data);
+
+/* Prototype for IDAILUPrecFree */
+static int IDAILUPrecFree(IDAMem ida_mem);
+
+/* Prototype for the shared access routine */
+static int IDAILUPrecAccess(void *ida_mem, const char *fname,
+                            IDAMem *IDA_mem, IILUPrecData *pdata);
+
+/*---------------------------------------------------------------
+  User-Callable Functions: initialization and optional output
+  ---------------------------------------------------------------*/
+int IDAILUPrecInit(void *ida_mem, SUNMatrix J, IDALsJacFn jac,
+                   int fill_level)
+{
+  IDAMem IDA_mem;
+  IDALsMem idals_mem;
+  IILUPrecData pdata;
+  int flag;
+
+  if (ida_mem == NULL) {
+    IDAProcessError(NULL, IDALS_MEM_NULL, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_MEM_NULL);
+    return(IDALS_MEM_NULL);
+  }
+  IDA_mem = (IDAMem) ida_mem;
+
+  /* Test if the LS linear solver interface has been created */
+  if (IDA_mem->ida_lmem == NULL) {
+    IDAProcessError(IDA_mem, IDALS_LMEM_NULL, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_LMEM_NULL);
+    return(IDALS_LMEM_NULL);
+  }
+  idals_mem = (IDALsMem) IDA_mem->ida_lmem;
+
+  /* Test compatibility of NVECTOR package with the ILU preconditioner */
+  if(IDA_mem->ida_tempv1->ops->nvgetarraypointer == NULL) {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_BAD_NVECTOR);
+    return(IDALS_ILL_INPUT);
+  }
+
+  /* Test the Jacobian template, function and fill level */
+  if ( (J == NULL) || (SUNMatGetID(J) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(J) != SUNSparseMatrix_Columns(J)) ||
+       (SUNSparseMatrix_Rows(J) != N_VGetLength(IDA_mem->ida_tempv1)) ) {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_BAD_MATRIX);
+    return(IDALS_ILL_INPUT);
+  }
+  if (jac == NULL) {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_JAC_NULL);
+    return(IDALS_ILL_INPUT);
+  }
+  if (fill_level < 0) {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_BAD_FILL);
+    return(IDALS_ILL_INPUT);
+  }
+
+  /* Allocate data memory. */
+  pdata = NULL;
+  pdata = (IILUPrecData) malloc(sizeof *pdata);
+  if (pdata == NULL) {
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_MEM_FAIL);
+    return(IDALS_MEM_FAIL);
+  }
+
+  /* Set pointers to jac and ida_mem; initialize counters. */
+  pdata->ida_mem = IDA_mem;
+  pdata->jac     = jac;
+  pdata->nje     = 0;
+  pdata->nfact   = 0;
+
+  /* Allocate memory for the preconditioner matrix with the pattern of the
+     template. */
+  pdata->PP = NULL;
+  pdata->PP = SUNMatClone(J);
+  if (pdata->PP == NULL) {
+    free(pdata); pdata = NULL;
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_MEM_FAIL);
+    return(IDALS_MEM_FAIL);
+  }
+
+  /* Allocate memory for temporary N_Vectors */
+  pdata->tempv1 = NULL;
+  pdata->tempv1 = N_VClone(IDA_mem->ida_tempv1);
+  pdata->tempv2 = NULL;
+  pdata->tempv2 = N_VClone(IDA_mem->ida_tempv1);
+  pdata->tempv3 = NULL;
+  pdata->tempv3 = N_VClone(IDA_mem->ida_tempv1);
+  if ((pdata->tempv1 == NULL) || (pdata->tempv2 == NULL) ||
+      (pdata->tempv3 == NULL)) {
+    if (pdata->tempv1) N_VDestroy(pdata->tempv1);
+    if (pdata->tempv2) N_VDestroy(pdata->tempv2);
+    if (pdata->tempv3) N_VDestroy(pdata->tempv3);
+    SUNMatDestroy(pdata->PP);
+    free(pdata); pdata = NULL;
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_MEM_FAIL);
+    return(IDALS_MEM_FAIL);
+  }
+
+  /* Allocate memory for the ILU linear solver */
+  pdata->LS = NULL;
+  pdata->LS = SUNLinSol_ILU(IDA_mem->ida_tempv1, pdata->PP, fill_level,
+                            IDA_mem->ida_sunctx);
+  if (pdata->LS == NULL) {
+    N_VDestroy(pdata->tempv1);
+    N_VDestroy(pdata->tempv2);
+    N_VDestroy(pdata->tempv3);
+    SUNMatDestroy(pdata->PP);
+    free(pdata); pdata = NULL;
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_MEM_FAIL);
+    return(IDALS_MEM_FAIL);
+  }
+
+  /* initialize ILU linear solver object */
+  flag = SUNLinSolInitialize(pdata->LS);
+  if (flag != SUNLS_SUCCESS) {
+    N_VDestroy(pdata->tempv1);
+    N_VDestroy(pdata->tempv2);
+    N_VDestroy(pdata->tempv3);
+    SUNMatDestroy(pdata->PP);
+    SUNLinSolFree(pdata->LS);
+    free(pdata); pdata = NULL;
+    IDAProcessError(IDA_mem, IDALS_SUNLS_FAIL, "IDAILUPRE",
+                    "IDAILUPrecInit", MSGILU_SUNLS_FAIL);
+    return(IDALS_SUNLS_FAIL);
+  }
+
+  /* make sure pdata is free from any previous allocations */
+  if (idals_mem->pfree)
+    idals_mem->pfree(IDA_mem);
+
+  /* Point to the new pdata field in the LS memory */
+  idals_mem->pdata = pdata;
+
+  /* Attach the pfree function */
+  idals_mem->pfree = IDAILUPrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = IDASetPreconditioner(ida_mem,
+                              IDAILUPrecSetup,
+                              IDAILUPrecSolve);
+
+  return(flag);
+}
+
+
+int IDAILUPrecGetWorkSpace(void *ida_mem,
+                           long int *lenrwILU,
+                           long int *leniwILU)
+{
+  IDAMem IDA_mem;
+  IILUPrecData pdata;
+  sunindextype lrw1, liw1;
+  long int lrw, liw;
+  int flag;
+
+  flag = IDAILUPrecAccess(ida_mem, "IDAILUPrecGetWorkSpace",
+                          &IDA_mem, &pdata);
+  if (flag != IDALS_SUCCESS) return(flag);
+
+  /* sum space requirements for all objects in pdata */
+  *leniwILU = 4;
+  *lenrwILU = 0;
+  if (IDA_mem->ida_tempv1->ops->nvspace) {
+    N_VSpace(IDA_mem->ida_tempv1, &lrw1, &liw1);
+    *leniwILU += 3*liw1;
+    *lenrwILU += 3*lrw1;
+  }
+  if (pdata->PP->ops->space) {
+    flag = SUNMatSpace(pdata->PP, &lrw, &liw);
+    if (flag != 0) return(-1);
+    *leniwILU += liw;
+    *lenrwILU += lrw;
+  }
+  if (pdata->LS->ops->space) {
+    flag = SUNLinSolSpace(pdata->LS, &lrw, &liw);
+    if (flag != 0) return(-1);
+    *leniwILU += liw;
+    *lenrwILU += lrw;
+  }
+
+  return(IDALS_SUCCESS);
+}
+
+
+int IDAILUPrecGetNumJacEvals(void *ida_mem, long int *njevalsILU)
+{
+  IDAMem IDA_mem;
+  IILUPrecData pdata;
+  int flag;
+
+  flag = IDAILUPrecAccess(ida_mem, "IDAILUPrecGetNumJacEvals",
+                          &IDA_mem, &pdata);
+  if (flag != IDALS_SUCCESS) return(flag);
+
+  *njevalsILU = pdata->nje;
+
+  return(IDALS_SUCCESS);
+}
+
+
+int IDAILUPrecGetNumFactorizations(void *ida_mem, long int *nfactILU)
+{
+  IDAMem IDA_mem;
+  IILUPrecData pdata;
+  int flag;
+
+  flag = IDAILUPrecAccess(ida_mem, "IDAILUPrecGetNumFactorizations",
+                          &IDA_mem, &pdata);
+  if (flag != IDALS_SUCCESS) return(flag);
+
+  *nfactILU = pdata->nfact;
+
+  return(IDALS_SUCCESS);
+}
+
+
+/*---------------------------------------------------------------
+  IDAILUPrecSetup:
+
+  IDAILUPrecSetup generates an incomplete LU factorization of the
+  iteration matrix P = dF/dy + c_j*dF/dy' computed by the
+  user-supplied Jacobian function. The symbolic factorization is
+  only recomputed when the pattern of P changes.
+
+  The parameters of IDAILUPrecSetup are as follows:
+
+  tt  is the current value of the independent variable t.
+
+  yy  is the current value of the dependent variable vector,
+      namely the predicted value of y(t).
+
+  yp  is the current value of the derivative vector y',
+      namely the predicted value of y'(t).
+
+  c_j is the scalar in the system Jacobian, proportional to 1/hh.
+
+  prec_data is the pointer to ILU preconditioner data
+      set by IDAILUPrecInit.
+
+  Return value:
+  The value returned by this IDAILUPrecSetup function is a int
+  flag indicating whether it was successful. This value is
+     0    if successful,
+   > 0    for a recoverable error (step will be retried), or
+   < 0    for a nonrecoverable error (step fails).
+ ----------------------------------------------------------------*/
+static int IDAILUPrecSetup(realtype tt, N_Vector yy, N_Vector yp,
+                           N_Vector rr, realtype c_j, void *prec_data)
+{
+  IILUPrecData pdata;
+  IDAMem IDA_mem;
+  int retval;
+
+  pdata = (IILUPrecData) prec_data;
+
+  IDA_mem = (IDAMem) pdata->ida_mem;
+
+  /* Call the Jacobian function to load PP. */
+  retval = SUNMatZero(pdata->PP);
+  if (retval != 0) {
+    IDAProcessError(IDA_mem, -1, "IDAILUPRE",
+                    "IDAILUPrecSetup", MSGILU_SUNMAT_FAIL);
+    return(-1);
+  }
+
+  retval = pdata->jac(tt, c_j, yy, yp, rr, pdata->PP,
+                      IDA_mem->ida_user_data, pdata->tempv1,
+                      pdata->tempv2, pdata->tempv3);
+  pdata->nje++;
+  if (retval < 0) {
+    IDAProcessError(IDA_mem, -1, "IDAILUPRE", "IDAILUPrecSetup",
+                    MSGILU_FUNC_FAILED);
+    return(-1);
+  }
+  if (retval > 0) {
+    return(+1);
+  }
+
+  /* Do the ILU factorization of PP. */
+  retval = SUNLinSolSetup(pdata->LS, pdata->PP);
+  pdata->nfact++;
+
+  /* Return 0 if the LU was complete, or +1 otherwise. */
+  if (retval == SUNLS_SUCCESS) return(0);
+  return((retval == SUNLS_LUFACT_FAIL) ? 1 : -1);
+}
+
+
+/*---------------------------------------------------------------
+  IDAILUPrecSolve
+
+  The function IDAILUPrecSolve computes a solution to the linear
+  system P z = r, with the incomplete LU factors computed by
+  IDAILUPrecSetup.
+
+  The parameters of IDAILUPrecSolve used here are as follows:
+
+  rvec is the input right-hand side vector r.
+
+  zvec is the computed solution vector z.
+
+  prec_data is the pointer to ILU preconditioner data set by
+      IDAILUPrecInit.
+
+  The arguments tt, yy, yp, rr, c_j and delta are NOT used.
+
+  IDAILUPrecSolve returns the value returned from the linear
+  solver object.
+  ---------------------------------------------------------------*/
+static int IDAILUPrecSolve(realtype tt, N_Vector yy, N_Vector yp,
+                           N_Vector rr, N_Vector rvec, N_Vector zvec,
+                           realtype c_j, realtype delta, void *prec_data)
+{
+  IILUPrecData pdata;
+  int retval;
+
+  pdata = (IILUPrecData) prec_data;
+
+  /* Call ILU solver object to do the work */
+  retval = SUNLinSolSolve(pdata->LS, pdata->PP, zvec, rvec, ZERO);
+  return(retval);
+}
+
+
+/*-------------------------------------------------------------*/
+static int IDAILUPrecFree(IDAMem IDA_mem)
+{
+  IDALsMem idals_mem;
+  IILUPrecData pdata;
+
+  if (IDA_mem->ida_lmem == NULL) return(0);
+  idals_mem = (IDALsMem) IDA_mem->ida_lmem;
+
+  if (idals_mem->pdata == NULL) return(0);
+  pdata = (IILUPrecData) idals_mem->pdata;
+
+  SUNLinSolFree(pdata->LS);
+  N_VDestroy(pdata->tempv1);
+  N_VDestroy(pdata->tempv2);
+  N_VDestroy(pdata->tempv3);
+  SUNMatDestroy(pdata->PP);
+
+  free(pdata);
+  pdata = NULL;
+
+  return(0);
+}
+
+
+/*---------------------------------------------------------------
+  IDAILUPrecAccess
+
+  This routine checks the integrator, linear solver and
+  preconditioner memory and returns pointers to them.
+  ---------------------------------------------------------------*/
+static int IDAILUPrecAccess(void *ida_mem, const char *fname,
+                            IDAMem *IDA_mem, IILUPrecData *pdata)
+{
+  IDALsMem idals_mem;
+
+  if (ida_mem == NULL) {
+    IDAProcessError(NULL, IDALS_MEM_NULL, "IDAILUPRE",
+                    fname, MSGILU_MEM_NULL);
+    return(IDALS_MEM_NULL);
+  }
+  *IDA_mem = (IDAMem) ida_mem;
+
+  if ((*IDA_mem)->ida_lmem == NULL) {
+    IDAProcessError(*IDA_mem, IDALS_LMEM_NULL, "IDAILUPRE",
+                    fname, MSGILU_LMEM_NULL);
+    return(IDALS_LMEM_NULL);
+  }
+  idals_mem = (IDALsMem) (*IDA_mem)->ida_lmem;
+
+  if (idals_mem->pdata == NULL) {
+    IDAProcessError(*IDA_mem, IDALS_PMEM_NULL, "IDAILUPRE",
+                    fname, MSGILU_PMEM_NULL);
+    return(IDALS_PMEM_NULL);
+  }
+  *pdata = (IILUPrecData) idals_mem->pdata;
+
+  return(IDALS_SUCCESS);
+}
@@ -199,6 +199,8 @@ typedef struct IDAMemRec {
   realtype ida_epsNewt;  /* test constant in Newton convergence test          */
   realtype ida_epcon;    /* coeficient of the Newton covergence test          */
   realtype ida_toldel;   /* tolerance in direct test on Newton corrections    */
+  realtype ida_enorm_kp1;     /* error norm for order k+1 from IDATestError   */
+  booleantype ida_kp1nrmcur;  /* is enorm_kp1 current?                        */
 
   /*------
     Limits
@@ -229,6 +231,8 @@ typedef struct IDAMemRec {
   long int ida_nre;      /* number of function (res) calls                    */
   long int ida_ncfn;     /* number of corrector convergence failures          */
   long int ida_netf;     /* number of error test failures                     */
+  long int ida_nreduce;  /* number of error test and order selection norm
+                            reductions                                        */
   long int ida_nni;      /* number of Newton iterations performed             */
   long int ida_nnf;      /* number of Newton convergence failures             */
   long int ida_nsetups;  /* number of lsetup calls                            */
@@ -918,6 +918,24 @@ int IDAGetNumErrTestFails(void *ida_mem, long int *netfails)
 
 /*-----------------------------------------------------------------*/
 
+int IDAGetNumReductions(void *ida_mem, long int *nreduce)
+{
+  IDAMem IDA_mem;
+
+  if (ida_mem==NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDA", "IDAGetNumReductions", MSG_NO_MEM);
+    return(IDA_MEM_NULL);
+  }
+
+  IDA_mem = (IDAMem) ida_mem;
+
+  *nreduce = IDA_mem->ida_nreduce;
+
+  return(IDA_SUCCESS);
+}
+
+/*-----------------------------------------------------------------*/
+
 int IDAGetNumBacktrackOps(void *ida_mem, long int *nbacktracks)
 {
   IDAMem IDA_mem;
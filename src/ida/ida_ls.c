@@ -24,6 +24,7 @@
 #include <sundials/sundials_math.h>
 #include <sundials/sundials_linearsolver.h>
 #include <sunmatrix/sunmatrix_band.h>
+#include <sunmatrix/sunmatrix_bsr.h>
 #include <sunmatrix/sunmatrix_dense.h>
 #include <sunmatrix/sunmatrix_sparse.h>
 
@@ -303,6 +304,108 @@ int IDASetJacFn(void *ida_mem, IDALsJacFn jac)
 }
 
 
+/* IDASetJacSparsityPattern specifies the sparsity pattern used by the
+ * internal difference quotient Jacobian approximation with a sparse matrix.
+ * A copy of the pattern is stored and a column coloring is computed so that
+ * the Jacobian can be approximated with one residual evaluation per color. */
+int IDASetJacSparsityPattern(void *ida_mem, SUNMatrix P)
+{
+  IDAMem       IDA_mem;
+  IDALsMem     idals_mem;
+  sunindextype N;
+  int          retval;
+
+  /* access IDALsMem structure */
+  retval = idaLs_AccessLMem(ida_mem, "IDASetJacSparsityPattern",
+                            &IDA_mem, &idals_mem);
+  if (retval != IDALS_SUCCESS)  return(retval);
+
+  /* free any existing pattern */
+  if (idals_mem->jac_pattern) {
+    SUNMatDestroy(idals_mem->jac_pattern);
+    idals_mem->jac_pattern = NULL;
+  }
+  if (idals_mem->jac_colors) {
+    free(idals_mem->jac_colors);
+    idals_mem->jac_colors = NULL;
+  }
+  idals_mem->jac_ncolors = 0;
+
+  /* a NULL input disables the sparse DQ Jacobian */
+  if (P == NULL) return(IDALS_SUCCESS);
+
+  /* the pattern must match the sparse or BSR system matrix */
+  if ((idals_mem->J == NULL) ||
+      (SUNMatGetID(idals_mem->J) != SUNMatGetID(P)) ||
+      ((SUNMatGetID(P) == SUNMATRIX_SPARSE) &&
+       ((SUNSparseMatrix_Rows(P) != SUNSparseMatrix_Rows(idals_mem->J)) ||
+        (SUNSparseMatrix_Columns(P) != SUNSparseMatrix_Columns(idals_mem->J)) ||
+        (SUNSparseMatrix_SparseType(P) != SUNSparseMatrix_SparseType(idals_mem->J)))) ||
+      ((SUNMatGetID(P) == SUNMATRIX_BSR) &&
+       ((SUNBSRMatrix_BlockRows(P) != SUNBSRMatrix_BlockRows(idals_mem->J)) ||
+        (SUNBSRMatrix_BlockColumns(P) != SUNBSRMatrix_BlockColumns(idals_mem->J)) ||
+        (SUNBSRMatrix_BlockSize(P) != SUNBSRMatrix_BlockSize(idals_mem->J)))) ||
+      ((SUNMatGetID(P) != SUNMATRIX_SPARSE) &&
+       (SUNMatGetID(P) != SUNMATRIX_BSR))) {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, "IDALS",
+                    "IDASetJacSparsityPattern",
+                    "Sparsity pattern is incompatible with the SUNMatrix");
+    return(IDALS_ILL_INPUT);
+  }
+
+  /* store a copy of the pattern */
+  idals_mem->jac_pattern = SUNMatClone(P);
+  if (idals_mem->jac_pattern == NULL) {
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDALS",
+                    "IDASetJacSparsityPattern", MSG_LS_MEM_FAIL);
+    return(IDALS_MEM_FAIL);
+  }
+
+  retval = SUNMatCopy(P, idals_mem->jac_pattern);
+  if (retval != SUNMAT_SUCCESS) {
+    IDAProcessError(IDA_mem, IDALS_SUNMAT_FAIL, "IDALS",
+                    "IDASetJacSparsityPattern", MSG_LS_SUNMAT_FAILED);
+    SUNMatDestroy(idals_mem->jac_pattern);
+    idals_mem->jac_pattern = NULL;
+    return(IDALS_SUNMAT_FAIL);
+  }
+
+  /* color the columns of the pattern */
+  if (SUNMatGetID(P) == SUNMATRIX_BSR)
+    N = SUNBSRMatrix_Columns(P);
+  else
+    N = SUNSparseMatrix_Columns(P);
+  idals_mem->jac_colors = (sunindextype *) malloc(N*sizeof(sunindextype));
+  if (idals_mem->jac_colors == NULL) {
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDALS",
+                    "IDASetJacSparsityPattern", MSG_LS_MEM_FAIL);
+    SUNMatDestroy(idals_mem->jac_pattern);
+    idals_mem->jac_pattern = NULL;
+    return(IDALS_MEM_FAIL);
+  }
+
+  if (SUNMatGetID(P) == SUNMATRIX_BSR)
+    retval = SUNBSRMatrix_ColorColumns(idals_mem->jac_pattern,
+                                       idals_mem->jac_colors,
+                                       &(idals_mem->jac_ncolors));
+  else
+    retval = SUNSparseMatrix_ColorColumns(idals_mem->jac_pattern,
+                                          idals_mem->jac_colors,
+                                          &(idals_mem->jac_ncolors));
+  if (retval != SUNMAT_SUCCESS) {
+    IDAProcessError(IDA_mem, IDALS_SUNMAT_FAIL, "IDALS",
+                    "IDASetJacSparsityPattern", MSG_LS_SUNMAT_FAILED);
+    SUNMatDestroy(idals_mem->jac_pattern);
+    idals_mem->jac_pattern = NULL;
+    free(idals_mem->jac_colors);
+    idals_mem->jac_colors = NULL;
+    return(IDALS_SUNMAT_FAIL);
+  }
+
+  return(IDALS_SUCCESS);
+}
+
+
 /* IDASetEpsLin specifies the nonlinear -> linear tolerance scale factor */
 int IDASetEpsLin(void *ida_mem, realtype eplifac)
 {
@@ -957,6 +1060,10 @@ int idaLsDQJac(realtype t, realtype c_j, N_Vector y, N_Vector yp,
     retval = idaLsDenseDQJac(t, c_j, y, yp, r, Jac, IDA_mem, tmp1);
   } else if (SUNMatGetID(Jac) == SUNMATRIX_BAND) {
     retval = idaLsBandDQJac(t, c_j, y, yp, r, Jac, IDA_mem, tmp1, tmp2, tmp3);
+  } else if (((SUNMatGetID(Jac) == SUNMATRIX_SPARSE) ||
+               (SUNMatGetID(Jac) == SUNMATRIX_BSR)) &&
+             (((IDALsMem) IDA_mem->ida_lmem)->jac_pattern != NULL)) {
+    retval = idaLsSparseDQJac(t, c_j, y, yp, r, Jac, IDA_mem, tmp1, tmp2, tmp3);
   } else {
     IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDALS",
                     "idaLsDQJac",
@@ -1190,6 +1297,165 @@ int idaLsBandDQJac(realtype tt, realtype c_j, N_Vector yy,
 }
 
 
+/*---------------------------------------------------------------
+  idaLsSparseDQJac
+
+  This routine generates a sparse difference quotient approximation
+  JJ to the DAE system Jacobian J using the user-supplied sparsity
+  pattern. The columns of the pattern are grouped by the coloring
+  computed in IDASetJacSparsityPattern so that columns of one color
+  do not share any rows. All yy[j] and yp[j] of a color are
+  perturbed together, requiring a single residual evaluation per
+  color, and the difference quotients are scattered into the
+  pattern entries (CSC, CSR or BSR) of the matching columns. The
+  increments are the same as in idaLsBandDQJac.
+  ---------------------------------------------------------------*/
+int idaLsSparseDQJac(realtype tt, realtype c_j, N_Vector yy,
+                     N_Vector yp, N_Vector rr, SUNMatrix Jac,
+                     IDAMem IDA_mem, N_Vector tmp1, N_Vector tmp2,
+                     N_Vector tmp3)
+{
+  realtype inc, yj, ypj, srur, conj, ewtj;
+  realtype *y_data, *yp_data, *ewt_data, *cns_data = NULL;
+  realtype *ytemp_data, *yptemp_data, *rtemp_data, *r_data, *J_data;
+  N_Vector rtemp, ytemp, yptemp;
+  sunindextype *colors, *Jp, *Ji;
+  sunindextype color, i, j, p, N, NP, I, r, c, bs;
+  IDALsMem idals_mem;
+  int retval = 0;
+
+  /* access LsMem interface structure */
+  idals_mem = (IDALsMem) IDA_mem->ida_lmem;
+
+  /* load the pattern into the Jacobian matrix */
+  retval = SUNMatCopy(idals_mem->jac_pattern, Jac);
+  if (retval != SUNMAT_SUCCESS) return(-1);
+
+  /* access matrix dimensions and data, for a BSR matrix NP is the number
+     of block rows and Jp, Ji index the blocks */
+  bs = 1;
+  if (SUNMatGetID(Jac) == SUNMATRIX_BSR) {
+    N      = SUNBSRMatrix_Columns(Jac);
+    NP     = SUNBSRMatrix_BlockRows(Jac);
+    bs     = SUNBSRMatrix_BlockSize(Jac);
+    Jp     = SUNBSRMatrix_IndexPointers(Jac);
+    Ji     = SUNBSRMatrix_IndexValues(Jac);
+    J_data = SUNBSRMatrix_Data(Jac);
+  } else {
+    N      = SUNSparseMatrix_Columns(Jac);
+    NP     = SUNSparseMatrix_NP(Jac);
+    Jp     = SUNSparseMatrix_IndexPointers(Jac);
+    Ji     = SUNSparseMatrix_IndexValues(Jac);
+    J_data = SUNSparseMatrix_Data(Jac);
+  }
+  colors = idals_mem->jac_colors;
+
+  /* Rename work vectors for use as temporary values of r, y and yp */
+  rtemp = tmp1;
+  ytemp = tmp2;
+  yptemp= tmp3;
+
+  /* Obtain pointers to the data for all vectors used.  */
+  ewt_data    = N_VGetArrayPointer(IDA_mem->ida_ewt);
+  r_data      = N_VGetArrayPointer(rr);
+  y_data      = N_VGetArrayPointer(yy);
+  yp_data     = N_VGetArrayPointer(yp);
+  rtemp_data  = N_VGetArrayPointer(rtemp);
+  ytemp_data  = N_VGetArrayPointer(ytemp);
+  yptemp_data = N_VGetArrayPointer(yptemp);
+  if (IDA_mem->ida_constraintsSet)
+    cns_data = N_VGetArrayPointer(IDA_mem->ida_constraints);
+
+  /* Initialize ytemp and yptemp. */
+  N_VScale(ONE, yy, ytemp);
+  N_VScale(ONE, yp, yptemp);
+
+  /* Compute miscellaneous values for the Jacobian computation. */
+  srur = SUNRsqrt(IDA_mem->ida_uround);
+
+  /* Loop over column colors. */
+  for (color=0; color < idals_mem->jac_ncolors; color++) {
+
+    /* Increment all yy[j] and yp[j] for j of this color. */
+    for (j=0; j<N; j++) {
+      if (colors[j] != color) continue;
+
+      yj = y_data[j];
+      ypj = yp_data[j];
+      ewtj = ewt_data[j];
+
+      /* Set increment inc to yj based on sqrt(uround)*abs(yj), with
+      adjustments using ypj and ewtj if this is small, and a further
+      adjustment to give it the same sign as hh*ypj. */
+      inc = SUNMAX( srur * SUNMAX( SUNRabs(yj), SUNRabs(IDA_mem->ida_hh*ypj) ),
+                    ONE/ewtj );
+      if (IDA_mem->ida_hh*ypj < ZERO)  inc = -inc;
+      inc = (yj + inc) - yj;
+
+      /* Adjust sign(inc) again if yj has an inequality constraint. */
+      if (IDA_mem->ida_constraintsSet) {
+        conj = cns_data[j];
+        if (SUNRabs(conj) == ONE)      {if((yj+inc)*conj <  ZERO) inc = -inc;}
+        else if (SUNRabs(conj) == TWO) {if((yj+inc)*conj <= ZERO) inc = -inc;}
+      }
+
+      /* Increment yj and ypj. */
+      ytemp_data[j] += inc;
+      yptemp_data[j] += c_j*inc;
+    }
+
+    /* Call res routine with incremented arguments. */
+    retval = IDA_mem->ida_res(tt, ytemp, yptemp, rtemp, IDA_mem->ida_user_data);
+    idals_mem->nreDQ++;
+    if (retval != 0) break;
+
+    /* Load the difference quotients. Since inc = (yj + inc) - yj, the
+       increment is recovered exactly from ytemp before it is reset. */
+    if (SUNMatGetID(Jac) == SUNMATRIX_BSR) {
+      for (I=0; I < NP; I++) {
+        for (p=Jp[I]; p < Jp[I+1]; p++) {
+          for (c=0; c < bs; c++) {
+            j = Ji[p]*bs + c;
+            if (colors[j] != color) continue;
+            inc = ytemp_data[j] - y_data[j];
+            for (r=0; r < bs; r++) {
+              i = I*bs + r;
+              J_data[(p*bs + c)*bs + r] = (rtemp_data[i] - r_data[i]) / inc;
+            }
+          }
+        }
+      }
+    } else if (SUNSparseMatrix_SparseType(Jac) == CSC_MAT) {
+      for (j=0; j<N; j++) {
+        if (colors[j] != color) continue;
+        inc = ytemp_data[j] - y_data[j];
+        for (p=Jp[j]; p<Jp[j+1]; p++) {
+          i = Ji[p];
+          J_data[p] = (rtemp_data[i] - r_data[i]) / inc;
+        }
+      }
+    } else {
+      for (i=0; i<NP; i++) {
+        for (p=Jp[i]; p<Jp[i+1]; p++) {
+          j = Ji[p];
+          if (colors[j] != color) continue;
+          J_data[p] = (rtemp_data[i] - r_data[i]) / (ytemp_data[j] - y_data[j]);
+        }
+      }
+    }
+
+    /* Reset ytemp and yptemp components that were perturbed. */
+    for (j=0; j<N; j++) {
+      if (colors[j] != color) continue;
+      ytemp_data[j]  = y_data[j];
+      yptemp_data[j] = yp_data[j];
+    }
+  }
+
+  return(retval);
+}
+
+
 /*---------------------------------------------------------------
   idaLsDQJtimes
 
@@ -1285,13 +1551,17 @@ int idaLsInitialize(IDAMem IDA_mem)
   } else if (idals_mem->jacDQ) {
 
     /* If J is non-NULL, and 'jac' is not user-supplied:
-       - if J is dense or band, ensure that our DQ approx. is used
+       - if J is dense, band, or sparse or BSR with a sparsity pattern, ensure
+         that our DQ approx. is used
        - otherwise => error */
     retval = 0;
     if (idals_mem->J->ops->getid) {
 
       if ( (SUNMatGetID(idals_mem->J) == SUNMATRIX_DENSE) ||
-           (SUNMatGetID(idals_mem->J) == SUNMATRIX_BAND) ) {
+           (SUNMatGetID(idals_mem->J) == SUNMATRIX_BAND) ||
+           (((SUNMatGetID(idals_mem->J) == SUNMATRIX_SPARSE) ||
+             (SUNMatGetID(idals_mem->J) == SUNMATRIX_BSR)) &&
+            (idals_mem->jac_pattern != NULL)) ) {
         idals_mem->jac    = idaLsDQJac;
         idals_mem->J_data = IDA_mem;
       } else {
@@ -1678,6 +1948,16 @@ int idaLsFree(IDAMem IDA_mem)
   /* Nullify SUNMatrix pointer */
   idals_mem->J = NULL;
 
+  /* Free sparse DQ Jacobian pattern and coloring */
+  if (idals_mem->jac_pattern) {
+    SUNMatDestroy(idals_mem->jac_pattern);
+    idals_mem->jac_pattern = NULL;
+  }
+  if (idals_mem->jac_colors) {
+    free(idals_mem->jac_colors);
+    idals_mem->jac_colors = NULL;
+  }
+
   /* Free preconditioner memory (if applicable) */
   if (idals_mem->pfree)  idals_mem->pfree(IDA_mem);
 
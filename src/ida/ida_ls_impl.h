@@ -53,6 +53,11 @@ typedef struct IDALsMemRec {
   N_Vector ypcur;       /* current yp vector in Newton iteration         */
   N_Vector rcur;        /* rcur = F(tn, ycur, ypcur)                     */
 
+  /* Sparse difference quotient Jacobian */
+  SUNMatrix jac_pattern;    /* copy of the Jacobian sparsity pattern      */
+  sunindextype *jac_colors; /* column colors of the sparsity pattern      */
+  sunindextype jac_ncolors; /* number of column colors                    */
+
   /* Matrix-based solver, scale solution to account for change in cj */
   booleantype scalesol;
 
@@ -135,6 +140,10 @@ int idaLsBandDQJac(realtype tt, realtype c_j,  N_Vector yy,
                    N_Vector yp, N_Vector rr, SUNMatrix Jac,
                    IDAMem IDA_mem, N_Vector tmp1,
                    N_Vector tmp2, N_Vector tmp3);
+int idaLsSparseDQJac(realtype tt, realtype c_j,  N_Vector yy,
+                     N_Vector yp, N_Vector rr, SUNMatrix Jac,
+                     IDAMem IDA_mem, N_Vector tmp1,
+                     N_Vector tmp2, N_Vector tmp3);
 
 /* Generic linit/lsetup/lsolve/lperf/lfree interface routines for IDA to call */
 int idaLsInitialize(IDAMem IDA_mem);
@@ -184,6 +193,7 @@ int idaLs_AccessLMem(void* ida_mem, const char* fname,
 #define MSG_LS_JTIMES_FAILED  "The Jacobian x vector routine failed in an unrecoverable manner."
 #define MSG_LS_JACFUNC_FAILED "The Jacobian routine failed in an unrecoverable manner."
 #define MSG_LS_MATZERO_FAILED "The SUNMatZero routine failed in an unrecoverable manner."
+#define MSG_LS_SUNMAT_FAILED  "A SUNMatrix routine failed in an unrecoverable manner."
 
 /* Warning Messages */
 #define MSG_LS_WARN  "Warning: " MSG_LS_TIME "poor iterative algorithm performance. "
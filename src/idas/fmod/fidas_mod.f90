@@ -334,6 +334,7 @@ module fidas_mod
  integer(C_INT), parameter, public :: IDALS_LMEMB_NULL = -102_C_INT
  public :: FIDASetLinearSolver
  public :: FIDASetJacFn
+ public :: FIDASetJacSparsityPattern
  public :: FIDASetPreconditioner
  public :: FIDASetJacTimes
  public :: FIDASetEpsLin
@@ -358,6 +359,7 @@ module fidas_mod
  public :: FIDASetLinearSolverB
  public :: FIDASetJacFnB
  public :: FIDASetJacFnBS
+ public :: FIDASetJacSparsityPatternB
  public :: FIDASetEpsLinB
  public :: FIDASetLSNormFactorB
  public :: FIDASetLinearSolutionScalingB
@@ -2345,6 +2347,15 @@ type(C_FUNPTR), value :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FIDASetJacSparsityPattern(farg1, farg2) &
+bind(C, name="_wrap_FIDASetJacSparsityPattern") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FIDASetPreconditioner(farg1, farg2, farg3) &
 bind(C, name="_wrap_FIDASetPreconditioner") &
 result(fresult)
@@ -2568,6 +2579,16 @@ type(C_FUNPTR), value :: farg3
 integer(C_INT) :: fresult
 end function
 
+function swigc_FIDASetJacSparsityPatternB(farg1, farg2, farg3) &
+bind(C, name="_wrap_FIDASetJacSparsityPatternB") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+type(C_PTR), value :: farg3
+integer(C_INT) :: fresult
+end function
+
 function swigc_FIDASetEpsLinB(farg1, farg2, farg3) &
 bind(C, name="_wrap_FIDASetEpsLinB") &
 result(fresult)
@@ -6329,6 +6350,22 @@ fresult = swigc_FIDASetJacFn(farg1, farg2)
 swig_result = fresult
 end function
 
+function FIDASetJacSparsityPattern(ida_mem, p) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: ida_mem
+type(SUNMatrix), target, intent(inout) :: p
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = ida_mem
+farg2 = c_loc(p)
+fresult = swigc_FIDASetJacSparsityPattern(farg1, farg2)
+swig_result = fresult
+end function
+
 function FIDASetPreconditioner(ida_mem, pset, psolve) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -6732,6 +6769,25 @@ fresult = swigc_FIDASetJacFnBS(farg1, farg2, farg3)
 swig_result = fresult
 end function
 
+function FIDASetJacSparsityPatternB(ida_mem, which, pb) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: ida_mem
+integer(C_INT), intent(in) :: which
+type(SUNMatrix), target, intent(inout) :: pb
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+type(C_PTR) :: farg3 
+
+farg1 = ida_mem
+farg2 = which
+farg3 = c_loc(pb)
+fresult = swigc_FIDASetJacSparsityPatternB(farg1, farg2, farg3)
+swig_result = fresult
+end function
+
 function FIDASetEpsLinB(ida_mem, which, eplifacb) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -51,12 +51,22 @@ static IDAckpntMem IDAAckpntNew(IDAMem IDA_mem);
 static void IDAAckpntCopyVectors(IDAMem IDA_mem, IDAckpntMem ck_mem);
 static booleantype IDAAckpntAllocVectors(IDAMem IDA_mem, IDAckpntMem ck_mem);
 static void IDAAckpntDelete(IDAckpntMem *ck_memPtr);
+static void IDAAckpntRemove(IDAMem IDA_mem, IDAckpntMem *ck_memPtr);
+static int  IDAAckpntThin(IDAMem IDA_mem);
+static int  IDAAckpntXfer(IDAMem IDA_mem, IDAckpntMem ck_mem, int mode,
+                          size_t *bytes);
+static int  IDAAckpntStore(IDAMem IDA_mem, IDAckpntMem ck_mem);
+static int  IDAAckpntLoad(IDAMem IDA_mem, IDAckpntMem ck_mem);
 
 static void IDAAbckpbDelete(IDABMem *IDAB_memPtr);
 
 static booleantype IDAAdataMalloc(IDAMem IDA_mem);
 static void IDAAdataFree(IDAMem IDA_mem);
 static int  IDAAdataStore(IDAMem IDA_mem, IDAckpntMem ck_mem);
+static int  IDAAdataRecord(IDAMem IDA_mem, realtype t0, realtype t1);
+static int  IDAAadvance(IDAMem IDA_mem, long int nst);
+static int  IDAArevolve(IDAMem IDA_mem, IDAckpntMem *ck_memPtr);
+static long int IDAArevolveSplit(long int m, long int s);
 
 static int  IDAAckpntGet(IDAMem IDA_mem, IDAckpntMem ck_mem);
 
@@ -146,6 +156,21 @@ int IDAAdjInit(void *ida_mem, long int steps, int interp)
   IDAADJ_mem->ia_nckpnts = 0;
   IDAADJ_mem->ia_ckpntData = NULL;
 
+  /* Check point phi arrays are kept in N_Vectors by default */
+  IDAADJ_mem->ia_ckstore = NULL;
+  IDAADJ_mem->ia_ckbuf = NULL;
+  IDAADJ_mem->ia_ckbufsize = 0;
+  IDAADJ_mem->ia_ckkey = 0;
+
+  /* All check points are kept by default */
+  IDAADJ_mem->ia_nslots = 0;
+  IDAADJ_mem->ia_ckspace = 1;
+  IDAADJ_mem->ia_tblk = NULL;
+  IDAADJ_mem->ia_tblkalloc = 0;
+  IDAADJ_mem->ia_ckpntBlk = 0;
+
+  IDAADJ_mem->ia_nstF = 0;
+  IDAADJ_mem->ia_nstR = 0;
 
   /* Initialization of interpolation data. */
   IDAADJ_mem->ia_interpType = interp;
@@ -254,6 +279,11 @@ int IDAAdjReInit(void *ida_mem)
   IDAADJ_mem->ck_mem = NULL;
   IDAADJ_mem->ia_nckpnts = 0;
   IDAADJ_mem->ia_ckpntData = NULL;
+  IDAADJ_mem->ia_ckspace = 1;
+  IDAADJ_mem->ia_ckpntBlk = 0;
+
+  IDAADJ_mem->ia_nstF = 0;
+  IDAADJ_mem->ia_nstR = 0;
 
   /* Flags for tracking the first calls to IDASolveF and IDASolveF. */
   IDAADJ_mem->ia_firstIDAFcall = SUNTRUE;
@@ -289,6 +319,10 @@ void IDAAdjFree(void *ida_mem)
       IDAAckpntDelete(&(IDAADJ_mem->ck_mem));
     }
 
+    /* Free the check point packing buffer and block start times */
+    if (IDAADJ_mem->ia_ckbuf != NULL) free(IDAADJ_mem->ia_ckbuf);
+    if (IDAADJ_mem->ia_tblk != NULL) free(IDAADJ_mem->ia_tblk);
+
     IDAAdataFree(IDA_mem);
 
     /* Free all backward problems. */
@@ -302,6 +336,86 @@ void IDAAdjFree(void *ida_mem)
   }
 }
 
+/*
+ * IDAAckpntRemove
+ *
+ * This routine deletes the check point *ck_memPtr from anywhere in
+ * the list, extending the interval of the previous check point.
+ */
+
+static void IDAAckpntRemove(IDAMem IDA_mem, IDAckpntMem *ck_memPtr)
+{
+  IDAadjMem IDAADJ_mem;
+  IDAckpntMem ck_mem;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+  ck_mem = *ck_memPtr;
+
+  if (ck_mem->ck_next != NULL) ck_mem->ck_next->ck_t1 = ck_mem->ck_t1;
+  if (IDAADJ_mem->ia_ckpntData == ck_mem) IDAADJ_mem->ia_ckpntData = NULL;
+
+  IDAAckpntDelete(ck_memPtr);
+  IDAADJ_mem->ia_nckpnts--;
+}
+
+/*
+ * IDAAckpntThin
+ *
+ * With binomial checkpointing, this routine is called by IDASolveF
+ * each time a check point is added at the start of a block of nsteps
+ * steps. It records the start time of the block and keeps the
+ * previous check point only if it lies on the grid of blocks spaced
+ * ia_ckspace apart. Whenever more than half of the slots are in use
+ * the grid spacing is doubled and the check points no longer on the
+ * grid are deleted, leaving the other slots for IDASolveB.
+ */
+
+static int IDAAckpntThin(IDAMem IDA_mem)
+{
+  IDAadjMem IDAADJ_mem;
+  IDAckpntMem ck_mem, *ck_link;
+  realtype *tblk;
+  long int blk, nalloc, nfwd;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+  ck_mem = IDAADJ_mem->ck_mem;
+
+  /* Record the start time of the new block */
+  blk = ck_mem->ck_nst / IDAADJ_mem->ia_nsteps;
+
+  if (blk >= IDAADJ_mem->ia_tblkalloc) {
+    nalloc = SUNMAX(64, 2*blk);
+    tblk = (realtype *) realloc(IDAADJ_mem->ia_tblk, nalloc*sizeof(realtype));
+    if (tblk == NULL) return(IDA_MEM_FAIL);
+    IDAADJ_mem->ia_tblk = tblk;
+    IDAADJ_mem->ia_tblkalloc = nalloc;
+  }
+  IDAADJ_mem->ia_tblk[blk] = ck_mem->ck_t0;
+
+  if (ck_mem->ck_next == NULL) return(IDA_SUCCESS);
+
+  /* Keep the previous check point if it is the first one or on the grid */
+  if ( (ck_mem->ck_next->ck_next != NULL) &&
+       ((ck_mem->ck_next->ck_nst / IDAADJ_mem->ia_nsteps) % IDAADJ_mem->ia_ckspace != 0) )
+    IDAAckpntRemove(IDA_mem, &(ck_mem->ck_next));
+
+  /* Coarsen the grid while more than half of the slots are used */
+  nfwd = SUNMAX(2, (IDAADJ_mem->ia_nslots + 1) / 2);
+
+  while (IDAADJ_mem->ia_nckpnts + 1 > nfwd) {
+    IDAADJ_mem->ia_ckspace *= 2;
+    ck_link = &(ck_mem->ck_next);
+    while ((*ck_link)->ck_next != NULL) {
+      if (((*ck_link)->ck_nst / IDAADJ_mem->ia_nsteps) % IDAADJ_mem->ia_ckspace != 0)
+        IDAAckpntRemove(IDA_mem, ck_link);
+      else
+        ck_link = &((*ck_link)->ck_next);
+    }
+  }
+
+  return(IDA_SUCCESS);
+}
+
 /*
  * =================================================================
  * PRIVATE FUNCTIONS FOR BACKWARD PROBLEMS
@@ -438,6 +552,14 @@ int IDASolveF(void *ida_mem, realtype tout, realtype *tret,
       return(IDA_MEM_FAIL);
     }
 
+    if (IDAADJ_mem->ia_nslots > 0) {
+      if (IDAAckpntThin(IDA_mem) != IDA_SUCCESS) {
+        IDAProcessError(IDA_mem, IDA_MEM_FAIL, "IDAA", "IDASolveF", MSG_MEM_FAIL);
+        SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+        return(IDA_MEM_FAIL);
+      }
+    }
+
     if (!IDAADJ_mem->ia_mallocDone) {
       /* Do we need to store sensitivities? */
       if (!IDA_mem->ida_sensi) IDAADJ_mem->ia_storeSensi = SUNFALSE;
@@ -497,6 +619,7 @@ int IDASolveF(void *ida_mem, realtype tout, realtype *tret,
       *ncheckPtr = IDAADJ_mem->ia_nckpnts;
       IDAADJ_mem->ia_newData = SUNTRUE;
       IDAADJ_mem->ia_ckpntData = IDAADJ_mem->ck_mem;
+      IDAADJ_mem->ia_ckpntBlk = IDAADJ_mem->ck_mem->ck_nst / IDAADJ_mem->ia_nsteps;
       IDAADJ_mem->ia_np = IDA_mem->ida_nst % IDAADJ_mem->ia_nsteps + 1;
       SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
       return(flag);
@@ -523,6 +646,7 @@ int IDASolveF(void *ida_mem, realtype tout, realtype *tret,
     if (flag < 0) break;
 
     nstloc++;
+    IDAADJ_mem->ia_nstF++;
 
     /* Test if a new check point is needed */
 
@@ -543,6 +667,14 @@ int IDASolveF(void *ida_mem, realtype tout, realtype *tret,
 
       IDA_mem->ida_forceSetup = SUNTRUE;
 
+      /* With a limited number of slots, drop check points not needed */
+      if (IDAADJ_mem->ia_nslots > 0) {
+        if (IDAAckpntThin(IDA_mem) != IDA_SUCCESS) {
+          flag = IDA_MEM_FAIL;
+          break;
+        }
+      }
+
       /* Reset i=0 and load dt_mem[0] */
       dt_mem[0]->t = IDAADJ_mem->ck_mem->ck_t0;
       IDAADJ_mem->ia_storePnt(IDA_mem, dt_mem[0]);
@@ -599,6 +731,7 @@ int IDASolveF(void *ida_mem, realtype tout, realtype *tret,
   /* Data is available for the last interval */
   IDAADJ_mem->ia_newData = SUNTRUE;
   IDAADJ_mem->ia_ckpntData = IDAADJ_mem->ck_mem;
+  IDAADJ_mem->ia_ckpntBlk = IDAADJ_mem->ck_mem->ck_nst / IDAADJ_mem->ia_nsteps;
   IDAADJ_mem->ia_np = IDA_mem->ida_nst % IDAADJ_mem->ia_nsteps + 1;
 
   SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
@@ -1454,7 +1587,7 @@ int IDASolveB(void *ida_mem, realtype tBout, int itaskB)
   IDAckpntMem ck_mem;
   IDABMem IDAB_mem, tmp_IDAB_mem;
   int flag=0, sign;
-  realtype tfuzz, tBret, tBn;
+  realtype tfuzz, tBret, tBn, tck;
   booleantype gotCkpnt, reachedTBout, isActive;
 
   /* Is the mem OK? */
@@ -1592,12 +1725,29 @@ int IDASolveB(void *ida_mem, realtype tBout, int itaskB)
 
     /* Store interpolation data if not available.
        This is the 2nd forward integration pass */
-    if (ck_mem != IDAADJ_mem->ia_ckpntData) {
+    if (IDAADJ_mem->ia_nslots > 0) {
+
+      flag = IDAArevolve(IDA_mem, &ck_mem);
+      if (flag != IDA_SUCCESS) break;
+
+    } else if (ck_mem != IDAADJ_mem->ia_ckpntData) {
 
       flag = IDAAdataStore(IDA_mem, ck_mem);
       if (flag != IDA_SUCCESS) break;
     }
 
+    /* Time at which the interpolation data starts */
+    if (IDAADJ_mem->ia_nslots > 0)
+      tck = IDAADJ_mem->ia_tblk[IDAADJ_mem->ia_ckpntBlk];
+    else
+      tck = ck_mem->ck_t0;
+
+    /* Start loading the check point needed next from the checkpoint
+       store while the backward problems are integrated */
+    if (ck_mem->ck_next != NULL && ck_mem->ck_next->ck_store != NULL)
+      (void) SUNCheckpointStore_Prefetch(ck_mem->ck_next->ck_store,
+                                         ck_mem->ck_next->ck_key);
+
     /* Starting with the current check point from above, loop over check points
        while propagating backward problems */
 
@@ -1609,9 +1759,9 @@ int IDASolveB(void *ida_mem, realtype tBout, int itaskB)
 
       tBn = tmp_IDAB_mem->IDA_mem->ida_tn;
 
-      if ( (tBn == ck_mem->ck_t0) && (sign*(tBout-ck_mem->ck_t0) < ZERO ) ) isActive = SUNFALSE;
-      if ( (tBn == ck_mem->ck_t0) && (itaskB == IDA_ONE_STEP) ) isActive = SUNFALSE;
-      if ( sign*(tBn - ck_mem->ck_t0) < ZERO ) isActive = SUNFALSE;
+      if ( (tBn == tck) && (sign*(tBout-tck) < ZERO ) ) isActive = SUNFALSE;
+      if ( (tBn == tck) && (itaskB == IDA_ONE_STEP) ) isActive = SUNFALSE;
+      if ( sign*(tBn - tck) < ZERO ) isActive = SUNFALSE;
 
       if ( isActive ) {
         /* Store the address of current backward problem memory
@@ -1619,7 +1769,7 @@ int IDASolveB(void *ida_mem, realtype tBout, int itaskB)
         IDAADJ_mem->ia_bckpbCrt = tmp_IDAB_mem;
 
         /* Integrate current backward problem */
-        IDASetStopTime(tmp_IDAB_mem->IDA_mem, ck_mem->ck_t0);
+        IDASetStopTime(tmp_IDAB_mem->IDA_mem, tck);
         flag = IDASolve(tmp_IDAB_mem->IDA_mem, tBout, &tBret,
                         tmp_IDAB_mem->ida_yy, tmp_IDAB_mem->ida_yp,
                         itaskB);
@@ -1665,8 +1815,11 @@ int IDASolveB(void *ida_mem, realtype tBout, int itaskB)
 
     if ( reachedTBout ) break;
 
-    /* Move check point in linked list to next one */
-    ck_mem = ck_mem->ck_next;
+    /* Move check point in linked list to next one (with binomial
+       checkpointing, only once its first block has been processed) */
+    if ( (IDAADJ_mem->ia_nslots == 0) ||
+         (IDAADJ_mem->ia_ckpntBlk == ck_mem->ck_nst / IDAADJ_mem->ia_nsteps) )
+      ck_mem = ck_mem->ck_next;
 
   } /* End of loop. */
 
@@ -1824,6 +1977,9 @@ static IDAckpntMem IDAAckpntInit(IDAMem IDA_mem)
   /* Alloc 3: current order, i.e. 1,  +   2. */
   ck_mem->ck_phi_alloc = 3;
 
+  /* The data at the initial time is always kept in N_Vectors */
+  ck_mem->ck_store = NULL;
+
   if (!IDAAckpntAllocVectors(IDA_mem, ck_mem)) {
     free(ck_mem); ck_mem = NULL;
     return(NULL);
@@ -1833,6 +1989,7 @@ static IDAckpntMem IDAAckpntInit(IDAMem IDA_mem)
 
   /* Next in list */
   ck_mem->ck_next  = NULL;
+  ck_mem->ck_temp  = SUNFALSE;
 
   return(ck_mem);
 }
@@ -1853,6 +2010,7 @@ static IDAckpntMem IDAAckpntNew(IDAMem IDA_mem)
   ck_mem = (IDAckpntMem) malloc(sizeof(struct IDAckpntMemRec));
   if (ck_mem == NULL) return(NULL);
 
+  ck_mem->ck_temp      = SUNFALSE;
   ck_mem->ck_nst       = IDA_mem->ida_nst;
   ck_mem->ck_tretlast  = IDA_mem->ida_tretlast;
   ck_mem->ck_kk        = IDA_mem->ida_kk;
@@ -1892,6 +2050,17 @@ static IDAckpntMem IDAAckpntNew(IDAMem IDA_mem)
   ck_mem->ck_phi_alloc = (IDA_mem->ida_kk+2 < MXORDP1) ?
     IDA_mem->ida_kk+2 : MXORDP1;
 
+  /* Save the phi arrays in the checkpoint store if one is set */
+  ck_mem->ck_store = NULL;
+
+  if (IDA_mem->ida_adj_mem->ia_ckstore != NULL) {
+    if (IDAAckpntStore(IDA_mem, ck_mem) != IDA_SUCCESS) {
+      free(ck_mem); ck_mem = NULL;
+      return(NULL);
+    }
+    return(ck_mem);
+  }
+
   if (!IDAAckpntAllocVectors(IDA_mem, ck_mem)) {
     free(ck_mem); ck_mem = NULL;
     return(NULL);
@@ -1919,6 +2088,13 @@ static void IDAAckpntDelete(IDAckpntMem *ck_memPtr)
     /* move head of list */
     *ck_memPtr = (*ck_memPtr)->ck_next;
 
+    /* release the data in the checkpoint store */
+    if (tmp->ck_store != NULL) {
+      (void) SUNCheckpointStore_Remove(tmp->ck_store, tmp->ck_key);
+      free(tmp); tmp=NULL;
+      return;
+    }
+
     /* free N_Vectors in tmp */
     for (j=0; j<tmp->ck_phi_alloc; j++)
       N_VDestroy(tmp->ck_phi[j]);
@@ -1944,6 +2120,120 @@ static void IDAAckpntDelete(IDAckpntMem *ck_memPtr)
   }
 }
 
+/*
+ * IDAAckpntXfer
+ *
+ * Walks over the phi arrays saved at a check point: phi[0],...,
+ * phi[phi_alloc-1] and, if carried, the corresponding quadrature,
+ * sensitivity, and quadrature sensitivity arrays. With mode = 0 it
+ * only adds up their packed size, with mode = 1 it packs them from
+ * IDA_mem into ia_ckbuf, and with mode = 2 it unpacks them from
+ * ia_ckbuf into IDA_mem. On return bytes holds the total packed size.
+ *
+ */
+static int IDAAckpntXfer(IDAMem IDA_mem, IDAckpntMem ck_mem, int mode,
+                         size_t *bytes)
+{
+  N_Vector v[4];
+  char *buf;
+  sunindextype vbytes;
+  int j, k, is, nv, ns, retval;
+
+  buf = (char*) IDA_mem->ida_adj_mem->ia_ckbuf;
+  ns  = ck_mem->ck_sensi ? ck_mem->ck_Ns : 0;
+  *bytes = 0;
+
+  for (j=0; j<ck_mem->ck_phi_alloc; j++) {
+    for (is=-1; is<ns; is++) {
+
+      nv = 0;
+      if (is < 0) {
+        v[nv++] = IDA_mem->ida_phi[j];
+        if (ck_mem->ck_quadr) v[nv++] = IDA_mem->ida_phiQ[j];
+      } else {
+        v[nv++] = IDA_mem->ida_phiS[j][is];
+        if (ck_mem->ck_quadr_sensi) v[nv++] = IDA_mem->ida_phiQS[j][is];
+      }
+
+      for (k=0; k<nv; k++) {
+        retval = N_VBufSize(v[k], &vbytes);
+        if (retval != 0) return(IDA_VECTOROP_ERR);
+        if (mode == 1) retval = N_VBufPack(v[k], buf + *bytes);
+        if (mode == 2) retval = N_VBufUnpack(v[k], buf + *bytes);
+        if (retval != 0) return(IDA_VECTOROP_ERR);
+        *bytes += (size_t) vbytes;
+      }
+    }
+  }
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDAAckpntStore
+ *
+ * Packs the phi arrays of a new check point and writes them to the
+ * checkpoint store.
+ *
+ */
+static int IDAAckpntStore(IDAMem IDA_mem, IDAckpntMem ck_mem)
+{
+  IDAadjMem IDAADJ_mem;
+  void *buf;
+  size_t bytes;
+  int retval;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  /* Make sure the packing buffer is large enough */
+  retval = IDAAckpntXfer(IDA_mem, ck_mem, 0, &bytes);
+  if (retval != IDA_SUCCESS) return(retval);
+
+  if (bytes > IDAADJ_mem->ia_ckbufsize) {
+    buf = realloc(IDAADJ_mem->ia_ckbuf, bytes);
+    if (buf == NULL) return(IDA_MEM_FAIL);
+    IDAADJ_mem->ia_ckbuf = buf;
+    IDAADJ_mem->ia_ckbufsize = bytes;
+  }
+
+  retval = IDAAckpntXfer(IDA_mem, ck_mem, 1, &bytes);
+  if (retval != IDA_SUCCESS) return(retval);
+
+  ck_mem->ck_key   = ++(IDAADJ_mem->ia_ckkey);
+  ck_mem->ck_bytes = bytes;
+
+  if (SUNCheckpointStore_Write(IDAADJ_mem->ia_ckstore, ck_mem->ck_key,
+                               IDAADJ_mem->ia_ckbuf, bytes) != 0)
+    return(IDA_MEM_FAIL);
+
+  ck_mem->ck_store = IDAADJ_mem->ia_ckstore;
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDAAckpntLoad
+ *
+ * Reads the phi arrays of a check point from the checkpoint store
+ * into IDA_mem.
+ *
+ */
+static int IDAAckpntLoad(IDAMem IDA_mem, IDAckpntMem ck_mem)
+{
+  IDAadjMem IDAADJ_mem;
+  size_t bytes;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  if (SUNCheckpointStore_Read(ck_mem->ck_store, ck_mem->ck_key,
+                              IDAADJ_mem->ia_ckbuf, ck_mem->ck_bytes) != 0) {
+    IDAProcessError(IDA_mem, IDA_MEM_FAIL, "IDAA", "IDAAckpntLoad", MSGAM_CKSTORE_FAIL);
+    return(IDA_MEM_FAIL);
+  }
+
+  return(IDAAckpntXfer(IDA_mem, ck_mem, 2, &bytes));
+}
+
 /*
  * IDAAckpntAllocVectors
  *
@@ -2169,52 +2459,269 @@ static void IDAAdataFree(IDAMem IDA_mem)
 static int IDAAdataStore(IDAMem IDA_mem, IDAckpntMem ck_mem)
 {
   IDAadjMem IDAADJ_mem;
-  IDAdtpntMem *dt_mem;
-  realtype t;
-  long int i;
-  int flag, sign;
+  int flag;
 
   IDAADJ_mem = IDA_mem->ida_adj_mem;
-  dt_mem = IDAADJ_mem->dt_mem;
 
   /* Initialize IDA_mem with data from ck_mem. */
   flag = IDAAckpntGet(IDA_mem, ck_mem);
   if (flag != IDA_SUCCESS)
     return(IDA_REIFWD_FAIL);
 
-  /* Set first structure in dt_mem[0] */
-  dt_mem[0]->t = ck_mem->ck_t0;
-  IDAADJ_mem->ia_storePnt(IDA_mem, dt_mem[0]);
-
   /* Decide whether TSTOP must be activated */
   if (IDAADJ_mem->ia_tstopIDAFcall) {
     IDASetStopTime(IDA_mem, IDAADJ_mem->ia_tstopIDAF);
   }
 
+  /* Run IDASolve to set the structures in dt_mem */
+  flag = IDAAdataRecord(IDA_mem, ck_mem->ck_t0, ck_mem->ck_t1);
+  if (flag != IDA_SUCCESS) return(flag);
+
+  /* New data is now available. */
+  IDAADJ_mem->ia_ckpntData = ck_mem;
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDAAdataRecord
+ *
+ * This routine integrates the forward model from its current state
+ * at t0 to t1, storing y and yprime at each step in dt_mem.
+ */
+
+static int IDAAdataRecord(IDAMem IDA_mem, realtype t0, realtype t1)
+{
+  IDAadjMem IDAADJ_mem;
+  IDAdtpntMem *dt_mem;
+  realtype t;
+  long int i;
+  int flag, sign;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+  dt_mem = IDAADJ_mem->dt_mem;
+
   sign = (IDAADJ_mem->ia_tfinal - IDAADJ_mem->ia_tinitial > ZERO) ? 1 : -1;
 
+  /* Set first structure in dt_mem[0] */
+  dt_mem[0]->t = t0;
+  IDAADJ_mem->ia_storePnt(IDA_mem, dt_mem[0]);
+
   /* Run IDASolve in IDA_ONE_STEP mode to set following structures in dt_mem[i]. */
   i = 1;
   do {
 
-    flag = IDASolve(IDA_mem, ck_mem->ck_t1, &t, IDAADJ_mem->ia_yyTmp,
+    if (i > IDAADJ_mem->ia_nsteps) return(IDA_FWD_FAIL);
+
+    flag = IDASolve(IDA_mem, t1, &t, IDAADJ_mem->ia_yyTmp,
                     IDAADJ_mem->ia_ypTmp, IDA_ONE_STEP);
     if (flag < 0) return(IDA_FWD_FAIL);
+    IDAADJ_mem->ia_nstR++;
 
     dt_mem[i]->t = t;
     IDAADJ_mem->ia_storePnt(IDA_mem, dt_mem[i]);
 
     i++;
-  } while ( sign*(ck_mem->ck_t1 - t) > ZERO );
+  } while ( sign*(t1 - t) > ZERO );
 
-  /* New data is now available. */
-  IDAADJ_mem->ia_ckpntData = ck_mem;
   IDAADJ_mem->ia_newData = SUNTRUE;
   IDAADJ_mem->ia_np  = i;
 
   return(IDA_SUCCESS);
 }
 
+/*
+ * IDAAadvance
+ *
+ * This routine integrates the forward model from its current state
+ * until nst steps have been taken, without storing any data. As in
+ * IDASolveF, a linear solver setup is forced at the start of each
+ * block of nsteps steps.
+ */
+
+static int IDAAadvance(IDAMem IDA_mem, long int nst)
+{
+  IDAadjMem IDAADJ_mem;
+  realtype t;
+  int flag;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  while (IDA_mem->ida_nst < nst) {
+
+    flag = IDASolve(IDA_mem, IDAADJ_mem->ia_tfinal, &t, IDAADJ_mem->ia_yyTmp,
+                    IDAADJ_mem->ia_ypTmp, IDA_ONE_STEP);
+    if (flag < 0) return(IDA_FWD_FAIL);
+    IDAADJ_mem->ia_nstR++;
+
+    if (IDA_mem->ida_nst % IDAADJ_mem->ia_nsteps == 0)
+      IDA_mem->ida_forceSetup = SUNTRUE;
+  }
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDAArevolve
+ *
+ * With binomial checkpointing, this routine makes interpolation data
+ * available for the block of nsteps steps containing the latest time
+ * reached by the backward problems, which lies in the interval of the
+ * check point *ck_memPtr. The interval is reversed as in the revolve
+ * algorithm of Griewank and Walther: while free slots remain and the
+ * block is not the first one in the interval, the forward problem is
+ * advanced by the optimal number of blocks and a new check point is
+ * taken, which becomes *ck_memPtr. Check points taken this way are
+ * deleted once the backward problems have passed them.
+ */
+
+static int IDAArevolve(IDAMem IDA_mem, IDAckpntMem *ck_memPtr)
+{
+  IDAadjMem IDAADJ_mem;
+  IDABMem tmp_IDAB_mem;
+  IDAckpntMem ck_mem, ck_newer, tmp, *ck_link;
+  realtype tB, t1;
+  long int blk, blkB, blkE, lo, hi, mid, nfree, k;
+  int flag, sign;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+  ck_mem = *ck_memPtr;
+
+  sign = (IDAADJ_mem->ia_tfinal - IDAADJ_mem->ia_tinitial > ZERO) ? 1 : -1;
+
+  /* Delete the check points taken for intervals that have been
+     completed and find the check point after ck_mem */
+  ck_newer = NULL;
+  ck_link  = &(IDAADJ_mem->ck_mem);
+  while (*ck_link != ck_mem) {
+    if ((*ck_link)->ck_temp) {
+      IDAAckpntRemove(IDA_mem, ck_link);
+    } else {
+      ck_newer = *ck_link;
+      ck_link  = &(ck_newer->ck_next);
+    }
+  }
+
+  /* Latest time reached by the backward problems */
+  tB = ck_mem->ck_t0;
+  for (tmp_IDAB_mem = IDAADJ_mem->IDAB_mem; tmp_IDAB_mem != NULL;
+       tmp_IDAB_mem = tmp_IDAB_mem->ida_next) {
+    if (sign*(tmp_IDAB_mem->IDA_mem->ida_tn - tB) > ZERO)
+      tB = tmp_IDAB_mem->IDA_mem->ida_tn;
+  }
+
+  for(;;) {
+
+    /* The interval of ck_mem spans the blocks blk,...,blkE-1. Find the
+       block blkB containing tB. */
+    blk  = ck_mem->ck_nst / IDAADJ_mem->ia_nsteps;
+    blkE = (ck_newer == NULL) ? blk+1 : ck_newer->ck_nst / IDAADJ_mem->ia_nsteps;
+
+    blkB = blk;
+    lo = blk + 1;
+    hi = blkE - 1;
+    while (lo <= hi) {
+      mid = (lo + hi) / 2;
+      if (sign*(tB - IDAADJ_mem->ia_tblk[mid]) > ZERO) {
+        blkB = mid;
+        lo = mid + 1;
+      } else {
+        hi = mid - 1;
+      }
+    }
+
+    /* Is the data already available? */
+    if ( (ck_mem == IDAADJ_mem->ia_ckpntData) &&
+         (blkB == IDAADJ_mem->ia_ckpntBlk) )
+      break;
+
+    /* Restart the forward problem from ck_mem */
+    flag = IDAAckpntGet(IDA_mem, ck_mem);
+    if (flag != IDA_SUCCESS) return(IDA_REIFWD_FAIL);
+
+    if (IDAADJ_mem->ia_tstopIDAFcall)
+      IDASetStopTime(IDA_mem, IDAADJ_mem->ia_tstopIDAF);
+
+    nfree = IDAADJ_mem->ia_nslots - (IDAADJ_mem->ia_nckpnts + 1);
+
+    if ( (blkB == blk) || (nfree <= 0) ) {
+
+      /* Advance to block blkB and store its interpolation data */
+      flag = IDAAadvance(IDA_mem, blkB*IDAADJ_mem->ia_nsteps);
+      if (flag != IDA_SUCCESS) return(flag);
+
+      t1 = (blkB+1 < blkE) ? IDAADJ_mem->ia_tblk[blkB+1] : ck_mem->ck_t1;
+
+      flag = IDAAdataRecord(IDA_mem, IDAADJ_mem->ia_tblk[blkB], t1);
+      if (flag != IDA_SUCCESS) return(flag);
+
+      IDAADJ_mem->ia_ckpntData = ck_mem;
+      IDAADJ_mem->ia_ckpntBlk  = blkB;
+
+      break;
+    }
+
+    /* Advance by the optimal number of blocks, take a check point, and
+       insert it in the list after ck_mem */
+    k = IDAArevolveSplit(blkB - blk + 1, nfree + 1);
+
+    flag = IDAAadvance(IDA_mem, (blk + k)*IDAADJ_mem->ia_nsteps);
+    if (flag != IDA_SUCCESS) return(flag);
+
+    tmp = IDAAckpntNew(IDA_mem);
+    if (tmp == NULL) return(IDA_MEM_FAIL);
+
+    tmp->ck_temp  = SUNTRUE;
+    tmp->ck_t1    = ck_mem->ck_t1;
+    ck_mem->ck_t1 = tmp->ck_t0;
+    tmp->ck_next  = ck_mem;
+    *ck_link      = tmp;
+    IDAADJ_mem->ia_nckpnts++;
+
+    ck_mem = tmp;
+  }
+
+  *ck_memPtr = ck_mem;
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDAArevolveSplit
+ *
+ * This routine returns the number of blocks to advance before taking
+ * a check point when reversing m > 1 blocks with s > 1 check points
+ * (including the one at the start), minimizing the total number of
+ * blocks recomputed (Griewank and Walther, ACM TOMS 26(1), 2000).
+ */
+
+static long int IDAArevolveSplit(long int m, long int s)
+{
+  long int reps, range, bino1, bino2, bino3, bino4, bino5, k;
+
+  /* Find the number of repetitions needed, range = (s+reps)!/(s! reps!) */
+  reps  = 0;
+  range = 1;
+  while (range < m) {
+    reps++;
+    range = range*(reps + s)/reps;
+  }
+
+  bino1 = range*reps/(s + reps);
+  bino2 = (s > 1) ? bino1*s/(s + reps - 1) : 1;
+  if (s == 1) bino3 = 0;
+  else        bino3 = (s > 2) ? bino2*(s - 1)/(s + reps - 2) : 1;
+  bino4 = bino2*(reps - 1)/s;
+  if (s < 3)  bino5 = 0;
+  else        bino5 = (s > 3) ? bino3*(s - 2)/reps : 1;
+
+  if (m <= bino1 + bino3)       k = bino4;
+  else if (m >= range - bino5)  k = bino1;
+  else                          k = m - bino2 - bino3;
+
+  return(SUNMAX(k, 1));
+}
+
 /*
  * CVAckpntGet
  *
@@ -2274,26 +2781,32 @@ static int IDAAckpntGet(IDAMem IDA_mem, IDAckpntMem ck_mem)
     IDA_mem->ida_ssS       = ck_mem->ck_ssS;
 
 
-    /* Copy the arrays from check point data structure */
-    for (j=0; j<ck_mem->ck_phi_alloc; j++)
-      N_VScale(ONE, ck_mem->ck_phi[j], IDA_mem->ida_phi[j]);
-
-    if(ck_mem->ck_quadr) {
+    /* Copy the arrays from the checkpoint store or the check point
+       data structure */
+    if (ck_mem->ck_store != NULL) {
+      flag = IDAAckpntLoad(IDA_mem, ck_mem);
+      if (flag != IDA_SUCCESS) return(flag);
+    } else {
       for (j=0; j<ck_mem->ck_phi_alloc; j++)
-        N_VScale(ONE, ck_mem->ck_phiQ[j], IDA_mem->ida_phiQ[j]);
-    }
+        N_VScale(ONE, ck_mem->ck_phi[j], IDA_mem->ida_phi[j]);
 
-    if (ck_mem->ck_sensi) {
-      for (is=0; is<IDA_mem->ida_Ns; is++) {
+      if(ck_mem->ck_quadr) {
         for (j=0; j<ck_mem->ck_phi_alloc; j++)
-          N_VScale(ONE, ck_mem->ck_phiS[j][is], IDA_mem->ida_phiS[j][is]);
+          N_VScale(ONE, ck_mem->ck_phiQ[j], IDA_mem->ida_phiQ[j]);
       }
-    }
 
-    if (ck_mem->ck_quadr_sensi) {
-      for (is=0; is<IDA_mem->ida_Ns; is++) {
-        for (j=0; j<ck_mem->ck_phi_alloc; j++)
-          N_VScale(ONE, ck_mem->ck_phiQS[j][is], IDA_mem->ida_phiQS[j][is]);
+      if (ck_mem->ck_sensi) {
+        for (is=0; is<IDA_mem->ida_Ns; is++) {
+          for (j=0; j<ck_mem->ck_phi_alloc; j++)
+            N_VScale(ONE, ck_mem->ck_phiS[j][is], IDA_mem->ida_phiS[j][is]);
+        }
+      }
+
+      if (ck_mem->ck_quadr_sensi) {
+        for (is=0; is<IDA_mem->ida_Ns; is++) {
+          for (j=0; j<ck_mem->ck_phi_alloc; j++)
+            N_VScale(ONE, ck_mem->ck_phiQS[j][is], IDA_mem->ida_phiQS[j][is]);
+        }
       }
     }
 
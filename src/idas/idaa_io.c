@@ -39,6 +39,7 @@
  * =================================================================
  */
 
+#define ZERO        RCONST(0.0)
 #define ONE         RCONST(1.0) 
 
 /* 
@@ -79,6 +80,101 @@ int IDAAdjSetNoSensi(void *ida_mem)
   return(IDA_SUCCESS);
 }
 
+/*
+ * -----------------------------------------------------------------
+ * IDAAdjSetCheckpointStore
+ * -----------------------------------------------------------------
+ * Keeps the phi arrays of the check points in a checkpoint store
+ * instead of N_Vectors. A NULL store restores the default.
+ * -----------------------------------------------------------------
+ */
+
+int IDAAdjSetCheckpointStore(void *ida_mem, SUNCheckpointStore store)
+{
+  IDAMem IDA_mem;
+  IDAadjMem IDAADJ_mem;
+  N_Vector v;
+
+  /* Is ida_mem valid? */
+  if (ida_mem == NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDAA", "IDAAdjSetCheckpointStore", MSGAM_NULL_IDAMEM);
+    return IDA_MEM_NULL;
+  }
+  IDA_mem = (IDAMem) ida_mem;
+
+  /* Is ASA initialized? */
+  if (IDA_mem->ida_adjMallocDone == SUNFALSE) {
+    IDAProcessError(IDA_mem, IDA_NO_ADJ, "IDAA", "IDAAdjSetCheckpointStore",  MSGAM_NO_ADJ);
+    return(IDA_NO_ADJ);
+  }
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  /* Check points may not change storage once IDASolveF was called */
+  if (!IDAADJ_mem->ia_firstIDAFcall) {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDAA", "IDAAdjSetCheckpointStore", MSGAM_CKSTORE_LATE);
+    return(IDA_ILL_INPUT);
+  }
+
+  /* The check point data is packed with the N_Vector buffer operations */
+  v = IDA_mem->ida_tempv1;
+  if (store != NULL &&
+      (v->ops->nvbufsize == NULL || v->ops->nvbufpack == NULL ||
+       v->ops->nvbufunpack == NULL)) {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDAA", "IDAAdjSetCheckpointStore", MSGAM_CKSTORE_VEC);
+    return(IDA_ILL_INPUT);
+  }
+
+  IDAADJ_mem->ia_ckstore = store;
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * IDAAdjSetCheckpointSlots
+ * -----------------------------------------------------------------
+ * Limits the number of check points kept at any time to nslots and
+ * enables binomial checkpointing. nslots = 0 restores the default,
+ * where a check point is kept every nsteps steps.
+ * -----------------------------------------------------------------
+ */
+
+int IDAAdjSetCheckpointSlots(void *ida_mem, int nslots)
+{
+  IDAMem IDA_mem;
+  IDAadjMem IDAADJ_mem;
+
+  /* Is ida_mem valid? */
+  if (ida_mem == NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDAA", "IDAAdjSetCheckpointSlots", MSGAM_NULL_IDAMEM);
+    return IDA_MEM_NULL;
+  }
+  IDA_mem = (IDAMem) ida_mem;
+
+  /* Is ASA initialized? */
+  if (IDA_mem->ida_adjMallocDone == SUNFALSE) {
+    IDAProcessError(IDA_mem, IDA_NO_ADJ, "IDAA", "IDAAdjSetCheckpointSlots",  MSGAM_NO_ADJ);
+    return(IDA_NO_ADJ);
+  }
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  /* The check point schedule may not change once IDASolveF was called */
+  if (!IDAADJ_mem->ia_firstIDAFcall) {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDAA", "IDAAdjSetCheckpointSlots", MSGAM_NSLOTS_LATE);
+    return(IDA_ILL_INPUT);
+  }
+
+  /* The first check point and the latest one are always kept */
+  if ( (nslots < 0) || (nslots == 1) ) {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDAA", "IDAAdjSetCheckpointSlots", MSGAM_BAD_NSLOTS);
+    return(IDA_ILL_INPUT);
+  }
+
+  IDAADJ_mem->ia_nslots = nslots;
+
+  return(IDA_SUCCESS);
+}
+
 /* 
  * -----------------------------------------------------------------
  * Optional input functions for backward integration
@@ -641,6 +737,70 @@ int IDAGetConsistentICB(void *ida_mem, int which, N_Vector yyB0_mod, N_Vector yp
 }
 
 
+/*
+ * IDAGetAdjNumRecomputedSteps
+ *
+ * Returns the number of forward steps recomputed by IDASolveB.
+ */
+
+int IDAGetAdjNumRecomputedSteps(void *ida_mem, long int *nstR)
+{
+  IDAMem IDA_mem;
+  IDAadjMem IDAADJ_mem;
+
+  /* Is ida_mem valid? */
+  if (ida_mem == NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDAA", "IDAGetAdjNumRecomputedSteps", MSGAM_NULL_IDAMEM);
+    return IDA_MEM_NULL;
+  }
+  IDA_mem = (IDAMem) ida_mem;
+
+  /* Is ASA initialized? */
+  if (IDA_mem->ida_adjMallocDone == SUNFALSE) {
+    IDAProcessError(IDA_mem, IDA_NO_ADJ, "IDAA", "IDAGetAdjNumRecomputedSteps",  MSGAM_NO_ADJ);
+    return(IDA_NO_ADJ);
+  }
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  *nstR = IDAADJ_mem->ia_nstR;
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDAGetAdjRecomputationRatio
+ *
+ * Returns the ratio of the number of forward steps recomputed by
+ * IDASolveB to the number of steps taken by IDASolveF.
+ */
+
+int IDAGetAdjRecomputationRatio(void *ida_mem, realtype *ratio)
+{
+  IDAMem IDA_mem;
+  IDAadjMem IDAADJ_mem;
+
+  /* Is ida_mem valid? */
+  if (ida_mem == NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDAA", "IDAGetAdjRecomputationRatio", MSGAM_NULL_IDAMEM);
+    return IDA_MEM_NULL;
+  }
+  IDA_mem = (IDAMem) ida_mem;
+
+  /* Is ASA initialized? */
+  if (IDA_mem->ida_adjMallocDone == SUNFALSE) {
+    IDAProcessError(IDA_mem, IDA_NO_ADJ, "IDAA", "IDAGetAdjRecomputationRatio",  MSGAM_NO_ADJ);
+    return(IDA_NO_ADJ);
+  }
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  if (IDAADJ_mem->ia_nstF > 0)
+    *ratio = (realtype) IDAADJ_mem->ia_nstR / (realtype) IDAADJ_mem->ia_nstF;
+  else
+    *ratio = ZERO;
+
+  return(IDA_SUCCESS);
+}
+
 /*
  * -----------------------------------------------------------------
  * Undocumented development user-callable functions
@@ -645,6 +645,15 @@ struct IDAckpntMemRec {
   /* How many phi, phiS, phiQ and phiQS were allocated? */
   int          ck_phi_alloc;
 
+  /* Checkpoint store holding the phi arrays (NULL if they are kept in
+     the N_Vectors above), key and size of the stored data */
+  SUNCheckpointStore ck_store;
+  long int     ck_key;
+  size_t       ck_bytes;
+
+  /* Was this check point created by IDASolveB (binomial checkpointing)? */
+  booleantype  ck_temp;
+
   /* Pointer to next structure in list */
   struct IDAckpntMemRec *ck_next;
 };
@@ -803,6 +812,27 @@ struct IDAadjMemRec {
   /* address of the check point structure for which data is available */
   struct IDAckpntMemRec *ia_ckpntData;
 
+  /* Optional store for the check point phi arrays and a buffer used to
+     pack them */
+  SUNCheckpointStore ia_ckstore;
+  void *ia_ckbuf;
+  size_t ia_ckbufsize;
+  long int ia_ckkey;
+
+  /* Binomial checkpointing: number of check point slots (0 if all check
+     points are kept), spacing of the check points kept by IDASolveF (in
+     blocks of nsteps steps), start times of the blocks, and block of
+     the data available in dt_mem */
+  int ia_nslots;
+  long int ia_ckspace;
+  realtype *ia_tblk;
+  long int ia_tblkalloc;
+  long int ia_ckpntBlk;
+
+  /* Number of steps taken by IDASolveF and recomputed by IDASolveB */
+  long int ia_nstF;
+  long int ia_nstR;
+
   /* Number of checkpoints. */
   int ia_nckpnts;
 
@@ -1197,6 +1227,11 @@ int IDASensResDQ(int Ns, realtype t,
 #define MSGAM_WRONG_INTERP "This function cannot be called for the specified interp type."
 #define MSGAM_MEM_FAIL     "A memory request failed."
 #define MSGAM_NO_INITBS    "Illegal attempt to call before calling IDAInitBS."
+#define MSGAM_CKSTORE_LATE "The checkpoint store must be set before the first call to IDASolveF."
+#define MSGAM_CKSTORE_VEC  "The N_Vector does not provide the buffer operations needed by a checkpoint store."
+#define MSGAM_CKSTORE_FAIL "Storing or loading check point data failed."
+#define MSGAM_BAD_NSLOTS   "The number of check point slots must be 0 or at least 2."
+#define MSGAM_NSLOTS_LATE  "The number of check point slots must be set before the first call to IDASolveF."
 
 #ifdef __cplusplus
 }
@@ -16,7 +16,9 @@
  * This file contains implementations of routines for a
  * band-block-diagonal preconditioner, i.e. a block-diagonal
  * matrix with banded blocks, for use with KINSol and the
- * KINLS linear solver interface.
+ * KINLS linear solver interface. The sparse variant keeps sparse
+ * local blocks computed by colored difference quotients, split in
+ * sub-blocks that are factored and solved independently.
  *
  * Note: With only one process, a banded matrix results
  * rather than a b-b-d matrix with banded blocks. Diagonal
@@ -45,13 +47,26 @@ static int KINBBDPrecSolve(N_Vector uu, N_Vector uscale,
                            N_Vector fval, N_Vector fscale,
                            N_Vector vv, void *pdata);
 
-/* Prototype for KINBBDPrecFree */
+/* Prototypes of functions KINBBDSparsePrecSetup and KINBBDSparsePrecSolve */
+static int KINBBDSparsePrecSetup(N_Vector uu, N_Vector uscale,
+                                 N_Vector fval, N_Vector fscale,
+                                 void *pdata);
+
+static int KINBBDSparsePrecSolve(N_Vector uu, N_Vector uscale,
+                                 N_Vector fval, N_Vector fscale,
+                                 N_Vector vv, void *pdata);
+
+/* Prototypes for KINBBDPrecFree and KINBBDPrecFreeData */
 static int KINBBDPrecFree(KINMem kin_mem);
+static void KINBBDPrecFreeData(KBBDPrecData pdata);
 
 /* Prototype for difference quotient jacobian calculation routine */
 static int KBBDDQJac(KBBDPrecData pdata,
                      N_Vector uu, N_Vector uscale,
                      N_Vector gu, N_Vector gtemp, N_Vector utemp);
+static int KBBDSparseDQJac(KBBDPrecData pdata,
+                           N_Vector uu, N_Vector uscale,
+                           N_Vector gu, N_Vector gtemp, N_Vector utemp);
 
 /*------------------------------------------------------------------
   user-callable functions
@@ -116,6 +131,17 @@ int KINBBDPrecInit(void *kinmem, sunindextype Nlocal,
   pdata->mukeep = muk;
   pdata->mlkeep = mlk;
 
+  /* The local block is banded */
+  pdata->sparse = SUNFALSE;
+  pdata->nsub   = 0;
+  pdata->suboff = NULL;
+  pdata->colors = NULL;
+  pdata->dqinc  = NULL;
+  pdata->subP   = NULL;
+  pdata->subLS  = NULL;
+  pdata->zsub   = NULL;
+  pdata->rsub   = NULL;
+
   /* Set extended upper half-bandwidth for PP (required for pivoting) */
   storage_mu = SUNMIN(Nlocal-1, muk+mlk);
 
@@ -276,6 +302,214 @@ int KINBBDPrecInit(void *kinmem, sunindextype Nlocal,
 }
 
 
+/*------------------------------------------------------------------
+  KINBBDPrecInitSparse
+  ------------------------------------------------------------------*/
+int KINBBDPrecInitSparse(void *kinmem, sunindextype Nlocal,
+                         SUNMatrix Jpattern, int nsub,
+                         KINBBDLinSolFn lsfn, realtype dq_rel_uu,
+                         KINBBDLocalFn gloc, KINBBDCommFn gcomm)
+{
+  KINMem kin_mem;
+  KINLsMem kinls_mem;
+  KBBDPrecData pdata;
+  sunindextype lrw1, liw1, ncolors;
+  long int lrw, liw;
+  int b, flag;
+
+  if (kinmem == NULL) {
+    KINProcessError(NULL, KINLS_MEM_NULL, "KINBBDPRE",
+                    "KINBBDPrecInitSparse", MSGBBD_MEM_NULL);
+    return(KINLS_MEM_NULL);
+  }
+  kin_mem = (KINMem) kinmem;
+
+  /* Test if the LS linear solver interface has been created */
+  if (kin_mem->kin_lmem == NULL) {
+    KINProcessError(kin_mem, KINLS_LMEM_NULL, "KINBBDPRE",
+                    "KINBBDPrecInitSparse", MSGBBD_LMEM_NULL);
+    return(KINLS_LMEM_NULL);
+  }
+  kinls_mem = (KINLsMem) kin_mem->kin_lmem;
+
+  /* Test compatibility of NVECTOR package with the BBD preconditioner */
+  if (kin_mem->kin_vtemp1->ops->nvgetarraypointer == NULL) {
+    KINProcessError(kin_mem, KINLS_ILL_INPUT, "KINBBDPRE",
+                    "KINBBDPrecInitSparse", MSGBBD_BAD_NVECTOR);
+    return(KINLS_ILL_INPUT);
+  }
+
+  /* Test the pattern of the local block */
+  if ( (Nlocal < 1) || (Jpattern == NULL) ||
+       (SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(Jpattern) != Nlocal) ||
+       (SUNSparseMatrix_Columns(Jpattern) != Nlocal) ) {
+    KINProcessError(kin_mem, KINLS_ILL_INPUT, "KINBBDPRE",
+                    "KINBBDPrecInitSparse", MSGBBD_BAD_MATRIX);
+    return(KINLS_ILL_INPUT);
+  }
+
+  /* By default the local block is not split */
+  if (nsub < 1) nsub = 1;
+  if (nsub > Nlocal) nsub = (int) Nlocal;
+
+  /* Allocate data memory */
+  pdata = NULL;
+  pdata = (KBBDPrecData) malloc(sizeof *pdata);
+  if (pdata == NULL) {
+    KINProcessError(kin_mem, KINLS_MEM_FAIL,
+                    "KINBBDPRE", "KINBBDPrecInitSparse", MSGBBD_MEM_FAIL);
+    return(KINLS_MEM_FAIL);
+  }
+
+  /* Set pointers to gloc and gcomm, the banded data is not used */
+  pdata->kin_mem = kinmem;
+  pdata->gloc = gloc;
+  pdata->gcomm = gcomm;
+  pdata->mudq = pdata->mldq = pdata->mukeep = pdata->mlkeep = 0;
+  pdata->PP = NULL;
+  pdata->LS = NULL;
+  pdata->rlocal = NULL;
+  pdata->n_local = Nlocal;
+
+  /* Allocate the sub-block arrays */
+  pdata->sparse = SUNTRUE;
+  pdata->nsub   = nsub;
+  pdata->suboff = (sunindextype *) malloc((nsub+1)*sizeof(sunindextype));
+  pdata->colors = (sunindextype *) malloc(Nlocal*sizeof(sunindextype));
+  pdata->dqinc  = (realtype *) malloc(Nlocal*sizeof(realtype));
+  pdata->subP   = (SUNMatrix *) calloc(nsub, sizeof(SUNMatrix));
+  pdata->subLS  = (SUNLinearSolver *) calloc(nsub, sizeof(SUNLinearSolver));
+  pdata->zsub   = (N_Vector *) calloc(nsub, sizeof(N_Vector));
+  pdata->rsub   = (N_Vector *) calloc(nsub, sizeof(N_Vector));
+  pdata->zlocal = N_VNew_Serial(Nlocal, kin_mem->kin_sunctx);
+  pdata->tempv1 = N_VClone(kin_mem->kin_vtemp1);
+  pdata->tempv2 = N_VClone(kin_mem->kin_vtemp1);
+  pdata->tempv3 = N_VClone(kin_mem->kin_vtemp1);
+  if ( (pdata->suboff == NULL) || (pdata->colors == NULL) ||
+       (pdata->dqinc == NULL) || (pdata->subP == NULL) ||
+       (pdata->subLS == NULL) || (pdata->zsub == NULL) ||
+       (pdata->rsub == NULL) || (pdata->zlocal == NULL) ||
+       (pdata->tempv1 == NULL) || (pdata->tempv2 == NULL) ||
+       (pdata->tempv3 == NULL) ) {
+    KINBBDPrecFreeData(pdata);
+    KINProcessError(kin_mem, KINLS_MEM_FAIL, "KINBBDPRE",
+                    "KINBBDPrecInitSparse", MSGBBD_MEM_FAIL);
+    return(KINLS_MEM_FAIL);
+  }
+
+  /* Split the local block in sub-blocks of contiguous rows, the entries
+     coupling different sub-blocks are dropped */
+  for (b=0; b<=nsub; b++)
+    pdata->suboff[b] = (b*Nlocal)/nsub;
+
+  flag = SUNSparseMatrix_DiagonalBlocks(Jpattern, nsub, pdata->suboff,
+                                        pdata->subP);
+  if (flag != SUNMAT_SUCCESS) {
+    KINBBDPrecFreeData(pdata);
+    KINProcessError(kin_mem, KINLS_SUNMAT_FAIL, "KINBBDPRE",
+                    "KINBBDPrecInitSparse", MSGBBD_SPMAT_FAIL);
+    return(KINLS_SUNMAT_FAIL);
+  }
+
+  /* Color the columns of each sub-block, the rows of different sub-blocks
+     are disjoint so they may share colors */
+  pdata->ncolors = 0;
+  for (b=0; b<nsub; b++) {
+    flag = SUNSparseMatrix_ColorColumns(pdata->subP[b],
+                                        pdata->colors + pdata->suboff[b],
+                                        &ncolors);
+    if (flag != SUNMAT_SUCCESS) {
+      KINBBDPrecFreeData(pdata);
+      KINProcessError(kin_mem, KINLS_SUNMAT_FAIL, "KINBBDPRE",
+                      "KINBBDPrecInitSparse", MSGBBD_SPMAT_FAIL);
+      return(KINLS_SUNMAT_FAIL);
+    }
+    pdata->ncolors = SUNMAX(pdata->ncolors, ncolors);
+  }
+
+  /* Create the local vectors and linear solver of each sub-block */
+  for (b=0; b<nsub; b++) {
+    pdata->zsub[b] = N_VNewEmpty_Serial(pdata->suboff[b+1] - pdata->suboff[b],
+                                        kin_mem->kin_sunctx);
+    pdata->rsub[b] = N_VNewEmpty_Serial(pdata->suboff[b+1] - pdata->suboff[b],
+                                        kin_mem->kin_sunctx);
+    if ( (pdata->zsub[b] == NULL) || (pdata->rsub[b] == NULL) ) {
+      KINBBDPrecFreeData(pdata);
+      KINProcessError(kin_mem, KINLS_MEM_FAIL, "KINBBDPRE",
+                      "KINBBDPrecInitSparse", MSGBBD_MEM_FAIL);
+      return(KINLS_MEM_FAIL);
+    }
+
+    if (lsfn != NULL)
+      pdata->subLS[b] = lsfn(pdata->rsub[b], pdata->subP[b],
+                             kin_mem->kin_sunctx);
+    else
+      pdata->subLS[b] = SUNLinSol_ILU(pdata->rsub[b], pdata->subP[b], 0,
+                                      kin_mem->kin_sunctx);
+    if (pdata->subLS[b] == NULL) {
+      KINBBDPrecFreeData(pdata);
+      KINProcessError(kin_mem, KINLS_MEM_FAIL, "KINBBDPRE",
+                      "KINBBDPrecInitSparse", MSGBBD_MEM_FAIL);
+      return(KINLS_MEM_FAIL);
+    }
+    flag = SUNLinSolInitialize(pdata->subLS[b]);
+    if (flag != SUNLS_SUCCESS) {
+      KINBBDPrecFreeData(pdata);
+      KINProcessError(kin_mem, KINLS_SUNLS_FAIL, "KINBBDPRE",
+                      "KINBBDPrecInitSparse", MSGBBD_SPLS_FAIL);
+      return(KINLS_SUNLS_FAIL);
+    }
+  }
+
+  /* Set rel_uu based on input value dq_rel_uu (0 implies default) */
+  pdata->rel_uu = (dq_rel_uu > ZERO) ? dq_rel_uu : SUNRsqrt(kin_mem->kin_uround);
+
+  /* Set work space sizes and initialize nge */
+  pdata->rpwsize = Nlocal;
+  pdata->ipwsize = Nlocal + nsub + 1;
+  if (kin_mem->kin_vtemp1->ops->nvspace) {
+    N_VSpace(kin_mem->kin_vtemp1, &lrw1, &liw1);
+    pdata->rpwsize += 3*lrw1;
+    pdata->ipwsize += 3*liw1;
+  }
+  if (pdata->zlocal->ops->nvspace) {
+    N_VSpace(pdata->zlocal, &lrw1, &liw1);
+    pdata->rpwsize += lrw1;
+    pdata->ipwsize += liw1;
+  }
+  for (b=0; b<nsub; b++) {
+    if (pdata->subP[b]->ops->space) {
+      flag = SUNMatSpace(pdata->subP[b], &lrw, &liw);
+      pdata->rpwsize += lrw;
+      pdata->ipwsize += liw;
+    }
+    if (pdata->subLS[b]->ops->space) {
+      flag = SUNLinSolSpace(pdata->subLS[b], &lrw, &liw);
+      pdata->rpwsize += lrw;
+      pdata->ipwsize += liw;
+    }
+  }
+  pdata->nge = 0;
+
+  /* make sure pdata is free from any previous allocations */
+  if (kinls_mem->pfree != NULL)
+    kinls_mem->pfree(kin_mem);
+
+  /* Point to the new pdata field in the LS memory */
+  kinls_mem->pdata = pdata;
+
+  /* Attach the pfree function */
+  kinls_mem->pfree = KINBBDPrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = KINSetPreconditioner(kinmem, KINBBDSparsePrecSetup,
+                              KINBBDSparsePrecSolve);
+
+  return(flag);
+}
+
+
 /*------------------------------------------------------------------
   KINBBDPrecGetWorkSpace
   ------------------------------------------------------------------*/
@@ -487,6 +721,38 @@ static int KINBBDPrecFree(KINMem kin_mem)
   if (kinls_mem->pdata == NULL) return(0);
   pdata = (KBBDPrecData) kinls_mem->pdata;
 
+  KINBBDPrecFreeData(pdata);
+  pdata = NULL;
+
+  return(0);
+}
+
+
+/*------------------------------------------------------------------
+  KINBBDPrecFreeData
+
+  Frees the preconditioner data of either kind of local block.
+  ------------------------------------------------------------------*/
+static void KINBBDPrecFreeData(KBBDPrecData pdata)
+{
+  int b;
+
+  if (pdata->sparse) {
+    for (b=0; b<pdata->nsub; b++) {
+      if (pdata->subLS) SUNLinSolFree(pdata->subLS[b]);
+      if (pdata->subP)  SUNMatDestroy(pdata->subP[b]);
+      if (pdata->zsub)  N_VDestroy(pdata->zsub[b]);
+      if (pdata->rsub)  N_VDestroy(pdata->rsub[b]);
+    }
+    free(pdata->suboff);
+    free(pdata->colors);
+    free(pdata->dqinc);
+    free(pdata->subLS);
+    free(pdata->subP);
+    free(pdata->zsub);
+    free(pdata->rsub);
+  }
+
   SUNLinSolFree(pdata->LS);
   N_VDestroy(pdata->zlocal);
   N_VDestroy(pdata->rlocal);
@@ -496,11 +762,103 @@ static int KINBBDPrecFree(KINMem kin_mem)
   SUNMatDestroy(pdata->PP);
 
   free(pdata);
-  pdata = NULL;
+}
 
-  return(0);
+
+/*------------------------------------------------------------------
+  KINBBDSparsePrecSetup
+
+  KINBBDSparsePrecSetup is the setup routine of the preconditioner
+  created by KINBBDPrecInitSparse. It computes the sub-blocks of
+  the local block of the Jacobian by colored difference quotients
+  and factors each of them with its linear solver.
+
+  The parameters and return values are the same as for
+  KINBBDPrecSetup.
+  ------------------------------------------------------------------*/
+static int KINBBDSparsePrecSetup(N_Vector uu, N_Vector uscale,
+                                 N_Vector fval, N_Vector fscale,
+                                 void *bbd_data)
+{
+  KBBDPrecData pdata;
+  KINMem kin_mem;
+  int b, retval, lsneg, lspos;
+
+  pdata = (KBBDPrecData) bbd_data;
+
+  kin_mem = (KINMem) pdata->kin_mem;
+
+  /* Call KBBDSparseDQJac for a new Jacobian calculation in subP */
+  retval = KBBDSparseDQJac(pdata, uu, uscale,
+                           pdata->tempv1, pdata->tempv2, pdata->tempv3);
+  if (retval != 0) {
+    KINProcessError(kin_mem, -1, "KINBBDPRE", "KINBBDSparsePrecSetup",
+                    MSGBBD_FUNC_FAILED);
+    return(-1);
+  }
+
+  /* Factor each sub-block */
+  lsneg = 0;
+  lspos = 0;
+  for (b=0; b<pdata->nsub; b++) {
+    retval = SUNLinSolSetup(pdata->subLS[b], pdata->subP[b]);
+    if (retval < 0) lsneg = SUNMIN(lsneg, retval);
+    if (retval > 0) lspos = SUNMAX(lspos, retval);
+  }
+
+  /* Return an unrecoverable failure first, then a recoverable one */
+  return((lsneg < 0) ? lsneg : lspos);
 }
 
+/*------------------------------------------------------------------
+  KINBBDSparsePrecSolve
+
+  KINBBDSparsePrecSolve solves a linear system P z = r, with the
+  block-diagonal preconditioner matrix P generated by
+  KINBBDSparsePrecSetup. The sub-block systems are solved one
+  after the other into zlocal, which is then copied into vv.
+  ------------------------------------------------------------------*/
+static int KINBBDSparsePrecSolve(N_Vector uu, N_Vector uscale,
+                                 N_Vector fval, N_Vector fscale,
+                                 N_Vector vv, void *bbd_data)
+{
+  KBBDPrecData pdata;
+  realtype *vd;
+  realtype *zd;
+  sunindextype i;
+  int b, retval, lsneg, lspos;
+
+  pdata = (KBBDPrecData) bbd_data;
+
+  /* Get data pointers */
+  vd = N_VGetArrayPointer(vv);
+  zd = N_VGetArrayPointer(pdata->zlocal);
+
+  lsneg = 0;
+  lspos = 0;
+  for (b=0; b<pdata->nsub; b++) {
+    /* Attach the sub-block data of vv and zlocal to rsub and zsub */
+    N_VSetArrayPointer(vd + pdata->suboff[b], pdata->rsub[b]);
+    N_VSetArrayPointer(zd + pdata->suboff[b], pdata->zsub[b]);
+
+    retval = SUNLinSolSolve(pdata->subLS[b], pdata->subP[b],
+                            pdata->zsub[b], pdata->rsub[b], ZERO);
+    if (retval < 0) lsneg = SUNMIN(lsneg, retval);
+    if (retval > 0) lspos = SUNMAX(lspos, retval);
+
+    /* Detach the sub-block data */
+    N_VSetArrayPointer(NULL, pdata->rsub[b]);
+    N_VSetArrayPointer(NULL, pdata->zsub[b]);
+  }
+
+  /* Copy result into vv */
+  for (i=0; i<pdata->n_local; i++)
+    vd[i] = zd[i];
+
+  return((lsneg < 0) ? lsneg : lspos);
+}
+
+
 
 /*------------------------------------------------------------------
   KBBDDQJac
@@ -580,3 +938,97 @@ static int KBBDDQJac(KBBDPrecData pdata,
 
   return(0);
 }
+
+/*------------------------------------------------------------------
+  KBBDSparseDQJac
+
+  This routine generates a sparse difference quotient approximation
+  to the sub-blocks of the local block of the Jacobian of f(u). The
+  columns of the sub-blocks are colored so that columns of one color
+  do not share any rows, and all u_j of a color are perturbed
+  together. The number of calls to gloc is therefore the number of
+  colors plus one, independently of the bandwidth of the block.
+  ------------------------------------------------------------------*/
+static int KBBDSparseDQJac(KBBDPrecData pdata,
+                           N_Vector uu, N_Vector uscale,
+                           N_Vector gu, N_Vector gtemp, N_Vector utemp)
+{
+  KINMem kin_mem;
+  int retval;
+  sunindextype color, b, i, j, p, s, nb;
+  sunindextype *colors, *Pp, *Pi;
+  realtype *udata, *uscdata, *gudata, *gtempdata, *utempdata;
+  realtype *incdata, *Pdata;
+
+  kin_mem = (KINMem) pdata->kin_mem;
+
+  /* load utemp with uu = predicted solution vector */
+  N_VScale(ONE, uu, utemp);
+
+  /* set pointers to the data for all vectors */
+  udata     = N_VGetArrayPointer(uu);
+  uscdata   = N_VGetArrayPointer(uscale);
+  gudata    = N_VGetArrayPointer(gu);
+  gtempdata = N_VGetArrayPointer(gtemp);
+  utempdata = N_VGetArrayPointer(utemp);
+  colors    = pdata->colors;
+  incdata   = pdata->dqinc;
+
+  /* Call gcomm and gloc to get base value of g(uu) */
+  if (pdata->gcomm != NULL) {
+    retval = pdata->gcomm(pdata->n_local, uu, kin_mem->kin_user_data);
+    if (retval != 0) return(retval);
+  }
+
+  retval = pdata->gloc(pdata->n_local, uu, gu, kin_mem->kin_user_data);
+  pdata->nge++;
+  if (retval != 0) return(retval);
+
+  /* Compute the increment of each component */
+  for (j = 0; j < pdata->n_local; j++)
+    incdata[j] = pdata->rel_uu * SUNMAX(SUNRabs(udata[j]), (ONE / uscdata[j]));
+
+  /* Loop over column colors */
+  for (color = 0; color < pdata->ncolors; color++) {
+
+    /* increment all u_j of this color */
+    for (j = 0; j < pdata->n_local; j++)
+      if (colors[j] == color) utempdata[j] += incdata[j];
+
+    /* Evaluate g with incremented u */
+    retval = pdata->gloc(pdata->n_local, utemp, gtemp, kin_mem->kin_user_data);
+    pdata->nge++;
+    if (retval != 0) return(retval);
+
+    /* restore utemp, then form and load difference quotients */
+    for (j = 0; j < pdata->n_local; j++)
+      if (colors[j] == color) utempdata[j] = udata[j];
+
+    for (b = 0; b < pdata->nsub; b++) {
+      s     = pdata->suboff[b];
+      nb    = pdata->suboff[b+1] - s;
+      Pp    = SUNSparseMatrix_IndexPointers(pdata->subP[b]);
+      Pi    = SUNSparseMatrix_IndexValues(pdata->subP[b]);
+      Pdata = SUNSparseMatrix_Data(pdata->subP[b]);
+      if (SUNSparseMatrix_SparseType(pdata->subP[b]) == CSC_MAT) {
+        for (j = 0; j < nb; j++) {
+          if (colors[s+j] != color) continue;
+          for (p = Pp[j]; p < Pp[j+1]; p++) {
+            i = s + Pi[p];
+            Pdata[p] = (gtempdata[i] - gudata[i]) / incdata[s+j];
+          }
+        }
+      } else {
+        for (i = 0; i < nb; i++) {
+          for (p = Pp[i]; p < Pp[i+1]; p++) {
+            j = s + Pi[p];
+            if (colors[j] == color)
+              Pdata[p] = (gtempdata[s+i] - gudata[s+i]) / incdata[j];
+          }
+        }
+      }
+    }
+  }
+
+  return(0);
+}
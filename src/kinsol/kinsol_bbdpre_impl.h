@@ -22,6 +22,8 @@
 #include <kinsol/kinsol_bbdpre.h>
 #include <sunmatrix/sunmatrix_band.h>
 #include <sunlinsol/sunlinsol_band.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+#include <sunlinsol/sunlinsol_ilu.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
 extern "C" {
@@ -50,6 +52,19 @@ typedef struct KBBDPrecDataRec {
   N_Vector tempv2;
   N_Vector tempv3;
 
+  /* set by KINBBDPrecInitSparse for a sparse local block split in nsub
+     diagonal sub-blocks starting at the rows suboff */
+  booleantype sparse;
+  int nsub;
+  sunindextype *suboff;
+  sunindextype *colors;
+  sunindextype ncolors;
+  realtype *dqinc;
+  SUNMatrix *subP;
+  SUNLinearSolver *subLS;
+  N_Vector *zsub;
+  N_Vector *rsub;
+
   /* available for optional output */
   long int rpwsize;
   long int ipwsize;
@@ -73,6 +88,9 @@ typedef struct KBBDPrecDataRec {
 #define MSGBBD_SUNMAT_FAIL "An error arose from a SUNBandMatrix routine."
 #define MSGBBD_SUNLS_FAIL  "An error arose from a SUNBandLinearSolver routine."
 #define MSGBBD_PMEM_NULL   "BBD peconditioner memory is NULL. IDABBDPrecInit must be called."
+#define MSGBBD_SPMAT_FAIL  "An error arose from a SUNSparseMatrix routine."
+#define MSGBBD_SPLS_FAIL   "An error arose from a local block linear solver."
+#define MSGBBD_BAD_MATRIX  "The local Jacobian pattern must be a square SUNMATRIX_SPARSE matrix of size Nlocal."
 #define MSGBBD_FUNC_FAILED "The gloc or gcomm routine failed in an unrecoverable manner."
 
 #ifdef __cplusplus
@@ -0,0 +1,421 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file contains implementations of the incomplete LU
+ * preconditioner and solver routines for use with the KINLS linear
+ * solver interface. The preconditioner is an ILU(k) factorization
+ * of the system Jacobian computed by a user-supplied sparse
+ * Jacobian function.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "kinsol_impl.h"
+#include "kinsol_ls_impl.h"
+#include "kinsol_ilupre_impl.h"
+#include <sundials/sundials_math.h>
+
+
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+
+/* Prototypes of functions KINILUPrecSetup and KINILUPrecSolve */
+static int KINILUPrecSetup(N_Vector uu, N_Vector uscale,
+                           N_Vector fval, N_Vector fscale,
+                           void *ilu_data);
+static int KINILUPrecSolve(N_Vector uu, N_Vector uscale,
+                           N_Vector fval, N_Vector fscale,
+                           N_Vector vv, void *ilu_data);
+
+/* Prototype for KINILUPrecFree */
+static int KINILUPrecFree(KINMem kinmem);
+
+/* Prototype for the shared access routine */
+static int KINILUPrecAccess(void *kinmem, const char *fname,
+                            KINMem *kin_mem, KILUPrecData *pdata);
+
+/*------------------------------------------------------------------
+  User-Callable Functions: initialization and optional output
+  ------------------------------------------------------------------*/
+int KINILUPrecInit(void *kinmem, SUNMatrix J, KINLsJacFn jac,
+                   int fill_level)
+{
+  KINMem kin_mem;
+  KINLsMem kinls_mem;
+  KILUPrecData pdata;
+  int flag;
+
+  if (kinmem == NULL) {
+    KINProcessError(NULL, KINLS_MEM_NULL, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_MEM_NULL);
+    return(KINLS_MEM_NULL);
+  }
+  kin_mem = (KINMem) kinmem;
+
+  /* Test if the LS linear solver interface has been created */
+  if (kin_mem->kin_lmem == NULL) {
+    KINProcessError(kin_mem, KINLS_LMEM_NULL, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_LMEM_NULL);
+    return(KINLS_LMEM_NULL);
+  }
+  kinls_mem = (KINLsMem) kin_mem->kin_lmem;
+
+  /* Test compatibility of NVECTOR package with the ILU preconditioner */
+  if(kin_mem->kin_vtemp1->ops->nvgetarraypointer == NULL) {
+    KINProcessError(kin_mem, KINLS_ILL_INPUT, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_BAD_NVECTOR);
+    return(KINLS_ILL_INPUT);
+  }
+
+  /* Test the Jacobian template, function and fill level */
+  if ( (J == NULL) || (SUNMatGetID(J) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(J) != SUNSparseMatrix_Columns(J)) ||
+       (SUNSparseMatrix_Rows(J) != N_VGetLength(kin_mem->kin_vtemp1)) ) {
+    KINProcessError(kin_mem, KINLS_ILL_INPUT, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_BAD_MATRIX);
+    return(KINLS_ILL_INPUT);
+  }
+  if (jac == NULL) {
+    KINProcessError(kin_mem, KINLS_ILL_INPUT, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_JAC_NULL);
+    return(KINLS_ILL_INPUT);
+  }
+  if (fill_level < 0) {
+    KINProcessError(kin_mem, KINLS_ILL_INPUT, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_BAD_FILL);
+    return(KINLS_ILL_INPUT);
+  }
+
+  /* Allocate data memory. */
+  pdata = NULL;
+  pdata = (KILUPrecData) malloc(sizeof *pdata);
+  if (pdata == NULL) {
+    KINProcessError(kin_mem, KINLS_MEM_FAIL, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_MEM_FAIL);
+    return(KINLS_MEM_FAIL);
+  }
+
+  /* Set pointers to jac and kinmem; initialize counters. */
+  pdata->kinmem = kin_mem;
+  pdata->jac     = jac;
+  pdata->nje     = 0;
+  pdata->nfact   = 0;
+
+  /* Allocate memory for the preconditioner matrix with the pattern of the
+     template. */
+  pdata->PP = NULL;
+  pdata->PP = SUNMatClone(J);
+  if (pdata->PP == NULL) {
+    free(pdata); pdata = NULL;
+    KINProcessError(kin_mem, KINLS_MEM_FAIL, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_MEM_FAIL);
+    return(KINLS_MEM_FAIL);
+  }
+
+  /* Allocate memory for temporary N_Vectors */
+  pdata->tempv1 = NULL;
+  pdata->tempv1 = N_VClone(kin_mem->kin_vtemp1);
+  pdata->tempv2 = NULL;
+  pdata->tempv2 = N_VClone(kin_mem->kin_vtemp1);
+  if ((pdata->tempv1 == NULL) || (pdata->tempv2 == NULL)) {
+    if (pdata->tempv1) N_VDestroy(pdata->tempv1);
+    if (pdata->tempv2) N_VDestroy(pdata->tempv2);
+    SUNMatDestroy(pdata->PP);
+    free(pdata); pdata = NULL;
+    KINProcessError(kin_mem, KINLS_MEM_FAIL, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_MEM_FAIL);
+    return(KINLS_MEM_FAIL);
+  }
+
+  /* Allocate memory for the ILU linear solver */
+  pdata->LS = NULL;
+  pdata->LS = SUNLinSol_ILU(kin_mem->kin_vtemp1, pdata->PP, fill_level,
+                            kin_mem->kin_sunctx);
+  if (pdata->LS == NULL) {
+    N_VDestroy(pdata->tempv1);
+    N_VDestroy(pdata->tempv2);
+    SUNMatDestroy(pdata->PP);
+    free(pdata); pdata = NULL;
+    KINProcessError(kin_mem, KINLS_MEM_FAIL, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_MEM_FAIL);
+    return(KINLS_MEM_FAIL);
+  }
+
+  /* initialize ILU linear solver object */
+  flag = SUNLinSolInitialize(pdata->LS);
+  if (flag != SUNLS_SUCCESS) {
+    N_VDestroy(pdata->tempv1);
+    N_VDestroy(pdata->tempv2);
+    SUNMatDestroy(pdata->PP);
+    SUNLinSolFree(pdata->LS);
+    free(pdata); pdata = NULL;
+    KINProcessError(kin_mem, KINLS_SUNLS_FAIL, "KINILUPRE",
+                    "KINILUPrecInit", MSGILU_SUNLS_FAIL);
+    return(KINLS_SUNLS_FAIL);
+  }
+
+  /* make sure pdata is free from any previous allocations */
+  if (kinls_mem->pfree)
+    kinls_mem->pfree(kin_mem);
+
+  /* Point to the new pdata field in the LS memory */
+  kinls_mem->pdata = pdata;
+
+  /* Attach the pfree function */
+  kinls_mem->pfree = KINILUPrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = KINSetPreconditioner(kinmem,
+                              KINILUPrecSetup,
+                              KINILUPrecSolve);
+
+  return(flag);
+}
+
+
+int KINILUPrecGetWorkSpace(void *kinmem,
+                           long int *lenrwILU,
+                           long int *leniwILU)
+{
+  KINMem kin_mem;
+  KILUPrecData pdata;
+  sunindextype lrw1, liw1;
+  long int lrw, liw;
+  int flag;
+
+  flag = KINILUPrecAccess(kinmem, "KINILUPrecGetWorkSpace",
+                          &kin_mem, &pdata);
+  if (flag != KINLS_SUCCESS) return(flag);
+
+  /* sum space requirements for all objects in pdata */
+  *leniwILU = 4;
+  *lenrwILU = 0;
+  if (kin_mem->kin_vtemp1->ops->nvspace) {
+    N_VSpace(kin_mem->kin_vtemp1, &lrw1, &liw1);
+    *leniwILU += 2*liw1;
+    *lenrwILU += 2*lrw1;
+  }
+  if (pdata->PP->ops->space) {
+    flag = SUNMatSpace(pdata->PP, &lrw, &liw);
+    if (flag != 0) return(-1);
+    *leniwILU += liw;
+    *lenrwILU += lrw;
+  }
+  if (pdata->LS->ops->space) {
+    flag = SUNLinSolSpace(pdata->LS, &lrw, &liw);
+    if (flag != 0) return(-1);
+    *leniwILU += liw;
+    *lenrwILU += lrw;
+  }
+
+  return(KINLS_SUCCESS);
+}
+
+
+int KINILUPrecGetNumJacEvals(void *kinmem, long int *njevalsILU)
+{
+  KINMem kin_mem;
+  KILUPrecData pdata;
+  int flag;
+
+  flag = KINILUPrecAccess(kinmem, "KINILUPrecGetNumJacEvals",
+                          &kin_mem, &pdata);
+  if (flag != KINLS_SUCCESS) return(flag);
+
+  *njevalsILU = pdata->nje;
+
+  return(KINLS_SUCCESS);
+}
+
+
+int KINILUPrecGetNumFactorizations(void *kinmem, long int *nfactILU)
+{
+  KINMem kin_mem;
+  KILUPrecData pdata;
+  int flag;
+
+  flag = KINILUPrecAccess(kinmem, "KINILUPrecGetNumFactorizations",
+                          &kin_mem, &pdata);
+  if (flag != KINLS_SUCCESS) return(flag);
+
+  *nfactILU = pdata->nfact;
+
+  return(KINLS_SUCCESS);
+}
+
+
+/*------------------------------------------------------------------
+  KINILUPrecSetup
+
+  KINILUPrecSetup generates an incomplete LU factorization of the
+  system Jacobian J = dF/du computed by the user-supplied Jacobian
+  function. The symbolic factorization is only recomputed when the
+  pattern of J changes.
+
+  The parameters of KINILUPrecSetup are as follows:
+
+  uu      is the current value of the dependent variable vector,
+          namely the solution to func(uu)=0
+
+  uscale  is the dependent variable scaling vector (i.e. uu)
+
+  fval    is the vector f(u)
+
+  fscale  is the function scaling vector
+
+  ilu_data is the pointer to ILU preconditioner data set by
+           KINILUPrecInit
+
+  Return value:
+  The value returned by this KINILUPrecSetup function is a int
+  flag indicating whether it was successful. This value is
+     0    if successful,
+   > 0    for a recoverable error, or
+   < 0    for a nonrecoverable error.
+  ------------------------------------------------------------------*/
+static int KINILUPrecSetup(N_Vector uu, N_Vector uscale,
+                           N_Vector fval, N_Vector fscale,
+                           void *ilu_data)
+{
+  KILUPrecData pdata;
+  KINMem kin_mem;
+  int retval;
+
+  pdata = (KILUPrecData) ilu_data;
+
+  kin_mem = (KINMem) pdata->kinmem;
+
+  /* Call the Jacobian function to load PP. */
+  retval = SUNMatZero(pdata->PP);
+  if (retval != 0) {
+    KINProcessError(kin_mem, -1, "KINILUPRE",
+                    "KINILUPrecSetup", MSGILU_SUNMAT_FAIL);
+    return(-1);
+  }
+
+  retval = pdata->jac(uu, fval, pdata->PP, kin_mem->kin_user_data,
+                      pdata->tempv1, pdata->tempv2);
+  pdata->nje++;
+  if (retval < 0) {
+    KINProcessError(kin_mem, -1, "KINILUPRE", "KINILUPrecSetup",
+                    MSGILU_FUNC_FAILED);
+    return(-1);
+  }
+  if (retval > 0) {
+    return(+1);
+  }
+
+  /* Do the ILU factorization of PP. */
+  retval = SUNLinSolSetup(pdata->LS, pdata->PP);
+  pdata->nfact++;
+
+  /* Return 0 if the LU was complete, or +1 otherwise. */
+  if (retval == SUNLS_SUCCESS) return(0);
+  return((retval == SUNLS_LUFACT_FAIL) ? 1 : -1);
+}
+
+
+/*------------------------------------------------------------------
+  KINILUPrecSolve
+
+  KINILUPrecSolve solves a linear system P z = r, with the
+  incomplete LU factors computed by KINILUPrecSetup.
+
+  The parameters of KINILUPrecSolve used here are as follows:
+
+  vv    contains the right-hand side vector r on input and the
+        computed solution z on output
+
+  ilu_data is the pointer to ILU preconditioner data set by
+           KINILUPrecInit
+
+  The arguments uu, uscale, fval and fscale are NOT used.
+
+  KINILUPrecSolve returns the value returned from the linear
+  solver object.
+  ------------------------------------------------------------------*/
+static int KINILUPrecSolve(N_Vector uu, N_Vector uscale,
+                           N_Vector fval, N_Vector fscale,
+                           N_Vector vv, void *ilu_data)
+{
+  KILUPrecData pdata;
+  int retval;
+
+  pdata = (KILUPrecData) ilu_data;
+
+  /* Call ILU solver object to do the work, the solver copies vv
+     before solving in place */
+  retval = SUNLinSolSolve(pdata->LS, pdata->PP, vv, vv, ZERO);
+  return(retval);
+}
+
+
+/*-------------------------------------------------------------*/
+static int KINILUPrecFree(KINMem kin_mem)
+{
+  KINLsMem kinls_mem;
+  KILUPrecData pdata;
+
+  if (kin_mem->kin_lmem == NULL) return(0);
+  kinls_mem = (KINLsMem) kin_mem->kin_lmem;
+
+  if (kinls_mem->pdata == NULL) return(0);
+  pdata = (KILUPrecData) kinls_mem->pdata;
+
+  SUNLinSolFree(pdata->LS);
+  N_VDestroy(pdata->tempv1);
+  N_VDestroy(pdata->tempv2);
+  SUNMatDestroy(pdata->PP);
+
+  free(pdata);
+  pdata = NULL;
+
+  return(0);
+}
+
+
+/*------------------------------------------------------------------
+  KINILUPrecAccess
+
+  This routine checks the integrator, linear solver and
+  preconditioner memory and returns pointers to them.
+  ------------------------------------------------------------------*/
+static int KINILUPrecAccess(void *kinmem, const char *fname,
+                            KINMem *kin_mem, KILUPrecData *pdata)
+{
+  KINLsMem kinls_mem;
+
+  if (kinmem == NULL) {
+    KINProcessError(NULL, KINLS_MEM_NULL, "KINILUPRE",
+                    fname, MSGILU_MEM_NULL);
+    return(KINLS_MEM_NULL);
+  }
+  *kin_mem = (KINMem) kinmem;
+
+  if ((*kin_mem)->kin_lmem == NULL) {
+    KINProcessError(*kin_mem, KINLS_LMEM_NULL, "KINILUPRE",
+                    fname, MSGILU_LMEM_NULL);
+    return(KINLS_LMEM_NULL);
+  }
+  kinls_mem = (KINLsMem) (*kin_mem)->kin_lmem;
+
+  if (kinls_mem->pdata == NULL) {
+    KINProcessError(*kin_mem, KINLS_PMEM_NULL, "KINILUPRE",
+                    fname, MSGILU_PMEM_NULL);
+    return(KINLS_PMEM_NULL);
+  }
+  *pdata = (KILUPrecData) kinls_mem->pdata;
+
+  return(KINLS_SUCCESS);
+}
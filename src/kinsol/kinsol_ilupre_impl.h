@@ -0,0 +1,77 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file (private version) for the KINILUPRE
+ * module, for an incomplete LU preconditioner for use with KINSOL.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _KINILUPRE_IMPL_H
+#define _KINILUPRE_IMPL_H
+
+#include <kinsol/kinsol_ilupre.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+#include <sunlinsol/sunlinsol_ilu.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------
+ * Definition of KILUPrecData
+ * -----------------------------------------------------------------
+ */
+
+typedef struct KILUPrecDataRec {
+
+  /* passed by user to KINILUPrecInit */
+  KINLsJacFn jac;
+
+  /* set by KINILUPrecSetup */
+  SUNMatrix PP;
+  SUNLinearSolver LS;
+  N_Vector tempv1;
+  N_Vector tempv2;
+
+  /* available for optional output */
+  long int nje;
+  long int nfact;
+
+  /* pointer to kinmem */
+  void *kinmem;
+
+} *KILUPrecData;
+
+/*
+ * -----------------------------------------------------------------
+ * KINILUPRE error messages
+ * -----------------------------------------------------------------
+ */
+
+#define MSGILU_MEM_NULL    "KINSOL Memory is NULL."
+#define MSGILU_LMEM_NULL   "Linear solver memory is NULL. One of the SPILS linear solvers must be attached."
+#define MSGILU_MEM_FAIL    "A memory request failed."
+#define MSGILU_BAD_NVECTOR "A required vector operation is not implemented."
+#define MSGILU_BAD_MATRIX  "The Jacobian template must be a square SUNMATRIX_SPARSE matrix matching the vector length."
+#define MSGILU_BAD_FILL    "The fill level must be nonnegative."
+#define MSGILU_JAC_NULL    "The Jacobian function is NULL."
+#define MSGILU_SUNMAT_FAIL "An error arose from a SUNSparseMatrix routine."
+#define MSGILU_SUNLS_FAIL  "An error arose from the SUNLinSol_ILU linear solver."
+#define MSGILU_PMEM_NULL   "ILU preconditioner memory is NULL. KINILUPrecInit must be called."
+#define MSGILU_FUNC_FAILED "The Jacobian routine failed in an unrecoverable manner."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -25,6 +25,7 @@
 
 #include <sundials/sundials_math.h>
 #include <sunmatrix/sunmatrix_band.h>
+#include <sunmatrix/sunmatrix_bsr.h>
 #include <sunmatrix/sunmatrix_dense.h>
 #include <sunmatrix/sunmatrix_sparse.h>
 
@@ -252,6 +253,111 @@ int KINSetJacFn(void *kinmem, KINLsJacFn jac)
 }
 
 
+/*------------------------------------------------------------------
+  KINSetJacSparsityPattern specifies the sparsity pattern used by
+  the internal difference quotient Jacobian approximation with a
+  sparse matrix. A copy of the pattern is stored and a column
+  coloring is computed so that the Jacobian can be approximated
+  with one function evaluation per color.
+  ------------------------------------------------------------------*/
+int KINSetJacSparsityPattern(void *kinmem, SUNMatrix P)
+{
+  KINMem       kin_mem;
+  KINLsMem     kinls_mem;
+  sunindextype N;
+  int          retval;
+
+  /* access KINLsMem structure */
+  retval = kinLs_AccessLMem(kinmem, "KINSetJacSparsityPattern",
+                            &kin_mem, &kinls_mem);
+  if (retval != KINLS_SUCCESS)  return(retval);
+
+  /* free any existing pattern */
+  if (kinls_mem->jac_pattern) {
+    SUNMatDestroy(kinls_mem->jac_pattern);
+    kinls_mem->jac_pattern = NULL;
+  }
+  if (kinls_mem->jac_colors) {
+    free(kinls_mem->jac_colors);
+    kinls_mem->jac_colors = NULL;
+  }
+  kinls_mem->jac_ncolors = 0;
+
+  /* a NULL input disables the sparse DQ Jacobian */
+  if (P == NULL) return(KINLS_SUCCESS);
+
+  /* the pattern must match the sparse or BSR system matrix */
+  if ((kinls_mem->J == NULL) ||
+      (SUNMatGetID(kinls_mem->J) != SUNMatGetID(P)) ||
+      ((SUNMatGetID(P) == SUNMATRIX_SPARSE) &&
+       ((SUNSparseMatrix_Rows(P) != SUNSparseMatrix_Rows(kinls_mem->J)) ||
+        (SUNSparseMatrix_Columns(P) != SUNSparseMatrix_Columns(kinls_mem->J)) ||
+        (SUNSparseMatrix_SparseType(P) != SUNSparseMatrix_SparseType(kinls_mem->J)))) ||
+      ((SUNMatGetID(P) == SUNMATRIX_BSR) &&
+       ((SUNBSRMatrix_BlockRows(P) != SUNBSRMatrix_BlockRows(kinls_mem->J)) ||
+        (SUNBSRMatrix_BlockColumns(P) != SUNBSRMatrix_BlockColumns(kinls_mem->J)) ||
+        (SUNBSRMatrix_BlockSize(P) != SUNBSRMatrix_BlockSize(kinls_mem->J)))) ||
+      ((SUNMatGetID(P) != SUNMATRIX_SPARSE) &&
+       (SUNMatGetID(P) != SUNMATRIX_BSR))) {
+    KINProcessError(kin_mem, KINLS_ILL_INPUT, "KINLS",
+                    "KINSetJacSparsityPattern",
+                    "Sparsity pattern is incompatible with the SUNMatrix");
+    return(KINLS_ILL_INPUT);
+  }
+
+  /* store a copy of the pattern */
+  kinls_mem->jac_pattern = SUNMatClone(P);
+  if (kinls_mem->jac_pattern == NULL) {
+    KINProcessError(kin_mem, KINLS_MEM_FAIL, "KINLS",
+                    "KINSetJacSparsityPattern", MSG_LS_MEM_FAIL);
+    return(KINLS_MEM_FAIL);
+  }
+
+  retval = SUNMatCopy(P, kinls_mem->jac_pattern);
+  if (retval != SUNMAT_SUCCESS) {
+    KINProcessError(kin_mem, KINLS_SUNMAT_FAIL, "KINLS",
+                    "KINSetJacSparsityPattern", MSG_LS_SUNMAT_FAILED);
+    SUNMatDestroy(kinls_mem->jac_pattern);
+    kinls_mem->jac_pattern = NULL;
+    return(KINLS_SUNMAT_FAIL);
+  }
+
+  /* color the columns of the pattern */
+  if (SUNMatGetID(P) == SUNMATRIX_BSR)
+    N = SUNBSRMatrix_Columns(P);
+  else
+    N = SUNSparseMatrix_Columns(P);
+  kinls_mem->jac_colors = (sunindextype *) malloc(N*sizeof(sunindextype));
+  if (kinls_mem->jac_colors == NULL) {
+    KINProcessError(kin_mem, KINLS_MEM_FAIL, "KINLS",
+                    "KINSetJacSparsityPattern", MSG_LS_MEM_FAIL);
+    SUNMatDestroy(kinls_mem->jac_pattern);
+    kinls_mem->jac_pattern = NULL;
+    return(KINLS_MEM_FAIL);
+  }
+
+  if (SUNMatGetID(P) == SUNMATRIX_BSR)
+    retval = SUNBSRMatrix_ColorColumns(kinls_mem->jac_pattern,
+                                       kinls_mem->jac_colors,
+                                       &(kinls_mem->jac_ncolors));
+  else
+    retval = SUNSparseMatrix_ColorColumns(kinls_mem->jac_pattern,
+                                          kinls_mem->jac_colors,
+                                          &(kinls_mem->jac_ncolors));
+  if (retval != SUNMAT_SUCCESS) {
+    KINProcessError(kin_mem, KINLS_SUNMAT_FAIL, "KINLS",
+                    "KINSetJacSparsityPattern", MSG_LS_SUNMAT_FAILED);
+    SUNMatDestroy(kinls_mem->jac_pattern);
+    kinls_mem->jac_pattern = NULL;
+    free(kinls_mem->jac_colors);
+    kinls_mem->jac_colors = NULL;
+    return(KINLS_SUNMAT_FAIL);
+  }
+
+  return(KINLS_SUCCESS);
+}
+
+
 /*------------------------------------------------------------------
   KINSetPreconditioner sets the preconditioner setup and solve
   functions
@@ -751,6 +857,10 @@ int kinLsDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac,
     retval = kinLsDenseDQJac(u, fu, Jac, kin_mem, tmp1, tmp2);
   } else if (SUNMatGetID(Jac) == SUNMATRIX_BAND) {
     retval = kinLsBandDQJac(u, fu, Jac, kin_mem, tmp1, tmp2);
+  } else if (((SUNMatGetID(Jac) == SUNMATRIX_SPARSE) ||
+               (SUNMatGetID(Jac) == SUNMATRIX_BSR)) &&
+             (((KINLsMem) kin_mem->kin_lmem)->jac_pattern != NULL)) {
+    retval = kinLsSparseDQJac(u, fu, Jac, kin_mem, tmp1, tmp2);
   } else {
     KINProcessError(kin_mem, KIN_ILL_INPUT, "KINLS", "kinLsDQJac",
                     "unrecognized matrix type for kinLsDQJac");
@@ -932,6 +1042,135 @@ int kinLsBandDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac,
 }
 
 
+/*------------------------------------------------------------------
+  kinLsSparseDQJac
+
+  This routine generates a sparse difference quotient approximation
+  to the Jacobian of F(u) using the user-supplied sparsity pattern.
+  The columns of the pattern are grouped by the coloring computed in
+  KINSetJacSparsityPattern so that columns of one color do not share
+  any rows. All u_j of a color are perturbed together, requiring a
+  single F evaluation per color, and the difference quotients are
+  scattered into the pattern entries (CSC, CSR or BSR) of the matching
+  columns. The increments are the same as in kinLsBandDQJac.
+
+  NOTE: Any type of failure of the system function here leads to an
+        unrecoverable failure of the Jacobian function and thus of
+        the linear solver setup function, stopping KINSOL.
+  ------------------------------------------------------------------*/
+int kinLsSparseDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac,
+                     KINMem kin_mem, N_Vector tmp1, N_Vector tmp2)
+{
+  realtype inc, sign;
+  N_Vector futemp, utemp;
+  sunindextype color, i, j, p, N, NP, I, r, c, bs;
+  sunindextype *colors, *Jp, *Ji;
+  realtype *fu_data, *futemp_data, *u_data, *utemp_data, *uscale_data;
+  realtype *J_data;
+  KINLsMem kinls_mem;
+  int retval = 0;
+
+  /* access LsMem interface structure */
+  kinls_mem = (KINLsMem) kin_mem->kin_lmem;
+
+  /* load the pattern into the Jacobian matrix */
+  retval = SUNMatCopy(kinls_mem->jac_pattern, Jac);
+  if (retval != SUNMAT_SUCCESS) return(-1);
+
+  /* access matrix dimensions and data, for a BSR matrix NP is the number
+     of block rows and Jp, Ji index the blocks */
+  bs = 1;
+  if (SUNMatGetID(Jac) == SUNMATRIX_BSR) {
+    N      = SUNBSRMatrix_Columns(Jac);
+    NP     = SUNBSRMatrix_BlockRows(Jac);
+    bs     = SUNBSRMatrix_BlockSize(Jac);
+    Jp     = SUNBSRMatrix_IndexPointers(Jac);
+    Ji     = SUNBSRMatrix_IndexValues(Jac);
+    J_data = SUNBSRMatrix_Data(Jac);
+  } else {
+    N      = SUNSparseMatrix_Columns(Jac);
+    NP     = SUNSparseMatrix_NP(Jac);
+    Jp     = SUNSparseMatrix_IndexPointers(Jac);
+    Ji     = SUNSparseMatrix_IndexValues(Jac);
+    J_data = SUNSparseMatrix_Data(Jac);
+  }
+  colors = kinls_mem->jac_colors;
+
+  /* Rename work vectors for use as temporary values of u and fu */
+  futemp = tmp1;
+  utemp  = tmp2;
+
+  /* Obtain pointers to the data for fu, futemp, u, utemp, uscale */
+  fu_data     = N_VGetArrayPointer(fu);
+  futemp_data = N_VGetArrayPointer(futemp);
+  u_data      = N_VGetArrayPointer(u);
+  uscale_data = N_VGetArrayPointer(kin_mem->kin_uscale);
+  utemp_data  = N_VGetArrayPointer(utemp);
+
+  /* Load utemp with u */
+  N_VScale(ONE, u, utemp);
+
+  for (color=0; color < kinls_mem->jac_ncolors; color++) {
+
+    /* Increment all utemp components of this color, with the same
+       increment (and sign) as the dense DQ approximation */
+    for (j=0; j < N; j++) {
+      if (colors[j] != color) continue;
+      sign = (u_data[j] >= ZERO) ? ONE : -ONE;
+      inc = kin_mem->kin_sqrt_relfunc*SUNMAX(SUNRabs(u_data[j]),
+                                             ONE/uscale_data[j])*sign;
+      utemp_data[j] += inc;
+    }
+
+    /* Evaluate f with incremented u */
+    retval = kin_mem->kin_func(utemp, futemp, kin_mem->kin_user_data);
+    kinls_mem->nfeDQ++;
+    if (retval != 0) return(retval);
+
+    /* Form and load difference quotients. The increment is recovered from
+       utemp before it is reset. */
+    if (SUNMatGetID(Jac) == SUNMATRIX_BSR) {
+      for (I=0; I < NP; I++) {
+        for (p=Jp[I]; p < Jp[I+1]; p++) {
+          for (c=0; c < bs; c++) {
+            j = Ji[p]*bs + c;
+            if (colors[j] != color) continue;
+            inc = utemp_data[j] - u_data[j];
+            for (r=0; r < bs; r++) {
+              i = I*bs + r;
+              J_data[(p*bs + c)*bs + r] = (futemp_data[i] - fu_data[i]) / inc;
+            }
+          }
+        }
+      }
+    } else if (SUNSparseMatrix_SparseType(Jac) == CSC_MAT) {
+      for (j=0; j < NP; j++) {
+        if (colors[j] != color) continue;
+        inc = utemp_data[j] - u_data[j];
+        for (p=Jp[j]; p < Jp[j+1]; p++) {
+          i = Ji[p];
+          J_data[p] = (futemp_data[i] - fu_data[i]) / inc;
+        }
+      }
+    } else {
+      for (i=0; i < NP; i++) {
+        for (p=Jp[i]; p < Jp[i+1]; p++) {
+          j = Ji[p];
+          if (colors[j] != color) continue;
+          J_data[p] = (futemp_data[i] - fu_data[i]) / (utemp_data[j] - u_data[j]);
+        }
+      }
+    }
+
+    /* Restore utemp components */
+    for (j=0; j < N; j++)
+      if (colors[j] == color) utemp_data[j] = u_data[j];
+  }
+
+  return(0);
+}
+
+
 /*------------------------------------------------------------------
   kinLsDQJtimes
 
@@ -1033,13 +1272,17 @@ int kinLsInitialize(KINMem kin_mem)
   } else if (kinls_mem->jacDQ) {
 
     /* If J is non-NULL, and 'jac' is not user-supplied:
-       - if A is dense or band, ensure that our DQ approx. is used
+       - if A is dense, band, or sparse or BSR with a sparsity pattern, ensure
+         that our DQ approx. is used
        - otherwise => error */
     retval = 0;
     if (kinls_mem->J->ops->getid) {
 
       if ( (SUNMatGetID(kinls_mem->J) == SUNMATRIX_DENSE) ||
-           (SUNMatGetID(kinls_mem->J) == SUNMATRIX_BAND) ) {
+           (SUNMatGetID(kinls_mem->J) == SUNMATRIX_BAND) ||
+           (((SUNMatGetID(kinls_mem->J) == SUNMATRIX_SPARSE) ||
+             (SUNMatGetID(kinls_mem->J) == SUNMATRIX_BSR)) &&
+            (kinls_mem->jac_pattern != NULL)) ) {
         kinls_mem->jac    = kinLsDQJac;
         kinls_mem->J_data = kin_mem;
       } else {
@@ -1349,6 +1592,16 @@ int kinLsFree(KINMem kin_mem)
   /* Nullify SUNMatrix pointer */
   kinls_mem->J = NULL;
 
+  /* Free sparse DQ Jacobian pattern and coloring */
+  if (kinls_mem->jac_pattern) {
+    SUNMatDestroy(kinls_mem->jac_pattern);
+    kinls_mem->jac_pattern = NULL;
+  }
+  if (kinls_mem->jac_colors) {
+    free(kinls_mem->jac_colors);
+    kinls_mem->jac_colors = NULL;
+  }
+
   /* Free preconditioner memory (if applicable) */
   if (kinls_mem->pfree) kinls_mem->pfree(kin_mem);
 
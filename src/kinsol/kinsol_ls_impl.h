@@ -55,6 +55,11 @@ typedef struct KINLsMemRec {
   SUNLinearSolver LS;  /* generic iterative linear solver object        */
   SUNMatrix J;         /* problem Jacobian                              */
 
+  /* Sparse difference quotient Jacobian */
+  SUNMatrix jac_pattern;    /* copy of the Jacobian sparsity pattern     */
+  sunindextype *jac_colors; /* column colors of the sparsity pattern     */
+  sunindextype jac_ncolors; /* number of column colors                   */
+
   /* Solver tolerance adjustment factor (if needed, see kinLsSolve)     */
   realtype tol_fac;
 
@@ -126,6 +131,9 @@ int kinLsDenseDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac,
 int kinLsBandDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac,
                    KINMem kin_mem, N_Vector tmp1, N_Vector tmp2);
 
+int kinLsSparseDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac,
+                     KINMem kin_mem, N_Vector tmp1, N_Vector tmp2);
+
 /* Generic linit/lsetup/lsolve/lfree interface routines for KINSOL to call */
 int kinLsInitialize(KINMem kin_mem);
 int kinLsSetup(KINMem kin_mem);
@@ -155,6 +163,7 @@ int kinLs_AccessLMem(void* kinmem, const char *fname,
 #define MSG_LS_PSOLVE_FAILED  "The preconditioner solve routine failed in an unrecoverable manner."
 #define MSG_LS_JTIMES_FAILED  "The Jacobian x vector routine failed in an unrecoverable manner."
 #define MSG_LS_MATZERO_FAILED "The SUNMatZero routine failed in an unrecoverable manner."
+#define MSG_LS_SUNMAT_FAILED  "A SUNMatrix routine failed in an unrecoverable manner."
 
 
 /*------------------------------------------------------------------
@@ -141,6 +141,10 @@ N_Vector N_VMake_MPIManyVector(MPI_Comm comm, sunindextype num_subvectors,
   v->ops->nvdotprodmultilocal     = N_VDotProdMultiLocal_MPIManyVector;
   v->ops->nvdotprodmultiallreduce = N_VDotProdMultiAllReduce_MPIManyVector;
 
+  /* split-phase buffer reduction operations */
+  v->ops->nvallreducestart  = N_VAllReduceStart_MPIManyVector;
+  v->ops->nvallreducefinish = N_VAllReduceFinish_MPIManyVector;
+
   /* XBraid interface operations */
   v->ops->nvbufsize   = N_VBufSize_MPIManyVector;
   v->ops->nvbufpack   = N_VBufPack_MPIManyVector;
@@ -162,6 +166,7 @@ N_Vector N_VMake_MPIManyVector(MPI_Comm comm, sunindextype num_subvectors,
 
   /* set scalar content entries, and allocate/set subvector array */
   content->comm           = MPI_COMM_NULL;
+  content->request        = MPI_REQUEST_NULL;
   content->num_subvectors = num_subvectors;
   content->own_data       = SUNFALSE;
   content->subvec_array   = NULL;
@@ -501,6 +506,10 @@ void MVAPPEND(N_VDestroy)(N_Vector v)
     MANYVECTOR_SUBVECS(v) = NULL;
 
 #ifdef MANYVECTOR_BUILD_WITH_MPI
+    /* complete a pending split-phase reduction */
+    if (MANYVECTOR_CONTENT(v)->request != MPI_REQUEST_NULL)
+      MPI_Wait(&(MANYVECTOR_CONTENT(v)->request), MPI_STATUS_IGNORE);
+
     /* free communicator */
     if (MANYVECTOR_COMM(v) != MPI_COMM_NULL)  MPI_Comm_free(&(MANYVECTOR_COMM(v)));
     MANYVECTOR_COMM(v) = MPI_COMM_NULL;
@@ -1316,6 +1325,54 @@ int N_VDotProdMultiAllReduce_MPIManyVector(int nvec_total, N_Vector x, realtype*
 
   return(-1);
 }
+
+
+/* Starts a non-blocking reduction of the buffer over the MPIManyVector
+   communicator; the buffer must not be accessed until the matching call to
+   N_VAllReduceFinish_MPIManyVector. Without a communicator the buffer already
+   holds the global values. */
+int N_VAllReduceStart_MPIManyVector(int nvec, N_Vector x, realtype* buf, int op)
+{
+  int    retval;
+  MPI_Op mpi_op;
+
+  /* invalid number of values or reduction already in progress */
+  if (nvec < 1) return(-1);
+  if (MANYVECTOR_CONTENT(x)->request != MPI_REQUEST_NULL) return(-1);
+
+  switch (op) {
+  case SUN_REDUCE_SUM: mpi_op = MPI_SUM; break;
+  case SUN_REDUCE_MAX: mpi_op = MPI_MAX; break;
+  case SUN_REDUCE_MIN: mpi_op = MPI_MIN; break;
+  default: return(-1);
+  }
+
+  if (MANYVECTOR_COMM(x) == MPI_COMM_NULL) return(0);
+
+#if MPI_VERSION >= 3
+  retval = MPI_Iallreduce(MPI_IN_PLACE, buf, nvec, MPI_SUNREALTYPE, mpi_op,
+                          MANYVECTOR_COMM(x), &(MANYVECTOR_CONTENT(x)->request));
+#else
+  retval = MPI_Allreduce(MPI_IN_PLACE, buf, nvec, MPI_SUNREALTYPE, mpi_op,
+                         MANYVECTOR_COMM(x));
+#endif
+
+  return(retval == MPI_SUCCESS ? 0 : -1);
+}
+
+
+/* Completes the reduction started by N_VAllReduceStart_MPIManyVector */
+int N_VAllReduceFinish_MPIManyVector(N_Vector x)
+{
+  int retval;
+
+  /* nothing to complete */
+  if (MANYVECTOR_CONTENT(x)->request == MPI_REQUEST_NULL) return(0);
+
+  retval = MPI_Wait(&(MANYVECTOR_CONTENT(x)->request), MPI_STATUS_IGNORE);
+
+  return(retval == MPI_SUCCESS ? 0 : -1);
+}
 #endif
 
 
@@ -2009,6 +2066,7 @@ static N_Vector ManyVectorClone(N_Vector w, booleantype cloneempty)
   /* Set scalar components */
 #ifdef MANYVECTOR_BUILD_WITH_MPI
   content->comm           = MPI_COMM_NULL;
+  content->request        = MPI_REQUEST_NULL;
 #endif
   content->num_subvectors = MANYVECTOR_NUM_SUBVECS(w);
   content->global_length  = MANYVECTOR_GLOBLENGTH(w);
@@ -33,6 +33,10 @@
 #define ONE    RCONST(1.0)
 #define ONEPT5 RCONST(1.5)
 
+/* Private functions to allocate and free the vector data */
+static realtype* VAllocData_OpenMP(N_Vector v, sunindextype length);
+static void VFreeData_OpenMP(N_Vector v);
+
 /* Private functions for special cases of vector operations */
 static void VCopy_OpenMP(N_Vector x, N_Vector z);                              /* z=x       */
 static void VSum_OpenMP(N_Vector x, N_Vector y, N_Vector z);                   /* z=x+y     */
@@ -155,6 +159,8 @@ N_Vector N_VNewEmpty_OpenMP(sunindextype length, int num_threads, SUNContext sun
   content->num_threads = num_threads;
   content->own_data    = SUNFALSE;
   content->data        = NULL;
+  content->mem_helper  = NULL;
+  content->mem         = NULL;
 
   return(v);
 }
@@ -177,7 +183,7 @@ N_Vector N_VNew_OpenMP(sunindextype length, int num_threads, SUNContext sunctx)
 
     /* Allocate memory */
     data = NULL;
-    data = (realtype *) malloc(length * sizeof(realtype));
+    data = VAllocData_OpenMP(v, length);
     if(data == NULL) { N_VDestroy_OpenMP(v); return(NULL); }
 
     /* Attach data */
@@ -321,6 +327,8 @@ N_Vector N_VCloneEmpty_OpenMP(N_Vector w)
   content->num_threads = NV_NUM_THREADS_OMP(w);
   content->own_data    = SUNFALSE;
   content->data        = NULL;
+  content->mem_helper  = NULL;
+  content->mem         = NULL;
 
   return(v);
 }
@@ -347,7 +355,7 @@ N_Vector N_VClone_OpenMP(N_Vector w)
 
     /* Allocate memory */
     data = NULL;
-    data = (realtype *) malloc(length * sizeof(realtype));
+    data = VAllocData_OpenMP(v, length);
     if(data == NULL) { N_VDestroy_OpenMP(v); return(NULL); }
 
     /* Attach data */
@@ -372,7 +380,7 @@ void N_VDestroy_OpenMP(N_Vector v)
   if (v->content != NULL) {
     /* free data array if it's owned by the vector */
     if (NV_OWN_DATA_OMP(v) && NV_DATA_OMP(v) != NULL) {
-      free(NV_DATA_OMP(v));
+      VFreeData_OpenMP(v);
       NV_DATA_OMP(v) = NULL;
     }
     free(v->content);
@@ -1930,6 +1938,48 @@ int N_VBufUnpack_OpenMP(N_Vector x, void *buf)
 }
 
 
+/*
+ * -----------------------------------------------------------------
+ * private functions to allocate and free the vector data
+ * -----------------------------------------------------------------
+ */
+
+/* Allocate the data through the memory helper attached to the context if
+   there is one, otherwise with malloc */
+static realtype* VAllocData_OpenMP(N_Vector v, sunindextype length)
+{
+  SUNMemoryHelper helper = NULL;
+  SUNMemory mem = NULL;
+
+  SUNContext_GetMemoryHelper(v->sunctx, &helper);
+
+  if (helper == NULL)
+    return((realtype *) malloc(length * sizeof(realtype)));
+
+  if (SUNMemoryHelper_Alloc(helper, &mem, length * sizeof(realtype),
+                            SUNMEMTYPE_HOST, NULL))
+    return(NULL);
+
+  NV_CONTENT_OMP(v)->mem_helper = helper;
+  NV_CONTENT_OMP(v)->mem        = mem;
+
+  return((realtype *) mem->ptr);
+}
+
+/* Free the data with the helper that allocated it */
+static void VFreeData_OpenMP(N_Vector v)
+{
+  if (NV_CONTENT_OMP(v)->mem != NULL) {
+    SUNMemoryHelper_Dealloc(NV_CONTENT_OMP(v)->mem_helper,
+                            NV_CONTENT_OMP(v)->mem, NULL);
+    NV_CONTENT_OMP(v)->mem_helper = NULL;
+    NV_CONTENT_OMP(v)->mem        = NULL;
+  } else {
+    free(NV_DATA_OMP(v));
+  }
+}
+
+
 /*
  * -----------------------------------------------------------------
  * private functions for special cases of vector operations
@@ -147,6 +147,10 @@ N_Vector N_VNewEmpty_Parallel(MPI_Comm comm,
   v->ops->nvdotprodmultilocal     = N_VDotProdMultiLocal_Parallel;
   v->ops->nvdotprodmultiallreduce = N_VDotProdMultiAllReduce_Parallel;
 
+  /* split-phase buffer reduction operations */
+  v->ops->nvallreducestart  = N_VAllReduceStart_Parallel;
+  v->ops->nvallreducefinish = N_VAllReduceFinish_Parallel;
+
   /* XBraid interface operations */
   v->ops->nvbufsize   = N_VBufSize_Parallel;
   v->ops->nvbufpack   = N_VBufPack_Parallel;
@@ -170,6 +174,7 @@ N_Vector N_VNewEmpty_Parallel(MPI_Comm comm,
   content->comm          = comm;
   content->own_data      = SUNFALSE;
   content->data          = NULL;
+  content->request       = MPI_REQUEST_NULL;
 
   return(v);
 }
@@ -351,6 +356,7 @@ N_Vector N_VCloneEmpty_Parallel(N_Vector w)
   content->comm          = NV_COMM_P(w);
   content->own_data      = SUNFALSE;
   content->data          = NULL;
+  content->request       = MPI_REQUEST_NULL;
 
   return(v);
 }
@@ -389,6 +395,9 @@ void N_VDestroy_Parallel(N_Vector v)
 
   /* free content */
   if (v->content != NULL) {
+    /* complete a pending split-phase reduction */
+    if (NV_CONTENT_P(v)->request != MPI_REQUEST_NULL)
+      MPI_Wait(&(NV_CONTENT_P(v)->request), MPI_STATUS_IGNORE);
     if (NV_OWN_DATA_P(v) && NV_DATA_P(v) != NULL) {
       free(NV_DATA_P(v));
       NV_DATA_P(v) = NULL;
@@ -1166,6 +1175,55 @@ int N_VDotProdMultiAllReduce_Parallel(int nvec_total, N_Vector x, realtype* sum)
 }
 
 
+/*
+ * -----------------------------------------------------------------
+ * split-phase buffer reduction operations
+ * -----------------------------------------------------------------
+ */
+
+int N_VAllReduceStart_Parallel(int nvec, N_Vector x, realtype* buf, int op)
+{
+  int      retval;
+  MPI_Op   mpi_op;
+
+  /* invalid number of values or reduction already in progress */
+  if (nvec < 1) return(-1);
+  if (NV_CONTENT_P(x)->request != MPI_REQUEST_NULL) return(-1);
+
+  switch (op) {
+  case SUN_REDUCE_SUM: mpi_op = MPI_SUM; break;
+  case SUN_REDUCE_MAX: mpi_op = MPI_MAX; break;
+  case SUN_REDUCE_MIN: mpi_op = MPI_MIN; break;
+  default: return(-1);
+  }
+
+  /* start the reduction, the buffer must not be accessed until the
+     matching call to N_VAllReduceFinish_Parallel */
+#if MPI_VERSION >= 3
+  retval = MPI_Iallreduce(MPI_IN_PLACE, buf, nvec, MPI_SUNREALTYPE, mpi_op,
+                          NV_COMM_P(x), &(NV_CONTENT_P(x)->request));
+#else
+  retval = MPI_Allreduce(MPI_IN_PLACE, buf, nvec, MPI_SUNREALTYPE, mpi_op,
+                         NV_COMM_P(x));
+#endif
+
+  return retval == MPI_SUCCESS ? 0 : -1;
+}
+
+
+int N_VAllReduceFinish_Parallel(N_Vector x)
+{
+  int retval;
+
+  /* nothing to complete */
+  if (NV_CONTENT_P(x)->request == MPI_REQUEST_NULL) return(0);
+
+  retval = MPI_Wait(&(NV_CONTENT_P(x)->request), MPI_STATUS_IGNORE);
+
+  return retval == MPI_SUCCESS ? 0 : -1;
+}
+
+
 /*
  * -----------------------------------------------------------------
  * vector array operations
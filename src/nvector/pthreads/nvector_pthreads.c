@@ -21,8 +21,13 @@
  * structures to pass data to threads.
  * -----------------------------------------------------------------*/
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* pthread_setaffinity_np and cpu_set_t */
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 #include <nvector/nvector_pthreads.h>
 #include <sundials/sundials_math.h>
@@ -33,6 +38,41 @@
 #define ONE    RCONST(1.0)
 #define ONEPT5 RCONST(1.5)
 
+/* Worker thread pool. Jobs are posted by incrementing the generation counter
+   and broadcasting on work_cv, worker i executes task i+1 of the job while
+   the calling thread executes task 0 and then waits on done_cv until all
+   workers have finished. The run_lock serializes jobs from different calling
+   threads sharing a pool. */
+
+typedef struct _N_VThreadPoolArg {
+  N_VThreadPool_Pthreads pool;       /* pool the worker belongs to        */
+  int                    id;         /* worker index                      */
+  unsigned long          generation; /* job counter when worker started   */
+} N_VThreadPoolArg;
+
+struct _N_VThreadPool_Pthreads {
+  int               refcount;   /* number of vectors using the pool      */
+  int               nworkers;   /* number of running worker threads      */
+  int               maxworkers; /* allocated length of worker arrays     */
+  pthread_t         *workers;   /* worker thread handles                 */
+  N_VThreadPoolArg  **args;     /* worker thread arguments               */
+  pthread_mutex_t   lock;       /* protects the job fields below         */
+  pthread_mutex_t   run_lock;   /* one job in flight at a time           */
+  pthread_cond_t    work_cv;    /* signals a new job (or shutdown)       */
+  pthread_cond_t    done_cv;    /* signals all workers finished the job  */
+  unsigned long     generation; /* job counter                           */
+  int               pending;    /* workers still running the current job */
+  int               ntasks;     /* number of tasks in the current job    */
+  void*             (*func)(void*); /* companion function of the job     */
+  Pthreads_Data     *task_data; /* per task data of the job              */
+  booleantype       shutdown;   /* workers should exit                   */
+  booleantype       pin;        /* pin workers to cores                  */
+};
+
+/* Private functions to allocate and free the vector data */
+static realtype* VAllocData_Pthreads(N_Vector v, sunindextype length);
+static void VFreeData_Pthreads(N_Vector v);
+
 /* Private functions for special cases of vector operations */
 static void VCopy_Pthreads(N_Vector x, N_Vector z);                              /* z=x       */
 static void VSum_Pthreads(N_Vector x, N_Vector y, N_Vector z);                   /* z=x+y     */
@@ -121,6 +161,17 @@ static void N_VSplitLoop(int myid, int *nthreads, sunindextype *N,
 /* Function to initialize thread data */
 static void N_VInitThreadData(Pthreads_Data *thread_data);
 
+/* Pthread companion function to N_VParallelFor */
+static void *N_VParallelFor_PT(void *thread_data);
+
+/* Thread pool functions */
+static N_VThreadPool_Pthreads N_VThreadPoolCreate(void);
+static void N_VThreadPoolRetain(N_VThreadPool_Pthreads pool);
+static void N_VThreadPoolRelease(N_VThreadPool_Pthreads pool);
+static void N_VThreadPoolPin(pthread_t thread, int id);
+static void N_VRunThreadPool(N_VThreadPool_Pthreads pool, int ntasks,
+                             void* (*func)(void*), Pthreads_Data *thread_data);
+
 /*
  * -----------------------------------------------------------------
  * exported functions
@@ -223,6 +274,13 @@ N_Vector N_VNewEmpty_Pthreads(sunindextype length, int num_threads,
   content->num_threads = num_threads;
   content->own_data    = SUNFALSE;
   content->data        = NULL;
+  content->mem_helper  = NULL;
+  content->mem         = NULL;
+  content->pool        = NULL;
+
+  /* Create thread pool (worker threads are started on first use) */
+  content->pool = N_VThreadPoolCreate();
+  if (content->pool == NULL) { N_VDestroy(v); return(NULL); }
 
   return(v);
 }
@@ -246,13 +304,17 @@ N_Vector N_VNew_Pthreads(sunindextype length, int num_threads,
 
     /* Allocate memory */
     data = NULL;
-    data = (realtype *) malloc(length * sizeof(realtype));
+    data = VAllocData_Pthreads(v, length);
     if(data == NULL) { N_VDestroy_Pthreads(v); return(NULL); }
 
     /* Attach data */
     NV_OWN_DATA_PT(v) = SUNTRUE;
     NV_DATA_PT(v)     = data;
 
+    /* First touch the data with the threads that will operate on it so the
+       pages are placed in the memory local to each thread */
+    N_VConst_Pthreads(ZERO, v);
+
   }
 
   return(v);
@@ -391,6 +453,12 @@ N_Vector N_VCloneEmpty_Pthreads(N_Vector w)
   content->num_threads = NV_NUM_THREADS_PT(w);
   content->own_data    = SUNFALSE;
   content->data        = NULL;
+  content->mem_helper  = NULL;
+  content->mem         = NULL;
+
+  /* Share the thread pool with the cloned vector */
+  content->pool = NV_POOL_PT(w);
+  N_VThreadPoolRetain(content->pool);
 
   return(v);
 }
@@ -417,13 +485,17 @@ N_Vector N_VClone_Pthreads(N_Vector w)
 
     /* Allocate memory */
     data = NULL;
-    data = (realtype *) malloc(length * sizeof(realtype));
+    data = VAllocData_Pthreads(v, length);
     if(data == NULL) { N_VDestroy_Pthreads(v); return(NULL); }
 
     /* Attach data */
     NV_OWN_DATA_PT(v) = SUNTRUE;
     NV_DATA_PT(v)     = data;
 
+    /* First touch the data with the threads that will operate on it so the
+       pages are placed in the memory local to each thread */
+    N_VConst_Pthreads(ZERO, v);
+
   }
 
   return(v);
@@ -440,9 +512,11 @@ void N_VDestroy_Pthreads(N_Vector v)
   /* free content */
   if (v->content != NULL) {
     if (NV_OWN_DATA_PT(v) && NV_DATA_PT(v) != NULL) {
-      free(NV_DATA_PT(v));
+      VFreeData_Pthreads(v);
       NV_DATA_PT(v) = NULL;
     }
+    N_VThreadPoolRelease(NV_POOL_PT(v));
+    NV_POOL_PT(v) = NULL;
     free(v->content);
     v->content = NULL;
   }
@@ -497,9 +571,7 @@ void N_VLinearSum_Pthreads(realtype a, N_Vector x, realtype b, N_Vector y, N_Vec
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   realtype c;
   N_Vector v1, v2;
@@ -572,16 +644,11 @@ void N_VLinearSum_Pthreads(realtype a, N_Vector x, realtype b, N_Vector y, N_Vec
      (2) a == 0.0, b == other - user should have called N_VScale
      (3) a,b == other, a !=b, a != -b */
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = (pthread_t *) malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -595,19 +662,12 @@ void N_VLinearSum_Pthreads(realtype a, N_Vector x, realtype b, N_Vector y, N_Vec
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VLinearSum_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VLinearSum_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -642,7 +702,7 @@ static void *N_VLinearSum_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -654,20 +714,13 @@ void N_VConst_Pthreads(realtype c, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(z);
   nthreads     = NV_NUM_THREADS_PT(z);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -678,19 +731,12 @@ void N_VConst_Pthreads(realtype c, N_Vector z)
     /* pack thread data */
     thread_data[i].c1 = c;
     thread_data[i].v1 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VConst_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(z), nthreads, N_VConst_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -722,7 +768,7 @@ static void *N_VConst_PT(void *thread_data)
     zd[i] = c;
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -734,20 +780,13 @@ void N_VProd_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -759,19 +798,12 @@ void N_VProd_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VProd_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VProd_PT, thread_data);
 
   /* clean up and exit */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -802,7 +834,7 @@ static void *N_VProd_PT(void *thread_data)
     zd[i] = xd[i]*yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -814,20 +846,13 @@ void N_VDiv_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -839,19 +864,12 @@ void N_VDiv_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VDiv_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VDiv_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -883,7 +901,7 @@ static void *N_VDiv_PT(void *thread_data)
     zd[i] = xd[i]/yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -895,9 +913,7 @@ void N_VScale_Pthreads(realtype c, N_Vector x, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   if (z == x) {  /* BLAS usage: scale x <- cx */
     VScaleBy_Pthreads(c, x);
@@ -909,16 +925,11 @@ void N_VScale_Pthreads(realtype c, N_Vector x, N_Vector z)
   } else if (c == -ONE) {
     VNeg_Pthreads(x, z);
   } else {
-    /* allocate threads and thread data structs */
+    /* allocate thread data structs */
     N            = NV_LENGTH_PT(x);
     nthreads     = NV_NUM_THREADS_PT(x);
-    threads      = malloc(nthreads*sizeof(pthread_t));
     thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-    /* set thread attributes */
-    pthread_attr_init(&attr);
-    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
     for (i=0; i<nthreads; i++) {
       /* initialize thread data */
       N_VInitThreadData(&thread_data[i]);
@@ -930,19 +941,12 @@ void N_VScale_Pthreads(realtype c, N_Vector x, N_Vector z)
       thread_data[i].c1 = c;
       thread_data[i].v1 = NV_DATA_PT(x);
       thread_data[i].v2 = NV_DATA_PT(z);
-
-      /* create threads and call pthread companion function */
-      pthread_create(&threads[i], &attr, N_VScale_PT, (void *) &thread_data[i]);
     }
 
-    /* wait for all threads to finish */
-    for (i=0; i<nthreads; i++) {
-      pthread_join(threads[i], NULL);
-    }
+    /* run companion function on the thread pool */
+    N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VScale_PT, thread_data);
 
     /* clean up */
-    pthread_attr_destroy(&attr);
-    free(threads);
     free(thread_data);
   }
 
@@ -976,7 +980,7 @@ static void *N_VScale_PT(void *thread_data)
     zd[i] = c*xd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -988,20 +992,13 @@ void N_VAbs_Pthreads(N_Vector x, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -1012,19 +1009,12 @@ void N_VAbs_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VAbs_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VAbs_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -1055,7 +1045,7 @@ static void *N_VAbs_PT(void *thread_data)
     zd[i] = SUNRabs(xd[i]);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1067,20 +1057,13 @@ void N_VInv_Pthreads(N_Vector x, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -1091,19 +1074,12 @@ void N_VInv_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VInv_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VInv_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -1134,7 +1110,7 @@ static void *N_VInv_PT(void *thread_data)
     zd[i] = ONE/xd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1146,20 +1122,13 @@ void N_VAddConst_Pthreads(N_Vector x, realtype b, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -1171,19 +1140,12 @@ void N_VAddConst_Pthreads(N_Vector x, realtype b, N_Vector z)
     thread_data[i].c1 = b;
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VAddConst_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VAddConst_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -1216,7 +1178,7 @@ static void *N_VAddConst_PT(void *thread_data)
     zd[i] = xd[i] + b;
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1228,22 +1190,15 @@ realtype N_VDotProd_Pthreads(N_Vector x, N_Vector y)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1259,20 +1214,13 @@ realtype N_VDotProd_Pthreads(N_Vector x, N_Vector y)
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VDotProd_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VDotProd_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(sum);
@@ -1314,7 +1262,7 @@ static void *N_VDotProd_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1326,22 +1274,15 @@ realtype N_VMaxNorm_Pthreads(N_Vector x)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        max = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1356,20 +1297,13 @@ realtype N_VMaxNorm_Pthreads(N_Vector x)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].global_val   = &max;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VMaxNorm_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VMaxNorm_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(max);
@@ -1412,7 +1346,7 @@ static void *N_VMaxNorm_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1434,22 +1368,15 @@ realtype N_VWSqrSumLocal_Pthreads(N_Vector x, N_Vector w)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1465,20 +1392,13 @@ realtype N_VWSqrSumLocal_Pthreads(N_Vector x, N_Vector w)
     thread_data[i].v2 = NV_DATA_PT(w);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VWSqrSum_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VWSqrSum_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(sum);
@@ -1520,7 +1440,7 @@ static void *N_VWSqrSum_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1542,22 +1462,15 @@ realtype N_VWSqrSumMaskLocal_Pthreads(N_Vector x, N_Vector w, N_Vector id)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1574,20 +1487,13 @@ realtype N_VWSqrSumMaskLocal_Pthreads(N_Vector x, N_Vector w, N_Vector id)
     thread_data[i].v3 = NV_DATA_PT(id);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VWSqrSumMask_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VWSqrSumMask_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(sum);
@@ -1632,7 +1538,7 @@ static void *N_VWSqrSumMask_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1644,25 +1550,18 @@ realtype N_VMin_Pthreads(N_Vector x)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        min;
 
   /* initialize global min */
   min = NV_Ith_PT(x,0);
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1677,20 +1576,13 @@ realtype N_VMin_Pthreads(N_Vector x)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].global_val   = &min;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VMin_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VMin_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(min);
@@ -1734,7 +1626,7 @@ static void *N_VMin_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1746,22 +1638,15 @@ realtype N_VWL2Norm_Pthreads(N_Vector x, N_Vector w)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1777,20 +1662,13 @@ realtype N_VWL2Norm_Pthreads(N_Vector x, N_Vector w)
     thread_data[i].v2 = NV_DATA_PT(w);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VWL2Norm_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VWL2Norm_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(SUNRsqrt(sum));
@@ -1832,7 +1710,7 @@ static void *N_VWL2Norm_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1844,22 +1722,15 @@ realtype N_VL1Norm_Pthreads(N_Vector x)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1874,20 +1745,13 @@ realtype N_VL1Norm_Pthreads(N_Vector x)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VL1Norm_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VL1Norm_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(sum);
@@ -1928,7 +1792,7 @@ static void *N_VL1Norm_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1940,20 +1804,13 @@ void N_VCompare_Pthreads(realtype c, N_Vector x, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -1965,19 +1822,12 @@ void N_VCompare_Pthreads(realtype c, N_Vector x, N_Vector z)
     thread_data[i].c1  = c;
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VCompare_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VCompare_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -2009,7 +1859,7 @@ static void *N_VCompare_PT(void *thread_data)
     zd[i] = (SUNRabs(xd[i]) >= c) ? ONE : ZERO;
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2021,22 +1871,15 @@ booleantype N_VInvTest_Pthreads(N_Vector x, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   realtype val = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -2048,19 +1891,12 @@ booleantype N_VInvTest_Pthreads(N_Vector x, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
     thread_data[i].global_val = &val;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VInvTest_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VInvTest_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   if (val > ZERO)
@@ -2107,7 +1943,7 @@ static void *N_VInvTest_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2119,22 +1955,15 @@ booleantype N_VConstrMask_Pthreads(N_Vector c, N_Vector x, N_Vector m)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   realtype val = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -2147,19 +1976,12 @@ booleantype N_VConstrMask_Pthreads(N_Vector c, N_Vector x, N_Vector m)
     thread_data[i].v2 = NV_DATA_PT(x);
     thread_data[i].v3 = NV_DATA_PT(m);
     thread_data[i].global_val = &val;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VConstrMask_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VConstrMask_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   if (val > ZERO)
@@ -2214,7 +2036,7 @@ static void *N_VConstrMask_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2226,22 +2048,15 @@ realtype N_VMinQuotient_Pthreads(N_Vector num, N_Vector denom)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        min = BIG_REAL;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(num);
   nthreads    = NV_NUM_THREADS_PT(num);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -2257,20 +2072,13 @@ realtype N_VMinQuotient_Pthreads(N_Vector num, N_Vector denom)
     thread_data[i].v2 = NV_DATA_PT(denom);
     thread_data[i].global_val   = &min;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VMinQuotient_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(num), nthreads, N_VMinQuotient_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(min);
@@ -2316,7 +2124,7 @@ static void *N_VMinQuotient_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2335,9 +2143,7 @@ int N_VLinearCombination_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector z
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   if (nvec < 1) return(-1);
@@ -2357,13 +2163,8 @@ int N_VLinearCombination_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector z
   /* get vector length and data array */
   N           = NV_LENGTH_PT(z);
   nthreads    = NV_NUM_THREADS_PT(z);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -2376,19 +2177,12 @@ int N_VLinearCombination_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector z
     thread_data[i].cvals = c;
     thread_data[i].Y1    = X;
     thread_data[i].x1    = z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VLinearCombination_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(z), nthreads, N_VLinearCombination_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -2428,7 +2222,7 @@ static void *N_VLinearCombination_PT(void *thread_data)
         zd[j] += c[i] * xd[j];
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -2444,7 +2238,7 @@ static void *N_VLinearCombination_PT(void *thread_data)
         zd[j] += c[i] * xd[j];
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -2460,7 +2254,7 @@ static void *N_VLinearCombination_PT(void *thread_data)
       zd[j] += c[i] * xd[j];
     }
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2472,9 +2266,7 @@ int N_VScaleAddMulti_Pthreads(int nvec, realtype* a, N_Vector x, N_Vector* Y, N_
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   if (nvec < 1) return(-1);
@@ -2488,13 +2280,8 @@ int N_VScaleAddMulti_Pthreads(int nvec, realtype* a, N_Vector x, N_Vector* Y, N_
   /* get vector length and data array */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -2508,19 +2295,12 @@ int N_VScaleAddMulti_Pthreads(int nvec, realtype* a, N_Vector x, N_Vector* Y, N_
     thread_data[i].x1    = x;
     thread_data[i].Y1    = Y;
     thread_data[i].Y2    = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VScaleAddMulti_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VScaleAddMulti_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -2561,7 +2341,7 @@ static void *N_VScaleAddMulti_PT(void *thread_data)
         yd[j] += a[i] * xd[j];
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -2574,7 +2354,7 @@ static void *N_VScaleAddMulti_PT(void *thread_data)
       zd[j] = a[i] * xd[j] + yd[j];
     }
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2586,9 +2366,7 @@ int N_VDotProdMulti_Pthreads(int nvec, N_Vector x, N_Vector* Y, realtype* dotpro
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
 
   /* invalid number of vectors */
@@ -2604,16 +2382,11 @@ int N_VDotProdMulti_Pthreads(int nvec, N_Vector x, N_Vector* Y, realtype* dotpro
   for (i=0; i<nvec; i++)
     dotprods[i] = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -2631,20 +2404,13 @@ int N_VDotProdMulti_Pthreads(int nvec, N_Vector x, N_Vector* Y, realtype* dotpro
     thread_data[i].cvals = dotprods;
 
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VDotProdMulti_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, N_VDotProdMulti_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -2691,7 +2457,7 @@ static void *N_VDotProdMulti_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2711,9 +2477,7 @@ int N_VLinearSumVectorArray_Pthreads(int nvec, realtype a, N_Vector* X,
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   realtype    c;
   N_Vector*  V1;
@@ -2788,13 +2552,8 @@ int N_VLinearSumVectorArray_Pthreads(int nvec, realtype a, N_Vector* X,
   /* get vector length and data array */
   N           = NV_LENGTH_PT(Z[0]);
   nthreads    = NV_NUM_THREADS_PT(Z[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -2809,20 +2568,12 @@ int N_VLinearSumVectorArray_Pthreads(int nvec, realtype a, N_Vector* X,
     thread_data[i].Y1   = X;
     thread_data[i].Y2   = Y;
     thread_data[i].Y3   = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VLinearSumVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(Z[0]), nthreads, N_VLinearSumVectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -2864,7 +2615,7 @@ static void *N_VLinearSumVectorArray_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2876,9 +2627,7 @@ int N_VScaleVectorArray_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector* Z
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   if (nvec < 1) return(-1);
@@ -2892,13 +2641,8 @@ int N_VScaleVectorArray_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector* Z
   /* get vector length and data array */
   N           = NV_LENGTH_PT(Z[0]);
   nthreads    = NV_NUM_THREADS_PT(Z[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -2911,20 +2655,12 @@ int N_VScaleVectorArray_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector* Z
     thread_data[i].cvals = c;
     thread_data[i].Y1    = X;
     thread_data[i].Y2    = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VScaleVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(Z[0]), nthreads, N_VScaleVectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -2963,7 +2699,7 @@ static void *N_VScaleVectorArray_PT(void *thread_data)
         xd[j] *= c[i];
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -2976,7 +2712,7 @@ static void *N_VScaleVectorArray_PT(void *thread_data)
       zd[j] = c[i] * xd[j];
     }
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2988,9 +2724,7 @@ int N_VConstVectorArray_Pthreads(int nvec, realtype c, N_Vector* Z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   if (nvec < 1) return(-1);
@@ -3004,13 +2738,8 @@ int N_VConstVectorArray_Pthreads(int nvec, realtype c, N_Vector* Z)
   /* get vector length and data array */
   N           = NV_LENGTH_PT(Z[0]);
   nthreads    = NV_NUM_THREADS_PT(Z[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -3022,20 +2751,12 @@ int N_VConstVectorArray_Pthreads(int nvec, realtype c, N_Vector* Z)
     thread_data[i].nvec = nvec;
     thread_data[i].c1   = c;
     thread_data[i].Y1   = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VConstVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(Z[0]), nthreads, N_VConstVectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -3069,7 +2790,7 @@ static void *N_VConstVectorArray_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3081,9 +2802,7 @@ int N_VWrmsNormVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W, realtype
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
 
   /* invalid number of vectors */
@@ -3099,16 +2818,11 @@ int N_VWrmsNormVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W, realtype
   for (i=0; i<nvec; i++)
     nrm[i] = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -3126,25 +2840,17 @@ int N_VWrmsNormVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W, realtype
     thread_data[i].cvals = nrm;
 
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VWrmsNormVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(X[0]), nthreads, N_VWrmsNormVectorArray_PT, thread_data);
 
   /* finalize wrms calculation */
   for (i=0; i<nvec; i++)
     nrm[i] = SUNRsqrt(nrm[i]/N);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -3191,7 +2897,7 @@ static void *N_VWrmsNormVectorArray_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3204,9 +2910,7 @@ int N_VWrmsNormMaskVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W,
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
 
   /* invalid number of vectors */
@@ -3222,16 +2926,11 @@ int N_VWrmsNormMaskVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W,
   for (i=0; i<nvec; i++)
     nrm[i] = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -3250,25 +2949,17 @@ int N_VWrmsNormMaskVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W,
     thread_data[i].cvals = nrm;
 
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VWrmsNormMaskVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(X[0]), nthreads, N_VWrmsNormMaskVectorArray_PT, thread_data);
 
   /* finalize wrms calculation */
   for (i=0; i<nvec; i++)
     nrm[i] = SUNRsqrt(nrm[i]/N);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -3318,7 +3009,7 @@ static void *N_VWrmsNormMaskVectorArray_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3331,9 +3022,7 @@ int N_VScaleAddMultiVectorArray_Pthreads(int nvec, int nsum, realtype* a,
 {
   sunindextype   N;
   int            i, j, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   int          retval;
   N_Vector*   YY;
@@ -3388,13 +3077,8 @@ int N_VScaleAddMultiVectorArray_Pthreads(int nvec, int nsum, realtype* a,
   /* get vector length and data array */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -3409,20 +3093,12 @@ int N_VScaleAddMultiVectorArray_Pthreads(int nvec, int nsum, realtype* a,
     thread_data[i].Y1    = X;
     thread_data[i].ZZ1   = Y;
     thread_data[i].ZZ2   = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VScaleAddMultiVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(X[0]), nthreads, N_VScaleAddMultiVectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -3465,7 +3141,7 @@ static void *N_VScaleAddMultiVectorArray_PT(void *thread_data)
         }
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -3481,7 +3157,7 @@ static void *N_VScaleAddMultiVectorArray_PT(void *thread_data)
       }
     }
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3494,9 +3170,7 @@ int N_VLinearCombinationVectorArray_Pthreads(int nvec, int nsum, realtype* c,
 {
   sunindextype   N;
   int            i, j, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   int          retval;
   realtype*    ctmp;
@@ -3569,13 +3243,8 @@ int N_VLinearCombinationVectorArray_Pthreads(int nvec, int nsum, realtype* c,
   /* get vector length and data array */
   N           = NV_LENGTH_PT(Z[0]);
   nthreads    = NV_NUM_THREADS_PT(Z[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -3589,20 +3258,12 @@ int N_VLinearCombinationVectorArray_Pthreads(int nvec, int nsum, realtype* c,
     thread_data[i].cvals = c;
     thread_data[i].ZZ1   = X;
     thread_data[i].Y1    = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VLinearCombinationVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(Z[0]), nthreads, N_VLinearCombinationVectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -3645,7 +3306,7 @@ static void *N_VLinearCombinationVectorArray_PT(void *thread_data)
         }
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -3664,7 +3325,7 @@ static void *N_VLinearCombinationVectorArray_PT(void *thread_data)
         }
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -3683,7 +3344,7 @@ static void *N_VLinearCombinationVectorArray_PT(void *thread_data)
       }
     }
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3715,22 +3376,15 @@ int N_VBufPack_Pthreads(N_Vector x, void *buf)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   if (x == NULL || buf == NULL) return(-1);
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -3741,19 +3395,12 @@ int N_VBufPack_Pthreads(N_Vector x, void *buf)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = (realtype*)buf;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VBufPack_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VBufPack_PT, thread_data);
 
   /* clean up */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -3785,7 +3432,7 @@ static void *VBufPack_PT(void *thread_data)
     bd[i] = xd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3797,22 +3444,15 @@ int N_VBufUnpack_Pthreads(N_Vector x, void *buf)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   if (x == NULL || buf == NULL) return(-1);
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -3823,19 +3463,12 @@ int N_VBufUnpack_Pthreads(N_Vector x, void *buf)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = (realtype*)buf;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VBufUnpack_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VBufUnpack_PT, thread_data);
 
   /* clean up */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -3867,18 +3500,60 @@ static void *VBufUnpack_PT(void *thread_data)
     xd[i] = bd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
 /*
  * -----------------------------------------------------------------
- * private functions for special cases of vector operations
+ * private functions to allocate and free the vector data
  * -----------------------------------------------------------------
  */
 
+/* Allocate the data through the memory helper attached to the context if
+   there is one, otherwise with malloc */
+static realtype* VAllocData_Pthreads(N_Vector v, sunindextype length)
+{
+  SUNMemoryHelper helper = NULL;
+  SUNMemory mem = NULL;
 
-/* ----------------------------------------------------------------------------
+  SUNContext_GetMemoryHelper(v->sunctx, &helper);
+
+  if (helper == NULL)
+    return((realtype *) malloc(length * sizeof(realtype)));
+
+  if (SUNMemoryHelper_Alloc(helper, &mem, length * sizeof(realtype),
+                            SUNMEMTYPE_HOST, NULL))
+    return(NULL);
+
+  NV_CONTENT_PT(v)->mem_helper = helper;
+  NV_CONTENT_PT(v)->mem        = mem;
+
+  return((realtype *) mem->ptr);
+}
+
+/* Free the data with the helper that allocated it */
+static void VFreeData_Pthreads(N_Vector v)
+{
+  if (NV_CONTENT_PT(v)->mem != NULL) {
+    SUNMemoryHelper_Dealloc(NV_CONTENT_PT(v)->mem_helper,
+                            NV_CONTENT_PT(v)->mem, NULL);
+    NV_CONTENT_PT(v)->mem_helper = NULL;
+    NV_CONTENT_PT(v)->mem        = NULL;
+  } else {
+    free(NV_DATA_PT(v));
+  }
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * private functions for special cases of vector operations
+ * -----------------------------------------------------------------
+ */
+
+
+/* ----------------------------------------------------------------------------
  * Copy vector components into second vector
  */
 
@@ -3886,20 +3561,13 @@ static void VCopy_Pthreads(N_Vector x, N_Vector z)
 {
   sunindextype      N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -3910,19 +3578,12 @@ static void VCopy_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VCopy_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VCopy_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -3953,7 +3614,7 @@ static void *VCopy_PT(void *thread_data)
     zd[i] = xd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3965,20 +3626,13 @@ static void VSum_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype      N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -3990,19 +3644,12 @@ static void VSum_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VSum_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VSum_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4034,7 +3681,7 @@ static void *VSum_PT(void *thread_data)
     zd[i] = xd[i] + yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4046,20 +3693,13 @@ static void VDiff_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -4071,19 +3711,12 @@ static void VDiff_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VDiff_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VDiff_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4115,7 +3748,7 @@ static void *VDiff_PT(void *thread_data)
     zd[i] = xd[i] - yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4127,20 +3760,13 @@ static void VNeg_Pthreads(N_Vector x, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -4151,19 +3777,12 @@ static void VNeg_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VNeg_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VNeg_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4194,7 +3813,7 @@ static void *VNeg_PT(void *thread_data)
     zd[i] = -xd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4206,20 +3825,13 @@ static void VScaleSum_Pthreads(realtype c, N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -4232,19 +3844,12 @@ static void VScaleSum_Pthreads(realtype c, N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VScaleSum_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VScaleSum_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4278,7 +3883,7 @@ static void *VScaleSum_PT(void *thread_data)
     zd[i] = c*(xd[i] + yd[i]);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4290,20 +3895,13 @@ static void VScaleDiff_Pthreads(realtype c, N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -4316,19 +3914,12 @@ static void VScaleDiff_Pthreads(realtype c, N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VScaleDiff_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VScaleDiff_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4362,7 +3953,7 @@ static void *VScaleDiff_PT(void *thread_data)
     zd[i] = c*(xd[i] - yd[i]);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4374,20 +3965,13 @@ static void VLin1_Pthreads(realtype a, N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -4400,19 +3984,12 @@ static void VLin1_Pthreads(realtype a, N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VLin1_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VLin1_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4446,7 +4023,7 @@ static void *VLin1_PT(void *thread_data)
     zd[i] = (a*xd[i]) + yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4458,20 +4035,13 @@ static void VLin2_Pthreads(realtype a, N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -4484,19 +4054,12 @@ static void VLin2_Pthreads(realtype a, N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VLin2_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VLin2_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4529,7 +4092,7 @@ static void *VLin2_PT(void *thread_data)
     zd[i] = (a*xd[i]) - yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4541,20 +4104,13 @@ static void Vaxpy_Pthreads(realtype a, N_Vector x, N_Vector y)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -4566,19 +4122,12 @@ static void Vaxpy_Pthreads(realtype a, N_Vector x, N_Vector y)
     thread_data[i].c1 = a;
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, Vaxpy_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, Vaxpy_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4611,7 +4160,7 @@ static void *Vaxpy_PT(void *thread_data)
       yd[i] += xd[i];
 
     /* exit */
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   if (a == -ONE) {
@@ -4619,14 +4168,14 @@ static void *Vaxpy_PT(void *thread_data)
       yd[i] -= xd[i];
 
     /* exit */
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   for (i = start; i < end; i++)
     yd[i] += a*xd[i];
 
   /* return */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4638,20 +4187,13 @@ static void VScaleBy_Pthreads(realtype a, N_Vector x)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
     N_VInitThreadData(&thread_data[i]);
@@ -4662,19 +4204,12 @@ static void VScaleBy_Pthreads(realtype a, N_Vector x)
     /* pack thread data */
     thread_data[i].c1 = a;
     thread_data[i].v1 = NV_DATA_PT(x);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VScaleBy_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(x), nthreads, VScaleBy_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4706,7 +4241,7 @@ static void *VScaleBy_PT(void *thread_data)
     xd[i] *= a;
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4720,21 +4255,14 @@ static int VSumVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y, N_Vector
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -4744,17 +4272,12 @@ static int VSumVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y, N_Vector
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VSumVectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(X[0]), nthreads, VSumVectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -4782,7 +4305,7 @@ static void *VSumVectorArray_PT(void *thread_data)
       zd[j] = xd[j] + yd[j];
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4790,21 +4313,14 @@ static int VDiffVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y, N_Vecto
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -4814,17 +4330,12 @@ static int VDiffVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y, N_Vecto
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VDiffVectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(X[0]), nthreads, VDiffVectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -4852,7 +4363,7 @@ static void *VDiffVectorArray_PT(void *thread_data)
       zd[j] = xd[j] - yd[j];
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4860,21 +4371,14 @@ static int VScaleSumVectorArray_Pthreads(int nvec, realtype c, N_Vector* X, N_Ve
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N            = NV_LENGTH_PT(X[0]);
   nthreads     = NV_NUM_THREADS_PT(X[0]);
-  threads      = malloc(nthreads*sizeof(pthread_t));
   thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -4885,17 +4389,12 @@ static int VScaleSumVectorArray_Pthreads(int nvec, realtype c, N_Vector* X, N_Ve
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VScaleSumVectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(X[0]), nthreads, VScaleSumVectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -4925,7 +4424,7 @@ static void *VScaleSumVectorArray_PT(void *thread_data)
       zd[j] = c * (xd[j] + yd[j]);
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4933,21 +4432,14 @@ static int VScaleDiffVectorArray_Pthreads(int nvec, realtype c, N_Vector* X, N_V
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -4958,17 +4450,12 @@ static int VScaleDiffVectorArray_Pthreads(int nvec, realtype c, N_Vector* X, N_V
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VScaleDiffVectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(X[0]), nthreads, VScaleDiffVectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -4998,7 +4485,7 @@ static void *VScaleDiffVectorArray_PT(void *thread_data)
       zd[j] = c * (xd[j] - yd[j]);
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -5006,21 +4493,14 @@ static int VLin1VectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -5031,17 +4511,12 @@ static int VLin1VectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VLin1VectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(X[0]), nthreads, VLin1VectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -5071,7 +4546,7 @@ static void *VLin1VectorArray_PT(void *thread_data)
       zd[j] = (a * xd[j]) + yd[j];
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -5079,21 +4554,14 @@ static int VLin2VectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -5104,17 +4572,12 @@ static int VLin2VectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VLin2VectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(X[0]), nthreads, VLin2VectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -5144,7 +4607,7 @@ static void *VLin2VectorArray_PT(void *thread_data)
       zd[j] = (a * xd[j]) - yd[j];
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -5152,21 +4615,14 @@ static int VaxpyVectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* allocate thread data structs */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
   thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -5176,17 +4632,12 @@ static int VaxpyVectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
     thread_data[i].Y2   = Y;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VaxpyVectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(X[0]), nthreads, VaxpyVectorArray_PT, thread_data);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return(0);
@@ -5214,7 +4665,7 @@ static void *VaxpyVectorArray_PT(void *thread_data)
       for (j=start; j<end; j++)
         yd[j] += xd[j];
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   if (a == -ONE) {
@@ -5224,7 +4675,7 @@ static void *VaxpyVectorArray_PT(void *thread_data)
       for (j=start; j<end; j++)
         yd[j] -= xd[j];
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   for (i=0; i<my_data->nvec; i++) {
@@ -5233,7 +4684,7 @@ static void *VaxpyVectorArray_PT(void *thread_data)
     for (j=start; j<end; j++)
       yd[j] += a * xd[j];
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -5296,6 +4747,281 @@ static void N_VInitThreadData(Pthreads_Data *thread_data)
   thread_data->Y1 = NULL;
   thread_data->Y2 = NULL;
   thread_data->Y3 = NULL;
+
+  thread_data->task      = 0;
+  thread_data->loop_body = NULL;
+  thread_data->loop_data = NULL;
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * thread pool functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Create an (idle) thread pool, worker threads are started on first use
+ */
+
+static N_VThreadPool_Pthreads N_VThreadPoolCreate(void)
+{
+  N_VThreadPool_Pthreads pool;
+
+  pool = NULL;
+  pool = (N_VThreadPool_Pthreads) malloc(sizeof *pool);
+  if (pool == NULL) return(NULL);
+
+  pool->refcount   = 1;
+  pool->nworkers   = 0;
+  pool->maxworkers = 0;
+  pool->workers    = NULL;
+  pool->args       = NULL;
+  pool->generation = 0;
+  pool->pending    = 0;
+  pool->ntasks     = 0;
+  pool->func       = NULL;
+  pool->task_data  = NULL;
+  pool->shutdown   = SUNFALSE;
+  pool->pin        = SUNFALSE;
+
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_mutex_init(&pool->run_lock, NULL);
+  pthread_cond_init(&pool->work_cv, NULL);
+  pthread_cond_init(&pool->done_cv, NULL);
+
+  return(pool);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Add a reference to a thread pool (e.g., when cloning a vector)
+ */
+
+static void N_VThreadPoolRetain(N_VThreadPool_Pthreads pool)
+{
+  if (pool == NULL) return;
+
+  pthread_mutex_lock(&pool->lock);
+  pool->refcount++;
+  pthread_mutex_unlock(&pool->lock);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Remove a reference to a thread pool, the last reference stops the worker
+ * threads and frees the pool
+ */
+
+static void N_VThreadPoolRelease(N_VThreadPool_Pthreads pool)
+{
+  int i, refcount;
+
+  if (pool == NULL) return;
+
+  pthread_mutex_lock(&pool->lock);
+  refcount = --pool->refcount;
+  if (refcount == 0) {
+    pool->shutdown = SUNTRUE;
+    pthread_cond_broadcast(&pool->work_cv);
+  }
+  pthread_mutex_unlock(&pool->lock);
+
+  if (refcount > 0) return;
+
+  for (i=0; i<pool->nworkers; i++) {
+    pthread_join(pool->workers[i], NULL);
+    free(pool->args[i]);
+  }
+
+  pthread_cond_destroy(&pool->done_cv);
+  pthread_cond_destroy(&pool->work_cv);
+  pthread_mutex_destroy(&pool->run_lock);
+  pthread_mutex_destroy(&pool->lock);
+
+  free(pool->workers);
+  free(pool->args);
+  free(pool);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Pin a worker thread to a core (workers are placed round-robin starting
+ * after core 0 which is left to the calling thread)
+ */
+
+static void N_VThreadPoolPin(pthread_t thread, int id)
+{
+#if defined(__linux__)
+  cpu_set_t cpuset;
+  long      ncpus;
+
+  ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (ncpus < 1) return;
+
+  CPU_ZERO(&cpuset);
+  CPU_SET((int) ((id + 1) % ncpus), &cpuset);
+
+  /* pinning is a performance hint, failures are ignored */
+  (void) pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuset);
+#endif
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Worker thread main loop: sleep until a new job is posted, execute the task
+ * matching the worker id, and signal completion
+ */
+
+static void *N_VThreadPoolWorker(void *worker_arg)
+{
+  N_VThreadPoolArg       *arg;
+  N_VThreadPool_Pthreads pool;
+  Pthreads_Data          *data;
+  unsigned long          seen;
+  int                    task;
+  void*                  (*func)(void*);
+
+  arg  = (N_VThreadPoolArg *) worker_arg;
+  pool = arg->pool;
+  task = arg->id + 1;  /* task 0 is executed by the calling thread */
+
+  pthread_mutex_lock(&pool->lock);
+  seen = arg->generation;
+
+  for (;;) {
+    while (pool->generation == seen && !pool->shutdown)
+      pthread_cond_wait(&pool->work_cv, &pool->lock);
+
+    if (pool->shutdown) break;
+
+    seen = pool->generation;
+
+    if (task < pool->ntasks) {
+      func = pool->func;
+      data = &pool->task_data[task];
+      pthread_mutex_unlock(&pool->lock);
+      func((void *) data);
+      pthread_mutex_lock(&pool->lock);
+      if (--pool->pending == 0) pthread_cond_signal(&pool->done_cv);
+    }
+  }
+
+  pthread_mutex_unlock(&pool->lock);
+
+  return(NULL);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Start additional worker threads so the pool has (at least) nworkers
+ * threads. Returns the number of running workers which may be less than
+ * requested if threads could not be created. Must be called while holding
+ * the pool run lock.
+ */
+
+static int N_VThreadPoolGrow(N_VThreadPool_Pthreads pool, int nworkers)
+{
+  pthread_t         *workers;
+  N_VThreadPoolArg  **args;
+  pthread_attr_t    attr;
+  int               i;
+
+  if (nworkers <= pool->nworkers) return(pool->nworkers);
+
+  /* resize worker arrays */
+  if (nworkers > pool->maxworkers) {
+    workers = (pthread_t *) realloc(pool->workers, nworkers*sizeof(pthread_t));
+    if (workers == NULL) return(pool->nworkers);
+    pool->workers = workers;
+
+    args = (N_VThreadPoolArg **) realloc(pool->args,
+                                         nworkers*sizeof(N_VThreadPoolArg *));
+    if (args == NULL) return(pool->nworkers);
+    pool->args = args;
+
+    pool->maxworkers = nworkers;
+  }
+
+  /* set thread attributes */
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+
+  for (i=pool->nworkers; i<nworkers; i++) {
+    pool->args[i] = (N_VThreadPoolArg *) malloc(sizeof(N_VThreadPoolArg));
+    if (pool->args[i] == NULL) break;
+
+    pool->args[i]->pool = pool;
+    pool->args[i]->id   = i;
+
+    /* no job is in flight while the run lock is held */
+    pool->args[i]->generation = pool->generation;
+
+    if (pthread_create(&pool->workers[i], &attr, N_VThreadPoolWorker,
+                       (void *) pool->args[i])) {
+      free(pool->args[i]);
+      break;
+    }
+
+    if (pool->pin) N_VThreadPoolPin(pool->workers[i], i);
+
+    pool->nworkers++;
+  }
+
+  pthread_attr_destroy(&attr);
+
+  return(pool->nworkers);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Execute a pthread companion function for each of the ntasks thread data
+ * structs. The calling thread executes the first task and the remaining tasks
+ * are handed to the persistent worker threads. If the pool could not start
+ * enough workers, the leftover tasks are executed by the calling thread.
+ */
+
+static void N_VRunThreadPool(N_VThreadPool_Pthreads pool, int ntasks,
+                             void* (*func)(void*), Pthreads_Data *thread_data)
+{
+  int i, nworkers;
+
+  /* nothing to hand off */
+  if (pool == NULL || ntasks < 2) {
+    for (i=0; i<ntasks; i++) func((void *) &thread_data[i]);
+    return;
+  }
+
+  /* only one job may use the pool at a time */
+  pthread_mutex_lock(&pool->run_lock);
+
+  nworkers = N_VThreadPoolGrow(pool, ntasks - 1);
+  if (nworkers > ntasks - 1) nworkers = ntasks - 1;
+
+  /* post the job and wake the workers */
+  pthread_mutex_lock(&pool->lock);
+  pool->func      = func;
+  pool->task_data = thread_data;
+  pool->ntasks    = nworkers + 1;
+  pool->pending   = nworkers;
+  pool->generation++;
+  pthread_cond_broadcast(&pool->work_cv);
+  pthread_mutex_unlock(&pool->lock);
+
+  /* execute the first task and any tasks without a worker */
+  func((void *) &thread_data[0]);
+  for (i=nworkers+1; i<ntasks; i++) func((void *) &thread_data[i]);
+
+  /* wait for the workers to finish */
+  pthread_mutex_lock(&pool->lock);
+  while (pool->pending > 0)
+    pthread_cond_wait(&pool->done_cv, &pool->lock);
+  pool->func      = NULL;
+  pool->task_data = NULL;
+  pool->ntasks    = 0;
+  pthread_mutex_unlock(&pool->lock);
+
+  pthread_mutex_unlock(&pool->run_lock);
 }
 
 
@@ -5532,3 +5258,106 @@ int N_VEnableLinearCombinationVectorArray_Pthreads(N_Vector v, booleantype tf)
   /* return success */
   return(0);
 }
+
+
+/*
+ * -----------------------------------------------------------------
+ * Thread pool options
+ * -----------------------------------------------------------------
+ */
+
+int N_VEnableThreadPinning_Pthreads(N_Vector v, booleantype tf)
+{
+  N_VThreadPool_Pthreads pool;
+  int i;
+
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that content and pool are non-NULL */
+  if (v->content == NULL) return(-1);
+  pool = NV_POOL_PT(v);
+  if (pool == NULL) return(-1);
+
+#if !defined(__linux__)
+  /* thread affinity is not supported on this platform */
+  if (tf) return(-1);
+#endif
+
+  /* update the setting for all vectors sharing the pool and pin any
+     workers that are already running */
+  pthread_mutex_lock(&pool->run_lock);
+  pool->pin = tf;
+  if (tf) {
+    for (i=0; i<pool->nworkers; i++)
+      N_VThreadPoolPin(pool->workers[i], i);
+  }
+  pthread_mutex_unlock(&pool->run_lock);
+
+  /* return success */
+  return(0);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Run a loop over the indices of the vector v on its thread pool. The index
+ * range is split in the same way as for the vector operations, so body sees
+ * the same [start, end) ranges for a given task as the companion functions.
+ */
+
+int N_VParallelFor_Pthreads(N_Vector v, N_VLoopBody_Pthreads body, void* data)
+{
+  sunindextype   N;
+  int            i, nthreads;
+  Pthreads_Data  *thread_data;
+
+  /* check for valid inputs */
+  if (v == NULL || body == NULL) return(-1);
+  if (v->content == NULL) return(-1);
+
+  /* allocate thread data structs */
+  N            = NV_LENGTH_PT(v);
+  nthreads     = NV_NUM_THREADS_PT(v);
+  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
+  if (thread_data == NULL) return(-1);
+
+  for (i=0; i<nthreads; i++) {
+    /* initialize thread data */
+    N_VInitThreadData(&thread_data[i]);
+
+    /* compute start and end loop index for thread */
+    N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
+
+    /* pack thread data */
+    thread_data[i].task      = i;
+    thread_data[i].loop_body = body;
+    thread_data[i].loop_data = data;
+  }
+
+  /* run companion function on the thread pool */
+  N_VRunThreadPool(NV_POOL_PT(v), nthreads, N_VParallelFor_PT, thread_data);
+
+  /* clean up and return */
+  free(thread_data);
+
+  return(0);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Pthread companion function to N_VParallelFor
+ */
+
+static void *N_VParallelFor_PT(void *thread_data)
+{
+  Pthreads_Data *my_data;
+
+  /* extract thread data */
+  my_data = (Pthreads_Data *) thread_data;
+
+  /* run the loop body on the range of this thread */
+  my_data->loop_body(my_data->start, my_data->end, my_data->task,
+                     my_data->loop_data);
+
+  return(NULL);
+}
@@ -28,6 +28,10 @@
 #define ONE    RCONST(1.0)
 #define ONEPT5 RCONST(1.5)
 
+/* Private functions to allocate and free the vector data */
+static realtype* VAllocData_Serial(N_Vector v, sunindextype length);
+static void VFreeData_Serial(N_Vector v);
+
 /* Private functions for special cases of vector operations */
 static void VCopy_Serial(N_Vector x, N_Vector z);                              /* z=x       */
 static void VSum_Serial(N_Vector x, N_Vector y, N_Vector z);                   /* z=x+y     */
@@ -149,6 +153,8 @@ N_Vector N_VNewEmpty_Serial(sunindextype length, SUNContext sunctx)
   content->length   = length;
   content->own_data = SUNFALSE;
   content->data     = NULL;
+  content->mem_helper = NULL;
+  content->mem      = NULL;
 
   return(v);
 }
@@ -171,7 +177,7 @@ N_Vector N_VNew_Serial(sunindextype length, SUNContext sunctx)
 
     /* Allocate memory */
     data = NULL;
-    data = (realtype *) malloc(length * sizeof(realtype));
+    data = VAllocData_Serial(v, length);
     if(data == NULL) { N_VDestroy_Serial(v); return(NULL); }
 
     /* Attach data */
@@ -310,6 +316,8 @@ N_Vector N_VCloneEmpty_Serial(N_Vector w)
   content->length   = NV_LENGTH_S(w);
   content->own_data = SUNFALSE;
   content->data     = NULL;
+  content->mem_helper = NULL;
+  content->mem      = NULL;
 
   return(v);
 }
@@ -331,7 +339,7 @@ N_Vector N_VClone_Serial(N_Vector w)
 
     /* Allocate memory */
     data = NULL;
-    data = (realtype *) malloc(length * sizeof(realtype));
+    data = VAllocData_Serial(v, length);
     if(data == NULL) { N_VDestroy_Serial(v); return(NULL); }
 
     /* Attach data */
@@ -351,7 +359,7 @@ void N_VDestroy_Serial(N_Vector v)
   if (v->content != NULL) {
     /* free data array if it's owned by the vector */
     if (NV_OWN_DATA_S(v) && NV_DATA_S(v) != NULL) {
-      free(NV_DATA_S(v));
+      VFreeData_Serial(v);
       NV_DATA_S(v) = NULL;
     }
     free(v->content);
@@ -1547,6 +1555,48 @@ int N_VBufUnpack_Serial(N_Vector x, void *buf)
 }
 
 
+/*
+ * -----------------------------------------------------------------
+ * private functions to allocate and free the vector data
+ * -----------------------------------------------------------------
+ */
+
+/* Allocate the data through the memory helper attached to the context if
+   there is one, otherwise with malloc */
+static realtype* VAllocData_Serial(N_Vector v, sunindextype length)
+{
+  SUNMemoryHelper helper = NULL;
+  SUNMemory mem = NULL;
+
+  SUNContext_GetMemoryHelper(v->sunctx, &helper);
+
+  if (helper == NULL)
+    return((realtype *) malloc(length * sizeof(realtype)));
+
+  if (SUNMemoryHelper_Alloc(helper, &mem, length * sizeof(realtype),
+                            SUNMEMTYPE_HOST, NULL))
+    return(NULL);
+
+  NV_CONTENT_S(v)->mem_helper = helper;
+  NV_CONTENT_S(v)->mem        = mem;
+
+  return((realtype *) mem->ptr);
+}
+
+/* Free the data with the helper that allocated it */
+static void VFreeData_Serial(N_Vector v)
+{
+  if (NV_CONTENT_S(v)->mem != NULL) {
+    SUNMemoryHelper_Dealloc(NV_CONTENT_S(v)->mem_helper,
+                            NV_CONTENT_S(v)->mem, NULL);
+    NV_CONTENT_S(v)->mem_helper = NULL;
+    NV_CONTENT_S(v)->mem        = NULL;
+  } else {
+    free(NV_DATA_S(v));
+  }
+}
+
+
 /*
  * -----------------------------------------------------------------
  * private functions for special cases of vector operations
@@ -0,0 +1,352 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * This is the implementation file for the SUNAdaptController module
+ * implementing Soderlind's digital filter step size controllers.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sunadaptcontroller/sunadaptcontroller_soderlind.h>
+#include <sundials/sundials_math.h>
+
+/* Content structure accessibility macros */
+#define SODERLIND_CONTENT(C) ( (SUNAdaptControllerContent_Soderlind)(C->content) )
+
+/* Constant macros */
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+#define TINY RCONST(1.0e-10)  /* lower bound on the error estimates */
+
+/* Format for printing realtype values */
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define RSYM ".32Lg"
+#else
+#define RSYM ".16g"
+#endif
+
+/* Default parameters of the classical controllers, these match the ARKODE
+   built-in adaptivity methods */
+#define PID_K1    RCONST(0.58)
+#define PID_K2    RCONST(0.21)
+#define PID_K3    RCONST(0.1)
+#define PI_K1     RCONST(0.8)
+#define PI_K2     RCONST(0.31)
+#define I_K1      RCONST(1.0)
+#define EXPGUS_K1 RCONST(0.367)
+#define EXPGUS_K2 RCONST(0.268)
+#define IMPGUS_K1 RCONST(0.98)
+#define IMPGUS_K2 RCONST(0.95)
+
+/* Parameters of the digital filters, Soderlind (2003) Table 1. H211 is the
+   H211b filter with b = 4 and H312 is the H312PID filter. */
+#define H0211_K1  RCONST(0.5)
+#define H0211_K2  RCONST(0.5)
+#define H0211_K4  RCONST(-0.5)
+#define H0321_K1  RCONST(1.25)
+#define H0321_K2  RCONST(0.5)
+#define H0321_K3  RCONST(-0.75)
+#define H0321_K4  RCONST(0.25)
+#define H0321_K5  RCONST(0.75)
+#define H211_K1   RCONST(0.25)
+#define H211_K2   RCONST(0.25)
+#define H211_K4   RCONST(-0.25)
+#define H312_K1   (ONE/RCONST(18.0))
+#define H312_K2   (ONE/RCONST(9.0))
+#define H312_K3   (ONE/RCONST(18.0))
+
+/* -----------------------------------------------------------------------------
+ * Constructors
+ * ---------------------------------------------------------------------------*/
+
+SUNAdaptController SUNAdaptController_Soderlind(SUNContext sunctx)
+{
+  SUNAdaptController C;
+  SUNAdaptControllerContent_Soderlind content;
+
+  /* Create an empty controller object */
+  C = NULL;
+  C = SUNAdaptController_NewEmpty(sunctx);
+  if (C == NULL) return(NULL);
+
+  /* Attach operations */
+  C->ops->gettype      = SUNAdaptController_GetType_Soderlind;
+  C->ops->estimatestep = SUNAdaptController_EstimateStep_Soderlind;
+  C->ops->updateh      = SUNAdaptController_UpdateH_Soderlind;
+  C->ops->reset        = SUNAdaptController_Reset_Soderlind;
+  C->ops->setdefaults  = SUNAdaptController_SetDefaults_Soderlind;
+  C->ops->write        = SUNAdaptController_Write_Soderlind;
+  C->ops->space        = SUNAdaptController_Space_Soderlind;
+  C->ops->destroy      = SUNAdaptController_Destroy_Soderlind;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNAdaptControllerContent_Soderlind) malloc(sizeof *content);
+  if (content == NULL) {
+    SUNAdaptController_DestroyEmpty(C);
+    return(NULL);
+  }
+
+  /* Attach content */
+  C->content = content;
+
+  /* Fill content with default/reset values */
+  SUNAdaptController_SetDefaults_Soderlind(C);
+  SUNAdaptController_Reset_Soderlind(C);
+
+  return(C);
+}
+
+SUNAdaptController SUNAdaptController_PID(SUNContext sunctx)
+{
+  SUNAdaptController C = SUNAdaptController_Soderlind(sunctx);
+  if (C == NULL) return(NULL);
+  SUNAdaptController_SetParams_PID(C, PID_K1, PID_K2, PID_K3);
+  return(C);
+}
+
+SUNAdaptController SUNAdaptController_PI(SUNContext sunctx)
+{
+  SUNAdaptController C = SUNAdaptController_Soderlind(sunctx);
+  if (C == NULL) return(NULL);
+  SUNAdaptController_SetParams_PI(C, PI_K1, PI_K2);
+  return(C);
+}
+
+SUNAdaptController SUNAdaptController_I(SUNContext sunctx)
+{
+  SUNAdaptController C = SUNAdaptController_Soderlind(sunctx);
+  if (C == NULL) return(NULL);
+  SUNAdaptController_SetParams_I(C, I_K1);
+  return(C);
+}
+
+SUNAdaptController SUNAdaptController_ExpGus(SUNContext sunctx)
+{
+  SUNAdaptController C = SUNAdaptController_Soderlind(sunctx);
+  if (C == NULL) return(NULL);
+  SUNAdaptController_SetParams_ExpGus(C, EXPGUS_K1, EXPGUS_K2);
+  return(C);
+}
+
+SUNAdaptController SUNAdaptController_ImpGus(SUNContext sunctx)
+{
+  SUNAdaptController C = SUNAdaptController_Soderlind(sunctx);
+  if (C == NULL) return(NULL);
+  SUNAdaptController_SetParams_ImpGus(C, IMPGUS_K1, IMPGUS_K2);
+  return(C);
+}
+
+SUNAdaptController SUNAdaptController_H0211(SUNContext sunctx)
+{
+  SUNAdaptController C = SUNAdaptController_Soderlind(sunctx);
+  if (C == NULL) return(NULL);
+  SUNAdaptController_SetParams_Soderlind(C, H0211_K1, H0211_K2, ZERO,
+                                         H0211_K4, ZERO);
+  return(C);
+}
+
+SUNAdaptController SUNAdaptController_H0321(SUNContext sunctx)
+{
+  SUNAdaptController C = SUNAdaptController_Soderlind(sunctx);
+  if (C == NULL) return(NULL);
+  SUNAdaptController_SetParams_Soderlind(C, H0321_K1, H0321_K2, H0321_K3,
+                                         H0321_K4, H0321_K5);
+  return(C);
+}
+
+SUNAdaptController SUNAdaptController_H211(SUNContext sunctx)
+{
+  SUNAdaptController C = SUNAdaptController_Soderlind(sunctx);
+  if (C == NULL) return(NULL);
+  SUNAdaptController_SetParams_Soderlind(C, H211_K1, H211_K2, ZERO,
+                                         H211_K4, ZERO);
+  return(C);
+}
+
+SUNAdaptController SUNAdaptController_H312(SUNContext sunctx)
+{
+  SUNAdaptController C = SUNAdaptController_Soderlind(sunctx);
+  if (C == NULL) return(NULL);
+  SUNAdaptController_SetParams_Soderlind(C, H312_K1, H312_K2, H312_K3,
+                                         ZERO, ZERO);
+  return(C);
+}
+
+/* -----------------------------------------------------------------------------
+ * Parameter set routines
+ * ---------------------------------------------------------------------------*/
+
+int SUNAdaptController_SetParams_Soderlind(SUNAdaptController C,
+                                           realtype k1, realtype k2,
+                                           realtype k3, realtype k4,
+                                           realtype k5)
+{
+  if (C == NULL || C->content == NULL) return(SUNADAPTCONTROLLER_ILL_INPUT);
+  SODERLIND_CONTENT(C)->k1 = k1;
+  SODERLIND_CONTENT(C)->k2 = k2;
+  SODERLIND_CONTENT(C)->k3 = k3;
+  SODERLIND_CONTENT(C)->k4 = k4;
+  SODERLIND_CONTENT(C)->k5 = k5;
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
+
+/* h' = h e_n^(-k1/p) e_{n-1}^(k2/p) e_{n-2}^(-k3/p) */
+int SUNAdaptController_SetParams_PID(SUNAdaptController C, realtype k1,
+                                     realtype k2, realtype k3)
+{
+  return(SUNAdaptController_SetParams_Soderlind(C, k1, -k2, k3, ZERO, ZERO));
+}
+
+/* h' = h e_n^(-k1/p) e_{n-1}^(k2/p) */
+int SUNAdaptController_SetParams_PI(SUNAdaptController C, realtype k1,
+                                    realtype k2)
+{
+  return(SUNAdaptController_SetParams_Soderlind(C, k1, -k2, ZERO, ZERO, ZERO));
+}
+
+/* h' = h e_n^(-k1/p) */
+int SUNAdaptController_SetParams_I(SUNAdaptController C, realtype k1)
+{
+  return(SUNAdaptController_SetParams_Soderlind(C, k1, ZERO, ZERO, ZERO,
+                                                ZERO));
+}
+
+/* h' = h e_n^(-k1/p) (e_n/e_{n-1})^(-k2/p) */
+int SUNAdaptController_SetParams_ExpGus(SUNAdaptController C, realtype k1,
+                                        realtype k2)
+{
+  return(SUNAdaptController_SetParams_Soderlind(C, k1+k2, -k2, ZERO, ZERO,
+                                                ZERO));
+}
+
+/* h' = h (h_n/h_{n-1}) e_n^(-k1/p) (e_n/e_{n-1})^(-k2/p) */
+int SUNAdaptController_SetParams_ImpGus(SUNAdaptController C, realtype k1,
+                                        realtype k2)
+{
+  return(SUNAdaptController_SetParams_Soderlind(C, k1+k2, -k2, ZERO, ONE,
+                                                ZERO));
+}
+
+/* -----------------------------------------------------------------------------
+ * Implementation of operations
+ * ---------------------------------------------------------------------------*/
+
+SUNAdaptController_Type SUNAdaptController_GetType_Soderlind(SUNAdaptController C)
+{
+  return(SUN_ADAPTCONTROLLER_H);
+}
+
+/* Until the history is full, the missing errors are replaced by the current
+   error and the missing step size ratios by one, so that the controller keeps
+   its overall gain during the first steps. */
+int SUNAdaptController_EstimateStep_Soderlind(SUNAdaptController C, realtype h,
+                                              int p, realtype dsm,
+                                              realtype* hnew)
+{
+  SUNAdaptControllerContent_Soderlind content;
+  realtype ord, e1, e2, e3, hrat, hrat2;
+
+  if (p <= 0) return(SUNADAPTCONTROLLER_ILL_INPUT);
+  content = SODERLIND_CONTENT(C);
+
+  ord   = (realtype) p;
+  e1    = SUNMAX(dsm, TINY);
+  e2    = (content->firststeps > 0) ? SUNMAX(content->ep, TINY) : e1;
+  e3    = (content->firststeps > 1) ? SUNMAX(content->epp, TINY) : e2;
+  hrat  = (content->firststeps > 0) ? h / content->hp : ONE;
+  hrat2 = (content->firststeps > 1) ? content->hp / content->hpp : ONE;
+
+  *hnew = h * SUNRpowerR(e1, -content->k1 / ord)
+            * SUNRpowerR(e2, -content->k2 / ord)
+            * SUNRpowerR(e3, -content->k3 / ord);
+  if (content->k4 != ZERO) *hnew *= SUNRpowerR(hrat, content->k4);
+  if (content->k5 != ZERO) *hnew *= SUNRpowerR(hrat2, content->k5);
+
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
+
+int SUNAdaptController_UpdateH_Soderlind(SUNAdaptController C, realtype h,
+                                         realtype dsm)
+{
+  SUNAdaptControllerContent_Soderlind content = SODERLIND_CONTENT(C);
+
+  content->epp = content->ep;
+  content->ep  = dsm;
+  content->hpp = content->hp;
+  content->hp  = h;
+  if (content->firststeps < 2) content->firststeps++;
+
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
+
+int SUNAdaptController_Reset_Soderlind(SUNAdaptController C)
+{
+  SUNAdaptControllerContent_Soderlind content = SODERLIND_CONTENT(C);
+
+  content->ep         = ONE;
+  content->epp        = ONE;
+  content->hp         = ZERO;
+  content->hpp        = ZERO;
+  content->firststeps = 0;
+
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
+
+int SUNAdaptController_SetDefaults_Soderlind(SUNAdaptController C)
+{
+  return(SUNAdaptController_SetParams_PID(C, PID_K1, PID_K2, PID_K3));
+}
+
+int SUNAdaptController_Write_Soderlind(SUNAdaptController C, FILE *fptr)
+{
+  SUNAdaptControllerContent_Soderlind content = SODERLIND_CONTENT(C);
+
+  fprintf(fptr, "Soderlind SUNAdaptController module:\n");
+  fprintf(fptr, "  k1 = %"RSYM"\n", content->k1);
+  fprintf(fptr, "  k2 = %"RSYM"\n", content->k2);
+  fprintf(fptr, "  k3 = %"RSYM"\n", content->k3);
+  fprintf(fptr, "  k4 = %"RSYM"\n", content->k4);
+  fprintf(fptr, "  k5 = %"RSYM"\n", content->k5);
+  fprintf(fptr, "  previous errors = %"RSYM"  %"RSYM"\n",
+          content->ep, content->epp);
+  fprintf(fptr, "  previous step sizes = %"RSYM"  %"RSYM"\n",
+          content->hp, content->hpp);
+  fprintf(fptr, "  firststeps = %i\n", content->firststeps);
+
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
+
+int SUNAdaptController_Space_Soderlind(SUNAdaptController C, long int* lenrw,
+                                       long int* leniw)
+{
+  *lenrw = 9;
+  *leniw = 1;
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
+
+int SUNAdaptController_Destroy_Soderlind(SUNAdaptController C)
+{
+  if (C == NULL) return(SUNADAPTCONTROLLER_SUCCESS);
+
+  /* free content */
+  if (C->content != NULL) {
+    free(C->content);
+    C->content = NULL;
+  }
+
+  /* free ops and controller */
+  SUNAdaptController_DestroyEmpty(C);
+  C = NULL;
+
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
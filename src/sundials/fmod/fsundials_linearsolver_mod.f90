@@ -85,6 +85,9 @@ module fsundials_linearsolver_mod
   enumerator :: SUNLINEARSOLVER_ONEMKLDENSE
   enumerator :: SUNLINEARSOLVER_GINKGO
   enumerator :: SUNLINEARSOLVER_KOKKOSDENSE
+  enumerator :: SUNLINEARSOLVER_BLOCKDENSE
+  enumerator :: SUNLINEARSOLVER_SSGMR
+  enumerator :: SUNLINEARSOLVER_ILU
   enumerator :: SUNLINEARSOLVER_CUSTOM
  end enum
  integer, parameter, public :: SUNLinearSolver_ID = kind(SUNLINEARSOLVER_BAND)
@@ -92,7 +95,7 @@ module fsundials_linearsolver_mod
     SUNLINEARSOLVER_LAPACKDENSE, SUNLINEARSOLVER_PCG, SUNLINEARSOLVER_SPBCGS, SUNLINEARSOLVER_SPFGMR, SUNLINEARSOLVER_SPGMR, &
     SUNLINEARSOLVER_SPTFQMR, SUNLINEARSOLVER_SUPERLUDIST, SUNLINEARSOLVER_SUPERLUMT, SUNLINEARSOLVER_CUSOLVERSP_BATCHQR, &
     SUNLINEARSOLVER_MAGMADENSE, SUNLINEARSOLVER_ONEMKLDENSE, SUNLINEARSOLVER_GINKGO, SUNLINEARSOLVER_KOKKOSDENSE, &
-    SUNLINEARSOLVER_CUSTOM
+    SUNLINEARSOLVER_BLOCKDENSE, SUNLINEARSOLVER_SSGMR, SUNLINEARSOLVER_ILU, SUNLINEARSOLVER_CUSTOM
  ! struct struct _generic_SUNLinearSolver_Ops
  type, bind(C), public :: SUNLinearSolver_Ops
   type(C_FUNPTR), public :: gettype
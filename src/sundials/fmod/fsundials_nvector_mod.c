@@ -970,6 +970,76 @@ SWIGEXPORT void _wrap_FN_VDestroyVectorArray(void *farg1, int const *farg2) {
 }
 
 
+SWIGEXPORT void * _wrap_FN_VCheckoutVectorArray(int const *farg1, N_Vector farg2) {
+  void * fresult ;
+  int arg1 ;
+  N_Vector arg2 = (N_Vector) 0 ;
+  N_Vector *result = 0 ;
+  
+  arg1 = (int)(*farg1);
+  arg2 = (N_Vector)(farg2);
+  result = (N_Vector *)N_VCheckoutVectorArray(arg1,arg2);
+  fresult = result;
+  return fresult;
+}
+
+
+SWIGEXPORT void _wrap_FN_VReturnVectorArray(void *farg1, int const *farg2) {
+  N_Vector *arg1 = (N_Vector *) 0 ;
+  int arg2 ;
+  
+  arg1 = (N_Vector *)(farg1);
+  arg2 = (int)(*farg2);
+  N_VReturnVectorArray(arg1,arg2);
+}
+
+
+SWIGEXPORT int _wrap_FSUNContext_EnableVectorPool(void *farg1, int const *farg2) {
+  int fresult ;
+  SUNContext arg1 = (SUNContext) 0 ;
+  int arg2 ;
+  int result;
+  
+  arg1 = (SUNContext)(farg1);
+  arg2 = (int)(*farg2);
+  result = (int)SUNContext_EnableVectorPool(arg1,arg2);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT int _wrap_FSUNContext_ReleaseVectorPool(void *farg1) {
+  int fresult ;
+  SUNContext arg1 = (SUNContext) 0 ;
+  int result;
+  
+  arg1 = (SUNContext)(farg1);
+  result = (int)SUNContext_ReleaseVectorPool(arg1);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT int _wrap_FSUNContext_GetVectorPoolStats(void *farg1, long *farg2, long *farg3, long *farg4, long *farg5) {
+  int fresult ;
+  SUNContext arg1 = (SUNContext) 0 ;
+  long *arg2 = (long *) 0 ;
+  long *arg3 = (long *) 0 ;
+  long *arg4 = (long *) 0 ;
+  long *arg5 = (long *) 0 ;
+  int result;
+  
+  arg1 = (SUNContext)(farg1);
+  arg2 = (long *)(farg2);
+  arg3 = (long *)(farg3);
+  arg4 = (long *)(farg4);
+  arg5 = (long *)(farg5);
+  result = (int)SUNContext_GetVectorPoolStats(arg1,arg2,arg3,arg4,arg5);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
 SWIGEXPORT N_Vector _wrap_FN_VGetVecAtIndexVectorArray(void *farg1, int const *farg2) {
   N_Vector fresult ;
   N_Vector *arg1 = (N_Vector *) 0 ;
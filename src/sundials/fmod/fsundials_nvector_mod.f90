@@ -36,6 +36,14 @@ module fsundials_nvector_mod
     SUNDIALS_NVEC_PETSC, SUNDIALS_NVEC_CUDA, SUNDIALS_NVEC_HIP, SUNDIALS_NVEC_SYCL, SUNDIALS_NVEC_RAJA, SUNDIALS_NVEC_KOKKOS, &
     SUNDIALS_NVEC_OPENMPDEV, SUNDIALS_NVEC_TRILINOS, SUNDIALS_NVEC_MANYVECTOR, SUNDIALS_NVEC_MPIMANYVECTOR, &
     SUNDIALS_NVEC_MPIPLUSX, SUNDIALS_NVEC_CUSTOM
+ ! typedef enum N_VReduceOp
+ enum, bind(c)
+  enumerator :: SUN_REDUCE_SUM
+  enumerator :: SUN_REDUCE_MAX
+  enumerator :: SUN_REDUCE_MIN
+ end enum
+ integer, parameter, public :: N_VReduceOp = kind(SUN_REDUCE_SUM)
+ public :: SUN_REDUCE_SUM, SUN_REDUCE_MAX, SUN_REDUCE_MIN
  ! struct struct _generic_N_Vector_Ops
  type, bind(C), public :: N_Vector_Ops
   type(C_FUNPTR), public :: nvgetvectorid
@@ -89,6 +97,8 @@ module fsundials_nvector_mod
   type(C_FUNPTR), public :: nvwsqrsummasklocal
   type(C_FUNPTR), public :: nvdotprodmultilocal
   type(C_FUNPTR), public :: nvdotprodmultiallreduce
+  type(C_FUNPTR), public :: nvallreducestart
+  type(C_FUNPTR), public :: nvallreducefinish
   type(C_FUNPTR), public :: nvbufsize
   type(C_FUNPTR), public :: nvbufpack
   type(C_FUNPTR), public :: nvbufunpack
@@ -158,6 +168,11 @@ module fsundials_nvector_mod
  public :: FN_VCloneEmptyVectorArray
  public :: FN_VCloneVectorArray
  public :: FN_VDestroyVectorArray
+ public :: FN_VCheckoutVectorArray
+ public :: FN_VReturnVectorArray
+ public :: FSUNContext_EnableVectorPool
+ public :: FSUNContext_ReleaseVectorPool
+ public :: FSUNContext_GetVectorPoolStats
  public :: FN_VGetVecAtIndexVectorArray
  public :: FN_VSetVecAtIndexVectorArray
  public :: FN_VPrint
@@ -673,6 +688,51 @@ type(C_PTR), value :: farg1
 integer(C_INT), intent(in) :: farg2
 end subroutine
 
+function swigc_FN_VCheckoutVectorArray(farg1, farg2) &
+bind(C, name="_wrap_FN_VCheckoutVectorArray") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT), intent(in) :: farg1
+type(C_PTR), value :: farg2
+type(C_PTR) :: fresult
+end function
+
+subroutine swigc_FN_VReturnVectorArray(farg1, farg2) &
+bind(C, name="_wrap_FN_VReturnVectorArray")
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+end subroutine
+
+function swigc_FSUNContext_EnableVectorPool(farg1, farg2) &
+bind(C, name="_wrap_FSUNContext_EnableVectorPool") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FSUNContext_ReleaseVectorPool(farg1) &
+bind(C, name="_wrap_FSUNContext_ReleaseVectorPool") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT) :: fresult
+end function
+
+function swigc_FSUNContext_GetVectorPoolStats(farg1, farg2, farg3, farg4, farg5) &
+bind(C, name="_wrap_FSUNContext_GetVectorPoolStats") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+type(C_PTR), value :: farg3
+type(C_PTR), value :: farg4
+type(C_PTR), value :: farg5
+integer(C_INT) :: fresult
+end function
+
 function swigc_FN_VGetVecAtIndexVectorArray(farg1, farg2) &
 bind(C, name="_wrap_FN_VGetVecAtIndexVectorArray") &
 result(fresult)
@@ -1638,6 +1698,88 @@ farg2 = count
 call swigc_FN_VDestroyVectorArray(farg1, farg2)
 end subroutine
 
+function FN_VCheckoutVectorArray(count, w) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR) :: swig_result
+integer(C_INT), intent(in) :: count
+type(N_Vector), target, intent(inout) :: w
+type(C_PTR) :: fresult 
+integer(C_INT) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = count
+farg2 = c_loc(w)
+fresult = swigc_FN_VCheckoutVectorArray(farg1, farg2)
+swig_result = fresult
+end function
+
+subroutine FN_VReturnVectorArray(vs, count)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR) :: vs
+integer(C_INT), intent(in) :: count
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+
+farg1 = vs
+farg2 = count
+call swigc_FN_VReturnVectorArray(farg1, farg2)
+end subroutine
+
+function FSUNContext_EnableVectorPool(sunctx, onoff) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: sunctx
+integer(C_INT), intent(in) :: onoff
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+
+farg1 = sunctx
+farg2 = onoff
+fresult = swigc_FSUNContext_EnableVectorPool(farg1, farg2)
+swig_result = fresult
+end function
+
+function FSUNContext_ReleaseVectorPool(sunctx) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: sunctx
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+
+farg1 = sunctx
+fresult = swigc_FSUNContext_ReleaseVectorPool(farg1)
+swig_result = fresult
+end function
+
+function FSUNContext_GetVectorPoolStats(sunctx, num_clones, num_checkouts, num_in_use, max_in_use) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: sunctx
+integer(C_LONG), dimension(*), target, intent(inout) :: num_clones
+integer(C_LONG), dimension(*), target, intent(inout) :: num_checkouts
+integer(C_LONG), dimension(*), target, intent(inout) :: num_in_use
+integer(C_LONG), dimension(*), target, intent(inout) :: max_in_use
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+type(C_PTR) :: farg3 
+type(C_PTR) :: farg4 
+type(C_PTR) :: farg5 
+
+farg1 = sunctx
+farg2 = c_loc(num_clones(1))
+farg3 = c_loc(num_checkouts(1))
+farg4 = c_loc(num_in_use(1))
+farg5 = c_loc(max_in_use(1))
+fresult = swigc_FSUNContext_GetVectorPoolStats(farg1, farg2, farg3, farg4, farg5)
+swig_result = fresult
+end function
+
 function FN_VGetVecAtIndexVectorArray(vs, index) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
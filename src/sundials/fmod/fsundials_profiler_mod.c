@@ -299,6 +299,106 @@ SWIGEXPORT int _wrap_FSUNProfiler_Reset(void *farg1) {
 }
 
 
+SWIGEXPORT int _wrap_FSUNProfiler_GetTimerId(void *farg1, SwigArrayWrapper *farg2, int *farg3) {
+  int fresult ;
+  SUNProfiler arg1 = (SUNProfiler) 0 ;
+  char *arg2 = (char *) 0 ;
+  int *arg3 = (int *) 0 ;
+  int result;
+  
+  arg1 = (SUNProfiler)(farg1);
+  arg2 = (char *)(farg2->data);
+  arg3 = (int *)(farg3);
+  result = (int)SUNProfiler_GetTimerId(arg1,(char const *)arg2,arg3);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT int _wrap_FSUNProfiler_BeginId(void *farg1, int const *farg2) {
+  int fresult ;
+  SUNProfiler arg1 = (SUNProfiler) 0 ;
+  int arg2 ;
+  int result;
+  
+  arg1 = (SUNProfiler)(farg1);
+  arg2 = (int)(*farg2);
+  result = (int)SUNProfiler_BeginId(arg1,arg2);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT int _wrap_FSUNProfiler_EndId(void *farg1, int const *farg2) {
+  int fresult ;
+  SUNProfiler arg1 = (SUNProfiler) 0 ;
+  int arg2 ;
+  int result;
+  
+  arg1 = (SUNProfiler)(farg1);
+  arg2 = (int)(*farg2);
+  result = (int)SUNProfiler_EndId(arg1,arg2);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT int _wrap_FSUNProfiler_EnableTrace(void *farg1, long const *farg2) {
+  int fresult ;
+  SUNProfiler arg1 = (SUNProfiler) 0 ;
+  long arg2 ;
+  int result;
+  
+  arg1 = (SUNProfiler)(farg1);
+  arg2 = (long)(*farg2);
+  result = (int)SUNProfiler_EnableTrace(arg1,arg2);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT int _wrap_FSUNProfiler_EnableCounters(void *farg1, int const *farg2) {
+  int fresult ;
+  SUNProfiler arg1 = (SUNProfiler) 0 ;
+  int arg2 ;
+  int result;
+  
+  arg1 = (SUNProfiler)(farg1);
+  arg2 = (int)(*farg2);
+  result = (int)SUNProfiler_EnableCounters(arg1,arg2);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT int _wrap_FSUNProfiler_ExportTrace(void *farg1, void *farg2) {
+  int fresult ;
+  SUNProfiler arg1 = (SUNProfiler) 0 ;
+  FILE *arg2 = (FILE *) 0 ;
+  int result;
+  
+  arg1 = (SUNProfiler)(farg1);
+  arg2 = (FILE *)(farg2);
+  result = (int)SUNProfiler_ExportTrace(arg1,arg2);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT int _wrap_FSUNProfiler_ExportCSV(void *farg1, void *farg2) {
+  int fresult ;
+  SUNProfiler arg1 = (SUNProfiler) 0 ;
+  FILE *arg2 = (FILE *) 0 ;
+  int result;
+  
+  arg1 = (SUNProfiler)(farg1);
+  arg2 = (FILE *)(farg2);
+  result = (int)SUNProfiler_ExportCSV(arg1,arg2);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
 
 SWIGEXPORT int _wrap_FSUNProfiler_Create(void *farg1, SwigArrayWrapper *farg2, void *farg3) {
   int fresult ;
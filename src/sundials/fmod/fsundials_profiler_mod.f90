@@ -33,6 +33,13 @@ module fsundials_profiler_mod
  public :: FSUNProfiler_End
  public :: FSUNProfiler_Print
  public :: FSUNProfiler_Reset
+ public :: FSUNProfiler_GetTimerId
+ public :: FSUNProfiler_BeginId
+ public :: FSUNProfiler_EndId
+ public :: FSUNProfiler_EnableTrace
+ public :: FSUNProfiler_EnableCounters
+ public :: FSUNProfiler_ExportTrace
+ public :: FSUNProfiler_ExportCSV
 
   public :: FSUNProfiler_Create
 
@@ -84,6 +91,71 @@ type(C_PTR), value :: farg1
 integer(C_INT) :: fresult
 end function
 
+function swigc_FSUNProfiler_GetTimerId(farg1, farg2, farg3) &
+bind(C, name="_wrap_FSUNProfiler_GetTimerId") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+import :: swigarraywrapper
+type(C_PTR), value :: farg1
+type(SwigArrayWrapper) :: farg2
+type(C_PTR), value :: farg3
+integer(C_INT) :: fresult
+end function
+
+function swigc_FSUNProfiler_BeginId(farg1, farg2) &
+bind(C, name="_wrap_FSUNProfiler_BeginId") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FSUNProfiler_EndId(farg1, farg2) &
+bind(C, name="_wrap_FSUNProfiler_EndId") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FSUNProfiler_EnableTrace(farg1, farg2) &
+bind(C, name="_wrap_FSUNProfiler_EnableTrace") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_LONG), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FSUNProfiler_EnableCounters(farg1, farg2) &
+bind(C, name="_wrap_FSUNProfiler_EnableCounters") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FSUNProfiler_ExportTrace(farg1, farg2) &
+bind(C, name="_wrap_FSUNProfiler_ExportTrace") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FSUNProfiler_ExportCSV(farg1, farg2) &
+bind(C, name="_wrap_FSUNProfiler_ExportCSV") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 
 function swigc_FSUNProfiler_Create(farg1, farg2, farg3) &
 bind(C, name="_wrap_FSUNProfiler_Create") &
@@ -195,6 +267,122 @@ fresult = swigc_FSUNProfiler_Reset(farg1)
 swig_result = fresult
 end function
 
+function FSUNProfiler_GetTimerId(p, name, id) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: p
+character(kind=C_CHAR, len=*), target :: name
+character(kind=C_CHAR), dimension(:), allocatable, target :: farg2_chars
+integer(C_INT), dimension(*), target, intent(inout) :: id
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(SwigArrayWrapper) :: farg2 
+type(C_PTR) :: farg3 
+
+farg1 = p
+call SWIG_string_to_chararray(name, farg2_chars, farg2)
+farg3 = c_loc(id(1))
+fresult = swigc_FSUNProfiler_GetTimerId(farg1, farg2, farg3)
+swig_result = fresult
+end function
+
+function FSUNProfiler_BeginId(p, id) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: p
+integer(C_INT), intent(in) :: id
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+
+farg1 = p
+farg2 = id
+fresult = swigc_FSUNProfiler_BeginId(farg1, farg2)
+swig_result = fresult
+end function
+
+function FSUNProfiler_EndId(p, id) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: p
+integer(C_INT), intent(in) :: id
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+
+farg1 = p
+farg2 = id
+fresult = swigc_FSUNProfiler_EndId(farg1, farg2)
+swig_result = fresult
+end function
+
+function FSUNProfiler_EnableTrace(p, max_events) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: p
+integer(C_LONG), intent(in) :: max_events
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_LONG) :: farg2 
+
+farg1 = p
+farg2 = max_events
+fresult = swigc_FSUNProfiler_EnableTrace(farg1, farg2)
+swig_result = fresult
+end function
+
+function FSUNProfiler_EnableCounters(p, onoff) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: p
+integer(C_INT), intent(in) :: onoff
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+
+farg1 = p
+farg2 = onoff
+fresult = swigc_FSUNProfiler_EnableCounters(farg1, farg2)
+swig_result = fresult
+end function
+
+function FSUNProfiler_ExportTrace(p, fp) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: p
+type(C_PTR) :: fp
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = p
+farg2 = fp
+fresult = swigc_FSUNProfiler_ExportTrace(farg1, farg2)
+swig_result = fresult
+end function
+
+function FSUNProfiler_ExportCSV(p, fp) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(C_PTR) :: p
+type(C_PTR) :: fp
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = p
+farg2 = fp
+fresult = swigc_FSUNProfiler_ExportCSV(farg1, farg2)
+swig_result = fresult
+end function
+
 
 function FSUNProfiler_Create(comm, title, p) &
 result(swig_result)
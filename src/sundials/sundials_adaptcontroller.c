@@ -0,0 +1,169 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * This is the implementation file for a generic SUNAdaptController package. It
+ * contains the implementation of the SUNAdaptController operations listed in
+ * the 'ops' structure in sundials_adaptcontroller.h
+ * ---------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <sundials/sundials_adaptcontroller.h>
+#include "sundials_context_impl.h"
+
+#if defined(SUNDIALS_BUILD_WITH_PROFILING)
+static SUNProfiler getSUNProfiler(SUNAdaptController C)
+{
+  return(C->sunctx->profiler);
+}
+#endif
+
+/* -----------------------------------------------------------------------------
+ * Create a new empty SUNAdaptController object
+ * ---------------------------------------------------------------------------*/
+
+SUNAdaptController SUNAdaptController_NewEmpty(SUNContext sunctx)
+{
+  SUNAdaptController     C;
+  SUNAdaptController_Ops ops;
+
+  /* check input */
+  if (!sunctx) return(NULL);
+
+  /* create controller object */
+  C = NULL;
+  C = (SUNAdaptController) malloc(sizeof *C);
+  if (C == NULL) return(NULL);
+
+  /* create controller ops structure */
+  ops = NULL;
+  ops = (SUNAdaptController_Ops) malloc(sizeof *ops);
+  if (ops == NULL) { free(C); return(NULL); }
+
+  /* initialize operations to NULL */
+  ops->gettype      = NULL;
+  ops->estimatestep = NULL;
+  ops->updateh      = NULL;
+  ops->reset        = NULL;
+  ops->setdefaults  = NULL;
+  ops->write        = NULL;
+  ops->space        = NULL;
+  ops->destroy      = NULL;
+
+  /* attach context and ops, initialize content to NULL */
+  C->sunctx  = sunctx;
+  C->ops     = ops;
+  C->content = NULL;
+
+  return(C);
+}
+
+/* -----------------------------------------------------------------------------
+ * Free a generic SUNAdaptController (assumes content is already empty)
+ * ---------------------------------------------------------------------------*/
+
+void SUNAdaptController_DestroyEmpty(SUNAdaptController C)
+{
+  if (C == NULL) return;
+
+  /* free non-NULL ops structure */
+  if (C->ops) free(C->ops);
+  C->ops = NULL;
+
+  /* free overall SUNAdaptController object and return */
+  free(C);
+  return;
+}
+
+/* -----------------------------------------------------------------------------
+ * core functions
+ * ---------------------------------------------------------------------------*/
+
+SUNAdaptController_Type SUNAdaptController_GetType(SUNAdaptController C)
+{
+  if (C == NULL) return(SUN_ADAPTCONTROLLER_NONE);
+  if (C->ops->gettype) return(C->ops->gettype(C));
+  return(SUN_ADAPTCONTROLLER_NONE);
+}
+
+int SUNAdaptController_EstimateStep(SUNAdaptController C, realtype h, int p,
+                                    realtype dsm, realtype* hnew)
+{
+  int ier;
+  if (C == NULL || hnew == NULL) return(SUNADAPTCONTROLLER_ILL_INPUT);
+  SUNDIALS_MARK_FUNCTION_BEGIN(getSUNProfiler(C));
+  *hnew = h;   /* no change by default */
+  if (C->ops->estimatestep)
+    ier = C->ops->estimatestep(C, h, p, dsm, hnew);
+  else
+    ier = SUNADAPTCONTROLLER_SUCCESS;
+  SUNDIALS_MARK_FUNCTION_END(getSUNProfiler(C));
+  return(ier);
+}
+
+int SUNAdaptController_UpdateH(SUNAdaptController C, realtype h, realtype dsm)
+{
+  int ier;
+  if (C == NULL) return(SUNADAPTCONTROLLER_ILL_INPUT);
+  SUNDIALS_MARK_FUNCTION_BEGIN(getSUNProfiler(C));
+  if (C->ops->updateh)
+    ier = C->ops->updateh(C, h, dsm);
+  else
+    ier = SUNADAPTCONTROLLER_SUCCESS;
+  SUNDIALS_MARK_FUNCTION_END(getSUNProfiler(C));
+  return(ier);
+}
+
+int SUNAdaptController_Reset(SUNAdaptController C)
+{
+  if (C == NULL) return(SUNADAPTCONTROLLER_ILL_INPUT);
+  if (C->ops->reset) return(C->ops->reset(C));
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
+
+int SUNAdaptController_SetDefaults(SUNAdaptController C)
+{
+  if (C == NULL) return(SUNADAPTCONTROLLER_ILL_INPUT);
+  if (C->ops->setdefaults) return(C->ops->setdefaults(C));
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
+
+int SUNAdaptController_Write(SUNAdaptController C, FILE* fptr)
+{
+  if (C == NULL || fptr == NULL) return(SUNADAPTCONTROLLER_ILL_INPUT);
+  if (C->ops->write) return(C->ops->write(C, fptr));
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
+
+int SUNAdaptController_Space(SUNAdaptController C, long int* lenrw,
+                             long int* leniw)
+{
+  if (C == NULL || lenrw == NULL || leniw == NULL)
+    return(SUNADAPTCONTROLLER_ILL_INPUT);
+  *lenrw = 0;   /* set outputs to zero in case the op is not implemented */
+  *leniw = 0;
+  if (C->ops->space) return(C->ops->space(C, lenrw, leniw));
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
+
+int SUNAdaptController_Destroy(SUNAdaptController C)
+{
+  if (C == NULL) return(SUNADAPTCONTROLLER_SUCCESS);
+
+  /* if the destroy operation exists use it */
+  if (C->ops)
+    if (C->ops->destroy) return(C->ops->destroy(C));
+
+  /* if we reach this point, either ops == NULL or destroy == NULL,
+     try to cleanup by freeing the content, ops, and controller */
+  if (C->content) { free(C->content); C->content = NULL; }
+  SUNAdaptController_DestroyEmpty(C);
+  return(SUNADAPTCONTROLLER_SUCCESS);
+}
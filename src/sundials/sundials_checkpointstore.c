@@ -0,0 +1,960 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * SUNDIALS checkpoint stores: generic functions and the memory,
+ * compressed memory, and file implementations.
+ * ----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <sundials/sundials_checkpointstore.h>
+#include "sundials_debug.h"
+
+#if defined(SUNDIALS_PTHREADS_ENABLED)
+#include <pthread.h>
+#endif
+
+/* maximum number of writes queued for the file I/O thread */
+#define MAX_PENDING_WRITES 4
+
+/* -----------------------------------------------------------------
+ * Generic functions
+ * ----------------------------------------------------------------*/
+
+SUNCheckpointStore SUNCheckpointStore_NewEmpty(SUNContext sunctx)
+{
+  SUNCheckpointStore store = NULL;
+
+  if (sunctx == NULL) return(NULL);
+
+  store = (SUNCheckpointStore) malloc(sizeof(struct _SUNCheckpointStore));
+  if (store == NULL)
+  {
+    SUNDIALS_DEBUG_PRINT("ERROR in SUNCheckpointStore_NewEmpty: malloc failed\n");
+    return(NULL);
+  }
+
+  store->ops = (SUNCheckpointStore_Ops) malloc(sizeof(struct _SUNCheckpointStore_Ops));
+  if (store->ops == NULL)
+  {
+    SUNDIALS_DEBUG_PRINT("ERROR in SUNCheckpointStore_NewEmpty: malloc failed\n");
+    free(store);
+    return(NULL);
+  }
+
+  /* Set all ops to NULL */
+  memset(store->ops, 0, sizeof(struct _SUNCheckpointStore_Ops));
+  store->content = NULL;
+  store->sunctx  = sunctx;
+
+  return(store);
+}
+
+void SUNCheckpointStore_FreeEmpty(SUNCheckpointStore store)
+{
+  if (store == NULL) return;
+  if (store->ops) free(store->ops);
+  free(store);
+}
+
+int SUNCheckpointStore_Write(SUNCheckpointStore store, long int key, void* buf,
+                             size_t bytes)
+{
+  return(store->ops->write(store, key, buf, bytes));
+}
+
+int SUNCheckpointStore_Read(SUNCheckpointStore store, long int key, void* buf,
+                            size_t bytes)
+{
+  return(store->ops->read(store, key, buf, bytes));
+}
+
+int SUNCheckpointStore_Remove(SUNCheckpointStore store, long int key)
+{
+  return(store->ops->remove(store, key));
+}
+
+int SUNCheckpointStore_Destroy(SUNCheckpointStore store)
+{
+  if (store == NULL) return(0);
+  return(store->ops->destroy(store));
+}
+
+int SUNCheckpointStore_Prefetch(SUNCheckpointStore store, long int key)
+{
+  if (store->ops->prefetch) return(store->ops->prefetch(store, key));
+  return(0);
+}
+
+int SUNCheckpointStore_GetMemoryUsage(SUNCheckpointStore store, size_t* bytes)
+{
+  if (store->ops->getmemoryusage)
+    return(store->ops->getmemoryusage(store, bytes));
+  return(-1);
+}
+
+/* -----------------------------------------------------------------
+ * Index of stored entries shared by the implementations
+ * ----------------------------------------------------------------*/
+
+typedef struct _CkptEntry
+{
+  long int key;
+  size_t   bytes;     /* size of the stored data                    */
+  void*    data;      /* data held in memory, NULL if not loaded    */
+  size_t   size;      /* size of data (differs from bytes if packed) */
+  long int offset;    /* file offset of the data                    */
+  int      ondisk;    /* the data has been written to the file      */
+  int      prefetch;  /* the data should be read from the file      */
+  int      busy;      /* the I/O thread is accessing the entry      */
+} *CkptEntry;
+
+typedef struct _CkptIndex
+{
+  CkptEntry* entries;
+  int        n;
+  int        nalloc;
+} CkptIndex;
+
+/* Keys are usually written in increasing order and read in decreasing
+   order, so search from the end */
+static CkptEntry ckptFind(CkptIndex* idx, long int key)
+{
+  int i;
+  for (i = idx->n - 1; i >= 0; i--)
+    if (idx->entries[i]->key == key) return(idx->entries[i]);
+  return(NULL);
+}
+
+static CkptEntry ckptAdd(CkptIndex* idx, long int key)
+{
+  CkptEntry  e;
+  CkptEntry* tmp;
+
+  if (idx->n == idx->nalloc)
+  {
+    tmp = (CkptEntry*) realloc(idx->entries, (2 * idx->nalloc + 16) *
+                                             sizeof(CkptEntry));
+    if (tmp == NULL) return(NULL);
+    idx->entries = tmp;
+    idx->nalloc  = 2 * idx->nalloc + 16;
+  }
+
+  e = (CkptEntry) calloc(1, sizeof(struct _CkptEntry));
+  if (e == NULL) return(NULL);
+  e->key = key;
+
+  idx->entries[idx->n++] = e;
+  return(e);
+}
+
+static void ckptDrop(CkptIndex* idx, CkptEntry e)
+{
+  int i;
+  for (i = 0; i < idx->n; i++)
+  {
+    if (idx->entries[i] == e)
+    {
+      memmove(idx->entries + i, idx->entries + i + 1,
+              (idx->n - i - 1) * sizeof(CkptEntry));
+      idx->n--;
+      break;
+    }
+  }
+  if (e->data) free(e->data);
+  free(e);
+}
+
+static void ckptFreeIndex(CkptIndex* idx)
+{
+  int i;
+  for (i = 0; i < idx->n; i++)
+  {
+    if (idx->entries[i]->data) free(idx->entries[i]->data);
+    free(idx->entries[i]);
+  }
+  free(idx->entries);
+  idx->entries = NULL;
+  idx->n = idx->nalloc = 0;
+}
+
+/* -----------------------------------------------------------------
+ * Lossless compression of 8-byte words. Each word is XORed with the
+ * previous one and only the nonzero low order bytes of the result
+ * are kept. The number of leading zero bytes of every word is kept
+ * in a 4-bit header. Smooth floating point data shares the sign,
+ * exponent, and leading mantissa bits of its neighbors, and zeros
+ * cost half a byte.
+ * ----------------------------------------------------------------*/
+
+static size_t ckptCompressBound(size_t bytes)
+{
+  return(bytes + (bytes / 8 + 1) / 2 + 1);
+}
+
+static size_t ckptCompress(const unsigned char* in, size_t bytes,
+                           unsigned char* out)
+{
+  size_t   i, nw, nh;
+  int      k, lz;
+  uint64_t w, x, prev = 0;
+  unsigned char* p;
+
+  nw = bytes / 8;
+  nh = (nw + 1) / 2;
+  memset(out, 0, nh);
+  p = out + nh;
+
+  for (i = 0; i < nw; i++)
+  {
+    memcpy(&w, in + 8 * i, 8);
+    x    = w ^ prev;
+    prev = w;
+
+    lz = 0;
+    while (lz < 8 && ((x >> (8 * (7 - lz))) & 0xff) == 0) lz++;
+
+    out[i / 2] |= (unsigned char) (lz << (4 * (i % 2)));
+    for (k = 0; k < 8 - lz; k++)
+      *p++ = (unsigned char) ((x >> (8 * k)) & 0xff);
+  }
+
+  memcpy(p, in + 8 * nw, bytes - 8 * nw);
+  p += bytes - 8 * nw;
+
+  return((size_t) (p - out));
+}
+
+static void ckptDecompress(const unsigned char* in, size_t bytes,
+                           unsigned char* out)
+{
+  size_t   i, nw, nh;
+  int      k, lz;
+  uint64_t w, x, prev = 0;
+  const unsigned char* p;
+
+  nw = bytes / 8;
+  nh = (nw + 1) / 2;
+  p  = in + nh;
+
+  for (i = 0; i < nw; i++)
+  {
+    lz = (in[i / 2] >> (4 * (i % 2))) & 0xf;
+
+    x = 0;
+    for (k = 0; k < 8 - lz; k++)
+      x |= ((uint64_t) *p++) << (8 * k);
+
+    w    = x ^ prev;
+    prev = w;
+    memcpy(out + 8 * i, &w, 8);
+  }
+
+  memcpy(out + 8 * nw, p, bytes - 8 * nw);
+}
+
+/* -----------------------------------------------------------------
+ * Memory and compressed memory checkpoint stores
+ * ----------------------------------------------------------------*/
+
+typedef struct _CkptMemContent
+{
+  CkptIndex   index;
+  booleantype compress;
+} *CkptMemContent;
+
+#define MEM_CONTENT(S) ((CkptMemContent) (S)->content)
+
+static int ckptMemWrite(SUNCheckpointStore store, long int key, void* buf,
+                        size_t bytes)
+{
+  CkptMemContent c = MEM_CONTENT(store);
+  CkptEntry      e;
+  void*          data;
+  size_t         size;
+
+  if (c->compress)
+  {
+    data = malloc(ckptCompressBound(bytes));
+    if (data == NULL) return(-1);
+    size = ckptCompress((unsigned char*) buf, bytes, (unsigned char*) data);
+    /* shrink the allocation to the compressed size */
+    if (size > 0)
+    {
+      void* tmp = realloc(data, size);
+      if (tmp != NULL) data = tmp;
+    }
+  }
+  else
+  {
+    data = malloc(bytes > 0 ? bytes : 1);
+    if (data == NULL) return(-1);
+    memcpy(data, buf, bytes);
+    size = bytes;
+  }
+
+  e = ckptFind(&c->index, key);
+  if (e == NULL) e = ckptAdd(&c->index, key);
+  if (e == NULL)
+  {
+    free(data);
+    return(-1);
+  }
+
+  if (e->data) free(e->data);
+  e->data  = data;
+  e->size  = size;
+  e->bytes = bytes;
+
+  return(0);
+}
+
+static int ckptMemRead(SUNCheckpointStore store, long int key, void* buf,
+                       size_t bytes)
+{
+  CkptMemContent c = MEM_CONTENT(store);
+  CkptEntry      e = ckptFind(&c->index, key);
+
+  if (e == NULL || e->bytes != bytes) return(-1);
+
+  if (c->compress)
+    ckptDecompress((unsigned char*) e->data, bytes, (unsigned char*) buf);
+  else
+    memcpy(buf, e->data, bytes);
+
+  return(0);
+}
+
+static int ckptMemRemove(SUNCheckpointStore store, long int key)
+{
+  CkptMemContent c = MEM_CONTENT(store);
+  CkptEntry      e = ckptFind(&c->index, key);
+
+  if (e == NULL) return(-1);
+  ckptDrop(&c->index, e);
+
+  return(0);
+}
+
+static int ckptMemGetMemoryUsage(SUNCheckpointStore store, size_t* bytes)
+{
+  CkptMemContent c = MEM_CONTENT(store);
+  int i;
+
+  *bytes = 0;
+  for (i = 0; i < c->index.n; i++) *bytes += c->index.entries[i]->size;
+
+  return(0);
+}
+
+static int ckptMemDestroy(SUNCheckpointStore store)
+{
+  if (store->content)
+  {
+    ckptFreeIndex(&MEM_CONTENT(store)->index);
+    free(store->content);
+    store->content = NULL;
+  }
+  SUNCheckpointStore_FreeEmpty(store);
+  return(0);
+}
+
+static SUNCheckpointStore ckptMemCreate(booleantype compress, SUNContext sunctx)
+{
+  SUNCheckpointStore store;
+  CkptMemContent     c;
+
+  store = SUNCheckpointStore_NewEmpty(sunctx);
+  if (store == NULL) return(NULL);
+
+  c = (CkptMemContent) calloc(1, sizeof(struct _CkptMemContent));
+  if (c == NULL)
+  {
+    SUNCheckpointStore_FreeEmpty(store);
+    return(NULL);
+  }
+  c->compress = compress;
+
+  store->content              = c;
+  store->ops->write           = ckptMemWrite;
+  store->ops->read            = ckptMemRead;
+  store->ops->remove          = ckptMemRemove;
+  store->ops->destroy         = ckptMemDestroy;
+  store->ops->getmemoryusage  = ckptMemGetMemoryUsage;
+
+  return(store);
+}
+
+SUNCheckpointStore SUNCheckpointStore_Memory(SUNContext sunctx)
+{
+  return(ckptMemCreate(SUNFALSE, sunctx));
+}
+
+SUNCheckpointStore SUNCheckpointStore_CompressedMemory(SUNContext sunctx)
+{
+  return(ckptMemCreate(SUNTRUE, sunctx));
+}
+
+/* -----------------------------------------------------------------
+ * File checkpoint store
+ *
+ * The data of each key is stored in an extent of the file. Extents
+ * released by removed or overwritten keys are kept in a free list
+ * (sorted by offset, with adjacent extents merged) and reused first
+ * fit by later writes, so the file only grows to the largest amount
+ * of data stored at once plus fragmentation. When built with
+ * Pthreads all file accesses are made by an I/O thread: a write
+ * copies the data into a queue entry that the thread writes to the
+ * file (the calling thread only blocks if MAX_PENDING_WRITES writes
+ * are queued), and a prefetch asks the thread to load the data back
+ * into memory so that the following read does not wait on the file.
+ * Data loaded from the file is released once it has been read.
+ * ----------------------------------------------------------------*/
+
+typedef struct _CkptExtent
+{
+  long int offset;
+  size_t   bytes;
+} CkptExtent;
+
+typedef struct _CkptFileContent
+{
+  CkptIndex   index;
+  FILE*       fp;
+  char*       filename;   /* removed on destroy, NULL for a tmpfile */
+  long int    fileend;
+  CkptExtent* free;       /* released extents sorted by offset      */
+  int         nfree;
+  int         nfreealloc;
+  int         error;
+#if defined(SUNDIALS_PTHREADS_ENABLED)
+  pthread_t       thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t  cond;
+  int             shutdown;
+  int             npending;
+#endif
+} *CkptFileContent;
+
+#define FILE_CONTENT(S) ((CkptFileContent) (S)->content)
+
+static int ckptFileWriteAt(CkptFileContent c, long int offset, void* data,
+                           size_t bytes)
+{
+  if (fseek(c->fp, offset, SEEK_SET) != 0) return(-1);
+  if (fwrite(data, 1, bytes, c->fp) != bytes) return(-1);
+  return(0);
+}
+
+static int ckptFileReadAt(CkptFileContent c, long int offset, void* data,
+                          size_t bytes)
+{
+  if (fseek(c->fp, offset, SEEK_SET) != 0) return(-1);
+  if (fread(data, 1, bytes, c->fp) != bytes) return(-1);
+  return(0);
+}
+
+/* Get an extent for bytes of data from the free list or the end of
+   the file */
+static long int ckptFileAlloc(CkptFileContent c, size_t bytes)
+{
+  long int offset;
+  int      i;
+
+  if (bytes == 0) return(c->fileend);
+
+  for (i = 0; i < c->nfree; i++)
+  {
+    if (c->free[i].bytes >= bytes)
+    {
+      offset = c->free[i].offset;
+      c->free[i].offset += (long int) bytes;
+      c->free[i].bytes  -= bytes;
+      if (c->free[i].bytes == 0)
+      {
+        memmove(c->free + i, c->free + i + 1,
+                (c->nfree - i - 1) * sizeof(CkptExtent));
+        c->nfree--;
+      }
+      return(offset);
+    }
+  }
+
+  offset      = c->fileend;
+  c->fileend += (long int) bytes;
+  return(offset);
+}
+
+/* Return an extent to the free list. If the list can not grow the
+   extent is not reused. */
+static void ckptFileRelease(CkptFileContent c, long int offset, size_t bytes)
+{
+  CkptExtent* tmp;
+  int         i;
+
+  if (bytes == 0) return;
+
+  /* an extent at the end of the file shortens the used part */
+  if (offset + (long int) bytes == c->fileend)
+  {
+    c->fileend = offset;
+    if (c->nfree > 0 && c->free[c->nfree - 1].offset +
+                        (long int) c->free[c->nfree - 1].bytes == c->fileend)
+    {
+      c->fileend = c->free[c->nfree - 1].offset;
+      c->nfree--;
+    }
+    return;
+  }
+
+  /* position of the extent in the list */
+  for (i = 0; i < c->nfree; i++)
+    if (c->free[i].offset > offset) break;
+
+  /* merge with the previous and next extents */
+  if (i > 0 && c->free[i - 1].offset + (long int) c->free[i - 1].bytes == offset)
+  {
+    c->free[i - 1].bytes += bytes;
+    if (i < c->nfree &&
+        offset + (long int) bytes == c->free[i].offset)
+    {
+      c->free[i - 1].bytes += c->free[i].bytes;
+      memmove(c->free + i, c->free + i + 1,
+              (c->nfree - i - 1) * sizeof(CkptExtent));
+      c->nfree--;
+    }
+    return;
+  }
+  if (i < c->nfree && offset + (long int) bytes == c->free[i].offset)
+  {
+    c->free[i].offset = offset;
+    c->free[i].bytes += bytes;
+    return;
+  }
+
+  if (c->nfree == c->nfreealloc)
+  {
+    tmp = (CkptExtent*) realloc(c->free, (2 * c->nfreealloc + 16) *
+                                         sizeof(CkptExtent));
+    if (tmp == NULL) return;
+    c->free       = tmp;
+    c->nfreealloc = 2 * c->nfreealloc + 16;
+  }
+
+  memmove(c->free + i + 1, c->free + i, (c->nfree - i) * sizeof(CkptExtent));
+  c->free[i].offset = offset;
+  c->free[i].bytes  = bytes;
+  c->nfree++;
+}
+
+#if defined(SUNDIALS_PTHREADS_ENABLED)
+
+/* I/O thread: write queued entries and load prefetched entries */
+static void* ckptFileWorker(void* arg)
+{
+  CkptFileContent c = (CkptFileContent) arg;
+  CkptEntry       e;
+  void*           data;
+  int             i, retval;
+
+  pthread_mutex_lock(&c->mutex);
+
+  while (!c->shutdown)
+  {
+    /* find the next job, writes first */
+    e = NULL;
+    for (i = 0; i < c->index.n && e == NULL; i++)
+    {
+      CkptEntry t = c->index.entries[i];
+      if (!t->busy && t->data && !t->ondisk && !c->error) e = t;
+    }
+    for (i = c->index.n - 1; i >= 0 && e == NULL; i--)
+    {
+      CkptEntry t = c->index.entries[i];
+      if (!t->busy && t->prefetch && !t->data && t->ondisk) e = t;
+    }
+
+    if (e == NULL)
+    {
+      pthread_cond_wait(&c->cond, &c->mutex);
+      continue;
+    }
+
+    e->busy = 1;
+
+    if (e->data)
+    {
+      /* the data is not modified while the entry is busy */
+      data = e->data;
+      pthread_mutex_unlock(&c->mutex);
+      retval = ckptFileWriteAt(c, e->offset, data, e->bytes);
+      pthread_mutex_lock(&c->mutex);
+
+      /* on failure the data stays in memory */
+      if (retval == 0)
+      {
+        e->ondisk = 1;
+        free(e->data);
+        e->data = NULL;
+      }
+      else
+      {
+        c->error = 1;
+      }
+      c->npending--;
+    }
+    else
+    {
+      pthread_mutex_unlock(&c->mutex);
+      data = malloc(e->bytes > 0 ? e->bytes : 1);
+      retval = (data == NULL) ? -1 : ckptFileReadAt(c, e->offset, data, e->bytes);
+      pthread_mutex_lock(&c->mutex);
+
+      if (retval == 0)
+      {
+        e->data = data;
+      }
+      else
+      {
+        if (data) free(data);
+        c->error = 1;
+      }
+      e->prefetch = 0;
+    }
+
+    e->busy = 0;
+    pthread_cond_broadcast(&c->cond);
+  }
+
+  pthread_mutex_unlock(&c->mutex);
+
+  return(NULL);
+}
+
+static int ckptFileWrite(SUNCheckpointStore store, long int key, void* buf,
+                         size_t bytes)
+{
+  CkptFileContent c = FILE_CONTENT(store);
+  CkptEntry       e;
+  void*           data;
+
+  data = malloc(bytes > 0 ? bytes : 1);
+  if (data == NULL) return(-1);
+  memcpy(data, buf, bytes);
+
+  pthread_mutex_lock(&c->mutex);
+
+  /* wait for the I/O thread to catch up */
+  while (c->npending >= MAX_PENDING_WRITES && !c->error)
+    pthread_cond_wait(&c->cond, &c->mutex);
+
+  e = ckptFind(&c->index, key);
+  if (e != NULL)
+  {
+    while (e->busy) pthread_cond_wait(&c->cond, &c->mutex);
+    if (e->data && !e->ondisk) c->npending--;
+    if (e->data) free(e->data);
+    e->data = NULL;
+    ckptFileRelease(c, e->offset, e->bytes);
+    e->bytes = 0;
+  }
+  else
+  {
+    e = ckptAdd(&c->index, key);
+  }
+
+  if (e == NULL || c->error)
+  {
+    pthread_mutex_unlock(&c->mutex);
+    free(data);
+    return(-1);
+  }
+
+  e->data     = data;
+  e->bytes    = bytes;
+  e->size     = bytes;
+  e->offset   = ckptFileAlloc(c, bytes);
+  e->ondisk   = 0;
+  e->prefetch = 0;
+  c->npending++;
+
+  pthread_cond_broadcast(&c->cond);
+  pthread_mutex_unlock(&c->mutex);
+
+  return(0);
+}
+
+static int ckptFileRead(SUNCheckpointStore store, long int key, void* buf,
+                        size_t bytes)
+{
+  CkptFileContent c = FILE_CONTENT(store);
+  CkptEntry       e;
+  int             retval = 0;
+
+  pthread_mutex_lock(&c->mutex);
+
+  e = ckptFind(&c->index, key);
+  if (e == NULL || e->bytes != bytes)
+  {
+    pthread_mutex_unlock(&c->mutex);
+    return(-1);
+  }
+
+  /* load the data if it has not been prefetched */
+  if (e->data == NULL)
+  {
+    e->prefetch = 1;
+    pthread_cond_broadcast(&c->cond);
+    while (e->data == NULL && !c->error)
+      pthread_cond_wait(&c->cond, &c->mutex);
+  }
+
+  if (e->data == NULL)
+  {
+    retval = -1;
+  }
+  else
+  {
+    memcpy(buf, e->data, bytes);
+    /* release data that is already in the file */
+    if (e->ondisk && !e->busy)
+    {
+      free(e->data);
+      e->data = NULL;
+    }
+  }
+
+  pthread_mutex_unlock(&c->mutex);
+
+  return(retval);
+}
+
+static int ckptFilePrefetch(SUNCheckpointStore store, long int key)
+{
+  CkptFileContent c = FILE_CONTENT(store);
+  CkptEntry       e;
+
+  pthread_mutex_lock(&c->mutex);
+
+  e = ckptFind(&c->index, key);
+  if (e != NULL && e->data == NULL)
+  {
+    e->prefetch = 1;
+    pthread_cond_broadcast(&c->cond);
+  }
+
+  pthread_mutex_unlock(&c->mutex);
+
+  return((e == NULL) ? -1 : 0);
+}
+
+static int ckptFileRemove(SUNCheckpointStore store, long int key)
+{
+  CkptFileContent c = FILE_CONTENT(store);
+  CkptEntry       e;
+
+  pthread_mutex_lock(&c->mutex);
+
+  e = ckptFind(&c->index, key);
+  if (e == NULL)
+  {
+    pthread_mutex_unlock(&c->mutex);
+    return(-1);
+  }
+
+  while (e->busy) pthread_cond_wait(&c->cond, &c->mutex);
+  if (e->data && !e->ondisk) c->npending--;
+  ckptFileRelease(c, e->offset, e->bytes);
+  ckptDrop(&c->index, e);
+
+  pthread_cond_broadcast(&c->cond);
+  pthread_mutex_unlock(&c->mutex);
+
+  return(0);
+}
+
+#else
+
+static int ckptFileWrite(SUNCheckpointStore store, long int key, void* buf,
+                         size_t bytes)
+{
+  CkptFileContent c = FILE_CONTENT(store);
+  CkptEntry       e;
+
+  e = ckptFind(&c->index, key);
+  if (e != NULL)
+  {
+    ckptFileRelease(c, e->offset, e->bytes);
+    e->bytes = 0;
+  }
+  else
+  {
+    e = ckptAdd(&c->index, key);
+  }
+  if (e == NULL) return(-1);
+
+  e->bytes  = bytes;
+  e->size   = bytes;
+  e->offset = ckptFileAlloc(c, bytes);
+  e->ondisk = 1;
+
+  return(ckptFileWriteAt(c, e->offset, buf, bytes));
+}
+
+static int ckptFileRead(SUNCheckpointStore store, long int key, void* buf,
+                        size_t bytes)
+{
+  CkptFileContent c = FILE_CONTENT(store);
+  CkptEntry       e = ckptFind(&c->index, key);
+
+  if (e == NULL || e->bytes != bytes) return(-1);
+
+  return(ckptFileReadAt(c, e->offset, buf, bytes));
+}
+
+static int ckptFileRemove(SUNCheckpointStore store, long int key)
+{
+  CkptFileContent c = FILE_CONTENT(store);
+  CkptEntry       e = ckptFind(&c->index, key);
+
+  if (e == NULL) return(-1);
+  ckptFileRelease(c, e->offset, e->bytes);
+  ckptDrop(&c->index, e);
+
+  return(0);
+}
+
+#endif
+
+static int ckptFileGetMemoryUsage(SUNCheckpointStore store, size_t* bytes)
+{
+  CkptFileContent c = FILE_CONTENT(store);
+  int i;
+
+#if defined(SUNDIALS_PTHREADS_ENABLED)
+  pthread_mutex_lock(&c->mutex);
+#endif
+
+  *bytes = 0;
+  for (i = 0; i < c->index.n; i++)
+    if (c->index.entries[i]->data) *bytes += c->index.entries[i]->size;
+
+#if defined(SUNDIALS_PTHREADS_ENABLED)
+  pthread_mutex_unlock(&c->mutex);
+#endif
+
+  return(0);
+}
+
+static int ckptFileDestroy(SUNCheckpointStore store)
+{
+  CkptFileContent c = FILE_CONTENT(store);
+
+  if (c != NULL)
+  {
+#if defined(SUNDIALS_PTHREADS_ENABLED)
+    pthread_mutex_lock(&c->mutex);
+    c->shutdown = 1;
+    pthread_cond_broadcast(&c->cond);
+    pthread_mutex_unlock(&c->mutex);
+    pthread_join(c->thread, NULL);
+    pthread_cond_destroy(&c->cond);
+    pthread_mutex_destroy(&c->mutex);
+#endif
+    ckptFreeIndex(&c->index);
+    if (c->free) free(c->free);
+    if (c->fp) fclose(c->fp);
+    if (c->filename)
+    {
+      remove(c->filename);
+      free(c->filename);
+    }
+    free(c);
+    store->content = NULL;
+  }
+
+  SUNCheckpointStore_FreeEmpty(store);
+  return(0);
+}
+
+SUNCheckpointStore SUNCheckpointStore_File(const char* filename,
+                                           SUNContext sunctx)
+{
+  SUNCheckpointStore store;
+  CkptFileContent    c;
+
+  store = SUNCheckpointStore_NewEmpty(sunctx);
+  if (store == NULL) return(NULL);
+
+  c = (CkptFileContent) calloc(1, sizeof(struct _CkptFileContent));
+  if (c == NULL)
+  {
+    SUNCheckpointStore_FreeEmpty(store);
+    return(NULL);
+  }
+  store->content = c;
+
+  if (filename != NULL)
+  {
+    c->filename = (char*) malloc(strlen(filename) + 1);
+    if (c->filename != NULL)
+    {
+      strcpy(c->filename, filename);
+      c->fp = fopen(filename, "w+b");
+    }
+  }
+  else
+  {
+    c->fp = tmpfile();
+  }
+
+  if (c->fp == NULL)
+  {
+    SUNDIALS_DEBUG_PRINT("ERROR in SUNCheckpointStore_File: could not open file\n");
+    if (c->filename) { free(c->filename); c->filename = NULL; }
+    free(c);
+    store->content = NULL;
+    SUNCheckpointStore_FreeEmpty(store);
+    return(NULL);
+  }
+
+#if defined(SUNDIALS_PTHREADS_ENABLED)
+  pthread_mutex_init(&c->mutex, NULL);
+  pthread_cond_init(&c->cond, NULL);
+  if (pthread_create(&c->thread, NULL, ckptFileWorker, c) != 0)
+  {
+    SUNDIALS_DEBUG_PRINT("ERROR in SUNCheckpointStore_File: could not create thread\n");
+    pthread_cond_destroy(&c->cond);
+    pthread_mutex_destroy(&c->mutex);
+    fclose(c->fp);
+    if (c->filename)
+    {
+      remove(c->filename);
+      free(c->filename);
+    }
+    free(c);
+    store->content = NULL;
+    SUNCheckpointStore_FreeEmpty(store);
+    return(NULL);
+  }
+  store->ops->prefetch = ckptFilePrefetch;
+#endif
+
+  store->ops->write          = ckptFileWrite;
+  store->ops->read           = ckptFileRead;
+  store->ops->remove         = ckptFileRemove;
+  store->ops->destroy        = ckptFileDestroy;
+  store->ops->getmemoryusage = ckptFileGetMemoryUsage;
+
+  return(store);
+}
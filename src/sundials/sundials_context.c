@@ -20,10 +20,12 @@
 #include <string.h>
 #include <sundials/sundials_context.h>
 #include <sundials/sundials_logger.h>
+#include <sundials/sundials_memory.h>
 #include <sundials/sundials_profiler.h>
 
 #include "sundials_context_impl.h"
 #include "sundials_debug.h"
+#include "sundials_profiler_impl.h"
 
 #ifdef SUNDIALS_ADIAK_ENABLED
 #include <adiak.h>
@@ -79,6 +81,9 @@ int SUNContext_Create(void* comm, SUNContext* sunctx)
   (*sunctx)->own_logger   = logger != NULL;
   (*sunctx)->profiler     = profiler;
   (*sunctx)->own_profiler = profiler != NULL;
+  (*sunctx)->mem_helper   = NULL;
+  (*sunctx)->use_vec_pool = SUNFALSE;
+  (*sunctx)->vec_pool     = NULL;
 
   return (0);
 }
@@ -160,6 +165,36 @@ int SUNContext_SetLogger(SUNContext sunctx, SUNLogger logger)
   return (0);
 }
 
+int SUNContext_GetMemoryHelper(SUNContext sunctx, SUNMemoryHelper* helper)
+{
+  if (sunctx == NULL)
+  {
+    return (-1);
+  }
+
+  /* get memory helper */
+  *helper = sunctx->mem_helper;
+
+  return (0);
+}
+
+int SUNContext_SetMemoryHelper(SUNContext sunctx, SUNMemoryHelper helper)
+{
+  if (sunctx == NULL)
+  {
+    return (-1);
+  }
+
+  /* pooled vectors that are not checked out were allocated by the previous
+     helper, destroy them so the helper can be destroyed after this call */
+  if (helper != sunctx->mem_helper) SUNContext_ReleaseVectorPool(sunctx);
+
+  /* set memory helper, the context does not take ownership */
+  sunctx->mem_helper = helper;
+
+  return (0);
+}
+
 int SUNContext_Free(SUNContext* sunctx)
 {
 #if defined(SUNDIALS_BUILD_WITH_PROFILING) && !defined(SUNDIALS_CALIPER_ENABLED)
@@ -176,6 +211,11 @@ int SUNContext_Free(SUNContext* sunctx)
     return (0);
   }
 
+  /* Destroy the pooled vectors first, while the logger and profiler still
+     exist. A memory helper attached to the context must outlive this call or
+     be detached (which releases the pool) before it is destroyed. */
+  sunVectorPoolFree(*sunctx);
+
 #if defined(SUNDIALS_BUILD_WITH_PROFILING) && !defined(SUNDIALS_CALIPER_ENABLED)
   /* Find out where we are printing to */
   sunprofiler_print_env = getenv("SUNPROFILER_PRINT");
@@ -198,6 +238,7 @@ int SUNContext_Free(SUNContext* sunctx)
   {
     if (fp) SUNProfiler_Print((*sunctx)->profiler, fp);
     if (fp) fclose(fp);
+    sunProfilerExportFromEnv((*sunctx)->profiler);
     if ((*sunctx)->own_profiler) SUNProfiler_Free(&(*sunctx)->profiler);
   }
 #endif
@@ -19,6 +19,8 @@
 
 #include <sundials/sundials_context.h>
 #include <sundials/sundials_logger.h>
+#include <sundials/sundials_memory.h>
+#include <sundials/sundials_nvector.h>
 #include <sundials/sundials_profiler.h>
 #include <sundials/sundials_types.h>
 
@@ -31,8 +33,16 @@ struct _SUNContext {
   booleantype own_profiler;
   SUNLogger logger;
   booleantype own_logger;
+  SUNMemoryHelper mem_helper;
+  booleantype use_vec_pool;
+  struct sunVectorPool_* vec_pool;
 };
 
+/* Checks if scratch vectors cloned from w are shared through the vector pool
+   of its context and destroys the pool (see sundials_nvector.c) */
+booleantype sunVectorPoolUsable(N_Vector w);
+void sunVectorPoolFree(SUNContext sunctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,6 +24,15 @@
 #include <sundials/sundials_nvector.h>
 #include "sundials_context_impl.h"
 
+/* The threaded vectors are only inspected through their content macros to
+   compare thread counts in the vector pool, no library symbols are used */
+#if defined(SUNDIALS_NVECTOR_OPENMP)
+#include <nvector/nvector_openmp.h>
+#endif
+#if defined(SUNDIALS_NVECTOR_PTHREADS)
+#include <nvector/nvector_pthreads.h>
+#endif
+
 #if defined(SUNDIALS_BUILD_WITH_PROFILING)
 static SUNProfiler getSUNProfiler(N_Vector v)
 {
@@ -135,6 +144,10 @@ N_Vector N_VNewEmpty(SUNContext sunctx)
   ops->nvdotprodmultilocal     = NULL;
   ops->nvdotprodmultiallreduce = NULL;
 
+  /* split-phase buffer reduction operations */
+  ops->nvallreducestart  = NULL;
+  ops->nvallreducefinish = NULL;
+
   /* XBraid interface operations */
   ops->nvbufsize   = NULL;
   ops->nvbufpack   = NULL;
@@ -256,6 +269,10 @@ int N_VCopyOps(N_Vector w, N_Vector v)
   v->ops->nvdotprodmultilocal     = w->ops->nvdotprodmultilocal;
   v->ops->nvdotprodmultiallreduce = w->ops->nvdotprodmultiallreduce;
 
+  /* split-phase buffer reduction operations */
+  v->ops->nvallreducestart  = w->ops->nvallreducestart;
+  v->ops->nvallreducefinish = w->ops->nvallreducefinish;
+
   /* XBraid interface operations */
   v->ops->nvbufsize   = w->ops->nvbufsize;
   v->ops->nvbufpack   = w->ops->nvbufpack;
@@ -920,6 +937,30 @@ int N_VDotProdMultiAllReduce(int nvec, N_Vector x, realtype* sum)
   return(-1);
 }
 
+/* -------------------------------------------------------
+ * OPTIONAL split-phase (non-blocking) reduction operations
+ * -------------------------------------------------------*/
+
+int N_VAllReduceStart(int nvec, N_Vector x, realtype* buf, int op)
+{
+  int ier = -1;
+  SUNDIALS_MARK_FUNCTION_BEGIN(getSUNProfiler(x));
+  if (x->ops->nvallreducestart)
+    ier = x->ops->nvallreducestart(nvec, x, buf, op);
+  SUNDIALS_MARK_FUNCTION_END(getSUNProfiler(x));
+  return(ier);
+}
+
+int N_VAllReduceFinish(N_Vector x)
+{
+  int ier = -1;
+  SUNDIALS_MARK_FUNCTION_BEGIN(getSUNProfiler(x));
+  if (x->ops->nvallreducefinish)
+    ier = x->ops->nvallreducefinish(x);
+  SUNDIALS_MARK_FUNCTION_END(getSUNProfiler(x));
+  return(ier);
+}
+
 /* ------------------------------------
  * OPTIONAL XBraid interface operations
  * ------------------------------------*/
@@ -1037,6 +1078,270 @@ void N_VDestroyVectorArray(N_Vector* vs, int count)
   return;
 }
 
+/* -----------------------------------------------------------------
+ * Scratch vector pool attached to the SUNContext:
+ *   SUNContext_EnableVectorPool
+ *   SUNContext_ReleaseVectorPool
+ *   SUNContext_GetVectorPoolStats
+ *   N_VCheckoutVectorArray
+ *   N_VReturnVectorArray
+ * -----------------------------------------------------------------*/
+
+struct sunVectorPool_
+{
+  N_Vector* vecs;          /* vectors owned by the pool         */
+  booleantype* in_use;     /* checkout flag for each vector     */
+  int nvecs;               /* number of vectors in the pool     */
+  int capacity;            /* allocated length of vecs, in_use  */
+  long int num_clones;     /* vectors cloned for checkouts      */
+  long int num_checkouts;  /* vectors checked out               */
+  long int num_in_use;     /* vectors currently checked out     */
+  long int max_in_use;     /* most vectors checked out at once  */
+};
+
+/* Only vectors whose data layout is determined by their type, lengths, and
+   thread count are shared, other types are cloned for each checkout. MPI
+   vectors are not pooled since a match would also require comparing their
+   communicators. */
+static booleantype sunVectorPoolable(N_Vector w)
+{
+  N_Vector_ID id;
+
+  if (w->ops->nvgetvectorid == NULL || w->ops->nvgetlength == NULL)
+    return(SUNFALSE);
+
+  id = N_VGetVectorID(w);
+  return(id == SUNDIALS_NVEC_SERIAL || id == SUNDIALS_NVEC_OPENMP ||
+         id == SUNDIALS_NVEC_PTHREADS);
+}
+
+static booleantype sunVectorPoolMatch(N_Vector v, N_Vector w)
+{
+  N_Vector_ID id = N_VGetVectorID(w);
+
+  if (N_VGetVectorID(v) != id) return(SUNFALSE);
+  if (N_VGetLength(v) != N_VGetLength(w)) return(SUNFALSE);
+
+  /* clones keep the thread count of the template */
+#if defined(SUNDIALS_NVECTOR_OPENMP)
+  if (id == SUNDIALS_NVEC_OPENMP &&
+      NV_NUM_THREADS_OMP(v) != NV_NUM_THREADS_OMP(w))
+    return(SUNFALSE);
+#endif
+#if defined(SUNDIALS_NVECTOR_PTHREADS)
+  if (id == SUNDIALS_NVEC_PTHREADS &&
+      NV_NUM_THREADS_PT(v) != NV_NUM_THREADS_PT(w))
+    return(SUNFALSE);
+#endif
+
+  return(SUNTRUE);
+}
+
+static struct sunVectorPool_* sunVectorPoolCreate(void)
+{
+  struct sunVectorPool_* pool;
+
+  pool = (struct sunVectorPool_*) calloc(1, sizeof(*pool));
+  return(pool);
+}
+
+/* Adds a vector to the pool and marks it as checked out */
+static int sunVectorPoolAppend(struct sunVectorPool_* pool, N_Vector v)
+{
+  int capacity;
+  N_Vector* vecs;
+  booleantype* in_use;
+
+  if (pool->nvecs == pool->capacity) {
+    capacity = (pool->capacity > 0) ? 2 * pool->capacity : 16;
+
+    vecs = (N_Vector*) realloc(pool->vecs, capacity * sizeof(N_Vector));
+    if (vecs == NULL) return(-1);
+    pool->vecs = vecs;
+
+    in_use = (booleantype*) realloc(pool->in_use,
+                                    capacity * sizeof(booleantype));
+    if (in_use == NULL) return(-1);
+    pool->in_use = in_use;
+
+    pool->capacity = capacity;
+  }
+
+  pool->vecs[pool->nvecs]   = v;
+  pool->in_use[pool->nvecs] = SUNTRUE;
+  pool->nvecs++;
+
+  return(0);
+}
+
+/* Returns a vector to the pool, returns -1 if it is not from the pool */
+static int sunVectorPoolReturn(struct sunVectorPool_* pool, N_Vector v)
+{
+  int i;
+
+  if (pool == NULL) return(-1);
+
+  for (i = pool->nvecs - 1; i >= 0; i--) {
+    if (pool->vecs[i] == v) {
+      if (!pool->in_use[i]) return(-1);
+      pool->in_use[i] = SUNFALSE;
+      pool->num_in_use--;
+      return(0);
+    }
+  }
+
+  return(-1);
+}
+
+int SUNContext_EnableVectorPool(SUNContext sunctx, booleantype onoff)
+{
+  if (sunctx == NULL) return(-1);
+
+  if (onoff && sunctx->vec_pool == NULL) {
+    sunctx->vec_pool = sunVectorPoolCreate();
+    if (sunctx->vec_pool == NULL) return(-1);
+  }
+
+  sunctx->use_vec_pool = onoff;
+
+  return(0);
+}
+
+int SUNContext_ReleaseVectorPool(SUNContext sunctx)
+{
+  int i, j;
+  struct sunVectorPool_* pool;
+
+  if (sunctx == NULL) return(-1);
+
+  pool = sunctx->vec_pool;
+  if (pool == NULL) return(0);
+
+  /* destroy the vectors that are not checked out */
+  for (i = 0, j = 0; i < pool->nvecs; i++) {
+    if (pool->in_use[i]) {
+      pool->vecs[j]   = pool->vecs[i];
+      pool->in_use[j] = SUNTRUE;
+      j++;
+    } else {
+      N_VDestroy(pool->vecs[i]);
+    }
+  }
+  pool->nvecs = j;
+
+  return(0);
+}
+
+int SUNContext_GetVectorPoolStats(SUNContext sunctx, long int* num_clones,
+                                  long int* num_checkouts, long int* num_in_use,
+                                  long int* max_in_use)
+{
+  struct sunVectorPool_* pool;
+
+  if (sunctx == NULL) return(-1);
+
+  pool = sunctx->vec_pool;
+
+  *num_clones    = (pool) ? pool->num_clones : 0;
+  *num_checkouts = (pool) ? pool->num_checkouts : 0;
+  *num_in_use    = (pool) ? pool->num_in_use : 0;
+  *max_in_use    = (pool) ? pool->max_in_use : 0;
+
+  return(0);
+}
+
+N_Vector* N_VCheckoutVectorArray(int count, N_Vector w)
+{
+  N_Vector* vs = NULL;
+  N_Vector v;
+  struct sunVectorPool_* pool;
+  int i, j;
+
+  if (count <= 0 || w == NULL) return(NULL);
+
+  if (!sunVectorPoolUsable(w))
+    return(N_VCloneVectorArray(count, w));
+
+  pool = w->sunctx->vec_pool;
+
+  vs = (N_Vector* ) malloc(count * sizeof(N_Vector));
+  if (vs == NULL) return(NULL);
+
+  /* reuse vectors that are not checked out */
+  j = 0;
+  for (i = 0; i < pool->nvecs && j < count; i++) {
+    if (!pool->in_use[i] && sunVectorPoolMatch(pool->vecs[i], w)) {
+      pool->in_use[i] = SUNTRUE;
+      vs[j++] = pool->vecs[i];
+    }
+  }
+  pool->num_in_use += j;
+
+  /* clone the rest */
+  for (; j < count; j++) {
+    v = N_VClone(w);
+    if (v == NULL || sunVectorPoolAppend(pool, v)) {
+      if (v) N_VDestroy(v);
+      N_VReturnVectorArray(vs, j);
+      return(NULL);
+    }
+    vs[j] = v;
+    pool->num_clones++;
+    pool->num_in_use++;
+  }
+
+  pool->num_checkouts += count;
+  if (pool->num_in_use > pool->max_in_use)
+    pool->max_in_use = pool->num_in_use;
+
+  return(vs);
+}
+
+void N_VReturnVectorArray(N_Vector* vs, int count)
+{
+  int j;
+
+  if (vs == NULL) return;
+
+  /* vectors that are not from the pool were cloned by the checkout */
+  for (j = 0; j < count; j++) {
+    if (sunVectorPoolReturn(vs[j]->sunctx->vec_pool, vs[j]))
+      N_VDestroy(vs[j]);
+    vs[j] = NULL;
+  }
+
+  free(vs); vs = NULL;
+
+  return;
+}
+
+booleantype sunVectorPoolUsable(N_Vector w)
+{
+  return(w->sunctx->use_vec_pool && sunVectorPoolable(w));
+}
+
+void sunVectorPoolFree(SUNContext sunctx)
+{
+  struct sunVectorPool_* pool = sunctx->vec_pool;
+
+  if (pool == NULL) return;
+
+  SUNContext_ReleaseVectorPool(sunctx);
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_WARNING
+  if (pool->nvecs > 0)
+    SUNLogger_QueueMsg(sunctx->logger, SUN_LOGLEVEL_WARNING,
+                       "SUNContext_Free", "vector-pool",
+                       "%d vectors are still checked out of the vector pool",
+                       pool->nvecs);
+#endif
+
+  free(pool->vecs);
+  free(pool->in_use);
+  free(pool);
+  sunctx->vec_pool = NULL;
+}
+
 /* These function are really only for users of the Fortran interface */
 N_Vector N_VGetVecAtIndexVectorArray(N_Vector* vs, int index)
 {
@@ -10,10 +10,26 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Timer names are interned into integer ids the first time they are
+ * seen. Each thread keeps its own timing data (flat timers, a call
+ * tree of nested regions, and an optional trace event buffer) so
+ * SUNProfiler_Begin/End only take the profiler lock when a thread
+ * sees a new timer name. Per-thread lookups of a name are cached by
+ * the address of the name string, which avoids hashing the string
+ * for literals and __func__. On Linux, hardware counters (cycles,
+ * instructions, last level cache misses, and floating point
+ * operations) can also be recorded for each region using perf
+ * events.
  * -----------------------------------------------------------------*/
 
 #include <sundials/sundials_config.h>
 
+/* syscall() is not declared with strict POSIX feature macros */
+#if defined(SUNDIALS_HAVE_PERF_EVENTS) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #if SUNDIALS_MPI_ENABLED
 #include <sundials/sundials_mpi_types.h>
 #include <mpi.h>
@@ -31,153 +47,873 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(SUNDIALS_HAVE_PERF_EVENTS)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include <sundials/sundials_profiler.h>
 #include <sundials/sundials_math.h>
 #include "sundials_hashmap.h"
 #include "sundials_debug.h"
+#include "sundials_profiler_impl.h"
 
 #define SUNDIALS_ROOT_TIMER ((const char*) "From profiler epoch")
 
-/* Private functions */
-#if SUNDIALS_MPI_ENABLED
-static int sunCollectTimers(SUNProfiler p);
+/* Default per-thread trace capacity and number of calibration calls */
+#define SUN_PROFILER_DEFAULT_MAX_EVENTS 1048576L
+#define SUN_PROFILER_CALIBRATION_CALLS  64
+
+/* Hardware counters recorded for each region */
+#define SUN_PROFILER_NCOUNTERS 4
+
+enum { SUN_COUNTER_CYCLES, SUN_COUNTER_INSTRUCTIONS, SUN_COUNTER_LLC_MISSES,
+       SUN_COUNTER_FLOPS };
+
+static const char* sun_counter_names[SUN_PROFILER_NCOUNTERS] =
+  { "cycles", "instructions", "LLC misses", "FLOPs" };
+
+/* Thread local storage, the profiler lock, and the atomic counter used to
+   number profiler objects. The configuration is rejected at CMake time if
+   none of the branches below applies. */
+#if defined(__GNUC__) || defined(__clang__)
+#define SUN_THREAD_LOCAL __thread
+#define SUN_ATOMIC
+typedef char sunProfilerLock;
+#define SUN_PROFILER_LOCK_INIT(p) __atomic_clear(&((p)->lock), __ATOMIC_RELEASE)
+#define SUN_PROFILER_LOCK(p) \
+  while (__atomic_test_and_set(&((p)->lock), __ATOMIC_ACQUIRE)) {}
+#define SUN_PROFILER_UNLOCK(p) __atomic_clear(&((p)->lock), __ATOMIC_RELEASE)
+#define SUN_ATOMIC_INCREMENT(x) __atomic_add_fetch(&(x), 1, __ATOMIC_RELAXED)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define SUN_THREAD_LOCAL __declspec(thread)
+#define SUN_ATOMIC volatile
+typedef volatile char sunProfilerLock;
+#define SUN_PROFILER_LOCK_INIT(p) _InterlockedExchange8(&((p)->lock), 0)
+#define SUN_PROFILER_LOCK(p) \
+  while (_InterlockedExchange8(&((p)->lock), 1)) {}
+#define SUN_PROFILER_UNLOCK(p) _InterlockedExchange8(&((p)->lock), 0)
+#define SUN_ATOMIC_INCREMENT(x) \
+  ((unsigned long) _InterlockedIncrement((volatile long*) &(x)))
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && \
+      !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define SUN_THREAD_LOCAL _Thread_local
+#define SUN_ATOMIC _Atomic
+typedef atomic_flag sunProfilerLock;
+#define SUN_PROFILER_LOCK_INIT(p) \
+  atomic_flag_clear_explicit(&((p)->lock), memory_order_release)
+#define SUN_PROFILER_LOCK(p) \
+  while (atomic_flag_test_and_set_explicit(&((p)->lock), \
+                                           memory_order_acquire)) {}
+#define SUN_PROFILER_UNLOCK(p) \
+  atomic_flag_clear_explicit(&((p)->lock), memory_order_release)
+#define SUN_ATOMIC_INCREMENT(x) \
+  (atomic_fetch_add_explicit(&(x), 1, memory_order_relaxed) + 1)
+#else
+#error The SUNDIALS profiler requires thread local storage and atomic operations (GCC/Clang builtins, MSVC intrinsics, or C11)
 #endif
-static void sunPrintTimers(int idx, SUNHashMapKeyValue kv, FILE* fp, void* pvoid);
-static int sunCompareTimes(const void* l, const void* r);
 
 /*
   sunTimerStruct.
-  A private structure holding timing information.
+  A private structure holding the merged timing information of a timer.
  */
 
 struct _sunTimerStruct
 {
-#if SUNDIALS_MPI_ENABLED
+  double    average;
+  double    maximum;
+  double    elapsed;
+  long      count;
+  long long counters[SUN_PROFILER_NCOUNTERS];
+};
+
+typedef struct _sunTimerStruct sunTimerStruct;
+
+/* A registered timer name, the value type stored in the name map */
+typedef struct _sunTimerName
+{
+  char* name;
+  int   id;
+} sunTimerName;
+
+/* Per-thread flat timer data */
+typedef struct _sunThreadTimer
+{
+  double    elapsed; /* inclusive time of outermost activations */
+  long      count;   /* number of activations                    */
+  int       active;  /* number of open activations               */
+  long long counters[SUN_PROFILER_NCOUNTERS];
+} sunThreadTimer;
+
+/* Node of the call tree of nested regions */
+typedef struct _sunProfilerNode
+{
+  int    timer;   /* timer id (-1 for the root of the tree) */
+  int    parent;  /* parent node                            */
+  int    child;   /* first child node                       */
+  int    sibling; /* next sibling node                      */
+  double elapsed; /* inclusive time                         */
+  long   count;   /* number of activations                  */
+  long long counters[SUN_PROFILER_NCOUNTERS];
+} sunProfilerNode;
+
+/* An open region */
+typedef struct _sunProfilerFrame
+{
+  int       node;
+  int       counting; /* counters were read at the start */
+  double    tic;
+  long long counters[SUN_PROFILER_NCOUNTERS];
+} sunProfilerFrame;
+
+/* A completed region in the trace buffer */
+typedef struct _sunProfilerEvent
+{
+  int    timer;
   double tic;
   double toc;
-#else
-  struct timespec* tic;
-  struct timespec* toc;
-#endif
-  double average;
-  double maximum;
-  double elapsed;
-  long   count;
+} sunProfilerEvent;
+
+/* Name lookup cache entry */
+typedef struct _sunNameCacheEntry
+{
+  const char* key;  /* address of the name string passed by the caller */
+  const char* name; /* registered copy of the name                     */
+  int         id;
+} sunNameCacheEntry;
+
+/* Timing data owned by a single thread */
+typedef struct _sunProfilerThread
+{
+  const void* key; /* identifies the owning thread */
+  int tid;         /* thread index in the profiler */
+  struct _sunProfilerThread* next;
+
+  sunThreadTimer* timers;
+  int ntimers;
+
+  sunNameCacheEntry* cache;
+  int cache_size; /* power of two */
+  int cache_used;
+
+  sunProfilerNode* nodes;
+  int nnodes;
+  int nodes_alloc;
+
+  sunProfilerFrame* stack;
+  int depth;
+  int stack_alloc;
+
+  sunProfilerEvent* events;
+  long nevents;
+  long events_alloc;
+  long dropped;
+
+  long ncalls; /* number of begin calls, for the overhead estimate */
+
+  int perf_state; /* 0 = not opened, 1 = counting, -1 = unavailable */
+  int perf_leader;
+  int perf_fd[SUN_PROFILER_NCOUNTERS];
+  int perf_slot[SUN_PROFILER_NCOUNTERS]; /* index in the group read */
+  int perf_nslots;
+} sunProfilerThread;
+
+/*
+  SUNProfiler.
+
+  This structure holds the registered timer names and the list of
+  per-thread timing data.
+ */
+
+struct _SUNProfiler
+{
+  void*              comm;
+  char*              title;
+  SUNHashMap         map;      /* timer name -> sunTimerName      */
+  char**             names;    /* registered names indexed by id  */
+  int                ntimers;
+  int                names_alloc;
+  sunProfilerThread* threads;
+  int                nthreads;
+  sunProfilerLock    lock;
+  unsigned long      serial;   /* distinguishes profiler objects  */
+  double             epoch;    /* creation time                   */
+  double             overhead; /* estimated cost of a Begin/End   */
+  long               max_events;
+  int                counters;          /* record hardware counters   */
+  double             counter_overhead;  /* cost of the counter reads  */
+  double             sundials_time;
+  int                root;
 };
 
-typedef struct _sunTimerStruct sunTimerStruct;
+static SUN_ATOMIC unsigned long sun_profiler_serial = 0;
+
+/* Thread local cache of the last profiler used by this thread */
+static SUN_THREAD_LOCAL char sun_tls_key;
+static SUN_THREAD_LOCAL SUNProfiler sun_tls_profiler = NULL;
+static SUN_THREAD_LOCAL unsigned long sun_tls_serial = 0;
+static SUN_THREAD_LOCAL sunProfilerThread* sun_tls_thread = NULL;
 
-static sunTimerStruct* sunTimerStructNew()
+/* Private functions */
+#if SUNDIALS_MPI_ENABLED
+static int sunCollectTimers(SUNProfiler p, sunTimerStruct* timers,
+                            int* order, int* mask);
+#endif
+static int sunCompareTimes(const void* l, const void* r);
+static int sunCompareNames(const void* l, const void* r);
+
+/* Comparator context (qsort does not take a context argument) */
+static SUN_THREAD_LOCAL sunTimerStruct* sun_sort_timers = NULL;
+static SUN_THREAD_LOCAL char** sun_sort_names = NULL;
+
+static double sunProfilerTime(void)
 {
-  sunTimerStruct* ts = (sunTimerStruct*) malloc(sizeof(sunTimerStruct));
 #if SUNDIALS_MPI_ENABLED
-  ts->tic = 0.0;
-  ts->toc = 0.0;
+  return MPI_Wtime();
 #else
-  ts->tic = (struct timespec *) malloc(sizeof(struct timespec));
-  ts->toc = (struct timespec *) malloc(sizeof(struct timespec));
-  ts->tic->tv_sec = 0;
-  ts->tic->tv_nsec = 0;
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
 #endif
-  ts->elapsed = 0.0;
-  ts->average = 0.0;
-  ts->maximum = 0.0;
-  ts->count   = 0;
-  return ts;
 }
 
-static void sunTimerStructFree(void* TS)
+#if defined(SUNDIALS_HAVE_PERF_EVENTS)
+/* Open a perf event counting user space events of the calling thread */
+static int sunPerfOpen(unsigned int type, unsigned long long config,
+                       int group)
 {
-  sunTimerStruct* ts = (sunTimerStruct*) TS;
-  if (ts)
-  {
-#if !SUNDIALS_MPI_ENABLED
-    if (ts->tic) free(ts->tic);
-    if (ts->toc) free(ts->toc);
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size           = sizeof(attr);
+  attr.type           = type;
+  attr.config         = config;
+  attr.read_format    = PERF_FORMAT_GROUP;
+  attr.disabled       = (group < 0);
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+
+  return (int) syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
 #endif
-    free(ts);
+
+/* Open the hardware counters of the calling thread as one group. Counters
+   the machine does not support (or the user may not access) are skipped. */
+static void sunPerfStart(sunProfilerThread* t)
+{
+#if defined(SUNDIALS_HAVE_PERF_EVENTS)
+  int k, fd;
+  char* flops_env;
+  unsigned int types[SUN_PROFILER_NCOUNTERS] =
+    { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+      PERF_TYPE_RAW };
+  unsigned long long configs[SUN_PROFILER_NCOUNTERS] =
+    { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES, 0 };
+
+  /* There is no generic floating point event, the raw event code for the
+     machine must be given in the environment */
+  flops_env = getenv("SUNPROFILER_FLOPS_EVENT");
+  if (flops_env) configs[SUN_COUNTER_FLOPS] = strtoull(flops_env, NULL, 0);
+
+  t->perf_leader = -1;
+  t->perf_nslots = 0;
+  for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++)
+  {
+    t->perf_fd[k]   = -1;
+    t->perf_slot[k] = -1;
+    if (k == SUN_COUNTER_FLOPS && !flops_env) continue;
+
+    fd = sunPerfOpen(types[k], configs[k], t->perf_leader);
+    if (fd < 0) continue;
+
+    if (t->perf_leader < 0) t->perf_leader = fd;
+    t->perf_fd[k]   = fd;
+    t->perf_slot[k] = t->perf_nslots++;
+  }
+
+  if (t->perf_leader < 0)
+  {
+    t->perf_state = -1;
+    return;
   }
+
+  ioctl(t->perf_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(t->perf_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  t->perf_state = 1;
+#else
+  t->perf_state = -1;
+#endif
 }
 
-static void sunStartTiming(sunTimerStruct* entry)
+static void sunPerfStop(sunProfilerThread* t)
 {
-#if SUNDIALS_MPI_ENABLED
-  entry->tic = MPI_Wtime();
-#else
-  clock_gettime(CLOCK_MONOTONIC, entry->tic);
+#if defined(SUNDIALS_HAVE_PERF_EVENTS)
+  int k;
+  if (t->perf_state != 1) return;
+  for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++)
+    if (t->perf_fd[k] >= 0) close(t->perf_fd[k]);
 #endif
+  t->perf_state = 0;
 }
 
-static void sunStopTiming(sunTimerStruct* entry)
+/* Read the hardware counters of a thread (zero if they are not counting).
+   The counters may be read from any thread. */
+static void sunPerfRead(sunProfilerThread* t, long long* counters)
 {
-#if SUNDIALS_MPI_ENABLED
-  entry->toc = MPI_Wtime();
-  entry->elapsed += entry->toc - entry->tic;
-#else
-  clock_gettime(CLOCK_MONOTONIC, entry->toc);
-  entry->elapsed +=
-    ((double) (entry->toc->tv_sec - entry->tic->tv_sec) +
-     (double) (entry->toc->tv_nsec - entry->tic->tv_nsec) * 1e-9);
+  int k;
+#if defined(SUNDIALS_HAVE_PERF_EVENTS)
+  unsigned long long buffer[SUN_PROFILER_NCOUNTERS + 1];
+
+  if (t->perf_state == 1 &&
+      read(t->perf_leader, buffer, sizeof(buffer)) >= (ssize_t)
+      ((t->perf_nslots + 1) * sizeof(unsigned long long)))
+  {
+    for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++)
+      counters[k] = (t->perf_slot[k] < 0) ? 0 :
+                    (long long) buffer[t->perf_slot[k] + 1];
+    return;
+  }
 #endif
-  /* Initialize to total value */
-  entry->average = entry->elapsed;
-  entry->maximum = entry->elapsed;
+  for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++) counters[k] = 0;
 }
 
-static void sunResetTiming(sunTimerStruct* entry)
+static void sunTimerNameFree(void* ptr)
 {
-#if SUNDIALS_MPI_ENABLED
-  entry->tic = 0.0;
-  entry->toc = 0.0;
-#else
-  entry->tic->tv_sec  = 0;
-  entry->tic->tv_nsec = 0;
-  entry->toc->tv_sec  = 0;
-  entry->toc->tv_nsec = 0;
+  sunTimerName* tn = (sunTimerName*) ptr;
+  if (tn)
+  {
+    free(tn->name);
+    free(tn);
+  }
+}
+
+static void sunProfilerThreadFree(sunProfilerThread* t)
+{
+  if (!t) return;
+  sunPerfStop(t);
+  free(t->timers);
+  free(t->cache);
+  free(t->nodes);
+  free(t->stack);
+  free(t->events);
+  free(t);
+}
+
+static sunProfilerThread* sunProfilerThreadNew(const void* key, int tid)
+{
+  sunProfilerThread* t;
+
+  t = (sunProfilerThread*) calloc(1, sizeof(sunProfilerThread));
+  if (!t) return NULL;
+
+  t->key = key;
+  t->tid = tid;
+
+  t->cache_size = 64;
+  t->cache = (sunNameCacheEntry*) calloc(t->cache_size,
+                                         sizeof(sunNameCacheEntry));
+
+  /* node 0 is the root of the call tree */
+  t->nodes_alloc = 64;
+  t->nodes = (sunProfilerNode*) calloc(t->nodes_alloc,
+                                       sizeof(sunProfilerNode));
+
+  t->stack_alloc = 32;
+  t->stack = (sunProfilerFrame*) calloc(t->stack_alloc,
+                                        sizeof(sunProfilerFrame));
+
+  if (!(t->cache) || !(t->nodes) || !(t->stack))
+  {
+    sunProfilerThreadFree(t);
+    return NULL;
+  }
+
+  t->nodes[0].timer   = -1;
+  t->nodes[0].parent  = -1;
+  t->nodes[0].child   = -1;
+  t->nodes[0].sibling = -1;
+  t->nnodes = 1;
+
+  return t;
+}
+
+/* Get the timing data of the calling thread */
+static sunProfilerThread* sunGetThread(SUNProfiler p)
+{
+  sunProfilerThread* t;
+
+  if (sun_tls_profiler == p && sun_tls_serial == p->serial)
+    return sun_tls_thread;
+
+  SUN_PROFILER_LOCK(p);
+  for (t = p->threads; t; t = t->next)
+    if (t->key == (const void*) &sun_tls_key) break;
+  if (!t)
+  {
+    t = sunProfilerThreadNew((const void*) &sun_tls_key, p->nthreads);
+    if (t)
+    {
+      /* append to keep the threads in creation order */
+      if (p->threads)
+      {
+        sunProfilerThread* last = p->threads;
+        while (last->next) last = last->next;
+        last->next = t;
+      }
+      else { p->threads = t; }
+      p->nthreads++;
+    }
+  }
+  SUN_PROFILER_UNLOCK(p);
+
+  if (t)
+  {
+    sun_tls_profiler = p;
+    sun_tls_serial   = p->serial;
+    sun_tls_thread   = t;
+  }
+
+  return t;
+}
+
+/* Register a timer name (or find the registered name) and return its id */
+static int sunRegisterName(SUNProfiler p, const char* name,
+                           const char** registered)
+{
+  int id = -1;
+  char** names;
+  sunTimerName* tn = NULL;
+
+  SUN_PROFILER_LOCK(p);
+
+  if (SUNHashMap_GetValue(p->map, name, (void**) &tn) == 0)
+  {
+    *registered = tn->name;
+    id = tn->id;
+    SUN_PROFILER_UNLOCK(p);
+    return id;
+  }
+
+  if (p->ntimers == p->names_alloc)
+  {
+    names = (char**) realloc(p->names, 2 * p->names_alloc * sizeof(char*));
+    if (!names) { SUN_PROFILER_UNLOCK(p); return -1; }
+    p->names = names;
+    p->names_alloc *= 2;
+  }
+
+  tn = (sunTimerName*) malloc(sizeof(sunTimerName));
+  if (tn) tn->name = (char*) malloc((strlen(name) + 1) * sizeof(char));
+  if (!tn || !(tn->name))
+  {
+    free(tn);
+    SUN_PROFILER_UNLOCK(p);
+    return -1;
+  }
+  strcpy(tn->name, name);
+  tn->id = p->ntimers;
+
+  if (SUNHashMap_Insert(p->map, tn->name, (void*) tn))
+  {
+#ifdef SUNDIALS_DEBUG
+    SUNDIALS_DEBUG_PRINT("(((( [ERROR] in SUNProfilerBegin: SUNHashMapInsert failed, increase SUNPROFILER_MAX_ENTRIES ))))\n");
 #endif
-  entry->elapsed = 0.0;
-  entry->average = 0.0;
-  entry->maximum = 0.0;
-  entry->count   = 0;
+    sunTimerNameFree(tn);
+    SUN_PROFILER_UNLOCK(p);
+    return -1;
+  }
+
+  p->names[p->ntimers] = tn->name;
+  id = p->ntimers++;
+  *registered = tn->name;
+
+  SUN_PROFILER_UNLOCK(p);
+
+  return id;
 }
 
+static size_t sunCacheIndex(const char* key, int size)
+{
+  return (((size_t) key) >> 3) & ((size_t) size - 1);
+}
 
-/*
-  SUNProfiler.
+static void sunCacheInsert(sunNameCacheEntry* cache, int size,
+                           sunNameCacheEntry entry)
+{
+  size_t i = sunCacheIndex(entry.key, size);
+  while (cache[i].key) i = (i + 1) & ((size_t) size - 1);
+  cache[i] = entry;
+}
 
-  This structure holds all of the timers in a map.s
- */
+/* Look up the id of a timer name. The cache is keyed by the address of the
+   name and a hit is confirmed by comparing the strings, so names stored in
+   reused buffers are handled correctly. */
+static int sunLookupName(SUNProfiler p, sunProfilerThread* t,
+                         const char* name)
+{
+  int i, id, new_size;
+  size_t k;
+  const char* registered = NULL;
+  sunNameCacheEntry entry;
+  sunNameCacheEntry* new_cache;
+
+  k = sunCacheIndex(name, t->cache_size);
+  while (t->cache[k].key)
+  {
+    if (t->cache[k].key == name && !strcmp(name, t->cache[k].name))
+      return t->cache[k].id;
+    k = (k + 1) & ((size_t) t->cache_size - 1);
+  }
 
-struct _SUNProfiler
+  id = sunRegisterName(p, name, &registered);
+  if (id < 0) return -1;
+
+  /* Keep the load factor at or below one half */
+  if (2 * (t->cache_used + 1) > t->cache_size)
+  {
+    new_size  = 2 * t->cache_size;
+    new_cache = (sunNameCacheEntry*) calloc(new_size,
+                                            sizeof(sunNameCacheEntry));
+    if (!new_cache) return id;
+    for (i = 0; i < t->cache_size; i++)
+      if (t->cache[i].key) sunCacheInsert(new_cache, new_size, t->cache[i]);
+    free(t->cache);
+    t->cache      = new_cache;
+    t->cache_size = new_size;
+  }
+
+  entry.key  = name;
+  entry.name = registered;
+  entry.id   = id;
+  sunCacheInsert(t->cache, t->cache_size, entry);
+  t->cache_used++;
+
+  return id;
+}
+
+/* Ensure the thread has flat timer data for timer id */
+static int sunThreadTimers(sunProfilerThread* t, int id)
 {
-  void*           comm;
-  char*           title;
-  SUNHashMap      map;
-  sunTimerStruct* overhead;
-  double          sundials_time;
-};
+  int n;
+  sunThreadTimer* timers;
+
+  if (id < t->ntimers) return 0;
+
+  n = SUNMAX(2 * t->ntimers, id + 16);
+  timers = (sunThreadTimer*) realloc(t->timers, n * sizeof(sunThreadTimer));
+  if (!timers) return -1;
+  memset(timers + t->ntimers, 0, (n - t->ntimers) * sizeof(sunThreadTimer));
+  t->timers  = timers;
+  t->ntimers = n;
+
+  return 0;
+}
+
+static int sunBegin(SUNProfiler p, sunProfilerThread* t, int id)
+{
+  int k, parent, node;
+  sunProfilerNode* nodes;
+  sunProfilerFrame* stack;
+
+  if (sunThreadTimers(t, id)) return -1;
+
+  /* Find (or create) the call tree node of this timer below the current
+     region */
+  parent = t->depth ? t->stack[t->depth - 1].node : 0;
+  for (node = t->nodes[parent].child; node >= 0; node = t->nodes[node].sibling)
+    if (t->nodes[node].timer == id) break;
+
+  if (node < 0)
+  {
+    if (t->nnodes == t->nodes_alloc)
+    {
+      nodes = (sunProfilerNode*) realloc(t->nodes, 2 * t->nodes_alloc *
+                                         sizeof(sunProfilerNode));
+      if (!nodes) return -1;
+      t->nodes = nodes;
+      t->nodes_alloc *= 2;
+    }
+    node = t->nnodes++;
+    t->nodes[node].timer   = id;
+    t->nodes[node].parent  = parent;
+    t->nodes[node].child   = -1;
+    t->nodes[node].sibling = t->nodes[parent].child;
+    t->nodes[node].elapsed = 0.0;
+    t->nodes[node].count   = 0;
+    for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++) t->nodes[node].counters[k] = 0;
+    t->nodes[parent].child = node;
+  }
+
+  if (t->depth == t->stack_alloc)
+  {
+    stack = (sunProfilerFrame*) realloc(t->stack, 2 * t->stack_alloc *
+                                        sizeof(sunProfilerFrame));
+    if (!stack) return -1;
+    t->stack = stack;
+    t->stack_alloc *= 2;
+  }
+
+  t->nodes[node].count++;
+  t->timers[id].count++;
+  t->timers[id].active++;
+  t->ncalls++;
+
+  t->stack[t->depth].node     = node;
+  t->stack[t->depth].counting = 0;
+  if (p->counters)
+  {
+    if (t->perf_state == 0) sunPerfStart(t);
+    if (t->perf_state == 1)
+    {
+      t->stack[t->depth].counting = 1;
+      sunPerfRead(t, t->stack[t->depth].counters);
+    }
+  }
+  t->stack[t->depth].tic = sunProfilerTime();
+  t->depth++;
+
+  return 0;
+}
+
+static void sunRecordEvent(SUNProfiler p, sunProfilerThread* t, int id,
+                           double tic, double toc)
+{
+  long n;
+  sunProfilerEvent* events;
+
+  if (t->nevents == t->events_alloc)
+  {
+    if (t->events_alloc >= p->max_events) { t->dropped++; return; }
+    n = SUNMIN(SUNMAX(2 * t->events_alloc, 1024), p->max_events);
+    events = (sunProfilerEvent*) realloc(t->events,
+                                         n * sizeof(sunProfilerEvent));
+    if (!events) { t->dropped++; return; }
+    t->events       = events;
+    t->events_alloc = n;
+  }
+
+  t->events[t->nevents].timer = id;
+  t->events[t->nevents].tic   = tic;
+  t->events[t->nevents].toc   = toc;
+  t->nevents++;
+}
+
+/* End the innermost open region of timer id. Regions opened inside it that
+   are still open are ended as well. */
+static int sunEnd(SUNProfiler p, sunProfilerThread* t, int id)
+{
+  int j, k, node, timer, outermost;
+  double dt;
+  long long dc;
+  long long counters[SUN_PROFILER_NCOUNTERS];
+  double toc = sunProfilerTime();
+
+  for (k = t->depth - 1; k >= 0; k--)
+    if (t->nodes[t->stack[k].node].timer == id) break;
+  if (k < 0) return -1;
+
+  if (t->perf_state == 1) sunPerfRead(t, counters);
+
+  while (t->depth > k)
+  {
+    t->depth--;
+    node  = t->stack[t->depth].node;
+    timer = t->nodes[node].timer;
+    dt    = toc - t->stack[t->depth].tic;
+
+    outermost = (--(t->timers[timer].active) == 0);
+
+    t->nodes[node].elapsed += dt;
+    if (outermost) t->timers[timer].elapsed += dt;
+
+    if (t->stack[t->depth].counting && t->perf_state == 1)
+    {
+      for (j = 0; j < SUN_PROFILER_NCOUNTERS; j++)
+      {
+        dc = counters[j] - t->stack[t->depth].counters[j];
+        t->nodes[node].counters[j] += dc;
+        if (outermost) t->timers[timer].counters[j] += dc;
+      }
+    }
+
+    if (p->max_events > 0)
+      sunRecordEvent(p, t, timer, t->stack[t->depth].tic, toc);
+  }
+
+  return 0;
+}
+
+/* Reset the timing data of a thread, open regions restart at time now */
+static void sunResetThread(sunProfilerThread* t, double now)
+{
+  int i, node;
+  long long counters[SUN_PROFILER_NCOUNTERS];
+
+  sunPerfRead(t, counters);
+
+  for (i = 0; i < t->ntimers; i++)
+  {
+    t->timers[i].elapsed = 0.0;
+    t->timers[i].count   = 0;
+    memset(t->timers[i].counters, 0, sizeof(counters));
+  }
+  for (i = 0; i < t->nnodes; i++)
+  {
+    t->nodes[i].elapsed = 0.0;
+    t->nodes[i].count   = 0;
+    memset(t->nodes[i].counters, 0, sizeof(counters));
+  }
+  for (i = 0; i < t->depth; i++)
+  {
+    node = t->stack[i].node;
+    t->stack[i].tic = now;
+    memcpy(t->stack[i].counters, counters, sizeof(counters));
+    t->nodes[node].count = 1;
+    t->timers[t->nodes[node].timer].count++;
+  }
+  t->nevents = 0;
+  t->dropped = 0;
+  t->ncalls  = t->depth;
+}
+
+/* Add the counts of an open region up to the current counter values */
+static void sunAddOpenCounters(sunProfilerFrame* frame, const long long* now,
+                               long long* counters)
+{
+  int j;
+  if (!counters || !(frame->counting)) return;
+  for (j = 0; j < SUN_PROFILER_NCOUNTERS; j++)
+    counters[j] += now[j] - frame->counters[j];
+}
+
+/* Inclusive flat time (and optionally hardware counts) of a timer on a
+   thread including open regions. The current counter values of the thread
+   are given in now_counters. */
+static double sunThreadTimerElapsed(sunProfilerThread* t, int id, double now,
+                                    const long long* now_counters,
+                                    long long* counters)
+{
+  int k;
+  double elapsed;
+
+  if (counters) memset(counters, 0, SUN_PROFILER_NCOUNTERS * sizeof(long long));
+  if (id >= t->ntimers) return 0.0;
+
+  elapsed = t->timers[id].elapsed;
+  if (counters)
+    memcpy(counters, t->timers[id].counters,
+           SUN_PROFILER_NCOUNTERS * sizeof(long long));
+
+  if (t->timers[id].active)
+  {
+    /* the outermost open activation is the first one on the stack */
+    for (k = 0; k < t->depth; k++)
+    {
+      if (t->nodes[t->stack[k].node].timer == id)
+      {
+        elapsed += now - t->stack[k].tic;
+        sunAddOpenCounters(&(t->stack[k]), now_counters, counters);
+        break;
+      }
+    }
+  }
+
+  return elapsed;
+}
+
+/* Inclusive time (and optionally hardware counts) of a call tree node
+   including an open region */
+static double sunNodeElapsed(sunProfilerThread* t, int node, double now,
+                             const long long* now_counters,
+                             long long* counters)
+{
+  int k;
+  double elapsed = t->nodes[node].elapsed;
+
+  if (counters)
+    memcpy(counters, t->nodes[node].counters,
+           SUN_PROFILER_NCOUNTERS * sizeof(long long));
+
+  for (k = 0; k < t->depth; k++)
+  {
+    if (t->stack[k].node == node)
+    {
+      elapsed += now - t->stack[k].tic;
+      sunAddOpenCounters(&(t->stack[k]), now_counters, counters);
+      break;
+    }
+  }
+
+  return elapsed;
+}
+
+/* Bit mask of the counters that are available on any thread */
+static int sunCounterMask(SUNProfiler p)
+{
+  int k, mask = 0;
+  sunProfilerThread* t;
+
+  if (!(p->counters)) return 0;
+  for (t = p->threads; t; t = t->next)
+    if (t->perf_state == 1)
+      for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++)
+        if (t->perf_slot[k] >= 0) mask |= 1 << k;
+
+  return mask;
+}
+
+/* Estimate the cost of a Begin/End pair on this machine */
+static void sunCalibrate(SUNProfiler p, sunProfilerThread* t)
+{
+  int i;
+  double tic, toc;
+  long max_events = p->max_events;
+
+  p->max_events = 0;
+
+  /* warm up the name cache and the call tree before timing */
+  SUNProfiler_Begin(p, SUNDIALS_ROOT_TIMER);
+  SUNProfiler_End(p, SUNDIALS_ROOT_TIMER);
+
+  tic = sunProfilerTime();
+  for (i = 0; i < SUN_PROFILER_CALIBRATION_CALLS; i++)
+  {
+    SUNProfiler_Begin(p, SUNDIALS_ROOT_TIMER);
+    SUNProfiler_End(p, SUNDIALS_ROOT_TIMER);
+  }
+  toc = sunProfilerTime();
+  p->max_events = max_events;
+
+  p->overhead = (toc - tic) / SUN_PROFILER_CALIBRATION_CALLS;
+  sunResetThread(t, toc);
+}
 
 int SUNProfiler_Create(void* comm, const char* title, SUNProfiler* p)
 {
   SUNProfiler profiler;
   int max_entries;
   char* max_entries_env;
+  char* trace_env;
+  char* max_events_env;
+  char* counters_env;
+  sunProfilerThread* t;
 
-  *p = profiler = (SUNProfiler) malloc(sizeof(struct _SUNProfiler));
+  *p = profiler = (SUNProfiler) calloc(1, sizeof(struct _SUNProfiler));
 
   if (profiler == NULL)
     return(-1);
 
-  profiler->overhead = sunTimerStructNew();
-  if (profiler->overhead == NULL)
-  {
-    free(profiler);
-    *p = profiler = NULL;
-    return(-1);
-  }
+  SUN_PROFILER_LOCK_INIT(profiler);
 
-  sunStartTiming(profiler->overhead);
+  profiler->epoch  = sunProfilerTime();
+  profiler->serial = SUN_ATOMIC_INCREMENT(sun_profiler_serial);
 
   /* Check to see if max entries env variable was set, and use if it was. */
   max_entries = 2560;
@@ -185,15 +921,35 @@ int SUNProfiler_Create(void* comm, const char* title, SUNProfiler* p)
   if (max_entries_env) max_entries = atoi(max_entries_env);
   if (max_entries <= 0) max_entries = 2560;
 
-  /* Create the hashmap used to store the timers */
+  /* Create the hashmap used to store the timer names */
   if (SUNHashMap_New(max_entries, &profiler->map))
   {
-    sunTimerStructFree((void*) profiler->overhead);
     free(profiler);
     *p = profiler = NULL;
     return(-1);
   }
 
+  profiler->names_alloc = 64;
+  profiler->names = (char**) malloc(profiler->names_alloc * sizeof(char*));
+  if (profiler->names == NULL)
+  {
+    SUNHashMap_Destroy(&profiler->map, sunTimerNameFree);
+    free(profiler);
+    *p = profiler = NULL;
+    return(-1);
+  }
+
+  /* Enable tracing if requested through the environment */
+  trace_env = getenv("SUNPROFILER_TRACE");
+  if (trace_env && strcmp(trace_env, "0"))
+  {
+    profiler->max_events = SUN_PROFILER_DEFAULT_MAX_EVENTS;
+    max_events_env = getenv("SUNPROFILER_MAX_EVENTS");
+    if (max_events_env) profiler->max_events = atol(max_events_env);
+    if (profiler->max_events <= 0)
+      profiler->max_events = SUN_PROFILER_DEFAULT_MAX_EVENTS;
+  }
+
   /* Attach the comm, duplicating it if MPI is used. */
 #if SUNDIALS_MPI_ENABLED
   profiler->comm = NULL;
@@ -214,22 +970,48 @@ int SUNProfiler_Create(void* comm, const char* title, SUNProfiler* p)
   /* Initialize the overall timer to 0. */
   profiler->sundials_time = 0.0;
 
-  SUNDIALS_MARK_BEGIN(profiler, SUNDIALS_ROOT_TIMER);
-  sunStopTiming(profiler->overhead);
+  /* Register the root timer, estimate the profiler overhead, and start the
+     root timer */
+  t = sunGetThread(profiler);
+  profiler->root = t ? sunLookupName(profiler, t, SUNDIALS_ROOT_TIMER) : -1;
+  if (profiler->root < 0)
+  {
+    SUNProfiler_Free(p);
+    return(-1);
+  }
+  sunCalibrate(profiler, t);
+  sunBegin(profiler, t, profiler->root);
+
+  /* Enable the hardware counters if requested through the environment */
+  counters_env = getenv("SUNPROFILER_COUNTERS");
+  if (counters_env && strcmp(counters_env, "0"))
+  {
+    if (SUNProfiler_EnableCounters(profiler, 1))
+    {
+      fprintf(stderr, "WARNING: SUNProfiler hardware counters are not "
+              "available\n");
+    }
+  }
 
   return(0);
 }
 
 int SUNProfiler_Free(SUNProfiler* p)
 {
-  if (p == NULL) return(-1);
+  sunProfilerThread* t;
+  sunProfilerThread* next;
 
-  SUNDIALS_MARK_END(*p, SUNDIALS_ROOT_TIMER);
+  if (p == NULL) return(-1);
 
   if (*p)
   {
-    SUNHashMap_Destroy(&(*p)->map, sunTimerStructFree);
-    sunTimerStructFree((void*) (*p)->overhead);
+    for (t = (*p)->threads; t; t = next)
+    {
+      next = t->next;
+      sunProfilerThreadFree(t);
+    }
+    SUNHashMap_Destroy(&(*p)->map, sunTimerNameFree);
+    free((*p)->names);
 #if SUNDIALS_MPI_ENABLED
     if ((*p)->comm)
     {
@@ -238,6 +1020,7 @@ int SUNProfiler_Free(SUNProfiler* p)
     }
 #endif
     free((*p)->title);
+    if (sun_tls_profiler == *p) sun_tls_profiler = NULL;
     free(*p);
   }
   *p = NULL;
@@ -247,125 +1030,296 @@ int SUNProfiler_Free(SUNProfiler* p)
 
 int SUNProfiler_Begin(SUNProfiler p, const char* name)
 {
-  int ier;
-  sunTimerStruct* timer = NULL;
-#ifdef SUNDIALS_DEBUG
-  size_t slen;
-  char* errmsg;
-#endif
+  int id;
+  sunProfilerThread* t;
 
-  if (p == NULL) return(-1);
-  sunStartTiming(p->overhead);
+  if (p == NULL || name == NULL) return(-1);
 
-  if (SUNHashMap_GetValue(p->map, name, (void**) &timer))
-  {
-    timer = sunTimerStructNew();
-    ier = SUNHashMap_Insert(p->map, name, (void*) timer);
-    if (ier)
-    {
-#ifdef SUNDIALS_DEBUG
-      slen = strlen(name);
-      errmsg = malloc(slen*sizeof(char));
-      snprintf(errmsg, 128+slen, "(((( [ERROR] in SUNProfilerBegin: SUNHashMapInsert failed with code %d while inserting %s))))\n", ier, name);
-      SUNDIALS_DEBUG_PRINT(errmsg);
-      free(errmsg);
-#endif
-      sunTimerStructFree(timer);
-      sunStopTiming(p->overhead);
-      return(-1);
-    }
-  }
+  t = sunGetThread(p);
+  if (t == NULL) return(-1);
 
-  timer->count++;
-  sunStartTiming(timer);
+  id = sunLookupName(p, t, name);
+  if (id < 0) return(-1);
 
-  sunStopTiming(p->overhead);
-  return(0);
+  return(sunBegin(p, t, id));
 }
 
 int SUNProfiler_End(SUNProfiler p, const char* name)
 {
-  sunTimerStruct* timer;
+  int id;
+  sunProfilerThread* t;
+
+  if (p == NULL || name == NULL) return(-1);
+
+  t = sunGetThread(p);
+  if (t == NULL) return(-1);
+
+  id = sunLookupName(p, t, name);
+  if (id < 0) return(-1);
+
+  return(sunEnd(p, t, id));
+}
+
+int SUNProfiler_GetTimerId(SUNProfiler p, const char* name, int* id)
+{
+  sunProfilerThread* t;
+
+  if (p == NULL || name == NULL || id == NULL) return(-1);
+
+  t = sunGetThread(p);
+  if (t == NULL) return(-1);
+
+  *id = sunLookupName(p, t, name);
+
+  return (*id < 0) ? -1 : 0;
+}
+
+int SUNProfiler_BeginId(SUNProfiler p, int id)
+{
+  sunProfilerThread* t;
+
+  if (p == NULL || id < 0 || id >= p->ntimers) return(-1);
+
+  t = sunGetThread(p);
+  if (t == NULL) return(-1);
+
+  return(sunBegin(p, t, id));
+}
+
+int SUNProfiler_EndId(SUNProfiler p, int id)
+{
+  sunProfilerThread* t;
+
+  if (p == NULL || id < 0 || id >= p->ntimers) return(-1);
+
+  t = sunGetThread(p);
+  if (t == NULL) return(-1);
+
+  return(sunEnd(p, t, id));
+}
+
+int SUNProfiler_EnableTrace(SUNProfiler p, long int max_events)
+{
+  if (p == NULL) return(-1);
+  if (max_events < 0) max_events = SUN_PROFILER_DEFAULT_MAX_EVENTS;
+  p->max_events = max_events;
+  return(0);
+}
+
+int SUNProfiler_EnableCounters(SUNProfiler p, int onoff)
+{
+  int i, k;
+  double tic, toc;
+  long long counters[SUN_PROFILER_NCOUNTERS];
+  sunProfilerThread* t;
 
   if (p == NULL) return(-1);
-  sunStartTiming(p->overhead);
 
-  if (SUNHashMap_GetValue(p->map, name, (void**) &timer))
+  if (!onoff)
   {
-    sunStopTiming(p->overhead);
-    return(-1);
+    p->counters = 0;
+    p->counter_overhead = 0.0;
+    return(0);
   }
 
-  sunStopTiming(timer);
+#if defined(SUNDIALS_HAVE_PERF_EVENTS)
+  t = sunGetThread(p);
+  if (t == NULL) return(-1);
+
+  if (t->perf_state == 0) sunPerfStart(t);
+  if (t->perf_state != 1) return(-1);
+
+  /* Regions open on this thread (e.g., the root timer) count from now */
+  sunPerfRead(t, counters);
+  for (k = 0; k < t->depth; k++)
+  {
+    if (!(t->stack[k].counting))
+    {
+      t->stack[k].counting = 1;
+      memcpy(t->stack[k].counters, counters, sizeof(counters));
+    }
+  }
+
+  /* Estimate the cost of the two counter reads in a Begin/End pair */
+  tic = sunProfilerTime();
+  for (i = 0; i < SUN_PROFILER_CALIBRATION_CALLS; i++)
+    sunPerfRead(t, counters);
+  toc = sunProfilerTime();
+
+  p->counter_overhead = 2 * (toc - tic) / SUN_PROFILER_CALIBRATION_CALLS;
+  p->counters = 1;
 
-  sunStopTiming(p->overhead);
   return(0);
+#else
+  (void) i; (void) k; (void) tic; (void) toc; (void) counters; (void) t;
+  return(-1);
+#endif
 }
 
 int SUNProfiler_Reset(SUNProfiler p)
 {
-  int i = 0;
-  sunTimerStruct* timer = NULL;
+  double now;
+  sunProfilerThread* t;
 
   /* Check for valid input */
   if (!p) return -1;
-  if (!(p->overhead)) return -1;
   if (!(p->map)) return -1;
-  if (!(p->map->buckets)) return -1;
 
-  /* Reset the overhead timer */
-  sunResetTiming(p->overhead);
-  sunStartTiming(p->overhead);
+  now = sunProfilerTime();
 
-  /* Reset all timers */
-  for (i = 0; i < p->map->max_size; i++)
-  {
-    if (!(p->map->buckets[i])) continue;
-    timer = p->map->buckets[i]->value;
-    if (timer) sunResetTiming(timer);
-  }
+  /* Reset all timers, open regions (e.g., the root timer) restart now */
+  SUN_PROFILER_LOCK(p);
+  for (t = p->threads; t; t = t->next) sunResetThread(t, now);
+  SUN_PROFILER_UNLOCK(p);
 
   /* Reset the overall timer. */
   p->sundials_time = 0.0;
 
-  SUNDIALS_MARK_BEGIN(p, SUNDIALS_ROOT_TIMER);
-  sunStopTiming(p->overhead);
-
   return 0;
 }
 
+/* Merge the flat timers of all threads. The counts (and hardware counts)
+   are summed and the elapsed time (and number of profiler calls) is the
+   maximum over the threads. */
+static void sunMergeTimers(SUNProfiler p, sunTimerStruct* timers, double now,
+                           long* ncalls)
+{
+  int i, k;
+  double elapsed;
+  long long now_counters[SUN_PROFILER_NCOUNTERS];
+  long long counters[SUN_PROFILER_NCOUNTERS];
+  sunProfilerThread* t;
+
+  *ncalls = 0;
+  for (i = 0; i < p->ntimers; i++)
+  {
+    timers[i].elapsed = 0.0;
+    timers[i].count   = 0;
+    memset(timers[i].counters, 0, sizeof(counters));
+  }
+
+  for (t = p->threads; t; t = t->next)
+  {
+    *ncalls = SUNMAX(*ncalls, t->ncalls);
+    sunPerfRead(t, now_counters);
+    for (i = 0; i < p->ntimers && i < t->ntimers; i++)
+    {
+      elapsed = sunThreadTimerElapsed(t, i, now, now_counters, counters);
+      timers[i].elapsed = SUNMAX(timers[i].elapsed, elapsed);
+      timers[i].count  += t->timers[i].count;
+      for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++)
+        timers[i].counters[k] += counters[k];
+    }
+  }
+
+  /* Initialize to total value */
+  for (i = 0; i < p->ntimers; i++)
+  {
+    timers[i].average = timers[i].elapsed;
+    timers[i].maximum = timers[i].elapsed;
+  }
+}
+
+/* Print a hardware count, or -- if the counter is not available */
+static void sunPrintCount(FILE* fp, int mask, int k, long long count)
+{
+  if (mask & (1 << k)) fprintf(fp, "%14lld\t", count);
+  else fprintf(fp, "%14s\t", "--");
+}
+
+/* Print the hardware counters of each timer */
+static void sunPrintCounters(SUNProfiler p, sunTimerStruct* timers,
+                             const int* order, int ntimers, int mask,
+                             FILE* fp)
+{
+  int i, k;
+  sunTimerStruct* ts;
+
+  fprintf(fp, "%-40s\t", "Hardware counters:");
+  for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++)
+    fprintf(fp, "%14s\t", sun_counter_names[k]);
+  fprintf(fp, "   IPC\t FLOPs/cycle\n");
+  fprintf(fp, "================================================================================================================\n");
+
+  for (i = 0; i < ntimers; i++)
+  {
+    ts = &timers[order[i]];
+    fprintf(fp, "%-40s\t", p->names[order[i]]);
+    for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++)
+      sunPrintCount(fp, mask, k, ts->counters[k]);
+
+    if ((mask & (1 << SUN_COUNTER_CYCLES)) && ts->counters[SUN_COUNTER_CYCLES])
+    {
+      if (mask & (1 << SUN_COUNTER_INSTRUCTIONS))
+        fprintf(fp, "%6.2f\t", (double) ts->counters[SUN_COUNTER_INSTRUCTIONS] /
+                (double) ts->counters[SUN_COUNTER_CYCLES]);
+      else fprintf(fp, "%6s\t", "--");
+      if (mask & (1 << SUN_COUNTER_FLOPS))
+        fprintf(fp, " %11.3f\n", (double) ts->counters[SUN_COUNTER_FLOPS] /
+                (double) ts->counters[SUN_COUNTER_CYCLES]);
+      else fprintf(fp, " %11s\n", "--");
+    }
+    else { fprintf(fp, "%6s\t %11s\n", "--", "--"); }
+  }
+
+  fprintf(fp, "\n");
+}
+
 int SUNProfiler_Print(SUNProfiler p, FILE* fp)
 {
   int i = 0;
   int rank = 0;
-  sunTimerStruct* timer = NULL;
-  SUNHashMapKeyValue* sorted = NULL;
+  int mask = 0;
+  int ntimers;
+  long ncalls;
+  double now, overhead, percent;
+  int* order = NULL;
+  sunTimerStruct* timers = NULL;
 
   if (p == NULL) return(-1);
-  sunStartTiming(p->overhead);
 
-  /* Get the total SUNDIALS time up to this point */
-  SUNDIALS_MARK_END(p, SUNDIALS_ROOT_TIMER);
-  SUNDIALS_MARK_BEGIN(p, SUNDIALS_ROOT_TIMER);
+  now = sunProfilerTime();
 
-  if (SUNHashMap_GetValue(p->map, SUNDIALS_ROOT_TIMER, (void**) &timer))
+  SUN_PROFILER_LOCK(p);
+  ntimers = p->ntimers;
+  timers  = (sunTimerStruct*) malloc(ntimers * sizeof(sunTimerStruct));
+  order   = (int*) malloc(ntimers * sizeof(int));
+  if (timers == NULL || order == NULL)
+  {
+    SUN_PROFILER_UNLOCK(p);
+    free(timers);
+    free(order);
     return(-1);
-  p->sundials_time = timer->elapsed;
+  }
+  sunMergeTimers(p, timers, now, &ncalls);
+  mask = sunCounterMask(p);
+  SUN_PROFILER_UNLOCK(p);
+
+  /* Get the total SUNDIALS time up to this point */
+  p->sundials_time = timers[p->root].elapsed;
+  overhead = (p->overhead + (mask ? p->counter_overhead : 0.0)) *
+             (double) ncalls;
+
+  /* Order the timers by name so all ranks agree */
+  for (i = 0; i < ntimers; i++) order[i] = i;
+  sun_sort_names = p->names;
+  qsort(order, ntimers, sizeof(int), sunCompareNames);
 
 #if SUNDIALS_MPI_ENABLED
   if (p->comm)
   {
     MPI_Comm_rank(*((MPI_Comm*) p->comm), &rank);
     /* Find the max and average time across all ranks */
-    sunCollectTimers(p);
+    sunCollectTimers(p, timers, order, &mask);
   }
 #endif
 
   if (rank == 0)
   {
     /* Sort the timers in descending order */
-    if (SUNHashMap_Sort(p->map, &sorted, sunCompareTimes))
-      return(-1);
+    sun_sort_timers = timers;
+    qsort(order, ntimers, sizeof(int), sunCompareTimes);
+
     fprintf(fp, "\n================================================================================================================\n");
     fprintf(fp, "SUNDIALS GIT VERSION: %s\n", SUNDIALS_GIT_VERSION);
     fprintf(fp, "SUNDIALS PROFILER: %s\n", p->title);
@@ -377,66 +1331,297 @@ int SUNProfiler_Print(SUNProfiler p, FILE* fp)
       printf("WARNING: no MPI communicator provided, times shown are for rank 0\n");
 #endif
 
-    /* Print all the other timers out */
-    for (i = 0; i < p->map->size; i++)
-      if (sorted[i]) sunPrintTimers(i, sorted[i], fp, (void*) p);
-    free(sorted);
-  }
-
-  sunStopTiming(p->overhead);
+    /* Print all the timers out: the timer name, percentage of exec time
+       (based on the max), max across ranks, average across ranks, and the
+       timer counter. */
+    for (i = 0; i < ntimers; i++)
+    {
+      sunTimerStruct* ts = &timers[order[i]];
+      percent = (order[i] == p->root) ? 100 :
+                ts->maximum / p->sundials_time * 100;
+      fprintf(fp, "%-40s\t %6.2f%% \t         %.6fs \t %.6fs \t %ld\n",
+              p->names[order[i]], percent, ts->maximum, ts->average,
+              ts->count);
+    }
 
-  if (rank == 0)
-  {
     /* Print out the total time and the profiler overhead */
     fprintf(fp, "%-40s\t %6.2f%% \t         %.6fs \t -- \t\t -- \n", "Est. profiler overhead",
-            p->overhead->elapsed/p->sundials_time,
-            p->overhead->elapsed);
+            p->sundials_time > 0.0 ? overhead / p->sundials_time * 100 : 0.0,
+            overhead);
 
     /* End of output */
     fprintf(fp, "\n");
+
+    /* Print the hardware counters (summed over threads and ranks) */
+    if (mask) sunPrintCounters(p, timers, order, ntimers, mask, fp);
+  }
+
+  free(timers);
+  free(order);
+
+  return(0);
+}
+
+/* Print the name of a call tree node's path, e.g., "CVode/cvStep/cvNls" */
+static void sunPrintPath(SUNProfiler p, sunProfilerThread* t, int node,
+                         FILE* fp)
+{
+  const char* c;
+  int parent = t->nodes[node].parent;
+
+  if (parent > 0)
+  {
+    sunPrintPath(p, t, parent, fp);
+    fputc('/', fp);
+  }
+  for (c = p->names[t->nodes[node].timer]; *c; c++)
+  {
+    if (*c == '"') fputc('"', fp);
+    fputc(*c, fp);
+  }
+}
+
+static void sunExportNodeCSV(SUNProfiler p, sunProfilerThread* t, int node,
+                             int depth, double now,
+                             const long long* now_counters, int mask,
+                             FILE* fp)
+{
+  int k, child;
+  double inclusive, exclusive;
+  long long counters[SUN_PROFILER_NCOUNTERS];
+
+  inclusive = sunNodeElapsed(t, node, now, now_counters, counters);
+  exclusive = inclusive;
+  for (child = t->nodes[node].child; child >= 0;
+       child = t->nodes[child].sibling)
+    exclusive -= sunNodeElapsed(t, child, now, NULL, NULL);
+
+  fprintf(fp, "%d,%d,\"", t->tid, depth);
+  sunPrintPath(p, t, node, fp);
+  fprintf(fp, "\",%ld,%.9e,%.9e,%.2f", t->nodes[node].count, inclusive,
+          exclusive, p->sundials_time > 0.0 ?
+          inclusive / p->sundials_time * 100 : 0.0);
+
+  /* Inclusive hardware counts, empty if the counter is not available */
+  if (mask)
+  {
+    for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++)
+    {
+      if ((mask & (1 << k)) && t->perf_slot[k] >= 0)
+        fprintf(fp, ",%lld", counters[k]);
+      else fprintf(fp, ",");
+    }
+  }
+  fprintf(fp, "\n");
+
+  for (child = t->nodes[node].child; child >= 0;
+       child = t->nodes[child].sibling)
+    sunExportNodeCSV(p, t, child, depth + 1, now, now_counters, mask, fp);
+}
+
+int SUNProfiler_ExportCSV(SUNProfiler p, FILE* fp)
+{
+  int node, mask;
+  double now;
+  long long now_counters[SUN_PROFILER_NCOUNTERS];
+  sunProfilerThread* t;
+
+  if (p == NULL || fp == NULL) return(-1);
+
+  now = sunProfilerTime();
+
+  SUN_PROFILER_LOCK(p);
+
+  /* The root timer is open on the thread that created the profiler */
+  p->sundials_time = p->threads ?
+    sunThreadTimerElapsed(p->threads, p->root, now, NULL, NULL) : 0.0;
+
+  mask = sunCounterMask(p);
+
+  fprintf(fp, "thread,depth,path,count,inclusive,exclusive,percent");
+  if (mask) fprintf(fp, ",cycles,instructions,llc_misses,flops");
+  fprintf(fp, "\n");
+
+  for (t = p->threads; t; t = t->next)
+  {
+    sunPerfRead(t, now_counters);
+    for (node = t->nodes[0].child; node >= 0; node = t->nodes[node].sibling)
+      sunExportNodeCSV(p, t, node, 0, now, now_counters, mask, fp);
+  }
+
+  SUN_PROFILER_UNLOCK(p);
+
+  return(0);
+}
+
+static void sunPrintJSONString(const char* str, FILE* fp)
+{
+  const char* c;
+
+  fputc('"', fp);
+  for (c = str; *c; c++)
+  {
+    if (*c == '"' || *c == '\\') { fputc('\\', fp); fputc(*c, fp); }
+    else if ((unsigned char) *c < 0x20) { fprintf(fp, "\\u%04x", *c); }
+    else { fputc(*c, fp); }
+  }
+  fputc('"', fp);
+}
+
+static void sunPrintTraceEvent(SUNProfiler p, int pid, int tid, int timer,
+                               double tic, double toc, int* first, FILE* fp)
+{
+  fprintf(fp, "%s\n{\"name\":", *first ? "" : ",");
+  sunPrintJSONString(p->names[timer], fp);
+  fprintf(fp, ",\"cat\":\"sundials\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+          "\"ts\":%.3f,\"dur\":%.3f}", pid, tid, (tic - p->epoch) * 1e6,
+          (toc - tic) * 1e6);
+  *first = 0;
+}
+
+int SUNProfiler_ExportTrace(SUNProfiler p, FILE* fp)
+{
+  int k, first = 1;
+  int rank = 0;
+  long i, dropped = 0;
+  double now;
+  sunProfilerThread* t;
+
+  if (p == NULL || fp == NULL) return(-1);
+
+  now = sunProfilerTime();
+
+#if SUNDIALS_MPI_ENABLED
+  if (p->comm) MPI_Comm_rank(*((MPI_Comm*) p->comm), &rank);
+#endif
+
+  SUN_PROFILER_LOCK(p);
+
+  fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"title\":");
+  sunPrintJSONString(p->title, fp);
+  fprintf(fp, "},\"traceEvents\":[");
+
+  for (t = p->threads; t; t = t->next)
+  {
+    fprintf(fp, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+            "\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+            first ? "" : ",", rank, t->tid, t->tid);
+    first = 0;
+
+    for (i = 0; i < t->nevents; i++)
+      sunPrintTraceEvent(p, rank, t->tid, t->events[i].timer,
+                         t->events[i].tic, t->events[i].toc, &first, fp);
+
+    /* Regions that are still open end now */
+    for (k = 0; k < t->depth; k++)
+      sunPrintTraceEvent(p, rank, t->tid, t->nodes[t->stack[k].node].timer,
+                         t->stack[k].tic, now, &first, fp);
+
+    dropped += t->dropped;
+  }
+
+  fprintf(fp, "\n]}\n");
+
+  SUN_PROFILER_UNLOCK(p);
+
+  if (dropped > 0)
+  {
+    fprintf(stderr, "WARNING: SUNProfiler trace buffer full, %ld events were "
+            "dropped (increase SUNPROFILER_MAX_EVENTS)\n", dropped);
   }
 
   return(0);
 }
 
+/* Write the exports requested by the SUNPROFILER_TRACE and SUNPROFILER_CSV
+   environment variables. With more than one MPI rank the file names are
+   suffixed with the rank. */
+int sunProfilerExportFromEnv(SUNProfiler p)
+{
+  int i, retval = 0;
+  int rank = 0;
+  int nranks = 1;
+  FILE* fp;
+  char* env;
+  char* fname;
+  const char* vars[2] = { "SUNPROFILER_TRACE", "SUNPROFILER_CSV" };
+
+  if (p == NULL) return(-1);
+
+#if SUNDIALS_MPI_ENABLED
+  if (p->comm)
+  {
+    MPI_Comm_rank(*((MPI_Comm*) p->comm), &rank);
+    MPI_Comm_size(*((MPI_Comm*) p->comm), &nranks);
+  }
+#endif
+
+  for (i = 0; i < 2; i++)
+  {
+    env = getenv(vars[i]);
+    if (!env || !strcmp(env, "0") || !strlen(env)) continue;
+
+    fname = (char*) malloc((strlen(env) + 16) * sizeof(char));
+    if (!fname) return(-1);
+    if (nranks > 1) sprintf(fname, "%s.%d", env, rank);
+    else strcpy(fname, env);
+
+    fp = fopen(fname, "w");
+    if (fp)
+    {
+      if (i == 0) retval += SUNProfiler_ExportTrace(p, fp);
+      else retval += SUNProfiler_ExportCSV(p, fp);
+      fclose(fp);
+    }
+    else { retval = -1; }
+
+    free(fname);
+  }
+
+  return(retval);
+}
+
 #if SUNDIALS_MPI_ENABLED
 static void sunTimerStructReduceMaxAndSum(void* a, void* b, int* len, MPI_Datatype* dType)
 {
   sunTimerStruct* a_ts = (sunTimerStruct*) a;
   sunTimerStruct* b_ts = (sunTimerStruct*) b;
   int i;
+  int k;
   for (i = 0; i < *len; ++i) {
-    b_ts[i].average += a_ts[i].elapsed;
+    b_ts[i].average += a_ts[i].average;
     b_ts[i].maximum = SUNMAX(a_ts[i].maximum, b_ts[i].maximum);
+    for (k = 0; k < SUN_PROFILER_NCOUNTERS; k++)
+      b_ts[i].counters[k] += a_ts[i].counters[k];
   }
 }
 
-/* Find the max and average time across all ranks */
-int sunCollectTimers(SUNProfiler p)
+/* Find the max and average time (and the total hardware counts) across all
+   ranks. The timers are reduced in the order of their names. */
+int sunCollectTimers(SUNProfiler p, sunTimerStruct* timers, int* order,
+                     int* mask)
 {
   int i, rank, nranks;
+  int ntimers = p->ntimers;
 
   MPI_Comm comm = *((MPI_Comm*) p->comm);
   MPI_Comm_rank(comm, &rank);
   MPI_Comm_size(comm, &nranks);
 
-  sunTimerStruct** values = NULL;
-
-  /* Extract the elapsed times from the hash map */
-  SUNHashMap_Values(p->map, (void***) &values, sizeof(sunTimerStruct));
-  sunTimerStruct* reduced = (sunTimerStruct*) malloc(p->map->size*sizeof(sunTimerStruct));
-  for (i = 0; i < p->map->size; ++i)
-    reduced[i] = *values[i];
+  sunTimerStruct* reduced = (sunTimerStruct*) malloc(ntimers*sizeof(sunTimerStruct));
+  for (i = 0; i < ntimers; ++i)
+    reduced[i] = timers[order[i]];
 
   /* Register MPI datatype for sunTimerStruct */
   MPI_Datatype tmp_type, MPI_sunTimerStruct;
-  const int block_lens[2] = { 5, 1 };
-  const MPI_Datatype types[2] = { MPI_DOUBLE, MPI_LONG };
-  const MPI_Aint displ[2] = { offsetof(sunTimerStruct, tic),
-                              offsetof(sunTimerStruct, count) };
+  const int block_lens[3] = { 3, 1, SUN_PROFILER_NCOUNTERS };
+  const MPI_Datatype types[3] = { MPI_DOUBLE, MPI_LONG, MPI_LONG_LONG };
+  const MPI_Aint displ[3] = { offsetof(sunTimerStruct, average),
+                              offsetof(sunTimerStruct, count),
+                              offsetof(sunTimerStruct, counters) };
   MPI_Aint lb, extent;
 
-  MPI_Type_create_struct(2, block_lens, displ, types, &tmp_type);
+  MPI_Type_create_struct(3, block_lens, displ, types, &tmp_type);
   MPI_Type_get_extent(tmp_type, &lb, &extent);
   extent = sizeof(sunTimerStruct);
   MPI_Type_create_resized(tmp_type, lb, extent, &MPI_sunTimerStruct);
@@ -449,12 +1634,12 @@ int sunCollectTimers(SUNProfiler p)
   /* Compute max and average time across all ranks */
   if (rank == 0)
   {
-    MPI_Reduce(MPI_IN_PLACE, reduced, p->map->size, MPI_sunTimerStruct,
+    MPI_Reduce(MPI_IN_PLACE, reduced, ntimers, MPI_sunTimerStruct,
                MPI_sunTimerStruct_MAXANDSUM, 0, comm);
   }
   else
   {
-    MPI_Reduce(reduced, reduced, p->map->size, MPI_sunTimerStruct,
+    MPI_Reduce(reduced, reduced, ntimers, MPI_sunTimerStruct,
                MPI_sunTimerStruct_MAXANDSUM, 0, comm);
   }
 
@@ -463,51 +1648,29 @@ int sunCollectTimers(SUNProfiler p)
   MPI_Type_free(&MPI_sunTimerStruct);
   MPI_Op_free(&MPI_sunTimerStruct_MAXANDSUM);
 
-  /* Update the values that are in this rank's hash map. */
-  for (i = 0; i < p->map->size; ++i) {
-    values[i]->average = reduced[i].average / (realtype) nranks;
-    values[i]->maximum = reduced[i].maximum;
+  /* The counters available on any rank */
+  MPI_Allreduce(MPI_IN_PLACE, mask, 1, MPI_INT, MPI_BOR, comm);
+
+  /* Update the values of this rank's timers */
+  for (i = 0; i < ntimers; ++i) {
+    timers[order[i]].average = reduced[i].average / (realtype) nranks;
+    timers[order[i]].maximum = reduced[i].maximum;
+    memcpy(timers[order[i]].counters, reduced[i].counters,
+           sizeof(reduced[i].counters));
   }
 
   free(reduced);
-  free(values);
 
   return(0);
 }
 #endif
 
-/* Print out the: timer name, percentage of exec time (based on the max),
-   max across ranks, average across ranks, and the timer counter. */
-void sunPrintTimers(int idx, SUNHashMapKeyValue kv, FILE* fp, void* pvoid)
-{
-  SUNProfiler p = (SUNProfiler) pvoid;
-  sunTimerStruct* ts = (sunTimerStruct*) kv->value;
-  double maximum = ts->maximum;
-  double average = ts->average;
-  double percent = strcmp((const char*) kv->key, (const char*) SUNDIALS_ROOT_TIMER) ? maximum / p->sundials_time * 100 : 100;
-  fprintf(fp, "%-40s\t %6.2f%% \t         %.6fs \t %.6fs \t %ld\n",
-          kv->key, percent, maximum, average, ts->count);
-}
-
-/* Comparator for qsort that compares key-value pairs
-   based on the maximum time in the sunTimerStruct. */
+/* Comparator for qsort that compares timer ids based on the maximum time in
+   the sunTimerStruct. */
 int sunCompareTimes(const void* l, const void* r)
 {
-  double left_max;
-  double right_max;
-
-  const SUNHashMapKeyValue left = *((SUNHashMapKeyValue*) l);
-  const SUNHashMapKeyValue right = *((SUNHashMapKeyValue*) r);
-
-  if (left == NULL && right == NULL)
-    return(0);
-  if (left == NULL)
-    return(1);
-  if (right == NULL)
-    return(-1);
-
-  left_max = ((sunTimerStruct*) left->value)->maximum;
-  right_max = ((sunTimerStruct*) right->value)->maximum;
+  double left_max  = sun_sort_timers[*((const int*) l)].maximum;
+  double right_max = sun_sort_timers[*((const int*) r)].maximum;
 
   if (left_max < right_max)
     return(1);
@@ -515,3 +1678,10 @@ int sunCompareTimes(const void* l, const void* r)
     return(-1);
   return(0);
 }
+
+/* Comparator for qsort that compares timer ids based on the timer name. */
+int sunCompareNames(const void* l, const void* r)
+{
+  return strcmp(sun_sort_names[*((const int*) l)],
+                sun_sort_names[*((const int*) r)]);
+}
@@ -0,0 +1,32 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Private functions of the SUNDIALS profiler.
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_PROFILER_IMPL_H
+#define _SUNDIALS_PROFILER_IMPL_H
+
+#include <sundials/sundials_profiler.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Write the trace and call tree exports requested with the SUNPROFILER_TRACE
+   and SUNPROFILER_CSV environment variables */
+int sunProfilerExportFromEnv(SUNProfiler p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
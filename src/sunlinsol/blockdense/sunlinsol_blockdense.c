@@ -0,0 +1,444 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the batched block-diagonal
+ * dense implementation of the SUNLINSOL package.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sunlinsol/sunlinsol_blockdense.h>
+#include <sundials/sundials_math.h>
+
+#include "sunlinsol_blockdense_impl.h"
+
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+
+/* shorthand for the number of interleaved blocks */
+#define NP SUNBLOCKDENSE_PACK
+
+/* Private function prototypes */
+static sunindextype packGETRF(realtype *a, sunindextype *piv, sunindextype M,
+                              sunindextype kfirst, sunindextype nlanes);
+static void packGETRS(realtype *a, sunindextype *piv, sunindextype M,
+                      sunindextype nlanes, realtype *w);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new block-diagonal dense linear solver
+ */
+
+SUNLinearSolver SUNLinSol_BlockDense(N_Vector y, SUNMatrix A, SUNContext sunctx)
+{
+  SUNLinearSolver S;
+  SUNLinearSolverContent_BlockDense content;
+  sunindextype M, nblocks, npacks;
+
+  /* Check compatibility with supplied SUNMatrix and N_Vector */
+  if (SUNMatGetID(A) != SUNMATRIX_BLOCKDENSE) return(NULL);
+
+  if (SUNBlockDenseMatrix_BlockRows(A) != SUNBlockDenseMatrix_BlockColumns(A))
+    return(NULL);
+
+  if ( (N_VGetVectorID(y) != SUNDIALS_NVEC_SERIAL) &&
+       (N_VGetVectorID(y) != SUNDIALS_NVEC_OPENMP) &&
+       (N_VGetVectorID(y) != SUNDIALS_NVEC_PTHREADS) )
+    return(NULL);
+
+  if (SUNBlockDenseMatrix_Rows(A) != N_VGetLength(y)) return(NULL);
+
+  M       = SUNBlockDenseMatrix_BlockRows(A);
+  nblocks = SUNBlockDenseMatrix_NumBlocks(A);
+  npacks  = (nblocks + NP - 1) / NP;
+
+  /* Create an empty linear solver */
+  S = NULL;
+  S = SUNLinSolNewEmpty(sunctx);
+  if (S == NULL) return(NULL);
+
+  /* Attach operations */
+  S->ops->gettype    = SUNLinSolGetType_BlockDense;
+  S->ops->getid      = SUNLinSolGetID_BlockDense;
+  S->ops->initialize = SUNLinSolInitialize_BlockDense;
+  S->ops->setup      = SUNLinSolSetup_BlockDense;
+  S->ops->solve      = SUNLinSolSolve_BlockDense;
+  S->ops->lastflag   = SUNLinSolLastFlag_BlockDense;
+  S->ops->space      = SUNLinSolSpace_BlockDense;
+  S->ops->free       = SUNLinSolFree_BlockDense;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNLinearSolverContent_BlockDense) malloc(sizeof *content);
+  if (content == NULL) { SUNLinSolFree(S); return(NULL); }
+
+  /* Attach content */
+  S->content = content;
+
+  /* Fill content */
+  content->M         = M;
+  content->nblocks   = nblocks;
+  content->npacks    = npacks;
+  content->last_flag = 0;
+  content->num_threads = 1;
+  content->pivots    = NULL;
+  content->work      = NULL;
+
+  /* Allocate content */
+  content->pivots = (sunindextype *) malloc(npacks * NP * M * sizeof(sunindextype));
+  if (content->pivots == NULL) { SUNLinSolFree(S); return(NULL); }
+
+  content->work = (realtype *) malloc(npacks * NP * M * sizeof(realtype));
+  if (content->work == NULL) { SUNLinSolFree(S); return(NULL); }
+
+  return(S);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of linear solver operations
+ * -----------------------------------------------------------------
+ */
+
+SUNLinearSolver_Type SUNLinSolGetType_BlockDense(SUNLinearSolver S)
+{
+  return(SUNLINEARSOLVER_DIRECT);
+}
+
+SUNLinearSolver_ID SUNLinSolGetID_BlockDense(SUNLinearSolver S)
+{
+  return(SUNLINEARSOLVER_BLOCKDENSE);
+}
+
+int SUNLinSolInitialize_BlockDense(SUNLinearSolver S)
+{
+  /* all solver-specific memory has already been allocated */
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSolSetup_BlockDense(SUNLinearSolver S, SUNMatrix A)
+{
+  sunindextype fail;
+  int retval;
+
+  retval = BlockDenseSetupPrepare(S, A);
+  if (retval != SUNLS_SUCCESS) return(retval);
+
+  /* perform LU factorization of each group of blocks */
+  fail = BlockDenseFactorPacks(S, A, 0, BLOCKDENSE_CONTENT(S)->npacks);
+
+  /* store error flag (if nonzero, this row encountered zero-valued pivot) */
+  LASTFLAG(S) = fail;
+  if (LASTFLAG(S) > 0)
+    return(SUNLS_LUFACT_FAIL);
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSolSolve_BlockDense(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                              N_Vector b, realtype tol)
+{
+  realtype *xdata;
+  int retval;
+
+  retval = BlockDenseSolvePrepare(S, A, x, b, &xdata);
+  if (retval != SUNLS_SUCCESS) return(retval);
+
+  /* solve using LU factors */
+  BlockDenseSolvePacks(S, A, xdata, 0, BLOCKDENSE_CONTENT(S)->npacks);
+
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(SUNLS_SUCCESS);
+}
+
+sunindextype SUNLinSolLastFlag_BlockDense(SUNLinearSolver S)
+{
+  /* return the stored 'last_flag' value */
+  if (S == NULL) return(-1);
+  return(LASTFLAG(S));
+}
+
+int SUNLinSolSpace_BlockDense(SUNLinearSolver S,
+                              long int *lenrwLS,
+                              long int *leniwLS)
+{
+  sunindextype n = BLOCKDENSE_CONTENT(S)->npacks * NP * BLOCKDENSE_CONTENT(S)->M;
+  *leniwLS = 4 + n;
+  *lenrwLS = n;
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSolFree_BlockDense(SUNLinearSolver S)
+{
+  /* return if S is already free */
+  if (S == NULL) return(SUNLS_SUCCESS);
+
+  /* delete items from contents, then delete generic structure */
+  if (S->content) {
+    if (PIVOTS(S)) {
+      free(PIVOTS(S));
+      PIVOTS(S) = NULL;
+    }
+    if (WORK(S)) {
+      free(WORK(S));
+      WORK(S) = NULL;
+    }
+    free(S->content);
+    S->content = NULL;
+  }
+  if (S->ops) {
+    free(S->ops);
+    S->ops = NULL;
+  }
+  free(S); S = NULL;
+  return(SUNLS_SUCCESS);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Setup and solve steps shared with the threaded setup and solve of
+ * sunlinsol_blockdense_threads.c
+ */
+
+int BlockDenseSetupPrepare(SUNLinearSolver S, SUNMatrix A)
+{
+  /* check for valid inputs */
+  if ( (A == NULL) || (S == NULL) )
+    return(SUNLS_MEM_NULL);
+
+  /* Ensure that A is a compatible block-diagonal dense matrix */
+  if ( (SUNMatGetID(A) != SUNMATRIX_BLOCKDENSE) ||
+       (SUNBlockDenseMatrix_NumBlocks(A) != BLOCKDENSE_CONTENT(S)->nblocks) ||
+       (SUNBlockDenseMatrix_BlockRows(A) != BLOCKDENSE_CONTENT(S)->M) ||
+       (SUNBlockDenseMatrix_BlockColumns(A) != BLOCKDENSE_CONTENT(S)->M) ) {
+    LASTFLAG(S) = SUNLS_ILL_INPUT;
+    return(SUNLS_ILL_INPUT);
+  }
+
+  /* check data pointers (return with failure on NULL) */
+  if ( (SUNBlockDenseMatrix_Data(A) == NULL) || (PIVOTS(S) == NULL) ) {
+    LASTFLAG(S) = SUNLS_MEM_FAIL;
+    return(SUNLS_MEM_FAIL);
+  }
+
+  return(SUNLS_SUCCESS);
+}
+
+sunindextype BlockDenseFactorPacks(SUNLinearSolver S, SUNMatrix A,
+                                   sunindextype start, sunindextype end)
+{
+  realtype *Adata;
+  sunindextype *pivots;
+  sunindextype M, nblocks, p, fail, flag;
+
+  Adata   = SUNBlockDenseMatrix_Data(A);
+  pivots  = PIVOTS(S);
+  M       = BLOCKDENSE_CONTENT(S)->M;
+  nblocks = BLOCKDENSE_CONTENT(S)->nblocks;
+
+  /* fail holds the smallest global column index (plus one) with a zero
+     pivot, the groups are in increasing order so the first failure is kept */
+  fail = 0;
+  for (p = start; p < end; p++) {
+    flag = packGETRF(Adata + p * NP * M * M, pivots + p * NP * M, M, p * NP,
+                     SUNMIN(NP, nblocks - p * NP));
+    if ((flag > 0) && (fail == 0)) fail = flag;
+  }
+
+  return(fail);
+}
+
+int BlockDenseSolvePrepare(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                           N_Vector b, realtype **xdata)
+{
+  if ( (A == NULL) || (S == NULL) || (x == NULL) || (b == NULL) )
+    return(SUNLS_MEM_NULL);
+
+  /* copy b into x */
+  N_VScale(ONE, b, x);
+
+  /* access data pointers (return with failure on NULL) */
+  *xdata = N_VGetArrayPointer(x);
+  if ( (SUNBlockDenseMatrix_Data(A) == NULL) || (*xdata == NULL) ||
+       (PIVOTS(S) == NULL) || (WORK(S) == NULL) ) {
+    LASTFLAG(S) = SUNLS_MEM_FAIL;
+    return(SUNLS_MEM_FAIL);
+  }
+
+  return(SUNLS_SUCCESS);
+}
+
+void BlockDenseSolvePacks(SUNLinearSolver S, SUNMatrix A, realtype *xdata,
+                          sunindextype start, sunindextype end)
+{
+  realtype *Adata, *w, *xk;
+  sunindextype *pivots;
+  sunindextype M, nblocks, p, i, l, nlanes;
+
+  Adata   = SUNBlockDenseMatrix_Data(A);
+  pivots  = PIVOTS(S);
+  M       = BLOCKDENSE_CONTENT(S)->M;
+  nblocks = BLOCKDENSE_CONTENT(S)->nblocks;
+
+  /* the right-hand sides of each group of blocks are interleaved in the
+     work array to match the matrix layout */
+  for (p = start; p < end; p++) {
+    nlanes = SUNMIN(NP, nblocks - p * NP);
+    w      = WORK(S) + p * NP * M;
+
+    for (l = 0; l < nlanes; l++) {
+      xk = xdata + (p * NP + l) * M;
+      for (i = 0; i < M; i++)
+        w[i * NP + l] = xk[i];
+    }
+
+    packGETRS(Adata + p * NP * M * M, pivots + p * NP * M, M, nlanes, w);
+
+    for (l = 0; l < nlanes; l++) {
+      xk = xdata + (p * NP + l) * M;
+      for (i = 0; i < M; i++)
+        xk[i] = w[i * NP + l];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------------
+ * LU factorization with partial pivoting of the NP interleaved M by M blocks
+ * in a, where entry (i,j) of block l is a[(j*M + i)*NP + l]. The elimination
+ * steps are those of SUNDlsMat_denseGETRF applied to all blocks at once, so
+ * every innermost loop runs over the blocks. Only the first nlanes blocks
+ * are used, the remaining ones pad the last group. A zero pivot does not stop
+ * the factorization of the other blocks; the function returns 0 on success or
+ * the smallest (kfirst + l)*M + k + 1 over the blocks l with a zero pivot in
+ * column k, i.e., the global column index (plus one) of the first failure.
+ */
+
+static sunindextype packGETRF(realtype *a, sunindextype *piv, sunindextype M,
+                              sunindextype kfirst, sunindextype nlanes)
+{
+  sunindextype i, j, k, l, r, fail;
+  realtype *col_j, *col_k;
+  realtype amax[NP], mult[NP];
+  realtype temp, aik;
+
+  fail = 0;
+
+  /* k-th elimination step number */
+  for (k = 0; k < M; k++) {
+
+    col_k = a + k * M * NP;
+
+    /* find the pivot row of every block */
+    for (l = 0; l < NP; l++) {
+      piv[k * NP + l] = k;
+      amax[l] = SUNRabs(col_k[k * NP + l]);
+    }
+    for (i = k + 1; i < M; i++) {
+      for (l = 0; l < NP; l++) {
+        aik = SUNRabs(col_k[i * NP + l]);
+        if (aik > amax[l]) {
+          amax[l] = aik;
+          piv[k * NP + l] = i;
+        }
+      }
+    }
+
+    /* check for zero pivot elements */
+    for (l = 0; l < nlanes; l++)
+      if ((amax[l] == ZERO) && ((fail == 0) || (fail > (kfirst + l) * M + k + 1)))
+        fail = (kfirst + l) * M + k + 1;
+
+    /* swap rows k and piv[k] of every block if necessary */
+    for (l = 0; l < NP; l++) {
+      r = piv[k * NP + l];
+      if (r != k) {
+        for (j = 0; j < M; j++) {
+          temp = a[(j * M + r) * NP + l];
+          a[(j * M + r) * NP + l] = a[(j * M + k) * NP + l];
+          a[(j * M + k) * NP + l] = temp;
+        }
+      }
+    }
+
+    /* scale the elements below the diagonal by 1/a(k,k), the multiplier
+       of a block with a zero pivot is set to zero */
+    for (l = 0; l < NP; l++)
+      mult[l] = (col_k[k * NP + l] != ZERO) ? ONE / col_k[k * NP + l] : ZERO;
+    for (i = k + 1; i < M; i++)
+      for (l = 0; l < NP; l++)
+        col_k[i * NP + l] *= mult[l];
+
+    /* a(i,j) = a(i,j) - [a(i,k)/a(k,k)]*a(k,j), i,j = k+1, ..., M-1 */
+    for (j = k + 1; j < M; j++) {
+      col_j = a + j * M * NP;
+      for (i = k + 1; i < M; i++)
+        for (l = 0; l < NP; l++)
+          col_j[i * NP + l] -= col_j[k * NP + l] * col_k[i * NP + l];
+    }
+  }
+
+  return(fail);
+}
+
+/* ----------------------------------------------------------------------------
+ * Solve with the LU factors of the interleaved blocks in a (see packGETRF)
+ * for the first nlanes interleaved right-hand sides in w, where entry i of
+ * right-hand side l is w[i*NP + l].
+ */
+
+static void packGETRS(realtype *a, sunindextype *piv, sunindextype M,
+                      sunindextype nlanes, realtype *w)
+{
+  sunindextype i, k, l, r;
+  realtype *col_k;
+  realtype temp;
+
+  /* permute the right-hand sides */
+  for (k = 0; k < M; k++) {
+    for (l = 0; l < nlanes; l++) {
+      r = piv[k * NP + l];
+      if (r != k) {
+        temp = w[r * NP + l];
+        w[r * NP + l] = w[k * NP + l];
+        w[k * NP + l] = temp;
+      }
+    }
+  }
+
+  /* solve Ly = b, store solution y in w */
+  for (k = 0; k < M - 1; k++) {
+    col_k = a + k * M * NP;
+    for (i = k + 1; i < M; i++)
+      for (l = 0; l < nlanes; l++)
+        w[i * NP + l] -= col_k[i * NP + l] * w[k * NP + l];
+  }
+
+  /* solve Ux = y, store solution x in w */
+  for (k = M - 1; k >= 0; k--) {
+    col_k = a + k * M * NP;
+    for (l = 0; l < nlanes; l++)
+      w[k * NP + l] /= col_k[k * NP + l];
+    for (i = 0; i < k; i++)
+      for (l = 0; l < nlanes; l++)
+        w[i * NP + l] -= col_k[i * NP + l] * w[k * NP + l];
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Private functions of the block-diagonal dense SUNLINSOL used by
+ * the threaded setup and solve in sunlinsol_blockdense_threads.c.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNLINSOL_BLOCKDENSE_IMPL_H
+#define _SUNLINSOL_BLOCKDENSE_IMPL_H
+
+#include <sunlinsol/sunlinsol_blockdense.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------
+ * Block-diagonal dense solver structure accessibility macros:
+ * -----------------------------------------------------------------
+ */
+
+#define BLOCKDENSE_CONTENT(S) ( (SUNLinearSolverContent_BlockDense)(S->content) )
+#define PIVOTS(S)             ( BLOCKDENSE_CONTENT(S)->pivots )
+#define WORK(S)               ( BLOCKDENSE_CONTENT(S)->work )
+#define LASTFLAG(S)           ( BLOCKDENSE_CONTENT(S)->last_flag )
+
+/* Checks the inputs of SUNLinSolSetup */
+int BlockDenseSetupPrepare(SUNLinearSolver S, SUNMatrix A);
+
+/* Factors the groups of blocks start to end-1 and returns the smallest
+   global column (plus one) with a zero pivot, or 0 */
+sunindextype BlockDenseFactorPacks(SUNLinearSolver S, SUNMatrix A,
+                                   sunindextype start, sunindextype end);
+
+/* Checks the inputs of SUNLinSolSolve and copies b into x */
+int BlockDenseSolvePrepare(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                           N_Vector b, realtype **xdata);
+
+/* Solves the systems of the groups of blocks start to end-1 in place */
+void BlockDenseSolvePacks(SUNLinearSolver S, SUNMatrix A, realtype *xdata,
+                          sunindextype start, sunindextype end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the OpenMP threaded setup and
+ * solve of the block-diagonal dense SUNLinearSolver. It is only part
+ * of the SUNLINSOL_BLOCKDENSE library, the packages that include the
+ * solver (e.g., for the CVODE batched integrator) do not depend on
+ * OpenMP.
+ * -----------------------------------------------------------------
+ */
+
+#include <sunlinsol/sunlinsol_blockdense.h>
+
+#include "sunlinsol_blockdense_impl.h"
+
+#if defined(_OPENMP)
+
+/* -----------------------------------------------------------------
+ * Number of threads used by S, at most one per group of blocks
+ */
+static int numThreads(SUNLinearSolver S)
+{
+  int nt = BLOCKDENSE_CONTENT(S)->num_threads;
+  if (nt > BLOCKDENSE_CONTENT(S)->npacks)
+    nt = (int) BLOCKDENSE_CONTENT(S)->npacks;
+  return(nt);
+}
+
+/* -----------------------------------------------------------------
+ * Factors the groups of blocks divided evenly among the threads of
+ * the solver
+ */
+static int SUNLinSolSetup_BlockDenseThreads(SUNLinearSolver S, SUNMatrix A)
+{
+  int retval, t, nt;
+  sunindextype np, nofail, fail, flag;
+
+  retval = BlockDenseSetupPrepare(S, A);
+  if (retval != SUNLS_SUCCESS) return(retval);
+
+  np = BLOCKDENSE_CONTENT(S)->npacks;
+  nt = numThreads(S);
+
+  /* fail holds the smallest global column index (plus one) with a zero
+     pivot over all threads */
+  nofail = BLOCKDENSE_CONTENT(S)->nblocks * BLOCKDENSE_CONTENT(S)->M + 1;
+  fail   = nofail;
+
+#pragma omp parallel for private(flag) num_threads(nt) reduction(min:fail) \
+  schedule(static)
+  for (t=0; t<nt; t++) {
+    flag = BlockDenseFactorPacks(S, A, (np * t) / nt, (np * (t + 1)) / nt);
+    if ((flag > 0) && (flag < fail)) fail = flag;
+  }
+
+  LASTFLAG(S) = (fail == nofail) ? 0 : fail;
+  if (LASTFLAG(S) > 0)
+    return(SUNLS_LUFACT_FAIL);
+  return(SUNLS_SUCCESS);
+}
+
+/* -----------------------------------------------------------------
+ * Solves the systems of the groups of blocks divided evenly among
+ * the threads of the solver
+ */
+static int SUNLinSolSolve_BlockDenseThreads(SUNLinearSolver S, SUNMatrix A,
+                                            N_Vector x, N_Vector b,
+                                            realtype tol)
+{
+  int retval, t, nt;
+  sunindextype np;
+  realtype *xdata;
+
+  retval = BlockDenseSolvePrepare(S, A, x, b, &xdata);
+  if (retval != SUNLS_SUCCESS) return(retval);
+
+  np = BLOCKDENSE_CONTENT(S)->npacks;
+  nt = numThreads(S);
+
+#pragma omp parallel for num_threads(nt) schedule(static)
+  for (t=0; t<nt; t++)
+    BlockDenseSolvePacks(S, A, xdata, (np * t) / nt, (np * (t + 1)) / nt);
+
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(SUNLS_SUCCESS);
+}
+
+#endif
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of OpenMP threads used by the setup and solve.
+ * Without OpenMP the solver always runs on the calling thread.
+ */
+
+int SUNLinSol_BlockDenseSetNumThreads(SUNLinearSolver S, int num_threads)
+{
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  if (num_threads < 1) return(SUNLS_ILL_INPUT);
+
+  BLOCKDENSE_CONTENT(S)->num_threads = num_threads;
+
+#if defined(_OPENMP)
+  S->ops->setup = (num_threads > 1) ? SUNLinSolSetup_BlockDenseThreads
+                                    : SUNLinSolSetup_BlockDense;
+  S->ops->solve = (num_threads > 1) ? SUNLinSolSolve_BlockDenseThreads
+                                    : SUNLinSolSolve_BlockDense;
+#endif
+
+  return(SUNLS_SUCCESS);
+}
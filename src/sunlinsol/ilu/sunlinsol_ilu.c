@@ -0,0 +1,719 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the incomplete LU
+ * implementation of the SUNLINSOL package.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sunlinsol/sunlinsol_ilu.h>
+#include <sundials/sundials_math.h>
+
+#include "sunlinsol_ilu_impl.h"
+
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+
+/* Private function prototypes */
+static int ILUSymbolic(SUNLinearSolver S, SUNMatrix A);
+static int ILULevels(sunindextype n, sunindextype *LUp, sunindextype *LUj,
+                     sunindextype *diag, booleantype lower,
+                     sunindextype *lev, sunindextype *ord,
+                     sunindextype *nlev);
+static booleantype ILUPatternMatches(SUNLinearSolver S, SUNMatrix A);
+static void ILUFreeFactors(SUNLinearSolver S);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new incomplete LU linear solver
+ */
+
+SUNLinearSolver SUNLinSol_ILU(N_Vector y, SUNMatrix A, int fill_level,
+                              SUNContext sunctx)
+{
+  SUNLinearSolver S;
+  SUNLinearSolverContent_ILU content;
+
+  /* Check compatibility with supplied SUNMatrix and N_Vector */
+  if (SUNMatGetID(A) != SUNMATRIX_SPARSE) return(NULL);
+
+  if (SUNSparseMatrix_Rows(A) != SUNSparseMatrix_Columns(A)) return(NULL);
+
+  if ( (N_VGetVectorID(y) != SUNDIALS_NVEC_SERIAL) &&
+       (N_VGetVectorID(y) != SUNDIALS_NVEC_OPENMP) &&
+       (N_VGetVectorID(y) != SUNDIALS_NVEC_PTHREADS) )
+    return(NULL);
+
+  if (SUNSparseMatrix_Rows(A) != N_VGetLength(y)) return(NULL);
+
+  if (fill_level < 0) return(NULL);
+
+  /* Create an empty linear solver */
+  S = NULL;
+  S = SUNLinSolNewEmpty(sunctx);
+  if (S == NULL) return(NULL);
+
+  /* Attach operations */
+  S->ops->gettype    = SUNLinSolGetType_ILU;
+  S->ops->getid      = SUNLinSolGetID_ILU;
+  S->ops->initialize = SUNLinSolInitialize_ILU;
+  S->ops->setup      = SUNLinSolSetup_ILU;
+  S->ops->solve      = SUNLinSolSolve_ILU;
+  S->ops->lastflag   = SUNLinSolLastFlag_ILU;
+  S->ops->space      = SUNLinSolSpace_ILU;
+  S->ops->free       = SUNLinSolFree_ILU;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNLinearSolverContent_ILU) malloc(sizeof *content);
+  if (content == NULL) { SUNLinSolFree(S); return(NULL); }
+
+  /* Attach content */
+  S->content = content;
+
+  /* Fill content, the factors are allocated in the first setup call */
+  content->N               = SUNSparseMatrix_Rows(A);
+  content->fill_level      = fill_level;
+  content->first_factorize = 1;
+  content->nnzA            = 0;
+  content->Ap              = NULL;
+  content->Ai              = NULL;
+  content->amap            = NULL;
+  content->LUp             = NULL;
+  content->LUj             = NULL;
+  content->LUx             = NULL;
+  content->diag            = NULL;
+  content->dinv            = NULL;
+  content->nlevL           = 0;
+  content->levL            = NULL;
+  content->ordL            = NULL;
+  content->nlevU           = 0;
+  content->levU            = NULL;
+  content->ordU            = NULL;
+  content->work            = NULL;
+  content->num_threads     = 1;
+  content->last_flag       = 0;
+
+  return(S);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to set the maximum level of the fill entries, the next setup call
+ * computes a new symbolic factorization
+ */
+
+int SUNLinSol_ILUSetFillLevel(SUNLinearSolver S, int fill_level)
+{
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  if (fill_level < 0) return(SUNLS_ILL_INPUT);
+
+  if (fill_level != ILU_CONTENT(S)->fill_level) {
+    ILU_CONTENT(S)->fill_level = fill_level;
+    FIRSTFACTORIZE(S) = 1;
+  }
+  return(SUNLS_SUCCESS);
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to access the size of the factors and the number of levels
+ */
+
+int SUNLinSol_ILUGetNumNonzeros(SUNLinearSolver S, sunindextype *nnz)
+{
+  if ((S == NULL) || (nnz == NULL)) return(SUNLS_MEM_NULL);
+  *nnz = (ILU_CONTENT(S)->LUp) ? ILU_CONTENT(S)->LUp[ILU_CONTENT(S)->N] : 0;
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSol_ILUGetNumLevels(SUNLinearSolver S, sunindextype *nlevL,
+                              sunindextype *nlevU)
+{
+  if ((S == NULL) || (nlevL == NULL) || (nlevU == NULL))
+    return(SUNLS_MEM_NULL);
+  *nlevL = ILU_CONTENT(S)->nlevL;
+  *nlevU = ILU_CONTENT(S)->nlevU;
+  return(SUNLS_SUCCESS);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of linear solver operations
+ * -----------------------------------------------------------------
+ */
+
+SUNLinearSolver_Type SUNLinSolGetType_ILU(SUNLinearSolver S)
+{
+  return(SUNLINEARSOLVER_DIRECT);
+}
+
+SUNLinearSolver_ID SUNLinSolGetID_ILU(SUNLinearSolver S)
+{
+  return(SUNLINEARSOLVER_ILU);
+}
+
+int SUNLinSolInitialize_ILU(SUNLinearSolver S)
+{
+  /* force a new symbolic factorization at the next setup call */
+  FIRSTFACTORIZE(S) = 1;
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSolSetup_ILU(SUNLinearSolver S, SUNMatrix A)
+{
+  int retval;
+  sunindextype fail;
+
+  retval = ILUSetupFactors(S, A);
+  if (retval != SUNLS_SUCCESS) return(retval);
+
+  /* the rows sorted by level only depend on earlier rows, fail holds the row
+     (plus one) of a zero pivot */
+  fail = ILUFactorRows(S, 0, ILU_CONTENT(S)->N, ILU_CONTENT(S)->work);
+  if (fail > ILU_CONTENT(S)->N) fail = 0;
+
+  LASTFLAG(S) = fail;
+  if (fail > 0)
+    return(SUNLS_LUFACT_FAIL);
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSolSolve_ILU(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                       N_Vector b, realtype tol)
+{
+  int retval;
+  realtype *xdata;
+
+  retval = ILUSolvePrepare(S, A, x, b, &xdata);
+  if (retval != SUNLS_SUCCESS) return(retval);
+
+  /* solve L y = b and then U x = y in place */
+  ILUSolveRows(S, xdata, SUNTRUE, 0, ILU_CONTENT(S)->N);
+  ILUSolveRows(S, xdata, SUNFALSE, 0, ILU_CONTENT(S)->N);
+
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(SUNLS_SUCCESS);
+}
+
+sunindextype SUNLinSolLastFlag_ILU(SUNLinearSolver S)
+{
+  /* return the stored 'last_flag' value */
+  if (S == NULL) return(-1);
+  return(LASTFLAG(S));
+}
+
+int SUNLinSolSpace_ILU(SUNLinearSolver S,
+                       long int *lenrwLS,
+                       long int *leniwLS)
+{
+  sunindextype n, nnz;
+
+  n   = ILU_CONTENT(S)->N;
+  nnz = (ILU_CONTENT(S)->LUp) ? ILU_CONTENT(S)->LUp[n] : 0;
+
+  *lenrwLS = (long int) (nnz + n);
+  *leniwLS = (long int) (10 + 7 * n + nnz + 2 * ILU_CONTENT(S)->nnzA +
+                         ILU_CONTENT(S)->num_threads * n);
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSolFree_ILU(SUNLinearSolver S)
+{
+  /* return if S is already free */
+  if (S == NULL) return(SUNLS_SUCCESS);
+
+  /* delete items from contents, then delete generic structure */
+  if (S->content) {
+    ILUFreeFactors(S);
+    free(S->content);
+    S->content = NULL;
+  }
+  if (S->ops) {
+    free(S->ops);
+    S->ops = NULL;
+  }
+  free(S); S = NULL;
+  return(SUNLS_SUCCESS);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Symbolic ILU(k) factorization. The pattern of each row of the factors is
+ * kept in a sorted linked list. Starting from the pattern of the row of A and
+ * the diagonal (level 0), the rows k < i of the list are visited in order and
+ * every entry (k,j) of U adds the fill entry (i,j) with level
+ * lev(i,k) + lev(k,j) + 1 if it does not exceed the fill level. The map from
+ * the entries of A to the factors and the levels of the triangular solves are
+ * computed as well, and a copy of the pattern of A is kept to detect changes.
+ */
+
+static int ILUSymbolic(SUNLinearSolver S, SUNMatrix A)
+{
+  SUNLinearSolverContent_ILU content = ILU_CONTENT(S);
+  sunindextype n, nnzA, cap, nnz, i, j, k, p, q, prev, lik, lev, head;
+  sunindextype *Ap, *Ai, *Rp, *Rj, *Rpos, *next, *rlev, *flev, *tmp;
+  int fill;
+
+  n    = content->N;
+  fill = content->fill_level;
+  Ap   = SUNSparseMatrix_IndexPointers(A);
+  Ai   = SUNSparseMatrix_IndexValues(A);
+  nnzA = Ap[n];
+
+  ILUFreeFactors(S);
+
+  /* keep a copy of the pattern of A */
+  content->nnzA = nnzA;
+  content->Ap   = (sunindextype*) malloc((n + 1) * sizeof(sunindextype));
+  content->Ai   = (sunindextype*) malloc(SUNMAX(nnzA, 1) * sizeof(sunindextype));
+  content->amap = (sunindextype*) malloc(SUNMAX(nnzA, 1) * sizeof(sunindextype));
+  content->LUp  = (sunindextype*) malloc((n + 1) * sizeof(sunindextype));
+  content->diag = (sunindextype*) malloc(SUNMAX(n, 1) * sizeof(sunindextype));
+  content->dinv = (realtype*) malloc(SUNMAX(n, 1) * sizeof(realtype));
+  content->levL = (sunindextype*) malloc((n + 1) * sizeof(sunindextype));
+  content->ordL = (sunindextype*) malloc(SUNMAX(n, 1) * sizeof(sunindextype));
+  content->levU = (sunindextype*) malloc((n + 1) * sizeof(sunindextype));
+  content->ordU = (sunindextype*) malloc(SUNMAX(n, 1) * sizeof(sunindextype));
+  if ((content->Ap == NULL) || (content->Ai == NULL) ||
+      (content->amap == NULL) || (content->LUp == NULL) ||
+      (content->diag == NULL) || (content->dinv == NULL) ||
+      (content->levL == NULL) || (content->ordL == NULL) ||
+      (content->levU == NULL) || (content->ordU == NULL)) {
+    ILUFreeFactors(S);
+    return(SUNLS_MEM_FAIL);
+  }
+  memcpy(content->Ap, Ap, (n + 1) * sizeof(sunindextype));
+  memcpy(content->Ai, Ai, nnzA * sizeof(sunindextype));
+
+  /* row access to the pattern of A, Rpos holds the position of each entry in
+     the arrays of A */
+  Rp   = (sunindextype*) calloc(n + 1, sizeof(sunindextype));
+  Rj   = (sunindextype*) malloc(SUNMAX(nnzA, 1) * sizeof(sunindextype));
+  Rpos = (sunindextype*) malloc(SUNMAX(nnzA, 1) * sizeof(sunindextype));
+  next = (sunindextype*) malloc((n + 1) * sizeof(sunindextype));
+  rlev = (sunindextype*) malloc(SUNMAX(n, 1) * sizeof(sunindextype));
+  if ((Rp == NULL) || (Rj == NULL) || (Rpos == NULL) || (next == NULL) ||
+      (rlev == NULL)) {
+    free(Rp); free(Rj); free(Rpos); free(next); free(rlev);
+    ILUFreeFactors(S);
+    return(SUNLS_MEM_FAIL);
+  }
+
+  if (SUNSparseMatrix_SparseType(A) == CSR_MAT) {
+    for (i = 0; i <= n; i++) Rp[i] = Ap[i];
+    for (p = 0; p < nnzA; p++) {
+      Rj[p]   = Ai[p];
+      Rpos[p] = p;
+    }
+  } else {
+    for (p = 0; p < nnzA; p++) Rp[Ai[p] + 1]++;
+    for (i = 0; i < n; i++) Rp[i + 1] += Rp[i];
+    for (i = 0; i < n; i++) next[i] = Rp[i];
+    for (j = 0; j < n; j++) {
+      for (p = Ap[j]; p < Ap[j + 1]; p++) {
+        q       = next[Ai[p]]++;
+        Rj[q]   = j;
+        Rpos[q] = p;
+      }
+    }
+  }
+
+  /* pattern of the factors, the arrays grow as fill entries are added */
+  cap  = nnzA + n;
+  content->LUj = (sunindextype*) malloc(cap * sizeof(sunindextype));
+  flev = (sunindextype*) malloc(cap * sizeof(sunindextype));
+  if ((content->LUj == NULL) || (flev == NULL)) {
+    free(Rp); free(Rj); free(Rpos); free(next); free(rlev); free(flev);
+    ILUFreeFactors(S);
+    return(SUNLS_MEM_FAIL);
+  }
+
+  head = n;
+  for (i = 0; i < n; i++) rlev[i] = -1;
+
+  nnz = 0;
+  for (i = 0; i < n; i++) {
+
+    /* row i starts where row i-1 ends, this also closes row i-1 for the
+       fill loop below */
+    content->LUp[i] = nnz;
+
+    /* sorted list with the diagonal and the row of A at level 0 */
+    next[head] = i;
+    next[i]    = n;
+    rlev[i]    = 0;
+    for (q = Rp[i]; q < Rp[i + 1]; q++) {
+      j = Rj[q];
+      if (rlev[j] >= 0) continue;
+      prev = head;
+      while (next[prev] < j) prev = next[prev];
+      next[j]    = next[prev];
+      next[prev] = j;
+      rlev[j]    = 0;
+    }
+
+    /* add the fill entries from the U rows of the previous rows */
+    for (k = next[head]; k < i; k = next[k]) {
+      lik = rlev[k];
+      if (lik >= fill) continue;
+      prev = k;
+      for (q = content->diag[k] + 1; q < content->LUp[k + 1]; q++) {
+        j   = content->LUj[q];
+        lev = lik + flev[q] + 1;
+        if (lev > fill) continue;
+        if (rlev[j] < 0) {
+          while (next[prev] < j) prev = next[prev];
+          next[j]    = next[prev];
+          next[prev] = j;
+          rlev[j]    = lev;
+        } else if (lev < rlev[j]) {
+          rlev[j] = lev;
+        }
+      }
+    }
+
+    /* store the row */
+    for (j = next[head]; j < n; j = next[j]) {
+      if (nnz == cap) {
+        cap *= 2;
+        tmp = (sunindextype*) realloc(content->LUj, cap * sizeof(sunindextype));
+        if (tmp == NULL) break;
+        content->LUj = tmp;
+        tmp = (sunindextype*) realloc(flev, cap * sizeof(sunindextype));
+        if (tmp == NULL) break;
+        flev = tmp;
+      }
+      if (j == i) content->diag[i] = nnz;
+      content->LUj[nnz] = j;
+      flev[nnz]         = rlev[j];
+      rlev[j]           = -1;
+      nnz++;
+    }
+    if (j < n) {
+      free(Rp); free(Rj); free(Rpos); free(next); free(rlev); free(flev);
+      ILUFreeFactors(S);
+      return(SUNLS_MEM_FAIL);
+    }
+  }
+  content->LUp[n] = nnz;
+  free(flev);
+
+  content->LUx = (realtype*) malloc(SUNMAX(nnz, 1) * sizeof(realtype));
+  if (content->LUx == NULL) {
+    free(Rp); free(Rj); free(Rpos); free(next); free(rlev);
+    ILUFreeFactors(S);
+    return(SUNLS_MEM_FAIL);
+  }
+
+  /* map the entries of A to the factors */
+  for (i = 0; i < n; i++) {
+    for (p = content->LUp[i]; p < content->LUp[i + 1]; p++)
+      rlev[content->LUj[p]] = p;
+    for (q = Rp[i]; q < Rp[i + 1]; q++)
+      content->amap[Rpos[q]] = rlev[Rj[q]];
+  }
+
+  free(Rp); free(Rj); free(Rpos);
+
+  /* levels of the lower and upper triangular solves */
+  if (ILULevels(n, content->LUp, content->LUj, content->diag, SUNTRUE,
+                content->levL, content->ordL, &content->nlevL) ||
+      ILULevels(n, content->LUp, content->LUj, content->diag, SUNFALSE,
+                content->levU, content->ordU, &content->nlevU)) {
+    free(next); free(rlev);
+    ILUFreeFactors(S);
+    return(SUNLS_MEM_FAIL);
+  }
+  free(next); free(rlev);
+
+  /* row markers, one set per thread */
+  content->work = (sunindextype*) malloc(SUNMAX(content->num_threads * n, 1) *
+                                         sizeof(sunindextype));
+  if (content->work == NULL) {
+    ILUFreeFactors(S);
+    return(SUNLS_MEM_FAIL);
+  }
+  for (p = 0; p < content->num_threads * n; p++) content->work[p] = -1;
+
+  return(SUNLS_SUCCESS);
+}
+
+/* ----------------------------------------------------------------------------
+ * Checks the inputs of SUNLinSolSetup, computes the pattern of the factors and
+ * the levels if this is the first factorization or the pattern of A changed,
+ * and loads A into the pattern of the factors
+ */
+
+int ILUSetupFactors(SUNLinearSolver S, SUNMatrix A)
+{
+  SUNLinearSolverContent_ILU content;
+  sunindextype p, nnzA, *amap;
+  realtype *LUx, *Ax;
+  int retval;
+
+  /* check for valid inputs */
+  if ( (A == NULL) || (S == NULL) )
+    return(SUNLS_MEM_NULL);
+
+  /* Ensure that A is a compatible sparse matrix */
+  if ( (SUNMatGetID(A) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(A) != ILU_CONTENT(S)->N) ||
+       (SUNSparseMatrix_Columns(A) != ILU_CONTENT(S)->N) ) {
+    LASTFLAG(S) = SUNLS_ILL_INPUT;
+    return(SUNLS_ILL_INPUT);
+  }
+
+  if (FIRSTFACTORIZE(S) || !ILUPatternMatches(S, A)) {
+    retval = ILUSymbolic(S, A);
+    if (retval != SUNLS_SUCCESS) {
+      LASTFLAG(S) = retval;
+      return(retval);
+    }
+    FIRSTFACTORIZE(S) = 0;
+  }
+
+  content = ILU_CONTENT(S);
+  nnzA    = content->nnzA;
+  amap    = content->amap;
+  LUx     = content->LUx;
+  Ax      = SUNSparseMatrix_Data(A);
+
+  for (p = 0; p < content->LUp[content->N]; p++) LUx[p] = ZERO;
+  for (p = 0; p < nnzA; p++) LUx[amap[p]] += Ax[p];
+
+  return(SUNLS_SUCCESS);
+}
+
+/* ----------------------------------------------------------------------------
+ * Numeric factorization of the rows ordL[start] to ordL[end-1] in the pattern
+ * of the factors (IKJ variant). Row i only uses rows k with an entry (i,k) in
+ * L, so the rows of one level of the lower triangular solve may be factored
+ * concurrently with separate row markers iw. Returns the smallest row index
+ * (plus one) with a zero pivot, or N+1 if there is none.
+ */
+
+sunindextype ILUFactorRows(SUNLinearSolver S, sunindextype start,
+                           sunindextype end, sunindextype *iw)
+{
+  SUNLinearSolverContent_ILU content = ILU_CONTENT(S);
+  sunindextype r, i, k, p, q, pos, fail;
+  sunindextype *LUp, *LUj, *diag, *ord;
+  realtype *LUx, *dinv, lik;
+
+  LUp  = content->LUp;
+  LUj  = content->LUj;
+  LUx  = content->LUx;
+  diag = content->diag;
+  dinv = content->dinv;
+  ord  = content->ordL;
+
+  fail = content->N + 1;
+
+  for (r = start; r < end; r++) {
+    i = ord[r];
+
+    for (p = LUp[i]; p < LUp[i + 1]; p++) iw[LUj[p]] = p;
+
+    /* eliminate with the previous rows in increasing column order */
+    for (p = LUp[i]; p < diag[i]; p++) {
+      k      = LUj[p];
+      LUx[p] *= dinv[k];
+      lik    = LUx[p];
+      for (q = diag[k] + 1; q < LUp[k + 1]; q++) {
+        pos = iw[LUj[q]];
+        if (pos >= 0) LUx[pos] -= lik * LUx[q];
+      }
+    }
+
+    for (p = LUp[i]; p < LUp[i + 1]; p++) iw[LUj[p]] = -1;
+
+    if (LUx[diag[i]] == ZERO) {
+      /* keep the later rows finite, the factorization is reported as
+         failed */
+      dinv[i] = ONE;
+      if (i + 1 < fail) fail = i + 1;
+    } else {
+      dinv[i] = ONE / LUx[diag[i]];
+    }
+  }
+
+  return(fail);
+}
+
+/* ----------------------------------------------------------------------------
+ * Checks the inputs of SUNLinSolSolve, copies b into x and returns the data
+ * of x
+ */
+
+int ILUSolvePrepare(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
+                    realtype **xdata)
+{
+  if ( (A == NULL) || (S == NULL) || (x == NULL) || (b == NULL) )
+    return(SUNLS_MEM_NULL);
+
+  /* copy b into x */
+  N_VScale(ONE, b, x);
+
+  /* access data pointers (return with failure on NULL) */
+  *xdata = N_VGetArrayPointer(x);
+  if ( (*xdata == NULL) || (ILU_CONTENT(S)->LUp == NULL) ||
+       (ILU_CONTENT(S)->LUx == NULL) ) {
+    LASTFLAG(S) = SUNLS_MEM_FAIL;
+    return(SUNLS_MEM_FAIL);
+  }
+
+  return(SUNLS_SUCCESS);
+}
+
+/* ----------------------------------------------------------------------------
+ * Solves the rows ord[start] to ord[end-1] of L y = x (lower == SUNTRUE) or
+ * U y = x in place, where ord holds the rows sorted by level. The rows of one
+ * level may be solved concurrently.
+ */
+
+void ILUSolveRows(SUNLinearSolver S, realtype *xdata, booleantype lower,
+                  sunindextype start, sunindextype end)
+{
+  realtype *LUx, *dinv, sum;
+  sunindextype *LUp, *LUj, *diag, *ord;
+  sunindextype r, i, p;
+
+  LUp  = ILU_CONTENT(S)->LUp;
+  LUj  = ILU_CONTENT(S)->LUj;
+  LUx  = ILU_CONTENT(S)->LUx;
+  diag = ILU_CONTENT(S)->diag;
+  dinv = ILU_CONTENT(S)->dinv;
+
+  if (lower) {
+    ord = ILU_CONTENT(S)->ordL;
+    for (r = start; r < end; r++) {
+      i   = ord[r];
+      sum = xdata[i];
+      for (p = LUp[i]; p < diag[i]; p++)
+        sum -= LUx[p] * xdata[LUj[p]];
+      xdata[i] = sum;
+    }
+  } else {
+    ord = ILU_CONTENT(S)->ordU;
+    for (r = start; r < end; r++) {
+      i   = ord[r];
+      sum = xdata[i];
+      for (p = diag[i] + 1; p < LUp[i + 1]; p++)
+        sum -= LUx[p] * xdata[LUj[p]];
+      xdata[i] = sum * dinv[i];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------------
+ * Levels of a triangular solve. For the lower factor (lower == SUNTRUE) the
+ * level of row i is one more than the largest level of the rows k < i with
+ * an entry (i,k), for the upper factor of the rows j > i with an entry (i,j).
+ * The rows are sorted by level into ord, lev[l] is the first row of level l.
+ */
+
+static int ILULevels(sunindextype n, sunindextype *LUp, sunindextype *LUj,
+                     sunindextype *diag, booleantype lower,
+                     sunindextype *lev, sunindextype *ord,
+                     sunindextype *nlev)
+{
+  sunindextype i, l, p, r, nl;
+  sunindextype *rowlev;
+
+  rowlev = (sunindextype*) malloc(SUNMAX(n, 1) * sizeof(sunindextype));
+  if (rowlev == NULL) return(1);
+
+  nl = 0;
+  for (r = 0; r < n; r++) {
+    i = lower ? r : n - 1 - r;
+    l = 0;
+    if (lower) {
+      for (p = LUp[i]; p < diag[i]; p++)
+        l = SUNMAX(l, rowlev[LUj[p]] + 1);
+    } else {
+      for (p = diag[i] + 1; p < LUp[i + 1]; p++)
+        l = SUNMAX(l, rowlev[LUj[p]] + 1);
+    }
+    rowlev[i] = l;
+    nl = SUNMAX(nl, l + 1);
+  }
+
+  /* counting sort of the rows by level */
+  for (l = 0; l <= nl; l++) lev[l] = 0;
+  for (i = 0; i < n; i++) lev[rowlev[i] + 1]++;
+  for (l = 0; l < nl; l++) lev[l + 1] += lev[l];
+  for (i = 0; i < n; i++) ord[lev[rowlev[i]]++] = i;
+  for (l = nl; l > 0; l--) lev[l] = lev[l - 1];
+  lev[0] = 0;
+
+  *nlev = nl;
+  free(rowlev);
+  return(0);
+}
+
+/* ----------------------------------------------------------------------------
+ * Check if the pattern of A is the one of the last symbolic factorization
+ */
+
+static booleantype ILUPatternMatches(SUNLinearSolver S, SUNMatrix A)
+{
+  SUNLinearSolverContent_ILU content = ILU_CONTENT(S);
+  sunindextype n = content->N;
+  sunindextype *Ap = SUNSparseMatrix_IndexPointers(A);
+
+  if ((content->Ap == NULL) || (Ap[n] != content->nnzA))
+    return(SUNFALSE);
+  if (memcmp(content->Ap, Ap, (n + 1) * sizeof(sunindextype)) != 0)
+    return(SUNFALSE);
+  if (memcmp(content->Ai, SUNSparseMatrix_IndexValues(A),
+             content->nnzA * sizeof(sunindextype)) != 0)
+    return(SUNFALSE);
+  return(SUNTRUE);
+}
+
+/* ----------------------------------------------------------------------------
+ * Free the factors and the level data
+ */
+
+static void ILUFreeFactors(SUNLinearSolver S)
+{
+  SUNLinearSolverContent_ILU content = ILU_CONTENT(S);
+
+  free(content->Ap);   content->Ap   = NULL;
+  free(content->Ai);   content->Ai   = NULL;
+  free(content->amap); content->amap = NULL;
+  free(content->LUp);  content->LUp  = NULL;
+  free(content->LUj);  content->LUj  = NULL;
+  free(content->LUx);  content->LUx  = NULL;
+  free(content->diag); content->diag = NULL;
+  free(content->dinv); content->dinv = NULL;
+  free(content->levL); content->levL = NULL;
+  free(content->ordL); content->ordL = NULL;
+  free(content->levU); content->levU = NULL;
+  free(content->ordU); content->ordU = NULL;
+  free(content->work); content->work = NULL;
+  content->nnzA     = 0;
+  content->nlevL    = 0;
+  content->nlevU    = 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Private functions of the incomplete LU SUNLinearSolver used by the
+ * threaded setup and solve in sunlinsol_ilu_threads.c.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNLINSOL_ILU_IMPL_H
+#define _SUNLINSOL_ILU_IMPL_H
+
+#include <sunlinsol/sunlinsol_ilu.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------
+ * ILU solver structure accessibility macros:
+ * -----------------------------------------------------------------
+ */
+
+#define ILU_CONTENT(S)     ( (SUNLinearSolverContent_ILU)(S->content) )
+#define FIRSTFACTORIZE(S)  ( ILU_CONTENT(S)->first_factorize )
+#define LASTFLAG(S)        ( ILU_CONTENT(S)->last_flag )
+
+/* Checks the inputs of SUNLinSolSetup, updates the symbolic factorization
+   and loads A into the pattern of the factors */
+int ILUSetupFactors(SUNLinearSolver S, SUNMatrix A);
+
+/* Factors the rows ordL[start] to ordL[end-1] with the row markers iw and
+   returns the smallest row (plus one) with a zero pivot, or N+1 */
+sunindextype ILUFactorRows(SUNLinearSolver S, sunindextype start,
+                           sunindextype end, sunindextype *iw);
+
+/* Checks the inputs of SUNLinSolSolve and copies b into x */
+int ILUSolvePrepare(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
+                    realtype **xdata);
+
+/* Solves the rows ord[start] to ord[end-1] of the L or U solve in place */
+void ILUSolveRows(SUNLinearSolver S, realtype *xdata, booleantype lower,
+                  sunindextype start, sunindextype end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
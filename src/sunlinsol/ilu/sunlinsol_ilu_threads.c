@@ -0,0 +1,137 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the OpenMP threaded setup and
+ * solve of the incomplete LU SUNLinearSolver. It is only part of the
+ * SUNLINSOL_ILU library, the packages that include the ILU solver
+ * (e.g., for the ILU preconditioner modules) do not depend on OpenMP.
+ * -----------------------------------------------------------------
+ */
+
+#include <sunlinsol/sunlinsol_ilu.h>
+
+#include "sunlinsol_ilu_impl.h"
+
+#if defined(_OPENMP)
+#include <omp.h>
+
+/* -----------------------------------------------------------------
+ * Factors the rows of each level of L with the rows divided evenly
+ * among the threads of the solver, the threads wait for each other
+ * at the end of a level
+ */
+static int SUNLinSolSetup_ILUThreads(SUNLinearSolver S, SUNMatrix A)
+{
+  int retval, nt;
+  sunindextype n, fail, *lev;
+
+  retval = ILUSetupFactors(S, A);
+  if (retval != SUNLS_SUCCESS) return(retval);
+
+  n    = ILU_CONTENT(S)->N;
+  lev  = ILU_CONTENT(S)->levL;
+  nt   = ILU_CONTENT(S)->num_threads;
+  fail = n + 1;
+
+#pragma omp parallel num_threads(nt) reduction(min:fail)
+  {
+    sunindextype l, cnt, f, *iw;
+    int t  = omp_get_thread_num();
+    int nth = omp_get_num_threads();
+
+    iw = ILU_CONTENT(S)->work + t * n;
+    for (l = 0; l < ILU_CONTENT(S)->nlevL; l++) {
+      cnt = lev[l + 1] - lev[l];
+      f = ILUFactorRows(S, lev[l] + (cnt * t) / nth,
+                        lev[l] + (cnt * (t + 1)) / nth, iw);
+      if (f < fail) fail = f;
+#pragma omp barrier
+    }
+  }
+
+  if (fail > n) fail = 0;
+
+  LASTFLAG(S) = fail;
+  if (fail > 0)
+    return(SUNLS_LUFACT_FAIL);
+  return(SUNLS_SUCCESS);
+}
+
+/* -----------------------------------------------------------------
+ * Solves L y = b and then U x = y with the rows of each level
+ * divided evenly among the threads of the solver
+ */
+static int SUNLinSolSolve_ILUThreads(SUNLinearSolver S, SUNMatrix A,
+                                     N_Vector x, N_Vector b, realtype tol)
+{
+  int retval, nt;
+  realtype *xdata;
+
+  retval = ILUSolvePrepare(S, A, x, b, &xdata);
+  if (retval != SUNLS_SUCCESS) return(retval);
+
+  nt = ILU_CONTENT(S)->num_threads;
+
+#pragma omp parallel num_threads(nt)
+  {
+    sunindextype l, cnt, *lev;
+    int t   = omp_get_thread_num();
+    int nth = omp_get_num_threads();
+
+    lev = ILU_CONTENT(S)->levL;
+    for (l = 0; l < ILU_CONTENT(S)->nlevL; l++) {
+      cnt = lev[l + 1] - lev[l];
+      ILUSolveRows(S, xdata, SUNTRUE, lev[l] + (cnt * t) / nth,
+                   lev[l] + (cnt * (t + 1)) / nth);
+#pragma omp barrier
+    }
+
+    lev = ILU_CONTENT(S)->levU;
+    for (l = 0; l < ILU_CONTENT(S)->nlevU; l++) {
+      cnt = lev[l + 1] - lev[l];
+      ILUSolveRows(S, xdata, SUNFALSE, lev[l] + (cnt * t) / nth,
+                   lev[l] + (cnt * (t + 1)) / nth);
+#pragma omp barrier
+    }
+  }
+
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(SUNLS_SUCCESS);
+}
+
+#endif
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of OpenMP threads used by the setup and solve,
+ * the next setup call computes a new symbolic factorization. Without OpenMP
+ * the solver always runs on the calling thread.
+ */
+
+int SUNLinSol_ILUSetNumThreads(SUNLinearSolver S, int num_threads)
+{
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  if (num_threads < 1) return(SUNLS_ILL_INPUT);
+
+  if (num_threads != ILU_CONTENT(S)->num_threads) {
+    ILU_CONTENT(S)->num_threads = num_threads;
+    FIRSTFACTORIZE(S) = 1;
+  }
+
+#if defined(_OPENMP)
+  S->ops->setup = (num_threads > 1) ? SUNLinSolSetup_ILUThreads
+                                    : SUNLinSolSetup_ILU;
+  S->ops->solve = (num_threads > 1) ? SUNLinSolSolve_ILUThreads
+                                    : SUNLinSolSolve_ILU;
+#endif
+
+  return(SUNLS_SUCCESS);
+}
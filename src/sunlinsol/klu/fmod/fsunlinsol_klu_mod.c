@@ -277,6 +277,20 @@ SWIGEXPORT int _wrap_FSUNLinSol_KLUSetOrdering(SUNLinearSolver farg1, int const
 }
 
 
+SWIGEXPORT int _wrap_FSUNLinSol_KLUShareSymbolic(SUNLinearSolver farg1, SUNLinearSolver farg2) {
+  int fresult ;
+  SUNLinearSolver arg1 = (SUNLinearSolver) 0 ;
+  SUNLinearSolver arg2 = (SUNLinearSolver) 0 ;
+  int result;
+  
+  arg1 = (SUNLinearSolver)(farg1);
+  arg2 = (SUNLinearSolver)(farg2);
+  result = (int)SUNLinSol_KLUShareSymbolic(arg1,arg2);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
 SWIGEXPORT SwigClassWrapper _wrap_FSUNLinSol_KLUGetSymbolic(SUNLinearSolver farg1) {
   SwigClassWrapper fresult ;
   SUNLinearSolver arg1 = (SUNLinearSolver) 0 ;
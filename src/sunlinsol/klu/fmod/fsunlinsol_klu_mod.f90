@@ -40,6 +40,7 @@ module fsunlinsol_klu_mod
  public :: FSUNLinSol_KLU
  public :: FSUNLinSol_KLUReInit
  public :: FSUNLinSol_KLUSetOrdering
+ public :: FSUNLinSol_KLUShareSymbolic
 
  integer, parameter :: swig_cmem_own_bit = 0
  integer, parameter :: swig_cmem_rvalue_bit = 1
@@ -101,6 +102,15 @@ integer(C_INT), intent(in) :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FSUNLinSol_KLUShareSymbolic(farg1, farg2) &
+bind(C, name="_wrap_FSUNLinSol_KLUShareSymbolic") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FSUNLinSol_KLUGetSymbolic(farg1) &
 bind(C, name="_wrap_FSUNLinSol_KLUGetSymbolic") &
 result(fresult)
@@ -261,6 +271,22 @@ fresult = swigc_FSUNLinSol_KLUSetOrdering(farg1, farg2)
 swig_result = fresult
 end function
 
+function FSUNLinSol_KLUShareSymbolic(s, s_src) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(SUNLinearSolver), target, intent(inout) :: s
+type(SUNLinearSolver), target, intent(inout) :: s_src
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = c_loc(s)
+farg2 = c_loc(s_src)
+fresult = swigc_FSUNLinSol_KLUShareSymbolic(farg1, farg2)
+swig_result = fresult
+end function
+
 function FSUNLinSol_KLUGetSymbolic(s) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
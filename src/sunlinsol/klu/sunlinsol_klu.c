@@ -18,8 +18,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <sunlinsol/sunlinsol_klu.h>
+#include <sunmatrix/sunmatrix_bsr.h>
 #include <sundials/sundials_math.h>
 
 #define ZERO      RCONST(0.0)
@@ -40,6 +42,8 @@
 #define NUMERIC(S)         ( KLU_CONTENT(S)->numeric )
 #define COMMON(S)          ( KLU_CONTENT(S)->common )
 #define SOLVE(S)           ( KLU_CONTENT(S)->klu_solver )
+#define SHARED(S)          ( KLU_CONTENT(S)->shared )
+#define BSRCOPY(S)         ( KLU_CONTENT(S)->bsr_copy )
 
 /*
  * -----------------------------------------------------------------
@@ -53,6 +57,22 @@
 #define KLU_INDEXTYPE int
 #endif
 
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static SUNKLUSharedSymbolic KLUSharedSymbolicNew(void);
+static void KLUSharedSymbolicRelease(SUNLinearSolver S);
+static unsigned long KLUPatternHash(SUNMatrix A);
+static booleantype KLUPatternMatches(SUNKLUSharedSymbolic shared, SUNMatrix A,
+                                     unsigned long hash);
+static int KLUPatternSave(SUNKLUSharedSymbolic shared, SUNMatrix A,
+                          unsigned long hash);
+static int KLUFactor(SUNLinearSolver S, SUNMatrix A);
+static SUNMatrix KLUSparseMatrix(SUNLinearSolver S, SUNMatrix A);
+
 /*
  * -----------------------------------------------------------------
  * exported functions
@@ -67,19 +87,31 @@ SUNLinearSolver SUNLinSol_KLU(N_Vector y, SUNMatrix A, SUNContext sunctx)
 {
   SUNLinearSolver S;
   SUNLinearSolverContent_KLU content;
-  int flag;
-
-  /* Check compatibility with supplied SUNMatrix and N_Vector */
-  if (SUNMatGetID(A) != SUNMATRIX_SPARSE) return(NULL);
+  sunindextype M, N;
+  int sparsetype, flag;
+
+  /* Check compatibility with supplied SUNMatrix and N_Vector, a BSR matrix
+     is factored through a CSC copy of its blocks */
+  if (SUNMatGetID(A) == SUNMATRIX_SPARSE) {
+    M          = SUNSparseMatrix_Rows(A);
+    N          = SUNSparseMatrix_Columns(A);
+    sparsetype = SUNSparseMatrix_SparseType(A);
+  } else if (SUNMatGetID(A) == SUNMATRIX_BSR) {
+    M          = SUNBSRMatrix_Rows(A);
+    N          = SUNBSRMatrix_Columns(A);
+    sparsetype = CSC_MAT;
+  } else {
+    return(NULL);
+  }
 
-  if (SUNSparseMatrix_Rows(A) != SUNSparseMatrix_Columns(A)) return(NULL);
+  if (M != N) return(NULL);
 
   if ( (N_VGetVectorID(y) != SUNDIALS_NVEC_SERIAL) &&
        (N_VGetVectorID(y) != SUNDIALS_NVEC_OPENMP) &&
        (N_VGetVectorID(y) != SUNDIALS_NVEC_PTHREADS) )
     return(NULL);
 
-  if (SUNSparseMatrix_Rows(A) != N_VGetLength(y)) return(NULL);
+  if (M != N_VGetLength(y)) return(NULL);
 
   /* Create an empty linear solver */
   S = NULL;
@@ -109,15 +141,17 @@ SUNLinearSolver SUNLinSol_KLU(N_Vector y, SUNMatrix A, SUNContext sunctx)
   content->first_factorize = 1;
   content->symbolic        = NULL;
   content->numeric         = NULL;
+  content->shared          = NULL;
+  content->bsr_copy        = NULL;
 
 #if defined(SUNDIALS_INT64_T)
-  if (SUNSparseMatrix_SparseType(A) == CSC_MAT) {
+  if (sparsetype == CSC_MAT) {
     content->klu_solver = (KLUSolveFn) &klu_l_solve;
   } else {
     content->klu_solver = (KLUSolveFn) &klu_l_tsolve;
   }
 #elif defined(SUNDIALS_INT32_T)
-  if (SUNSparseMatrix_SparseType(A) == CSC_MAT) {
+  if (sparsetype == CSC_MAT) {
     content->klu_solver = &klu_solve;
   } else {
     content->klu_solver = &klu_tsolve;
@@ -130,6 +164,10 @@ SUNLinearSolver SUNLinSol_KLU(N_Vector y, SUNMatrix A, SUNContext sunctx)
   if (flag == 0) { SUNLinSolFree(S); return(NULL); }
   (content->common).ordering = SUNKLU_ORDERING_DEFAULT;
 
+  /* Create an (unshared) symbolic factorization holder */
+  content->shared = KLUSharedSymbolicNew();
+  if (content->shared == NULL) { SUNLinSolFree(S); return(NULL); }
+
   return(S);
 }
 
@@ -146,7 +184,7 @@ int SUNLinSol_KLUReInit(SUNLinearSolver S, SUNMatrix A,
     return(SUNLS_MEM_NULL);
 
   /* Check for valid SUNMatrix */
-  if (SUNMatGetID(A) != SUNMATRIX_SPARSE)
+  if ((SUNMatGetID(A) != SUNMATRIX_SPARSE) && (SUNMatGetID(A) != SUNMATRIX_BSR))
     return(SUNLS_ILL_INPUT);
 
   /* Check for valid reinit_type */
@@ -154,14 +192,15 @@ int SUNLinSol_KLUReInit(SUNLinearSolver S, SUNMatrix A,
       (reinit_type != SUNKLU_REINIT_PARTIAL))
     return(SUNLS_ILL_INPUT);
 
-  /* Full re-initialization: reallocate matrix for updated storage */
-  if (reinit_type == SUNKLU_REINIT_FULL)
+  /* Full re-initialization: reallocate matrix for updated storage, the CSC
+     copy of a BSR matrix is resized in the next setup call */
+  if ((reinit_type == SUNKLU_REINIT_FULL) && (SUNMatGetID(A) == SUNMATRIX_SPARSE))
     if (SUNSparseMatrix_Reallocate(A, nnz) != 0)
       return(SUNLS_MEM_FAIL);
 
-  /* Free the prior factorazation and reset for first factorization */
-  if( SYMBOLIC(S) != NULL)
-    sun_klu_free_symbolic(&SYMBOLIC(S), &COMMON(S));
+  /* Free the prior numeric factorization and reset for first factorization.
+     The symbolic analysis is kept and reused in the next setup call if the
+     sparsity pattern of A is unchanged. */
   if( NUMERIC(S) != NULL)
     sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
   FIRSTFACTORIZE(S) = 1;
@@ -191,6 +230,47 @@ int SUNLinSol_KLUSetOrdering(SUNLinearSolver S, int ordering_choice)
 }
 
 
+/* ----------------------------------------------------------------------------
+ * Function to share the symbolic factorization of S_src with S. The symbolic
+ * analysis is reference counted and is performed (or reused) by whichever
+ * solver is set up first. A solver whose sparsity pattern differs from the
+ * shared analysis detaches and performs its own analysis.
+ */
+
+int SUNLinSol_KLUShareSymbolic(SUNLinearSolver S, SUNLinearSolver S_src)
+{
+  /* Check for non-NULL SUNLinearSolvers */
+  if ((S == NULL) || (S_src == NULL))
+    return(SUNLS_MEM_NULL);
+
+  /* Check for KLU linear solvers */
+  if ((SUNLinSolGetID(S) != SUNLINEARSOLVER_KLU) ||
+      (SUNLinSolGetID(S_src) != SUNLINEARSOLVER_KLU))
+    return(SUNLS_ILL_INPUT);
+
+  /* Nothing to do if the symbolic factorization is already shared */
+  if (SHARED(S) == SHARED(S_src)) {
+    LASTFLAG(S) = SUNLS_SUCCESS;
+    return(LASTFLAG(S));
+  }
+
+  /* Release the current symbolic factorization and attach the shared one.
+     The numeric factorization depends on the symbolic one, so force a new
+     factorization in the next setup call. */
+  if (NUMERIC(S) != NULL)
+    sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
+  KLUSharedSymbolicRelease(S);
+
+  SHARED(S) = SHARED(S_src);
+  SHARED(S)->refcount++;
+  SYMBOLIC(S) = SHARED(S)->symbolic;
+  FIRSTFACTORIZE(S) = 1;
+
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(LASTFLAG(S));
+}
+
+
 /*
  * -----------------------------------------------------------------
  * accessor functions
@@ -244,42 +324,79 @@ int SUNLinSolInitialize_KLU(SUNLinearSolver S)
 int SUNLinSolSetup_KLU(SUNLinearSolver S, SUNMatrix A)
 {
   int retval;
+  unsigned long hash;
+  booleantype refactor_full;
   realtype uround_twothirds;
+  SUNKLUSharedSymbolic shared;
 
   uround_twothirds = SUNRpowerR(UNIT_ROUNDOFF,TWOTHIRDS);
 
-  /* Ensure that A is a sparse matrix */
-  if (SUNMatGetID(A) != SUNMATRIX_SPARSE) {
+  /* Ensure that A is a sparse matrix, a BSR matrix is copied to CSC */
+  if (SUNMatGetID(A) == SUNMATRIX_BSR) {
+    A = KLUSparseMatrix(S, A);
+    if (A == NULL) {
+      LASTFLAG(S) = SUNLS_MEM_FAIL;
+      return(LASTFLAG(S));
+    }
+  } else if (SUNMatGetID(A) != SUNMATRIX_SPARSE) {
     LASTFLAG(S) = SUNLS_ILL_INPUT;
     return(LASTFLAG(S));
   }
 
+  /* If SUNMatScaleAdd or SUNMatScaleAddI reports a new sparsity pattern,
+     check the symbolic factorization and compute a new numeric one */
+  if (SUNSparseMatrix_PatternChanged(A))
+    FIRSTFACTORIZE(S) = 1;
+
   /* On first decomposition, get the symbolic factorization */
   if (FIRSTFACTORIZE(S)) {
 
-    /* Perform symbolic analysis of sparsity structure */
-    if (SYMBOLIC(S))
-      sun_klu_free_symbolic(&SYMBOLIC(S), &COMMON(S));
-    SYMBOLIC(S) = sun_klu_analyze(SUNSparseMatrix_NP(A),
-                                  (KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
-                                  (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
-                                  &COMMON(S));
-    if (SYMBOLIC(S) == NULL) {
-      LASTFLAG(S) = SUNLS_PACKAGE_FAIL_UNREC;
-      return(LASTFLAG(S));
+    /* Reuse an existing (possibly shared) symbolic analysis if it was
+       computed for the same sparsity pattern and ordering */
+    hash   = KLUPatternHash(A);
+    shared = SHARED(S);
+
+    if ( (shared->symbolic == NULL) ||
+         (shared->ordering != COMMON(S).ordering) ||
+         !KLUPatternMatches(shared, A, hash) ) {
+
+      /* Do not modify an analysis used by other solvers, detach instead */
+      if ((shared->refcount > 1) && (shared->symbolic != NULL)) {
+        KLUSharedSymbolicRelease(S);
+        SHARED(S) = KLUSharedSymbolicNew();
+        if (SHARED(S) == NULL) {
+          LASTFLAG(S) = SUNLS_MEM_FAIL;
+          return(LASTFLAG(S));
+        }
+        shared = SHARED(S);
+      }
+
+      /* Perform symbolic analysis of sparsity structure */
+      if (shared->symbolic)
+        sun_klu_free_symbolic(&(shared->symbolic), &COMMON(S));
+      shared->symbolic = sun_klu_analyze(SUNSparseMatrix_NP(A),
+                                         (KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
+                                         (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
+                                         &COMMON(S));
+      SYMBOLIC(S) = shared->symbolic;
+      if (shared->symbolic == NULL) {
+        LASTFLAG(S) = SUNLS_PACKAGE_FAIL_UNREC;
+        return(LASTFLAG(S));
+      }
+      if (KLUPatternSave(shared, A, hash)) {
+        sun_klu_free_symbolic(&(shared->symbolic), &COMMON(S));
+        SYMBOLIC(S) = NULL;
+        LASTFLAG(S) = SUNLS_MEM_FAIL;
+        return(LASTFLAG(S));
+      }
+      shared->ordering = COMMON(S).ordering;
     }
+    SYMBOLIC(S) = shared->symbolic;
 
     /* ------------------------------------------------------------
        Compute the LU factorization of the matrix
        ------------------------------------------------------------*/
-    if(NUMERIC(S))
-      sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
-    NUMERIC(S) = sun_klu_factor((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
-                                (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
-                                SUNSparseMatrix_Data(A),
-                                SYMBOLIC(S),
-                                &COMMON(S));
-    if (NUMERIC(S) == NULL) {
+    if (KLUFactor(S, A)) {
       LASTFLAG(S) = SUNLS_PACKAGE_FAIL_UNREC;
       return(LASTFLAG(S));
     }
@@ -288,6 +405,8 @@ int SUNLinSolSetup_KLU(SUNLinearSolver S, SUNMatrix A)
 
   } else {   /* not the first decomposition, so just refactor */
 
+    refactor_full = SUNFALSE;
+
     retval = sun_klu_refactor((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
                               (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
                               SUNSparseMatrix_Data(A),
@@ -295,52 +414,74 @@ int SUNLinSolSetup_KLU(SUNLinearSolver S, SUNMatrix A)
                               NUMERIC(S),
                               &COMMON(S));
     if (retval == 0) {
-      LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
-      return(LASTFLAG(S));
-    }
 
-    /*-----------------------------------------------------------
-      Check if a cheap estimate of the reciprocal of the condition
-      number is getting too small.  If so, delete
-      the prior numeric factorization and recompute it.
-      -----------------------------------------------------------*/
+      /* The refactorization with the prior pivot sequence failed (e.g., a
+         zero pivot), so try a full numeric factorization with pivoting */
+      refactor_full = SUNTRUE;
 
-    retval = sun_klu_rcond(SYMBOLIC(S), NUMERIC(S), &COMMON(S));
-    if (retval == 0) {
-      LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
-      return(LASTFLAG(S));
-    }
+    } else {
 
-    if ( COMMON(S).rcond < uround_twothirds ) {
+      /*-----------------------------------------------------------
+        Check if a cheap estimate of the reciprocal of the condition
+        number is getting too small or if the pivot growth of the
+        prior pivot sequence is too large. If so, delete the prior
+        numeric factorization and recompute it.
+        -----------------------------------------------------------*/
 
-      /* Condition number may be getting large.
-	 Compute more accurate estimate */
-      retval = sun_klu_condest((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
-                               SUNSparseMatrix_Data(A),
-                               SYMBOLIC(S),
-                               NUMERIC(S),
-                               &COMMON(S));
+      retval = sun_klu_rcond(SYMBOLIC(S), NUMERIC(S), &COMMON(S));
       if (retval == 0) {
-	LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
+        LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
         return(LASTFLAG(S));
       }
 
-      if ( COMMON(S).condest > (ONE/uround_twothirds) ) {
-
-	/* More accurate estimate also says condition number is
-	   large, so recompute the numeric factorization */
-	sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
-	NUMERIC(S) = sun_klu_factor((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
-                                    (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
-                                    SUNSparseMatrix_Data(A),
-                                    SYMBOLIC(S),
-                                    &COMMON(S));
-	if (NUMERIC(S) == NULL) {
-	  LASTFLAG(S) = SUNLS_PACKAGE_FAIL_UNREC;
+      if ( COMMON(S).rcond < uround_twothirds ) {
+
+        /* Condition number may be getting large.
+           Compute more accurate estimate */
+        retval = sun_klu_condest((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
+                                 SUNSparseMatrix_Data(A),
+                                 SYMBOLIC(S),
+                                 NUMERIC(S),
+                                 &COMMON(S));
+        if (retval == 0) {
+          LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
           return(LASTFLAG(S));
-	}
+        }
+
+        /* More accurate estimate also says condition number is large */
+        if ( COMMON(S).condest > (ONE/uround_twothirds) )
+          refactor_full = SUNTRUE;
+      }
+
+      if (!refactor_full) {
+
+        /* Reciprocal pivot growth, small values indicate that the pivot
+           sequence of the prior factorization is no longer stable */
+        retval = sun_klu_rgrowth((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
+                                 (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
+                                 SUNSparseMatrix_Data(A),
+                                 SYMBOLIC(S),
+                                 NUMERIC(S),
+                                 &COMMON(S));
+        if (retval == 0) {
+          LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
+          return(LASTFLAG(S));
+        }
+
+        if ( COMMON(S).rgrowth < uround_twothirds )
+          refactor_full = SUNTRUE;
       }
+    }
 
+    /* Recompute the numeric factorization, reusing the symbolic one */
+    if (refactor_full) {
+      if (KLUFactor(S, A)) {
+        /* Factor from scratch in the next call (e.g., after a step size
+           change makes the matrix nonsingular) */
+        FIRSTFACTORIZE(S) = 1;
+        LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
+        return(LASTFLAG(S));
+      }
     }
   }
 
@@ -371,7 +512,8 @@ int SUNLinSolSolve_KLU(SUNLinearSolver S, SUNMatrix A, N_Vector x,
 
   /* Call KLU to solve the linear system */
   flag = SOLVE(S)(SYMBOLIC(S), NUMERIC(S),
-                  SUNSparseMatrix_NP(A), 1, xdata,
+                  (SUNMatGetID(A) == SUNMATRIX_BSR) ?
+                  SUNBSRMatrix_Rows(A) : SUNSparseMatrix_NP(A), 1, xdata,
                   &COMMON(S));
   if (flag == 0) {
     LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
@@ -411,8 +553,9 @@ int SUNLinSolFree_KLU(SUNLinearSolver S)
   if (S->content) {
     if (NUMERIC(S))
       sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
-    if (SYMBOLIC(S))
-      sun_klu_free_symbolic(&SYMBOLIC(S), &COMMON(S));
+    KLUSharedSymbolicRelease(S);
+    if (BSRCOPY(S))
+      SUNMatDestroy(BSRCOPY(S));
     free(S->content);
     S->content = NULL;
   }
@@ -425,3 +568,186 @@ int SUNLinSolFree_KLU(SUNLinearSolver S)
   free(S); S = NULL;
   return(SUNLS_SUCCESS);
 }
+
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Create an empty symbolic factorization holder with one reference
+ */
+
+static SUNKLUSharedSymbolic KLUSharedSymbolicNew(void)
+{
+  SUNKLUSharedSymbolic shared;
+
+  shared = (SUNKLUSharedSymbolic) malloc(sizeof *shared);
+  if (shared == NULL) return(NULL);
+
+  shared->symbolic  = NULL;
+  shared->hash      = 0;
+  shared->n         = 0;
+  shared->nnz       = 0;
+  shared->indexptrs = NULL;
+  shared->indexvals = NULL;
+  shared->ordering  = -1;
+  shared->refcount = 1;
+
+  return(shared);
+}
+
+/* ----------------------------------------------------------------------------
+ * Drop the reference of S to its symbolic factorization holder and free the
+ * holder when no other solver uses it
+ */
+
+static void KLUSharedSymbolicRelease(SUNLinearSolver S)
+{
+  SUNKLUSharedSymbolic shared = SHARED(S);
+
+  SYMBOLIC(S) = NULL;
+  SHARED(S)   = NULL;
+  if (shared == NULL) return;
+
+  shared->refcount--;
+  if (shared->refcount > 0) return;
+
+  if (shared->symbolic)
+    sun_klu_free_symbolic(&(shared->symbolic), &COMMON(S));
+  free(shared->indexptrs);
+  free(shared->indexvals);
+  free(shared);
+}
+
+/* ----------------------------------------------------------------------------
+ * FNV-1a hash of the sparsity pattern (index pointers and index values)
+ */
+
+static unsigned long KLUPatternHash(SUNMatrix A)
+{
+  sunindextype i, np, nnz;
+  sunindextype *ptrs, *vals;
+  unsigned long hash = 2166136261UL;
+
+  np   = SUNSparseMatrix_NP(A);
+  ptrs = SUNSparseMatrix_IndexPointers(A);
+  vals = SUNSparseMatrix_IndexValues(A);
+  nnz  = ptrs[np];
+
+  for (i = 0; i <= np; i++)
+    hash = (hash ^ (unsigned long) ptrs[i]) * 16777619UL;
+  for (i = 0; i < nnz; i++)
+    hash = (hash ^ (unsigned long) vals[i]) * 16777619UL;
+
+  return(hash);
+}
+
+/* ----------------------------------------------------------------------------
+ * Check if the pattern of A is the analyzed pattern. Equal hashes may come
+ * from different patterns, so the index arrays are always compared.
+ */
+
+static booleantype KLUPatternMatches(SUNKLUSharedSymbolic shared, SUNMatrix A,
+                                     unsigned long hash)
+{
+  sunindextype np, nnz;
+  sunindextype *ptrs, *vals;
+
+  np   = SUNSparseMatrix_NP(A);
+  ptrs = SUNSparseMatrix_IndexPointers(A);
+  vals = SUNSparseMatrix_IndexValues(A);
+  nnz  = ptrs[np];
+
+  if ( (shared->indexptrs == NULL) || (shared->hash != hash) ||
+       (shared->n != np) || (shared->nnz != nnz) )
+    return(SUNFALSE);
+
+  if (memcmp(shared->indexptrs, ptrs, (np+1)*sizeof(sunindextype)))
+    return(SUNFALSE);
+  if ((nnz > 0) && memcmp(shared->indexvals, vals, nnz*sizeof(sunindextype)))
+    return(SUNFALSE);
+
+  return(SUNTRUE);
+}
+
+/* ----------------------------------------------------------------------------
+ * Store a copy of the pattern of A as the analyzed pattern
+ */
+
+static int KLUPatternSave(SUNKLUSharedSymbolic shared, SUNMatrix A,
+                          unsigned long hash)
+{
+  sunindextype np, nnz;
+  sunindextype *ptrs, *vals;
+
+  np   = SUNSparseMatrix_NP(A);
+  ptrs = SUNSparseMatrix_IndexPointers(A);
+  vals = SUNSparseMatrix_IndexValues(A);
+  nnz  = ptrs[np];
+
+  free(shared->indexptrs); shared->indexptrs = NULL;
+  free(shared->indexvals); shared->indexvals = NULL;
+  shared->n   = 0;
+  shared->nnz = 0;
+
+  shared->indexptrs = (sunindextype*) malloc((np+1)*sizeof(sunindextype));
+  shared->indexvals = (sunindextype*) malloc(SUNMAX(nnz,1)*sizeof(sunindextype));
+  if ((shared->indexptrs == NULL) || (shared->indexvals == NULL)) {
+    free(shared->indexptrs); shared->indexptrs = NULL;
+    free(shared->indexvals); shared->indexvals = NULL;
+    return(-1);
+  }
+
+  memcpy(shared->indexptrs, ptrs, (np+1)*sizeof(sunindextype));
+  if (nnz > 0) memcpy(shared->indexvals, vals, nnz*sizeof(sunindextype));
+  shared->hash = hash;
+  shared->n    = np;
+  shared->nnz  = nnz;
+
+  return(0);
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute a new numeric factorization with the current symbolic one
+ */
+
+static int KLUFactor(SUNLinearSolver S, SUNMatrix A)
+{
+  if (NUMERIC(S))
+    sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
+  NUMERIC(S) = sun_klu_factor((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
+                              (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
+                              SUNSparseMatrix_Data(A),
+                              SYMBOLIC(S),
+                              &COMMON(S));
+  return((NUMERIC(S) == NULL) ? 1 : 0);
+}
+
+/* ----------------------------------------------------------------------------
+ * Copy the blocks of the BSR matrix A to the CSC matrix factored by KLU. The
+ * copy reports a pattern change only when the block pattern of A changes, so
+ * the symbolic factorization is kept between setups.
+ */
+
+static SUNMatrix KLUSparseMatrix(SUNLinearSolver S, SUNMatrix A)
+{
+  if ((BSRCOPY(S) != NULL) &&
+      (SUNSparseMatrix_Rows(BSRCOPY(S)) != SUNBSRMatrix_Rows(A))) {
+    SUNMatDestroy(BSRCOPY(S));
+    BSRCOPY(S) = NULL;
+  }
+
+  if (BSRCOPY(S) == NULL) {
+    if (SUNBSRMatrix_ToSparse(A, CSC_MAT, &BSRCOPY(S)) != SUNMAT_SUCCESS)
+      return(NULL);
+    return(BSRCOPY(S));
+  }
+
+  if (SUNBSRMatrix_CopyToSparse(A, BSRCOPY(S)) != SUNMAT_SUCCESS)
+    return(NULL);
+
+  return(BSRCOPY(S));
+}
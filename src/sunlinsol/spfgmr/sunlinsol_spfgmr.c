@@ -38,6 +38,10 @@
 #define SPFGMR_CONTENT(S)  ( (SUNLinearSolverContent_SPFGMR)(S->content) )
 #define LASTFLAG(S)        ( SPFGMR_CONTENT(S)->last_flag )
 
+/* Private function to solve with the Krylov vectors in place */
+static int SPFGMRSolve(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                       N_Vector b, realtype delta);
+
 /*
  * -----------------------------------------------------------------
  * exported functions
@@ -251,7 +255,7 @@ int SUNLinSolInitialize_SPFGMR(SUNLinearSolver S)
      choice of maxl) here */
 
   /*   Krylov subspace vectors */
-  if (content->V == NULL) {
+  if (content->V == NULL && !sunVectorPoolUsable(content->vtemp)) {
     content->V = N_VCloneVectorArray(content->maxl+1, content->vtemp);
     if (content->V == NULL) {
       content->last_flag = SUNLS_MEM_FAIL;
@@ -260,7 +264,7 @@ int SUNLinSolInitialize_SPFGMR(SUNLinearSolver S)
   }
 
   /*   Preconditioned basis vectors */
-  if (content->Z == NULL) {
+  if (content->Z == NULL && !sunVectorPoolUsable(content->vtemp)) {
     content->Z = N_VCloneVectorArray(content->maxl+1, content->vtemp);
     if (content->Z == NULL) {
       content->last_flag = SUNLS_MEM_FAIL;
@@ -405,8 +409,8 @@ int SUNLinSolSetup_SPFGMR(SUNLinearSolver S, SUNMatrix A)
 }
 
 
-int SUNLinSolSolve_SPFGMR(SUNLinearSolver S, SUNMatrix A, N_Vector x,
-                          N_Vector b, realtype delta)
+static int SPFGMRSolve(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                       N_Vector b, realtype delta)
 {
   /* local data and shortcut variables */
   N_Vector *V, *Z, xcor, vtemp, s1, s2;
@@ -714,6 +718,43 @@ int SUNLinSolSolve_SPFGMR(SUNLinearSolver S, SUNMatrix A, N_Vector x,
 }
 
 
+int SUNLinSolSolve_SPFGMR(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                          N_Vector b, realtype delta)
+{
+  int retval;
+  SUNLinearSolverContent_SPFGMR content;
+
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  content = SPFGMR_CONTENT(S);
+
+  /* use the vectors allocated by SUNLinSolInitialize if there are any,
+     otherwise borrow the Krylov and preconditioned basis vectors from the vector
+     pool for the duration of the solve */
+  if (content->V != NULL) return(SPFGMRSolve(S, A, x, b, delta));
+
+  content->V = N_VCheckoutVectorArray(content->maxl+1, content->vtemp);
+  content->Z = N_VCheckoutVectorArray(content->maxl+1, content->vtemp);
+  if (content->V == NULL || content->Z == NULL) {
+    N_VReturnVectorArray(content->V, content->maxl+1);
+    N_VReturnVectorArray(content->Z, content->maxl+1);
+    content->V = NULL;
+    content->Z = NULL;
+    content->zeroguess = SUNFALSE;
+    content->last_flag = SUNLS_MEM_FAIL;
+    return(SUNLS_MEM_FAIL);
+  }
+
+  retval = SPFGMRSolve(S, A, x, b, delta);
+
+  N_VReturnVectorArray(content->V, content->maxl+1);
+  N_VReturnVectorArray(content->Z, content->maxl+1);
+  content->V = NULL;
+  content->Z = NULL;
+
+  return(retval);
+}
+
+
 int SUNLinSolNumIters_SPFGMR(SUNLinearSolver S)
 {
   /* return the stored 'numiters' value */
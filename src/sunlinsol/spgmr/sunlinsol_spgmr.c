@@ -38,6 +38,10 @@
 #define SPGMR_CONTENT(S)  ( (SUNLinearSolverContent_SPGMR)(S->content) )
 #define LASTFLAG(S)       ( SPGMR_CONTENT(S)->last_flag )
 
+/* Private function to solve with the Krylov vectors in place */
+static int SPGMRSolve(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                      N_Vector b, realtype delta);
+
 /*
  * -----------------------------------------------------------------
  * exported functions
@@ -248,7 +252,7 @@ int SUNLinSolInitialize_SPGMR(SUNLinearSolver S)
      choice of maxl) here */
 
   /*   Krylov subspace vectors */
-  if (content->V == NULL) {
+  if (content->V == NULL && !sunVectorPoolUsable(content->vtemp)) {
     content->V = N_VCloneVectorArray(content->maxl+1, content->vtemp);
     if (content->V == NULL) {
       content->last_flag = SUNLS_MEM_FAIL;
@@ -393,8 +397,8 @@ int SUNLinSolSetup_SPGMR(SUNLinearSolver S, SUNMatrix A)
 }
 
 
-int SUNLinSolSolve_SPGMR(SUNLinearSolver S, SUNMatrix A, N_Vector x,
-                         N_Vector b, realtype delta)
+static int SPGMRSolve(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                      N_Vector b, realtype delta)
 {
   /* local data and shortcut variables */
   N_Vector *V, xcor, vtemp, s1, s2;
@@ -767,6 +771,36 @@ int SUNLinSolSolve_SPGMR(SUNLinearSolver S, SUNMatrix A, N_Vector x,
 }
 
 
+int SUNLinSolSolve_SPGMR(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                         N_Vector b, realtype delta)
+{
+  int retval;
+  SUNLinearSolverContent_SPGMR content;
+
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  content = SPGMR_CONTENT(S);
+
+  /* use the vectors allocated by SUNLinSolInitialize if there are any,
+     otherwise borrow the Krylov vectors from the vector
+     pool for the duration of the solve */
+  if (content->V != NULL) return(SPGMRSolve(S, A, x, b, delta));
+
+  content->V = N_VCheckoutVectorArray(content->maxl+1, content->vtemp);
+  if (content->V == NULL) {
+    content->zeroguess = SUNFALSE;
+    content->last_flag = SUNLS_MEM_FAIL;
+    return(SUNLS_MEM_FAIL);
+  }
+
+  retval = SPGMRSolve(S, A, x, b, delta);
+
+  N_VReturnVectorArray(content->V, content->maxl+1);
+  content->V = NULL;
+
+  return(retval);
+}
+
+
 int SUNLinSolNumIters_SPGMR(SUNLinearSolver S)
 {
   /* return the stored 'numiters' value */
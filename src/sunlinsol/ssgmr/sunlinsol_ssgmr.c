@@ -0,0 +1,1126 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the SSGMR implementation of
+ * the SUNLINSOL package.
+ *
+ * Starting from the last orthonormal Krylov vector v_j, each block
+ * generates y_i = A-tilde y_(i-1) / sigma, i = 1,...,s, with y_0 = v_j,
+ * and orthonormalizes the y_i against V and each other with two
+ * passes of block classical Gram-Schmidt followed by Cholesky QR,
+ * where the Gram matrix of the projected block is obtained from the
+ * same reduction as the projection coefficients (Pythagorean
+ * update). The Hessenberg columns of the new vectors are recovered
+ * from the resulting change of basis. The scaling sigma estimates
+ * the growth of the monomial basis from the previous block.
+ *
+ * The reductions are blocking. Each block starts from the vector
+ * returned by the second CholQR pass of the previous block, so the
+ * Gram matrix reduction cannot overlap with the next matvec without
+ * changing the iterates (pipelining is not supported).
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sunlinsol/sunlinsol_ssgmr.h>
+#include <sundials/sundials_math.h>
+
+#include "sundials_context_impl.h"
+#include "sundials_logger_impl.h"
+
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+#define TWO  RCONST(2.0)
+
+/*
+ * -----------------------------------------------------------------
+ * SSGMR solver structure accessibility macros:
+ * -----------------------------------------------------------------
+ */
+
+#define SSGMR_CONTENT(S)  ( (SUNLinearSolverContent_SSGMR)(S->content) )
+#define LASTFLAG(S)       ( SSGMR_CONTENT(S)->last_flag )
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static int SSGMRApplyOp(SUNLinearSolver S, booleantype preOnLeft,
+                        booleantype preOnRight, realtype delta,
+                        N_Vector x, N_Vector y);
+static int SSGMRDots(int nx, N_Vector *X, int ny, N_Vector *Y, realtype *d);
+static int SSGMRBlockPass(N_Vector *V, int j, int p, realtype *d,
+                          realtype *C, int ldc, realtype *R, realtype *G,
+                          int lds, realtype *cv, N_Vector *Xv);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new SSGMR linear solver
+ */
+
+SUNLinearSolver SUNLinSol_SSGMR(N_Vector y, int pretype, int maxl, SUNContext sunctx)
+{
+  SUNLinearSolver S;
+  SUNLinearSolverContent_SSGMR content;
+
+  /* check for legal pretype and maxl values; if illegal use defaults */
+  if ((pretype != SUN_PREC_NONE)  && (pretype != SUN_PREC_LEFT) &&
+      (pretype != SUN_PREC_RIGHT) && (pretype != SUN_PREC_BOTH))
+    pretype = SUN_PREC_NONE;
+  if (maxl <= 0)
+    maxl = SUNSSGMR_MAXL_DEFAULT;
+
+  /* check that the supplied N_Vector supports all requisite operations */
+  if ( (y->ops->nvclone == NULL) || (y->ops->nvdestroy == NULL) ||
+       (y->ops->nvlinearsum == NULL) || (y->ops->nvconst == NULL) ||
+       (y->ops->nvprod == NULL) || (y->ops->nvdiv == NULL) ||
+       (y->ops->nvscale == NULL) || (y->ops->nvdotprod == NULL) )
+    return(NULL);
+
+  /* Create linear solver */
+  S = NULL;
+  S = SUNLinSolNewEmpty(sunctx);
+  if (S == NULL) return(NULL);
+
+  /* Attach operations */
+  S->ops->gettype           = SUNLinSolGetType_SSGMR;
+  S->ops->getid             = SUNLinSolGetID_SSGMR;
+  S->ops->setatimes         = SUNLinSolSetATimes_SSGMR;
+  S->ops->setpreconditioner = SUNLinSolSetPreconditioner_SSGMR;
+  S->ops->setscalingvectors = SUNLinSolSetScalingVectors_SSGMR;
+  S->ops->setzeroguess      = SUNLinSolSetZeroGuess_SSGMR;
+  S->ops->initialize        = SUNLinSolInitialize_SSGMR;
+  S->ops->setup             = SUNLinSolSetup_SSGMR;
+  S->ops->solve             = SUNLinSolSolve_SSGMR;
+  S->ops->numiters          = SUNLinSolNumIters_SSGMR;
+  S->ops->resnorm           = SUNLinSolResNorm_SSGMR;
+  S->ops->resid             = SUNLinSolResid_SSGMR;
+  S->ops->lastflag          = SUNLinSolLastFlag_SSGMR;
+  S->ops->space             = SUNLinSolSpace_SSGMR;
+  S->ops->free              = SUNLinSolFree_SSGMR;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNLinearSolverContent_SSGMR) malloc(sizeof *content);
+  if (content == NULL) { SUNLinSolFree(S); return(NULL); }
+
+  /* Attach content */
+  S->content = content;
+
+  /* Fill content */
+  content->last_flag    = 0;
+  content->maxl         = maxl;
+  content->pretype      = pretype;
+  content->block        = SUNSSGMR_BLOCK_DEFAULT;
+  content->max_restarts = SUNSSGMR_MAXRS_DEFAULT;
+  content->zeroguess    = SUNFALSE;
+  content->numiters     = 0;
+  content->resnorm      = ZERO;
+  content->sigma        = ONE;
+  content->xcor         = NULL;
+  content->vtemp        = NULL;
+  content->s1           = NULL;
+  content->s2           = NULL;
+  content->ATimes       = NULL;
+  content->ATData       = NULL;
+  content->Psetup       = NULL;
+  content->Psolve       = NULL;
+  content->PData        = NULL;
+  content->V            = NULL;
+  content->Hes          = NULL;
+  content->Hraw         = NULL;
+  content->givens       = NULL;
+  content->yg           = NULL;
+  content->cv           = NULL;
+  content->Xv           = NULL;
+  content->work         = NULL;
+
+  /* Allocate content */
+  content->xcor = N_VClone(y);
+  if (content->xcor == NULL) { SUNLinSolFree(S); return(NULL); }
+
+  content->vtemp = N_VClone(y);
+  if (content->vtemp == NULL) { SUNLinSolFree(S); return(NULL); }
+
+  return(S);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Function to set the type of preconditioning for SSGMR to use
+ */
+
+int SUNLinSol_SSGMRSetPrecType(SUNLinearSolver S, int pretype)
+{
+  /* Check for legal pretype */
+  if ((pretype != SUN_PREC_NONE)  && (pretype != SUN_PREC_LEFT) &&
+      (pretype != SUN_PREC_RIGHT) && (pretype != SUN_PREC_BOTH)) {
+    return(SUNLS_ILL_INPUT);
+  }
+
+  /* Check for non-NULL SUNLinearSolver */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+
+  /* Set pretype */
+  SSGMR_CONTENT(S)->pretype = pretype;
+  return(SUNLS_SUCCESS);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of Krylov vectors SSGMR generates per block
+ */
+
+int SUNLinSol_SSGMRSetBlockSize(SUNLinearSolver S, int block)
+{
+  /* Illegal block size implies use of default value */
+  if (block <= 0)
+    block = SUNSSGMR_BLOCK_DEFAULT;
+
+  /* Check for non-NULL SUNLinearSolver */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+
+  /* The block workspace depends on the block size, release it so that
+     the next call to SUNLinSolInitialize reallocates it */
+  if ((SSGMR_CONTENT(S)->work != NULL) && (block != SSGMR_CONTENT(S)->block)) {
+    free(SSGMR_CONTENT(S)->work);
+    SSGMR_CONTENT(S)->work = NULL;
+  }
+
+  /* Set block */
+  SSGMR_CONTENT(S)->block = block;
+  return(SUNLS_SUCCESS);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Function to set the maximum number of GMRES restarts to allow
+ */
+
+int SUNLinSol_SSGMRSetMaxRestarts(SUNLinearSolver S, int maxrs)
+{
+  /* Illegal maxrs implies use of default value */
+  if (maxrs < 0)
+    maxrs = SUNSSGMR_MAXRS_DEFAULT;
+
+  /* Check for non-NULL SUNLinearSolver */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+
+  /* Set max_restarts */
+  SSGMR_CONTENT(S)->max_restarts = maxrs;
+  return(SUNLS_SUCCESS);
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of linear solver operations
+ * -----------------------------------------------------------------
+ */
+
+SUNLinearSolver_Type SUNLinSolGetType_SSGMR(SUNLinearSolver S)
+{
+  return(SUNLINEARSOLVER_ITERATIVE);
+}
+
+
+SUNLinearSolver_ID SUNLinSolGetID_SSGMR(SUNLinearSolver S)
+{
+  return(SUNLINEARSOLVER_SSGMR);
+}
+
+
+int SUNLinSolInitialize_SSGMR(SUNLinearSolver S)
+{
+  int k, maxl, block;
+  SUNLinearSolverContent_SSGMR content;
+
+  /* set shortcut to SSGMR memory structure */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  content = SSGMR_CONTENT(S);
+
+  /* ensure valid options */
+  if (content->max_restarts < 0)
+    content->max_restarts = SUNSSGMR_MAXRS_DEFAULT;
+
+  if (content->ATimes == NULL) {
+    LASTFLAG(S) = SUNLS_ATIMES_NULL;
+    return(LASTFLAG(S));
+  }
+
+  if ( (content->pretype != SUN_PREC_LEFT) &&
+       (content->pretype != SUN_PREC_RIGHT) &&
+       (content->pretype != SUN_PREC_BOTH) )
+    content->pretype = SUN_PREC_NONE;
+
+  if ((content->pretype != SUN_PREC_NONE) && (content->Psolve == NULL)) {
+    LASTFLAG(S) = SUNLS_PSOLVE_NULL;
+    return(LASTFLAG(S));
+  }
+
+  /* allocate solver-specific memory (where the size depends on the
+     choice of maxl and block) here */
+  maxl  = content->maxl;
+  block = content->block;
+
+  /*   Krylov subspace vectors */
+  if (content->V == NULL) {
+    content->V = N_VCloneVectorArray(maxl+1, content->vtemp);
+    if (content->V == NULL) {
+      content->last_flag = SUNLS_MEM_FAIL;
+      return(SUNLS_MEM_FAIL);
+    }
+  }
+
+  /*   Hessenberg matrix Hes (overwritten by its QR factorization) and
+       its unfactored copy Hraw */
+  if (content->Hes == NULL) {
+    content->Hes = (realtype **) calloc(maxl+1, sizeof(realtype *));
+    if (content->Hes == NULL) {
+      content->last_flag = SUNLS_MEM_FAIL;
+      return(SUNLS_MEM_FAIL);
+    }
+
+    for (k=0; k<=maxl; k++) {
+      content->Hes[k] = (realtype *) malloc(maxl*sizeof(realtype));
+      if (content->Hes[k] == NULL) {
+        content->last_flag = SUNLS_MEM_FAIL;
+        return(SUNLS_MEM_FAIL);
+      }
+    }
+  }
+
+  if (content->Hraw == NULL) {
+    content->Hraw = (realtype **) calloc(maxl+1, sizeof(realtype *));
+    if (content->Hraw == NULL) {
+      content->last_flag = SUNLS_MEM_FAIL;
+      return(SUNLS_MEM_FAIL);
+    }
+
+    for (k=0; k<=maxl; k++) {
+      content->Hraw[k] = (realtype *) malloc(maxl*sizeof(realtype));
+      if (content->Hraw[k] == NULL) {
+        content->last_flag = SUNLS_MEM_FAIL;
+        return(SUNLS_MEM_FAIL);
+      }
+    }
+  }
+
+  /*   Givens rotation components */
+  if (content->givens == NULL) {
+    content->givens = (realtype *) malloc(2*maxl*sizeof(realtype));
+    if (content->givens == NULL) {
+      content->last_flag = SUNLS_MEM_FAIL;
+      return(SUNLS_MEM_FAIL);
+    }
+  }
+
+  /*    y and g vectors */
+  if (content->yg == NULL) {
+    content->yg = (realtype *) malloc((maxl+1)*sizeof(realtype));
+    if (content->yg == NULL) {
+      content->last_flag = SUNLS_MEM_FAIL;
+      return(SUNLS_MEM_FAIL);
+    }
+  }
+
+  /*    cv vector for fused vector ops */
+  if (content->cv == NULL) {
+    content->cv = (realtype *) malloc((maxl+1)*sizeof(realtype));
+    if (content->cv == NULL) {
+      content->last_flag = SUNLS_MEM_FAIL;
+      return(SUNLS_MEM_FAIL);
+    }
+  }
+
+  /*    Xv vector for fused vector ops */
+  if (content->Xv == NULL) {
+    content->Xv = (N_Vector *) malloc((maxl+1)*sizeof(N_Vector));
+    if (content->Xv == NULL) {
+      content->last_flag = SUNLS_MEM_FAIL;
+      return(SUNLS_MEM_FAIL);
+    }
+  }
+
+  /*    block workspace: the dot products, the projection coefficients
+        and triangular factors of both passes, and the Gram matrix */
+  if (content->work == NULL) {
+    content->work = (realtype *) malloc((3*(maxl+1) + 3*block) * block *
+                                        sizeof(realtype));
+    if (content->work == NULL) {
+      content->last_flag = SUNLS_MEM_FAIL;
+      return(SUNLS_MEM_FAIL);
+    }
+  }
+
+  /* return with success */
+  content->last_flag = SUNLS_SUCCESS;
+  return(SUNLS_SUCCESS);
+}
+
+
+int SUNLinSolSetATimes_SSGMR(SUNLinearSolver S, void* ATData,
+                             SUNATimesFn ATimes)
+{
+  /* set function pointers to integrator-supplied ATimes routine
+     and data, and return with success */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  SSGMR_CONTENT(S)->ATimes = ATimes;
+  SSGMR_CONTENT(S)->ATData = ATData;
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(LASTFLAG(S));
+}
+
+
+int SUNLinSolSetPreconditioner_SSGMR(SUNLinearSolver S, void* PData,
+                                     SUNPSetupFn Psetup, SUNPSolveFn Psolve)
+{
+  /* set function pointers to integrator-supplied Psetup and PSolve
+     routines and data, and return with success */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  SSGMR_CONTENT(S)->Psetup = Psetup;
+  SSGMR_CONTENT(S)->Psolve = Psolve;
+  SSGMR_CONTENT(S)->PData = PData;
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(LASTFLAG(S));
+}
+
+
+int SUNLinSolSetScalingVectors_SSGMR(SUNLinearSolver S, N_Vector s1,
+                                     N_Vector s2)
+{
+  /* set N_Vector pointers to integrator-supplied scaling vectors,
+     and return with success */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  SSGMR_CONTENT(S)->s1 = s1;
+  SSGMR_CONTENT(S)->s2 = s2;
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(LASTFLAG(S));
+}
+
+
+int SUNLinSolSetZeroGuess_SSGMR(SUNLinearSolver S, booleantype onff)
+{
+  /* set flag indicating a zero initial guess */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  SSGMR_CONTENT(S)->zeroguess = onff;
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(LASTFLAG(S));
+}
+
+
+int SUNLinSolSetup_SSGMR(SUNLinearSolver S, SUNMatrix A)
+{
+  int ier;
+  SUNPSetupFn Psetup;
+  void* PData;
+
+  /* Set shortcuts to SSGMR memory structures */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  Psetup = SSGMR_CONTENT(S)->Psetup;
+  PData = SSGMR_CONTENT(S)->PData;
+
+  /* no solver-specific setup is required, but if user-supplied
+     Psetup routine exists, call that here */
+  if (Psetup != NULL) {
+    ier = Psetup(PData);
+    if (ier != 0) {
+      LASTFLAG(S) = (ier < 0) ?
+        SUNLS_PSET_FAIL_UNREC : SUNLS_PSET_FAIL_REC;
+      return(LASTFLAG(S));
+    }
+  }
+
+  /* the preconditioned operator changed, restart the basis scaling */
+  SSGMR_CONTENT(S)->sigma = ONE;
+
+  /* return with success */
+  return(SUNLS_SUCCESS);
+}
+
+
+int SUNLinSolSolve_SSGMR(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                         N_Vector b, realtype delta)
+{
+  /* local data and shortcut variables */
+  N_Vector *V, xcor, vtemp, s1, s2;
+  realtype **Hes, **Hraw, *givens, *yg, *res_norm, *work;
+  realtype *d, *C1, *C2, *R1, *R2, *G;
+  realtype beta, rotation_product, r_norm, s_product, rho, sigma, rhs;
+  realtype tkc, ynorm2, nu;
+  booleantype preOnLeft, preOnRight, scale1, converged;
+  booleantype *zeroguess;
+  int i, k, l, c, r, j, p, p1, pmax, ldc, lds, krydim, ier, ntries;
+  int l_max, max_restarts, block;
+  int *nli;
+  void *P_data;
+  SUNATimesFn atimes;
+  SUNPSolveFn psolve;
+
+  /* local shortcuts for fused vector operations */
+  realtype* cv;
+  N_Vector* Xv;
+
+  /* Initialize some variables */
+  krydim = 0;
+
+  /* Make local shorcuts to solver variables. */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+  l_max        = SSGMR_CONTENT(S)->maxl;
+  max_restarts = SSGMR_CONTENT(S)->max_restarts;
+  block        = SSGMR_CONTENT(S)->block;
+  V            = SSGMR_CONTENT(S)->V;
+  Hes          = SSGMR_CONTENT(S)->Hes;
+  Hraw         = SSGMR_CONTENT(S)->Hraw;
+  givens       = SSGMR_CONTENT(S)->givens;
+  xcor         = SSGMR_CONTENT(S)->xcor;
+  yg           = SSGMR_CONTENT(S)->yg;
+  vtemp        = SSGMR_CONTENT(S)->vtemp;
+  s1           = SSGMR_CONTENT(S)->s1;
+  s2           = SSGMR_CONTENT(S)->s2;
+  P_data       = SSGMR_CONTENT(S)->PData;
+  atimes       = SSGMR_CONTENT(S)->ATimes;
+  psolve       = SSGMR_CONTENT(S)->Psolve;
+  zeroguess    = &(SSGMR_CONTENT(S)->zeroguess);
+  nli          = &(SSGMR_CONTENT(S)->numiters);
+  res_norm     = &(SSGMR_CONTENT(S)->resnorm);
+  cv           = SSGMR_CONTENT(S)->cv;
+  Xv           = SSGMR_CONTENT(S)->Xv;
+  work         = SSGMR_CONTENT(S)->work;
+
+  /* Partition the block workspace */
+  ldc = l_max + 1;
+  lds = block;
+  d   = work;
+  C1  = d  + ldc*lds;
+  C2  = C1 + ldc*lds;
+  R1  = C2 + ldc*lds;
+  R2  = R1 + lds*lds;
+  G   = R2 + lds*lds;
+
+  /* Initialize counters and convergence flag */
+  *nli = 0;
+  converged = SUNFALSE;
+
+  /* Set booleantype flags for internal solver options */
+  preOnLeft  = ( (SSGMR_CONTENT(S)->pretype == SUN_PREC_LEFT) ||
+                 (SSGMR_CONTENT(S)->pretype == SUN_PREC_BOTH) );
+  preOnRight = ( (SSGMR_CONTENT(S)->pretype == SUN_PREC_RIGHT) ||
+                 (SSGMR_CONTENT(S)->pretype == SUN_PREC_BOTH) );
+  scale1 = (s1 != NULL);
+
+  /* Check if Atimes function has been set */
+  if (atimes == NULL) {
+    *zeroguess  = SUNFALSE;
+    LASTFLAG(S) = SUNLS_ATIMES_NULL;
+    return(LASTFLAG(S));
+  }
+
+  /* If preconditioning, check if psolve has been set */
+  if ((preOnLeft || preOnRight) && psolve == NULL) {
+    *zeroguess  = SUNFALSE;
+    LASTFLAG(S) = SUNLS_PSOLVE_NULL;
+    return(LASTFLAG(S));
+  }
+
+  /* Set vtemp and V[0] to initial (unscaled) residual r_0 = b - A*x_0 */
+  if (*zeroguess) {
+    N_VScale(ONE, b, vtemp);
+  } else {
+    ier = atimes(SSGMR_CONTENT(S)->ATData, x, vtemp);
+    if (ier != 0) {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = (ier < 0) ?
+        SUNLS_ATIMES_FAIL_UNREC : SUNLS_ATIMES_FAIL_REC;
+      return(LASTFLAG(S));
+    }
+    N_VLinearSum(ONE, b, -ONE, vtemp, vtemp);
+  }
+  N_VScale(ONE, vtemp, V[0]);
+
+  /* Apply left preconditioner and left scaling to V[0] = r_0 */
+  if (preOnLeft) {
+    ier = psolve(P_data, V[0], vtemp, delta, SUN_PREC_LEFT);
+    if (ier != 0) {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = (ier < 0) ?
+        SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC;
+      return(LASTFLAG(S));
+    }
+  } else {
+    N_VScale(ONE, V[0], vtemp);
+  }
+
+  if (scale1) {
+    N_VProd(s1, vtemp, V[0]);
+  } else {
+    N_VScale(ONE, vtemp, V[0]);
+  }
+
+  /* Set r_norm = beta to L2 norm of V[0] = s1 P1_inv r_0, and
+     return if small  */
+  *res_norm = r_norm = beta = SUNRsqrt(N_VDotProd(V[0], V[0]));
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_INFO
+  SUNLogger_QueueMsg(S->sunctx->logger, SUN_LOGLEVEL_INFO,
+    "SUNLinSolSolve_SSGMR", "initial-residual",
+    "nli = %li, resnorm = %.16g", (long int) 0, *res_norm);
+#endif
+
+  if (r_norm <= delta) {
+    *zeroguess  = SUNFALSE;
+    LASTFLAG(S) = SUNLS_SUCCESS;
+    return(LASTFLAG(S));
+  }
+
+  /* Initialize rho to avoid compiler warning message */
+  rho = beta;
+
+  /* Set xcor = 0 */
+  N_VConst(ZERO, xcor);
+
+  /* Begin outer iterations: up to (max_restarts + 1) attempts */
+  for (ntries=0; ntries<=max_restarts; ntries++) {
+
+    /* Initialize the Hessenberg matrices and Givens rotation
+       product.  Normalize the initial vector V[0] */
+    for (i=0; i<=l_max; i++)
+      for (k=0; k<l_max; k++)
+        Hes[i][k] = Hraw[i][k] = ZERO;
+
+    rotation_product = ONE;
+    N_VScale(ONE/r_norm, V[0], V[0]);
+
+    /* Inner loop: generate the Krylov basis block by block, V[j] is the
+       last orthonormal basis vector */
+    j = 0;
+    while (j < l_max) {
+
+      pmax  = SUNMIN(block, l_max - j);
+      sigma = SSGMR_CONTENT(S)->sigma;
+
+      /* Monomial basis V[j+i] = A-tilde V[j+i-1] / sigma, where A-tilde =
+         s1 P1_inv A P2_inv s2_inv */
+      for (i=1; i<=pmax; i++) {
+        ier = SSGMRApplyOp(S, preOnLeft, preOnRight, delta, V[j+i-1], V[j+i]);
+        if (ier != SUNLS_SUCCESS) {
+          *zeroguess  = SUNFALSE;
+          LASTFLAG(S) = ier;
+          return(LASTFLAG(S));
+        }
+        if (sigma != ONE) N_VScale(ONE/sigma, V[j+i], V[j+i]);
+      }
+
+      /* First orthogonalization pass */
+      p1 = SSGMRBlockPass(V, j, pmax, d, C1, ldc, R1, G, lds, cv, Xv);
+      if (p1 < 0) {
+        *zeroguess  = SUNFALSE;
+        LASTFLAG(S) = SUNLS_GS_FAIL;
+        return(LASTFLAG(S));
+      }
+      ynorm2 = (p1 > 0) ? d[(p1-1)*(j+1+pmax) + j+p1] : ZERO;
+
+      /* Second (reorthogonalization) pass, then combine both passes:
+         C1 <- C1 + C2 R1 and R1 <- R2 R1 */
+      p = 0;
+      if (p1 > 0) {
+        p = SSGMRBlockPass(V, j, p1, d, C2, ldc, R2, G, lds, cv, Xv);
+        if (p < 0) {
+          *zeroguess  = SUNFALSE;
+          LASTFLAG(S) = SUNLS_GS_FAIL;
+          return(LASTFLAG(S));
+        }
+      }
+
+      if (p > 0) {
+
+        for (c=0; c<p; c++) {
+          for (r=0; r<=j; r++)
+            for (k=0; k<=c; k++)
+              C1[r + c*ldc] += C2[r + k*ldc] * R1[k + c*lds];
+          for (r=0; r<=c; r++) {
+            rhs = ZERO;
+            for (k=r; k<=c; k++)
+              rhs += R2[r + k*lds] * R1[k + c*lds];
+            R1[r + c*lds] = rhs;
+          }
+        }
+
+        /* With Y = [V[j], y_1, ..., y_p] = V B, where B = [e_j, [C1; R1]],
+           A-tilde Y(:,0:p-1) = sigma V B(:,1:p) gives the Hessenberg
+           columns j,...,j+p-1 from the upper triangular T = B(j:j+p-1,0:p-1)
+           and the columns of Y on V[0],...,V[j-1]. */
+        for (c=0; c<p; c++) {
+          l = j + c;
+          tkc = (c == 0) ? ONE : R1[(c-1) + (c-1)*lds];
+          for (r=0; r<=l+1; r++) {
+            rhs = (r <= j) ? sigma * C1[r + c*ldc]
+                           : sigma * R1[(r-j-1) + c*lds];
+            if ((c > 0) && (r <= j))
+              for (k=0; k<j; k++)
+                rhs -= Hraw[r][k] * C1[k + (c-1)*ldc];
+            for (k=0; k<c; k++)
+              rhs -= Hraw[r][j+k] * ((k == 0) ? C1[j + (c-1)*ldc]
+                                              : R1[(k-1) + (c-1)*lds]);
+            Hraw[r][l] = rhs / tkc;
+          }
+        }
+
+      } else {
+
+        /* The block is numerically rank deficient from its first vector
+           on; fall back to a classical Gram-Schmidt Arnoldi step for
+           V[j+1] = (A-tilde V[j] / sigma - V C1(:,0)) / R1(0,0), where
+           C1(:,0) = 0 and R1(0,0) = 1 if the first pass failed. */
+        if (p1 == 0) {
+          for (r=0; r<=j; r++) C1[r] = ZERO;
+          R1[0] = ONE;
+        }
+        if (SUNClassicalGS(V, Hraw, j+1, j+1, &nu, cv, Xv) != 0) {
+          *zeroguess  = SUNFALSE;
+          LASTFLAG(S) = SUNLS_GS_FAIL;
+          return(LASTFLAG(S));
+        }
+        for (r=0; r<=j; r++)
+          Hraw[r][j] = sigma * (C1[r] + R1[0] * Hraw[r][j]);
+        Hraw[j+1][j] = sigma * R1[0] * nu;
+        if (nu > ZERO) N_VScale(ONE/nu, V[j+1], V[j+1]);
+        p = 1;
+      }
+
+      /* Update the QR factorization of Hes and the residual norm estimate
+         column by column; break if convergence test passes */
+      for (c=0; c<p; c++) {
+        l = j + c;
+        (*nli)++;
+        krydim = l + 1;
+
+        for (r=0; r<=l+1; r++) Hes[r][l] = Hraw[r][l];
+
+        if (SUNQRfact(krydim, Hes, givens, l) != 0) {
+          *zeroguess  = SUNFALSE;
+          LASTFLAG(S) = SUNLS_QRFACT_FAIL;
+          return(LASTFLAG(S));
+        }
+
+        rotation_product *= givens[2*l+1];
+        *res_norm = rho = SUNRabs(rotation_product*r_norm);
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_INFO
+        SUNLogger_QueueMsg(S->sunctx->logger, SUN_LOGLEVEL_INFO,
+          "SUNLinSolSolve_SSGMR", "iterate-residual",
+          "nli = %li, resnorm = %.16g", (long int) *nli, *res_norm);
+#endif
+
+        if (rho <= delta) { converged = SUNTRUE; break; }
+      }
+      if (converged) break;
+
+      /* Update the growth estimate of the monomial basis */
+      if ((p1 > 0) && (ynorm2 > ZERO))
+        SSGMR_CONTENT(S)->sigma = sigma * SUNRpowerR(ynorm2, ONE/(TWO*p1));
+
+      j += p;
+    }
+
+    /* Inner loop is done.  Compute the new correction vector xcor */
+
+    /*   Construct g, then solve for y */
+    yg[0] = r_norm;
+    for (i=1; i<=krydim; i++) yg[i]=ZERO;
+    if (SUNQRsol(krydim, Hes, givens, yg) != 0) {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = SUNLS_QRSOL_FAIL;
+      return(LASTFLAG(S));
+    }
+
+    /*   Add correction vector V_l y to xcor */
+    cv[0] = ONE;
+    Xv[0] = xcor;
+
+    for (k=0; k<krydim; k++) {
+      cv[k+1] = yg[k];
+      Xv[k+1] = V[k];
+    }
+    ier = N_VLinearCombination(krydim+1, cv, Xv, xcor);
+    if (ier != SUNLS_SUCCESS) {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = SUNLS_VECTOROP_ERR;
+      return(SUNLS_VECTOROP_ERR);
+    }
+
+    /* If converged, construct the final solution vector x and return */
+    if (converged) {
+
+      /* Apply right scaling and right precond.: vtemp = P2_inv s2_inv xcor */
+      if (s2 != NULL) N_VDiv(xcor, s2, xcor);
+      if (preOnRight) {
+        ier = psolve(P_data, xcor, vtemp, delta, SUN_PREC_RIGHT);
+        if (ier != 0) {
+          *zeroguess  = SUNFALSE;
+          LASTFLAG(S) = (ier < 0) ?
+            SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC;
+          return(LASTFLAG(S));
+        }
+      } else {
+        N_VScale(ONE, xcor, vtemp);
+      }
+
+      /* Add vtemp to initial x to get final solution x, and return */
+      if (*zeroguess)
+        N_VScale(ONE, vtemp, x);
+      else
+        N_VLinearSum(ONE, x, ONE, vtemp, x);
+
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = SUNLS_SUCCESS;
+      return(LASTFLAG(S));
+    }
+
+    /* Not yet converged; if allowed, prepare for restart */
+    if (ntries == max_restarts) break;
+
+    /* Construct last column of Q in yg */
+    s_product = ONE;
+    for (i=krydim; i>0; i--) {
+      yg[i] = s_product*givens[2*i-2];
+      s_product *= givens[2*i-1];
+    }
+    yg[0] = s_product;
+
+    /* Scale r_norm and yg */
+    r_norm *= s_product;
+    for (i=0; i<=krydim; i++)
+      yg[i] *= r_norm;
+    r_norm = SUNRabs(r_norm);
+
+    /* Multiply yg by V_(krydim+1) to get last residual vector; restart */
+    for (k=0; k<=krydim; k++) {
+      cv[k] = yg[k];
+      Xv[k] = V[k];
+    }
+    ier = N_VLinearCombination(krydim+1, cv, Xv, V[0]);
+    if (ier != SUNLS_SUCCESS) {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = SUNLS_VECTOROP_ERR;
+      return(SUNLS_VECTOROP_ERR);
+    }
+
+  }
+
+  /* Failed to converge, even after allowed restarts.
+     If the residual norm was reduced below its initial value, compute
+     and return x anyway.  Otherwise return failure flag. */
+  if (rho < beta) {
+
+    /* Apply right scaling and right precond.: vtemp = P2_inv s2_inv xcor */
+    if (s2 != NULL) N_VDiv(xcor, s2, xcor);
+    if (preOnRight) {
+      ier = psolve(P_data, xcor, vtemp, delta, SUN_PREC_RIGHT);
+      if (ier != 0) {
+        *zeroguess  = SUNFALSE;
+        LASTFLAG(S) = (ier < 0) ?
+          SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC;
+        return(LASTFLAG(S));
+      }
+    } else {
+      N_VScale(ONE, xcor, vtemp);
+    }
+
+    /* Add vtemp to initial x to get final solution x, and return */
+    if (*zeroguess)
+      N_VScale(ONE, vtemp, x);
+    else
+      N_VLinearSum(ONE, x, ONE, vtemp, x);
+
+    *zeroguess  = SUNFALSE;
+    LASTFLAG(S) = SUNLS_RES_REDUCED;
+    return(LASTFLAG(S));
+  }
+
+  *zeroguess  = SUNFALSE;
+  LASTFLAG(S) = SUNLS_CONV_FAIL;
+  return(LASTFLAG(S));
+}
+
+
+int SUNLinSolNumIters_SSGMR(SUNLinearSolver S)
+{
+  /* return the stored 'numiters' value */
+  if (S == NULL) return(-1);
+  return (SSGMR_CONTENT(S)->numiters);
+}
+
+
+realtype SUNLinSolResNorm_SSGMR(SUNLinearSolver S)
+{
+  /* return the stored 'resnorm' value */
+  if (S == NULL) return(-ONE);
+  return (SSGMR_CONTENT(S)->resnorm);
+}
+
+
+N_Vector SUNLinSolResid_SSGMR(SUNLinearSolver S)
+{
+  /* return the stored 'vtemp' vector */
+  return (SSGMR_CONTENT(S)->vtemp);
+}
+
+
+sunindextype SUNLinSolLastFlag_SSGMR(SUNLinearSolver S)
+{
+  /* return the stored 'last_flag' value */
+  if (S == NULL) return(-1);
+  return (LASTFLAG(S));
+}
+
+
+int SUNLinSolSpace_SSGMR(SUNLinearSolver S,
+                         long int *lenrwLS,
+                         long int *leniwLS)
+{
+  int maxl, block;
+  sunindextype liw1, lrw1;
+  maxl  = SSGMR_CONTENT(S)->maxl;
+  block = SSGMR_CONTENT(S)->block;
+  if (SSGMR_CONTENT(S)->vtemp->ops->nvspace)
+    N_VSpace(SSGMR_CONTENT(S)->vtemp, &lrw1, &liw1);
+  else
+    lrw1 = liw1 = 0;
+  *lenrwLS = lrw1*(maxl + 3) + 2*maxl*(maxl + 2) + 2*(maxl + 1) + 3
+    + (3*(maxl + 1) + 3*block)*block;
+  *leniwLS = liw1*(maxl + 3);
+  return(SUNLS_SUCCESS);
+}
+
+
+int SUNLinSolFree_SSGMR(SUNLinearSolver S)
+{
+  int k;
+
+  if (S == NULL) return(SUNLS_SUCCESS);
+
+  if (S->content) {
+    /* delete items from within the content structure */
+    if (SSGMR_CONTENT(S)->xcor) {
+      N_VDestroy(SSGMR_CONTENT(S)->xcor);
+      SSGMR_CONTENT(S)->xcor = NULL;
+    }
+    if (SSGMR_CONTENT(S)->vtemp) {
+      N_VDestroy(SSGMR_CONTENT(S)->vtemp);
+      SSGMR_CONTENT(S)->vtemp = NULL;
+    }
+    if (SSGMR_CONTENT(S)->V) {
+      N_VDestroyVectorArray(SSGMR_CONTENT(S)->V,
+                            SSGMR_CONTENT(S)->maxl+1);
+      SSGMR_CONTENT(S)->V = NULL;
+    }
+    if (SSGMR_CONTENT(S)->Hes) {
+      for (k=0; k<=SSGMR_CONTENT(S)->maxl; k++)
+        if (SSGMR_CONTENT(S)->Hes[k]) {
+          free(SSGMR_CONTENT(S)->Hes[k]);
+          SSGMR_CONTENT(S)->Hes[k] = NULL;
+        }
+      free(SSGMR_CONTENT(S)->Hes);
+      SSGMR_CONTENT(S)->Hes = NULL;
+    }
+    if (SSGMR_CONTENT(S)->Hraw) {
+      for (k=0; k<=SSGMR_CONTENT(S)->maxl; k++)
+        if (SSGMR_CONTENT(S)->Hraw[k]) {
+          free(SSGMR_CONTENT(S)->Hraw[k]);
+          SSGMR_CONTENT(S)->Hraw[k] = NULL;
+        }
+      free(SSGMR_CONTENT(S)->Hraw);
+      SSGMR_CONTENT(S)->Hraw = NULL;
+    }
+    if (SSGMR_CONTENT(S)->givens) {
+      free(SSGMR_CONTENT(S)->givens);
+      SSGMR_CONTENT(S)->givens = NULL;
+    }
+    if (SSGMR_CONTENT(S)->yg) {
+      free(SSGMR_CONTENT(S)->yg);
+      SSGMR_CONTENT(S)->yg = NULL;
+    }
+    if (SSGMR_CONTENT(S)->cv) {
+      free(SSGMR_CONTENT(S)->cv);
+      SSGMR_CONTENT(S)->cv = NULL;
+    }
+    if (SSGMR_CONTENT(S)->Xv) {
+      free(SSGMR_CONTENT(S)->Xv);
+      SSGMR_CONTENT(S)->Xv = NULL;
+    }
+    if (SSGMR_CONTENT(S)->work) {
+      free(SSGMR_CONTENT(S)->work);
+      SSGMR_CONTENT(S)->work = NULL;
+    }
+    free(S->content); S->content = NULL;
+  }
+  if (S->ops) { free(S->ops); S->ops = NULL; }
+  free(S); S = NULL;
+  return(SUNLS_SUCCESS);
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Computes y = A-tilde x = s1 P1_inv A P2_inv s2_inv x, using vtemp as
+ * workspace. Returns SUNLS_SUCCESS or the SUNLS flag of a failed
+ * ATimes or Psolve call.
+ */
+
+static int SSGMRApplyOp(SUNLinearSolver S, booleantype preOnLeft,
+                        booleantype preOnRight, realtype delta,
+                        N_Vector x, N_Vector y)
+{
+  int ier;
+  N_Vector vtemp = SSGMR_CONTENT(S)->vtemp;
+  N_Vector s1    = SSGMR_CONTENT(S)->s1;
+  N_Vector s2    = SSGMR_CONTENT(S)->s2;
+  void* P_data   = SSGMR_CONTENT(S)->PData;
+
+  /* Apply right scaling: vtemp = s2_inv x */
+  if (s2 != NULL) N_VDiv(x, s2, vtemp);
+  else N_VScale(ONE, x, vtemp);
+
+  /* Apply right preconditioner: vtemp = P2_inv s2_inv x */
+  if (preOnRight) {
+    N_VScale(ONE, vtemp, y);
+    ier = SSGMR_CONTENT(S)->Psolve(P_data, y, vtemp, delta, SUN_PREC_RIGHT);
+    if (ier != 0)
+      return((ier < 0) ? SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC);
+  }
+
+  /* Apply A: y = A P2_inv s2_inv x */
+  ier = SSGMR_CONTENT(S)->ATimes(SSGMR_CONTENT(S)->ATData, vtemp, y);
+  if (ier != 0)
+    return((ier < 0) ? SUNLS_ATIMES_FAIL_UNREC : SUNLS_ATIMES_FAIL_REC);
+
+  /* Apply left preconditioning: vtemp = P1_inv A P2_inv s2_inv x */
+  if (preOnLeft) {
+    ier = SSGMR_CONTENT(S)->Psolve(P_data, y, vtemp, delta, SUN_PREC_LEFT);
+    if (ier != 0)
+      return((ier < 0) ? SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC);
+  } else {
+    N_VScale(ONE, y, vtemp);
+  }
+
+  /* Apply left scaling: y = s1 P1_inv A P2_inv s2_inv x */
+  if (s1 != NULL) N_VProd(s1, vtemp, y);
+  else N_VScale(ONE, vtemp, y);
+
+  return(SUNLS_SUCCESS);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Computes d[i*ny + k] = X[i] . Y[k] for i < nx and k < ny with a single
+ * global reduction when the vector provides the local and all-reduce
+ * parts of the multiple dot product separately.
+ */
+
+static int SSGMRDots(int nx, N_Vector *X, int ny, N_Vector *Y, realtype *d)
+{
+  int i;
+
+  if ((X[0]->ops->nvdotprodmultilocal != NULL) &&
+      (X[0]->ops->nvdotprodmultiallreduce != NULL)) {
+    for (i=0; i<nx; i++)
+      if (N_VDotProdMultiLocal(ny, X[i], Y, d + i*ny) != 0) return(-1);
+    return(N_VDotProdMultiAllReduce(nx*ny, X[0], d));
+  }
+
+  for (i=0; i<nx; i++)
+    if (N_VDotProdMulti(ny, X[i], Y, d + i*ny) != 0) return(-1);
+  return(0);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * One pass of block classical Gram-Schmidt and Cholesky QR on the block
+ * Z = V[j+1],...,V[j+p] against the orthonormal vectors V[0],...,V[j]:
+ *   C = V(0:j)^T Z,  R^T R = Z^T Z - C^T C,  Z <- (Z - V(0:j) C) R^{-1}.
+ * C is stored with leading dimension ldc and R, G with leading dimension
+ * lds. Since the Gram matrix is obtained from the same reduction as C, a
+ * column whose projected norm is too small relative to its norm cannot
+ * be orthonormalized reliably; the block is truncated before the first
+ * such column. Returns the number of columns kept, or -1 on failure.
+ */
+
+static int SSGMRBlockPass(N_Vector *V, int j, int p, realtype *d,
+                          realtype *C, int ldc, realtype *R, realtype *G,
+                          int lds, realtype *cv, N_Vector *Xv)
+{
+  int i, k, m, ny;
+  realtype sum, tol;
+
+  tol = SUNRsqrt(UNIT_ROUNDOFF);
+  ny  = j + 1 + p;
+
+  /* One reduction for the projections and the Gram matrix */
+  if (SSGMRDots(p, V+j+1, ny, V, d) != 0) return(-1);
+
+  for (i=0; i<p; i++)
+    for (k=0; k<=j; k++)
+      C[k + i*ldc] = d[i*ny + k];
+
+  for (i=0; i<p; i++)
+    for (m=0; m<=i; m++) {
+      sum = d[i*ny + j+1+m];
+      for (k=0; k<=j; k++)
+        sum -= C[k + m*ldc] * C[k + i*ldc];
+      G[m + i*lds] = sum;
+    }
+
+  /* Cholesky factorization G = R^T R */
+  for (i=0; i<p; i++) {
+    for (m=0; m<i; m++) {
+      sum = G[m + i*lds];
+      for (k=0; k<m; k++)
+        sum -= R[k + m*lds] * R[k + i*lds];
+      R[m + i*lds] = sum / R[m + m*lds];
+    }
+    sum = G[i + i*lds];
+    for (k=0; k<i; k++)
+      sum -= R[k + i*lds] * R[k + i*lds];
+    if (sum <= tol * d[i*ny + j+1+i]) { p = i; break; }
+    R[i + i*lds] = SUNRsqrt(sum);
+  }
+
+  /* Z(:,i) <- (Z(:,i) - V(0:j) C(:,i) - sum_{m<i} R(m,i) Q(:,m)) / R(i,i) */
+  for (i=0; i<p; i++) {
+    cv[0] = ONE / R[i + i*lds];
+    Xv[0] = V[j+1+i];
+    for (k=0; k<=j; k++) {
+      cv[k+1] = -C[k + i*ldc] * cv[0];
+      Xv[k+1] = V[k];
+    }
+    for (m=0; m<i; m++) {
+      cv[j+2+m] = -R[m + i*lds] / R[i + i*lds];
+      Xv[j+2+m] = V[j+1+m];
+    }
+    if (N_VLinearCombination(j+2+i, cv, Xv, V[j+1+i]) != 0) return(-1);
+  }
+
+  return(p);
+}
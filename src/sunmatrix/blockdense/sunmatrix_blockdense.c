@@ -0,0 +1,449 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the block-diagonal dense
+ * implementation of the SUNMATRIX package.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>
+#include <sunmatrix/sunmatrix_blockdense.h>
+
+#include "sunmatrix_blockdense_impl.h"
+
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+
+/* Private function prototypes */
+static booleantype compatibleMatrixAndVectors(SUNMatrix A, N_Vector x, N_Vector y);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new block-diagonal dense matrix
+ */
+
+SUNMatrix SUNBlockDenseMatrix(sunindextype nblocks, sunindextype M,
+                              sunindextype N, SUNContext sunctx)
+{
+  SUNMatrix A;
+  SUNMatrixContent_BlockDense content;
+
+  /* return with NULL matrix on illegal dimension input */
+  if ((nblocks <= 0) || (M <= 0) || (N <= 0))
+    return (NULL);
+
+  /* Create an empty matrix object */
+  A = NULL;
+  A = SUNMatNewEmpty(sunctx);
+  if (A == NULL)
+    return (NULL);
+
+  /* Attach operations */
+  A->ops->getid     = SUNMatGetID_BlockDense;
+  A->ops->clone     = SUNMatClone_BlockDense;
+  A->ops->destroy   = SUNMatDestroy_BlockDense;
+  A->ops->zero      = SUNMatZero_BlockDense;
+  A->ops->copy      = SUNMatCopy_BlockDense;
+  A->ops->scaleadd  = SUNMatScaleAdd_BlockDense;
+  A->ops->scaleaddi = SUNMatScaleAddI_BlockDense;
+  A->ops->matvec    = SUNMatMatvec_BlockDense;
+  A->ops->space     = SUNMatSpace_BlockDense;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNMatrixContent_BlockDense)malloc(sizeof *content);
+  if (content == NULL) {
+    SUNMatDestroy(A);
+    return (NULL);
+  }
+
+  /* Attach content */
+  A->content = content;
+
+  /* Fill content, the last group is padded to a full group */
+  content->M       = M;
+  content->N       = N;
+  content->nblocks = nblocks;
+  content->npacks  = (nblocks + SUNBLOCKDENSE_PACK - 1) / SUNBLOCKDENSE_PACK;
+  content->ldata   = content->npacks * SUNBLOCKDENSE_PACK * M * N;
+  content->data    = NULL;
+  content->num_threads = 1;
+
+  /* Allocate content */
+  content->data = (realtype*)calloc(content->ldata, sizeof(realtype));
+  if (content->data == NULL) {
+    SUNMatDestroy(A);
+    return (NULL);
+  }
+
+  return (A);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to print the block-diagonal dense matrix
+ */
+
+void SUNBlockDenseMatrix_Print(SUNMatrix A, FILE* outfile)
+{
+  sunindextype i, j, k;
+
+  /* should not be called unless A is a block-diagonal dense matrix;
+     otherwise return immediately */
+  if (SUNMatGetID(A) != SUNMATRIX_BLOCKDENSE)
+    return;
+
+  /* perform operation */
+  fprintf(outfile, "\n");
+  for (k = 0; k < SM_NBLOCKS_BD(A); k++) {
+    fprintf(outfile, "block %ld:\n", (long int) k);
+    for (i = 0; i < SM_BLOCKROWS_BD(A); i++) {
+      for (j = 0; j < SM_BLOCKCOLUMNS_BD(A); j++) {
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+        fprintf(outfile, "%12Lg  ", SM_ELEMENT_BD(A, k, i, j));
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+        fprintf(outfile, "%12g  ", SM_ELEMENT_BD(A, k, i, j));
+#else
+        fprintf(outfile, "%12g  ", SM_ELEMENT_BD(A, k, i, j));
+#endif
+      }
+      fprintf(outfile, "\n");
+    }
+    fprintf(outfile, "\n");
+  }
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to access the contents of the block-diagonal dense matrix
+ * structure
+ */
+
+sunindextype SUNBlockDenseMatrix_Rows(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BLOCKDENSE)
+    return SM_NBLOCKS_BD(A) * SM_BLOCKROWS_BD(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNBlockDenseMatrix_Columns(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BLOCKDENSE)
+    return SM_NBLOCKS_BD(A) * SM_BLOCKCOLUMNS_BD(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNBlockDenseMatrix_BlockRows(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BLOCKDENSE)
+    return SM_BLOCKROWS_BD(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNBlockDenseMatrix_BlockColumns(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BLOCKDENSE)
+    return SM_BLOCKCOLUMNS_BD(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNBlockDenseMatrix_NumBlocks(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BLOCKDENSE)
+    return SM_NBLOCKS_BD(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNBlockDenseMatrix_LData(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BLOCKDENSE)
+    return SM_LDATA_BD(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+realtype* SUNBlockDenseMatrix_Data(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BLOCKDENSE)
+    return SM_DATA_BD(A);
+  else
+    return NULL;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of matrix operations
+ * -----------------------------------------------------------------
+ */
+
+SUNMatrix_ID SUNMatGetID_BlockDense(SUNMatrix A) { return SUNMATRIX_BLOCKDENSE; }
+
+SUNMatrix SUNMatClone_BlockDense(SUNMatrix A)
+{
+  SUNMatrix B = SUNBlockDenseMatrix(SM_NBLOCKS_BD(A), SM_BLOCKROWS_BD(A),
+                                    SM_BLOCKCOLUMNS_BD(A), A->sunctx);
+  if (B == NULL) return (NULL);
+
+  /* use the same threads (see SUNBlockDenseMatrix_SetNumThreads) */
+  SM_NUM_THREADS_BD(B) = SM_NUM_THREADS_BD(A);
+  B->ops->zero      = A->ops->zero;
+  B->ops->copy      = A->ops->copy;
+  B->ops->scaleadd  = A->ops->scaleadd;
+  B->ops->scaleaddi = A->ops->scaleaddi;
+  B->ops->matvec    = A->ops->matvec;
+
+  return (B);
+}
+
+void SUNMatDestroy_BlockDense(SUNMatrix A)
+{
+  if (A == NULL)
+    return;
+
+  /* free content */
+  if (A->content != NULL) {
+    /* free data array */
+    if (SM_DATA_BD(A) != NULL) {
+      free(SM_DATA_BD(A));
+      SM_DATA_BD(A) = NULL;
+    }
+    /* free content struct */
+    free(A->content);
+    A->content = NULL;
+  }
+
+  /* free ops and matrix */
+  if (A->ops) {
+    free(A->ops);
+    A->ops = NULL;
+  }
+  free(A);
+  A = NULL;
+
+  return;
+}
+
+int SUNMatZero_BlockDense(SUNMatrix A)
+{
+  SMZeroPacks_BD(A, 0, SM_NPACKS_BD(A));
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatCopy_BlockDense(SUNMatrix A, SUNMatrix B)
+{
+  if (!SMCompatibleMatrices_BD(A, B))
+    return SUNMAT_ILL_INPUT;
+
+  SMCopyPacks_BD(A, B, 0, SM_NPACKS_BD(A));
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatScaleAddI_BlockDense(realtype c, SUNMatrix A)
+{
+  SMScaleAddIPacks_BD(c, A, 0, SM_NPACKS_BD(A));
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatScaleAdd_BlockDense(realtype c, SUNMatrix A, SUNMatrix B)
+{
+  if (!SMCompatibleMatrices_BD(A, B))
+    return SUNMAT_ILL_INPUT;
+
+  SMScaleAddPacks_BD(c, A, B, 0, SM_NPACKS_BD(A));
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatMatvec_BlockDense(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int retval;
+  realtype *xd, *yd;
+
+  retval = SMMatvecSetup_BD(A, x, y, &xd, &yd);
+  if (retval != SUNMAT_SUCCESS) return retval;
+
+  SMMatvecPacks_BD(A, xd, yd, 0, SM_NPACKS_BD(A));
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatSpace_BlockDense(SUNMatrix A, long int* lenrw, long int* leniw)
+{
+  *lenrw = SM_LDATA_BD(A);
+  *leniw = 5;
+  return SUNMAT_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Input checks shared with the threaded operations of
+ * sunmatrix_blockdense_threads.c
+ */
+
+booleantype SMCompatibleMatrices_BD(SUNMatrix A, SUNMatrix B)
+{
+  /* both matrices must be SUNMATRIX_BLOCKDENSE */
+  if ((SUNMatGetID(A) != SUNMATRIX_BLOCKDENSE) ||
+      (SUNMatGetID(B) != SUNMATRIX_BLOCKDENSE)) {
+    return SUNFALSE;
+  }
+
+  /* both matrices must have the same number and shape of blocks */
+  if ((SM_NBLOCKS_BD(A) != SM_NBLOCKS_BD(B)) ||
+      (SM_BLOCKROWS_BD(A) != SM_BLOCKROWS_BD(B)) ||
+      (SM_BLOCKCOLUMNS_BD(A) != SM_BLOCKCOLUMNS_BD(B))) {
+    return SUNFALSE;
+  }
+
+  return SUNTRUE;
+}
+
+int SMMatvecSetup_BD(SUNMatrix A, N_Vector x, N_Vector y, realtype **xd,
+                     realtype **yd)
+{
+  if (!compatibleMatrixAndVectors(A, x, y))
+    return SUNMAT_ILL_INPUT;
+
+  /* access vector data (return if NULL data pointers) */
+  *xd = N_VGetArrayPointer(x);
+  *yd = N_VGetArrayPointer(y);
+  if ((*xd == NULL) || (*yd == NULL) || (*xd == *yd))
+    return SUNMAT_MEM_FAIL;
+
+  return SUNMAT_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Operations on the groups of blocks start to end-1, the groups are
+ * independent so that the threaded operations split them among the threads
+ */
+
+void SMZeroPacks_BD(SUNMatrix A, sunindextype start, sunindextype end)
+{
+  sunindextype i, len;
+  realtype *Adata;
+
+  /* Perform operation A_ij = 0 */
+  len   = SM_BLOCKROWS_BD(A) * SM_BLOCKCOLUMNS_BD(A) * SUNBLOCKDENSE_PACK;
+  Adata = SM_DATA_BD(A);
+  for (i = start * len; i < end * len; i++)
+    Adata[i] = ZERO;
+}
+
+void SMCopyPacks_BD(SUNMatrix A, SUNMatrix B, sunindextype start,
+                    sunindextype end)
+{
+  sunindextype i, len;
+  realtype *Adata, *Bdata;
+
+  /* Perform operation B_ij = A_ij */
+  len   = SM_BLOCKROWS_BD(A) * SM_BLOCKCOLUMNS_BD(A) * SUNBLOCKDENSE_PACK;
+  Adata = SM_DATA_BD(A);
+  Bdata = SM_DATA_BD(B);
+  for (i = start * len; i < end * len; i++)
+    Bdata[i] = Adata[i];
+}
+
+void SMScaleAddPacks_BD(realtype c, SUNMatrix A, SUNMatrix B,
+                        sunindextype start, sunindextype end)
+{
+  sunindextype i, len;
+  realtype *Adata, *Bdata;
+
+  /* Perform operation A = c*A + B */
+  len   = SM_BLOCKROWS_BD(A) * SM_BLOCKCOLUMNS_BD(A) * SUNBLOCKDENSE_PACK;
+  Adata = SM_DATA_BD(A);
+  Bdata = SM_DATA_BD(B);
+  for (i = start * len; i < end * len; i++)
+    Adata[i] = c * Adata[i] + Bdata[i];
+}
+
+void SMScaleAddIPacks_BD(realtype c, SUNMatrix A, sunindextype start,
+                         sunindextype end)
+{
+  sunindextype i, l, p, M, N, nblocks, nlanes;
+  realtype *Ap;
+
+  M       = SM_BLOCKROWS_BD(A);
+  N       = SM_BLOCKCOLUMNS_BD(A);
+  nblocks = SM_NBLOCKS_BD(A);
+
+  /* Perform operation A = c*A + I on every group of blocks, the padding
+     blocks of the last group are left zero */
+  for (p = start; p < end; p++) {
+    Ap     = SM_DATA_BD(A) + p * M * N * SUNBLOCKDENSE_PACK;
+    nlanes = SUNMIN(SUNBLOCKDENSE_PACK, nblocks - p * SUNBLOCKDENSE_PACK);
+    for (i = 0; i < M * N * SUNBLOCKDENSE_PACK; i++)
+      Ap[i] *= c;
+    for (i = 0; i < SUNMIN(M, N); i++)
+      for (l = 0; l < nlanes; l++)
+        Ap[(i * M + i) * SUNBLOCKDENSE_PACK + l] += ONE;
+  }
+}
+
+void SMMatvecPacks_BD(SUNMatrix A, const realtype *xd, realtype *yd,
+                      sunindextype start, sunindextype end)
+{
+  sunindextype i, j, k, l, p, M, N, nblocks;
+  const realtype *Aj, *xk;
+  realtype *yk;
+
+  M       = SM_BLOCKROWS_BD(A);
+  N       = SM_BLOCKCOLUMNS_BD(A);
+  nblocks = SM_NBLOCKS_BD(A);
+
+  /* Perform operation y_k = A_k x_k where block k of the vectors x and y
+     holds entries k*N, ..., k*N+N-1 and k*M, ..., k*M+M-1 respectively */
+  for (p = start; p < end; p++) {
+    for (l = 0; l < SUNBLOCKDENSE_PACK; l++) {
+      k = p * SUNBLOCKDENSE_PACK + l;
+      if (k >= nblocks) break;
+      xk = xd + k * N;
+      yk = yd + k * M;
+      for (i = 0; i < M; i++)
+        yk[i] = ZERO;
+      for (j = 0; j < N; j++) {
+        Aj = SM_DATA_BD(A) + ((p * N + j) * M) * SUNBLOCKDENSE_PACK + l;
+        for (i = 0; i < M; i++)
+          yk[i] += Aj[i * SUNBLOCKDENSE_PACK] * xk[j];
+      }
+    }
+  }
+}
+
+static booleantype compatibleMatrixAndVectors(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  /* Vectors must provide nvgetarraypointer and cannot be a parallel vector */
+  if (!x->ops->nvgetarraypointer || !y->ops->nvgetarraypointer) {
+    return SUNFALSE;
+  }
+
+  /* Check that the dimensions agree */
+  if ((N_VGetLength(x) != SUNBlockDenseMatrix_Columns(A)) ||
+      (N_VGetLength(y) != SUNBlockDenseMatrix_Rows(A))) {
+    return SUNFALSE;
+  }
+
+  return SUNTRUE;
+}
@@ -0,0 +1,53 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Private functions of the block-diagonal dense SUNMATRIX used by
+ * the threaded operations in sunmatrix_blockdense_threads.c.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNMATRIX_BLOCKDENSE_IMPL_H
+#define _SUNMATRIX_BLOCKDENSE_IMPL_H
+
+#include <sunmatrix/sunmatrix_blockdense.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Checks that A and B have the same number and shape of blocks */
+booleantype SMCompatibleMatrices_BD(SUNMatrix A, SUNMatrix B);
+
+/* Checks the inputs of y = A x and returns the vector data */
+int SMMatvecSetup_BD(SUNMatrix A, N_Vector x, N_Vector y, realtype **xd,
+                     realtype **yd);
+
+/* Operations on the groups of blocks start to end-1 */
+void SMZeroPacks_BD(SUNMatrix A, sunindextype start, sunindextype end);
+
+void SMCopyPacks_BD(SUNMatrix A, SUNMatrix B, sunindextype start,
+                    sunindextype end);
+
+void SMScaleAddPacks_BD(realtype c, SUNMatrix A, SUNMatrix B,
+                        sunindextype start, sunindextype end);
+
+void SMScaleAddIPacks_BD(realtype c, SUNMatrix A, sunindextype start,
+                         sunindextype end);
+
+void SMMatvecPacks_BD(SUNMatrix A, const realtype *xd, realtype *yd,
+                      sunindextype start, sunindextype end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
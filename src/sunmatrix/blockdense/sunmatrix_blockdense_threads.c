@@ -0,0 +1,152 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the OpenMP threaded
+ * operations of the block-diagonal dense SUNMATRIX. Like the BSR
+ * matrix threads, it is only part of the SUNMATRIX_BLOCKDENSE
+ * library.
+ * -----------------------------------------------------------------
+ */
+
+#include <sunmatrix/sunmatrix_blockdense.h>
+
+#include "sunmatrix_blockdense_impl.h"
+
+#if defined(_OPENMP)
+
+/* first group of blocks of thread t out of nt */
+#define PACK_START(A,t,nt) ( (SM_NPACKS_BD(A) * (t)) / (nt) )
+
+/* -----------------------------------------------------------------
+ * Number of threads used with A, at most one per group of blocks
+ */
+static int numThreads(SUNMatrix A)
+{
+  int nt = SM_NUM_THREADS_BD(A);
+  if (nt > SM_NPACKS_BD(A)) nt = (int) SM_NPACKS_BD(A);
+  return nt;
+}
+
+/* -----------------------------------------------------------------
+ * Matrix operations with the groups of blocks divided evenly among
+ * the threads of the matrix
+ */
+
+static int SUNMatZero_BlockDenseThreads(SUNMatrix A)
+{
+  int t, nt = numThreads(A);
+
+#pragma omp parallel for num_threads(nt) schedule(static)
+  for (t=0; t<nt; t++)
+    SMZeroPacks_BD(A, PACK_START(A, t, nt), PACK_START(A, t + 1, nt));
+
+  return SUNMAT_SUCCESS;
+}
+
+static int SUNMatCopy_BlockDenseThreads(SUNMatrix A, SUNMatrix B)
+{
+  int t, nt;
+
+  if (!SMCompatibleMatrices_BD(A, B))
+    return SUNMAT_ILL_INPUT;
+
+  nt = numThreads(A);
+
+#pragma omp parallel for num_threads(nt) schedule(static)
+  for (t=0; t<nt; t++)
+    SMCopyPacks_BD(A, B, PACK_START(A, t, nt), PACK_START(A, t + 1, nt));
+
+  return SUNMAT_SUCCESS;
+}
+
+static int SUNMatScaleAdd_BlockDenseThreads(realtype c, SUNMatrix A,
+                                            SUNMatrix B)
+{
+  int t, nt;
+
+  if (!SMCompatibleMatrices_BD(A, B))
+    return SUNMAT_ILL_INPUT;
+
+  nt = numThreads(A);
+
+#pragma omp parallel for num_threads(nt) schedule(static)
+  for (t=0; t<nt; t++)
+    SMScaleAddPacks_BD(c, A, B, PACK_START(A, t, nt),
+                       PACK_START(A, t + 1, nt));
+
+  return SUNMAT_SUCCESS;
+}
+
+static int SUNMatScaleAddI_BlockDenseThreads(realtype c, SUNMatrix A)
+{
+  int t, nt = numThreads(A);
+
+#pragma omp parallel for num_threads(nt) schedule(static)
+  for (t=0; t<nt; t++)
+    SMScaleAddIPacks_BD(c, A, PACK_START(A, t, nt), PACK_START(A, t + 1, nt));
+
+  return SUNMAT_SUCCESS;
+}
+
+static int SUNMatMatvec_BlockDenseThreads(SUNMatrix A, N_Vector x,
+                                          N_Vector y)
+{
+  int retval, t, nt;
+  realtype *xd, *yd;
+
+  retval = SMMatvecSetup_BD(A, x, y, &xd, &yd);
+  if (retval != SUNMAT_SUCCESS) return retval;
+
+  nt = numThreads(A);
+
+#pragma omp parallel for num_threads(nt) schedule(static)
+  for (t=0; t<nt; t++)
+    SMMatvecPacks_BD(A, xd, yd, PACK_START(A, t, nt),
+                     PACK_START(A, t + 1, nt));
+
+  return SUNMAT_SUCCESS;
+}
+
+#endif
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of OpenMP threads used by the matrix
+ * operations. Without OpenMP the operations are always performed by the
+ * calling thread.
+ */
+
+int SUNBlockDenseMatrix_SetNumThreads(SUNMatrix A, int num_threads)
+{
+  /* check for valid inputs */
+  if (A == NULL || SUNMatGetID(A) != SUNMATRIX_BLOCKDENSE || num_threads < 1)
+    return SUNMAT_ILL_INPUT;
+
+  SM_NUM_THREADS_BD(A) = num_threads;
+
+#if defined(_OPENMP)
+  if (num_threads > 1) {
+    A->ops->zero      = SUNMatZero_BlockDenseThreads;
+    A->ops->copy      = SUNMatCopy_BlockDenseThreads;
+    A->ops->scaleadd  = SUNMatScaleAdd_BlockDenseThreads;
+    A->ops->scaleaddi = SUNMatScaleAddI_BlockDenseThreads;
+    A->ops->matvec    = SUNMatMatvec_BlockDenseThreads;
+  } else {
+    A->ops->zero      = SUNMatZero_BlockDense;
+    A->ops->copy      = SUNMatCopy_BlockDense;
+    A->ops->scaleadd  = SUNMatScaleAdd_BlockDense;
+    A->ops->scaleaddi = SUNMatScaleAddI_BlockDense;
+    A->ops->matvec    = SUNMatMatvec_BlockDense;
+  }
+#endif
+
+  return SUNMAT_SUCCESS;
+}
@@ -0,0 +1,1029 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the block compressed sparse
+ * row (BSR) implementation of the SUNMATRIX package.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sundials/sundials_math.h>
+#include <sunmatrix/sunmatrix_bsr.h>
+
+#include "sunmatrix_bsr_impl.h"
+
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+
+/* Largest block size with a matrix-vector product kernel specialized for it */
+#define BSR_MAX_UNROLL 8
+
+/* Private function prototypes */
+static booleantype compatibleMatrices(SUNMatrix A, SUNMatrix B);
+static booleantype compatibleMatrixAndVectors(SUNMatrix A, N_Vector x, N_Vector y);
+static booleantype samePattern(SUNMatrix A, SUNMatrix B);
+static int mergePatterns(realtype c, SUNMatrix A, SUNMatrix B);
+static int compareIndices(const void *a, const void *b);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new BSR matrix with MB by NB blocks of size bs and room
+ * for NNZB blocks
+ */
+
+SUNMatrix SUNBSRMatrix(sunindextype MB, sunindextype NB, sunindextype bs,
+                       sunindextype NNZB, SUNContext sunctx)
+{
+  SUNMatrix A;
+  SUNMatrixContent_BSR content;
+
+  /* return with NULL matrix on illegal input */
+  if ((MB <= 0) || (NB <= 0) || (bs <= 0) || (NNZB < 0))
+    return (NULL);
+
+  /* Create an empty matrix object */
+  A = NULL;
+  A = SUNMatNewEmpty(sunctx);
+  if (A == NULL)
+    return (NULL);
+
+  /* Attach operations */
+  A->ops->getid     = SUNMatGetID_BSR;
+  A->ops->clone     = SUNMatClone_BSR;
+  A->ops->destroy   = SUNMatDestroy_BSR;
+  A->ops->zero      = SUNMatZero_BSR;
+  A->ops->copy      = SUNMatCopy_BSR;
+  A->ops->scaleadd  = SUNMatScaleAdd_BSR;
+  A->ops->scaleaddi = SUNMatScaleAddI_BSR;
+  A->ops->matvec    = SUNMatMatvec_BSR;
+  A->ops->space     = SUNMatSpace_BSR;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNMatrixContent_BSR)malloc(sizeof *content);
+  if (content == NULL) {
+    SUNMatDestroy(A);
+    return (NULL);
+  }
+
+  /* Attach content */
+  A->content = content;
+
+  /* Fill content */
+  content->MB        = MB;
+  content->NB        = NB;
+  content->bs        = bs;
+  content->NNZB      = NNZB;
+  content->data      = NULL;
+  content->indexvals = NULL;
+  content->indexptrs = NULL;
+  content->num_threads = 1;
+
+  /* Allocate content */
+  content->data = (realtype*)calloc(SUNMAX(NNZB * bs * bs, 1), sizeof(realtype));
+  content->indexvals = (sunindextype*)calloc(SUNMAX(NNZB, 1), sizeof(sunindextype));
+  content->indexptrs = (sunindextype*)calloc(MB + 1, sizeof(sunindextype));
+  if ((content->data == NULL) || (content->indexvals == NULL) ||
+      (content->indexptrs == NULL)) {
+    SUNMatDestroy(A);
+    return (NULL);
+  }
+
+  return (A);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new BSR matrix from a sparse matrix. Every bs by bs
+ * block of A that contains a stored entry becomes a block of the new matrix.
+ * The numbers of rows and columns of A must be multiples of bs.
+ */
+
+SUNMatrix SUNBSRFromSparseMatrix(SUNMatrix A, sunindextype bs)
+{
+  sunindextype MB, NB, I, J, r, p, q, k, nnzb;
+  sunindextype *Sp, *Sj, *marker, *pos, *Bp, *Bj;
+  realtype *Sx;
+  SUNMatrix As, B;
+
+  /* check for legal input */
+  if ((A == NULL) || (SUNMatGetID(A) != SUNMATRIX_SPARSE) || (bs <= 0))
+    return (NULL);
+  if ((SM_ROWS_S(A) % bs != 0) || (SM_COLUMNS_S(A) % bs != 0))
+    return (NULL);
+
+  /* work with the rows of A */
+  As = A;
+  if (SM_SPARSETYPE_S(A) == CSC_MAT)
+    if (SUNSparseMatrix_ToCSR(A, &As) != SUNMAT_SUCCESS)
+      return (NULL);
+
+  MB = SM_ROWS_S(As) / bs;
+  NB = SM_COLUMNS_S(As) / bs;
+  Sp = SM_INDEXPTRS_S(As);
+  Sj = SM_INDEXVALS_S(As);
+  Sx = SM_DATA_S(As);
+
+  marker = (sunindextype*)malloc(2 * NB * sizeof(sunindextype));
+  if (marker == NULL) {
+    if (As != A) SUNMatDestroy(As);
+    return (NULL);
+  }
+  pos = marker + NB;
+
+  /* count the blocks */
+  nnzb = 0;
+  for (J = 0; J < NB; J++)
+    marker[J] = -1;
+  for (I = 0; I < MB; I++) {
+    for (r = I * bs; r < (I + 1) * bs; r++) {
+      for (p = Sp[r]; p < Sp[r + 1]; p++) {
+        J = Sj[p] / bs;
+        if (marker[J] != I) {
+          marker[J] = I;
+          nnzb++;
+        }
+      }
+    }
+  }
+
+  B = SUNBSRMatrix(MB, NB, bs, nnzb, A->sunctx);
+  if (B == NULL) {
+    free(marker);
+    if (As != A) SUNMatDestroy(As);
+    return (NULL);
+  }
+  Bp = SM_INDEXPTRS_BSR(B);
+  Bj = SM_INDEXVALS_BSR(B);
+
+  /* collect and sort the block columns of each block row, then copy the
+     entries into their blocks */
+  k = 0;
+  for (J = 0; J < NB; J++)
+    marker[J] = -1;
+  for (I = 0; I < MB; I++) {
+    Bp[I] = k;
+    for (r = I * bs; r < (I + 1) * bs; r++) {
+      for (p = Sp[r]; p < Sp[r + 1]; p++) {
+        J = Sj[p] / bs;
+        if (marker[J] != I) {
+          marker[J] = I;
+          Bj[k++]   = J;
+        }
+      }
+    }
+    qsort(Bj + Bp[I], k - Bp[I], sizeof(sunindextype), compareIndices);
+    for (q = Bp[I]; q < k; q++)
+      pos[Bj[q]] = q;
+    for (r = I * bs; r < (I + 1) * bs; r++) {
+      for (p = Sp[r]; p < Sp[r + 1]; p++) {
+        J = Sj[p] / bs;
+        SM_BLOCK_ELEMENT_BSR(B, pos[J], r - I * bs, Sj[p] - J * bs) += Sx[p];
+      }
+    }
+  }
+  Bp[MB] = k;
+
+  free(marker);
+  if (As != A) SUNMatDestroy(As);
+
+  return (B);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new sparse matrix of type sparsetype (CSC_MAT or
+ * CSR_MAT) holding every entry of the blocks of A
+ */
+
+int SUNBSRMatrix_ToSparse(SUNMatrix A, int sparsetype, SUNMatrix *Bout)
+{
+  sunindextype bs;
+
+  if ((A == NULL) || (Bout == NULL) || (SUNMatGetID(A) != SUNMATRIX_BSR))
+    return SUNMAT_ILL_INPUT;
+  if ((sparsetype != CSC_MAT) && (sparsetype != CSR_MAT))
+    return SUNMAT_ILL_INPUT;
+
+  bs    = SM_BLOCKSIZE_BSR(A);
+  *Bout = SUNSparseMatrix(SM_BLOCKROWS_BSR(A) * bs, SM_BLOCKCOLS_BSR(A) * bs,
+                          SUNMAX(SM_INDEXPTRS_BSR(A)[SM_BLOCKROWS_BSR(A)] * bs * bs, 1),
+                          sparsetype, A->sunctx);
+  if (*Bout == NULL)
+    return SUNMAT_MEM_FAIL;
+
+  return SUNBSRMatrix_CopyToSparse(A, *Bout);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to copy the entries of the blocks of A into the sparse matrix B,
+ * reallocating B if needed. The index arrays of B are only rewritten where
+ * they differ from the block pattern of A, and SUNSparseMatrix_PatternChanged
+ * returns SUNTRUE for B afterwards if they did, so a linear solver can keep
+ * the symbolic factorization of B while the pattern of A is unchanged.
+ */
+
+int SUNBSRMatrix_CopyToSparse(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype MB, NB, bs, nnzb, nnz, I, J, i, j, k, p, q;
+  sunindextype *Ap, *Aj, *Bp, *Bi, *Tp, *Tk;
+  realtype *Bx;
+  booleantype changed;
+
+  if ((A == NULL) || (B == NULL) || (SUNMatGetID(A) != SUNMATRIX_BSR) ||
+      (SUNMatGetID(B) != SUNMATRIX_SPARSE))
+    return SUNMAT_ILL_INPUT;
+  if ((SM_ROWS_S(B) != SUNBSRMatrix_Rows(A)) ||
+      (SM_COLUMNS_S(B) != SUNBSRMatrix_Columns(A)))
+    return SUNMAT_ILL_INPUT;
+
+  MB   = SM_BLOCKROWS_BSR(A);
+  NB   = SM_BLOCKCOLS_BSR(A);
+  bs   = SM_BLOCKSIZE_BSR(A);
+  Ap   = SM_INDEXPTRS_BSR(A);
+  Aj   = SM_INDEXVALS_BSR(A);
+  nnzb = Ap[MB];
+  nnz  = nnzb * bs * bs;
+
+  changed = SUNFALSE;
+  if (SM_NNZ_S(B) < nnz) {
+    if (SUNSparseMatrix_Reallocate(B, nnz) != SUNMAT_SUCCESS)
+      return SUNMAT_MEM_FAIL;
+    changed = SUNTRUE;
+  }
+  Bp = SM_INDEXPTRS_S(B);
+  Bi = SM_INDEXVALS_S(B);
+  Bx = SM_DATA_S(B);
+
+  p = 0;
+  if (SM_SPARSETYPE_S(B) == CSR_MAT) {
+
+    /* row i of block row I holds row i of each block of I */
+    for (I = 0; I < MB; I++) {
+      for (i = 0; i < bs; i++) {
+        changed = changed || (Bp[I * bs + i] != p);
+        Bp[I * bs + i] = p;
+        for (k = Ap[I]; k < Ap[I + 1]; k++) {
+          for (j = 0; j < bs; j++) {
+            changed = changed || (Bi[p] != Aj[k] * bs + j);
+            Bi[p]   = Aj[k] * bs + j;
+            Bx[p++] = SM_BLOCK_ELEMENT_BSR(A, k, i, j);
+          }
+        }
+      }
+    }
+
+  } else {
+
+    /* list the blocks of each block column, in order of their block rows */
+    Tp = (sunindextype*)calloc(NB + 1 + 2 * SUNMAX(nnzb, 1), sizeof(sunindextype));
+    if (Tp == NULL) return SUNMAT_MEM_FAIL;
+    Tk = Tp + NB + 1;
+
+    for (k = 0; k < nnzb; k++)
+      Tp[Aj[k] + 1]++;
+    for (J = 0; J < NB; J++)
+      Tp[J + 1] += Tp[J];
+    for (I = 0; I < MB; I++) {
+      for (k = Ap[I]; k < Ap[I + 1]; k++) {
+        q = Tp[Aj[k]]++;
+        Tk[2 * q]     = k;
+        Tk[2 * q + 1] = I;
+      }
+    }
+    for (J = NB; J > 0; J--)
+      Tp[J] = Tp[J - 1];
+    Tp[0] = 0;
+
+    /* column j of block column J holds column j of each block of J */
+    for (J = 0; J < NB; J++) {
+      for (j = 0; j < bs; j++) {
+        changed = changed || (Bp[J * bs + j] != p);
+        Bp[J * bs + j] = p;
+        for (q = Tp[J]; q < Tp[J + 1]; q++) {
+          k = Tk[2 * q];
+          I = Tk[2 * q + 1];
+          for (i = 0; i < bs; i++) {
+            changed = changed || (Bi[p] != I * bs + i);
+            Bi[p]   = I * bs + i;
+            Bx[p++] = SM_BLOCK_ELEMENT_BSR(A, k, i, j);
+          }
+        }
+      }
+    }
+
+    free(Tp);
+  }
+
+  changed = changed || (Bp[SM_NP_S(B)] != p);
+  Bp[SM_NP_S(B)] = p;
+
+  SM_CONTENT_S(B)->pattern_changed = changed;
+
+  return SUNMAT_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to reallocate internal BSR matrix storage arrays so that the
+ * resulting BSR matrix has storage for a specified number of blocks
+ */
+
+int SUNBSRMatrix_Reallocate(SUNMatrix A, sunindextype NNZB)
+{
+  sunindextype bs;
+
+  /* check for valid matrix type */
+  if (SUNMatGetID(A) != SUNMATRIX_BSR)
+    return SUNMAT_ILL_INPUT;
+
+  /* check for valid size, the stored blocks must fit */
+  if ((NNZB < 0) || (NNZB < SM_INDEXPTRS_BSR(A)[SM_BLOCKROWS_BSR(A)]))
+    return SUNMAT_ILL_INPUT;
+
+  bs = SM_BLOCKSIZE_BSR(A);
+
+  /* perform reallocation */
+  SM_INDEXVALS_BSR(A) = (sunindextype*)realloc(SM_INDEXVALS_BSR(A),
+                                               SUNMAX(NNZB, 1) * sizeof(sunindextype));
+  SM_DATA_BSR(A) = (realtype*)realloc(SM_DATA_BSR(A),
+                                      SUNMAX(NNZB * bs * bs, 1) * sizeof(realtype));
+  SM_NNZB_BSR(A) = NNZB;
+
+  if ((SM_INDEXVALS_BSR(A) == NULL) || (SM_DATA_BSR(A) == NULL))
+    return SUNMAT_MEM_FAIL;
+
+  return SUNMAT_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to print the BSR matrix
+ */
+
+void SUNBSRMatrix_Print(SUNMatrix A, FILE* outfile)
+{
+  sunindextype I, i, j, k;
+
+  /* should not be called unless A is a BSR matrix;
+     otherwise return immediately */
+  if (SUNMatGetID(A) != SUNMATRIX_BSR)
+    return;
+
+  /* perform operation */
+  fprintf(outfile, "\n");
+  for (I = 0; I < SM_BLOCKROWS_BSR(A); I++) {
+    for (k = SM_INDEXPTRS_BSR(A)[I]; k < SM_INDEXPTRS_BSR(A)[I + 1]; k++) {
+      fprintf(outfile, "block (%ld, %ld):\n", (long int) I,
+              (long int) SM_INDEXVALS_BSR(A)[k]);
+      for (i = 0; i < SM_BLOCKSIZE_BSR(A); i++) {
+        for (j = 0; j < SM_BLOCKSIZE_BSR(A); j++) {
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+          fprintf(outfile, "%12Lg  ", SM_BLOCK_ELEMENT_BSR(A, k, i, j));
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+          fprintf(outfile, "%12g  ", SM_BLOCK_ELEMENT_BSR(A, k, i, j));
+#else
+          fprintf(outfile, "%12g  ", SM_BLOCK_ELEMENT_BSR(A, k, i, j));
+#endif
+        }
+        fprintf(outfile, "\n");
+      }
+    }
+  }
+  fprintf(outfile, "\n");
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to access the contents of the BSR matrix structure
+ */
+
+sunindextype SUNBSRMatrix_Rows(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BSR)
+    return SM_BLOCKROWS_BSR(A) * SM_BLOCKSIZE_BSR(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNBSRMatrix_Columns(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BSR)
+    return SM_BLOCKCOLS_BSR(A) * SM_BLOCKSIZE_BSR(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNBSRMatrix_BlockRows(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BSR)
+    return SM_BLOCKROWS_BSR(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNBSRMatrix_BlockColumns(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BSR)
+    return SM_BLOCKCOLS_BSR(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNBSRMatrix_BlockSize(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BSR)
+    return SM_BLOCKSIZE_BSR(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNBSRMatrix_NNZB(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BSR)
+    return SM_NNZB_BSR(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+realtype* SUNBSRMatrix_Data(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BSR)
+    return SM_DATA_BSR(A);
+  else
+    return NULL;
+}
+
+sunindextype* SUNBSRMatrix_IndexValues(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BSR)
+    return SM_INDEXVALS_BSR(A);
+  else
+    return NULL;
+}
+
+sunindextype* SUNBSRMatrix_IndexPointers(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_BSR)
+    return SM_INDEXPTRS_BSR(A);
+  else
+    return NULL;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to color the columns of A for a difference quotient Jacobian. The
+ * block columns are colored greedily so that no two block columns with the
+ * same color have a block in the same block row. Column j of a block column
+ * with color c gets color c*bs + j, so the columns of one color do not share
+ * any row. On return colors[j] holds the color of column j (colors must have
+ * length NB*bs) and ncolors the number of colors used.
+ */
+
+int SUNBSRMatrix_ColorColumns(SUNMatrix A, sunindextype *colors,
+                              sunindextype *ncolors)
+{
+  sunindextype MB, NB, bs, nnzb, I, J, K, j, k, p, q, c, nbcolors;
+  sunindextype *Ap, *Aj, *Tp, *Ti, *bcolors, *forbidden;
+
+  /* check for valid inputs */
+  if ((A == NULL) || (colors == NULL) || (ncolors == NULL))
+    return SUNMAT_ILL_INPUT;
+  if (SUNMatGetID(A) != SUNMATRIX_BSR)
+    return SUNMAT_ILL_INPUT;
+
+  MB   = SM_BLOCKROWS_BSR(A);
+  NB   = SM_BLOCKCOLS_BSR(A);
+  bs   = SM_BLOCKSIZE_BSR(A);
+  Ap   = SM_INDEXPTRS_BSR(A);
+  Aj   = SM_INDEXVALS_BSR(A);
+  nnzb = Ap[MB];
+
+  /* list the block rows of each block column */
+  Tp = (sunindextype*)calloc(3 * NB + 1 + SUNMAX(nnzb, 1), sizeof(sunindextype));
+  if (Tp == NULL) return SUNMAT_MEM_FAIL;
+  bcolors   = Tp + NB + 1;
+  forbidden = bcolors + NB;
+  Ti        = forbidden + NB;
+
+  for (k = 0; k < nnzb; k++)
+    Tp[Aj[k] + 1]++;
+  for (J = 0; J < NB; J++)
+    Tp[J + 1] += Tp[J];
+  for (I = 0; I < MB; I++)
+    for (k = Ap[I]; k < Ap[I + 1]; k++)
+      Ti[Tp[Aj[k]]++] = I;
+  for (J = NB; J > 0; J--)
+    Tp[J] = Tp[J - 1];
+  Tp[0] = 0;
+
+  /* greedily assign each block column the smallest color not used by any
+     block column sharing a block row with it, forbidden[c] == J marks color c
+     as taken */
+  for (J = 0; J < NB; J++) {
+    bcolors[J]   = -1;
+    forbidden[J] = -1;
+  }
+  nbcolors = 0;
+
+  for (J = 0; J < NB; J++) {
+    for (p = Tp[J]; p < Tp[J + 1]; p++) {
+      I = Ti[p];
+      for (q = Ap[I]; q < Ap[I + 1]; q++) {
+        K = Aj[q];
+        if (bcolors[K] >= 0) forbidden[bcolors[K]] = J;
+      }
+    }
+    c = 0;
+    while (forbidden[c] == J) c++;
+    bcolors[J] = c;
+    if (c + 1 > nbcolors) nbcolors = c + 1;
+  }
+
+  for (J = 0; J < NB; J++)
+    for (j = 0; j < bs; j++)
+      colors[J * bs + j] = bcolors[J] * bs + j;
+  *ncolors = nbcolors * bs;
+
+  free(Tp);
+
+  return SUNMAT_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of matrix operations
+ * -----------------------------------------------------------------
+ */
+
+SUNMatrix_ID SUNMatGetID_BSR(SUNMatrix A) { return SUNMATRIX_BSR; }
+
+SUNMatrix SUNMatClone_BSR(SUNMatrix A)
+{
+  sunindextype MB, nnzb;
+  SUNMatrix B;
+
+  /* the clone has the block pattern of A with zero entries */
+  MB = SM_BLOCKROWS_BSR(A);
+  B  = SUNBSRMatrix(MB, SM_BLOCKCOLS_BSR(A), SM_BLOCKSIZE_BSR(A),
+                    SM_NNZB_BSR(A), A->sunctx);
+  if (B == NULL) return (NULL);
+
+  nnzb = SM_INDEXPTRS_BSR(A)[MB];
+  memcpy(SM_INDEXPTRS_BSR(B), SM_INDEXPTRS_BSR(A), (MB + 1) * sizeof(sunindextype));
+  if (nnzb > 0)
+    memcpy(SM_INDEXVALS_BSR(B), SM_INDEXVALS_BSR(A), nnzb * sizeof(sunindextype));
+
+  /* use the same threads (see SUNBSRMatrix_SetNumThreads) */
+  SM_NUM_THREADS_BSR(B) = SM_NUM_THREADS_BSR(A);
+  B->ops->matvec = A->ops->matvec;
+
+  return (B);
+}
+
+void SUNMatDestroy_BSR(SUNMatrix A)
+{
+  if (A == NULL)
+    return;
+
+  /* free content */
+  if (A->content != NULL) {
+    /* free data and index arrays */
+    if (SM_DATA_BSR(A) != NULL) {
+      free(SM_DATA_BSR(A));
+      SM_DATA_BSR(A) = NULL;
+    }
+    if (SM_INDEXVALS_BSR(A) != NULL) {
+      free(SM_INDEXVALS_BSR(A));
+      SM_INDEXVALS_BSR(A) = NULL;
+    }
+    if (SM_INDEXPTRS_BSR(A) != NULL) {
+      free(SM_INDEXPTRS_BSR(A));
+      SM_INDEXPTRS_BSR(A) = NULL;
+    }
+    /* free content struct */
+    free(A->content);
+    A->content = NULL;
+  }
+
+  /* free ops and matrix */
+  if (A->ops) {
+    free(A->ops);
+    A->ops = NULL;
+  }
+  free(A);
+  A = NULL;
+
+  return;
+}
+
+int SUNMatZero_BSR(SUNMatrix A)
+{
+  sunindextype i, n;
+  realtype* Adata;
+
+  /* Perform operation A_ij = 0, the block pattern is kept */
+  Adata = SM_DATA_BSR(A);
+  n     = SM_NNZB_BSR(A) * SM_BLOCKSIZE_BSR(A) * SM_BLOCKSIZE_BSR(A);
+  for (i = 0; i < n; i++)
+    Adata[i] = ZERO;
+
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatCopy_BSR(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype MB, nnzb, bs;
+
+  if (!compatibleMatrices(A, B))
+    return SUNMAT_ILL_INPUT;
+
+  MB   = SM_BLOCKROWS_BSR(A);
+  bs   = SM_BLOCKSIZE_BSR(A);
+  nnzb = SM_INDEXPTRS_BSR(A)[MB];
+
+  /* ensure that B has room for the blocks of A */
+  if (SM_NNZB_BSR(B) < nnzb) {
+    SM_INDEXPTRS_BSR(B)[MB] = 0;
+    if (SUNBSRMatrix_Reallocate(B, nnzb) != SUNMAT_SUCCESS)
+      return SUNMAT_MEM_FAIL;
+  }
+
+  /* Perform operation B = A, including the block pattern */
+  memcpy(SM_INDEXPTRS_BSR(B), SM_INDEXPTRS_BSR(A), (MB + 1) * sizeof(sunindextype));
+  if (nnzb > 0) {
+    memcpy(SM_INDEXVALS_BSR(B), SM_INDEXVALS_BSR(A), nnzb * sizeof(sunindextype));
+    memcpy(SM_DATA_BSR(B), SM_DATA_BSR(A), nnzb * bs * bs * sizeof(realtype));
+  }
+
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatScaleAddI_BSR(realtype c, SUNMatrix A)
+{
+  sunindextype I, i, k, n, MB, bs;
+  sunindextype *Ap, *Aj;
+  realtype *Ad;
+  booleantype diag;
+
+  /* the identity only has the same block structure for square block grids */
+  if (SM_BLOCKROWS_BSR(A) != SM_BLOCKCOLS_BSR(A))
+    return SUNMAT_ILL_INPUT;
+
+  MB = SM_BLOCKROWS_BSR(A);
+  bs = SM_BLOCKSIZE_BSR(A);
+  Ap = SM_INDEXPTRS_BSR(A);
+  Aj = SM_INDEXVALS_BSR(A);
+
+  /* check that every diagonal block is stored, otherwise add the missing
+     blocks to the pattern */
+  for (I = 0; I < MB; I++) {
+    diag = SUNFALSE;
+    for (k = Ap[I]; k < Ap[I + 1]; k++)
+      if (Aj[k] == I) { diag = SUNTRUE; break; }
+    if (!diag) return mergePatterns(c, A, NULL);
+  }
+
+  /* Perform operation A = c*A + I */
+  Ad = SM_DATA_BSR(A);
+  n  = Ap[MB] * bs * bs;
+  for (i = 0; i < n; i++)
+    Ad[i] *= c;
+  for (I = 0; I < MB; I++) {
+    for (k = Ap[I]; k < Ap[I + 1]; k++) {
+      if (Aj[k] == I) {
+        for (i = 0; i < bs; i++)
+          SM_BLOCK_ELEMENT_BSR(A, k, i, i) += ONE;
+        break;
+      }
+    }
+  }
+
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatScaleAdd_BSR(realtype c, SUNMatrix A, SUNMatrix B)
+{
+  sunindextype i, n;
+  realtype *Ad, *Bd;
+
+  if (!compatibleMatrices(A, B))
+    return SUNMAT_ILL_INPUT;
+
+  /* matrices with different block patterns are merged */
+  if (!samePattern(A, B))
+    return mergePatterns(c, A, B);
+
+  /* Perform operation A = c*A + B */
+  Ad = SM_DATA_BSR(A);
+  Bd = SM_DATA_BSR(B);
+  n  = SM_INDEXPTRS_BSR(A)[SM_BLOCKROWS_BSR(A)] * SM_BLOCKSIZE_BSR(A)
+       * SM_BLOCKSIZE_BSR(A);
+  for (i = 0; i < n; i++)
+    Ad[i] = c * Ad[i] + Bd[i];
+
+  return SUNMAT_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Product of the blocks of one block row with x. The block size is a compile
+ * time constant where this is inlined with a literal bs, so the loops over a
+ * block are unrolled and the partial sums of the block row stay in registers.
+ */
+
+SUNDIALS_STATIC_INLINE
+void Matvec_BSRRow(const sunindextype bs, const sunindextype kstart,
+                   const sunindextype kend, const sunindextype *Aj,
+                   const realtype *Ad, const realtype *xd, realtype *yI)
+{
+  sunindextype i, j, k;
+  realtype sum[BSR_MAX_UNROLL];
+  const realtype *Ak, *xJ;
+
+  for (i = 0; i < bs; i++)
+    sum[i] = ZERO;
+
+  for (k = kstart; k < kend; k++) {
+    Ak = Ad + k * bs * bs;
+    xJ = xd + Aj[k] * bs;
+    for (j = 0; j < bs; j++)
+      for (i = 0; i < bs; i++)
+        sum[i] += Ak[j * bs + i] * xJ[j];
+  }
+
+  for (i = 0; i < bs; i++)
+    yI[i] = sum[i];
+}
+
+/* Same product for blocks larger than BSR_MAX_UNROLL, summed in y */
+static void Matvec_BSRRowGeneric(const sunindextype bs, const sunindextype kstart,
+                                 const sunindextype kend, const sunindextype *Aj,
+                                 const realtype *Ad, const realtype *xd,
+                                 realtype *yI)
+{
+  sunindextype i, j, k;
+  const realtype *Ak, *xJ;
+
+  for (i = 0; i < bs; i++)
+    yI[i] = ZERO;
+
+  for (k = kstart; k < kend; k++) {
+    Ak = Ad + k * bs * bs;
+    xJ = xd + Aj[k] * bs;
+    for (j = 0; j < bs; j++)
+      for (i = 0; i < bs; i++)
+        yI[i] += Ak[j * bs + i] * xJ[j];
+  }
+}
+
+int SUNMatMatvec_BSR(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int retval;
+  realtype *xd, *yd;
+
+  retval = SMMatvecSetup_BSR(A, x, y, &xd, &yd);
+  if (retval != SUNMAT_SUCCESS) return retval;
+
+  SMMatvecBlockRows_BSR(A, xd, yd, 0, SM_BLOCKROWS_BSR(A));
+
+  return SUNMAT_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Checks the inputs of y = A*x and returns the vector data. The block rows of
+ * y are independent and may be computed concurrently with
+ * SMMatvecBlockRows_BSR.
+ */
+
+int SMMatvecSetup_BSR(SUNMatrix A, N_Vector x, N_Vector y, realtype **xd,
+                      realtype **yd)
+{
+  if (!compatibleMatrixAndVectors(A, x, y))
+    return SUNMAT_ILL_INPUT;
+
+  /* access vector data (return if NULL data pointers) */
+  *xd = N_VGetArrayPointer(x);
+  *yd = N_VGetArrayPointer(y);
+  if ((*xd == NULL) || (*yd == NULL) || (*xd == *yd))
+    return SUNMAT_MEM_FAIL;
+
+  return SUNMAT_SUCCESS;
+}
+
+/* Computes the block rows start to end-1 of y = A*x */
+
+void SMMatvecBlockRows_BSR(SUNMatrix A, const realtype *xd, realtype *yd,
+                           sunindextype start, sunindextype end)
+{
+  sunindextype I, bs;
+  sunindextype *Ap, *Aj;
+  realtype *Ad, *yI;
+
+  bs = SM_BLOCKSIZE_BSR(A);
+  Ap = SM_INDEXPTRS_BSR(A);
+  Aj = SM_INDEXVALS_BSR(A);
+  Ad = SM_DATA_BSR(A);
+
+  for (I = start; I < end; I++) {
+    yI = yd + I * bs;
+    switch (bs) {
+    case 1: Matvec_BSRRow(1, Ap[I], Ap[I + 1], Aj, Ad, xd, yI); break;
+    case 2: Matvec_BSRRow(2, Ap[I], Ap[I + 1], Aj, Ad, xd, yI); break;
+    case 3: Matvec_BSRRow(3, Ap[I], Ap[I + 1], Aj, Ad, xd, yI); break;
+    case 4: Matvec_BSRRow(4, Ap[I], Ap[I + 1], Aj, Ad, xd, yI); break;
+    case 5: Matvec_BSRRow(5, Ap[I], Ap[I + 1], Aj, Ad, xd, yI); break;
+    case 6: Matvec_BSRRow(6, Ap[I], Ap[I + 1], Aj, Ad, xd, yI); break;
+    case 7: Matvec_BSRRow(7, Ap[I], Ap[I + 1], Aj, Ad, xd, yI); break;
+    case 8: Matvec_BSRRow(8, Ap[I], Ap[I + 1], Aj, Ad, xd, yI); break;
+    default: Matvec_BSRRowGeneric(bs, Ap[I], Ap[I + 1], Aj, Ad, xd, yI);
+    }
+  }
+}
+
+int SUNMatSpace_BSR(SUNMatrix A, long int* lenrw, long int* leniw)
+{
+  *lenrw = (long int) (SM_NNZB_BSR(A) * SM_BLOCKSIZE_BSR(A) * SM_BLOCKSIZE_BSR(A));
+  *leniw = 10 + SM_BLOCKROWS_BSR(A) + 1 + SM_NNZB_BSR(A);
+  return SUNMAT_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static booleantype compatibleMatrices(SUNMatrix A, SUNMatrix B)
+{
+  /* both matrices must be SUNMATRIX_BSR */
+  if ((SUNMatGetID(A) != SUNMATRIX_BSR) || (SUNMatGetID(B) != SUNMATRIX_BSR))
+    return SUNFALSE;
+
+  /* both matrices must have the same block grid and block size */
+  if ((SM_BLOCKROWS_BSR(A) != SM_BLOCKROWS_BSR(B)) ||
+      (SM_BLOCKCOLS_BSR(A) != SM_BLOCKCOLS_BSR(B)) ||
+      (SM_BLOCKSIZE_BSR(A) != SM_BLOCKSIZE_BSR(B)))
+    return SUNFALSE;
+
+  return SUNTRUE;
+}
+
+static booleantype compatibleMatrixAndVectors(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  /* Vectors must provide nvgetarraypointer and cannot be a parallel vector */
+  if (!x->ops->nvgetarraypointer || !y->ops->nvgetarraypointer)
+    return SUNFALSE;
+
+  /* Check that the dimensions agree */
+  if ((N_VGetLength(x) != SUNBSRMatrix_Columns(A)) ||
+      (N_VGetLength(y) != SUNBSRMatrix_Rows(A)))
+    return SUNFALSE;
+
+  return SUNTRUE;
+}
+
+/* Check if A and B store the same blocks in the same order */
+static booleantype samePattern(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype MB, nnzb;
+
+  if (A == B) return SUNTRUE;
+
+  MB   = SM_BLOCKROWS_BSR(A);
+  nnzb = SM_INDEXPTRS_BSR(A)[MB];
+
+  if (memcmp(SM_INDEXPTRS_BSR(A), SM_INDEXPTRS_BSR(B),
+             (MB + 1) * sizeof(sunindextype)) != 0)
+    return SUNFALSE;
+  if ((nnzb > 0) && (memcmp(SM_INDEXVALS_BSR(A), SM_INDEXVALS_BSR(B),
+                            nnzb * sizeof(sunindextype)) != 0))
+    return SUNFALSE;
+
+  return SUNTRUE;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute A = c*A + B where the block pattern of the result is the union of
+ * the patterns of A and B, or A = c*A + I if B is NULL. The block columns of
+ * each block row of the result are sorted.
+ */
+
+static int mergePatterns(realtype c, SUNMatrix A, SUNMatrix B)
+{
+  sunindextype MB, NB, bs, bs2, I, J, i, k, q, nnzb;
+  sunindextype *Ap, *Aj, *Bp, *Bj, *Cp, *Cj, *marker, *pos;
+  realtype *Ad, *Bd, *Cd, *Ck, *Ak;
+
+  MB  = SM_BLOCKROWS_BSR(A);
+  NB  = SM_BLOCKCOLS_BSR(A);
+  bs  = SM_BLOCKSIZE_BSR(A);
+  bs2 = bs * bs;
+  Ap  = SM_INDEXPTRS_BSR(A);
+  Aj  = SM_INDEXVALS_BSR(A);
+  Ad  = SM_DATA_BSR(A);
+  Bp  = (B) ? SM_INDEXPTRS_BSR(B) : NULL;
+  Bj  = (B) ? SM_INDEXVALS_BSR(B) : NULL;
+  Bd  = (B) ? SM_DATA_BSR(B) : NULL;
+
+  marker = (sunindextype*)malloc(2 * NB * sizeof(sunindextype));
+  if (marker == NULL) return SUNMAT_MEM_FAIL;
+  pos = marker + NB;
+
+  /* count the blocks of the result */
+  nnzb = 0;
+  for (J = 0; J < NB; J++)
+    marker[J] = -1;
+  for (I = 0; I < MB; I++) {
+    for (k = Ap[I]; k < Ap[I + 1]; k++) {
+      marker[Aj[k]] = I;
+      nnzb++;
+    }
+    if (B) {
+      for (k = Bp[I]; k < Bp[I + 1]; k++)
+        if (marker[Bj[k]] != I) { marker[Bj[k]] = I; nnzb++; }
+    } else if (marker[I] != I) {
+      nnzb++;
+    }
+  }
+
+  Cp = (sunindextype*)malloc((MB + 1) * sizeof(sunindextype));
+  Cj = (sunindextype*)malloc(SUNMAX(nnzb, 1) * sizeof(sunindextype));
+  Cd = (realtype*)calloc(SUNMAX(nnzb * bs2, 1), sizeof(realtype));
+  if ((Cp == NULL) || (Cj == NULL) || (Cd == NULL)) {
+    free(marker); free(Cp); free(Cj); free(Cd);
+    return SUNMAT_MEM_FAIL;
+  }
+
+  /* collect and sort the block columns of each block row, then add c times
+     the blocks of A and the blocks of B (or I) */
+  q = 0;
+  for (J = 0; J < NB; J++)
+    marker[J] = -1;
+  for (I = 0; I < MB; I++) {
+    Cp[I] = q;
+    for (k = Ap[I]; k < Ap[I + 1]; k++) {
+      marker[Aj[k]] = I;
+      Cj[q++]       = Aj[k];
+    }
+    if (B) {
+      for (k = Bp[I]; k < Bp[I + 1]; k++)
+        if (marker[Bj[k]] != I) { marker[Bj[k]] = I; Cj[q++] = Bj[k]; }
+    } else if (marker[I] != I) {
+      marker[I] = I;
+      Cj[q++]   = I;
+    }
+    qsort(Cj + Cp[I], q - Cp[I], sizeof(sunindextype), compareIndices);
+    for (k = Cp[I]; k < q; k++)
+      pos[Cj[k]] = k;
+
+    for (k = Ap[I]; k < Ap[I + 1]; k++) {
+      Ck = Cd + pos[Aj[k]] * bs2;
+      Ak = Ad + k * bs2;
+      for (i = 0; i < bs2; i++)
+        Ck[i] += c * Ak[i];
+    }
+    if (B) {
+      for (k = Bp[I]; k < Bp[I + 1]; k++) {
+        Ck = Cd + pos[Bj[k]] * bs2;
+        Ak = Bd + k * bs2;
+        for (i = 0; i < bs2; i++)
+          Ck[i] += Ak[i];
+      }
+    } else {
+      Ck = Cd + pos[I] * bs2;
+      for (i = 0; i < bs; i++)
+        Ck[i * bs + i] += ONE;
+    }
+  }
+  Cp[MB] = q;
+
+  free(marker);
+
+  /* replace the arrays of A */
+  free(SM_INDEXPTRS_BSR(A));
+  free(SM_INDEXVALS_BSR(A));
+  free(SM_DATA_BSR(A));
+  SM_INDEXPTRS_BSR(A) = Cp;
+  SM_INDEXVALS_BSR(A) = Cj;
+  SM_DATA_BSR(A)      = Cd;
+  SM_NNZB_BSR(A)      = nnzb;
+
+  return SUNMAT_SUCCESS;
+}
+
+static int compareIndices(const void *a, const void *b)
+{
+  sunindextype ia = *((const sunindextype*) a);
+  sunindextype ib = *((const sunindextype*) b);
+  return (ia > ib) - (ia < ib);
+}
@@ -0,0 +1,39 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Private functions of the BSR SUNMATRIX used by the threaded
+ * matrix-vector product in sunmatrix_bsr_threads.c.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNMATRIX_BSR_IMPL_H
+#define _SUNMATRIX_BSR_IMPL_H
+
+#include <sunmatrix/sunmatrix_bsr.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Checks the inputs of y = A x and returns the vector data */
+int SMMatvecSetup_BSR(SUNMatrix A, N_Vector x, N_Vector y, realtype **xd,
+                      realtype **yd);
+
+/* Computes the block rows start to end-1 of y = A x */
+void SMMatvecBlockRows_BSR(SUNMatrix A, const realtype *xd, realtype *yd,
+                           sunindextype start, sunindextype end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the OpenMP threaded
+ * matrix-vector product of the BSR SUNMATRIX. Like the sparse
+ * matrix threads, it is only part of the SUNMATRIX_BSR library.
+ * -----------------------------------------------------------------
+ */
+
+#include <sunmatrix/sunmatrix_bsr.h>
+
+#include "sunmatrix_bsr_impl.h"
+
+#if defined(_OPENMP)
+
+/* -----------------------------------------------------------------
+ * Computes y=A*x with the block rows divided evenly among the
+ * threads of the matrix
+ */
+static int SUNMatMatvec_BSRThreads(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int retval, t, nt;
+  sunindextype MB;
+  realtype *xd, *yd;
+
+  retval = SMMatvecSetup_BSR(A, x, y, &xd, &yd);
+  if (retval != SUNMAT_SUCCESS) return retval;
+
+  MB = SM_BLOCKROWS_BSR(A);
+  nt = SM_NUM_THREADS_BSR(A);
+  if (nt > MB) nt = (int) MB;
+
+#pragma omp parallel for num_threads(nt) schedule(static)
+  for (t=0; t<nt; t++)
+    SMMatvecBlockRows_BSR(A, xd, yd, (MB * t) / nt, (MB * (t + 1)) / nt);
+
+  return SUNMAT_SUCCESS;
+}
+
+#endif
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of OpenMP threads used by SUNMatMatvec. Without
+ * OpenMP the product is always computed by the calling thread.
+ */
+
+int SUNBSRMatrix_SetNumThreads(SUNMatrix A, int num_threads)
+{
+  /* check for valid inputs */
+  if (A == NULL || SUNMatGetID(A) != SUNMATRIX_BSR || num_threads < 1)
+    return SUNMAT_ILL_INPUT;
+
+  SM_NUM_THREADS_BSR(A) = num_threads;
+
+#if defined(_OPENMP)
+  A->ops->matvec = (num_threads > 1) ? SUNMatMatvec_BSRThreads
+                                     : SUNMatMatvec_BSR;
+#endif
+
+  return SUNMAT_SUCCESS;
+}
@@ -384,6 +384,74 @@ SWIGEXPORT int _wrap_FSUNSparseMatrix_SparseType(SUNMatrix farg1) {
 }
 
 
+SWIGEXPORT int _wrap_FSUNSparseMatrix_PatternChanged(SUNMatrix farg1) {
+  int fresult ;
+  SUNMatrix arg1 = (SUNMatrix) 0 ;
+  int result;
+  
+  arg1 = (SUNMatrix)(farg1);
+  result = (int)SUNSparseMatrix_PatternChanged(arg1);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT void _wrap_FSUNSparseMatrix_FreeCache(SUNMatrix farg1) {
+  SUNMatrix arg1 = (SUNMatrix) 0 ;
+  
+  arg1 = (SUNMatrix)(farg1);
+  SUNSparseMatrix_FreeCache(arg1);
+}
+
+
+SWIGEXPORT int _wrap_FSUNSparseMatrix_SetMatvecLayout(SUNMatrix farg1, int const *farg2, int64_t const *farg3, int64_t const *farg4) {
+  int fresult ;
+  SUNMatrix arg1 = (SUNMatrix) 0 ;
+  int arg2 ;
+  sunindextype arg3 ;
+  sunindextype arg4 ;
+  int result;
+  
+  arg1 = (SUNMatrix)(farg1);
+  arg2 = (int)(*farg2);
+  arg3 = (sunindextype)(*farg3);
+  arg4 = (sunindextype)(*farg4);
+  result = (int)SUNSparseMatrix_SetMatvecLayout(arg1,arg2,arg3,arg4);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT int _wrap_FSUNSparseMatrix_SetNumThreads(SUNMatrix farg1, int const *farg2) {
+  int fresult ;
+  SUNMatrix arg1 = (SUNMatrix) 0 ;
+  int arg2 ;
+  int result;
+  
+  arg1 = (SUNMatrix)(farg1);
+  arg2 = (int)(*farg2);
+  result = (int)SUNSparseMatrix_SetNumThreads(arg1,arg2);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
+SWIGEXPORT int _wrap_FSUNSparseMatrix_ColorColumns(SUNMatrix farg1, int64_t *farg2, int64_t *farg3) {
+  int fresult ;
+  SUNMatrix arg1 = (SUNMatrix) 0 ;
+  sunindextype *arg2 = (sunindextype *) 0 ;
+  sunindextype *arg3 = (sunindextype *) 0 ;
+  int result;
+  
+  arg1 = (SUNMatrix)(farg1);
+  arg2 = (sunindextype *)(farg2);
+  arg3 = (sunindextype *)(farg3);
+  result = (int)SUNSparseMatrix_ColorColumns(arg1,arg2,arg3);
+  fresult = (int)(result);
+  return fresult;
+}
+
+
 SWIGEXPORT int _wrap_FSUNMatGetID_Sparse(SUNMatrix farg1) {
   int fresult ;
   SUNMatrix arg1 = (SUNMatrix) 0 ;
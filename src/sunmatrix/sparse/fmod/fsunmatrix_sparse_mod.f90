@@ -32,6 +32,9 @@ module fsunmatrix_sparse_mod
  ! DECLARATION CONSTRUCTS
  integer(C_INT), parameter, public :: CSC_MAT = 0_C_INT
  integer(C_INT), parameter, public :: CSR_MAT = 1_C_INT
+ integer(C_INT), parameter, public :: SUNSPARSE_MATVEC_NATIVE = 0_C_INT
+ integer(C_INT), parameter, public :: SUNSPARSE_MATVEC_CSR = 1_C_INT
+ integer(C_INT), parameter, public :: SUNSPARSE_MATVEC_SELL = 2_C_INT
  public :: FSUNSparseMatrix
  public :: FSUNSparseFromDenseMatrix
  public :: FSUNSparseFromBandMatrix
@@ -45,6 +48,11 @@ module fsunmatrix_sparse_mod
  public :: FSUNSparseMatrix_NNZ
  public :: FSUNSparseMatrix_NP
  public :: FSUNSparseMatrix_SparseType
+ public :: FSUNSparseMatrix_PatternChanged
+ public :: FSUNSparseMatrix_FreeCache
+ public :: FSUNSparseMatrix_SetMatvecLayout
+ public :: FSUNSparseMatrix_SetNumThreads
+ public :: FSUNSparseMatrix_ColorColumns
  public :: FSUNMatGetID_Sparse
  public :: FSUNMatClone_Sparse
  public :: FSUNMatDestroy_Sparse
@@ -176,6 +184,50 @@ type(C_PTR), value :: farg1
 integer(C_INT) :: fresult
 end function
 
+function swigc_FSUNSparseMatrix_PatternChanged(farg1) &
+bind(C, name="_wrap_FSUNSparseMatrix_PatternChanged") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT) :: fresult
+end function
+
+subroutine swigc_FSUNSparseMatrix_FreeCache(farg1) &
+bind(C, name="_wrap_FSUNSparseMatrix_FreeCache")
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+end subroutine
+
+function swigc_FSUNSparseMatrix_SetMatvecLayout(farg1, farg2, farg3, farg4) &
+bind(C, name="_wrap_FSUNSparseMatrix_SetMatvecLayout") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+integer(C_INT64_T), intent(in) :: farg3
+integer(C_INT64_T), intent(in) :: farg4
+integer(C_INT) :: fresult
+end function
+
+function swigc_FSUNSparseMatrix_SetNumThreads(farg1, farg2) &
+bind(C, name="_wrap_FSUNSparseMatrix_SetNumThreads") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
+function swigc_FSUNSparseMatrix_ColorColumns(farg1, farg2, farg3) &
+bind(C, name="_wrap_FSUNSparseMatrix_ColorColumns") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+type(C_PTR), value :: farg2
+type(C_PTR), value :: farg3
+integer(C_INT) :: fresult
+end function
+
 function swigc_FSUNMatGetID_Sparse(farg1) &
 bind(C, name="_wrap_FSUNMatGetID_Sparse") &
 result(fresult)
@@ -485,6 +537,85 @@ fresult = swigc_FSUNSparseMatrix_SparseType(farg1)
 swig_result = fresult
 end function
 
+function FSUNSparseMatrix_PatternChanged(a) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(SUNMatrix), target, intent(inout) :: a
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+
+farg1 = c_loc(a)
+fresult = swigc_FSUNSparseMatrix_PatternChanged(farg1)
+swig_result = fresult
+end function
+
+subroutine FSUNSparseMatrix_FreeCache(a)
+use, intrinsic :: ISO_C_BINDING
+type(SUNMatrix), target, intent(inout) :: a
+type(C_PTR) :: farg1 
+
+farg1 = c_loc(a)
+call swigc_FSUNSparseMatrix_FreeCache(farg1)
+end subroutine
+
+function FSUNSparseMatrix_SetMatvecLayout(a, layout, chunk, sigma) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(SUNMatrix), target, intent(inout) :: a
+integer(C_INT), intent(in) :: layout
+integer(C_INT64_T), intent(in) :: chunk
+integer(C_INT64_T), intent(in) :: sigma
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+integer(C_INT64_T) :: farg3 
+integer(C_INT64_T) :: farg4 
+
+farg1 = c_loc(a)
+farg2 = layout
+farg3 = chunk
+farg4 = sigma
+fresult = swigc_FSUNSparseMatrix_SetMatvecLayout(farg1, farg2, farg3, farg4)
+swig_result = fresult
+end function
+
+function FSUNSparseMatrix_SetNumThreads(a, num_threads) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(SUNMatrix), target, intent(inout) :: a
+integer(C_INT), intent(in) :: num_threads
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+
+farg1 = c_loc(a)
+farg2 = num_threads
+fresult = swigc_FSUNSparseMatrix_SetNumThreads(farg1, farg2)
+swig_result = fresult
+end function
+
+function FSUNSparseMatrix_ColorColumns(a, colors, ncolors) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(SUNMatrix), target, intent(inout) :: a
+integer(C_INT64_T), dimension(*), target, intent(inout) :: colors
+integer(C_INT64_T), dimension(*), target, intent(inout) :: ncolors
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+type(C_PTR) :: farg2 
+type(C_PTR) :: farg3 
+
+farg1 = c_loc(a)
+farg2 = c_loc(colors(1))
+farg3 = c_loc(ncolors(1))
+fresult = swigc_FSUNSparseMatrix_ColorColumns(farg1, farg2, farg3)
+swig_result = fresult
+end function
+
 function FSUNMatGetID_Sparse(a) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
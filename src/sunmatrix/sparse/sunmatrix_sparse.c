@@ -27,15 +27,80 @@
 #include <sundials/sundials_nvector.h>
 #include <sundials/sundials_math.h>
 
+#include "sunmatrix_sparse_impl.h"
+
 #define ZERO RCONST(0.0)
 #define ONE  RCONST(1.0)
 
+/* Default SELL-C-sigma chunk height and sorting window, and the largest
+   supported chunk height */
+#define SELL_DEFAULT_C     8
+#define SELL_DEFAULT_SIGMA 256
+#define SELL_MAX_C         32
+
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#define SUNSPARSE_PRAGMA_SIMD _Pragma("omp simd")
+#else
+#define SUNSPARSE_PRAGMA_SIMD
+#endif
+
 /* Private function prototypes */
 static booleantype SMCompatible_Sparse(SUNMatrix A, SUNMatrix B);
 static booleantype SMCompatible2_Sparse(SUNMatrix A, N_Vector x, N_Vector y);
 static int Matvec_SparseCSC(SUNMatrix A, N_Vector x, N_Vector y);
-static int Matvec_SparseCSR(SUNMatrix A, N_Vector x, N_Vector y);
+static void Matvec_SparseCSR(SUNMatrix A, const realtype *xd, realtype *yd,
+                             sunindextype start, sunindextype end);
+static void Matvec_SparseSELL(SUNMatrix A, const realtype *xd, realtype *yd,
+                              sunindextype start, sunindextype end);
+static int SMLayoutBuild_Sparse(SUNMatrix A);
+static void SMLayoutClear_Sparse(SUNMatrix A);
+static void SMLayoutStale_Sparse(SUNMatrix A);
 static int format_convert(const SUNMatrix A, SUNMatrix B);
+static void SMCacheSave_Sparse(SUNMatrix A, SUNMatrix B);
+static void SMCacheBuild_Sparse(SUNMatrix A, SUNMatrix B);
+static booleantype SMCacheMatches_Sparse(SUNMatrix A, SUNMatrix B);
+static void SMCacheApply_Sparse(realtype c, SUNMatrix A, SUNMatrix B);
+
+/* Maps cached by SUNMatScaleAdd_Sparse (B != NULL) and SUNMatScaleAddI_Sparse
+   (B == NULL) so that later calls with the same input patterns are a single
+   pass over the data. Position p of A (entry k of B or of the diagonal) is
+   moved to amap[p] (added at bmap[k]) in the result. A negative bmap[k] marks
+   an entry that is not in A and is stored at -(bmap[k]+1). When no entries
+   are inserted amap and Cp are NULL and A keeps its pattern. */
+struct _SUNSparseMergeCache {
+  booleantype valid;     /* maps have been built              */
+  sunindextype nnz_c;    /* number of nonzeros in the result  */
+  sunindextype *Ap;      /* input pattern of A                */
+  sunindextype *Ai;
+  sunindextype *Bp;      /* pattern of B (NULL for ScaleAddI) */
+  sunindextype *Bi;
+  sunindextype *Cp;      /* index pointers of the result      */
+  sunindextype *amap;
+  sunindextype *bmap;
+};
+
+/* Copy of the matrix used by SUNMatMatvec_Sparse. The CSR layout holds the
+   rows of a CSC matrix (for CSR matrices the matrix itself is used) so that
+   the rows can be computed in parallel without conflicts. The SELL-C-sigma
+   layout sorts the rows by length within windows of sigma rows and stores
+   chunks of C rows column by column, padded to the longest row of the chunk,
+   so that the C rows of a chunk are computed together in SIMD lanes. The copy
+   is rebuilt by the first product after the matrix is changed. */
+struct _SUNSparseMatvecLayout {
+  int type;              /* SUNSPARSE_MATVEC_CSR or SUNSPARSE_MATVEC_SELL */
+  sunindextype C;        /* chunk height                                   */
+  sunindextype sigma;    /* sorting window                                 */
+  booleantype stale;     /* rebuild before the next product                */
+  sunindextype *rp;      /* CSR copy of a CSC matrix                       */
+  sunindextype *ci;
+  realtype *v;
+  sunindextype nchunks;  /* number of SELL chunks                          */
+  sunindextype *cs;      /* start of each chunk                            */
+  sunindextype *cl;      /* width of each chunk                            */
+  sunindextype *perm;    /* row computed by each SELL lane (-1 if padding) */
+  sunindextype *scol;    /* SELL column indices and values                 */
+  realtype *sval;
+};
 
 /*
  * -----------------------------------------------------------------
@@ -113,6 +178,10 @@ SUNMatrix SUNSparseMatrix(sunindextype M, sunindextype N,
   content->data      = NULL;
   content->indexvals = NULL;
   content->indexptrs = NULL;
+  content->cache     = NULL;
+  content->pattern_changed = SUNFALSE;
+  content->layout    = NULL;
+  content->num_threads = 1;
 
   /* Allocate content */
   content->data = (realtype *) calloc(NNZ, sizeof(realtype));
@@ -309,6 +378,8 @@ int SUNSparseMatrix_Realloc(SUNMatrix A)
   nzmax = (SM_INDEXPTRS_S(A))[SM_NP_S(A)];
   if (nzmax < 0) return SUNMAT_ILL_INPUT;
 
+  SMLayoutStale_Sparse(A);
+
   /* perform reallocation */
   SM_INDEXVALS_S(A) = (sunindextype *) realloc(SM_INDEXVALS_S(A), nzmax*sizeof(sunindextype));
   SM_DATA_S(A) = (realtype *) realloc(SM_DATA_S(A), nzmax*sizeof(realtype));
@@ -333,6 +404,8 @@ int SUNSparseMatrix_Reallocate(SUNMatrix A, sunindextype NNZ)
   /* check for valid nnz */
   if (NNZ < 0)  return SUNMAT_ILL_INPUT;
 
+  SMLayoutStale_Sparse(A);
+
   /* perform reallocation */
   SM_INDEXVALS_S(A) = (sunindextype *) realloc(SM_INDEXVALS_S(A), NNZ*sizeof(sunindextype));
   SM_DATA_S(A) = (realtype *) realloc(SM_DATA_S(A), NNZ*sizeof(realtype));
@@ -461,6 +534,262 @@ sunindextype* SUNSparseMatrix_IndexPointers(SUNMatrix A)
     return NULL;
 }
 
+/* ----------------------------------------------------------------------------
+ * Function to report whether the most recent call to SUNMatScaleAdd or
+ * SUNMatScaleAddI with A as the output could not reuse the maps cached by the
+ * previous call, i.e., the sparsity pattern of the result may have changed.
+ */
+
+booleantype SUNSparseMatrix_PatternChanged(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_SPARSE)
+    return SM_CONTENT_S(A)->pattern_changed;
+  else
+    return SUNFALSE;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Function to free the maps cached by SUNMatScaleAdd and SUNMatScaleAddI
+ */
+
+void SUNSparseMatrix_FreeCache(SUNMatrix A)
+{
+  struct _SUNSparseMergeCache *cache;
+
+  if (SUNMatGetID(A) != SUNMATRIX_SPARSE) return;
+
+  cache = SM_CONTENT_S(A)->cache;
+  if (cache == NULL) return;
+
+  free(cache->Ap);
+  free(cache->Ai);
+  free(cache->Bp);
+  free(cache->Bi);
+  free(cache->Cp);
+  free(cache->amap);
+  free(cache->bmap);
+  free(cache);
+  SM_CONTENT_S(A)->cache = NULL;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Function to select the storage used by SUNMatMatvec. The CSR and SELL-C-sigma
+ * layouts keep a copy of the matrix that is built by the next product. A chunk
+ * height or sorting window <= 0 selects the default.
+ */
+
+int SUNSparseMatrix_SetMatvecLayout(SUNMatrix A, int layout,
+                                    sunindextype chunk, sunindextype sigma)
+{
+  struct _SUNSparseMatvecLayout *content;
+
+  /* check for valid inputs */
+  if (A == NULL || SUNMatGetID(A) != SUNMATRIX_SPARSE)
+    return SUNMAT_ILL_INPUT;
+  if ( (layout != SUNSPARSE_MATVEC_NATIVE) &&
+       (layout != SUNSPARSE_MATVEC_CSR) &&
+       (layout != SUNSPARSE_MATVEC_SELL) )
+    return SUNMAT_ILL_INPUT;
+  if (chunk > SELL_MAX_C)
+    return SUNMAT_ILL_INPUT;
+
+  /* remove the previous layout */
+  content = SM_CONTENT_S(A)->layout;
+  if (content != NULL) {
+    SMLayoutClear_Sparse(A);
+    free(content);
+    SM_CONTENT_S(A)->layout = NULL;
+  }
+
+  if (layout == SUNSPARSE_MATVEC_NATIVE)
+    return SUNMAT_SUCCESS;
+
+  content = (struct _SUNSparseMatvecLayout *) calloc(1, sizeof *content);
+  if (content == NULL) return SUNMAT_MEM_FAIL;
+
+  content->type  = layout;
+  content->C     = (chunk > 0) ? chunk : SELL_DEFAULT_C;
+  content->sigma = (sigma > 0) ? sigma : SELL_DEFAULT_SIGMA;
+  content->stale = SUNTRUE;
+
+  SM_CONTENT_S(A)->layout = content;
+
+  return SUNMAT_SUCCESS;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Function to compute a greedy coloring of the columns of the sparsity pattern
+ * of A such that no two columns with the same color have a nonzero in the same
+ * row (a distance-2 coloring of the column graph). All columns of one color
+ * can be perturbed simultaneously when approximating a Jacobian with this
+ * pattern by difference quotients. On return colors[j] holds the color of
+ * column j (colors must have length N) and ncolors the number of colors used.
+ */
+
+int SUNSparseMatrix_ColorColumns(SUNMatrix A, sunindextype *colors,
+                                 sunindextype *ncolors)
+{
+  sunindextype M, N, NP, NT, nnz, i, j, k, p, q, c;
+  sunindextype *Ap, *Ai, *Tp, *Ti, *forbidden;
+  sunindextype *colptrs, *rowvals, *rowptrs, *colvals;
+
+  /* check for valid inputs */
+  if (A == NULL || colors == NULL || ncolors == NULL)
+    return SUNMAT_ILL_INPUT;
+  if (SUNMatGetID(A) != SUNMATRIX_SPARSE)
+    return SUNMAT_ILL_INPUT;
+
+  M   = SM_ROWS_S(A);
+  N   = SM_COLUMNS_S(A);
+  NP  = SM_NP_S(A);
+  NT  = (SM_SPARSETYPE_S(A) == CSC_MAT) ? M : N;
+  Ap  = SM_INDEXPTRS_S(A);
+  Ai  = SM_INDEXVALS_S(A);
+  nnz = Ap[NP];
+
+  /* create the transposed index arrays so that both the rows of each column
+     and the columns of each row are available */
+  Tp = (sunindextype *) calloc(NT+1, sizeof(sunindextype));
+  Ti = (sunindextype *) malloc(SUNMAX(nnz,1)*sizeof(sunindextype));
+  forbidden = (sunindextype *) malloc(SUNMAX(N,1)*sizeof(sunindextype));
+  if (Tp == NULL || Ti == NULL || forbidden == NULL) {
+    free(Tp); free(Ti); free(forbidden);
+    return SUNMAT_MEM_FAIL;
+  }
+
+  for (p=0; p<nnz; p++) Tp[Ai[p]+1]++;
+  for (i=0; i<NT; i++) Tp[i+1] += Tp[i];
+  for (j=0; j<NP; j++) {
+    for (p=Ap[j]; p<Ap[j+1]; p++) {
+      Ti[Tp[Ai[p]]++] = j;
+    }
+  }
+  for (i=NT; i>0; i--) Tp[i] = Tp[i-1];
+  Tp[0] = 0;
+
+  if (SM_SPARSETYPE_S(A) == CSC_MAT) {
+    colptrs = Ap; rowvals = Ai;
+    rowptrs = Tp; colvals = Ti;
+  } else {
+    colptrs = Tp; rowvals = Ti;
+    rowptrs = Ap; colvals = Ai;
+  }
+
+  /* greedily assign each column the smallest color not used by any column
+     sharing a row with it, forbidden[c] == j marks color c as taken */
+  for (j=0; j<N; j++) {
+    colors[j]    = -1;
+    forbidden[j] = -1;
+  }
+  *ncolors = 0;
+
+  for (j=0; j<N; j++) {
+    for (p=colptrs[j]; p<colptrs[j+1]; p++) {
+      i = rowvals[p];
+      for (q=rowptrs[i]; q<rowptrs[i+1]; q++) {
+        k = colvals[q];
+        if (colors[k] >= 0) forbidden[colors[k]] = j;
+      }
+    }
+    c = 0;
+    while (forbidden[c] == j) c++;
+    colors[j] = c;
+    if (c+1 > *ncolors) *ncolors = c+1;
+  }
+
+  free(Tp);
+  free(Ti);
+  free(forbidden);
+
+  return SUNMAT_SUCCESS;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Function to extract the diagonal blocks of a square sparse matrix
+ */
+
+int SUNSparseMatrix_DiagonalBlocks(SUNMatrix A, sunindextype nblocks,
+                                   const sunindextype *offsets, SUNMatrix *B)
+{
+  sunindextype b, k, p, q, s, e, m, nnz, *Ap, *Ai, *Bp, *Bi;
+  booleantype hasdiag;
+  realtype *Ax, *Bx;
+
+  /* check for valid inputs */
+  if (A == NULL || offsets == NULL || B == NULL || nblocks < 1)
+    return SUNMAT_ILL_INPUT;
+  if (SUNMatGetID(A) != SUNMATRIX_SPARSE)
+    return SUNMAT_ILL_INPUT;
+  if (SM_ROWS_S(A) != SM_COLUMNS_S(A))
+    return SUNMAT_ILL_INPUT;
+  if (offsets[0] != 0 || offsets[nblocks] != SM_ROWS_S(A))
+    return SUNMAT_ILL_INPUT;
+  for (b=0; b<nblocks; b++)
+    if (offsets[b+1] <= offsets[b]) return SUNMAT_ILL_INPUT;
+
+  Ap = SM_INDEXPTRS_S(A);
+  Ai = SM_INDEXVALS_S(A);
+  Ax = SM_DATA_S(A);
+
+  for (b=0; b<nblocks; b++) B[b] = NULL;
+
+  /* the diagonal blocks are the same for the rows (CSR) and the columns (CSC)
+     of A, so both formats are handled by looping over the index pointers */
+  for (b=0; b<nblocks; b++) {
+    s = offsets[b];
+    e = offsets[b+1];
+
+    /* count the entries inside the block, adding missing diagonal entries */
+    nnz = 0;
+    for (k=s; k<e; k++) {
+      hasdiag = SUNFALSE;
+      for (p=Ap[k]; p<Ap[k+1]; p++) {
+        if (Ai[p] >= s && Ai[p] < e) nnz++;
+        if (Ai[p] == k) hasdiag = SUNTRUE;
+      }
+      if (!hasdiag) nnz++;
+    }
+
+    B[b] = SUNSparseMatrix(e-s, e-s, nnz, SM_SPARSETYPE_S(A), A->sunctx);
+    if (B[b] == NULL) {
+      for (q=0; q<b; q++) { SUNMatDestroy(B[q]); B[q] = NULL; }
+      return SUNMAT_MEM_FAIL;
+    }
+    Bp = SM_INDEXPTRS_S(B[b]);
+    Bi = SM_INDEXVALS_S(B[b]);
+    Bx = SM_DATA_S(B[b]);
+
+    /* copy the entries, a missing diagonal entry is stored as an explicit
+       zero before the first entry past the diagonal */
+    nnz = 0;
+    for (k=s; k<e; k++) {
+      Bp[k-s] = nnz;
+      hasdiag = SUNFALSE;
+      for (p=Ap[k]; p<Ap[k+1]; p++)
+        if (Ai[p] == k) hasdiag = SUNTRUE;
+      for (p=Ap[k]; p<Ap[k+1]; p++) {
+        m = Ai[p];
+        if (m < s || m >= e) continue;
+        if (!hasdiag && m > k) {
+          Bi[nnz] = k-s;  Bx[nnz] = ZERO;  nnz++;
+          hasdiag = SUNTRUE;
+        }
+        Bi[nnz] = m-s;  Bx[nnz] = Ax[p];  nnz++;
+      }
+      if (!hasdiag) {
+        Bi[nnz] = k-s;  Bx[nnz] = ZERO;  nnz++;
+      }
+    }
+    Bp[e-s] = nnz;
+  }
+
+  return SUNMAT_SUCCESS;
+}
+
 
 /*
  * -----------------------------------------------------------------
@@ -477,6 +806,22 @@ SUNMatrix SUNMatClone_Sparse(SUNMatrix A)
 {
   SUNMatrix B = SUNSparseMatrix(SM_ROWS_S(A), SM_COLUMNS_S(A),
                                 SM_NNZ_S(A), SM_SPARSETYPE_S(A), A->sunctx);
+  if (B == NULL) return(NULL);
+
+  /* use the same matrix-vector product layout */
+  if (SM_CONTENT_S(A)->layout != NULL) {
+    if (SUNSparseMatrix_SetMatvecLayout(B, SM_CONTENT_S(A)->layout->type,
+                                        SM_CONTENT_S(A)->layout->C,
+                                        SM_CONTENT_S(A)->layout->sigma)) {
+      SUNMatDestroy_Sparse(B);
+      return(NULL);
+    }
+  }
+
+  /* use the same threads (see SUNSparseMatrix_SetNumThreads) */
+  SM_CONTENT_S(B)->num_threads = SM_CONTENT_S(A)->num_threads;
+  B->ops->matvec = A->ops->matvec;
+
   return(B);
 }
 
@@ -505,6 +850,13 @@ void SUNMatDestroy_Sparse(SUNMatrix A)
       SM_CONTENT_S(A)->colptrs = NULL;
       SM_CONTENT_S(A)->rowptrs = NULL;
     }
+    /* free cached maps and the matrix-vector product layout */
+    SUNSparseMatrix_FreeCache(A);
+    if (SM_CONTENT_S(A)->layout) {
+      SMLayoutClear_Sparse(A);
+      free(SM_CONTENT_S(A)->layout);
+      SM_CONTENT_S(A)->layout = NULL;
+    }
     /* free content struct */
     free(A->content);
     A->content = NULL;
@@ -521,6 +873,8 @@ int SUNMatZero_Sparse(SUNMatrix A)
 {
   sunindextype i;
 
+  SMLayoutStale_Sparse(A);
+
   /* Perform operation */
   for (i=0; i<SM_NNZ_S(A); i++) {
     (SM_DATA_S(A))[i] = ZERO;
@@ -540,6 +894,8 @@ int SUNMatCopy_Sparse(SUNMatrix A, SUNMatrix B)
   if (!SMCompatible_Sparse(A, B))
     return SUNMAT_ILL_INPUT;
 
+  SMLayoutStale_Sparse(B);
+
   /* Perform operation */
   A_nz = (SM_INDEXPTRS_S(A))[SM_NP_S(A)];
 
@@ -598,6 +954,17 @@ int SUNMatScaleAddI_Sparse(realtype c, SUNMatrix A)
   if (SM_DATA_S(A))       Ax = SM_DATA_S(A);
   else  return (SUNMAT_MEM_FAIL);
 
+  SMLayoutStale_Sparse(A);
+
+  /* if A has the same pattern as in the previous call, reuse the cached
+     diagonal positions */
+  if (SMCacheMatches_Sparse(A, NULL)) {
+    SMCacheApply_Sparse(c, A, NULL);
+    SM_CONTENT_S(A)->pattern_changed = SUNFALSE;
+    return SUNMAT_SUCCESS;
+  }
+  SM_CONTENT_S(A)->pattern_changed = SUNTRUE;
+  SMCacheSave_Sparse(A, NULL);
 
   /* determine if A: contains values on the diagonal (so I can just be added in);
      if not, then increment counter for extra storage that should be required. */
@@ -628,7 +995,7 @@ int SUNMatScaleAddI_Sparse(realtype c, SUNMatrix A)
   if (newvals == 0) {
 
     /* iterate through columns, adding 1.0 to diagonal */
-    for (j=0; j < SUNMIN(M,N); j++)
+    for (j=0; j<N; j++)
       for (i=Ap[j]; i<Ap[j+1]; i++)
         if (Ai[i] == j) {
           Ax[i] = ONE + c*Ax[i];
@@ -778,6 +1145,10 @@ int SUNMatScaleAddI_Sparse(realtype c, SUNMatrix A)
     free(x);
 
   }
+
+  /* cache the diagonal positions for the next call */
+  SMCacheBuild_Sparse(A, NULL);
+
   return SUNMAT_SUCCESS;
 
 }
@@ -820,6 +1191,18 @@ int SUNMatScaleAdd_Sparse(realtype c, SUNMatrix A, SUNMatrix B)
   if (SM_DATA_S(B))       Bx = SM_DATA_S(B);
   else  return(SUNMAT_MEM_FAIL);
 
+  SMLayoutStale_Sparse(A);
+
+  /* if A and B have the same patterns as in the previous call, reuse the
+     cached merge map */
+  if (SMCacheMatches_Sparse(A, B)) {
+    SMCacheApply_Sparse(c, A, B);
+    SM_CONTENT_S(A)->pattern_changed = SUNFALSE;
+    return SUNMAT_SUCCESS;
+  }
+  SM_CONTENT_S(A)->pattern_changed = SUNTRUE;
+  SMCacheSave_Sparse(A, B);
+
   /* create work arrays for row indices and nonzero column values */
   w = (sunindextype *) malloc(M * sizeof(sunindextype));
   x = (realtype *) malloc(M * sizeof(realtype));
@@ -1002,6 +1385,9 @@ int SUNMatScaleAdd_Sparse(realtype c, SUNMatrix A, SUNMatrix B)
   free(w);
   free(x);
 
+  /* cache the merge map for the next call */
+  SMCacheBuild_Sparse(A, B);
+
   /* return success */
   return(0);
 
@@ -1009,15 +1395,20 @@ int SUNMatScaleAdd_Sparse(realtype c, SUNMatrix A, SUNMatrix B)
 
 int SUNMatMatvec_Sparse(SUNMatrix A, N_Vector x, N_Vector y)
 {
-  /* Verify that A, x and y are compatible */
-  if (!SMCompatible2_Sparse(A, x, y))
-    return SUNMAT_ILL_INPUT;
+  int retval;
+  sunindextype nblocks;
+  realtype *xd, *yd;
 
-  /* Perform operation */
-  if(SM_SPARSETYPE_S(A) == CSC_MAT)
+  retval = SMMatvecSetup_Sparse(A, x, y, &xd, &yd, &nblocks);
+  if (retval != SUNMAT_SUCCESS) return retval;
+
+  /* CSC matrices without a layout are not split into rows */
+  if (nblocks == 0)
     return Matvec_SparseCSC(A, x, y);
-  else
-    return Matvec_SparseCSR(A, x, y);
+
+  SMMatvecBlocks_Sparse(A, xd, yd, 0, nblocks);
+
+  return SUNMAT_SUCCESS;
 }
 
 int SUNMatSpace_Sparse(SUNMatrix A, long int *lenrw, long int *leniw)
@@ -1078,6 +1469,263 @@ static booleantype SMCompatible2_Sparse(SUNMatrix A, N_Vector x, N_Vector y)
 }
 
 
+/* -----------------------------------------------------------------
+ * Function to save the input patterns of SUNMatScaleAdd (B != NULL)
+ * or SUNMatScaleAddI (B == NULL) before A is updated. The maps are
+ * built from them by SMCacheBuild_Sparse once the result is known.
+ */
+
+static void SMCacheSave_Sparse(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype i, np, nnz;
+  struct _SUNSparseMergeCache *cache;
+
+  SUNSparseMatrix_FreeCache(A);
+
+  cache = (struct _SUNSparseMergeCache *) calloc(1, sizeof *cache);
+  if (cache == NULL) return;
+  SM_CONTENT_S(A)->cache = cache;
+
+  np  = SM_NP_S(A);
+  nnz = (SM_INDEXPTRS_S(A))[np];
+  cache->Ap = (sunindextype *) malloc((np+1)*sizeof(sunindextype));
+  cache->Ai = (sunindextype *) malloc(SUNMAX(nnz,1)*sizeof(sunindextype));
+  if (cache->Ap == NULL || cache->Ai == NULL) {
+    SUNSparseMatrix_FreeCache(A);
+    return;
+  }
+  for (i=0; i<=np; i++)  cache->Ap[i] = (SM_INDEXPTRS_S(A))[i];
+  for (i=0; i<nnz; i++)  cache->Ai[i] = (SM_INDEXVALS_S(A))[i];
+
+  if (B == NULL) return;
+
+  nnz = (SM_INDEXPTRS_S(B))[np];
+  cache->Bp = (sunindextype *) malloc((np+1)*sizeof(sunindextype));
+  cache->Bi = (sunindextype *) malloc(SUNMAX(nnz,1)*sizeof(sunindextype));
+  if (cache->Bp == NULL || cache->Bi == NULL) {
+    SUNSparseMatrix_FreeCache(A);
+    return;
+  }
+  for (i=0; i<=np; i++)  cache->Bp[i] = (SM_INDEXPTRS_S(B))[i];
+  for (i=0; i<nnz; i++)  cache->Bi[i] = (SM_INDEXVALS_S(B))[i];
+}
+
+
+/* -----------------------------------------------------------------
+ * Function to build the maps from the saved input patterns to the
+ * pattern of the result now stored in A. The maps are dropped if
+ * the entries of a column of A can not be moved in place, i.e., if
+ * the input columns are not sorted.
+ */
+
+static void SMCacheBuild_Sparse(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype i, j, k, p, q, M, np, ndiag, nnz_a, nnz_b;
+  sunindextype *w, *mark, *Cp, *Ci;
+  booleantype inserted, inplace;
+  struct _SUNSparseMergeCache *cache;
+
+  cache = SM_CONTENT_S(A)->cache;
+  if (cache == NULL) return;
+
+  /* inner dimension, number of outer indices and length of the diagonal */
+  M     = (SM_SPARSETYPE_S(A) == CSC_MAT) ? SM_ROWS_S(A) : SM_COLUMNS_S(A);
+  np    = SM_NP_S(A);
+  ndiag = SUNMIN(SM_ROWS_S(A), SM_COLUMNS_S(A));
+  Cp    = SM_INDEXPTRS_S(A);
+  Ci    = SM_INDEXVALS_S(A);
+  nnz_a = cache->Ap[np];
+  nnz_b = (B) ? cache->Bp[np] : ndiag;
+
+  w    = (sunindextype *) malloc(M*sizeof(sunindextype));
+  mark = (sunindextype *) malloc(M*sizeof(sunindextype));
+  cache->amap = (sunindextype *) malloc(SUNMAX(nnz_a,1)*sizeof(sunindextype));
+  cache->bmap = (sunindextype *) malloc(SUNMAX(nnz_b,1)*sizeof(sunindextype));
+  if (w == NULL || mark == NULL || cache->amap == NULL || cache->bmap == NULL) {
+    free(w);  free(mark);
+    SUNSparseMatrix_FreeCache(A);
+    return;
+  }
+
+  for (i=0; i<M; i++)  mark[i] = -1;
+
+  inserted = SUNFALSE;
+  inplace  = SUNTRUE;
+  for (j=0; j<np; j++) {
+
+    /* w holds the position in the result of each index in this column */
+    for (q=Cp[j]; q<Cp[j+1]; q++)
+      w[Ci[q]] = q;
+
+    /* map the entries of A, marking their indices */
+    for (p=cache->Ap[j]; p<cache->Ap[j+1]; p++) {
+      mark[cache->Ai[p]] = j;
+      cache->amap[p] = w[cache->Ai[p]];
+      if (p > cache->Ap[j] && cache->amap[p] <= cache->amap[p-1])
+        inplace = SUNFALSE;
+    }
+
+    /* map the entries of B (or the diagonal) */
+    if (B) {
+      for (k=cache->Bp[j]; k<cache->Bp[j+1]; k++) {
+        i = cache->Bi[k];
+        if (mark[i] == j) {
+          cache->bmap[k] = w[i];
+        } else {
+          cache->bmap[k] = -(w[i]+1);
+          inserted = SUNTRUE;
+        }
+      }
+    } else if (j < ndiag) {
+      if (mark[j] == j) {
+        cache->bmap[j] = w[j];
+      } else {
+        cache->bmap[j] = -(w[j]+1);
+        inserted = SUNTRUE;
+      }
+    }
+  }
+
+  free(w);
+  free(mark);
+
+  /* without insertions the entries of A stay in place */
+  if (!inserted) {
+    free(cache->amap);
+    cache->amap = NULL;
+  } else if (!inplace) {
+    SUNSparseMatrix_FreeCache(A);
+    return;
+  } else {
+    cache->Cp = (sunindextype *) malloc((np+1)*sizeof(sunindextype));
+    if (cache->Cp == NULL) {
+      SUNSparseMatrix_FreeCache(A);
+      return;
+    }
+    for (j=0; j<=np; j++)  cache->Cp[j] = Cp[j];
+  }
+
+  cache->nnz_c = Cp[np];
+  cache->valid = SUNTRUE;
+}
+
+
+/* -----------------------------------------------------------------
+ * Function to check if the patterns of A and B (or of A alone for
+ * SUNMatScaleAddI) match the patterns the cached maps were built
+ * for, and A has storage for the result
+ */
+
+static booleantype SMCacheMatches_Sparse(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype i, np;
+  sunindextype *Ap, *Ai, *Bp, *Bi;
+  struct _SUNSparseMergeCache *cache;
+
+  /* the cached update reads B after scaling A, so A and B must differ */
+  if (A == B)  return SUNFALSE;
+
+  cache = SM_CONTENT_S(A)->cache;
+  if (cache == NULL || !cache->valid)  return SUNFALSE;
+  if ((B == NULL) != (cache->Bp == NULL))  return SUNFALSE;
+  if (cache->nnz_c > SM_NNZ_S(A))  return SUNFALSE;
+
+  np = SM_NP_S(A);
+  Ap = SM_INDEXPTRS_S(A);
+  Ai = SM_INDEXVALS_S(A);
+  for (i=0; i<=np; i++)
+    if (Ap[i] != cache->Ap[i])  return SUNFALSE;
+  for (i=0; i<Ap[np]; i++)
+    if (Ai[i] != cache->Ai[i])  return SUNFALSE;
+
+  if (B == NULL)  return SUNTRUE;
+
+  Bp = SM_INDEXPTRS_S(B);
+  Bi = SM_INDEXVALS_S(B);
+  for (i=0; i<=np; i++)
+    if (Bp[i] != cache->Bp[i])  return SUNFALSE;
+  for (i=0; i<Bp[np]; i++)
+    if (Bi[i] != cache->Bi[i])  return SUNFALSE;
+
+  return SUNTRUE;
+}
+
+
+/* -----------------------------------------------------------------
+ * Function to compute A = c*A + B (or A = c*A + I if B is NULL)
+ * with the cached maps in a single pass and without allocation
+ */
+
+static void SMCacheApply_Sparse(realtype c, SUNMatrix A, SUNMatrix B)
+{
+  sunindextype j, k, p, q, np, ndiag;
+  sunindextype *Ap, *Ai, *Bp, *Bi, *amap, *bmap;
+  realtype *Ax, *Bx;
+  struct _SUNSparseMergeCache *cache;
+
+  cache = SM_CONTENT_S(A)->cache;
+  amap  = cache->amap;
+  bmap  = cache->bmap;
+
+  np    = SM_NP_S(A);
+  ndiag = SUNMIN(SM_ROWS_S(A), SM_COLUMNS_S(A));
+  Ap    = SM_INDEXPTRS_S(A);
+  Ai    = SM_INDEXVALS_S(A);
+  Ax    = SM_DATA_S(A);
+  Bp    = (B) ? SM_INDEXPTRS_S(B) : NULL;
+  Bi    = (B) ? SM_INDEXVALS_S(B) : NULL;
+  Bx    = (B) ? SM_DATA_S(B) : NULL;
+
+  /* case 1: A contains the pattern of B, update the values in place */
+  if (amap == NULL) {
+    for (j=0; j<np; j++) {
+      for (p=Ap[j]; p<Ap[j+1]; p++)
+        Ax[p] *= c;
+      if (B) {
+        for (k=Bp[j]; k<Bp[j+1]; k++)
+          Ax[bmap[k]] += Bx[k];
+      } else if (j < ndiag) {
+        Ax[bmap[j]] += ONE;
+      }
+    }
+    return;
+  }
+
+  /* case 2: move the entries of A to their positions in the result, last
+     column (row) first so that no entry is overwritten before it is moved,
+     then add or insert the entries of B */
+  for (j=np-1; j>=0; j--) {
+    for (p=Ap[j+1]-1; p>=Ap[j]; p--) {
+      q     = amap[p];
+      Ai[q] = Ai[p];
+      Ax[q] = c*Ax[p];
+    }
+    if (B) {
+      for (k=Bp[j]; k<Bp[j+1]; k++) {
+        q = bmap[k];
+        if (q >= 0) {
+          Ax[q] += Bx[k];
+        } else {
+          Ai[-q-1] = Bi[k];
+          Ax[-q-1] = Bx[k];
+        }
+      }
+    } else if (j < ndiag) {
+      q = bmap[j];
+      if (q >= 0) {
+        Ax[q] += ONE;
+      } else {
+        Ai[-q-1] = j;
+        Ax[-q-1] = ONE;
+      }
+    }
+  }
+
+  for (j=0; j<=np; j++)
+    Ap[j] = cache->Cp[j];
+}
+
+
 /* -----------------------------------------------------------------
  * Computes y=A*x, where A is a CSC SUNMatrix_Sparse of dimension MxN, x is a
  * compatible N_Vector object of length N, and y is a compatible
@@ -1123,45 +1771,315 @@ int Matvec_SparseCSC(SUNMatrix A, N_Vector x, N_Vector y)
 
 
 /* -----------------------------------------------------------------
- * Computes y=A*x, where A is a CSR SUNMatrix_Sparse of dimension MxN, x is a
- * compatible N_Vector object of length N, and y is a compatible
- * N_Vector object of length M.
- *
- * Returns 0 if successful, -1 if unsuccessful (failed memory access).
+ * Checks the inputs of y=A*x, rebuilds the matrix-vector product
+ * layout if the matrix changed since the last product, and returns
+ * the vector data and the number of independent blocks of y (rows, or
+ * chunks of the SELL-C-sigma layout). The number of blocks is zero for
+ * a CSC matrix without a layout, whose product is not split into rows.
+ * The blocks may be computed concurrently with SMMatvecBlocks_Sparse.
  */
-int Matvec_SparseCSR(SUNMatrix A, N_Vector x, N_Vector y)
+int SMMatvecSetup_Sparse(SUNMatrix A, N_Vector x, N_Vector y, realtype **xd,
+                         realtype **yd, sunindextype *nblocks)
 {
-  sunindextype i, j;
-  sunindextype *Ap, *Aj;
-  realtype *Ax, *xd, *yd;
+  struct _SUNSparseMatvecLayout *layout;
 
-  /* access data from CSR structure (return if failure) */
-  Ap = SM_INDEXPTRS_S(A);
-  Aj = SM_INDEXVALS_S(A);
-  Ax = SM_DATA_S(A);
-  if ((Ap == NULL) || (Aj == NULL) || (Ax == NULL))
+  /* Verify that A, x and y are compatible */
+  if (!SMCompatible2_Sparse(A, x, y))
+    return SUNMAT_ILL_INPUT;
+
+  /* build the selected layout if the matrix changed since the last product */
+  layout = SM_CONTENT_S(A)->layout;
+  if (layout != NULL && layout->stale && SMLayoutBuild_Sparse(A))
     return SUNMAT_MEM_FAIL;
 
   /* access vector data (return if failure) */
-  xd = N_VGetArrayPointer(x);
-  yd = N_VGetArrayPointer(y);
-  if ((xd == NULL) || (yd == NULL) || (xd == yd))
+  *xd = N_VGetArrayPointer(x);
+  *yd = N_VGetArrayPointer(y);
+  if ((*xd == NULL) || (*yd == NULL) || (*xd == *yd))
     return SUNMAT_MEM_FAIL;
 
-  /* initialize result */
-  for (i=0; i<SM_ROWS_S(A); i++)
-    yd[i] = 0.0;
+  if (layout != NULL && layout->type == SUNSPARSE_MATVEC_SELL) {
+    if ((layout->cs == NULL) || (layout->cl == NULL) ||
+        (layout->perm == NULL) || (layout->scol == NULL) ||
+        (layout->sval == NULL))
+      return SUNMAT_MEM_FAIL;
+    *nblocks = layout->nchunks;
+  } else if (SM_SPARSETYPE_S(A) == CSR_MAT) {
+    if ((SM_INDEXPTRS_S(A) == NULL) || (SM_INDEXVALS_S(A) == NULL) ||
+        (SM_DATA_S(A) == NULL))
+      return SUNMAT_MEM_FAIL;
+    *nblocks = SM_ROWS_S(A);
+  } else if (layout != NULL) {
+    if ((layout->rp == NULL) || (layout->ci == NULL) || (layout->v == NULL))
+      return SUNMAT_MEM_FAIL;
+    *nblocks = SM_ROWS_S(A);
+  } else {
+    *nblocks = 0;
+  }
+
+  return SUNMAT_SUCCESS;
+}
+
+
+/* -----------------------------------------------------------------
+ * Computes the blocks start to end-1 of y=A*x after a successful call
+ * to SMMatvecSetup_Sparse.
+ */
+void SMMatvecBlocks_Sparse(SUNMatrix A, const realtype *xd, realtype *yd,
+                           sunindextype start, sunindextype end)
+{
+  if (SM_CONTENT_S(A)->layout != NULL &&
+      SM_CONTENT_S(A)->layout->type == SUNSPARSE_MATVEC_SELL)
+    Matvec_SparseSELL(A, xd, yd, start, end);
+  else
+    Matvec_SparseCSR(A, xd, yd, start, end);
+}
+
+
+/* -----------------------------------------------------------------
+ * Computes the rows start to end-1 of y=A*x, where A is a CSR
+ * SUNMatrix_Sparse. For a CSC matrix the CSR copy held by the
+ * matrix-vector product layout is used.
+ */
+static void Matvec_SparseCSR(SUNMatrix A, const realtype *xd, realtype *yd,
+                             sunindextype start, sunindextype end)
+{
+  sunindextype i, j;
+  sunindextype *Ap, *Aj;
+  realtype *Ax, sum;
+
+  /* access data from CSR structure */
+  if (SM_SPARSETYPE_S(A) == CSR_MAT) {
+    Ap = SM_INDEXPTRS_S(A);
+    Aj = SM_INDEXVALS_S(A);
+    Ax = SM_DATA_S(A);
+  } else {
+    Ap = SM_CONTENT_S(A)->layout->rp;
+    Aj = SM_CONTENT_S(A)->layout->ci;
+    Ax = SM_CONTENT_S(A)->layout->v;
+  }
 
   /* iterate through matrix rows */
-  for (i=0; i<SM_ROWS_S(A); i++) {
+  for (i=start; i<end; i++) {
 
     /* iterate along row of A, performing product */
+    sum = ZERO;
     for (j=Ap[i]; j<Ap[i+1]; j++)
-      yd[i] += Ax[j]*xd[Aj[j]];
+      sum += Ax[j]*xd[Aj[j]];
+    yd[i] = sum;
 
   }
+}
 
-  return(0);
+
+/* -----------------------------------------------------------------
+ * Computes the chunks start to end-1 of y=A*x with the SELL-C-sigma
+ * copy of A. The C lanes of a chunk are accumulated together.
+ */
+static void Matvec_SparseSELL(SUNMatrix A, const realtype *xd, realtype *yd,
+                              sunindextype start, sunindextype end)
+{
+  sunindextype k, j, r, off, C;
+  sunindextype *cs, *cl, *perm, *scol;
+  realtype *sval;
+  realtype sum[SELL_MAX_C];
+
+  C    = SM_CONTENT_S(A)->layout->C;
+  cs   = SM_CONTENT_S(A)->layout->cs;
+  cl   = SM_CONTENT_S(A)->layout->cl;
+  perm = SM_CONTENT_S(A)->layout->perm;
+  scol = SM_CONTENT_S(A)->layout->scol;
+  sval = SM_CONTENT_S(A)->layout->sval;
+
+  for (k=start; k<end; k++) {
+
+    for (r=0; r<C; r++)
+      sum[r] = ZERO;
+
+    /* the j-th entries of the C rows in the chunk are contiguous */
+    off = cs[k];
+    for (j=0; j<cl[k]; j++) {
+      SUNSPARSE_PRAGMA_SIMD
+      for (r=0; r<C; r++)
+        sum[r] += sval[off+r]*xd[scol[off+r]];
+      off += C;
+    }
+
+    for (r=0; r<C; r++)
+      if (perm[k*C+r] >= 0)
+        yd[perm[k*C+r]] = sum[r];
+
+  }
+}
+
+
+/* -----------------------------------------------------------------
+ * Functions to build, free, and invalidate the copy of the matrix
+ * used by the matrix-vector product
+ */
+
+/* length and index of a row, used to sort rows by decreasing length */
+typedef struct {
+  sunindextype len;
+  sunindextype row;
+} SMRowLength;
+
+static int SMCompareRows(const void *a, const void *b)
+{
+  const SMRowLength *ra = (const SMRowLength *) a;
+  const SMRowLength *rb = (const SMRowLength *) b;
+  if (ra->len != rb->len) return (ra->len > rb->len) ? -1 : 1;
+  return (ra->row < rb->row) ? -1 : (ra->row > rb->row);
+}
+
+static int SMLayoutBuild_Sparse(SUNMatrix A)
+{
+  sunindextype i, j, k, p, q, r, M, C, nchunks, nnz, len;
+  sunindextype *rp, *ci, *Ap, *Ai;
+  realtype *v, *Ax;
+  SMRowLength *rows;
+  struct _SUNSparseMatvecLayout *layout;
+
+  layout = SM_CONTENT_S(A)->layout;
+  SMLayoutClear_Sparse(A);
+
+  M  = SM_ROWS_S(A);
+  Ap = SM_INDEXPTRS_S(A);
+  Ai = SM_INDEXVALS_S(A);
+  Ax = SM_DATA_S(A);
+
+  /* the rows of A, transposing a CSC matrix */
+  if (SM_SPARSETYPE_S(A) == CSR_MAT) {
+    rp = Ap;
+    ci = Ai;
+    v  = Ax;
+  } else {
+    nnz = Ap[SM_NP_S(A)];
+    layout->rp = (sunindextype *) calloc(M+1, sizeof(sunindextype));
+    layout->ci = (sunindextype *) malloc(SUNMAX(nnz,1)*sizeof(sunindextype));
+    layout->v  = (realtype *) malloc(SUNMAX(nnz,1)*sizeof(realtype));
+    if (layout->rp == NULL || layout->ci == NULL || layout->v == NULL) {
+      SMLayoutClear_Sparse(A);
+      return SUNMAT_MEM_FAIL;
+    }
+    rp = layout->rp;
+    ci = layout->ci;
+    v  = layout->v;
+
+    for (p=0; p<nnz; p++) rp[Ai[p]+1]++;
+    for (i=0; i<M; i++) rp[i+1] += rp[i];
+    for (j=0; j<SM_NP_S(A); j++) {
+      for (p=Ap[j]; p<Ap[j+1]; p++) {
+        q     = rp[Ai[p]]++;
+        ci[q] = j;
+        v[q]  = Ax[p];
+      }
+    }
+    for (i=M; i>0; i--) rp[i] = rp[i-1];
+    rp[0] = 0;
+  }
+
+  if (layout->type == SUNSPARSE_MATVEC_CSR) {
+    layout->stale = SUNFALSE;
+    return SUNMAT_SUCCESS;
+  }
+
+  /* SELL-C-sigma: sort the rows by decreasing length within each window */
+  C       = layout->C;
+  nchunks = (M + C - 1) / C;
+
+  rows         = (SMRowLength *) malloc(M*sizeof(SMRowLength));
+  layout->perm = (sunindextype *) malloc(nchunks*C*sizeof(sunindextype));
+  layout->cs   = (sunindextype *) malloc((nchunks+1)*sizeof(sunindextype));
+  layout->cl   = (sunindextype *) malloc(nchunks*sizeof(sunindextype));
+  if (rows == NULL || layout->perm == NULL || layout->cs == NULL ||
+      layout->cl == NULL) {
+    free(rows);
+    SMLayoutClear_Sparse(A);
+    return SUNMAT_MEM_FAIL;
+  }
+
+  for (i=0; i<M; i++) {
+    rows[i].len = rp[i+1] - rp[i];
+    rows[i].row = i;
+  }
+  for (i=0; i<M; i+=layout->sigma)
+    qsort(rows+i, (size_t) SUNMIN(layout->sigma, M-i), sizeof(SMRowLength),
+          SMCompareRows);
+
+  for (i=0; i<nchunks*C; i++)
+    layout->perm[i] = (i < M) ? rows[i].row : -1;
+  free(rows);
+
+  /* each chunk is as wide as its longest row */
+  layout->cs[0] = 0;
+  for (k=0; k<nchunks; k++) {
+    layout->cl[k] = 0;
+    for (r=0; r<C; r++) {
+      i = layout->perm[k*C+r];
+      if (i >= 0) layout->cl[k] = SUNMAX(layout->cl[k], rp[i+1]-rp[i]);
+    }
+    layout->cs[k+1] = layout->cs[k] + layout->cl[k]*C;
+  }
+  layout->nchunks = nchunks;
+
+  nnz          = layout->cs[nchunks];
+  layout->scol = (sunindextype *) malloc(SUNMAX(nnz,1)*sizeof(sunindextype));
+  layout->sval = (realtype *) malloc(SUNMAX(nnz,1)*sizeof(realtype));
+  if (layout->scol == NULL || layout->sval == NULL) {
+    SMLayoutClear_Sparse(A);
+    return SUNMAT_MEM_FAIL;
+  }
+
+  /* store the chunks column by column, padding with zeros */
+  for (k=0; k<nchunks; k++) {
+    for (r=0; r<C; r++) {
+      i   = layout->perm[k*C+r];
+      len = (i >= 0) ? rp[i+1]-rp[i] : 0;
+      for (j=0; j<layout->cl[k]; j++) {
+        q = layout->cs[k] + j*C + r;
+        if (j < len) {
+          layout->scol[q] = ci[rp[i]+j];
+          layout->sval[q] = v[rp[i]+j];
+        } else {
+          layout->scol[q] = 0;
+          layout->sval[q] = ZERO;
+        }
+      }
+    }
+  }
+
+  /* the CSR copy of a CSC matrix is only needed to build the chunks */
+  free(layout->rp);  layout->rp = NULL;
+  free(layout->ci);  layout->ci = NULL;
+  free(layout->v);   layout->v  = NULL;
+
+  layout->stale = SUNFALSE;
+  return SUNMAT_SUCCESS;
+}
+
+static void SMLayoutClear_Sparse(SUNMatrix A)
+{
+  struct _SUNSparseMatvecLayout *layout = SM_CONTENT_S(A)->layout;
+
+  if (layout == NULL) return;
+
+  free(layout->rp);    layout->rp   = NULL;
+  free(layout->ci);    layout->ci   = NULL;
+  free(layout->v);     layout->v    = NULL;
+  free(layout->cs);    layout->cs   = NULL;
+  free(layout->cl);    layout->cl   = NULL;
+  free(layout->perm);  layout->perm = NULL;
+  free(layout->scol);  layout->scol = NULL;
+  free(layout->sval);  layout->sval = NULL;
+  layout->nchunks = 0;
+  layout->stale   = SUNTRUE;
+}
+
+static void SMLayoutStale_Sparse(SUNMatrix A)
+{
+  if (SM_CONTENT_S(A)->layout != NULL)
+    SM_CONTENT_S(A)->layout->stale = SUNTRUE;
 }
 
 
@@ -0,0 +1,40 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Private functions of the sparse SUNMATRIX used by the threaded
+ * matrix-vector product in sunmatrix_sparse_threads.c.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNMATRIX_SPARSE_IMPL_H
+#define _SUNMATRIX_SPARSE_IMPL_H
+
+#include <sunmatrix/sunmatrix_sparse.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Checks the inputs of y = A x and returns the number of independent
+   blocks of y, zero if the product is not split into blocks */
+int SMMatvecSetup_Sparse(SUNMatrix A, N_Vector x, N_Vector y, realtype **xd,
+                         realtype **yd, sunindextype *nblocks);
+
+/* Computes the blocks start to end-1 of y = A x */
+void SMMatvecBlocks_Sparse(SUNMatrix A, const realtype *xd, realtype *yd,
+                           sunindextype start, sunindextype end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
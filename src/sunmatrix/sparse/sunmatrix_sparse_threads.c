@@ -0,0 +1,75 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the OpenMP threaded
+ * matrix-vector product of the sparse SUNMATRIX. It is only part of
+ * the SUNMATRIX_SPARSE library, the packages that include the sparse
+ * matrix do not depend on OpenMP.
+ * -----------------------------------------------------------------
+ */
+
+#include <sunmatrix/sunmatrix_sparse.h>
+
+#include "sunmatrix_sparse_impl.h"
+
+#if defined(_OPENMP)
+
+/* -----------------------------------------------------------------
+ * Computes y=A*x with the blocks of y divided evenly among the
+ * threads of the matrix
+ */
+static int SUNMatMatvec_SparseThreads(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int retval, t, nt;
+  sunindextype nblocks;
+  realtype *xd, *yd;
+
+  retval = SMMatvecSetup_Sparse(A, x, y, &xd, &yd, &nblocks);
+  if (retval != SUNMAT_SUCCESS) return retval;
+
+  /* CSC matrices without a layout are not split into rows */
+  if (nblocks == 0)
+    return SUNMatMatvec_Sparse(A, x, y);
+
+  nt = SM_NUM_THREADS_S(A);
+  if (nt > nblocks) nt = (int) nblocks;
+
+#pragma omp parallel for num_threads(nt) schedule(static)
+  for (t=0; t<nt; t++)
+    SMMatvecBlocks_Sparse(A, xd, yd, (nblocks * t) / nt,
+                          (nblocks * (t + 1)) / nt);
+
+  return SUNMAT_SUCCESS;
+}
+
+#endif
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of OpenMP threads used by SUNMatMatvec. Without
+ * OpenMP the product is always computed by the calling thread.
+ */
+
+int SUNSparseMatrix_SetNumThreads(SUNMatrix A, int num_threads)
+{
+  /* check for valid inputs */
+  if (A == NULL || SUNMatGetID(A) != SUNMATRIX_SPARSE || num_threads < 1)
+    return SUNMAT_ILL_INPUT;
+
+  SM_NUM_THREADS_S(A) = num_threads;
+
+#if defined(_OPENMP)
+  A->ops->matvec = (num_threads > 1) ? SUNMatMatvec_SparseThreads
+                                     : SUNMatMatvec_Sparse;
+#endif
+
+  return SUNMAT_SUCCESS;
+}
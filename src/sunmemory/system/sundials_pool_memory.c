@@ -0,0 +1,312 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * SUNDIALS memory helper implementation that keeps freed host
+ * blocks in size classes and reuses them for later allocations.
+ * The sizes of the classes grow geometrically with four classes
+ * between consecutive powers of two, so a block is at most 25%
+ * larger than the request. Blocks are aligned to
+ * SUNMEMORY_POOL_ALIGNMENT bytes.
+ * ----------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_math.h>
+#include <sunmemory/sunmemory_pool.h>
+
+#include "sundials_debug.h"
+
+/* The smallest block is 2^SUNPOOL_MIN_SHIFT bytes */
+#define SUNPOOL_MIN_SHIFT   6
+#define SUNPOOL_NUM_CLASSES (4 * (8 * (int) sizeof(size_t) - SUNPOOL_MIN_SHIFT) + 1)
+
+struct SUNMemoryHelper_Content_Pool_
+{
+  void* free_list[SUNPOOL_NUM_CLASSES]; /* cached blocks of each class */
+  unsigned long num_allocations;
+  unsigned long num_deallocations;
+  unsigned long num_reuses;
+  size_t bytes_allocated;
+  size_t bytes_high_watermark;
+  size_t bytes_cached;
+  size_t max_bytes_cached;
+};
+
+typedef struct SUNMemoryHelper_Content_Pool_ SUNMemoryHelper_Content_Pool;
+
+#define SUNHELPER_CONTENT(h) ((SUNMemoryHelper_Content_Pool*)h->content)
+
+/* Find the size class of a request and the size of its blocks */
+static int sunPoolClass(size_t bytes, size_t* block_bytes)
+{
+  int p = SUNPOOL_MIN_SHIFT;
+  size_t base, step, k;
+
+  if (bytes <= ((size_t) 1 << SUNPOOL_MIN_SHIFT))
+  {
+    *block_bytes = (size_t) 1 << SUNPOOL_MIN_SHIFT;
+    return 0;
+  }
+
+  /* 2^p < bytes <= 2^(p+1) */
+  while (p + 1 < 8 * (int) sizeof(size_t) && ((size_t) 1 << (p + 1)) < bytes)
+    p++;
+
+  base = (size_t) 1 << p;
+  step = base >> 2;
+  k    = (bytes - base + step - 1) / step; /* 1, 2, 3, or 4 */
+
+  *block_bytes = base + k * step;
+  return 1 + 4 * (p - SUNPOOL_MIN_SHIFT) + (int) (k - 1);
+}
+
+/* Allocate an aligned block, the address returned by malloc is stored just
+   before the block */
+static void* sunPoolAlignedAlloc(size_t bytes)
+{
+  char* base;
+  uintptr_t aligned;
+
+  base = (char*) malloc(bytes + SUNMEMORY_POOL_ALIGNMENT + sizeof(void*));
+  if (base == NULL) return NULL;
+
+  aligned = ((uintptr_t) (base + sizeof(void*)) + SUNMEMORY_POOL_ALIGNMENT - 1)
+            & ~((uintptr_t) SUNMEMORY_POOL_ALIGNMENT - 1);
+  ((void**) aligned)[-1] = base;
+
+  return (void*) aligned;
+}
+
+static void sunPoolAlignedFree(void* ptr)
+{
+  if (ptr) free(((void**) ptr)[-1]);
+}
+
+SUNMemoryHelper SUNMemoryHelper_Pool(SUNContext sunctx)
+{
+  SUNMemoryHelper helper;
+
+  /* Allocate the helper */
+  helper = SUNMemoryHelper_NewEmpty(sunctx);
+  if (helper == NULL) return NULL;
+
+  /* Set the ops */
+  helper->ops->alloc         = SUNMemoryHelper_Alloc_Pool;
+  helper->ops->dealloc       = SUNMemoryHelper_Dealloc_Pool;
+  helper->ops->copy          = SUNMemoryHelper_Copy_Pool;
+  helper->ops->getallocstats = SUNMemoryHelper_GetAllocStats_Pool;
+  helper->ops->clone         = SUNMemoryHelper_Clone_Pool;
+  helper->ops->destroy       = SUNMemoryHelper_Destroy_Pool;
+
+  /* Attach content */
+  helper->content =
+    (SUNMemoryHelper_Content_Pool*)calloc(1, sizeof(SUNMemoryHelper_Content_Pool));
+  if (helper->content == NULL)
+  {
+    SUNMemoryHelper_Destroy_Pool(helper);
+    return NULL;
+  }
+  SUNHELPER_CONTENT(helper)->max_bytes_cached = (size_t) -1;
+
+  return helper;
+}
+
+int SUNMemoryHelper_SetMaxCached_Pool(SUNMemoryHelper helper,
+                                      size_t max_bytes_cached)
+{
+  if (helper == NULL || helper->content == NULL) return (-1);
+  SUNHELPER_CONTENT(helper)->max_bytes_cached = max_bytes_cached;
+  if (SUNHELPER_CONTENT(helper)->bytes_cached > max_bytes_cached)
+    return SUNMemoryHelper_ReleaseCached_Pool(helper);
+  return (0);
+}
+
+int SUNMemoryHelper_ReleaseCached_Pool(SUNMemoryHelper helper)
+{
+  int i;
+  void* block;
+  void* next;
+
+  if (helper == NULL || helper->content == NULL) return (-1);
+
+  for (i = 0; i < SUNPOOL_NUM_CLASSES; i++)
+  {
+    for (block = SUNHELPER_CONTENT(helper)->free_list[i]; block; block = next)
+    {
+      next = *((void**) block);
+      sunPoolAlignedFree(block);
+    }
+    SUNHELPER_CONTENT(helper)->free_list[i] = NULL;
+  }
+  SUNHELPER_CONTENT(helper)->bytes_cached = 0;
+
+  return (0);
+}
+
+int SUNMemoryHelper_GetPoolStats_Pool(SUNMemoryHelper helper,
+                                      unsigned long* num_reuses,
+                                      size_t* bytes_cached)
+{
+  if (helper == NULL || helper->content == NULL) return (-1);
+  *num_reuses   = SUNHELPER_CONTENT(helper)->num_reuses;
+  *bytes_cached = SUNHELPER_CONTENT(helper)->bytes_cached;
+  return (0);
+}
+
+int SUNMemoryHelper_Alloc_Pool(SUNMemoryHelper helper, SUNMemory* memptr,
+                               size_t mem_size, SUNMemoryType mem_type,
+                               void* queue)
+{
+  int k;
+  size_t block_bytes;
+  SUNMemory mem;
+
+  if (mem_type != SUNMEMTYPE_HOST)
+  {
+    SUNDIALS_DEBUG_PRINT(
+      "ERROR in SUNMemoryHelper_Alloc_Pool: unsupported memory type\n");
+    return (-1);
+  }
+
+  mem = SUNMemoryNewEmpty();
+  if (mem == NULL) return (-1);
+
+  mem->ptr   = NULL;
+  mem->own   = SUNTRUE;
+  mem->type  = mem_type;
+  mem->bytes = mem_size;
+
+  k = sunPoolClass(mem_size, &block_bytes);
+
+  /* Reuse a cached block of this class if there is one */
+  if (SUNHELPER_CONTENT(helper)->free_list[k])
+  {
+    mem->ptr = SUNHELPER_CONTENT(helper)->free_list[k];
+    SUNHELPER_CONTENT(helper)->free_list[k] = *((void**) mem->ptr);
+    SUNHELPER_CONTENT(helper)->bytes_cached -= block_bytes;
+    SUNHELPER_CONTENT(helper)->num_reuses++;
+  }
+  else
+  {
+    mem->ptr = sunPoolAlignedAlloc(block_bytes);
+    if (mem->ptr == NULL)
+    {
+      /* Return the cached blocks to the system and try again */
+      SUNMemoryHelper_ReleaseCached_Pool(helper);
+      mem->ptr = sunPoolAlignedAlloc(block_bytes);
+    }
+    if (mem->ptr == NULL)
+    {
+      SUNDIALS_DEBUG_PRINT(
+        "ERROR in SUNMemoryHelper_Alloc_Pool: malloc returned NULL\n");
+      free(mem);
+      return (-1);
+    }
+  }
+
+  SUNHELPER_CONTENT(helper)->bytes_allocated += block_bytes;
+  SUNHELPER_CONTENT(helper)->num_allocations++;
+  SUNHELPER_CONTENT(helper)->bytes_high_watermark =
+    SUNMAX(SUNHELPER_CONTENT(helper)->bytes_allocated,
+           SUNHELPER_CONTENT(helper)->bytes_high_watermark);
+
+  *memptr = mem;
+  return (0);
+}
+
+int SUNMemoryHelper_Dealloc_Pool(SUNMemoryHelper helper, SUNMemory mem,
+                                 void* queue)
+{
+  int k;
+  size_t block_bytes;
+
+  if (mem == NULL) return (0);
+
+  if (mem->ptr != NULL && mem->own)
+  {
+    if (mem->type != SUNMEMTYPE_HOST)
+    {
+      SUNDIALS_DEBUG_PRINT(
+        "ERROR in SUNMemoryHelper_Dealloc_Pool: unsupported memory type\n");
+      return (-1);
+    }
+
+    k = sunPoolClass(mem->bytes, &block_bytes);
+
+    SUNHELPER_CONTENT(helper)->num_deallocations++;
+    SUNHELPER_CONTENT(helper)->bytes_allocated -= block_bytes;
+
+    /* Cache the block unless the cache is full */
+    if (SUNHELPER_CONTENT(helper)->bytes_cached + block_bytes <=
+        SUNHELPER_CONTENT(helper)->max_bytes_cached)
+    {
+      *((void**) mem->ptr) = SUNHELPER_CONTENT(helper)->free_list[k];
+      SUNHELPER_CONTENT(helper)->free_list[k] = mem->ptr;
+      SUNHELPER_CONTENT(helper)->bytes_cached += block_bytes;
+    }
+    else { sunPoolAlignedFree(mem->ptr); }
+
+    mem->ptr = NULL;
+  }
+
+  free(mem);
+  return (0);
+}
+
+int SUNMemoryHelper_Copy_Pool(SUNMemoryHelper helper, SUNMemory dst,
+                              SUNMemory src, size_t memory_size, void* queue)
+{
+  memcpy(dst->ptr, src->ptr, memory_size);
+  return (0);
+}
+
+int SUNMemoryHelper_GetAllocStats_Pool(SUNMemoryHelper helper,
+                                       SUNMemoryType mem_type,
+                                       unsigned long* num_allocations,
+                                       unsigned long* num_deallocations,
+                                       size_t* bytes_allocated,
+                                       size_t* bytes_high_watermark)
+{
+  if (mem_type == SUNMEMTYPE_HOST)
+  {
+    *num_allocations      = SUNHELPER_CONTENT(helper)->num_allocations;
+    *num_deallocations    = SUNHELPER_CONTENT(helper)->num_deallocations;
+    *bytes_allocated      = SUNHELPER_CONTENT(helper)->bytes_allocated;
+    *bytes_high_watermark = SUNHELPER_CONTENT(helper)->bytes_high_watermark;
+  }
+  else { return -1; }
+  return 0;
+}
+
+SUNMemoryHelper SUNMemoryHelper_Clone_Pool(SUNMemoryHelper helper)
+{
+  SUNMemoryHelper hclone = SUNMemoryHelper_Pool(helper->sunctx);
+  if (hclone)
+    SUNHELPER_CONTENT(hclone)->max_bytes_cached =
+      SUNHELPER_CONTENT(helper)->max_bytes_cached;
+  return hclone;
+}
+
+int SUNMemoryHelper_Destroy_Pool(SUNMemoryHelper helper)
+{
+  if (helper)
+  {
+    if (helper->content)
+    {
+      SUNMemoryHelper_ReleaseCached_Pool(helper);
+      free(helper->content);
+    }
+    if (helper->ops) { free(helper->ops); }
+    free(helper);
+  }
+  return 0;
+}
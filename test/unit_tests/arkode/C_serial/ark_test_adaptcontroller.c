@@ -0,0 +1,352 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for SUNAdaptController objects in ARKODE. The Prothero-Robinson
+ * problem
+ *
+ *   y' = lambda (y - cos(t)) - sin(t),  y(0) = 1
+ *
+ * with exact solution y = cos(t) is integrated with ARKStep (DIRK), ERKStep,
+ * and MRIStep using the Soderlind controllers. The I controller object must
+ * reproduce the built-in I controller exactly, and all controllers must
+ * produce solutions within the expected error bounds. The step and error
+ * test failure counts of each controller are printed for comparison.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "arkode/arkode_arkstep.h"
+#include "arkode/arkode_erkstep.h"
+#include "arkode/arkode_mristep.h"
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunadaptcontroller/sunadaptcontroller_soderlind.h"
+#include "sundials/sundials_math.h"
+
+#define ZERO   SUN_RCONST(0.0)
+#define ONE    SUN_RCONST(1.0)
+#define TF     SUN_RCONST(5.0)
+#define LAMBDA SUN_RCONST(-100.0)
+
+typedef SUNAdaptController (*ControllerFn)(SUNContext sunctx);
+
+/* Full, stiff, and nonstiff right-hand side functions */
+static int ffull(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  NV_Ith_S(ydot, 0) = LAMBDA * (NV_Ith_S(y, 0) - cos(t)) - sin(t);
+  return 0;
+}
+
+static int fstiff(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  NV_Ith_S(ydot, 0) = LAMBDA * (NV_Ith_S(y, 0) - cos(t));
+  return 0;
+}
+
+static int fnonstiff(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  NV_Ith_S(ydot, 0) = -sin(t);
+  return 0;
+}
+
+/* Integrate with the given stepper (0 = ARKStep, 1 = ERKStep, 2 = MRIStep)
+   and controller (NULL = built-in adaptivity method imethod) */
+static int Integrate(int stepper, SUNAdaptController C, int imethod,
+                     N_Vector y, long int *nst, long int *netf,
+                     SUNContext sunctx)
+{
+  int                 retval;
+  realtype            t;
+  SUNMatrix           A  = NULL;
+  SUNLinearSolver     LS = NULL;
+  void                *arkode_mem, *inner_mem = NULL;
+  MRIStepInnerStepper inner_stepper = NULL;
+
+  NV_Ith_S(y, 0) = ONE;
+  *netf = 0;
+
+  if (stepper == 0)
+  {
+    arkode_mem = ARKStepCreate(NULL, ffull, ZERO, y, sunctx);
+    if (!arkode_mem) return 1;
+
+    A  = SUNDenseMatrix(1, 1, sunctx);
+    LS = SUNLinSol_Dense(y, A, sunctx);
+    retval = ARKStepSetLinearSolver(arkode_mem, LS, A);
+    if (retval) return retval;
+
+    retval = ARKStepSStolerances(arkode_mem, SUN_RCONST(1.0e-6),
+                                 SUN_RCONST(1.0e-10));
+    if (retval) return retval;
+
+    retval = ARKStepSetMaxNumSteps(arkode_mem, 100000);
+    if (retval) return retval;
+
+    retval = ARKStepSetAdaptivityMethod(arkode_mem, imethod, 1, 0, NULL);
+    if (retval) return retval;
+
+    if (C)
+    {
+      retval = ARKStepSetAdaptController(arkode_mem, C);
+      if (retval) return retval;
+    }
+
+    retval = ARKStepEvolve(arkode_mem, TF, y, &t, ARK_NORMAL);
+    if (retval < 0) return retval;
+
+    ARKStepGetNumSteps(arkode_mem, nst);
+    ARKStepGetNumErrTestFails(arkode_mem, netf);
+    ARKStepFree(&arkode_mem);
+  }
+  else if (stepper == 1)
+  {
+    arkode_mem = ERKStepCreate(ffull, ZERO, y, sunctx);
+    if (!arkode_mem) return 1;
+
+    retval = ERKStepSStolerances(arkode_mem, SUN_RCONST(1.0e-6),
+                                 SUN_RCONST(1.0e-10));
+    if (retval) return retval;
+
+    retval = ERKStepSetMaxNumSteps(arkode_mem, 100000);
+    if (retval) return retval;
+
+    retval = ERKStepSetAdaptivityMethod(arkode_mem, imethod, 1, 0, NULL);
+    if (retval) return retval;
+
+    if (C)
+    {
+      retval = ERKStepSetAdaptController(arkode_mem, C);
+      if (retval) return retval;
+    }
+
+    retval = ERKStepEvolve(arkode_mem, TF, y, &t, ARK_NORMAL);
+    if (retval < 0) return retval;
+
+    ERKStepGetNumSteps(arkode_mem, nst);
+    ERKStepGetNumErrTestFails(arkode_mem, netf);
+    ERKStepFree(&arkode_mem);
+  }
+  else
+  {
+    inner_mem = ARKStepCreate(fstiff, NULL, ZERO, y, sunctx);
+    if (!inner_mem) return 1;
+
+    retval = ARKStepSetFixedStep(inner_mem, SUN_RCONST(1.0e-3));
+    if (retval) return retval;
+
+    retval = ARKStepSetMaxNumSteps(inner_mem, 100000);
+    if (retval) return retval;
+
+    retval = ARKStepCreateMRIStepInnerStepper(inner_mem, &inner_stepper);
+    if (retval) return retval;
+
+    arkode_mem = MRIStepCreate(fnonstiff, NULL, ZERO, y, inner_stepper,
+                               sunctx);
+    if (!arkode_mem) return 1;
+
+    retval = MRIStepSStolerances(arkode_mem, SUN_RCONST(1.0e-6),
+                                 SUN_RCONST(1.0e-10));
+    if (retval) return retval;
+
+    retval = MRIStepSetMaxNumSteps(arkode_mem, 100000);
+    if (retval) return retval;
+
+    if (C)
+    {
+      retval = MRIStepSetAdaptController(arkode_mem, C);
+      if (retval) return retval;
+    }
+
+    retval = MRIStepEvolve(arkode_mem, TF, y, &t, ARK_NORMAL);
+    if (retval < 0) return retval;
+
+    MRIStepGetNumSteps(arkode_mem, nst);
+    MRIStepGetNumErrTestFails(arkode_mem, netf);
+    MRIStepFree(&arkode_mem);
+    ARKStepFree(&inner_mem);
+    MRIStepInnerStepper_Free(&inner_stepper);
+  }
+
+  if (LS) SUNLinSolFree(LS);
+  if (A) SUNMatDestroy(A);
+
+  return 0;
+}
+
+/* The I controller object must reproduce the built-in I controller */
+static int TestBuiltIn(int stepper, SUNContext sunctx)
+{
+  int                retval;
+  long int           nst_ref, netf_ref, nst, netf;
+  N_Vector           y_ref, y;
+  SUNAdaptController C;
+
+  y_ref = N_VNew_Serial(1, sunctx);
+  y     = N_VNew_Serial(1, sunctx);
+  C     = SUNAdaptController_I(sunctx);
+
+  retval = Integrate(stepper, NULL, ARK_ADAPT_I, y_ref, &nst_ref, &netf_ref,
+                     sunctx);
+  if (retval) return 1;
+
+  retval = Integrate(stepper, C, ARK_ADAPT_PID, y, &nst, &netf, sunctx);
+  if (retval) return 1;
+
+  printf("stepper %i, built-in I controller: steps %ld (object %ld), "
+         "error test fails %ld (object %ld)\n", stepper, nst_ref, nst,
+         netf_ref, netf);
+
+  retval = (nst != nst_ref || netf != netf_ref ||
+            NV_Ith_S(y, 0) != NV_Ith_S(y_ref, 0));
+  if (retval) fprintf(stderr, "controller object differs from built-in\n");
+
+  SUNAdaptController_Destroy(C);
+  N_VDestroy(y_ref);
+  N_VDestroy(y);
+
+  return retval;
+}
+
+/* Each controller must reach TF within the error bound */
+static int TestController(int stepper, const char *name, ControllerFn create,
+                          SUNContext sunctx)
+{
+  int                retval;
+  long int           nst, netf;
+  realtype           err;
+  N_Vector           y;
+  SUNAdaptController C;
+
+  y = N_VNew_Serial(1, sunctx);
+  C = create(sunctx);
+  if (!C) return 1;
+
+  if (SUNAdaptController_GetType(C) != SUN_ADAPTCONTROLLER_H)
+  {
+    fprintf(stderr, "unexpected controller type\n");
+    return 1;
+  }
+
+  retval = Integrate(stepper, C, ARK_ADAPT_PID, y, &nst, &netf, sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "integration with %s failed\n", name);
+    return 1;
+  }
+
+  err = SUNRabs(NV_Ith_S(y, 0) - cos(TF));
+
+  printf("stepper %i, %-6s controller: steps %5ld, error test fails %3ld, "
+         "error %.2e\n", stepper, name, nst, netf, (double) err);
+
+  SUNAdaptController_Destroy(C);
+  N_VDestroy(y);
+
+  if (err > SUN_RCONST(1.0e-4))
+  {
+    fprintf(stderr, "error exceeds the tolerance\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+/* The controller history is reset and the step estimate must not depend on
+   the errors of previous steps */
+static int TestReset(SUNContext sunctx)
+{
+  int                retval = 0;
+  long int           lenrw, leniw;
+  realtype           h1, h2;
+  SUNAdaptController C;
+
+  C = SUNAdaptController_H211(sunctx);
+
+  SUNAdaptController_EstimateStep(C, SUN_RCONST(0.1), 3, SUN_RCONST(0.5),
+                                  &h1);
+  SUNAdaptController_UpdateH(C, SUN_RCONST(0.1), SUN_RCONST(0.01));
+  SUNAdaptController_UpdateH(C, SUN_RCONST(0.2), SUN_RCONST(2.0));
+  SUNAdaptController_Reset(C);
+  SUNAdaptController_EstimateStep(C, SUN_RCONST(0.1), 3, SUN_RCONST(0.5),
+                                  &h2);
+  if (h1 != h2 || h1 <= SUN_RCONST(0.1))
+  {
+    fprintf(stderr, "controller reset failed\n");
+    retval = 1;
+  }
+
+  SUNAdaptController_Space(C, &lenrw, &leniw);
+  if (lenrw <= 0)
+  {
+    fprintf(stderr, "controller space is not reported\n");
+    retval = 1;
+  }
+
+  SUNAdaptController_Destroy(C);
+
+  return retval;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  int        stepper;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestReset(sunctx);
+
+  for (stepper = 0; stepper < 3; stepper++)
+  {
+    if (stepper < 2) retval += TestBuiltIn(stepper, sunctx);
+    retval += TestController(stepper, "PID",    SUNAdaptController_PID,
+                             sunctx);
+    retval += TestController(stepper, "PI",     SUNAdaptController_PI,
+                             sunctx);
+    retval += TestController(stepper, "ExpGus", SUNAdaptController_ExpGus,
+                             sunctx);
+    retval += TestController(stepper, "ImpGus", SUNAdaptController_ImpGus,
+                             sunctx);
+    retval += TestController(stepper, "H0211",  SUNAdaptController_H0211,
+                             sunctx);
+    retval += TestController(stepper, "H0321",  SUNAdaptController_H0321,
+                             sunctx);
+    retval += TestController(stepper, "H211",   SUNAdaptController_H211,
+                             sunctx);
+    retval += TestController(stepper, "H312",   SUNAdaptController_H312,
+                             sunctx);
+  }
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,511 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for adaptive slow time steps in MRIStep. The two-rate linear
+ * problem
+ *
+ *   y' = Af y + Ae y + g(t) + Ai y
+ *
+ * with a fast rotation Af, slow couplings Ae and Ai, and a slow forcing g(t)
+ * is integrated with the explicit, implicit, and ImEx coupling tables, using
+ * their embeddings to adapt the slow step size. The final solutions are
+ * compared to a reference computed with ARKStep at tight tolerances. The
+ * explicit tables are additionally run with a fast step budget, where the
+ * inner ARKStep takes fixed steps and the budget is adapted from its
+ * accumulated error estimate, as reported by MRIStepGetFastStepStats, with
+ * the exponent given by the order of the inner embedding. Reinitializing the
+ * inner ARKStep afterwards must disable its error accumulation.
+ * Finally, tables built with MRIStepCoupling_Create (no embedding row),
+ * MRIStepCoupling_CreateEmbedded, and MRIStepCoupling_MIStoMRI (without
+ * embedding weights) are checked to be rejected or accepted for adaptive
+ * steps accordingly.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "arkode/arkode_arkstep.h"
+#include "arkode/arkode_mristep.h"
+#include "arkode/arkode_butcher_erk.h"
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sundials/sundials_math.h"
+#include "arkode/arkode_arkstep_impl.h"
+#include "arkode/arkode_mristep_impl.h"
+
+#define NEQ 2
+
+/* ZERO and ONE are defined in arkode_impl.h */
+#define TF   SUN_RCONST(1.0)
+
+/* Fast, slow explicit, and slow implicit coupling matrices */
+static const realtype Af[2][2] = {{-SUN_RCONST(20.0),  SUN_RCONST(10.0)},
+                                  {-SUN_RCONST(10.0), -SUN_RCONST(20.0)}};
+static const realtype Ae[2][2] = {{-SUN_RCONST(0.5),  SUN_RCONST(0.3)},
+                                  { SUN_RCONST(0.2), -SUN_RCONST(0.4)}};
+static const realtype Ai[2][2] = {{-ONE,  SUN_RCONST(0.5)},
+                                  { ZERO, -SUN_RCONST(2.0)}};
+
+/* ydot = sum of the selected terms */
+static void rhs(realtype t, N_Vector y, N_Vector ydot, booleantype fast,
+                booleantype slow_expl, booleantype slow_impl)
+{
+  realtype *yd = N_VGetArrayPointer(y);
+  realtype *fd = N_VGetArrayPointer(ydot);
+  int i;
+
+  for (i = 0; i < NEQ; i++)
+  {
+    fd[i] = ZERO;
+    if (fast) fd[i] += Af[i][0] * yd[0] + Af[i][1] * yd[1];
+    if (slow_expl) fd[i] += Ae[i][0] * yd[0] + Ae[i][1] * yd[1];
+    if (slow_impl) fd[i] += Ai[i][0] * yd[0] + Ai[i][1] * yd[1];
+  }
+
+  if (slow_expl)
+  {
+    fd[0] += cos(t);
+    fd[1] += sin(SUN_RCONST(2.0) * t);
+  }
+}
+
+static int ffast(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  rhs(t, y, ydot, SUNTRUE, SUNFALSE, SUNFALSE);
+  return 0;
+}
+
+static int fslow_expl(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  rhs(t, y, ydot, SUNFALSE, SUNTRUE, SUNFALSE);
+  return 0;
+}
+
+static int fslow_impl(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  rhs(t, y, ydot, SUNFALSE, SUNFALSE, SUNTRUE);
+  return 0;
+}
+
+static int fslow(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  rhs(t, y, ydot, SUNFALSE, SUNTRUE, SUNTRUE);
+  return 0;
+}
+
+static int ffull(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  rhs(t, y, ydot, SUNTRUE, SUNTRUE, SUNTRUE);
+  return 0;
+}
+
+static void SetInitialCondition(N_Vector y)
+{
+  NV_Ith_S(y, 0) = ONE;
+  NV_Ith_S(y, 1) = SUN_RCONST(0.5);
+}
+
+/* Compute the reference solution at TF */
+static int Reference(N_Vector y, SUNContext sunctx)
+{
+  int      retval;
+  realtype t;
+  void     *arkode_mem;
+
+  SetInitialCondition(y);
+
+  arkode_mem = ARKStepCreate(ffull, NULL, ZERO, y, sunctx);
+  if (!arkode_mem) return 1;
+
+  retval = ARKStepSStolerances(arkode_mem, SUN_RCONST(1.0e-12),
+                               SUN_RCONST(1.0e-14));
+  if (retval) return retval;
+
+  retval = ARKStepSetOrder(arkode_mem, 5);
+  if (retval) return retval;
+
+  retval = ARKStepSetMaxNumSteps(arkode_mem, 100000);
+  if (retval) return retval;
+
+  retval = ARKStepEvolve(arkode_mem, TF, y, &t, ARK_NORMAL);
+  if (retval < 0) return retval;
+
+  ARKStepFree(&arkode_mem);
+
+  return 0;
+}
+
+/* Integrate to TF with adaptive slow steps, if budget > 0 the inner stepper
+   takes budget fixed steps per slow step initially */
+static int TestAdapt(ARKODE_MRITableID table, int budget, N_Vector yref,
+                     SUNContext sunctx)
+{
+  int                 retval, fast_budget, fast_p;
+  booleantype         expl, impl;
+  long int            nst, nst_a, netf, nfast_fails;
+  realtype            t, err, fast_err;
+  N_Vector            y;
+  MRIStepCoupling     C;
+  SUNMatrix           A  = NULL;
+  SUNLinearSolver     LS = NULL;
+  void                *inner_mem, *arkode_mem;
+  MRIStepInnerStepper inner_stepper = NULL;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  SetInitialCondition(y);
+
+  /* inner ARKStep integrator */
+  inner_mem = ARKStepCreate(ffast, NULL, ZERO, y, sunctx);
+  if (!inner_mem) return 1;
+
+  retval = ARKStepSetOrder(inner_mem, 4);
+  if (retval) return retval;
+
+  if (budget > 0)
+  {
+    retval = ARKStepSStolerances(inner_mem, SUN_RCONST(1.0e-8),
+                                 SUN_RCONST(1.0e-12));
+    if (retval) return retval;
+  }
+  else
+  {
+    retval = ARKStepSetFixedStep(inner_mem, SUN_RCONST(1.0e-3));
+    if (retval) return retval;
+  }
+
+  retval = ARKStepCreateMRIStepInnerStepper(inner_mem, &inner_stepper);
+  if (retval) return retval;
+
+  /* outer MRIStep integrator */
+  C = MRIStepCoupling_LoadTable(table);
+  if (!C) return 1;
+
+  expl = (C->W != NULL);
+  impl = (C->G != NULL);
+
+  if (expl && impl)
+    arkode_mem = MRIStepCreate(fslow_expl, fslow_impl, ZERO, y, inner_stepper,
+                               sunctx);
+  else if (expl)
+    arkode_mem = MRIStepCreate(fslow, NULL, ZERO, y, inner_stepper, sunctx);
+  else
+    arkode_mem = MRIStepCreate(NULL, fslow, ZERO, y, inner_stepper, sunctx);
+  if (!arkode_mem) return 1;
+
+  retval = MRIStepSetCoupling(arkode_mem, C);
+  if (retval) return retval;
+
+  retval = MRIStepSStolerances(arkode_mem, SUN_RCONST(1.0e-6),
+                               SUN_RCONST(1.0e-10));
+  if (retval) return retval;
+
+  retval = MRIStepSetMaxNumSteps(arkode_mem, 10000);
+  if (retval) return retval;
+
+  if (impl)
+  {
+    A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+    LS = SUNLinSol_Dense(y, A, sunctx);
+    retval = MRIStepSetLinearSolver(arkode_mem, LS, A);
+    if (retval) return retval;
+  }
+
+  if (budget > 0)
+  {
+    retval = MRIStepSetFastStepBudget(arkode_mem, budget, 0);
+    if (retval) return retval;
+  }
+
+  retval = MRIStepEvolve(arkode_mem, TF, y, &t, ARK_NORMAL);
+  if (retval < 0)
+  {
+    fprintf(stderr, "MRIStepEvolve returned %i\n", retval);
+    return 1;
+  }
+
+  MRIStepGetNumSteps(arkode_mem, &nst);
+  MRIStepGetNumStepAttempts(arkode_mem, &nst_a);
+  MRIStepGetNumErrTestFails(arkode_mem, &netf);
+  MRIStepGetFastStepStats(arkode_mem, &fast_budget, &fast_err, &nfast_fails);
+
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  err = N_VMaxNorm(y);
+
+  printf("table %i, budget %i: steps %ld, attempts %ld, error test fails %ld,"
+         " fast budget %i, fast fails %ld, error %g\n", (int) table, budget,
+         nst, nst_a, netf, fast_budget, nfast_fails, (double) err);
+
+  if (budget > 0)
+  {
+    /* the fourth order inner table has a third order embedding */
+    retval = mriStepInnerStepper_GetEmbeddingOrder(inner_stepper, &fast_p);
+    if (retval || fast_p != 3)
+    {
+      fprintf(stderr, "inner embedding order %i, expected 3\n", fast_p);
+      return 1;
+    }
+
+    /* reinitializing the inner integrator stops the error accumulation */
+    if (!((ARKodeARKStepMem) ((ARKodeMem) inner_mem)->step_mem)->accum_error)
+    {
+      fprintf(stderr, "inner error accumulation was not enabled\n");
+      return 1;
+    }
+
+    retval = ARKStepReInit(inner_mem, ffast, NULL, ZERO, yref);
+    if (retval) return retval;
+
+    if (((ARKodeARKStepMem) ((ARKodeMem) inner_mem)->step_mem)->accum_error)
+    {
+      fprintf(stderr, "inner error accumulation was not reset\n");
+      return 1;
+    }
+  }
+
+  MRIStepFree(&arkode_mem);
+  ARKStepFree(&inner_mem);
+  MRIStepInnerStepper_Free(&inner_stepper);
+  MRIStepCoupling_Free(C);
+  if (LS) SUNLinSolFree(LS);
+  if (A) SUNMatDestroy(A);
+  N_VDestroy(y);
+
+  if (err > SUN_RCONST(1.0e-4))
+  {
+    fprintf(stderr, "error exceeds the tolerance\n");
+    return 1;
+  }
+
+  if (nst < 2 || nst_a < nst + netf)
+  {
+    fprintf(stderr, "inconsistent step statistics\n");
+    return 1;
+  }
+
+  if (budget > 0 && (fast_budget < 1 || fast_err > ONE))
+  {
+    fprintf(stderr, "inconsistent fast step statistics\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+/* Integrate to TF with the explicit table C using fixed (h > 0) or adaptive
+   slow steps, returns the MRIStepEvolve return value */
+static int Evolve(MRIStepCoupling C, realtype h, N_Vector yref,
+                  SUNContext sunctx)
+{
+  int                 retval;
+  realtype            t;
+  N_Vector            y;
+  void                *inner_mem, *arkode_mem;
+  MRIStepInnerStepper inner_stepper = NULL;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  SetInitialCondition(y);
+
+  inner_mem = ARKStepCreate(ffast, NULL, ZERO, y, sunctx);
+  if (!inner_mem) return 1;
+
+  retval = ARKStepSetOrder(inner_mem, 4);
+  if (retval) return retval;
+
+  retval = ARKStepSetFixedStep(inner_mem, SUN_RCONST(1.0e-3));
+  if (retval) return retval;
+
+  retval = ARKStepCreateMRIStepInnerStepper(inner_mem, &inner_stepper);
+  if (retval) return retval;
+
+  arkode_mem = MRIStepCreate(fslow, NULL, ZERO, y, inner_stepper, sunctx);
+  if (!arkode_mem) return 1;
+
+  retval = MRIStepSetCoupling(arkode_mem, C);
+  if (retval) return retval;
+
+  retval = MRIStepSStolerances(arkode_mem, SUN_RCONST(1.0e-6),
+                               SUN_RCONST(1.0e-10));
+  if (retval) return retval;
+
+  if (h > ZERO)
+  {
+    retval = MRIStepSetFixedStep(arkode_mem, h);
+    if (retval) return retval;
+  }
+
+  retval = MRIStepEvolve(arkode_mem, TF, y, &t, ARK_NORMAL);
+
+  if (retval >= 0)
+  {
+    N_VLinearSum(ONE, y, -ONE, yref, y);
+    if (N_VMaxNorm(y) > SUN_RCONST(1.0e-4))
+    {
+      fprintf(stderr, "error exceeds the tolerance\n");
+      retval = -1;
+    }
+  }
+
+  MRIStepFree(&arkode_mem);
+  ARKStepFree(&inner_mem);
+  MRIStepInnerStepper_Free(&inner_stepper);
+  N_VDestroy(y);
+
+  return retval;
+}
+
+/* Build the ERK33a table from 1D arrays with and without the embedding row and
+   a MIS table without embedding weights, fixed steps work with all of them
+   while adaptive steps require the embedding row */
+static int TestCreate(N_Vector yref, SUNContext sunctx)
+{
+  int                passfail = 0;
+  int                i, j, k, s;
+  realtype           *W, *We;
+  MRIStepCoupling    C, Cc, Ce, Cm;
+  ARKodeButcherTable B;
+
+  C = MRIStepCoupling_LoadTable(ARKODE_MRI_GARK_ERK33a);
+  if (!C) return 1;
+  s = C->stages;
+
+  /* old layout with stages rows and the layout with stages + 1 rows */
+  W  = (realtype *) malloc(C->nmat * s * s * sizeof(realtype));
+  We = (realtype *) malloc(C->nmat * (s + 1) * s * sizeof(realtype));
+  for (k = 0; k < C->nmat; k++)
+    for (i = 0; i <= s; i++)
+      for (j = 0; j < s; j++)
+      {
+        if (i < s) W[s * (s * k + i) + j] = C->W[k][i][j];
+        We[s * ((s + 1) * k + i) + j] = C->W[k][i][j];
+      }
+
+  Cc = MRIStepCoupling_Create(C->nmat, s, C->q, C->p, W, NULL, C->c);
+  Ce = MRIStepCoupling_CreateEmbedded(C->nmat, s, C->q, C->p, We, NULL, C->c);
+  if (!Cc || !Ce)
+  {
+    fprintf(stderr, "MRIStepCoupling_Create(Embedded) failed\n");
+    return 1;
+  }
+
+  for (k = 0; k < C->nmat; k++)
+  {
+    if (Cc->W[k][s] != NULL)
+    {
+      fprintf(stderr, "MRIStepCoupling_Create set an embedding row\n");
+      passfail = 1;
+    }
+    for (i = 0; i <= s; i++)
+      for (j = 0; j < s; j++)
+      {
+        if (Ce->W[k][i][j] != C->W[k][i][j] ||
+            (i < s && Cc->W[k][i][j] != C->W[k][i][j]))
+        {
+          fprintf(stderr, "coefficient mismatch in W[%i][%i][%i]\n", k, i, j);
+          passfail = 1;
+        }
+      }
+  }
+
+  if (Evolve(Cc, SUN_RCONST(0.01), yref, sunctx) < 0)
+  {
+    fprintf(stderr, "fixed steps failed without an embedding row\n");
+    passfail = 1;
+  }
+
+  if (Evolve(Cc, ZERO, yref, sunctx) >= 0)
+  {
+    fprintf(stderr, "adaptive steps accepted without an embedding row\n");
+    passfail = 1;
+  }
+
+  if (Evolve(Ce, ZERO, yref, sunctx) < 0)
+  {
+    fprintf(stderr, "adaptive steps failed with an embedding row\n");
+    passfail = 1;
+  }
+
+  /* MIS table with an embedding order but without embedding weights */
+  B = ARKodeButcherTable_LoadERK(ARKODE_KNOTH_WOLKE_3_3);
+  Cm = MRIStepCoupling_MIStoMRI(B, 3, 2);
+  if (!Cm || Cm->W[0][Cm->stages] != NULL)
+  {
+    fprintf(stderr, "MRIStepCoupling_MIStoMRI without embedding failed\n");
+    passfail = 1;
+  }
+  else if (Evolve(Cm, SUN_RCONST(0.01), yref, sunctx) < 0)
+  {
+    fprintf(stderr, "fixed steps failed with the MIS table\n");
+    passfail = 1;
+  }
+
+  free(W);
+  free(We);
+  MRIStepCoupling_Free(C);
+  MRIStepCoupling_Free(Cc);
+  MRIStepCoupling_Free(Ce);
+  MRIStepCoupling_Free(Cm);
+  ARKodeButcherTable_Free(B);
+
+  return passfail;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  N_Vector   yref;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  yref = N_VNew_Serial(NEQ, sunctx);
+  if (Reference(yref, sunctx))
+  {
+    fprintf(stderr, "reference solution failed\n");
+    return 1;
+  }
+
+  retval += TestAdapt(ARKODE_MIS_KW3,            0, yref, sunctx);
+  retval += TestAdapt(ARKODE_MRI_GARK_ERK33a,    0, yref, sunctx);
+  retval += TestAdapt(ARKODE_MRI_GARK_ERK45a,    0, yref, sunctx);
+  retval += TestAdapt(ARKODE_MRI_GARK_IRK21a,    0, yref, sunctx);
+  retval += TestAdapt(ARKODE_MRI_GARK_ESDIRK34a, 0, yref, sunctx);
+  retval += TestAdapt(ARKODE_MRI_GARK_ESDIRK46a, 0, yref, sunctx);
+  retval += TestAdapt(ARKODE_IMEX_MRI_GARK3a,    0, yref, sunctx);
+  retval += TestAdapt(ARKODE_IMEX_MRI_GARK3b,    0, yref, sunctx);
+  retval += TestAdapt(ARKODE_IMEX_MRI_GARK4,     0, yref, sunctx);
+  retval += TestAdapt(ARKODE_MRI_GARK_ERK33a,    4, yref, sunctx);
+  retval += TestAdapt(ARKODE_MRI_GARK_ERK45a,    4, yref, sunctx);
+  retval += TestCreate(yref, sunctx);
+
+  N_VDestroy(yref);
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
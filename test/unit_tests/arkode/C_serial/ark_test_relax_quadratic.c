@@ -0,0 +1,235 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the quadratic relaxation solver. The harmonic oscillator
+ *
+ *   u' = -v,  u(0) = 1
+ *   v' =  u,  v(0) = 0
+ *
+ * conserves the quadratic energy e(y) = (u^2 + v^2) / 2. The problem is
+ * integrated with relaxation using ERKStep and ARKStep (explicit) with the
+ * Newton and quadratic relaxation solvers. The quadratic solver must conserve
+ * the energy, be as accurate as the Newton solver, and not evaluate the
+ * relaxation function.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "arkode/arkode_arkstep.h"
+#include "arkode/arkode_erkstep.h"
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
+#define ONE  SUN_RCONST(1.0)
+#define TF   SUN_RCONST(10.0)
+
+/* Right-hand side function */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  NV_Ith_S(ydot, 0) = -NV_Ith_S(y, 1);
+  NV_Ith_S(ydot, 1) =  NV_Ith_S(y, 0);
+  return 0;
+}
+
+/* Energy function e(y) = y . y / 2 */
+static int Energy(N_Vector y, realtype* e, void* user_data)
+{
+  *e = HALF * N_VDotProd(y, y);
+  return 0;
+}
+
+/* Energy Jacobian J(y) = y */
+static int EnergyJac(N_Vector y, N_Vector J, void* user_data)
+{
+  N_VScale(ONE, y, J);
+  return 0;
+}
+
+/* Energy Hessian action H(y) v = v */
+static int EnergyHess(N_Vector y, N_Vector v, N_Vector Hv, void* user_data)
+{
+  N_VScale(ONE, v, Hv);
+  return 0;
+}
+
+/* Integrate with the given stepper (0 = ERKStep, 1 = ARKStep) and relaxation
+   solver */
+static int Integrate(int stepper, ARKRelaxSolver solver, N_Vector y,
+                     realtype *err, long int *nst, long int *nfe,
+                     long int *nhe, SUNContext sunctx)
+{
+  int      retval;
+  realtype t;
+  void     *arkode_mem;
+
+  NV_Ith_S(y, 0) = ONE;
+  NV_Ith_S(y, 1) = ZERO;
+
+  if (stepper == 0)
+  {
+    arkode_mem = ERKStepCreate(f, ZERO, y, sunctx);
+    if (!arkode_mem) return 1;
+
+    retval = ERKStepSStolerances(arkode_mem, SUN_RCONST(1.0e-4),
+                                 SUN_RCONST(1.0e-8));
+    if (retval) return retval;
+
+    retval = ERKStepSetRelaxFn(arkode_mem, Energy, EnergyJac);
+    if (retval) return retval;
+
+    retval = ERKStepSetRelaxHessFn(arkode_mem, EnergyHess);
+    if (retval) return retval;
+
+    retval = ERKStepSetRelaxSolver(arkode_mem, solver);
+    if (retval) return retval;
+
+    /* Take internal steps so the output is not interpolated */
+    t = ZERO;
+    while (t < TF)
+    {
+      retval = ERKStepEvolve(arkode_mem, TF, y, &t, ARK_ONE_STEP);
+      if (retval < 0) return retval;
+    }
+
+    ERKStepGetNumSteps(arkode_mem, nst);
+    ERKStepGetNumRelaxFnEvals(arkode_mem, nfe);
+    ERKStepGetNumRelaxHessEvals(arkode_mem, nhe);
+    ERKStepFree(&arkode_mem);
+  }
+  else
+  {
+    arkode_mem = ARKStepCreate(f, NULL, ZERO, y, sunctx);
+    if (!arkode_mem) return 1;
+
+    retval = ARKStepSStolerances(arkode_mem, SUN_RCONST(1.0e-4),
+                                 SUN_RCONST(1.0e-8));
+    if (retval) return retval;
+
+    retval = ARKStepSetRelaxFn(arkode_mem, Energy, EnergyJac);
+    if (retval) return retval;
+
+    retval = ARKStepSetRelaxHessFn(arkode_mem, EnergyHess);
+    if (retval) return retval;
+
+    retval = ARKStepSetRelaxSolver(arkode_mem, solver);
+    if (retval) return retval;
+
+    /* Take internal steps so the output is not interpolated */
+    t = ZERO;
+    while (t < TF)
+    {
+      retval = ARKStepEvolve(arkode_mem, TF, y, &t, ARK_ONE_STEP);
+      if (retval < 0) return retval;
+    }
+
+    ARKStepGetNumSteps(arkode_mem, nst);
+    ARKStepGetNumRelaxFnEvals(arkode_mem, nfe);
+    ARKStepGetNumRelaxHessEvals(arkode_mem, nhe);
+    ARKStepFree(&arkode_mem);
+  }
+
+  /* Error in the exact solution at the final time reached */
+  *err = SUNRabs(NV_Ith_S(y, 0) - cos(t)) + SUNRabs(NV_Ith_S(y, 1) - sin(t));
+
+  return 0;
+}
+
+static int TestStepper(int stepper, SUNContext sunctx)
+{
+  int      retval = 0;
+  long int nst_n, nfe_n, nhe_n, nst_q, nfe_q, nhe_q;
+  realtype e_q, err_n, err_q;
+  N_Vector y_n, y_q;
+
+  y_n = N_VNew_Serial(2, sunctx);
+  y_q = N_VNew_Serial(2, sunctx);
+
+  if (Integrate(stepper, ARK_RELAX_NEWTON, y_n, &err_n, &nst_n, &nfe_n, &nhe_n,
+                sunctx))
+  {
+    fprintf(stderr, "integration with the Newton solver failed\n");
+    return 1;
+  }
+
+  if (Integrate(stepper, ARK_RELAX_QUADRATIC, y_q, &err_q, &nst_q, &nfe_q, &nhe_q,
+                sunctx))
+  {
+    fprintf(stderr, "integration with the quadratic solver failed\n");
+    return 1;
+  }
+
+  Energy(y_q, &e_q, NULL);
+
+  printf("stepper %i: Newton steps %ld, fn evals %ld; quadratic steps %ld, "
+         "fn evals %ld, Hess evals %ld\n", stepper, nst_n, nfe_n, nst_q,
+         nfe_q, nhe_q);
+  printf("  energy error %.2e, solution error %.2e (Newton %.2e)\n",
+         (double) SUNRabs(e_q - HALF), (double) err_q, (double) err_n);
+
+  if (SUNRabs(e_q - HALF) > SUN_RCONST(1.0e-12))
+  {
+    fprintf(stderr, "energy is not conserved\n");
+    retval = 1;
+  }
+
+  if (err_q > SUN_RCONST(2.0) * err_n)
+  {
+    fprintf(stderr, "quadratic solver is less accurate than Newton\n");
+    retval = 1;
+  }
+
+  if (nfe_q != 0 || nhe_q < nst_q || nhe_n != 0)
+  {
+    fprintf(stderr, "unexpected relaxation function evaluations\n");
+    retval = 1;
+  }
+
+  N_VDestroy(y_n);
+  N_VDestroy(y_q);
+
+  return retval;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestStepper(0, sunctx);
+  retval += TestStepper(1, sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
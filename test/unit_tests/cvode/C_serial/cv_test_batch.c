@@ -0,0 +1,335 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the batched mode of CVODE. Copies of the Robertson chemical
+ * kinetics problem with rate constants varying over several orders of
+ * magnitude are integrated as one batch, with the difference quotient and
+ * with an analytic Jacobian, and one at a time with CVODE and the dense linear
+ * solver. The solutions of the batch must agree with the individual runs at
+ * each output time, and the systems must take different numbers of steps.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunmatrix/sunmatrix_blockdense.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunlinsol/sunlinsol_blockdense.h"
+#include "sundials/sundials_math.h"
+#include "cvode/cvode.h"
+#include "cvode/cvode_batch.h"
+
+#define NSYS  19
+#define NEQ   3
+#define NOUT  4
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+#define RTOL SUN_RCONST(1.0e-4)
+
+static const realtype abstols[NEQ] = {SUN_RCONST(1.0e-8), SUN_RCONST(1.0e-14),
+                                      SUN_RCONST(1.0e-6)};
+
+/* Rate constant k1 of system k */
+static realtype RateK1(int k)
+{
+  return SUN_RCONST(0.04) * SUNRpowerR(SUN_RCONST(10.0),
+                                       SUN_RCONST(0.25) * (k - NSYS / 2));
+}
+
+/* Right-hand side of one system */
+static void Robertson(realtype k1, const realtype *y, realtype *f)
+{
+  realtype r1 = k1 * y[0];
+  realtype r2 = SUN_RCONST(1.0e4) * y[1] * y[2];
+  realtype r3 = SUN_RCONST(3.0e7) * y[1] * y[1];
+
+  f[0] = -r1 + r2;
+  f[1] =  r1 - r2 - r3;
+  f[2] =  r3;
+}
+
+/* Right-hand side of the batch */
+static int fbatch(const realtype *t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype *yd = N_VGetArrayPointer(y);
+  realtype *fd = N_VGetArrayPointer(ydot);
+  int k;
+
+  for (k = 0; k < NSYS; k++)
+    Robertson(RateK1(k), yd + k * NEQ, fd + k * NEQ);
+
+  return 0;
+}
+
+/* Jacobian of the batch */
+static int jbatch(const realtype *t, N_Vector y, N_Vector fy, SUNMatrix J,
+                  void *user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  realtype *yd = N_VGetArrayPointer(y);
+  realtype k1, y2, y3;
+  int k;
+
+  for (k = 0; k < NSYS; k++)
+  {
+    k1 = RateK1(k);
+    y2 = yd[k * NEQ + 1];
+    y3 = yd[k * NEQ + 2];
+
+    SM_ELEMENT_BD(J, k, 0, 0) = -k1;
+    SM_ELEMENT_BD(J, k, 0, 1) = SUN_RCONST(1.0e4) * y3;
+    SM_ELEMENT_BD(J, k, 0, 2) = SUN_RCONST(1.0e4) * y2;
+
+    SM_ELEMENT_BD(J, k, 1, 0) = k1;
+    SM_ELEMENT_BD(J, k, 1, 1) = -SUN_RCONST(1.0e4) * y3 -
+                                SUN_RCONST(6.0e7) * y2;
+    SM_ELEMENT_BD(J, k, 1, 2) = -SUN_RCONST(1.0e4) * y2;
+
+    SM_ELEMENT_BD(J, k, 2, 0) = ZERO;
+    SM_ELEMENT_BD(J, k, 2, 1) = SUN_RCONST(6.0e7) * y2;
+    SM_ELEMENT_BD(J, k, 2, 2) = ZERO;
+  }
+
+  return 0;
+}
+
+/* Right-hand side of a single system, the system index is the user data */
+static int fsingle(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  Robertson(RateK1(*((int *) user_data)), N_VGetArrayPointer(y),
+            N_VGetArrayPointer(ydot));
+  return 0;
+}
+
+/* Integrate system k on its own, returning the solutions at the output times */
+static int IntegrateSingle(int k, const realtype *tout, realtype *yref,
+                           long int *nst, SUNContext sunctx)
+{
+  int             retval, iout, i;
+  realtype        t;
+  N_Vector        y, abstol;
+  SUNMatrix       A;
+  SUNLinearSolver LS;
+  void            *cvode_mem;
+
+  y      = N_VNew_Serial(NEQ, sunctx);
+  abstol = N_VClone(y);
+  for (i = 0; i < NEQ; i++)
+  {
+    NV_Ith_S(y, i)      = (i == 0) ? ONE : ZERO;
+    NV_Ith_S(abstol, i) = abstols[i];
+  }
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  retval = CVodeInit(cvode_mem, fsingle, ZERO, y);
+  if (retval) return retval;
+  retval = CVodeSVtolerances(cvode_mem, RTOL, abstol);
+  if (retval) return retval;
+  retval = CVodeSetUserData(cvode_mem, &k);
+  if (retval) return retval;
+
+  A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (retval) return retval;
+
+  for (iout = 0; iout < NOUT; iout++)
+  {
+    retval = CVode(cvode_mem, tout[iout], y, &t, CV_NORMAL);
+    if (retval < 0)
+    {
+      fprintf(stderr, "CVode returned %i for system %i\n", retval, k);
+      return retval;
+    }
+    for (i = 0; i < NEQ; i++) yref[iout * NEQ + i] = NV_Ith_S(y, i);
+  }
+
+  CVodeGetNumSteps(cvode_mem, nst);
+
+  CVodeFree(&cvode_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  N_VDestroy(y);
+  N_VDestroy(abstol);
+
+  return 0;
+}
+
+static int TestBatch(booleantype userjac, SUNContext sunctx)
+{
+  int             retval, passfail = 0;
+  int             k, i, iout;
+  int             status[NSYS];
+  long int        nst[NSYS], nst_ref, nfe, nje, nrounds, nstmin, nstmax;
+  realtype        tout[NOUT], tret[NSYS], *yd, *ybatch, err, maxerr;
+  N_Vector        y, abstol;
+  SUNMatrix       A;
+  SUNLinearSolver LS;
+  void            *cvb_mem;
+
+  tout[0] = SUN_RCONST(0.4);
+  for (iout = 1; iout < NOUT; iout++)
+    tout[iout] = SUN_RCONST(10.0) * tout[iout - 1];
+
+  y      = N_VNew_Serial(NSYS * NEQ, sunctx);
+  abstol = N_VClone(y);
+  yd     = N_VGetArrayPointer(y);
+  for (k = 0; k < NSYS; k++)
+  {
+    for (i = 0; i < NEQ; i++)
+    {
+      yd[k * NEQ + i] = (i == 0) ? ONE : ZERO;
+      NV_Ith_S(abstol, k * NEQ + i) = abstols[i];
+    }
+  }
+
+  cvb_mem = CVodeBatchCreate(NSYS, NEQ, sunctx);
+  if (cvb_mem == NULL) return 1;
+
+  retval = CVodeBatchInit(cvb_mem, fbatch, ZERO, y);
+  if (retval) return 1;
+  retval = CVodeBatchSVtolerances(cvb_mem, RTOL, abstol);
+  if (retval) return 1;
+
+  A  = SUNBlockDenseMatrix(NSYS, NEQ, NEQ, sunctx);
+  LS = SUNLinSol_BlockDense(y, A, sunctx);
+  retval = CVodeBatchSetLinearSolver(cvb_mem, LS, A);
+  if (retval) return 1;
+
+  if (userjac)
+  {
+    retval = CVodeBatchSetJacFn(cvb_mem, jbatch);
+    if (retval) return 1;
+  }
+
+  /* batched solutions of each system at the output times */
+  ybatch = (realtype *) malloc(NSYS * NOUT * NEQ * sizeof(realtype));
+  maxerr = ZERO;
+
+  for (iout = 0; iout < NOUT; iout++)
+  {
+    retval = CVodeBatch(cvb_mem, tout[iout], y, tret);
+    if (retval)
+    {
+      CVodeBatchGetStatus(cvb_mem, status);
+      fprintf(stderr, "CVodeBatch returned %i\n", retval);
+      for (k = 0; k < NSYS; k++)
+        if (status[k]) fprintf(stderr, "  system %i: flag %i\n", k, status[k]);
+      return 1;
+    }
+    for (k = 0; k < NSYS; k++)
+    {
+      if (tret[k] != tout[iout])
+      {
+        fprintf(stderr, "system %i returned at t = %g\n", k, (double) tret[k]);
+        passfail = 1;
+      }
+    }
+    for (i = 0; i < NSYS * NEQ; i++)
+      ybatch[(i / NEQ) * NOUT * NEQ + iout * NEQ + i % NEQ] = yd[i];
+  }
+
+  CVodeBatchGetNumSteps(cvb_mem, nst);
+  CVodeBatchGetNumRhsEvals(cvb_mem, &nfe);
+  CVodeBatchGetNumJacEvals(cvb_mem, &nje);
+  CVodeBatchGetNumRounds(cvb_mem, &nrounds);
+
+  /* compare with individual CVODE runs */
+  nstmin = nstmax = nst[0];
+  for (k = 0; k < NSYS; k++)
+  {
+    realtype ysingle[NOUT * NEQ];
+
+    retval = IntegrateSingle(k, tout, ysingle, &nst_ref, sunctx);
+    if (retval) return 1;
+
+    for (i = 0; i < NOUT * NEQ; i++)
+    {
+      err = SUNRabs(ysingle[i] - ybatch[k * NOUT * NEQ + i]) /
+            (RTOL * SUNRabs(ysingle[i]) + abstols[i % NEQ]);
+      maxerr = SUNMAX(maxerr, err);
+    }
+
+    /* the batch follows the CVODE algorithm, but roundoff differences in
+       the linear algebra can change the step size sequence */
+    if (labs(nst[k] - nst_ref) > nst_ref / 4 + 2)
+    {
+      fprintf(stderr, "system %i: %ld steps, %ld for CVODE\n", k, nst[k],
+              nst_ref);
+      passfail = 1;
+    }
+
+    nstmin = (nst[k] < nstmin) ? nst[k] : nstmin;
+    nstmax = (nst[k] > nstmax) ? nst[k] : nstmax;
+  }
+
+  printf("userjac = %i: steps %ld to %ld, rounds %ld, nfe %ld, nje %ld, "
+         "max weighted diff %g\n", (int) userjac, nstmin, nstmax, nrounds,
+         nfe, nje, (double) maxerr);
+
+  /* the solutions agree to within the tolerances */
+  if (maxerr > SUN_RCONST(10.0))
+  {
+    fprintf(stderr, "batched and individual solutions differ\n");
+    passfail = 1;
+  }
+
+  /* the systems took different numbers of steps in the same rounds */
+  if ((nstmin == nstmax) || (nrounds < nstmax))
+  {
+    fprintf(stderr, "per-system step sizes were not used\n");
+    passfail = 1;
+  }
+
+  free(ybatch);
+  CVodeBatchFree(&cvb_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  N_VDestroy(y);
+  N_VDestroy(abstol);
+
+  return passfail;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestBatch(SUNFALSE, sunctx);
+  retval += TestBatch(SUNTRUE,  sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,311 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the fused host kernels enabled with
+ * CVodeSetUseIntegratorFusedKernels. Several copies of the Robertson chemical
+ * kinetics problem with perturbed rate constants are integrated with and
+ * without the fused kernels using BDF and Adams methods, scalar and vector
+ * absolute tolerances, non-negativity constraints, and the dense and diagonal
+ * linear solvers. The solutions and step counts of the two runs are compared
+ * and the fused run checks that the Nordsieck array is stored contiguously.
+ * If NVECTOR_PTHREADS is available the runs are repeated with Pthreads vectors
+ * so that the sweeps are split across the thread pool. The error weight
+ * kernels are also checked to leave the weight vector unchanged when a
+ * component of the tolerance is not positive.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvector/nvector_serial.h"
+#if defined(USE_PTHREADS)
+#include "nvector/nvector_pthreads.h"
+#endif
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sundials/sundials_math.h"
+#include "cvode/cvode.h"
+#include "cvode/cvode_diag.h"
+#include "cvode/cvode_impl.h"
+
+#define NCOPIES 20
+#define NEQ     (3 * NCOPIES)
+
+#define NTHREADS 2
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Right-hand side function */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype *yd = N_VGetArrayPointer(y);
+  realtype *fd = N_VGetArrayPointer(ydot);
+  realtype k1, r1, r2, r3;
+  int i;
+
+  for (i = 0; i < NCOPIES; i++)
+  {
+    k1 = SUN_RCONST(0.04) * (ONE + SUN_RCONST(0.05) * i);
+    r1 = k1 * yd[3*i];
+    r2 = SUN_RCONST(1.0e4) * yd[3*i+1] * yd[3*i+2];
+    r3 = SUN_RCONST(3.0e7) * yd[3*i+1] * yd[3*i+1];
+    fd[3*i]   = -r1 + r2;
+    fd[3*i+1] =  r1 - r2 - r3;
+    fd[3*i+2] =  r3;
+  }
+
+  return 0;
+}
+
+/* Integrate to tout and return the solution and number of steps */
+static int Integrate(booleantype fused, int lmm, booleantype vtol,
+                     booleantype diag, N_Vector y, long int *nst,
+                     SUNContext sunctx)
+{
+  int             retval, i;
+  CVodeMem        cv_mem;
+  realtype        t;
+  N_Vector        abstol = NULL, constraints;
+  SUNMatrix       A  = NULL;
+  SUNLinearSolver LS = NULL;
+  void            *cvode_mem;
+
+  for (i = 0; i < NCOPIES; i++)
+  {
+    N_VGetArrayPointer(y)[3*i]   = ONE;
+    N_VGetArrayPointer(y)[3*i+1] = ZERO;
+    N_VGetArrayPointer(y)[3*i+2] = ZERO;
+  }
+
+  cvode_mem = CVodeCreate(lmm, sunctx);
+  retval = CVodeInit(cvode_mem, f, ZERO, y);
+  if (retval) return retval;
+
+  if (vtol)
+  {
+    abstol = N_VClone(y);
+    for (i = 0; i < NCOPIES; i++)
+    {
+      N_VGetArrayPointer(abstol)[3*i]   = SUN_RCONST(1.0e-8);
+      N_VGetArrayPointer(abstol)[3*i+1] = SUN_RCONST(1.0e-14);
+      N_VGetArrayPointer(abstol)[3*i+2] = SUN_RCONST(1.0e-6);
+    }
+    retval = CVodeSVtolerances(cvode_mem, SUN_RCONST(1.0e-4), abstol);
+  }
+  else
+  {
+    retval = CVodeSStolerances(cvode_mem, SUN_RCONST(1.0e-4),
+                               SUN_RCONST(1.0e-10));
+  }
+  if (retval) return retval;
+
+  constraints = N_VClone(y);
+  N_VConst(ONE, constraints);
+  retval = CVodeSetConstraints(cvode_mem, constraints);
+  if (retval) return retval;
+
+  if (diag)
+  {
+    retval = CVDiag(cvode_mem);
+  }
+  else
+  {
+    A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+    LS = SUNLinSol_Dense(y, A, sunctx);
+    retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  }
+  if (retval) return retval;
+
+  retval = CVodeSetMaxNumSteps(cvode_mem, 50000);
+  if (retval) return retval;
+
+  retval = CVodeSetUseIntegratorFusedKernels(cvode_mem, fused);
+  if (retval)
+  {
+    fprintf(stderr, "CVodeSetUseIntegratorFusedKernels returned %i\n", retval);
+    return retval;
+  }
+
+  /* check the contiguous Nordsieck array storage */
+  cv_mem = (CVodeMem) cvode_mem;
+  if (fused)
+  {
+    for (i = 0; i <= cv_mem->cv_qmax_alloc; i++)
+    {
+      if (N_VGetArrayPointer(cv_mem->cv_zn[i]) != cv_mem->cv_znblock + i * NEQ)
+      {
+        fprintf(stderr, "zn[%i] is not stored in the Nordsieck block\n", i);
+        return 1;
+      }
+    }
+  }
+
+  retval = CVode(cvode_mem, SUN_RCONST(40.0), y, &t, CV_NORMAL);
+  if (retval < 0)
+  {
+    fprintf(stderr, "CVode returned %i\n", retval);
+    return retval;
+  }
+
+  CVodeGetNumSteps(cvode_mem, nst);
+
+  CVodeFree(&cvode_mem);
+  if (LS) SUNLinSolFree(LS);
+  if (A) SUNMatDestroy(A);
+  if (abstol) N_VDestroy(abstol);
+  N_VDestroy(constraints);
+
+  return 0;
+}
+
+static int TestFusedHost(int lmm, booleantype vtol, booleantype diag,
+                         int nthreads, SUNContext sunctx)
+{
+  int      retval;
+  long int nst_ref, nst_fused;
+  realtype err;
+  N_Vector y_ref, y_fused;
+
+#if defined(USE_PTHREADS)
+  if (nthreads > 0) y_ref = N_VNew_Pthreads(NEQ, nthreads, sunctx);
+  else y_ref = N_VNew_Serial(NEQ, sunctx);
+#else
+  y_ref = N_VNew_Serial(NEQ, sunctx);
+#endif
+  y_fused = N_VClone(y_ref);
+
+  retval = Integrate(SUNFALSE, lmm, vtol, diag, y_ref, &nst_ref, sunctx);
+  if (retval) return 1;
+
+  retval = Integrate(SUNTRUE, lmm, vtol, diag, y_fused, &nst_fused, sunctx);
+  if (retval) return 1;
+
+  N_VLinearSum(ONE, y_ref, -ONE, y_fused, y_fused);
+  err = N_VMaxNorm(y_fused);
+
+  printf("lmm = %i, vtol = %i, diag = %i, threads = %i: steps %ld "
+         "(reference %ld), max diff %g\n", lmm, (int) vtol, (int) diag,
+         nthreads, nst_fused, nst_ref, (double) err);
+
+  N_VDestroy(y_ref);
+  N_VDestroy(y_fused);
+
+  if (nst_ref != nst_fused || err > SUN_RCONST(1.0e-10))
+  {
+    fprintf(stderr, "fused and unfused solutions differ\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+/* Check that the error weight kernels fail without modifying the weights if
+   a component of reltol*|y| + abstol is zero */
+static int TestEwtFail(N_Vector y)
+{
+  int      retval, passfail = 0;
+  realtype err;
+  N_Vector abstol, weight;
+
+  abstol = N_VClone(y);
+  weight = N_VClone(y);
+
+  N_VConst(ONE, y);
+  N_VGetArrayPointer(y)[NEQ - 1] = ZERO;
+  N_VConst(SUN_RCONST(1.0e-6), abstol);
+  N_VGetArrayPointer(abstol)[NEQ - 1] = ZERO;
+
+  N_VConst(SUN_RCONST(7.0), weight);
+  retval = cvEwtSetSV_host(SUNTRUE, SUN_RCONST(1.0e-4), abstol, y, weight);
+  N_VAddConst(weight, SUN_RCONST(-7.0), abstol);
+  err = N_VMaxNorm(abstol);
+  if (retval != -1 || err != ZERO)
+  {
+    fprintf(stderr, "cvEwtSetSV_host returned %i, weight changed by %g\n",
+            retval, (double) err);
+    passfail = 1;
+  }
+
+  retval = cvEwtSetSS_host(SUNTRUE, SUN_RCONST(1.0e-4), ZERO, y, weight);
+  N_VAddConst(weight, SUN_RCONST(-7.0), abstol);
+  err = N_VMaxNorm(abstol);
+  if (retval != -1 || err != ZERO)
+  {
+    fprintf(stderr, "cvEwtSetSS_host returned %i, weight changed by %g\n",
+            retval, (double) err);
+    passfail = 1;
+  }
+
+  /* with a positive tolerance the weights are set */
+  retval = cvEwtSetSS_host(SUNTRUE, ZERO, SUN_RCONST(0.5), y, weight);
+  N_VAddConst(weight, SUN_RCONST(-2.0), abstol);
+  err = N_VMaxNorm(abstol);
+  if (retval != 0 || err != ZERO)
+  {
+    fprintf(stderr, "cvEwtSetSS_host returned %i, weight error %g\n",
+            retval, (double) err);
+    passfail = 1;
+  }
+
+  N_VDestroy(abstol);
+  N_VDestroy(weight);
+
+  return passfail;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  N_Vector   y;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestFusedHost(CV_BDF,   SUNFALSE, SUNFALSE, 0, sunctx);
+  retval += TestFusedHost(CV_BDF,   SUNTRUE,  SUNFALSE, 0, sunctx);
+  retval += TestFusedHost(CV_BDF,   SUNFALSE, SUNTRUE,  0, sunctx);
+  retval += TestFusedHost(CV_ADAMS, SUNFALSE, SUNFALSE, 0, sunctx);
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  retval += TestEwtFail(y);
+  N_VDestroy(y);
+
+#if defined(USE_PTHREADS)
+  retval += TestFusedHost(CV_BDF,   SUNFALSE, SUNFALSE, NTHREADS, sunctx);
+  retval += TestFusedHost(CV_BDF,   SUNTRUE,  SUNFALSE, NTHREADS, sunctx);
+
+  y = N_VNew_Pthreads(NEQ, NTHREADS, sunctx);
+  retval += TestEwtFail(y);
+  N_VDestroy(y);
+#endif
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,266 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the combined error test and order selection reductions in
+ * CVODE. The Robertson chemical kinetics problem is integrated with a serial
+ * vector and with a serial vector that also provides the single buffer
+ * reduction operation N_VDotProdMultiAllReduce (a no-op for a serial vector),
+ * which enables the combined reductions. The solutions and step counts of the
+ * two runs are compared and the second run must perform fewer reductions, as
+ * reported by CVodeGetNumReductions. The error weights are also computed with
+ * mock split-phase reductions to check that the weight vector is left unchanged
+ * when a component of the tolerance is not positive.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "cvode/cvode.h"
+#include "cvode/cvode_impl.h"
+
+#define NEQ 3
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Right-hand side function */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype *yd = N_VGetArrayPointer(y);
+  realtype *fd = N_VGetArrayPointer(ydot);
+  realtype r1, r2, r3;
+
+  r1 = SUN_RCONST(0.04) * yd[0];
+  r2 = SUN_RCONST(1.0e4) * yd[1] * yd[2];
+  r3 = SUN_RCONST(3.0e7) * yd[1] * yd[1];
+  fd[0] = -r1 + r2;
+  fd[1] =  r1 - r2 - r3;
+  fd[2] =  r3;
+
+  return 0;
+}
+
+/* Local sums of a serial vector are already global */
+static int DotProdMultiAllReduce(int nvec, N_Vector x, realtype *sum)
+{
+  return 0;
+}
+
+/* Split-phase reductions of a serial vector only count the calls */
+static int nstart = 0;
+
+static int AllReduceStart(int nvec, N_Vector x, realtype *buf, int op)
+{
+  nstart++;
+  return 0;
+}
+
+static int AllReduceFinish(N_Vector x)
+{
+  return 0;
+}
+
+/* Integrate to tout and return the solution and counters */
+static int Integrate(booleantype fuse, int lmm, booleantype constr,
+                     N_Vector y, long int *nst, long int *nreduce,
+                     SUNContext sunctx)
+{
+  int             retval;
+  realtype        t;
+  N_Vector        constraints = NULL;
+  SUNMatrix       A  = NULL;
+  SUNLinearSolver LS = NULL;
+  void            *cvode_mem;
+
+  y->ops->nvdotprodmultiallreduce = fuse ? DotProdMultiAllReduce : NULL;
+
+  NV_Ith_S(y, 0) = ONE;
+  NV_Ith_S(y, 1) = ZERO;
+  NV_Ith_S(y, 2) = ZERO;
+
+  cvode_mem = CVodeCreate(lmm, sunctx);
+  retval = CVodeInit(cvode_mem, f, ZERO, y);
+  if (retval) return retval;
+
+  retval = CVodeSStolerances(cvode_mem, SUN_RCONST(1.0e-4),
+                             SUN_RCONST(1.0e-10));
+  if (retval) return retval;
+
+  if (constr)
+  {
+    constraints = N_VClone(y);
+    N_VConst(ONE, constraints);
+    retval = CVodeSetConstraints(cvode_mem, constraints);
+    if (retval) return retval;
+  }
+
+  A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (retval) return retval;
+
+  retval = CVodeSetMaxNumSteps(cvode_mem, 50000);
+  if (retval) return retval;
+
+  retval = CVode(cvode_mem, SUN_RCONST(40.0), y, &t, CV_NORMAL);
+  if (retval < 0)
+  {
+    fprintf(stderr, "CVode returned %i\n", retval);
+    return retval;
+  }
+
+  CVodeGetNumSteps(cvode_mem, nst);
+  CVodeGetNumReductions(cvode_mem, nreduce);
+
+  CVodeFree(&cvode_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  if (constraints) N_VDestroy(constraints);
+
+  return 0;
+}
+
+static int TestReductions(int lmm, booleantype constr, SUNContext sunctx)
+{
+  int      retval;
+  long int nst_ref, nst_fused, nred_ref, nred_fused;
+  realtype err;
+  N_Vector y_ref, y_fused;
+
+  y_ref   = N_VNew_Serial(NEQ, sunctx);
+  y_fused = N_VNew_Serial(NEQ, sunctx);
+
+  retval = Integrate(SUNFALSE, lmm, constr, y_ref, &nst_ref, &nred_ref,
+                     sunctx);
+  if (retval) return 1;
+
+  retval = Integrate(SUNTRUE, lmm, constr, y_fused, &nst_fused, &nred_fused,
+                     sunctx);
+  if (retval) return 1;
+
+  N_VLinearSum(ONE, y_ref, -ONE, y_fused, y_ref);
+  err = N_VMaxNorm(y_ref);
+
+  printf("lmm = %i, constraints = %i: steps %ld (reference %ld), "
+         "reductions %ld (reference %ld), max diff %g\n", lmm, (int) constr,
+         nst_fused, nst_ref, nred_fused, nred_ref, (double) err);
+
+  N_VDestroy(y_ref);
+  N_VDestroy(y_fused);
+
+  if (nst_ref != nst_fused || err > SUN_RCONST(1.0e-10))
+  {
+    fprintf(stderr, "solutions with and without fused reductions differ\n");
+    return 1;
+  }
+
+  if (nred_fused >= nred_ref)
+  {
+    fprintf(stderr, "fused reductions did not reduce the reduction count\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+/* Check that the error weights computed with split-phase reductions are only
+   written once the minimum of reltol*|y| + abstol is known to be positive */
+static int TestEwtSplit(SUNContext sunctx)
+{
+  int      retval, passfail = 0;
+  realtype err;
+  N_Vector y, weight;
+  void     *cvode_mem;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  y->ops->nvallreducestart  = AllReduceStart;
+  y->ops->nvallreducefinish = AllReduceFinish;
+  weight = N_VClone(y);
+
+  N_VConst(ONE, y);
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  retval = CVodeInit(cvode_mem, f, ZERO, y);
+  if (retval) return retval;
+
+  retval = CVodeSStolerances(cvode_mem, SUN_RCONST(0.5), ZERO);
+  if (retval) return retval;
+
+  /* a zero component fails the test without modifying the weights */
+  NV_Ith_S(y, NEQ - 1) = ZERO;
+  N_VConst(SUN_RCONST(7.0), weight);
+  nstart = 0;
+  retval = cvEwtSet(y, weight, cvode_mem);
+  N_VAddConst(weight, SUN_RCONST(-7.0), y);
+  err = N_VMaxNorm(y);
+  if (retval != -1 || err != ZERO || nstart != 1)
+  {
+    fprintf(stderr, "cvEwtSet returned %i with %i split reductions, weight "
+            "changed by %g\n", retval, nstart, (double) err);
+    passfail = 1;
+  }
+
+  /* with positive components the weights are set */
+  N_VConst(ONE, y);
+  nstart = 0;
+  retval = cvEwtSet(y, weight, cvode_mem);
+  N_VAddConst(weight, SUN_RCONST(-2.0), y);
+  err = N_VMaxNorm(y);
+  if (retval != 0 || err != ZERO || nstart != 1)
+  {
+    fprintf(stderr, "cvEwtSet returned %i with %i split reductions, weight "
+            "error %g\n", retval, nstart, (double) err);
+    passfail = 1;
+  }
+
+  CVodeFree(&cvode_mem);
+  N_VDestroy(y);
+  N_VDestroy(weight);
+
+  return passfail;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestReductions(CV_BDF,   SUNFALSE, sunctx);
+  retval += TestReductions(CV_BDF,   SUNTRUE,  sunctx);
+  retval += TestReductions(CV_ADAMS, SUNFALSE, sunctx);
+  retval += TestEwtSplit(sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,339 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the colored sparse difference quotient Jacobian enabled with
+ * CVodeSetJacSparsityPattern. The system is a periodic nonlinear diffusion
+ * problem with a tridiagonal plus corner sparsity pattern,
+ *
+ *   y_i' = -y_i^2 + y_{i-1} - 2 y_i + y_{i+1},
+ *
+ * for which three column colors suffice when N is divisible by three. The DQ
+ * Jacobian is compared to the analytic Jacobian in CSC, CSR and BSR format,
+ * with 3 x 3 blocks the block columns also need three colors.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_bsr.h"
+#include "sunmatrix/sunmatrix_sparse.h"
+#include "sundials/sundials_math.h"
+#include "cvode/cvode.h"
+#include "cvode/cvode_ls.h"
+#include "cvode/cvode_ls_impl.h"
+
+#define NEQ 18
+#define BS  3
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+/* Right-hand side function */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype *yd = N_VGetArrayPointer(y);
+  realtype *fd = N_VGetArrayPointer(ydot);
+  int i;
+
+  for (i = 0; i < NEQ; i++)
+  {
+    fd[i] = -yd[i] * yd[i] + yd[(i + NEQ - 1) % NEQ] - TWO * yd[i]
+            + yd[(i + 1) % NEQ];
+  }
+
+  return 0;
+}
+
+/* Dummy direct linear solver, only needed to attach the sparse matrix */
+static SUNLinearSolver_Type LSGetType(SUNLinearSolver S)
+{
+  return SUNLINEARSOLVER_DIRECT;
+}
+
+static int LSSolve(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
+                   realtype tol)
+{
+  return SUNLS_SUCCESS;
+}
+
+/* Fill the periodic tridiagonal pattern with the analytic Jacobian (the matrix
+   is symmetric so the same loop works for CSC and CSR storage) */
+static void FillJacobian(SUNMatrix J, N_Vector y)
+{
+  realtype     *yd = N_VGetArrayPointer(y);
+  realtype     *data = SUNSparseMatrix_Data(J);
+  sunindextype *ptrs = SUNSparseMatrix_IndexPointers(J);
+  sunindextype *vals = SUNSparseMatrix_IndexValues(J);
+  sunindextype i, k, tmp, nnz = 0;
+  sunindextype idx[3];
+
+  for (i = 0; i < NEQ; i++)
+  {
+    /* sorted neighbors of i on the periodic grid */
+    idx[0] = (i + NEQ - 1) % NEQ;
+    idx[1] = i;
+    idx[2] = (i + 1) % NEQ;
+    if (idx[0] > idx[1]) { tmp = idx[0]; idx[0] = idx[1]; idx[1] = tmp; }
+    if (idx[1] > idx[2]) { tmp = idx[1]; idx[1] = idx[2]; idx[2] = tmp; }
+    if (idx[0] > idx[1]) { tmp = idx[0]; idx[0] = idx[1]; idx[1] = tmp; }
+
+    ptrs[i] = nnz;
+    for (k = 0; k < 3; k++)
+    {
+      vals[nnz] = idx[k];
+      data[nnz] = (idx[k] == i) ? -TWO * yd[i] - TWO : ONE;
+      nnz++;
+    }
+  }
+  ptrs[NEQ] = nnz;
+}
+
+static int TestSparseDQ(int sparsetype, SUNContext sunctx)
+{
+  int             retval;
+  int             passfail = 0;
+  sunindextype    i;
+  long int        nfeLS;
+  realtype        tol, err;
+  N_Vector        y, fy;
+  SUNMatrix       A, P, Jref;
+  SUNLinearSolver LS;
+  CVodeMem        cv_mem;
+  void            *cvode_mem;
+
+  y  = N_VNew_Serial(NEQ, sunctx);
+  fy = N_VClone(y);
+  for (i = 0; i < NEQ; i++)
+  {
+    NV_Ith_S(y, i) = ONE + SUN_RCONST(0.1) * i;
+  }
+  f(ZERO, y, fy, NULL);
+
+  A    = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  P    = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  Jref = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  FillJacobian(P, y);
+  FillJacobian(Jref, y);
+
+  LS = SUNLinSolNewEmpty(sunctx);
+  LS->ops->gettype = LSGetType;
+  LS->ops->solve   = LSSolve;
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  retval = CVodeInit(cvode_mem, f, ZERO, y);
+  if (retval)
+  {
+    fprintf(stderr, "CVodeInit returned %i\n", retval);
+    return 1;
+  }
+
+  retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (retval)
+  {
+    fprintf(stderr, "CVodeSetLinearSolver returned %i\n", retval);
+    return 1;
+  }
+
+  retval = CVodeSetJacSparsityPattern(cvode_mem, P);
+  if (retval)
+  {
+    fprintf(stderr, "CVodeSetJacSparsityPattern returned %i\n", retval);
+    return 1;
+  }
+
+  /* set unit error weights and evaluate the DQ Jacobian */
+  cv_mem = (CVodeMem) cvode_mem;
+  N_VConst(ONE, cv_mem->cv_ewt);
+
+  retval = cvLsDQJac(ZERO, y, fy, A, cvode_mem, cv_mem->cv_tempv,
+                     cv_mem->cv_acor, cv_mem->cv_ftemp);
+  if (retval)
+  {
+    fprintf(stderr, "cvLsDQJac returned %i\n", retval);
+    return 1;
+  }
+
+  /* compare with the analytic Jacobian */
+  tol = SUN_RCONST(10.0) * SUNRsqrt(UNIT_ROUNDOFF) * TWO;
+  for (i = 0; i < 3 * NEQ; i++)
+  {
+    if (SUNSparseMatrix_IndexValues(A)[i] != SUNSparseMatrix_IndexValues(Jref)[i])
+    {
+      fprintf(stderr, "pattern mismatch at entry %ld\n", (long int) i);
+      passfail = 1;
+    }
+    err = SUNRabs(SUNSparseMatrix_Data(A)[i] - SUNSparseMatrix_Data(Jref)[i]);
+    if (err > tol)
+    {
+      fprintf(stderr, "entry %ld error %g > %g\n", (long int) i,
+              (double) err, (double) tol);
+      passfail = 1;
+    }
+  }
+
+  /* one RHS evaluation per color */
+  CVodeGetNumLinRhsEvals(cvode_mem, &nfeLS);
+  if (nfeLS != 3)
+  {
+    fprintf(stderr, "expected 3 RHS evaluations, got %ld\n", nfeLS);
+    passfail = 1;
+  }
+
+  CVodeFree(&cvode_mem);
+  SUNLinSolFreeEmpty(LS);
+  SUNMatDestroy(A);
+  SUNMatDestroy(P);
+  SUNMatDestroy(Jref);
+  N_VDestroy(y);
+  N_VDestroy(fy);
+
+  return passfail;
+}
+
+static int TestBSRDQ(SUNContext sunctx)
+{
+  int             retval;
+  int             passfail = 0;
+  sunindextype    i, nnz;
+  long int        nfeLS;
+  realtype        tol, err;
+  N_Vector        y, fy;
+  SUNMatrix       S, A, P, Jref;
+  SUNLinearSolver LS;
+  CVodeMem        cv_mem;
+  void            *cvode_mem;
+
+  y  = N_VNew_Serial(NEQ, sunctx);
+  fy = N_VClone(y);
+  for (i = 0; i < NEQ; i++)
+  {
+    NV_Ith_S(y, i) = ONE + SUN_RCONST(0.1) * i;
+  }
+  f(ZERO, y, fy, NULL);
+
+  /* block the analytic Jacobian, the blocks hold explicit zeros */
+  S = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, CSR_MAT, sunctx);
+  FillJacobian(S, y);
+  P    = SUNBSRFromSparseMatrix(S, BS);
+  Jref = SUNBSRFromSparseMatrix(S, BS);
+  A    = SUNMatClone(P);
+  if (!P || !Jref || !A)
+  {
+    fprintf(stderr, "SUNBSRFromSparseMatrix failed\n");
+    return 1;
+  }
+
+  LS = SUNLinSolNewEmpty(sunctx);
+  LS->ops->gettype = LSGetType;
+  LS->ops->solve   = LSSolve;
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  retval = CVodeInit(cvode_mem, f, ZERO, y);
+  if (retval)
+  {
+    fprintf(stderr, "CVodeInit returned %i\n", retval);
+    return 1;
+  }
+
+  retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (retval)
+  {
+    fprintf(stderr, "CVodeSetLinearSolver returned %i\n", retval);
+    return 1;
+  }
+
+  retval = CVodeSetJacSparsityPattern(cvode_mem, P);
+  if (retval)
+  {
+    fprintf(stderr, "CVodeSetJacSparsityPattern returned %i\n", retval);
+    return 1;
+  }
+
+  /* set unit error weights and evaluate the DQ Jacobian */
+  cv_mem = (CVodeMem) cvode_mem;
+  N_VConst(ONE, cv_mem->cv_ewt);
+
+  retval = cvLsDQJac(ZERO, y, fy, A, cvode_mem, cv_mem->cv_tempv,
+                     cv_mem->cv_acor, cv_mem->cv_ftemp);
+  if (retval)
+  {
+    fprintf(stderr, "cvLsDQJac returned %i\n", retval);
+    return 1;
+  }
+
+  /* compare with the analytic Jacobian */
+  tol = SUN_RCONST(10.0) * SUNRsqrt(UNIT_ROUNDOFF) * TWO;
+  nnz = SUNBSRMatrix_IndexPointers(Jref)[NEQ / BS] * BS * BS;
+  for (i = 0; i < nnz; i++)
+  {
+    err = SUNRabs(SUNBSRMatrix_Data(A)[i] - SUNBSRMatrix_Data(Jref)[i]);
+    if (err > tol)
+    {
+      fprintf(stderr, "BSR entry %ld error %g > %g\n", (long int) i,
+              (double) err, (double) tol);
+      passfail = 1;
+    }
+  }
+
+  /* one RHS evaluation per color, three block colors of BS columns */
+  CVodeGetNumLinRhsEvals(cvode_mem, &nfeLS);
+  if (nfeLS != 3 * BS)
+  {
+    fprintf(stderr, "expected %d RHS evaluations, got %ld\n", 3 * BS, nfeLS);
+    passfail = 1;
+  }
+
+  CVodeFree(&cvode_mem);
+  SUNLinSolFreeEmpty(LS);
+  SUNMatDestroy(S);
+  SUNMatDestroy(A);
+  SUNMatDestroy(P);
+  SUNMatDestroy(Jref);
+  N_VDestroy(y);
+  N_VDestroy(fy);
+
+  return passfail;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestSparseDQ(CSC_MAT, sunctx);
+  retval += TestSparseDQ(CSR_MAT, sunctx);
+  retval += TestBSRDQ(sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,305 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the SUNContext vector pool. The 1D heat equation
+ *
+ *   u_t = u_xx,  u(0) = u(1) = 0
+ *
+ * is integrated by two CVODE instances sharing a context, one using SPGMR and
+ * one using SPFGMR. With the vector pool enabled the linear solvers borrow
+ * their Krylov vectors during each solve, so the second solver reuses the
+ * vectors of the first. The solutions must match the runs without the pool.
+ * The test also checks that vectors are not shared between templates with
+ * different thread counts and that detaching a memory helper from the context
+ * releases the pooled vectors it allocated.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "cvode/cvode.h"
+#include "nvector/nvector_serial.h"
+#include "sunmemory/sunmemory_pool.h"
+#include "sundials/sundials_math.h"
+#include "sunlinsol/sunlinsol_spfgmr.h"
+#include "sunlinsol/sunlinsol_spgmr.h"
+
+#if defined(USE_PTHREADS)
+#include "nvector/nvector_pthreads.h"
+#endif
+
+#define NX   40
+#define MAXL 10
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TF   SUN_RCONST(0.1)
+#define PI   SUN_RCONST(3.141592653589793238462643383279502884197169)
+
+/* Right-hand side function */
+static int f(realtype t, N_Vector u, N_Vector udot, void *user_data)
+{
+  sunindextype i;
+  realtype *ud  = N_VGetArrayPointer(u);
+  realtype *dud = N_VGetArrayPointer(udot);
+  realtype dx   = ONE / (NX + 1);
+  realtype c    = ONE / (dx * dx);
+  realtype ul, ur;
+
+  for (i = 0; i < NX; i++)
+  {
+    ul     = (i > 0) ? ud[i-1] : ZERO;
+    ur     = (i < NX - 1) ? ud[i+1] : ZERO;
+    dud[i] = c * (ul - SUN_RCONST(2.0) * ud[i] + ur);
+  }
+
+  return 0;
+}
+
+/* Create a CVODE instance with SPGMR (0) or SPFGMR (1) */
+static void* Create(int solver, N_Vector u, SUNLinearSolver *LS,
+                    SUNContext sunctx)
+{
+  sunindextype i;
+  realtype *ud = N_VGetArrayPointer(u);
+  void *cvode_mem;
+
+  for (i = 0; i < NX; i++)
+    ud[i] = sin(PI * (i + 1) / (NX + 1));
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  if (!cvode_mem) return NULL;
+
+  if (CVodeInit(cvode_mem, f, ZERO, u)) return NULL;
+  if (CVodeSStolerances(cvode_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-10)))
+    return NULL;
+
+  if (solver == 0) *LS = SUNLinSol_SPGMR(u, SUN_PREC_NONE, MAXL, sunctx);
+  else             *LS = SUNLinSol_SPFGMR(u, SUN_PREC_NONE, MAXL, sunctx);
+  if (!(*LS)) return NULL;
+
+  if (CVodeSetLinearSolver(cvode_mem, *LS, NULL)) return NULL;
+
+  return cvode_mem;
+}
+
+/* Integrate both problems, alternating between them each step */
+static int Integrate(N_Vector u0, N_Vector u1, long int *nli,
+                     SUNContext sunctx)
+{
+  int retval;
+  long int nli0, nli1;
+  realtype t0 = ZERO, t1 = ZERO;
+  void *cvode_mem0, *cvode_mem1;
+  SUNLinearSolver LS0, LS1;
+
+  cvode_mem0 = Create(0, u0, &LS0, sunctx);
+  cvode_mem1 = Create(1, u1, &LS1, sunctx);
+  if (!cvode_mem0 || !cvode_mem1) return 1;
+
+  CVodeSetStopTime(cvode_mem0, TF);
+  CVodeSetStopTime(cvode_mem1, TF);
+
+  while (t0 < TF || t1 < TF)
+  {
+    if (t0 < TF)
+    {
+      retval = CVode(cvode_mem0, TF, u0, &t0, CV_ONE_STEP);
+      if (retval < 0) return 1;
+    }
+    if (t1 < TF)
+    {
+      retval = CVode(cvode_mem1, TF, u1, &t1, CV_ONE_STEP);
+      if (retval < 0) return 1;
+    }
+  }
+
+  CVodeGetNumLinIters(cvode_mem0, &nli0);
+  CVodeGetNumLinIters(cvode_mem1, &nli1);
+  *nli = nli0 + nli1;
+
+  CVodeFree(&cvode_mem0);
+  CVodeFree(&cvode_mem1);
+  SUNLinSolFree(LS0);
+  SUNLinSolFree(LS1);
+
+  return 0;
+}
+
+/* Check out and return count vectors, returns the number of new clones */
+static long int Cycle(N_Vector w, int count, int num_threads,
+                      SUNContext sunctx)
+{
+  long int num_clones, num_checkouts, num_in_use, max_in_use, clones0;
+  N_Vector *vs;
+
+  SUNContext_GetVectorPoolStats(sunctx, &clones0, &num_checkouts, &num_in_use,
+                                &max_in_use);
+
+  vs = N_VCheckoutVectorArray(count, w);
+  if (!vs) return -1;
+
+#if defined(USE_PTHREADS)
+  if (num_threads > 0 && NV_NUM_THREADS_PT(vs[0]) != num_threads) return -1;
+#endif
+
+  N_VReturnVectorArray(vs, count);
+
+  SUNContext_GetVectorPoolStats(sunctx, &num_clones, &num_checkouts,
+                                &num_in_use, &max_in_use);
+
+  return num_clones - clones0;
+}
+
+/* Pooled vectors allocated through a memory helper are destroyed when the
+   helper is detached, so the helper can be destroyed before the context */
+static int TestMemoryHelper(SUNContext sunctx)
+{
+  int             passfail = 0;
+  N_Vector        w;
+  SUNMemoryHelper helper;
+
+  helper = SUNMemoryHelper_Pool(sunctx);
+  if (!helper) return 1;
+
+  SUNContext_SetMemoryHelper(sunctx, helper);
+
+  w = N_VNew_Serial(NX, sunctx);
+  if (Cycle(w, 3, 0, sunctx) != 3 || Cycle(w, 3, 0, sunctx) != 0)
+  {
+    fprintf(stderr, "pooled vectors were not reused\n");
+    passfail = 1;
+  }
+  N_VDestroy(w);
+
+  SUNContext_SetMemoryHelper(sunctx, NULL);
+  SUNMemoryHelper_Destroy(helper);
+
+  w = N_VNew_Serial(NX, sunctx);
+  if (Cycle(w, 3, 0, sunctx) != 3)
+  {
+    fprintf(stderr, "detaching the memory helper did not release the pool\n");
+    passfail = 1;
+  }
+  N_VDestroy(w);
+
+  return passfail;
+}
+
+#if defined(USE_PTHREADS)
+/* Vectors of the same length with different thread counts are not shared */
+static int TestThreads(SUNContext sunctx)
+{
+  int      passfail = 0;
+  N_Vector w1, w2;
+
+  w1 = N_VNew_Pthreads(NX, 1, sunctx);
+  w2 = N_VNew_Pthreads(NX, 2, sunctx);
+
+  if (Cycle(w1, 2, 1, sunctx) != 2 || Cycle(w2, 2, 2, sunctx) != 2 ||
+      Cycle(w1, 2, 1, sunctx) != 0 || Cycle(w2, 2, 2, sunctx) != 0)
+  {
+    fprintf(stderr, "vectors with different thread counts were shared\n");
+    passfail = 1;
+  }
+
+  N_VDestroy(w1);
+  N_VDestroy(w2);
+
+  return passfail;
+}
+#endif
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  long int   nli_ref, nli, num_clones, num_checkouts, num_in_use, max_in_use;
+  N_Vector   u0_ref, u1_ref, u0, u1;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  u0_ref = N_VNew_Serial(NX, sunctx);
+  u1_ref = N_VNew_Serial(NX, sunctx);
+  u0     = N_VNew_Serial(NX, sunctx);
+  u1     = N_VNew_Serial(NX, sunctx);
+
+  /* Reference run without the pool */
+  if (Integrate(u0_ref, u1_ref, &nli_ref, sunctx))
+  {
+    fprintf(stderr, "integration without the vector pool failed\n");
+    return 1;
+  }
+
+  /* Run with the pool */
+  SUNContext_EnableVectorPool(sunctx, SUNTRUE);
+
+  if (Integrate(u0, u1, &nli, sunctx))
+  {
+    fprintf(stderr, "integration with the vector pool failed\n");
+    return 1;
+  }
+
+  SUNContext_GetVectorPoolStats(sunctx, &num_clones, &num_checkouts,
+                                &num_in_use, &max_in_use);
+
+  printf("linear iterations %ld (reference %ld)\n", nli, nli_ref);
+  printf("vector pool: clones %ld, checkouts %ld, in use %ld, max in use %ld\n",
+         num_clones, num_checkouts, num_in_use, max_in_use);
+
+  N_VLinearSum(ONE, u0, -ONE, u0_ref, u0);
+  N_VLinearSum(ONE, u1, -ONE, u1_ref, u1);
+  if (N_VMaxNorm(u0) != ZERO || N_VMaxNorm(u1) != ZERO || nli != nli_ref)
+  {
+    fprintf(stderr, "solutions with and without the vector pool differ\n");
+    retval = 1;
+  }
+
+  /* SPFGMR needs 2 (MAXL + 1) vectors and SPGMR reuses them */
+  if (num_clones != 2 * (MAXL + 1) || max_in_use != 2 * (MAXL + 1) ||
+      num_in_use != 0 || num_checkouts <= num_clones)
+  {
+    fprintf(stderr, "unexpected vector pool statistics\n");
+    retval = 1;
+  }
+
+  SUNContext_ReleaseVectorPool(sunctx);
+
+  retval += TestMemoryHelper(sunctx);
+#if defined(USE_PTHREADS)
+  retval += TestThreads(sunctx);
+#endif
+
+  N_VDestroy(u0_ref);
+  N_VDestroy(u1_ref);
+  N_VDestroy(u0);
+  N_VDestroy(u1);
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,252 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for binomial checkpointing enabled with CVodeSetAdjCheckpointSlots.
+ * The adjoint of the Robertson chemical kinetics problem (with a forward
+ * quadrature) is computed with all check points kept and with a limited number
+ * of check point slots, with and without a checkpoint store. The backward
+ * problem is integrated one step at a time to verify the number of check
+ * points never exceeds the number of slots. The adjoint solutions must agree
+ * to the last bit.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sundials/sundials_math.h"
+#include "cvodes/cvodes.h"
+#include "cvodes/cvodes_impl.h"
+
+#define NEQ    3
+#define NSTEPS 5
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Forward right-hand side function */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype *yd = N_VGetArrayPointer(y);
+  realtype *fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -SUN_RCONST(0.04) * yd[0] + SUN_RCONST(1.0e4) * yd[1] * yd[2];
+  fd[2] = SUN_RCONST(3.0e7) * yd[1] * yd[1];
+  fd[1] = -fd[0] - fd[2];
+
+  return 0;
+}
+
+/* Forward quadrature integrand */
+static int fQ(realtype t, N_Vector y, N_Vector qdot, void *user_data)
+{
+  NV_Ith_S(qdot, 0) = NV_Ith_S(y, 2);
+  return 0;
+}
+
+/* Adjoint right-hand side function, yB' = -J^T yB */
+static int fB(realtype t, N_Vector y, N_Vector yB, N_Vector yBdot,
+              void *user_dataB)
+{
+  realtype *yd  = N_VGetArrayPointer(y);
+  realtype *lb  = N_VGetArrayPointer(yB);
+  realtype *lbd = N_VGetArrayPointer(yBdot);
+  realtype p1 = SUN_RCONST(0.04), p2 = SUN_RCONST(1.0e4);
+  realtype p3 = SUN_RCONST(3.0e7);
+
+  lbd[0] = p1 * (lb[0] - lb[1]);
+  lbd[1] = -p2 * yd[2] * (lb[0] - lb[1])
+           + SUN_RCONST(2.0) * p3 * yd[1] * (lb[1] - lb[2]);
+  lbd[2] = -p2 * yd[1] * (lb[0] - lb[1]) - ONE;
+
+  return 0;
+}
+
+/* Solve the forward and adjoint problems and return the adjoint solution */
+static int SolveAdjoint(int nslots, booleantype usestore, N_Vector yB,
+                        SUNContext sunctx)
+{
+  int                retval, which, ncheck, maxckpnts = 0;
+  long int           nstR;
+  realtype           t, ratio;
+  N_Vector           y, q;
+  SUNMatrix          A, AB;
+  SUNLinearSolver    LS, LSB;
+  SUNCheckpointStore store = NULL;
+  void               *cvode_mem;
+  CVadjMem           ca_mem;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  q = N_VNew_Serial(1, sunctx);
+  NV_Ith_S(y, 0) = ONE;
+  NV_Ith_S(y, 1) = ZERO;
+  NV_Ith_S(y, 2) = ZERO;
+  NV_Ith_S(q, 0) = ZERO;
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  if (CVodeInit(cvode_mem, f, ZERO, y)) return 1;
+  if (CVodeSStolerances(cvode_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-10)))
+    return 1;
+  if (CVodeQuadInit(cvode_mem, fQ, q)) return 1;
+  if (CVodeSetQuadErrCon(cvode_mem, SUNTRUE)) return 1;
+  if (CVodeQuadSStolerances(cvode_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-8)))
+    return 1;
+
+  A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (CVodeSetLinearSolver(cvode_mem, LS, A)) return 1;
+
+  if (CVodeAdjInit(cvode_mem, NSTEPS, CV_HERMITE)) return 1;
+
+  retval = CVodeSetAdjCheckpointSlots(cvode_mem, nslots);
+  if (retval)
+  {
+    fprintf(stderr, "CVodeSetAdjCheckpointSlots returned %i\n", retval);
+    return 1;
+  }
+
+  if (usestore)
+  {
+    store = SUNCheckpointStore_CompressedMemory(sunctx);
+    if (CVodeSetAdjCheckpointStore(cvode_mem, store)) return 1;
+  }
+
+  /* integrate in two calls to check the schedule carries over */
+  retval = CVodeF(cvode_mem, SUN_RCONST(4.0), y, &t, CV_NORMAL, &ncheck);
+  if (retval < 0)
+  {
+    fprintf(stderr, "CVodeF returned %i\n", retval);
+    return 1;
+  }
+  retval = CVodeF(cvode_mem, SUN_RCONST(40.0), y, &t, CV_NORMAL, &ncheck);
+  if (retval < 0)
+  {
+    fprintf(stderr, "CVodeF returned %i\n", retval);
+    return 1;
+  }
+
+  N_VConst(ZERO, yB);
+  if (CVodeCreateB(cvode_mem, CV_BDF, &which)) return 1;
+  if (CVodeInitB(cvode_mem, which, fB, SUN_RCONST(40.0), yB)) return 1;
+  if (CVodeSStolerancesB(cvode_mem, which, SUN_RCONST(1.0e-6),
+                         SUN_RCONST(1.0e-8)))
+    return 1;
+
+  AB  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LSB = SUNLinSol_Dense(yB, AB, sunctx);
+  if (CVodeSetLinearSolverB(cvode_mem, which, LSB, AB)) return 1;
+
+  /* integrate the backward problem one step at a time to monitor the number
+     of check points */
+  ca_mem = ((CVodeMem) cvode_mem)->cv_adj_mem;
+  do
+  {
+    retval = CVodeB(cvode_mem, ZERO, CV_ONE_STEP);
+    if (retval < 0)
+    {
+      fprintf(stderr, "CVodeB returned %i\n", retval);
+      return 1;
+    }
+    if (ca_mem->ca_nckpnts + 1 > maxckpnts) maxckpnts = ca_mem->ca_nckpnts + 1;
+    if (CVodeGetB(cvode_mem, which, &t, yB)) return 1;
+  } while (t > ZERO);
+
+  CVodeGetAdjNumRecomputedSteps(cvode_mem, &nstR);
+  CVodeGetAdjRecomputationRatio(cvode_mem, &ratio);
+
+  printf("nslots = %2i, store = %i: max %2i check points, %ld steps "
+         "recomputed, ratio %.2f, lambda = %g %g %g\n", nslots, (int) usestore,
+         maxckpnts, nstR, (double) ratio, (double) NV_Ith_S(yB, 0),
+         (double) NV_Ith_S(yB, 1), (double) NV_Ith_S(yB, 2));
+
+  retval = 0;
+  if (nslots > 0 && maxckpnts > nslots)
+  {
+    fprintf(stderr, "too many check points\n");
+    retval = 1;
+  }
+
+  CVodeFree(&cvode_mem);
+  if (store) SUNCheckpointStore_Destroy(store);
+  SUNLinSolFree(LS);
+  SUNLinSolFree(LSB);
+  SUNMatDestroy(A);
+  SUNMatDestroy(AB);
+  N_VDestroy(y);
+  N_VDestroy(q);
+
+  return retval;
+}
+
+static int TestBinomial(int nslots, booleantype usestore, N_Vector yB_ref,
+                        SUNContext sunctx)
+{
+  int      retval;
+  N_Vector yB;
+
+  yB = N_VClone(yB_ref);
+
+  retval = SolveAdjoint(nslots, usestore, yB, sunctx);
+
+  if (!retval && memcmp(N_VGetArrayPointer(yB), N_VGetArrayPointer(yB_ref),
+                        NEQ * sizeof(realtype)))
+  {
+    fprintf(stderr, "nslots = %i: adjoint solution differs\n", nslots);
+    retval = 1;
+  }
+
+  N_VDestroy(yB);
+
+  return retval;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  N_Vector   yB_ref;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  yB_ref = N_VNew_Serial(NEQ, sunctx);
+
+  retval += SolveAdjoint(0, SUNFALSE, yB_ref, sunctx);
+  retval += TestBinomial(2, SUNFALSE, yB_ref, sunctx);
+  retval += TestBinomial(3, SUNFALSE, yB_ref, sunctx);
+  retval += TestBinomial(5, SUNFALSE, yB_ref, sunctx);
+  retval += TestBinomial(10, SUNFALSE, yB_ref, sunctx);
+  retval += TestBinomial(10, SUNTRUE, yB_ref, sunctx);
+
+  N_VDestroy(yB_ref);
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
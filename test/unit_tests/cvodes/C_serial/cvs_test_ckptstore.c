@@ -0,0 +1,400 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the checkpoint stores set with CVodeSetAdjCheckpointStore. The
+ * stores are first exercised directly, then the adjoint of the Robertson
+ * chemical kinetics problem (with a forward quadrature) is computed with the
+ * check points kept in N_Vectors and in the memory, compressed memory, and
+ * file stores. The adjoint solutions must agree to the last bit. The file
+ * store is also checked to reuse the space of removed and overwritten keys.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sundials/sundials_math.h"
+#include "cvodes/cvodes.h"
+
+#define NEQ   3
+#define NBUF  1000
+#define NKEYS 8
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Forward right-hand side function */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype *yd = N_VGetArrayPointer(y);
+  realtype *fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -SUN_RCONST(0.04) * yd[0] + SUN_RCONST(1.0e4) * yd[1] * yd[2];
+  fd[2] = SUN_RCONST(3.0e7) * yd[1] * yd[1];
+  fd[1] = -fd[0] - fd[2];
+
+  return 0;
+}
+
+/* Forward quadrature integrand */
+static int fQ(realtype t, N_Vector y, N_Vector qdot, void *user_data)
+{
+  NV_Ith_S(qdot, 0) = NV_Ith_S(y, 2);
+  return 0;
+}
+
+/* Adjoint right-hand side function, yB' = -J^T yB */
+static int fB(realtype t, N_Vector y, N_Vector yB, N_Vector yBdot,
+              void *user_dataB)
+{
+  realtype *yd  = N_VGetArrayPointer(y);
+  realtype *lb  = N_VGetArrayPointer(yB);
+  realtype *lbd = N_VGetArrayPointer(yBdot);
+  realtype p1 = SUN_RCONST(0.04), p2 = SUN_RCONST(1.0e4);
+  realtype p3 = SUN_RCONST(3.0e7);
+
+  lbd[0] = p1 * (lb[0] - lb[1]);
+  lbd[1] = -p2 * yd[2] * (lb[0] - lb[1])
+           + SUN_RCONST(2.0) * p3 * yd[1] * (lb[1] - lb[2]);
+  lbd[2] = -p2 * yd[1] * (lb[0] - lb[1]) - ONE;
+
+  return 0;
+}
+
+/* Smooth test data with some noise and zeros so the compressed store has
+   work to do (key 3 is overwritten with different data) */
+static realtype Data(long int key, int i, booleantype overwritten)
+{
+  if (overwritten && key == 3) return -i;
+  if (i % 50 == 0) return ZERO;
+  return ONE / (ONE + SUN_RCONST(0.001) * i * key) + (i % 7) * SUN_RCONST(1.0e-12);
+}
+
+/* Write, prefetch, read, overwrite, and remove blocks of a store */
+static int TestStore(SUNCheckpointStore store, const char *name)
+{
+  realtype *buf, *out;
+  size_t   bytes = NBUF * sizeof(realtype);
+  size_t   mem;
+  long int key;
+  int      i, retval = 0;
+
+  buf = (realtype*) malloc(bytes);
+  out = (realtype*) malloc(bytes);
+
+  for (key = 1; key <= NKEYS; key++)
+  {
+    for (i = 0; i < NBUF; i++) buf[i] = Data(key, i, SUNFALSE);
+    if (SUNCheckpointStore_Write(store, key, buf, bytes)) retval = 1;
+  }
+
+  /* overwrite a key with different data */
+  for (i = 0; i < NBUF; i++) buf[i] = Data(3, i, SUNTRUE);
+  if (SUNCheckpointStore_Write(store, 3, buf, bytes)) retval = 1;
+
+  /* read back in reverse order as the adjoint sweep does */
+  for (key = NKEYS; key >= 1; key--)
+  {
+    if (key > 1) SUNCheckpointStore_Prefetch(store, key - 1);
+    if (SUNCheckpointStore_Read(store, key, out, bytes)) retval = 1;
+    for (i = 0; i < NBUF; i++) buf[i] = Data(key, i, SUNTRUE);
+    if (memcmp(buf, out, bytes))
+    {
+      fprintf(stderr, "%s store: data for key %ld differs\n", name, key);
+      retval = 1;
+    }
+    if (SUNCheckpointStore_Remove(store, key)) retval = 1;
+  }
+
+  /* reading a removed key must fail */
+  if (SUNCheckpointStore_Read(store, 1, out, bytes) == 0)
+  {
+    fprintf(stderr, "%s store: read of a removed key succeeded\n", name);
+    retval = 1;
+  }
+
+  if (SUNCheckpointStore_GetMemoryUsage(store, &mem) == 0 && mem != 0)
+  {
+    fprintf(stderr, "%s store: %lu bytes left after removing all keys\n",
+            name, (unsigned long) mem);
+    retval = 1;
+  }
+
+  free(buf);
+  free(out);
+
+  return retval;
+}
+
+/* Write and remove the keys of an adjoint sweep many times (overwriting some
+   keys with smaller and larger data) and check that the file does not grow
+   beyond the data stored at once */
+static int TestFileReuse(SUNContext sunctx)
+{
+  const char         *filename = "cvs_test_ckptstore.tmp";
+  SUNCheckpointStore store;
+  FILE               *fp;
+  realtype           *buf, *out;
+  size_t             bytes = NBUF * sizeof(realtype);
+  long int           key, size;
+  int                cycle, i, retval = 0;
+
+  store = SUNCheckpointStore_File(filename, sunctx);
+  if (store == NULL)
+  {
+    fprintf(stderr, "creating the file store %s failed\n", filename);
+    return 1;
+  }
+
+  buf = (realtype*) malloc(bytes);
+  out = (realtype*) malloc(bytes);
+
+  for (cycle = 0; cycle < 20; cycle++)
+  {
+    for (key = 1; key <= NKEYS; key++)
+    {
+      for (i = 0; i < NBUF; i++) buf[i] = Data(key, i, SUNFALSE);
+      if (SUNCheckpointStore_Write(store, key, buf, bytes)) retval = 1;
+    }
+
+    /* overwrite with less and then more data */
+    if (SUNCheckpointStore_Write(store, 2, buf, bytes / 2)) retval = 1;
+    if (SUNCheckpointStore_Write(store, 5, buf, bytes / 4)) retval = 1;
+    for (i = 0; i < NBUF; i++) buf[i] = Data(2, i, SUNFALSE);
+    if (SUNCheckpointStore_Write(store, 2, buf, bytes)) retval = 1;
+
+    for (key = NKEYS; key >= 1; key--)
+    {
+      if (key == 5)
+      {
+        if (SUNCheckpointStore_Read(store, key, out, bytes / 4)) retval = 1;
+        SUNCheckpointStore_Remove(store, key);
+        continue;
+      }
+      if (SUNCheckpointStore_Read(store, key, out, bytes)) retval = 1;
+      for (i = 0; i < NBUF; i++) buf[i] = Data(key, i, SUNFALSE);
+      if (memcmp(buf, out, bytes))
+      {
+        fprintf(stderr, "file store: data for key %ld differs in cycle %i\n",
+                key, cycle);
+        retval = 1;
+      }
+      if (SUNCheckpointStore_Remove(store, key)) retval = 1;
+    }
+  }
+
+  /* the file holds at most the keys of one sweep plus the overwrites */
+  fp = fopen(filename, "rb");
+  if (fp == NULL || fseek(fp, 0, SEEK_END) != 0)
+  {
+    fprintf(stderr, "could not open %s\n", filename);
+    retval = 1;
+  }
+  else
+  {
+    size = ftell(fp);
+    if (size > (long int) ((NKEYS + 2) * bytes))
+    {
+      fprintf(stderr, "file store: file grew to %ld bytes\n", size);
+      retval = 1;
+    }
+  }
+  if (fp) fclose(fp);
+
+  SUNCheckpointStore_Destroy(store);
+  free(buf);
+  free(out);
+
+  return retval;
+}
+
+/* Solve the forward and adjoint problems and return the adjoint solution */
+static int SolveAdjoint(SUNCheckpointStore store, int interp, N_Vector yB,
+                        int *ncheck, SUNContext sunctx)
+{
+  int             retval, which;
+  realtype        t;
+  N_Vector        y, q;
+  SUNMatrix       A, AB;
+  SUNLinearSolver LS, LSB;
+  void            *cvode_mem;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  q = N_VNew_Serial(1, sunctx);
+  NV_Ith_S(y, 0) = ONE;
+  NV_Ith_S(y, 1) = ZERO;
+  NV_Ith_S(y, 2) = ZERO;
+  NV_Ith_S(q, 0) = ZERO;
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  if (CVodeInit(cvode_mem, f, ZERO, y)) return 1;
+  if (CVodeSStolerances(cvode_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-10)))
+    return 1;
+  if (CVodeQuadInit(cvode_mem, fQ, q)) return 1;
+  if (CVodeSetQuadErrCon(cvode_mem, SUNTRUE)) return 1;
+  if (CVodeQuadSStolerances(cvode_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-8)))
+    return 1;
+
+  A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (CVodeSetLinearSolver(cvode_mem, LS, A)) return 1;
+
+  /* use a short check point interval to create many check points */
+  if (CVodeAdjInit(cvode_mem, 20, interp)) return 1;
+
+  retval = CVodeSetAdjCheckpointStore(cvode_mem, store);
+  if (retval)
+  {
+    fprintf(stderr, "CVodeSetAdjCheckpointStore returned %i\n", retval);
+    return 1;
+  }
+
+  retval = CVodeF(cvode_mem, SUN_RCONST(40.0), y, &t, CV_NORMAL, ncheck);
+  if (retval < 0)
+  {
+    fprintf(stderr, "CVodeF returned %i\n", retval);
+    return 1;
+  }
+
+  /* the store may not be changed after the forward run */
+  CVodeSetErrFile(cvode_mem, NULL);
+  if (CVodeSetAdjCheckpointStore(cvode_mem, NULL) != CV_ILL_INPUT)
+  {
+    fprintf(stderr, "CVodeSetAdjCheckpointStore after CVodeF did not fail\n");
+    return 1;
+  }
+
+  N_VConst(ZERO, yB);
+  if (CVodeCreateB(cvode_mem, CV_BDF, &which)) return 1;
+  if (CVodeInitB(cvode_mem, which, fB, SUN_RCONST(40.0), yB)) return 1;
+  if (CVodeSStolerancesB(cvode_mem, which, SUN_RCONST(1.0e-6),
+                         SUN_RCONST(1.0e-8)))
+    return 1;
+
+  AB  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LSB = SUNLinSol_Dense(yB, AB, sunctx);
+  if (CVodeSetLinearSolverB(cvode_mem, which, LSB, AB)) return 1;
+
+  retval = CVodeB(cvode_mem, ZERO, CV_NORMAL);
+  if (retval < 0)
+  {
+    fprintf(stderr, "CVodeB returned %i\n", retval);
+    return 1;
+  }
+
+  if (CVodeGetB(cvode_mem, which, &t, yB)) return 1;
+
+  CVodeFree(&cvode_mem);
+  SUNLinSolFree(LS);
+  SUNLinSolFree(LSB);
+  SUNMatDestroy(A);
+  SUNMatDestroy(AB);
+  N_VDestroy(y);
+  N_VDestroy(q);
+
+  return 0;
+}
+
+static int TestAdjoint(SUNCheckpointStore store, const char *name, int interp,
+                       N_Vector yB_ref, SUNContext sunctx)
+{
+  int      retval, ncheck;
+  N_Vector yB;
+
+  yB = N_VClone(yB_ref);
+
+  retval = SolveAdjoint(store, interp, yB, &ncheck, sunctx);
+  if (retval) return 1;
+
+  printf("%s store, interp = %i: %i check points, lambda = %g %g %g\n", name,
+         interp, ncheck, (double) NV_Ith_S(yB, 0), (double) NV_Ith_S(yB, 1),
+         (double) NV_Ith_S(yB, 2));
+
+  if (memcmp(N_VGetArrayPointer(yB), N_VGetArrayPointer(yB_ref),
+             NEQ * sizeof(realtype)))
+  {
+    fprintf(stderr, "%s store: adjoint solution differs\n", name);
+    retval = 1;
+  }
+
+  N_VDestroy(yB);
+
+  return retval;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int                retval = 0;
+  int                i, interp, ncheck;
+  const char         *names[3] = {"memory", "compressed", "file"};
+  SUNCheckpointStore store;
+  N_Vector           yB_ref;
+  SUNContext         sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  yB_ref = N_VNew_Serial(NEQ, sunctx);
+
+  for (i = 0; i < 3; i++)
+  {
+    if (i == 0) store = SUNCheckpointStore_Memory(sunctx);
+    if (i == 1) store = SUNCheckpointStore_CompressedMemory(sunctx);
+    if (i == 2) store = SUNCheckpointStore_File(NULL, sunctx);
+    if (store == NULL)
+    {
+      fprintf(stderr, "creating the %s store failed\n", names[i]);
+      return 1;
+    }
+    retval += TestStore(store, names[i]);
+    SUNCheckpointStore_Destroy(store);
+  }
+
+  retval += TestFileReuse(sunctx);
+
+  for (interp = CV_HERMITE; interp <= CV_POLYNOMIAL; interp++)
+  {
+    retval += SolveAdjoint(NULL, interp, yB_ref, &ncheck, sunctx);
+
+    for (i = 0; i < 3; i++)
+    {
+      if (i == 0) store = SUNCheckpointStore_Memory(sunctx);
+      if (i == 1) store = SUNCheckpointStore_CompressedMemory(sunctx);
+      if (i == 2) store = SUNCheckpointStore_File(NULL, sunctx);
+      retval += TestAdjoint(store, names[i], interp, yB_ref, sunctx);
+      SUNCheckpointStore_Destroy(store);
+    }
+  }
+
+  N_VDestroy(yB_ref);
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
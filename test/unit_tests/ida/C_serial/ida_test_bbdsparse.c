@@ -0,0 +1,278 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the sparse local blocks of the BBD preconditioner enabled with
+ * IDABBDPrecInitSparse. The residual is a nonlinear diffusion problem made of
+ * two uncoupled chains of NEQ/2 components,
+ *
+ *   G_i = y_i' + y_i^2 - y_{i-1} + 2 y_i - y_{i+1},
+ *
+ * so that the local block is tridiagonal and splitting it in two sub-blocks
+ * drops no entry. After a few steps with the banded preconditioner of
+ * IDABBDPrecInit, the preconditioner is set up and applied to a vector with the
+ * banded and the sparse local blocks, in CSC and CSR format, with one and two
+ * sub-blocks and with the default ILU(0) or a user supplied sub-block solver.
+ * Both are exact factorizations of the same difference quotient approximation
+ * of dG/dy + c_j dG/dy', so the results must agree to rounding.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_sparse.h"
+#include "sunlinsol/sunlinsol_ilu.h"
+#include "sunlinsol/sunlinsol_spgmr.h"
+#include "sundials/sundials_math.h"
+#include "ida/ida.h"
+#include "ida/ida_bbdpre.h"
+#include "ida/ida_impl.h"
+#include "ida/ida_ls_impl.h"
+
+#define NEQ   18
+#define NHALF (NEQ / 2)
+
+#define ZERO  SUN_RCONST(0.0)
+#define ONE   SUN_RCONST(1.0)
+#define TWO   SUN_RCONST(2.0)
+#define CJ    SUN_RCONST(10.0)
+
+/* Residual and local residual function */
+static int g(sunindextype Nlocal, realtype t, N_Vector y, N_Vector yp,
+             N_Vector gy, void *user_data)
+{
+  realtype *yd  = N_VGetArrayPointer(y);
+  realtype *ypd = N_VGetArrayPointer(yp);
+  realtype *gd  = N_VGetArrayPointer(gy);
+  sunindextype i;
+
+  for (i = 0; i < NEQ; i++)
+  {
+    gd[i] = ypd[i] + yd[i] * yd[i] + TWO * yd[i];
+    if (i % NHALF > 0)         gd[i] -= yd[i - 1];
+    if (i % NHALF < NHALF - 1) gd[i] -= yd[i + 1];
+  }
+
+  return 0;
+}
+
+static int res(realtype t, N_Vector y, N_Vector yp, N_Vector r,
+               void *user_data)
+{
+  return g(NEQ, t, y, yp, r, user_data);
+}
+
+/* Sub-block solver keeping some fill, to test a user supplied solver */
+static SUNLinearSolver ILU2(N_Vector y, SUNMatrix A, SUNContext sunctx)
+{
+  return SUNLinSol_ILU(y, A, 2, sunctx);
+}
+
+/* Set up the attached preconditioner and solve P z = r, returning the number
+   of local residual evaluations of the setup */
+static int PrecSetupSolve(void *ida_mem, N_Vector y, N_Vector yp,
+                          N_Vector rr, N_Vector r, N_Vector z, long int *nge)
+{
+  IDAMem   IDA_mem = (IDAMem) ida_mem;
+  IDALsMem idals_mem = (IDALsMem) IDA_mem->ida_lmem;
+  long int nge0, nge1;
+  int      retval;
+
+  IDABBDPrecGetNumGfnEvals(ida_mem, &nge0);
+
+  retval = idals_mem->pset(IDA_mem->ida_tn, y, yp, rr, CJ, idals_mem->pdata);
+  if (retval)
+  {
+    fprintf(stderr, "preconditioner setup returned %i\n", retval);
+    return 1;
+  }
+
+  retval = idals_mem->psolve(IDA_mem->ida_tn, y, yp, rr, r, z, CJ, ZERO,
+                             idals_mem->pdata);
+  if (retval)
+  {
+    fprintf(stderr, "preconditioner solve returned %i\n", retval);
+    return 1;
+  }
+
+  IDABBDPrecGetNumGfnEvals(ida_mem, &nge1);
+  *nge = nge1 - nge0;
+
+  return 0;
+}
+
+static int TestBBDSparse(int sparsetype, int nsub, IDABBDLinSolFn lsfn,
+                         SUNContext sunctx)
+{
+  int             retval;
+  int             passfail = 0;
+  long int        nge_band, nge_sparse;
+  realtype        t, tol, err;
+  sunindextype    i, k, nnz;
+  sunindextype    *ptrs, *vals;
+  N_Vector        y, yp, rr, r, zband, zsparse;
+  SUNMatrix       P;
+  SUNLinearSolver LS;
+  void            *ida_mem;
+
+  y       = N_VNew_Serial(NEQ, sunctx);
+  yp      = N_VClone(y);
+  rr      = N_VClone(y);
+  r       = N_VClone(y);
+  zband   = N_VClone(y);
+  zsparse = N_VClone(y);
+  for (i = 0; i < NEQ; i++)
+  {
+    NV_Ith_S(y, i) = ONE + SUN_RCONST(0.1) * i;
+    NV_Ith_S(r, i) = (i % 2) ? -ONE : ONE;
+  }
+
+  /* consistent initial derivatives */
+  N_VConst(ZERO, yp);
+  res(ZERO, y, yp, yp, NULL);
+  N_VScale(-ONE, yp, yp);
+
+  /* tridiagonal pattern without the couplings between the two chains (the
+     pattern is symmetric so the same loop works for CSC and CSR storage) */
+  P    = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  ptrs = SUNSparseMatrix_IndexPointers(P);
+  vals = SUNSparseMatrix_IndexValues(P);
+  nnz  = 0;
+  for (i = 0; i < NEQ; i++)
+  {
+    ptrs[i] = nnz;
+    for (k = i - 1; k <= i + 1; k++)
+    {
+      if ((k < 0) || (k >= NEQ) || (k / NHALF != i / NHALF)) continue;
+      vals[nnz++] = k;
+    }
+  }
+  ptrs[NEQ] = nnz;
+
+  LS = SUNLinSol_SPGMR(y, SUN_PREC_LEFT, 0, sunctx);
+
+  ida_mem = IDACreate(sunctx);
+  retval = IDAInit(ida_mem, res, ZERO, y, yp);
+  if (retval)
+  {
+    fprintf(stderr, "IDAInit returned %i\n", retval);
+    return 1;
+  }
+
+  retval = IDASStolerances(ida_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-9));
+  if (retval)
+  {
+    fprintf(stderr, "IDASStolerances returned %i\n", retval);
+    return 1;
+  }
+
+  retval = IDASetLinearSolver(ida_mem, LS, NULL);
+  if (retval)
+  {
+    fprintf(stderr, "IDASetLinearSolver returned %i\n", retval);
+    return 1;
+  }
+
+  retval = IDABBDPrecInit(ida_mem, NEQ, 1, 1, 1, 1, ZERO, g, NULL);
+  if (retval)
+  {
+    fprintf(stderr, "IDABBDPrecInit returned %i\n", retval);
+    return 1;
+  }
+
+  /* take a few steps to set the step size and error weights */
+  retval = IDASolve(ida_mem, SUN_RCONST(0.1), &t, y, yp, IDA_NORMAL);
+  if (retval < 0)
+  {
+    fprintf(stderr, "IDASolve returned %i\n", retval);
+    return 1;
+  }
+  res(t, y, yp, rr, NULL);
+
+  /* apply the banded and then the sparse preconditioner at the same state */
+  if (PrecSetupSolve(ida_mem, y, yp, rr, r, zband, &nge_band)) return 1;
+
+  retval = IDABBDPrecInitSparse(ida_mem, NEQ, P, nsub, lsfn, ZERO, g, NULL);
+  if (retval)
+  {
+    fprintf(stderr, "IDABBDPrecInitSparse returned %i\n", retval);
+    return 1;
+  }
+
+  if (PrecSetupSolve(ida_mem, y, yp, rr, r, zsparse, &nge_sparse)) return 1;
+
+  /* compare the preconditioned vectors */
+  tol = SUN_RCONST(1.0e3) * UNIT_ROUNDOFF * N_VMaxNorm(zband);
+  N_VLinearSum(ONE, zsparse, -ONE, zband, zsparse);
+  err = N_VMaxNorm(zsparse);
+  if (err > tol)
+  {
+    fprintf(stderr, "%s, %i sub-blocks: difference %g > %g\n",
+            (sparsetype == CSC_MAT) ? "CSC" : "CSR", nsub, (double) err,
+            (double) tol);
+    passfail = 1;
+  }
+
+  /* three colors plus the base evaluation, as with the banded quotient */
+  if ((nge_sparse != 4) || (nge_band != 4))
+  {
+    fprintf(stderr, "expected 4 local function evaluations, got %ld (sparse) "
+            "and %ld (banded)\n", nge_sparse, nge_band);
+    passfail = 1;
+  }
+
+  IDAFree(&ida_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(P);
+  N_VDestroy(y);
+  N_VDestroy(yp);
+  N_VDestroy(rr);
+  N_VDestroy(r);
+  N_VDestroy(zband);
+  N_VDestroy(zsparse);
+
+  return passfail;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestBBDSparse(CSC_MAT, 1, NULL, sunctx);
+  retval += TestBBDSparse(CSR_MAT, 1, NULL, sunctx);
+  retval += TestBBDSparse(CSC_MAT, 2, NULL, sunctx);
+  retval += TestBBDSparse(CSR_MAT, 2, ILU2, sunctx);
+  retval += TestBBDSparse(CSR_MAT, 0, ILU2, sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,197 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the combined error test and order selection reductions in
+ * IDA. The Robertson chemical kinetics DAE is integrated with a serial vector
+ * and with a serial vector that also provides the single buffer reduction
+ * operation N_VDotProdMultiAllReduce (a no-op for a serial vector), which
+ * enables the combined reductions. The runs are made with and without the
+ * algebraic variables excluded from the error test. The solutions and step
+ * counts of the two runs are compared and the second run must perform fewer
+ * reductions, as reported by IDAGetNumReductions.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "ida/ida.h"
+
+#define NEQ 3
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Residual function */
+static int res(realtype t, N_Vector y, N_Vector yp, N_Vector rr,
+               void *user_data)
+{
+  realtype *yd  = N_VGetArrayPointer(y);
+  realtype *ypd = N_VGetArrayPointer(yp);
+  realtype *rd  = N_VGetArrayPointer(rr);
+
+  rd[0] = -SUN_RCONST(0.04) * yd[0] + SUN_RCONST(1.0e4) * yd[1] * yd[2];
+  rd[1] = -rd[0] - SUN_RCONST(3.0e7) * yd[1] * yd[1] - ypd[1];
+  rd[0] -= ypd[0];
+  rd[2] = yd[0] + yd[1] + yd[2] - ONE;
+
+  return 0;
+}
+
+/* Local sums of a serial vector are already global */
+static int DotProdMultiAllReduce(int nvec, N_Vector x, realtype *sum)
+{
+  return 0;
+}
+
+/* Integrate to tout and return the solution and counters */
+static int Integrate(booleantype fuse, booleantype suppress, N_Vector y,
+                     long int *nst, long int *nreduce, SUNContext sunctx)
+{
+  int             retval;
+  realtype        t;
+  N_Vector        yp, id = NULL;
+  SUNMatrix       A  = NULL;
+  SUNLinearSolver LS = NULL;
+  void            *ida_mem;
+
+  y->ops->nvdotprodmultiallreduce = fuse ? DotProdMultiAllReduce : NULL;
+
+  yp = N_VClone(y);
+
+  NV_Ith_S(y, 0)  = ONE;
+  NV_Ith_S(y, 1)  = ZERO;
+  NV_Ith_S(y, 2)  = ZERO;
+  NV_Ith_S(yp, 0) = -SUN_RCONST(0.04);
+  NV_Ith_S(yp, 1) = SUN_RCONST(0.04);
+  NV_Ith_S(yp, 2) = ZERO;
+
+  ida_mem = IDACreate(sunctx);
+  retval = IDAInit(ida_mem, res, ZERO, y, yp);
+  if (retval) return retval;
+
+  retval = IDASStolerances(ida_mem, SUN_RCONST(1.0e-4), SUN_RCONST(1.0e-10));
+  if (retval) return retval;
+
+  if (suppress)
+  {
+    id = N_VClone(y);
+    NV_Ith_S(id, 0) = ONE;
+    NV_Ith_S(id, 1) = ONE;
+    NV_Ith_S(id, 2) = ZERO;
+    retval = IDASetId(ida_mem, id);
+    if (retval) return retval;
+    retval = IDASetSuppressAlg(ida_mem, SUNTRUE);
+    if (retval) return retval;
+  }
+
+  A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  retval = IDASetLinearSolver(ida_mem, LS, A);
+  if (retval) return retval;
+
+  retval = IDASetMaxNumSteps(ida_mem, 50000);
+  if (retval) return retval;
+
+  retval = IDASolve(ida_mem, SUN_RCONST(40.0), &t, y, yp, IDA_NORMAL);
+  if (retval < 0)
+  {
+    fprintf(stderr, "IDASolve returned %i\n", retval);
+    return retval;
+  }
+
+  IDAGetNumSteps(ida_mem, nst);
+  IDAGetNumReductions(ida_mem, nreduce);
+
+  IDAFree(&ida_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  N_VDestroy(yp);
+  if (id) N_VDestroy(id);
+
+  return 0;
+}
+
+static int TestReductions(booleantype suppress, SUNContext sunctx)
+{
+  int      retval;
+  long int nst_ref, nst_fused, nred_ref, nred_fused;
+  realtype err;
+  N_Vector y_ref, y_fused;
+
+  y_ref   = N_VNew_Serial(NEQ, sunctx);
+  y_fused = N_VNew_Serial(NEQ, sunctx);
+
+  retval = Integrate(SUNFALSE, suppress, y_ref, &nst_ref, &nred_ref, sunctx);
+  if (retval) return 1;
+
+  retval = Integrate(SUNTRUE, suppress, y_fused, &nst_fused, &nred_fused,
+                     sunctx);
+  if (retval) return 1;
+
+  N_VLinearSum(ONE, y_ref, -ONE, y_fused, y_ref);
+  err = N_VMaxNorm(y_ref);
+
+  printf("suppressalg = %i: steps %ld (reference %ld), "
+         "reductions %ld (reference %ld), max diff %g\n", (int) suppress,
+         nst_fused, nst_ref, nred_fused, nred_ref, (double) err);
+
+  N_VDestroy(y_ref);
+  N_VDestroy(y_fused);
+
+  if (nst_ref != nst_fused || err > SUN_RCONST(1.0e-10))
+  {
+    fprintf(stderr, "solutions with and without fused reductions differ\n");
+    return 1;
+  }
+
+  if (nred_fused >= nred_ref)
+  {
+    fprintf(stderr, "fused reductions did not reduce the reduction count\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestReductions(SUNFALSE, sunctx);
+  retval += TestReductions(SUNTRUE,  sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
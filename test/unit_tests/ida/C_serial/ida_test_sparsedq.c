@@ -0,0 +1,274 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the colored sparse difference quotient Jacobian enabled with
+ * IDASetJacSparsityPattern. The residual is a periodic nonlinear diffusion
+ * problem with a tridiagonal plus corner sparsity pattern,
+ *
+ *   F_i = y_i' + y_i^2 - y_{i-1} + 2 y_i - y_{i+1},
+ *
+ * for which three column colors suffice when N is divisible by three. The
+ * sparse DQ approximation of dF/dy + c_j dF/dy' is compared to the analytic
+ * Jacobian and to the dense DQ approximation in CSC and CSR format. The
+ * derivatives y' have both signs so that increments of both signs are used.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunmatrix/sunmatrix_sparse.h"
+#include "sundials/sundials_math.h"
+#include "ida/ida.h"
+#include "ida/ida_ls.h"
+#include "ida/ida_impl.h"
+#include "ida/ida_ls_impl.h"
+
+#define NEQ 18
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+#define CJ   SUN_RCONST(5.0)
+
+/* Residual function */
+static int res(realtype t, N_Vector y, N_Vector yp, N_Vector r,
+               void *user_data)
+{
+  realtype *yd  = N_VGetArrayPointer(y);
+  realtype *ypd = N_VGetArrayPointer(yp);
+  realtype *rd  = N_VGetArrayPointer(r);
+  int i;
+
+  for (i = 0; i < NEQ; i++)
+  {
+    rd[i] = ypd[i] + yd[i] * yd[i] - yd[(i + NEQ - 1) % NEQ] + TWO * yd[i]
+            - yd[(i + 1) % NEQ];
+  }
+
+  return 0;
+}
+
+/* Dummy direct linear solver, only needed to attach the sparse matrix */
+static SUNLinearSolver_Type LSGetType(SUNLinearSolver S)
+{
+  return SUNLINEARSOLVER_DIRECT;
+}
+
+static int LSSolve(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
+                   realtype tol)
+{
+  return SUNLS_SUCCESS;
+}
+
+/* Fill the periodic tridiagonal pattern with the analytic Jacobian (the matrix
+   is symmetric so the same loop works for CSC and CSR storage) */
+static void FillJacobian(SUNMatrix J, N_Vector y)
+{
+  realtype     *yd = N_VGetArrayPointer(y);
+  realtype     *data = SUNSparseMatrix_Data(J);
+  sunindextype *ptrs = SUNSparseMatrix_IndexPointers(J);
+  sunindextype *vals = SUNSparseMatrix_IndexValues(J);
+  sunindextype i, k, tmp, nnz = 0;
+  sunindextype idx[3];
+
+  for (i = 0; i < NEQ; i++)
+  {
+    /* sorted neighbors of i on the periodic grid */
+    idx[0] = (i + NEQ - 1) % NEQ;
+    idx[1] = i;
+    idx[2] = (i + 1) % NEQ;
+    if (idx[0] > idx[1]) { tmp = idx[0]; idx[0] = idx[1]; idx[1] = tmp; }
+    if (idx[1] > idx[2]) { tmp = idx[1]; idx[1] = idx[2]; idx[2] = tmp; }
+    if (idx[0] > idx[1]) { tmp = idx[0]; idx[0] = idx[1]; idx[1] = tmp; }
+
+    ptrs[i] = nnz;
+    for (k = 0; k < 3; k++)
+    {
+      vals[nnz] = idx[k];
+      data[nnz] = (idx[k] == i) ? TWO * yd[i] + TWO + CJ : -ONE;
+      nnz++;
+    }
+  }
+  ptrs[NEQ] = nnz;
+}
+
+static int TestSparseDQ(int sparsetype, SUNContext sunctx)
+{
+  int             retval;
+  int             passfail = 0;
+  sunindextype    i, j, p;
+  long int        nreLS;
+  realtype        tol, err, dense;
+  N_Vector        y, yp, r, tmp1, tmp2, tmp3;
+  SUNMatrix       A, D, P, Jref;
+  SUNLinearSolver LS;
+  IDAMem          IDA_mem;
+  void            *ida_mem;
+
+  y  = N_VNew_Serial(NEQ, sunctx);
+  yp = N_VClone(y);
+  r  = N_VClone(y);
+  tmp1 = N_VClone(y);
+  tmp2 = N_VClone(y);
+  tmp3 = N_VClone(y);
+  for (i = 0; i < NEQ; i++)
+  {
+    NV_Ith_S(y, i)  = ONE + SUN_RCONST(0.1) * i;
+    NV_Ith_S(yp, i) = (i % 2) ? -ONE : ONE;
+  }
+  res(ZERO, y, yp, r, NULL);
+
+  A    = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  P    = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  Jref = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  D    = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  FillJacobian(P, y);
+  FillJacobian(Jref, y);
+
+  LS = SUNLinSolNewEmpty(sunctx);
+  LS->ops->gettype = LSGetType;
+  LS->ops->solve   = LSSolve;
+
+  ida_mem = IDACreate(sunctx);
+  retval = IDAInit(ida_mem, res, ZERO, y, yp);
+  if (retval)
+  {
+    fprintf(stderr, "IDAInit returned %i\n", retval);
+    return 1;
+  }
+
+  retval = IDASetLinearSolver(ida_mem, LS, A);
+  if (retval)
+  {
+    fprintf(stderr, "IDASetLinearSolver returned %i\n", retval);
+    return 1;
+  }
+
+  retval = IDASetJacSparsityPattern(ida_mem, P);
+  if (retval)
+  {
+    fprintf(stderr, "IDASetJacSparsityPattern returned %i\n", retval);
+    return 1;
+  }
+
+  /* set error weights (the increments are at least 1/ewt), a step size and
+     c_j, and evaluate the sparse and dense DQ Jacobians */
+  IDA_mem = (IDAMem) ida_mem;
+  N_VConst(SUN_RCONST(1.0e8), IDA_mem->ida_ewt);
+  IDA_mem->ida_hh = SUN_RCONST(0.01);
+  IDA_mem->ida_cj = CJ;
+
+  retval = idaLsDQJac(ZERO, CJ, y, yp, r, A, ida_mem, tmp1, tmp2, tmp3);
+  if (retval)
+  {
+    fprintf(stderr, "idaLsDQJac returned %i\n", retval);
+    return 1;
+  }
+
+  IDAGetNumLinResEvals(ida_mem, &nreLS);
+
+  retval = idaLsDenseDQJac(ZERO, CJ, y, yp, r, D, IDA_mem, tmp1);
+  if (retval)
+  {
+    fprintf(stderr, "idaLsDenseDQJac returned %i\n", retval);
+    return 1;
+  }
+
+  /* compare with the analytic and the dense DQ Jacobian */
+  tol = SUN_RCONST(10.0) * SUNRsqrt(UNIT_ROUNDOFF) * (TWO + CJ);
+  for (i = 0; i < NEQ; i++)
+  {
+    for (p = SUNSparseMatrix_IndexPointers(A)[i];
+         p < SUNSparseMatrix_IndexPointers(A)[i + 1]; p++)
+    {
+      if (SUNSparseMatrix_IndexValues(A)[p] != SUNSparseMatrix_IndexValues(Jref)[p])
+      {
+        fprintf(stderr, "pattern mismatch at entry %ld\n", (long int) p);
+        passfail = 1;
+      }
+      err = SUNRabs(SUNSparseMatrix_Data(A)[p] - SUNSparseMatrix_Data(Jref)[p]);
+      if (err > tol)
+      {
+        fprintf(stderr, "entry %ld error %g > %g\n", (long int) p,
+                (double) err, (double) tol);
+        passfail = 1;
+      }
+
+      /* row and column of the entry in the dense matrix */
+      j = SUNSparseMatrix_IndexValues(A)[p];
+      dense = (sparsetype == CSC_MAT) ? SM_ELEMENT_D(D, j, i)
+                                      : SM_ELEMENT_D(D, i, j);
+      err = SUNRabs(SUNSparseMatrix_Data(A)[p] - dense);
+      if (err > tol)
+      {
+        fprintf(stderr, "entry %ld differs from the dense DQ by %g > %g\n",
+                (long int) p, (double) err, (double) tol);
+        passfail = 1;
+      }
+    }
+  }
+
+  /* one residual evaluation per color */
+  if (nreLS != 3)
+  {
+    fprintf(stderr, "expected 3 residual evaluations, got %ld\n", nreLS);
+    passfail = 1;
+  }
+
+  IDAFree(&ida_mem);
+  SUNLinSolFreeEmpty(LS);
+  SUNMatDestroy(A);
+  SUNMatDestroy(D);
+  SUNMatDestroy(P);
+  SUNMatDestroy(Jref);
+  N_VDestroy(y);
+  N_VDestroy(yp);
+  N_VDestroy(r);
+  N_VDestroy(tmp1);
+  N_VDestroy(tmp2);
+  N_VDestroy(tmp3);
+
+  return passfail;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestSparseDQ(CSC_MAT, sunctx);
+  retval += TestSparseDQ(CSR_MAT, sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
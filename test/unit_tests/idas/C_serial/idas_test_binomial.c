@@ -0,0 +1,267 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for binomial checkpointing enabled with IDAAdjSetCheckpointSlots.
+ * The adjoint of the Robertson chemical kinetics problem in implicit form (with
+ * a forward quadrature) is computed with all check points kept and with a limited number
+ * of check point slots, with and without a checkpoint store. The backward
+ * problem is integrated one step at a time to verify the number of check
+ * points never exceeds the number of slots. The adjoint solutions must agree
+ * to the last bit.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "idas/idas.h"
+#include "idas/idas_impl.h"
+
+#define NEQ    3
+#define NSTEPS 5
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Forward residual function */
+static int res(realtype t, N_Vector yy, N_Vector yp, N_Vector rr,
+               void *user_data)
+{
+  realtype *yd = N_VGetArrayPointer(yy);
+  realtype *pd = N_VGetArrayPointer(yp);
+  realtype *rd = N_VGetArrayPointer(rr);
+  realtype f0, f2;
+
+  f0 = -SUN_RCONST(0.04) * yd[0] + SUN_RCONST(1.0e4) * yd[1] * yd[2];
+  f2 = SUN_RCONST(3.0e7) * yd[1] * yd[1];
+
+  rd[0] = pd[0] - f0;
+  rd[1] = pd[1] + f0 + f2;
+  rd[2] = pd[2] - f2;
+
+  return 0;
+}
+
+/* Forward quadrature integrand */
+static int rhsQ(realtype t, N_Vector yy, N_Vector yp, N_Vector qdot,
+                void *user_data)
+{
+  NV_Ith_S(qdot, 0) = NV_Ith_S(yy, 2);
+  return 0;
+}
+
+/* Adjoint residual function, yB' + J^T yB + e_3 = 0 */
+static int resB(realtype t, N_Vector yy, N_Vector yp, N_Vector yB,
+                N_Vector ypB, N_Vector rrB, void *user_dataB)
+{
+  realtype *yd  = N_VGetArrayPointer(yy);
+  realtype *lb  = N_VGetArrayPointer(yB);
+  realtype *lbp = N_VGetArrayPointer(ypB);
+  realtype *rb  = N_VGetArrayPointer(rrB);
+  realtype p1 = SUN_RCONST(0.04), p2 = SUN_RCONST(1.0e4);
+  realtype p3 = SUN_RCONST(3.0e7);
+
+  rb[0] = lbp[0] - p1 * (lb[0] - lb[1]);
+  rb[1] = lbp[1] + p2 * yd[2] * (lb[0] - lb[1])
+          - SUN_RCONST(2.0) * p3 * yd[1] * (lb[1] - lb[2]);
+  rb[2] = lbp[2] + p2 * yd[1] * (lb[0] - lb[1]) + ONE;
+
+  return 0;
+}
+
+/* Solve the forward and adjoint problems and return the adjoint solution */
+static int SolveAdjoint(int nslots, booleantype usestore, N_Vector yB,
+                        SUNContext sunctx)
+{
+  int                retval, which, ncheck, maxckpnts = 0;
+  long int           nstR;
+  realtype           t, ratio;
+  N_Vector           yy, yp, q, ypB;
+  SUNMatrix          A, AB;
+  SUNLinearSolver    LS, LSB;
+  SUNCheckpointStore store = NULL;
+  void               *ida_mem;
+  IDAadjMem          IDAADJ_mem;
+
+  yy = N_VNew_Serial(NEQ, sunctx);
+  yp = N_VClone(yy);
+  q  = N_VNew_Serial(1, sunctx);
+  N_VConst(ZERO, yy);
+  N_VConst(ZERO, q);
+  NV_Ith_S(yy, 0) = ONE;
+  res(ZERO, yy, yy, yp, NULL);
+  N_VScale(-ONE, yp, yp);
+
+  ida_mem = IDACreate(sunctx);
+  if (IDAInit(ida_mem, res, ZERO, yy, yp)) return 1;
+  if (IDASStolerances(ida_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-10)))
+    return 1;
+  if (IDAQuadInit(ida_mem, rhsQ, q)) return 1;
+  if (IDASetQuadErrCon(ida_mem, SUNTRUE)) return 1;
+  if (IDAQuadSStolerances(ida_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-8)))
+    return 1;
+
+  A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LS = SUNLinSol_Dense(yy, A, sunctx);
+  if (IDASetLinearSolver(ida_mem, LS, A)) return 1;
+
+  if (IDAAdjInit(ida_mem, NSTEPS, IDA_HERMITE)) return 1;
+
+  retval = IDAAdjSetCheckpointSlots(ida_mem, nslots);
+  if (retval)
+  {
+    fprintf(stderr, "IDAAdjSetCheckpointSlots returned %i\n", retval);
+    return 1;
+  }
+
+  if (usestore)
+  {
+    store = SUNCheckpointStore_CompressedMemory(sunctx);
+    if (IDAAdjSetCheckpointStore(ida_mem, store)) return 1;
+  }
+
+  /* integrate in two calls to check the schedule carries over */
+  retval = IDASolveF(ida_mem, SUN_RCONST(4.0), &t, yy, yp, IDA_NORMAL, &ncheck);
+  if (retval < 0)
+  {
+    fprintf(stderr, "IDASolveF returned %i\n", retval);
+    return 1;
+  }
+  retval = IDASolveF(ida_mem, SUN_RCONST(40.0), &t, yy, yp, IDA_NORMAL, &ncheck);
+  if (retval < 0)
+  {
+    fprintf(stderr, "IDASolveF returned %i\n", retval);
+    return 1;
+  }
+
+  ypB = N_VClone(yB);
+  N_VConst(ZERO, yB);
+  N_VConst(ZERO, ypB);
+  NV_Ith_S(ypB, 2) = -ONE;
+
+  if (IDACreateB(ida_mem, &which)) return 1;
+  if (IDAInitB(ida_mem, which, resB, SUN_RCONST(40.0), yB, ypB)) return 1;
+  if (IDASStolerancesB(ida_mem, which, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-8)))
+    return 1;
+
+  AB  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LSB = SUNLinSol_Dense(yB, AB, sunctx);
+  if (IDASetLinearSolverB(ida_mem, which, LSB, AB)) return 1;
+
+  /* integrate the backward problem one step at a time to monitor the number
+     of check points */
+  IDAADJ_mem = ((IDAMem) ida_mem)->ida_adj_mem;
+  do
+  {
+    retval = IDASolveB(ida_mem, ZERO, IDA_ONE_STEP);
+    if (retval < 0)
+    {
+      fprintf(stderr, "IDASolveB returned %i\n", retval);
+      return 1;
+    }
+    if (IDAADJ_mem->ia_nckpnts + 1 > maxckpnts)
+      maxckpnts = IDAADJ_mem->ia_nckpnts + 1;
+    if (IDAGetB(ida_mem, which, &t, yB, ypB)) return 1;
+  } while (t > ZERO);
+
+  IDAGetAdjNumRecomputedSteps(ida_mem, &nstR);
+  IDAGetAdjRecomputationRatio(ida_mem, &ratio);
+
+  printf("nslots = %2i, store = %i: max %2i check points, %ld steps "
+         "recomputed, ratio %.2f, lambda = %g %g %g\n", nslots, (int) usestore,
+         maxckpnts, nstR, (double) ratio, (double) NV_Ith_S(yB, 0),
+         (double) NV_Ith_S(yB, 1), (double) NV_Ith_S(yB, 2));
+
+  retval = 0;
+  if (nslots > 0 && maxckpnts > nslots)
+  {
+    fprintf(stderr, "too many check points\n");
+    retval = 1;
+  }
+
+  IDAFree(&ida_mem);
+  if (store) SUNCheckpointStore_Destroy(store);
+  SUNLinSolFree(LS);
+  SUNLinSolFree(LSB);
+  SUNMatDestroy(A);
+  SUNMatDestroy(AB);
+  N_VDestroy(yy);
+  N_VDestroy(yp);
+  N_VDestroy(q);
+  N_VDestroy(ypB);
+
+  return retval;
+}
+
+static int TestBinomial(int nslots, booleantype usestore, N_Vector yB_ref,
+                        SUNContext sunctx)
+{
+  int      retval;
+  N_Vector yB;
+
+  yB = N_VClone(yB_ref);
+
+  retval = SolveAdjoint(nslots, usestore, yB, sunctx);
+
+  if (!retval && memcmp(N_VGetArrayPointer(yB), N_VGetArrayPointer(yB_ref),
+                        NEQ * sizeof(realtype)))
+  {
+    fprintf(stderr, "nslots = %i: adjoint solution differs\n", nslots);
+    retval = 1;
+  }
+
+  N_VDestroy(yB);
+
+  return retval;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  N_Vector   yB_ref;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  yB_ref = N_VNew_Serial(NEQ, sunctx);
+
+  retval += SolveAdjoint(0, SUNFALSE, yB_ref, sunctx);
+  retval += TestBinomial(2, SUNFALSE, yB_ref, sunctx);
+  retval += TestBinomial(3, SUNFALSE, yB_ref, sunctx);
+  retval += TestBinomial(5, SUNFALSE, yB_ref, sunctx);
+  retval += TestBinomial(10, SUNFALSE, yB_ref, sunctx);
+  retval += TestBinomial(10, SUNTRUE, yB_ref, sunctx);
+
+  N_VDestroy(yB_ref);
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,252 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the sparse local blocks of the BBD preconditioner enabled with
+ * KINBBDPrecInitSparse. The system function is a nonlinear diffusion operator
+ * made of two uncoupled chains of NEQ/2 components,
+ *
+ *   F_i = u_i^2 + u_{i-1} - 4 u_i + u_{i+1},
+ *
+ * so that the local block is tridiagonal and splitting it in two sub-blocks
+ * drops no entry. The preconditioner is set up and applied to a vector with
+ * the banded local block of KINBBDPrecInit and with the sparse local blocks, in CSC and CSR format, with one and two
+ * sub-blocks and with the default ILU(0) or a user supplied sub-block solver.
+ * Both are exact factorizations of the same difference quotient Jacobian, so
+ * the results must agree to rounding.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_sparse.h"
+#include "sunlinsol/sunlinsol_ilu.h"
+#include "sunlinsol/sunlinsol_spgmr.h"
+#include "sundials/sundials_math.h"
+#include "kinsol/kinsol.h"
+#include "kinsol/kinsol_bbdpre.h"
+#include "kinsol/kinsol_impl.h"
+#include "kinsol/kinsol_ls_impl.h"
+
+#define NEQ   18
+#define NHALF (NEQ / 2)
+
+#define ZERO  SUN_RCONST(0.0)
+#define ONE   SUN_RCONST(1.0)
+#define FOUR  SUN_RCONST(4.0)
+
+/* System and local function */
+static int g(sunindextype Nlocal, N_Vector u, N_Vector gu, void *user_data)
+{
+  realtype *ud = N_VGetArrayPointer(u);
+  realtype *gd = N_VGetArrayPointer(gu);
+  sunindextype i;
+
+  for (i = 0; i < NEQ; i++)
+  {
+    gd[i] = ud[i] * ud[i] - FOUR * ud[i];
+    if (i % NHALF > 0)         gd[i] += ud[i - 1];
+    if (i % NHALF < NHALF - 1) gd[i] += ud[i + 1];
+  }
+
+  return 0;
+}
+
+static int func(N_Vector u, N_Vector fu, void *user_data)
+{
+  return g(NEQ, u, fu, user_data);
+}
+
+/* Sub-block solver keeping some fill, to test a user supplied solver */
+static SUNLinearSolver ILU2(N_Vector y, SUNMatrix A, SUNContext sunctx)
+{
+  return SUNLinSol_ILU(y, A, 2, sunctx);
+}
+
+/* Set up the attached preconditioner and solve P z = r in place, returning
+   the number of local function evaluations of the setup */
+static int PrecSetupSolve(void *kinmem, N_Vector u, N_Vector fu,
+                          N_Vector scale, N_Vector z, long int *nge)
+{
+  KINMem   kin_mem = (KINMem) kinmem;
+  KINLsMem kinls_mem = (KINLsMem) kin_mem->kin_lmem;
+  long int nge0, nge1;
+  int      retval;
+
+  KINBBDPrecGetNumGfnEvals(kinmem, &nge0);
+
+  retval = kinls_mem->pset(u, scale, fu, scale, kinls_mem->pdata);
+  if (retval)
+  {
+    fprintf(stderr, "preconditioner setup returned %i\n", retval);
+    return 1;
+  }
+
+  retval = kinls_mem->psolve(u, scale, fu, scale, z, kinls_mem->pdata);
+  if (retval)
+  {
+    fprintf(stderr, "preconditioner solve returned %i\n", retval);
+    return 1;
+  }
+
+  KINBBDPrecGetNumGfnEvals(kinmem, &nge1);
+  *nge = nge1 - nge0;
+
+  return 0;
+}
+
+static int TestBBDSparse(int sparsetype, int nsub, KINBBDLinSolFn lsfn,
+                         SUNContext sunctx)
+{
+  int             retval;
+  int             passfail = 0;
+  long int        nge_band, nge_sparse;
+  realtype        tol, err;
+  sunindextype    i, k, nnz;
+  sunindextype    *ptrs, *vals;
+  N_Vector        u, fu, scale, zband, zsparse;
+  SUNMatrix       P;
+  SUNLinearSolver LS;
+  void            *kinmem;
+
+  u       = N_VNew_Serial(NEQ, sunctx);
+  fu      = N_VClone(u);
+  scale   = N_VClone(u);
+  zband   = N_VClone(u);
+  zsparse = N_VClone(u);
+  for (i = 0; i < NEQ; i++)
+  {
+    NV_Ith_S(u, i)     = ((i % 2) ? -ONE : ONE) * SUN_RCONST(0.02) * (i + 1);
+    NV_Ith_S(zband, i) = (i % 3) ? -ONE : ONE;
+  }
+  N_VScale(ONE, zband, zsparse);
+  N_VConst(ONE, scale);
+  func(u, fu, NULL);
+
+  /* tridiagonal pattern without the couplings between the two chains (the
+     pattern is symmetric so the same loop works for CSC and CSR storage) */
+  P    = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  ptrs = SUNSparseMatrix_IndexPointers(P);
+  vals = SUNSparseMatrix_IndexValues(P);
+  nnz  = 0;
+  for (i = 0; i < NEQ; i++)
+  {
+    ptrs[i] = nnz;
+    for (k = i - 1; k <= i + 1; k++)
+    {
+      if ((k < 0) || (k >= NEQ) || (k / NHALF != i / NHALF)) continue;
+      vals[nnz++] = k;
+    }
+  }
+  ptrs[NEQ] = nnz;
+
+  LS = SUNLinSol_SPGMR(u, SUN_PREC_RIGHT, 0, sunctx);
+
+  kinmem = KINCreate(sunctx);
+  retval = KINInit(kinmem, func, u);
+  if (retval)
+  {
+    fprintf(stderr, "KINInit returned %i\n", retval);
+    return 1;
+  }
+
+  retval = KINSetLinearSolver(kinmem, LS, NULL);
+  if (retval)
+  {
+    fprintf(stderr, "KINSetLinearSolver returned %i\n", retval);
+    return 1;
+  }
+
+  retval = KINBBDPrecInit(kinmem, NEQ, 1, 1, 1, 1, ZERO, g, NULL);
+  if (retval)
+  {
+    fprintf(stderr, "KINBBDPrecInit returned %i\n", retval);
+    return 1;
+  }
+
+  /* apply the banded and then the sparse preconditioner at the same point */
+  if (PrecSetupSolve(kinmem, u, fu, scale, zband, &nge_band)) return 1;
+
+  retval = KINBBDPrecInitSparse(kinmem, NEQ, P, nsub, lsfn, ZERO, g, NULL);
+  if (retval)
+  {
+    fprintf(stderr, "KINBBDPrecInitSparse returned %i\n", retval);
+    return 1;
+  }
+
+  if (PrecSetupSolve(kinmem, u, fu, scale, zsparse, &nge_sparse)) return 1;
+
+  /* compare the preconditioned vectors */
+  tol = SUN_RCONST(1.0e3) * UNIT_ROUNDOFF * N_VMaxNorm(zband);
+  N_VLinearSum(ONE, zsparse, -ONE, zband, zsparse);
+  err = N_VMaxNorm(zsparse);
+  if (err > tol)
+  {
+    fprintf(stderr, "%s, %i sub-blocks: difference %g > %g\n",
+            (sparsetype == CSC_MAT) ? "CSC" : "CSR", nsub, (double) err,
+            (double) tol);
+    passfail = 1;
+  }
+
+  /* three colors plus the base evaluation, as with the banded quotient */
+  if ((nge_sparse != 4) || (nge_band != 4))
+  {
+    fprintf(stderr, "expected 4 local function evaluations, got %ld (sparse) "
+            "and %ld (banded)\n", nge_sparse, nge_band);
+    passfail = 1;
+  }
+
+  KINFree(&kinmem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(P);
+  N_VDestroy(u);
+  N_VDestroy(fu);
+  N_VDestroy(scale);
+  N_VDestroy(zband);
+  N_VDestroy(zsparse);
+
+  return passfail;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestBBDSparse(CSC_MAT, 1, NULL, sunctx);
+  retval += TestBBDSparse(CSR_MAT, 1, NULL, sunctx);
+  retval += TestBBDSparse(CSC_MAT, 2, NULL, sunctx);
+  retval += TestBBDSparse(CSR_MAT, 2, ILU2, sunctx);
+  retval += TestBBDSparse(CSR_MAT, 0, ILU2, sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
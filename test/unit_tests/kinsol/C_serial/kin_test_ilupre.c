@@ -0,0 +1,313 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the ILU(k) preconditioner module enabled with KINILUPrecInit.
+ * The system is a steady 2D reaction-diffusion problem on the unit square with
+ * homogeneous Dirichlet boundary conditions,
+ *
+ *   F(u) = u_xx + u_yy - u^3 + 1 = 0,
+ *
+ * discretized with the 5-point stencil on an MX x MY interior grid. The
+ * problem is solved with Newton and SPGMR preconditioned by ILU(0) and ILU(1)
+ * of the Jacobian J, in CSC and CSR format. The solution is compared to a
+ * tightly converged dense direct solve, and the preconditioned runs must need
+ * fewer linear iterations than an unpreconditioned run.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunmatrix/sunmatrix_sparse.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunlinsol/sunlinsol_spgmr.h"
+#include "sundials/sundials_math.h"
+#include "kinsol/kinsol.h"
+#include "kinsol/kinsol_ls.h"
+#include "kinsol/kinsol_ilupre.h"
+
+#define MX   15
+#define MY   15
+#define NEQ  (MX * MY)
+
+#define ZERO  SUN_RCONST(0.0)
+#define ONE   SUN_RCONST(1.0)
+#define THREE SUN_RCONST(3.0)
+
+/* Linear solver options */
+#define DIRECT  0
+#define NOPREC  1
+#define ILUPREC 2
+
+/* Inverse squared mesh spacing */
+#define DX2 ((realtype) ((MX + 1) * (MX + 1)))
+#define DY2 ((realtype) ((MY + 1) * (MY + 1)))
+
+#define IDX(i, j) ((i) + (j) * MX)
+
+/* System function */
+static int func(N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype *yd = N_VGetArrayPointer(y);
+  realtype *fd = N_VGetArrayPointer(ydot);
+  realtype uw, ue, us, un, uc;
+  int i, j;
+
+  for (j = 0; j < MY; j++)
+  {
+    for (i = 0; i < MX; i++)
+    {
+      uc = yd[IDX(i, j)];
+      uw = (i > 0)      ? yd[IDX(i - 1, j)] : ZERO;
+      ue = (i < MX - 1) ? yd[IDX(i + 1, j)] : ZERO;
+      us = (j > 0)      ? yd[IDX(i, j - 1)] : ZERO;
+      un = (j < MY - 1) ? yd[IDX(i, j + 1)] : ZERO;
+
+      fd[IDX(i, j)] = DX2 * (uw - 2 * uc + ue) + DY2 * (us - 2 * uc + un)
+                      - uc * uc * uc + ONE;
+    }
+  }
+
+  return 0;
+}
+
+/* Sparse Jacobian function (the matrix is symmetric so the same loop works
+   for CSC and CSR storage) */
+static int jac(N_Vector y, N_Vector fy, SUNMatrix J, void *user_data,
+               N_Vector tmp1, N_Vector tmp2)
+{
+  realtype     *yd   = N_VGetArrayPointer(y);
+  realtype     *data = SUNSparseMatrix_Data(J);
+  sunindextype *ptrs = SUNSparseMatrix_IndexPointers(J);
+  sunindextype *vals = SUNSparseMatrix_IndexValues(J);
+  sunindextype nnz   = 0;
+  realtype     uc;
+  int          i, j;
+
+  for (j = 0; j < MY; j++)
+  {
+    for (i = 0; i < MX; i++)
+    {
+      uc = yd[IDX(i, j)];
+
+      ptrs[IDX(i, j)] = nnz;
+      if (j > 0)
+      {
+        vals[nnz] = IDX(i, j - 1); data[nnz++] = DY2;
+      }
+      if (i > 0)
+      {
+        vals[nnz] = IDX(i - 1, j); data[nnz++] = DX2;
+      }
+      vals[nnz] = IDX(i, j); data[nnz++] = -2 * (DX2 + DY2) - THREE * uc * uc;
+      if (i < MX - 1)
+      {
+        vals[nnz] = IDX(i + 1, j); data[nnz++] = DX2;
+      }
+      if (j < MY - 1)
+      {
+        vals[nnz] = IDX(i, j + 1); data[nnz++] = DY2;
+      }
+    }
+  }
+  ptrs[NEQ] = nnz;
+
+  return 0;
+}
+
+/* Solve the system with the given linear solver and get the number of linear
+   iterations */
+static int Solve(int solver, int sparsetype, int fill_level, N_Vector y,
+                 long int *nli, SUNContext sunctx)
+{
+  int             retval;
+  int             passfail = 0;
+  long int        njeIP, nfactIP;
+  realtype        fnormtol;
+  N_Vector        scale;
+  sunindextype    i, j;
+  SUNMatrix       A = NULL;
+  SUNLinearSolver LS;
+  void            *kinmem;
+
+  /* initial guess */
+  for (j = 0; j < MY; j++)
+  {
+    for (i = 0; i < MX; i++)
+    {
+      NV_Ith_S(y, IDX(i, j)) = SUN_RCONST(16.0) * (i + 1) * (MX - i) / DX2
+                               * (j + 1) * (MY - j) / DY2;
+    }
+  }
+
+  scale = N_VClone(y);
+  N_VConst(ONE, scale);
+
+  if (solver == DIRECT)
+  {
+    fnormtol = SUN_RCONST(1.0e-10);
+    A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+    LS = SUNLinSol_Dense(y, A, sunctx);
+  }
+  else
+  {
+    fnormtol = SUN_RCONST(1.0e-8);
+    LS = SUNLinSol_SPGMR(y, (solver == ILUPREC) ? SUN_PREC_RIGHT : SUN_PREC_NONE,
+                         0, sunctx);
+  }
+
+  kinmem = KINCreate(sunctx);
+  retval = KINInit(kinmem, func, y);
+  if (retval)
+  {
+    fprintf(stderr, "KINInit returned %i\n", retval);
+    return 1;
+  }
+
+  retval = KINSetFuncNormTol(kinmem, fnormtol);
+  if (retval)
+  {
+    fprintf(stderr, "KINSetFuncNormTol returned %i\n", retval);
+    return 1;
+  }
+
+  retval = KINSetLinearSolver(kinmem, LS, A);
+  if (retval)
+  {
+    fprintf(stderr, "KINSetLinearSolver returned %i\n", retval);
+    return 1;
+  }
+
+  if (solver == ILUPREC)
+  {
+    /* the template only provides the size and storage format */
+    A = SUNSparseMatrix(NEQ, NEQ, 5 * NEQ, sparsetype, sunctx);
+    retval = KINILUPrecInit(kinmem, A, jac, fill_level);
+    if (retval)
+    {
+      fprintf(stderr, "KINILUPrecInit returned %i\n", retval);
+      return 1;
+    }
+  }
+
+  retval = KINSol(kinmem, y, KIN_LINESEARCH, scale, scale);
+  if (retval < 0)
+  {
+    fprintf(stderr, "KINSol returned %i\n", retval);
+    return 1;
+  }
+
+  KINGetNumLinIters(kinmem, nli);
+
+  if (solver == ILUPREC)
+  {
+    KINILUPrecGetNumJacEvals(kinmem, &njeIP);
+    KINILUPrecGetNumFactorizations(kinmem, &nfactIP);
+
+    if ((njeIP < 1) || (nfactIP < njeIP))
+    {
+      fprintf(stderr, "ILU(%i): %ld Jacobian evaluations, %ld factorizations\n",
+              fill_level, njeIP, nfactIP);
+      passfail = 1;
+    }
+  }
+
+  KINFree(&kinmem);
+  SUNLinSolFree(LS);
+  if (A) SUNMatDestroy(A);
+  N_VDestroy(scale);
+
+  return passfail;
+}
+
+static int TestILUPre(int sparsetype, int fill_level, N_Vector yref,
+                      long int nli_noprec, SUNContext sunctx)
+{
+  int      passfail = 0;
+  long int nli;
+  realtype err, tol;
+  N_Vector y;
+
+  y = N_VClone(yref);
+
+  if (Solve(ILUPREC, sparsetype, fill_level, y, &nli, sunctx)) passfail = 1;
+
+  /* compare with the reference solution */
+  tol = SUN_RCONST(1.0e-5);
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  err = N_VMaxNorm(y);
+  if (err > tol)
+  {
+    fprintf(stderr, "ILU(%i) %s: error %g > %g\n", fill_level,
+            (sparsetype == CSC_MAT) ? "CSC" : "CSR", (double) err,
+            (double) tol);
+    passfail = 1;
+  }
+
+  /* the preconditioner must reduce the number of linear iterations */
+  if (nli >= nli_noprec)
+  {
+    fprintf(stderr, "ILU(%i) %s: %ld linear iterations >= %ld without "
+            "preconditioning\n", fill_level,
+            (sparsetype == CSC_MAT) ? "CSC" : "CSR", nli, nli_noprec);
+    passfail = 1;
+  }
+
+  N_VDestroy(y);
+
+  return passfail;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  long int   nli, nli_noprec;
+  N_Vector   yref, y;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  yref = N_VNew_Serial(NEQ, sunctx);
+  y    = N_VClone(yref);
+
+  /* reference solution and unpreconditioned linear iteration count */
+  retval += Solve(DIRECT, 0, 0, yref, &nli, sunctx);
+  retval += Solve(NOPREC, 0, 0, y, &nli_noprec, sunctx);
+
+  retval += TestILUPre(CSC_MAT, 0, yref, nli_noprec, sunctx);
+  retval += TestILUPre(CSR_MAT, 0, yref, nli_noprec, sunctx);
+  retval += TestILUPre(CSC_MAT, 1, yref, nli_noprec, sunctx);
+  retval += TestILUPre(CSR_MAT, 1, yref, nli_noprec, sunctx);
+
+  N_VDestroy(yref);
+  N_VDestroy(y);
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,268 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the colored sparse difference quotient Jacobian enabled with
+ * KINSetJacSparsityPattern. The system function is a periodic nonlinear
+ * diffusion operator with a tridiagonal plus corner sparsity pattern,
+ *
+ *   F_i = u_i^2 + u_{i-1} - 2 u_i + u_{i+1},
+ *
+ * for which three column colors suffice when N is divisible by three. The
+ * sparse DQ Jacobian is compared to the analytic Jacobian and to the dense DQ
+ * Jacobian in CSC and CSR format. The components of u have both signs so that
+ * increments of both signs are used.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvector/nvector_serial.h"
+#include "sunmatrix/sunmatrix_dense.h"
+#include "sunmatrix/sunmatrix_sparse.h"
+#include "sundials/sundials_math.h"
+#include "kinsol/kinsol.h"
+#include "kinsol/kinsol_ls.h"
+#include "kinsol/kinsol_impl.h"
+#include "kinsol/kinsol_ls_impl.h"
+
+#define NEQ 18
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+/* System function */
+static int func(N_Vector u, N_Vector fu, void *user_data)
+{
+  realtype *ud = N_VGetArrayPointer(u);
+  realtype *fd = N_VGetArrayPointer(fu);
+  int i;
+
+  for (i = 0; i < NEQ; i++)
+  {
+    fd[i] = ud[i] * ud[i] + ud[(i + NEQ - 1) % NEQ] - TWO * ud[i]
+            + ud[(i + 1) % NEQ];
+  }
+
+  return 0;
+}
+
+/* Dummy direct linear solver, only needed to attach the sparse matrix */
+static SUNLinearSolver_Type LSGetType(SUNLinearSolver S)
+{
+  return SUNLINEARSOLVER_DIRECT;
+}
+
+static int LSSolve(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
+                   realtype tol)
+{
+  return SUNLS_SUCCESS;
+}
+
+/* Fill the periodic tridiagonal pattern with the analytic Jacobian (the matrix
+   is symmetric so the same loop works for CSC and CSR storage) */
+static void FillJacobian(SUNMatrix J, N_Vector u)
+{
+  realtype     *ud = N_VGetArrayPointer(u);
+  realtype     *data = SUNSparseMatrix_Data(J);
+  sunindextype *ptrs = SUNSparseMatrix_IndexPointers(J);
+  sunindextype *vals = SUNSparseMatrix_IndexValues(J);
+  sunindextype i, k, tmp, nnz = 0;
+  sunindextype idx[3];
+
+  for (i = 0; i < NEQ; i++)
+  {
+    /* sorted neighbors of i on the periodic grid */
+    idx[0] = (i + NEQ - 1) % NEQ;
+    idx[1] = i;
+    idx[2] = (i + 1) % NEQ;
+    if (idx[0] > idx[1]) { tmp = idx[0]; idx[0] = idx[1]; idx[1] = tmp; }
+    if (idx[1] > idx[2]) { tmp = idx[1]; idx[1] = idx[2]; idx[2] = tmp; }
+    if (idx[0] > idx[1]) { tmp = idx[0]; idx[0] = idx[1]; idx[1] = tmp; }
+
+    ptrs[i] = nnz;
+    for (k = 0; k < 3; k++)
+    {
+      vals[nnz] = idx[k];
+      data[nnz] = (idx[k] == i) ? TWO * ud[i] - TWO : ONE;
+      nnz++;
+    }
+  }
+  ptrs[NEQ] = nnz;
+}
+
+static int TestSparseDQ(int sparsetype, SUNContext sunctx)
+{
+  int             retval;
+  int             passfail = 0;
+  sunindextype    i, j, p;
+  long int        nfeLS;
+  realtype        tol, err, dense;
+  N_Vector        u, fu, scale, tmp1, tmp2;
+  SUNMatrix       A, D, P, Jref;
+  SUNLinearSolver LS;
+  KINMem          kin_mem;
+  void            *kinmem;
+
+  u     = N_VNew_Serial(NEQ, sunctx);
+  fu    = N_VClone(u);
+  scale = N_VClone(u);
+  tmp1  = N_VClone(u);
+  tmp2  = N_VClone(u);
+  for (i = 0; i < NEQ; i++)
+  {
+    NV_Ith_S(u, i) = ((i % 2) ? -ONE : ONE) * (ONE + SUN_RCONST(0.1) * i);
+  }
+  N_VConst(ONE, scale);
+  func(u, fu, NULL);
+
+  A    = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  P    = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  Jref = SUNSparseMatrix(NEQ, NEQ, 3 * NEQ, sparsetype, sunctx);
+  D    = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  FillJacobian(P, u);
+  FillJacobian(Jref, u);
+
+  LS = SUNLinSolNewEmpty(sunctx);
+  LS->ops->gettype = LSGetType;
+  LS->ops->solve   = LSSolve;
+
+  kinmem = KINCreate(sunctx);
+  retval = KINInit(kinmem, func, u);
+  if (retval)
+  {
+    fprintf(stderr, "KINInit returned %i\n", retval);
+    return 1;
+  }
+
+  retval = KINSetLinearSolver(kinmem, LS, A);
+  if (retval)
+  {
+    fprintf(stderr, "KINSetLinearSolver returned %i\n", retval);
+    return 1;
+  }
+
+  retval = KINSetJacSparsityPattern(kinmem, P);
+  if (retval)
+  {
+    fprintf(stderr, "KINSetJacSparsityPattern returned %i\n", retval);
+    return 1;
+  }
+
+  /* set unit scaling (normally attached by KINSol) and evaluate the sparse
+     and dense DQ Jacobians */
+  kin_mem = (KINMem) kinmem;
+  kin_mem->kin_uscale = scale;
+
+  retval = kinLsDQJac(u, fu, A, kinmem, tmp1, tmp2);
+  if (retval)
+  {
+    fprintf(stderr, "kinLsDQJac returned %i\n", retval);
+    return 1;
+  }
+
+  KINGetNumLinFuncEvals(kinmem, &nfeLS);
+
+  retval = kinLsDenseDQJac(u, fu, D, kin_mem, tmp1, tmp2);
+  if (retval)
+  {
+    fprintf(stderr, "kinLsDenseDQJac returned %i\n", retval);
+    return 1;
+  }
+
+  /* compare with the analytic and the dense DQ Jacobian */
+  tol = SUN_RCONST(10.0) * SUNRsqrt(UNIT_ROUNDOFF) * SUN_RCONST(8.0);
+  for (i = 0; i < NEQ; i++)
+  {
+    for (p = SUNSparseMatrix_IndexPointers(A)[i];
+         p < SUNSparseMatrix_IndexPointers(A)[i + 1]; p++)
+    {
+      if (SUNSparseMatrix_IndexValues(A)[p] != SUNSparseMatrix_IndexValues(Jref)[p])
+      {
+        fprintf(stderr, "pattern mismatch at entry %ld\n", (long int) p);
+        passfail = 1;
+      }
+      err = SUNRabs(SUNSparseMatrix_Data(A)[p] - SUNSparseMatrix_Data(Jref)[p]);
+      if (err > tol)
+      {
+        fprintf(stderr, "entry %ld error %g > %g\n", (long int) p,
+                (double) err, (double) tol);
+        passfail = 1;
+      }
+
+      /* row and column of the entry in the dense matrix */
+      j = SUNSparseMatrix_IndexValues(A)[p];
+      dense = (sparsetype == CSC_MAT) ? SM_ELEMENT_D(D, j, i)
+                                      : SM_ELEMENT_D(D, i, j);
+      err = SUNRabs(SUNSparseMatrix_Data(A)[p] - dense);
+      if (err > tol)
+      {
+        fprintf(stderr, "entry %ld differs from the dense DQ by %g > %g\n",
+                (long int) p, (double) err, (double) tol);
+        passfail = 1;
+      }
+    }
+  }
+
+  /* one function evaluation per color */
+  if (nfeLS != 3)
+  {
+    fprintf(stderr, "expected 3 function evaluations, got %ld\n", nfeLS);
+    passfail = 1;
+  }
+
+  kin_mem->kin_uscale = NULL;
+  KINFree(&kinmem);
+  SUNLinSolFreeEmpty(LS);
+  SUNMatDestroy(A);
+  SUNMatDestroy(D);
+  SUNMatDestroy(P);
+  SUNMatDestroy(Jref);
+  N_VDestroy(u);
+  N_VDestroy(fu);
+  N_VDestroy(scale);
+  N_VDestroy(tmp1);
+  N_VDestroy(tmp2);
+
+  return passfail;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  int        retval = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  retval += TestSparseDQ(CSC_MAT, sunctx);
+  retval += TestSparseDQ(CSR_MAT, sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (retval)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,207 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the SUNDIALS profiler. Nested regions are timed using names
+ * and timer ids, including names stored in a reused buffer, and the call tree
+ * (CSV) and Chrome trace (JSON) exports are checked, with hardware counters
+ * enabled if the machine supports them.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sundials/sundials_profiler.h"
+
+#define NOUTER 10
+#define NINNER 5
+
+/* Do some work so the timed regions are not empty */
+static double Work(int n)
+{
+  int i;
+  volatile double sum = 0.0;
+  for (i = 0; i < n; i++) sum += 1.0 / (double) (i + 1);
+  return sum;
+}
+
+/* Count the lines of a file containing str */
+static int CountLines(FILE* fp, const char* str)
+{
+  int count = 0;
+  char line[1024];
+
+  rewind(fp);
+  while (fgets(line, sizeof(line), fp))
+    if (strstr(line, str)) count++;
+
+  return count;
+}
+
+/* Read the count column of the CSV row with the given path */
+static long GetCount(FILE* fp, const char* path)
+{
+  long count = -1;
+  char line[1024];
+  char* c;
+
+  rewind(fp);
+  while (fgets(line, sizeof(line), fp))
+  {
+    if (strstr(line, path) && (c = strstr(line, "\",")))
+    {
+      count = atol(c + 2);
+      break;
+    }
+  }
+
+  return count;
+}
+
+static int TestProfiler(void)
+{
+  int i, j, id, retval = 0;
+  long count;
+  char name[32];
+  FILE* fp;
+  SUNProfiler prof = NULL;
+
+  if (SUNProfiler_Create(NULL, "test_profiler", &prof))
+  {
+    fprintf(stderr, "SUNProfiler_Create failed\n");
+    return 1;
+  }
+
+  if (SUNProfiler_EnableTrace(prof, 1000))
+  {
+    fprintf(stderr, "SUNProfiler_EnableTrace failed\n");
+    return 1;
+  }
+
+  /* hardware counters are optional, the results must not depend on them */
+  if (SUNProfiler_EnableCounters(prof, 1) == 0)
+    printf("hardware counters enabled\n");
+  else
+    printf("hardware counters are not available\n");
+
+  if (SUNProfiler_GetTimerId(prof, "inner", &id))
+  {
+    fprintf(stderr, "SUNProfiler_GetTimerId failed\n");
+    return 1;
+  }
+
+  for (i = 0; i < NOUTER; i++)
+  {
+    SUNProfiler_Begin(prof, "outer");
+    for (j = 0; j < NINNER; j++)
+    {
+      SUNProfiler_BeginId(prof, id);
+      Work(1000);
+      SUNProfiler_EndId(prof, id);
+    }
+
+    /* the same buffer holds a different name on each iteration */
+    sprintf(name, "region %d", i % 2);
+    SUNProfiler_Begin(prof, name);
+    Work(1000);
+    SUNProfiler_End(prof, name);
+
+    SUNProfiler_End(prof, "outer");
+  }
+
+  /* "inner" outside of "outer" is a different node of the call tree */
+  SUNProfiler_BeginId(prof, id);
+  Work(1000);
+  SUNProfiler_EndId(prof, id);
+
+  /* ending a region that is not open is an error */
+  if (SUNProfiler_End(prof, "outer") == 0)
+  {
+    fprintf(stderr, "ending a closed region did not fail\n");
+    retval = 1;
+  }
+
+  SUNProfiler_Print(prof, stdout);
+
+  /* check the call tree */
+  fp = tmpfile();
+  SUNProfiler_ExportCSV(prof, fp);
+
+  count = GetCount(fp, "\"From profiler epoch/outer\"");
+  if (count != NOUTER)
+  {
+    fprintf(stderr, "outer count %ld != %d\n", count, NOUTER);
+    retval = 1;
+  }
+  count = GetCount(fp, "\"From profiler epoch/outer/inner\"");
+  if (count != NOUTER * NINNER)
+  {
+    fprintf(stderr, "outer/inner count %ld != %d\n", count, NOUTER * NINNER);
+    retval = 1;
+  }
+  count = GetCount(fp, "\"From profiler epoch/inner\"");
+  if (count != 1)
+  {
+    fprintf(stderr, "inner count %ld != 1\n", count);
+    retval = 1;
+  }
+  count = GetCount(fp, "\"From profiler epoch/outer/region 1\"");
+  if (count != NOUTER / 2)
+  {
+    fprintf(stderr, "region 1 count %ld != %d\n", count, NOUTER / 2);
+    retval = 1;
+  }
+  fclose(fp);
+
+  /* check the trace, the root region is still open */
+  fp = tmpfile();
+  SUNProfiler_ExportTrace(prof, fp);
+  i = CountLines(fp, "\"ph\":\"X\"");
+  if (i != NOUTER * (NINNER + 2) + 2)
+  {
+    fprintf(stderr, "trace has %d events, expected %d\n", i,
+            NOUTER * (NINNER + 2) + 2);
+    retval = 1;
+  }
+  fclose(fp);
+
+  /* after a reset only the open root region remains */
+  SUNProfiler_Reset(prof);
+  fp = tmpfile();
+  SUNProfiler_ExportCSV(prof, fp);
+  if (GetCount(fp, "\"From profiler epoch/outer\"") != 0 ||
+      GetCount(fp, "\"From profiler epoch\"") != 1)
+  {
+    fprintf(stderr, "profiler reset failed\n");
+    retval = 1;
+  }
+  fclose(fp);
+
+  SUNProfiler_Free(&prof);
+
+  return retval;
+}
+
+/* Main program */
+int main(int argc, char *argv[])
+{
+  if (TestProfiler())
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
+
+/*---- end of file ----*/
@@ -0,0 +1,172 @@
+/*------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2023, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *-----------------------------------------------------------------*/
+
+#include <cstdint>
+#include <iostream>
+#include <nvector/nvector_serial.h>
+#include <sundials/sundials_memory.h>
+#include <sundials/sundials_types.h>
+#include <sunmemory/sunmemory_pool.h>
+
+int test_reuse(SUNMemoryHelper helper)
+{
+  unsigned long num_allocations, num_deallocations, num_reuses;
+  size_t bytes_allocated, bytes_high_watermark, bytes_cached;
+  SUNMemory mem1 = nullptr;
+  SUNMemory mem2 = nullptr;
+
+  std::cout << "  Reuse... \n";
+
+  if (SUNMemoryHelper_Alloc(helper, &mem1, 1000, SUNMEMTYPE_HOST, nullptr))
+  {
+    std::cout << "  Reuse... FAILED\n";
+    return -1;
+  }
+
+  if (reinterpret_cast<std::uintptr_t>(mem1->ptr) % SUNMEMORY_POOL_ALIGNMENT)
+  {
+    std::cout << "  Reuse... FAILED\n";
+    std::cout << "    block is not aligned\n";
+    return -1;
+  }
+
+  // Write to the whole block and return it to the pool
+  void* ptr = mem1->ptr;
+  for (int i = 0; i < 1000; i++) { static_cast<char*>(ptr)[i] = 1; }
+  SUNMemoryHelper_Dealloc(helper, mem1, nullptr);
+
+  // A request in the same size class gets the same block back
+  SUNMemoryHelper_Alloc(helper, &mem2, 990, SUNMEMTYPE_HOST, nullptr);
+  if (mem2->ptr != ptr)
+  {
+    std::cout << "  Reuse... FAILED\n";
+    std::cout << "    cached block was not reused\n";
+    return -1;
+  }
+
+  SUNMemoryHelper_GetPoolStats_Pool(helper, &num_reuses, &bytes_cached);
+  if (num_reuses != 1 || bytes_cached != 0)
+  {
+    std::cout << "  Reuse... FAILED\n";
+    std::cout << "    num_reuses = " << num_reuses
+              << " bytes_cached = " << bytes_cached << "\n";
+    return -1;
+  }
+
+  // 1000 bytes is in the (768, 1024] class
+  SUNMemoryHelper_GetAllocStats(helper, SUNMEMTYPE_HOST, &num_allocations,
+                                &num_deallocations, &bytes_allocated,
+                                &bytes_high_watermark);
+  if (num_allocations != 2 || num_deallocations != 1 ||
+      bytes_allocated != 1024 || bytes_high_watermark != 1024)
+  {
+    std::cout << "  Reuse... FAILED\n";
+    std::cout << "\tnum_allocations = " << num_allocations
+              << " num_deallocations = " << num_deallocations
+              << " bytes_allocated = " << bytes_allocated
+              << " bytes_high_watermark = " << bytes_high_watermark << "\n";
+    return -1;
+  }
+
+  SUNMemoryHelper_Dealloc(helper, mem2, nullptr);
+
+  // Blocks are not cached past the limit, 100 bytes is in the (96, 112] class
+  SUNMemoryHelper_SetMaxCached_Pool(helper, 512);
+  SUNMemoryHelper_GetPoolStats_Pool(helper, &num_reuses, &bytes_cached);
+  if (bytes_cached != 0)
+  {
+    std::cout << "  Reuse... FAILED\n";
+    std::cout << "    cache was not released\n";
+    return -1;
+  }
+
+  SUNMemoryHelper_Alloc(helper, &mem1, 1000, SUNMEMTYPE_HOST, nullptr);
+  SUNMemoryHelper_Alloc(helper, &mem2, 100, SUNMEMTYPE_HOST, nullptr);
+  SUNMemoryHelper_Dealloc(helper, mem1, nullptr);
+  SUNMemoryHelper_Dealloc(helper, mem2, nullptr);
+  SUNMemoryHelper_GetPoolStats_Pool(helper, &num_reuses, &bytes_cached);
+  if (bytes_cached != 112)
+  {
+    std::cout << "  Reuse... FAILED\n";
+    std::cout << "    bytes_cached = " << bytes_cached << "\n";
+    return -1;
+  }
+
+  std::cout << "  Reuse... PASSED\n";
+  return 0;
+}
+
+int test_vectors(SUNMemoryHelper helper, SUNContext sunctx)
+{
+  unsigned long num_reuses;
+  size_t bytes_cached;
+
+  std::cout << "  SUNContext_SetMemoryHelper... \n";
+
+  SUNContext_SetMemoryHelper(sunctx, helper);
+
+  // The temporaries cloned after the first set reuse its memory
+  N_Vector x = N_VNew_Serial(100, sunctx);
+  for (int i = 0; i < 10; i++)
+  {
+    N_Vector tmp = N_VClone(x);
+    N_VConst(sunrealtype{1.0}, tmp);
+    N_VDestroy(tmp);
+  }
+  N_VDestroy(x);
+
+  SUNContext_SetMemoryHelper(sunctx, nullptr);
+
+  SUNMemoryHelper_GetPoolStats_Pool(helper, &num_reuses, &bytes_cached);
+  if (num_reuses != 9)
+  {
+    std::cout << "  SUNContext_SetMemoryHelper... FAILED\n";
+    std::cout << "    num_reuses = " << num_reuses << "\n";
+    return -1;
+  }
+
+  std::cout << "  SUNContext_SetMemoryHelper... PASSED\n";
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  sundials::Context sunctx;
+
+  std::cout << "Testing the SUNMemoryHelper_Pool module... \n";
+
+  std::cout << "  SUNMemoryHelper_Pool... \n";
+  SUNMemoryHelper helper = SUNMemoryHelper_Pool(sunctx);
+  if (!helper)
+  {
+    std::cout << "  SUNMemoryHelper_Pool... FAILED\n";
+    return -1;
+  }
+  std::cout << "  SUNMemoryHelper_Pool... PASSED\n";
+
+  if (test_reuse(helper)) return -1;
+
+  SUNMemoryHelper helper2 = SUNMemoryHelper_Clone(helper);
+  SUNMemoryHelper_SetMaxCached_Pool(helper2, static_cast<size_t>(-1));
+  if (test_vectors(helper2, sunctx)) return -1;
+
+  // Check destroy
+  std::cout << "  SUNMemoryHelper_Destroy... \n";
+  if (SUNMemoryHelper_Destroy(helper) || SUNMemoryHelper_Destroy(helper2))
+  {
+    std::cout << "  SUNMemoryHelper_Destroy... FAILED\n";
+    return -1;
+  }
+  std::cout << "  SUNMemoryHelper_Destroy... PASSED\n";
+
+  return 0;
+}